@@ -0,0 +1,81 @@
+# Copyright (c) 2026 Hollysys Co., Ltd.
+#
+# SPDX-License-Identifier: MIT
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+"""
+协程式顺序控制示例
+
+用 async def step() 描述“开阀 -> 等待 -> 检查压力”的顺序流程，
+无需手写状态机。运行时每个周期推进一次协程，等待期间的周期计数在 C 侧完成。
+
+运行：bin/plcopen_runtime --config <配置文件>（script_path 指向本文件）
+"""
+
+from plcopen import cycles, sleep, spawn, until
+
+# 模拟过程量
+valve_open = False
+pressure = 1.0
+heartbeat = 0
+
+
+async def monitor():
+    """长期运行的后台协程：每 10 个周期输出一次压力"""
+    global heartbeat
+    while True:
+        heartbeat += 1
+        state = "开" if valve_open else "关"
+        print(f"[监视] 心跳 {heartbeat:4d} | 阀门: {state} | 压力: {pressure:.2f} bar")
+        await cycles(10)
+
+
+def init():
+    """初始化函数：注册后台协程"""
+    spawn(monitor())
+    print("顺序控制示例初始化完成")
+
+
+def simulate():
+    """简单的压力模型：阀门打开时升压，关闭时泄压"""
+    global pressure
+    pressure += 0.02 if valve_open else -0.01
+    pressure = max(1.0, min(pressure, 3.0))
+
+
+async def step():
+    """顺序流程：每轮结束后运行时会重新开始一轮"""
+    global valve_open
+
+    valve_open = True
+    print("步骤 1：开阀")
+
+    # 等待 5 秒，期间每周期仍需更新模型
+    for _ in range(50):
+        simulate()
+        await cycles(1)
+
+    print(f"步骤 2：5 秒后压力 = {pressure:.2f} bar")
+    if pressure < 2.0:
+        print("步骤 3：压力不足，等待压力达到 2.0 bar")
+        await until(lambda: simulate() or pressure >= 2.0)
+
+    valve_open = False
+    print("步骤 4：关阀，保持 3 秒")
+    await sleep(3.0)
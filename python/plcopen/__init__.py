@@ -31,6 +31,9 @@ __license__ = "MIT"
 
 # 导出功能块类
 from plcopen.blocks import PID, FirstOrder, Ramp, Limit
+from plcopen.cycle import next_cycle, cycles, sleep, until, spawn
+from plcopen.tasks import task
+from plcopen.network import attach
 
 __all__ = [
     "__version__",
@@ -38,4 +41,11 @@ __all__ = [
     "FirstOrder",
     "Ramp",
     "Limit",
+    "next_cycle",
+    "cycles",
+    "sleep",
+    "until",
+    "spawn",
+    "task",
+    "attach",
 ]
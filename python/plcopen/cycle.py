@@ -0,0 +1,132 @@
+# Copyright (c) 2026 Hollysys Co., Ltd.
+#
+# SPDX-License-Identifier: MIT
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+"""
+周期驱动的协程支持
+
+运行时检测到 `async def step()` 时，会由 C 调度器在每个控制周期把 step()
+协程推进一次；plcopen.spawn() 注册的长期协程也按同样方式推进。
+协程通过 await 下列对象把控制权交回调度器：
+
+    await next_cycle()      # 下一个周期继续
+    await cycles(50)        # 50 个周期后继续（计数在 C 侧完成）
+    await sleep(5.0)        # 按控制周期换算为周期数
+    await until(lambda: pressure > 2.0)   # 每周期检查一次条件
+
+示例:
+    >>> async def step():
+    ...     valve.open()
+    ...     await sleep(5.0)
+    ...     if pressure < 2.0:
+    ...         alarm.set()
+    ...     await until(lambda: pressure >= 2.0)
+
+注意：这些 awaitable 只能在运行时的周期协程循环中使用，不能在 asyncio 中使用。
+"""
+
+import inspect
+import math
+from typing import Any, Callable, Coroutine
+
+# 控制周期（毫秒），由运行时在加载脚本后设置
+_cycle_period_ms = 100
+
+# spawn() 注册、等待运行时接收的协程
+_spawn_queue: list = []
+
+
+class _CycleWait:
+    """
+    周期等待请求
+
+    __await__ 返回元组迭代器，只让出一个等待请求（周期数或条件函数），
+    避免每次 await 创建生成器对象。
+    """
+
+    __slots__ = ("_request",)
+
+    def __init__(self, request: Any):
+        self._request = (request,)
+
+    def __await__(self):
+        return iter(self._request)
+
+
+_NEXT_CYCLE = _CycleWait(1)
+
+
+def next_cycle() -> _CycleWait:
+    """等待到下一个控制周期"""
+    return _NEXT_CYCLE
+
+
+def cycles(n: int) -> _CycleWait:
+    """
+    等待 n 个控制周期
+
+    参数:
+        n: 周期数，必须 >= 1
+    """
+    n = int(n)
+    if n < 1:
+        raise ValueError("n must be >= 1")
+    return _NEXT_CYCLE if n == 1 else _CycleWait(n)
+
+
+def sleep(seconds: float) -> _CycleWait:
+    """
+    等待指定时间（向上取整为整数个控制周期，至少一个周期）
+
+    参数:
+        seconds: 等待时间（秒）
+    """
+    return cycles(max(1, math.ceil(seconds * 1000.0 / _cycle_period_ms)))
+
+
+def until(condition: Callable[[], Any]) -> _CycleWait:
+    """
+    等待条件成立（从下一个周期开始每周期调用一次 condition）
+
+    参数:
+        condition: 无参可调用对象，返回真值时恢复协程
+    """
+    if not callable(condition):
+        raise TypeError("condition must be callable")
+    return _CycleWait(condition)
+
+
+def spawn(coro: Coroutine) -> Coroutine:
+    """
+    注册一个长期运行的协程，由运行时每周期推进一次
+
+    参数:
+        coro: 协程对象（调用 async def 函数的返回值）
+
+    返回:
+        传入的协程对象
+    """
+    if not inspect.iscoroutine(coro):
+        raise TypeError("spawn() requires a coroutine object")
+    _spawn_queue.append(coro)
+    return coro
+
+
+__all__ = ["next_cycle", "cycles", "sleep", "until", "spawn"]
@@ -0,0 +1,95 @@
+# Copyright (c) 2026 Hollysys Co., Ltd.
+#
+# SPDX-License-Identifier: MIT
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+"""
+把 FBD 网络挂到控制周期上
+
+plcopen_c.Network 声明并构建好之后，用 attach() 交给运行时，每个周期
+在 step() 之前或之后由 C 直接执行整个网络，不再逐块经过解释器：
+
+    from plcopen_c import Network
+    from plcopen.network import attach
+
+    net = Network()
+    net.add_input("sp", 50.0)
+    net.add_input("pv")
+    net.add_block("pid", "PID", Kp=2.0, Ki=0.5)
+    net.add_block("lim", "Limit", min_value=0, max_value=100)
+    net.connect("sp", "pid.SP")
+    net.connect("pv", "pid.PV")
+    net.connect("pid.CV", "lim.in")
+    net.add_output("valve", "lim.out")
+    attach(net, phase="after_step")
+
+    def step():
+        net["pv"] = read_sensor()      # step() 只负责读写网络边界信号
+
+plcopen_c.STProgram（结构化文本程序）也可以挂接，每周期在 C 中执行其字节码：
+
+    from plcopen_c import STProgram
+
+    logic = attach(STProgram('''
+        VAR_INPUT level : REAL; END_VAR
+        VAR_OUTPUT alarm : BOOL; END_VAR
+        alarm := level > 90.0;
+    '''))
+
+运行时在 init() 返回后读取挂接表，之后调用的 attach() 不再生效。
+模块级挂接了网络的脚本可以省略 step()，整个周期只运行 C 网络。
+"""
+
+from typing import Any, Optional
+
+# 挂接表：(net, phase, period_ms)，由运行时在 init() 之后读取
+_attached: list = []
+
+PHASES = ("before_step", "after_step")
+
+
+def attach(net: Any, phase: str = "after_step",
+           period_ms: Optional[int] = None) -> Any:
+    """
+    把已声明的网络挂到控制周期上
+
+    参数:
+        net: plcopen_c.Network 实例（未构建时自动调用 build()）
+            或 plcopen_c.STProgram 实例
+        phase: "before_step" 或 "after_step"
+        period_ms: 执行周期（毫秒），应为控制周期的整数倍；None 表示每周期执行
+
+    返回:
+        net 本身
+    """
+    if phase not in PHASES:
+        raise ValueError("phase must be 'before_step' or 'after_step'")
+    if not hasattr(net, "_capsule"):
+        raise TypeError("attach() requires a plcopen_c.Network or STProgram")
+    period = 0 if period_ms is None else int(period_ms)
+    if period_ms is not None and period < 1:
+        raise ValueError("period_ms must be >= 1")
+
+    if not net.built:
+        net.build()
+    _attached.append((net, phase, period))
+    return net
+
+
+__all__ = ["attach", "PHASES"]
@@ -0,0 +1,134 @@
+# Copyright (c) 2026 Hollysys Co., Ltd.
+#
+# SPDX-License-Identifier: MIT
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+"""
+输入录制与逐周期回放
+
+脚本把外部输入和需要核对的输出经本模块传递，运行时即可录制每个周期的
+周期时间、输入和输出，之后在回放模式下用同样的输入重跑同一脚本，定位
+第一个不一致的周期和通道：
+
+    from plcopen import record
+
+    def step():
+        pv = record.input("pv", read_pv())     # 回放时返回录制值
+        cv = pid.compute(sp, pv)               # dt 为 0 时按周期时间自动计算
+        record.output("cv", cv)                # 回放时与录制值比较
+        write_cv(cv)
+
+运行时配置了 record 节（或命令行 --record/--replay）时，在加载脚本前调用
+open()，每个周期开始时在 C 中锁存周期时间；回放不等待周期定时，录制结束时
+停止并报告第一个不一致。未打开时 input()/output() 直接返回实时值。
+
+确定性要求：step() 中不要直接读取 time.monotonic() 等实时时钟计算 dt，
+使用 dt=0（按锁存的周期时间自动计算）或固定 dt。
+"""
+
+from typing import Any, Dict, Optional
+
+# 当前录制器（plcopen_c.Recorder），运行时在加载脚本前打开
+_recorder: Optional[Any] = None
+
+
+def open(path: str, mode: str = "record", buffer_size: int = 0) -> Any:
+    """
+    打开录制文件
+
+    参数:
+        path: 文件路径（录制时覆盖）
+        mode: "record" 或 "replay"
+        buffer_size: 录制环形缓冲区大小（字节），0 表示默认 256 KiB
+
+    返回:
+        plcopen_c.Recorder 实例
+    """
+    global _recorder
+    import plcopen_c
+
+    if _recorder is not None and not _recorder.closed:
+        raise RuntimeError("a recording is already open")
+    _recorder = plcopen_c.Recorder(path, mode, buffer_size)
+    return _recorder
+
+
+def recorder() -> Optional[Any]:
+    """返回当前录制器，未打开时返回 None"""
+    if _recorder is None or _recorder.closed:
+        return None
+    return _recorder
+
+
+def input(name: str, value: float) -> float:
+    """
+    外部输入
+
+    参数:
+        name: 通道名
+        value: 实时值
+
+    返回:
+        录制时为 value，回放时为录制值
+    """
+    if _recorder is None:
+        return value
+    return _recorder.input(name, value)
+
+
+def output(name: str, value: float) -> bool:
+    """
+    需要核对的输出
+
+    参数:
+        name: 通道名
+        value: 本周期计算值
+
+    返回:
+        回放时是否与录制值不一致，其余情况为 False
+    """
+    if _recorder is None:
+        return False
+    return _recorder.output(name, value)
+
+
+def cycle(now: Optional[float] = None) -> Optional[float]:
+    """
+    开始一个周期（运行时自动调用，单独使用时每周期调用一次）
+
+    返回:
+        周期时间（秒）；回放结束时返回 None
+    """
+    return _recorder.cycle(now) if _recorder is not None else now
+
+
+def divergence() -> Optional[Dict[str, Any]]:
+    """返回第一个不一致 {cycle, channel, expected, actual}，没有时返回 None"""
+    return _recorder.divergence if _recorder is not None else None
+
+
+def close() -> None:
+    """写出剩余记录并关闭"""
+    global _recorder
+    if _recorder is not None:
+        _recorder.close()
+        _recorder = None
+
+
+__all__ = ["open", "recorder", "input", "output", "cycle", "divergence", "close"]
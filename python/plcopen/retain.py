@@ -0,0 +1,122 @@
+# Copyright (c) 2026 Hollysys Co., Ltd.
+#
+# SPDX-License-Identifier: MIT
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+"""
+保持型（RETAIN）变量
+
+选定功能块的状态和声明的保持变量保存在内存映射文件中，重启后恢复，
+避免积分、滤波和斜坡输出从 0 开始对被控对象造成扰动：
+
+    import plcopen_c
+    from plcopen import retain
+
+    pid = plcopen_c.PID(Kp=2.0, Ki=0.5)
+    pid.name = "TIC101"
+    retain.block(pid)                      # 恢复积分值和上一周期误差
+    sp = retain.var("tic101_sp", 50.0)     # 首次启动取 50.0，之后取上次保存的值
+
+    def step():
+        cv = pid.compute(sp.value, read_pv())
+
+运行时配置了 retain.file 时，在加载脚本前调用 open()，每个控制周期结束后
+在 C 中捕获一次（只做内存复制），由后台线程按 retain.period_ms 写盘，
+退出时写入最终检查点。单独使用时需自行 open() 并每周期调用 checkpoint()。
+"""
+
+from typing import Any, Optional
+
+# 当前保持文件（plcopen_c.Retain），运行时在加载脚本前打开
+_store: Optional[Any] = None
+
+
+def open(path: str, size: int = 0, period_ms: int = 100) -> Any:
+    """
+    打开保持文件并启动后台写线程
+
+    参数:
+        path: 文件路径，不存在时创建
+        size: 单个存储区大小（字节），0 表示默认 64 KiB
+        period_ms: 最短写盘间隔（毫秒）
+
+    返回:
+        plcopen_c.Retain 实例
+    """
+    global _store
+    import plcopen_c
+
+    if _store is not None and not _store.closed:
+        raise RuntimeError("retain file is already open")
+    store = plcopen_c.Retain(path, size)
+    store.start(period_ms)
+    _store = store
+    return store
+
+
+def store() -> Any:
+    """返回当前保持文件，未打开时抛出 RuntimeError"""
+    if _store is None or _store.closed:
+        raise RuntimeError("retain file is not open (set retain.file in the runtime config "
+                           "or call plcopen.retain.open())")
+    return _store
+
+
+def block(fb: Any, key: Optional[str] = None) -> bool:
+    """
+    声明保持的功能块状态（PID、FirstOrder、Ramp）
+
+    参数:
+        fb: plcopen_c 功能块实例
+        key: 记录键，默认使用 fb.name
+
+    返回:
+        是否从检查点恢复
+    """
+    return store().block(fb, key)
+
+
+def var(key: str, initial: float = 0.0) -> Any:
+    """
+    声明保持变量
+
+    参数:
+        key: 变量名
+        initial: 检查点中没有该变量时的初值
+
+    返回:
+        plcopen_c.RetainVar，通过 .value 读写
+    """
+    return store().var(key, initial)
+
+
+def checkpoint() -> None:
+    """捕获当前值（只做内存复制，写盘由后台线程完成）"""
+    store().checkpoint()
+
+
+def close() -> None:
+    """停止写线程、写入最终检查点并关闭文件"""
+    global _store
+    if _store is not None:
+        _store.close()
+        _store = None
+
+
+__all__ = ["open", "store", "block", "var", "checkpoint", "close"]
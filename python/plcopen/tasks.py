@@ -0,0 +1,83 @@
+# Copyright (c) 2026 Hollysys Co., Ltd.
+#
+# SPDX-License-Identifier: MIT
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+"""
+装饰器注册的多速率任务
+
+脚本可以用 @task 注册多个周期函数，代替（或补充）单一的 step()：
+
+    @task(period_ms=10, priority=90)
+    def fast_loop():
+        ...
+
+    @task(period_ms=1000, priority=10)
+    def slow_logging():
+        ...
+
+运行时在加载脚本后读取注册表，按控制周期分频调度各任务，同一周期内
+按优先级从高到低执行，并在 C 侧统计每个任务的执行时间、超时和异常次数。
+注册了任务的脚本可以省略 step()。
+
+thread 参数把任务放入命名线程组：在 free-threaded（无 GIL）的 Python
+构建中，每个线程组在独立线程中运行；带 GIL 的解释器中线程组仍在控制
+线程中执行，并在启动时给出警告。
+"""
+
+import inspect
+from typing import Callable, Optional
+
+# 注册表：(func, period_ms, priority, name, thread)，由运行时在加载脚本后读取
+_registry: list = []
+
+
+def task(period_ms: int, priority: int = 50, name: Optional[str] = None,
+         thread: Optional[str] = None) -> Callable[[Callable], Callable]:
+    """
+    注册周期任务的装饰器
+
+    参数:
+        period_ms: 任务周期（毫秒），应为控制周期的整数倍
+        priority: 优先级，越大越先执行；线程组中用作 SCHED_FIFO 优先级（1-99）
+        name: 任务名称，默认使用函数名
+        thread: 线程组名称，None 表示在控制线程中执行
+
+    返回:
+        装饰器，原样返回被装饰的函数
+    """
+    period_ms = int(period_ms)
+    priority = int(priority)
+    if period_ms < 1:
+        raise ValueError("period_ms must be >= 1")
+
+    def decorator(func: Callable) -> Callable:
+        if not callable(func):
+            raise TypeError("task() requires a callable")
+        if inspect.iscoroutinefunction(func):
+            raise TypeError("task() does not accept async functions, use spawn()")
+        task_name = name if name is not None else getattr(func, "__name__", "task")
+        _registry.append((func, period_ms, priority, str(task_name),
+                          None if thread is None else str(thread)))
+        return func
+
+    return decorator
+
+
+__all__ = ["task"]
@@ -4,6 +4,8 @@ setup.py - Python C Extension 构建脚本
 构建 PLCopen 功能块的 Python 绑定。
 """
 
+import os
+
 from setuptools import setup, Extension
 
 # 源文件列表
@@ -14,12 +16,44 @@ c_sources = [
     "src/python_bindings/py_first_order.c",
     "src/python_bindings/py_ramp.c",
     "src/python_bindings/py_limit.c",
+    "src/python_bindings/py_dead_time.c",
+    "src/python_bindings/py_window.c",
+    "src/python_bindings/py_iir.c",
+    "src/python_bindings/py_lookup.c",
+    "src/python_bindings/py_iec.c",
+    "src/python_bindings/py_autotune.c",
+    "src/python_bindings/py_kalman.c",
+    "src/python_bindings/py_view.c",
+    "src/python_bindings/py_pid_bank.c",
+    "src/python_bindings/py_fb_arrays.c",
+    "src/python_bindings/py_network.c",
+    "src/python_bindings/py_st.c",
+    "src/python_bindings/py_registry.c",
+    "src/python_bindings/py_retain.c",
+    "src/python_bindings/py_record.c",
     # 功能块实现
     "src/function_blocks/fb_common.c",
     "src/function_blocks/fb_pid.c",
+    "src/function_blocks/fb_pid_bank.c",
     "src/function_blocks/fb_first_order.c",
     "src/function_blocks/fb_ramp.c",
     "src/function_blocks/fb_limit.c",
+    "src/function_blocks/fb_dead_time.c",
+    "src/function_blocks/fb_window.c",
+    "src/function_blocks/fb_iir.c",
+    "src/function_blocks/fb_lookup.c",
+    "src/function_blocks/fb_iec.c",
+    "src/function_blocks/fb_autotune.c",
+    "src/function_blocks/fb_kalman.c",
+    "src/function_blocks/fb_precision.c",
+    "src/function_blocks/fb_network.c",
+    "src/function_blocks/fb_st.c",
+    "src/function_blocks/fb_pool.c",
+    "src/function_blocks/fb_registry.c",
+    "src/function_blocks/fb_timing.c",
+    "src/function_blocks/fb_journal.c",
+    "src/function_blocks/fb_retain.c",
+    "src/function_blocks/fb_record.c",
     # 运行时支持
     "src/runtime/logger.c",
 ]
@@ -34,6 +68,10 @@ extra_compile_args = [
     "-fPIC",
 ]
 
+# FB_TIMING=1 时启用功能块执行时间计数（改变 FunctionBlock 结构布局，
+# 运行时须用 make FB_TIMING=1 同样构建；切换时加 --force 重新编译）
+define_macros = [("FB_TIMING", None)] if os.environ.get("FB_TIMING") == "1" else []
+
 # 链接选项
 extra_link_args = [
     "-lpthread",  # pthread 用于日志系统的互斥锁
@@ -45,6 +83,7 @@ plcopen_ext = Extension(
     "plcopen_c",  # 模块名
     sources=c_sources,
     include_dirs=["src"],
+    define_macros=define_macros,
     extra_compile_args=extra_compile_args,
     extra_link_args=extra_link_args,
 )
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_autotune.c
+ * @brief 继电器反馈自整定功能块实现
+ */
+
+#include "fb_autotune.h"
+#include "fb_journal.h"
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
+#include "../runtime/logger.h"
+#include <math.h>
+#include <string.h>
+
+#define AUTOTUNE_PI 3.14159265358979323846
+
+// 规则系数：Kp = kp·Ku，Ti = ti·Tu，Td = td·Tu
+static const struct {
+    const char* name;
+    double kp, ti, td;
+} AUTOTUNE_RULES[] = {
+    [AUTOTUNE_RULE_ZN] = {"zn", 0.6, 0.5, 0.125},
+    [AUTOTUNE_RULE_ZN_PI] = {"zn_pi", 0.45, 1.0 / 1.2, 0.0},
+    [AUTOTUNE_RULE_TYREUS_LUYBEN] = {"tyreus_luyben", 1.0 / 2.2, 2.2, 1.0 / 6.3},
+    [AUTOTUNE_RULE_SOME_OVERSHOOT] = {"some_overshoot", 0.33, 0.5, 1.0 / 3.0},
+    [AUTOTUNE_RULE_NO_OVERSHOOT] = {"no_overshoot", 0.2, 0.5, 1.0 / 3.0},
+};
+
+#define AUTOTUNE_RULE_COUNT (sizeof(AUTOTUNE_RULES) / sizeof(AUTOTUNE_RULES[0]))
+
+int autotune_parse_rule(const char* name, AutoTuneRule* rule) {
+    for (size_t i = 0; name && i < AUTOTUNE_RULE_COUNT; i++) {
+        if (strcmp(AUTOTUNE_RULES[i].name, name) == 0) {
+            *rule = (AutoTuneRule)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+const char* autotune_rule_name(AutoTuneRule rule) {
+    return (size_t)rule < AUTOTUNE_RULE_COUNT ? AUTOTUNE_RULES[rule].name : "?";
+}
+
+const char* autotune_state_name(AutoTuneState state) {
+    static const char* const names[] = {"idle", "running", "done", "failed"};
+    return (size_t)state < sizeof(names) / sizeof(names[0]) ? names[state] : "?";
+}
+
+static int config_valid(const AutoTuneConfig* c) {
+    return c && isfinite(c->relay) && c->relay != 0.0 && c->hysteresis >= 0.0 &&
+           isfinite(c->hysteresis) && c->cycles >= 2 && c->cycles <= 100 &&
+           c->tolerance > 0.0 && c->tolerance < 1.0 && c->timeout >= 0.0 &&
+           (size_t)c->rule < AUTOTUNE_RULE_COUNT;
+}
+
+int autotune_init(AutoTuneFB* at, PIDFunctionBlock* pid, const AutoTuneConfig* config) {
+    if (!at || !config_valid(config)) {
+        return -1;
+    }
+
+    memset(at, 0, sizeof(*at));
+    at->base.type = FB_TYPE_AUTOTUNE;
+    at->config = *config;
+    at->config.auto_apply = config->auto_apply != 0;
+    at->pid = pid;
+    at->state = AUTOTUNE_IDLE;
+    at->last_rise = -1.0;
+    return 0;
+}
+
+AutoTuneFB* autotune_create(PIDFunctionBlock* pid, const AutoTuneConfig* config) {
+    if (!config_valid(config)) {
+        LOG_ERROR_MSG("自整定器创建失败：配置无效");
+        return NULL;
+    }
+
+    AutoTuneFB* at = (AutoTuneFB*)fb_pool_alloc(FB_TYPE_AUTOTUNE);
+    if (!at) {
+        LOG_ERROR_MSG("自整定器创建失败：实例池已满");
+        return NULL;
+    }
+
+    autotune_init(at, pid, config);
+    if (fb_registry_register(&at->base, NULL, NULL) == 0) {
+        fb_pool_free(FB_TYPE_AUTOTUNE, at);
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_AUTOTUNE, at->base.id, FB_EVENT_CREATE, "pid,relay,hysteresis",
+               pid ? (double)pid->base.id : 0.0, config->relay, config->hysteresis);
+    return at;
+}
+
+void autotune_destroy(AutoTuneFB* at) {
+    if (at) {
+        autotune_stop(at);
+        FB_JOURNAL_EVENT(FB_TYPE_AUTOTUNE, at->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(at->base.id);
+        fb_pool_free(FB_TYPE_AUTOTUNE, at);
+    }
+}
+
+int autotune_start(AutoTuneFB* at, double SP, const double* bias) {
+    if (!at || at->state == AUTOTUNE_RUNNING || !isfinite(SP) || (bias && !isfinite(*bias))) {
+        return -1;
+    }
+
+    at->SP = SP;
+    at->bias = bias ? *bias : at->pid ? at->pid->ext.output : 0.0;
+
+    // 两档输出按 PID 输出范围限幅，等效继电器幅值取两档之差的一半
+    double d = fabs(at->config.relay);
+    at->u_high = at->bias + d;
+    at->u_low = at->bias - d;
+    if (at->pid) {
+        at->u_high = clamp(at->u_high, at->pid->params.output_min, at->pid->params.output_max);
+        at->u_low = clamp(at->u_low, at->pid->params.output_min, at->pid->params.output_max);
+    }
+    if (!(at->u_high > at->u_low)) {
+        LOG_ERROR_MSG("自整定启动失败：ID=%u, 继电器两档输出相同（bias=%.3f）", at->base.id,
+                      at->bias);
+        return -1;
+    }
+    if (at->config.relay < 0.0) {       // 反作用：PV 低于 SP 时减小输出
+        double t = at->u_high;
+        at->u_high = at->u_low;
+        at->u_low = t;
+    }
+
+    at->state = AUTOTUNE_RUNNING;
+    at->high = 0;
+    at->elapsed = 0.0;
+    at->last_rise = -1.0;
+    at->pv_max = -INFINITY;
+    at->pv_min = INFINITY;
+    at->period = at->amplitude = 0.0;
+    at->periods = at->consistent = 0;
+    at->Ku = at->Tu = 0.0;
+    at->Kp = at->Ki = at->Kd = 0.0;
+    at->output = at->bias;
+    at->base.last_update_time = 0.0;
+    if (at->pid) {
+        pid_set_manual(at->pid, 1);
+    }
+    return 0;
+}
+
+// 试验结束：关联的 PID 无扰切回自动（成功且 auto_apply 时再无扰换上新参数）
+static void autotune_finish(AutoTuneFB* at, AutoTuneState state) {
+    at->state = state;
+    if (!at->pid) {
+        return;
+    }
+    pid_set_manual(at->pid, 0);
+    if (state == AUTOTUNE_DONE && at->config.auto_apply) {
+        autotune_apply(at);
+    }
+}
+
+// 由最近一个周期的振幅和周期计算 Ku、Tu 和建议参数
+static void autotune_conclude(AutoTuneFB* at) {
+    double a = at->amplitude;
+    double eps = at->config.hysteresis;
+    if (!(a > eps)) {
+        // 失败记录振幅和滞环，结果见 state
+        FB_JOURNAL(FB_TYPE_AUTOTUNE, at->base.id, FB_EVENT_TUNE, "amplitude,hysteresis", a, eps);
+        autotune_finish(at, AUTOTUNE_FAILED);
+        return;
+    }
+
+    double d = (at->u_high - at->u_low) / 2.0;
+    at->Ku = 4.0 * fabs(d) / (AUTOTUNE_PI * sqrt(a * a - eps * eps));
+    at->Tu = at->period;
+
+    AutoTuneRule r = at->config.rule;
+    at->Kp = AUTOTUNE_RULES[r].kp * at->Ku;
+    at->Ki = at->Kp / (AUTOTUNE_RULES[r].ti * at->Tu);
+    at->Kd = at->Kp * AUTOTUNE_RULES[r].td * at->Tu;
+
+    FB_JOURNAL(FB_TYPE_AUTOTUNE, at->base.id, FB_EVENT_TUNE, "Ku,Tu,Kp,Ki,Kd", at->Ku, at->Tu,
+               at->Kp, at->Ki, at->Kd);
+    autotune_finish(at, AUTOTUNE_DONE);
+}
+
+// 两个量的相对偏差是否在容差内
+static inline int within(double a, double b, double tol) {
+    return fabs(a - b) <= tol * fabs(a);
+}
+
+double autotune_compute(AutoTuneFB* at, double PV, double dt) {
+    if (!at) {
+        return 0.0;
+    }
+
+    FB_TIMED(&at->base);
+    if (at->state != AUTOTUNE_RUNNING) {
+        return at->output;
+    }
+
+    if (dt <= 0.0) {
+        dt = fb_auto_dt(&at->base);
+    }
+    at->elapsed += dt;
+
+    if (PV > at->pv_max) {
+        at->pv_max = PV;
+    }
+    if (PV < at->pv_min) {
+        at->pv_min = PV;
+    }
+
+    double error = at->SP - PV;
+    double eps = at->config.hysteresis;
+    if (!at->high && error > eps) {
+        at->high = 1;
+        // 切高：结束一个完整周期
+        if (at->last_rise >= 0.0) {
+            double period = at->elapsed - at->last_rise;
+            double amplitude = (at->pv_max - at->pv_min) / 2.0;
+            int same = at->periods > 0 && within(period, at->period, at->config.tolerance) &&
+                       within(amplitude, at->amplitude, at->config.tolerance);
+            at->consistent = same ? at->consistent + 1 : 1;
+            at->period = period;
+            at->amplitude = amplitude;
+            at->periods++;
+        }
+        at->last_rise = at->elapsed;
+        at->pv_max = at->pv_min = PV;
+    } else if (at->high && error < -eps) {
+        at->high = 0;
+    }
+
+    at->output = at->high ? at->u_high : at->u_low;
+    if (at->pid) {
+        // PID 在手动模式下跟踪继电器输出，切回自动时无扰
+        at->pid->manual_output = at->output;
+        pid_compute(at->pid, at->SP, PV, dt);
+    }
+
+    if (at->consistent >= at->config.cycles) {
+        autotune_conclude(at);
+    } else if (at->config.timeout > 0.0 && at->elapsed > at->config.timeout) {
+        FB_JOURNAL(FB_TYPE_AUTOTUNE, at->base.id, FB_EVENT_TUNE, "elapsed,periods", at->elapsed,
+                   (double)at->periods);
+        autotune_finish(at, AUTOTUNE_FAILED);
+    }
+    return at->output;
+}
+
+void autotune_stop(AutoTuneFB* at) {
+    if (at && at->state == AUTOTUNE_RUNNING) {
+        autotune_finish(at, AUTOTUNE_IDLE);
+    }
+}
+
+int autotune_apply(AutoTuneFB* at) {
+    if (!at || !at->pid || at->state != AUTOTUNE_DONE) {
+        return -1;
+    }
+    return pid_set_params_bumpless(at->pid, &at->Kp, &at->Ki, &at->Kd);
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_autotune.h
+ * @brief 继电器反馈自整定功能块（Åström–Hägglund）
+ *
+ * 试验期间用带滞环的继电器代替 PID 输出：PV 低于 SP - ε 时输出 bias + d，
+ * 高于 SP + ε 时输出 bias - d，回路进入等幅振荡。每次继电器切高时结束一个
+ * 完整周期，由两次切高的间隔得到振荡周期 Tu、由该周期内 PV 的最大/最小值
+ * 得到振幅 a，每周期 O(1)、不分配内存。连续 cycles 个周期的周期和振幅彼此
+ * 相差不超过 tolerance 时按描述函数求临界增益 Ku = 4d / (π·sqrt(a² - ε²))，
+ * 再按整定规则给出 Kp/Ki/Kd。
+ *
+ * 关联 PID 时，试验期间 PID 处于手动模式并跟踪继电器输出；试验结束（成功、
+ * 失败或中止）后 PID 无扰切回自动，auto_apply 时先用 pid_set_params_bumpless()
+ * 换上新参数。关联的 PID 在整定器销毁前不得销毁。
+ */
+
+#ifndef FB_AUTOTUNE_H
+#define FB_AUTOTUNE_H
+
+#include "fb_common.h"
+#include "fb_pid.h"
+
+// 整定器状态
+typedef enum {
+    AUTOTUNE_IDLE = 0,       // 未开始或已中止
+    AUTOTUNE_RUNNING,        // 试验进行中
+    AUTOTUNE_DONE,           // 已得到建议参数
+    AUTOTUNE_FAILED          // 超时或振幅不大于滞环
+} AutoTuneState;
+
+// 整定规则（Ti、Td 以 Tu 表示）
+typedef enum {
+    AUTOTUNE_RULE_ZN = 0,            // Ziegler–Nichols PID：0.6Ku, Tu/2, Tu/8
+    AUTOTUNE_RULE_ZN_PI,             // Ziegler–Nichols PI：0.45Ku, Tu/1.2
+    AUTOTUNE_RULE_TYREUS_LUYBEN,     // Tyreus–Luyben：Ku/2.2, 2.2Tu, Tu/6.3
+    AUTOTUNE_RULE_SOME_OVERSHOOT,    // 少量超调：0.33Ku, Tu/2, Tu/3
+    AUTOTUNE_RULE_NO_OVERSHOOT       // 无超调：0.2Ku, Tu/2, Tu/3
+} AutoTuneRule;
+
+// 试验配置
+typedef struct {
+    double relay;        // 继电器幅值 d（输出单位），负数表示反作用对象
+    double hysteresis;   // 滞环 ε（PV 单位），应大于测量噪声
+    int cycles;          // 判定收敛所需的连续一致周期数 [2, 100]
+    double tolerance;    // 周期、振幅的相对偏差上限 (0, 1)
+    double timeout;      // 试验时间上限（秒），0 表示不限
+    AutoTuneRule rule;   // 整定规则
+    int auto_apply;      // 成功后自动把建议参数无扰写入关联的 PID
+} AutoTuneConfig;
+
+#define AUTOTUNE_DEFAULT_CONFIG {1.0, 0.0, 3, 0.05, 0.0, AUTOTUNE_RULE_ZN, 1}
+
+// 自整定功能块
+typedef struct {
+    FunctionBlock base;
+    AutoTuneConfig config;
+    PIDFunctionBlock* pid;   // 被整定的 PID（可为 NULL）
+    AutoTuneState state;
+    double SP;               // 试验设定值
+    double bias;             // 继电器中心输出
+    double output;           // 最近一次输出
+    double u_high, u_low;    // 继电器两档输出（已按 PID 输出范围限幅）
+    int high;                // 继电器当前为高
+    double elapsed;          // 试验已进行时间（秒）
+    double last_rise;        // 上次切高时刻，负数表示尚未切高
+    double pv_max, pv_min;   // 当前周期内 PV 的极值
+    double period;           // 最近一个完整周期的周期（秒）
+    double amplitude;        // 最近一个完整周期的 PV 振幅
+    int periods;             // 已完成的周期数
+    int consistent;          // 连续一致的周期数
+    double Ku, Tu;           // 临界增益与临界周期
+    double Kp, Ki, Kd;       // 建议参数
+} AutoTuneFB;
+
+/**
+ * @brief 按名称解析整定规则
+ * @param name "zn"、"zn_pi"、"tyreus_luyben"、"some_overshoot" 或 "no_overshoot"
+ * @param rule 输出规则
+ * @return 0 成功，-1 未知名称
+ */
+int autotune_parse_rule(const char* name, AutoTuneRule* rule);
+
+/**
+ * @brief 规则名称
+ */
+const char* autotune_rule_name(AutoTuneRule rule);
+
+/**
+ * @brief 状态名称（"idle"、"running"、"done"、"failed"）
+ */
+const char* autotune_state_name(AutoTuneState state);
+
+/**
+ * @brief 初始化整定器
+ * @param at 整定器
+ * @param pid 被整定的 PID，可为 NULL（只给出建议参数）
+ * @param config 试验配置
+ * @return 0 成功，-1 配置无效
+ */
+int autotune_init(AutoTuneFB* at, PIDFunctionBlock* pid, const AutoTuneConfig* config);
+
+/**
+ * @brief 从实例池创建整定器
+ * @return 功能块指针，配置无效或实例池已满时返回 NULL
+ */
+AutoTuneFB* autotune_create(PIDFunctionBlock* pid, const AutoTuneConfig* config);
+
+/**
+ * @brief 销毁整定器（试验进行中时先中止）
+ */
+void autotune_destroy(AutoTuneFB* at);
+
+/**
+ * @brief 开始试验
+ * @param at 整定器
+ * @param SP 试验设定值
+ * @param bias 继电器中心输出，NULL 表示取关联 PID 的上一周期输出（无 PID 时为 0）
+ * @return 0 成功，-1 试验已在进行或参数无效
+ */
+int autotune_start(AutoTuneFB* at, double SP, const double* bias);
+
+/**
+ * @brief 执行一个周期
+ * @param at 整定器
+ * @param PV 过程变量
+ * @param dt 距上个周期的时间（秒），0 表示按功能块时钟自动计算
+ * @return 试验期间为继电器输出（代替 PID 输出送往执行机构），其他状态为最近一次输出
+ */
+double autotune_compute(AutoTuneFB* at, double PV, double dt);
+
+/**
+ * @brief 中止试验，关联的 PID 以原参数无扰切回自动
+ */
+void autotune_stop(AutoTuneFB* at);
+
+/**
+ * @brief 把建议参数无扰写入关联的 PID
+ * @return 0 成功，-1 尚无结果或未关联 PID
+ */
+int autotune_apply(AutoTuneFB* at);
+
+#endif // FB_AUTOTUNE_H
@@ -27,23 +27,55 @@
  */
 
 #include "fb_common.h"
-#include "../runtime/logger.h"
+#include "fb_journal.h"
 #include <math.h>
+#include <string.h>
+#include <time.h>
 
-double clamp(double value, double min, double max) {
-    if (value < min) return min;
-    if (value > max) return max;
-    return value;
-}
+static FBClock g_fb_clock = {0, 0.0};
 
 double validate_and_clamp(double value, double min, double max, const char* param_name) {
     double original = value;
     double clamped = clamp(value, min, max);
 
+    // 只计数，由事件汇总报告（见 fb_journal.h），在线改参越限时不逐次写日志
     if (fabs(clamped - original) > 1e-9) {
-        LOG_WARNING_MSG("参数 %s 超出范围：原值=%.6f, 限制后=%.6f (范围 [%.6f, %.6f])",
-                        param_name, original, clamped, min, max);
+        fb_journal_note_clamp(param_name, original, min, max);
     }
 
     return clamped;
 }
+
+void fb_reinit(void* block, const void* fresh, size_t size) {
+    FunctionBlock base = *(FunctionBlock*)block;
+    memcpy(block, fresh, size);
+    base.last_update_time = 0.0;
+    *(FunctionBlock*)block = base;
+}
+
+double fb_auto_dt(FunctionBlock* base) {
+    double current_time;
+    if (__atomic_load_n(&g_fb_clock.latched, __ATOMIC_ACQUIRE)) {
+        __atomic_load(&g_fb_clock.now, &current_time, __ATOMIC_RELAXED);
+    } else {
+        current_time = fb_clock_monotonic();
+    }
+
+    double dt = 0.1;  // 默认 100ms
+    if (base->last_update_time > 0.0) {
+        dt = current_time - base->last_update_time;
+    }
+
+    base->last_update_time = current_time;
+    return dt;
+}
+
+FBClock* fb_clock(void) {
+    return &g_fb_clock;
+}
+
+double fb_clock_monotonic(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
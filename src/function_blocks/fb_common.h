@@ -29,6 +29,8 @@
 #ifndef FB_COMMON_H
 #define FB_COMMON_H
 
+#include "fb_kernels.h"
+#include <stddef.h>
 #include <stdint.h>
 
 // 功能块类型枚举
@@ -36,33 +38,96 @@ typedef enum {
     FB_TYPE_PID,           // PID 控制器
     FB_TYPE_FIRST_ORDER,   // 一阶惯性
     FB_TYPE_RAMP,          // 斜坡生成器
-    FB_TYPE_LIMIT          // 限幅器
+    FB_TYPE_LIMIT,         // 限幅器
+    FB_TYPE_PID_BANK,      // 批量 PID
+    FB_TYPE_DEAD_TIME,     // 纯滞后
+    FB_TYPE_MOVING_AVERAGE,  // 滑动平均
+    FB_TYPE_MOVING_MEDIAN,   // 滑动中值
+    FB_TYPE_SLOPE,           // 变化率
+    FB_TYPE_IIR,             // 离散传递函数（级联二阶节）
+    FB_TYPE_LOOKUP_1D,       // 一维折线表
+    FB_TYPE_LOOKUP_2D,       // 二维折线表
+    FB_TYPE_TON,             // 接通延时定时器
+    FB_TYPE_TOF,             // 断开延时定时器
+    FB_TYPE_TP,              // 脉冲定时器
+    FB_TYPE_CTU,             // 加计数器
+    FB_TYPE_CTD,             // 减计数器
+    FB_TYPE_R_TRIG,          // 上升沿检测
+    FB_TYPE_F_TRIG,          // 下降沿检测
+    FB_TYPE_AUTOTUNE,        // 继电器反馈自整定
+    FB_TYPE_KALMAN,          // 卡尔曼滤波
+    FB_TYPE_ARRAY            // 功能块实例数组（Python *Array 类型，整个数组登记为一个条目）
 } FunctionBlockType;
 
+#define FB_TYPE_COUNT (FB_TYPE_ARRAY + 1)   // 类型数（新增类型时同步修改）
+
+// 单个实例的执行时间计数（单位为时钟刻度，换算见 fb_timing.h）
+typedef struct {
+    uint64_t calls;          // 计算调用次数
+    uint64_t total;          // 累计耗时
+    uint64_t max;            // 单次最大耗时
+} FBTiming;
+
 // 功能块基础结构（所有功能块的共同属性）
 typedef struct {
     FunctionBlockType type;  // 功能块类型
     uint32_t id;             // 实例 ID
     double last_update_time; // 上次更新时间（秒）
+#ifdef FB_TIMING
+    FBTiming timing;         // 执行时间计数（仅 FB_TIMING 构建）
+#endif
 } FunctionBlock;
 
-/**
- * @brief 将浮点数限制到指定范围
- * @param value 输入值
- * @param min 最小值
- * @param max 最大值
- * @return 限制后的值
- */
-double clamp(double value, double min, double max);
+// 功能块时钟：fb_auto_dt() 的时间来源（扩展和运行时各编译一份）
+typedef struct {
+    int latched;             // 1：使用 now（录制/回放时按控制周期锁存），0：读取单调时钟
+    double now;              // 锁存的周期时间（秒）
+} FBClock;
+
+// clamp() 及其 _f32 / _q16 版本见 fb_kernels.h
 
 /**
  * @brief 验证参数并限制到有效范围
  * @param value 参数值
  * @param min 最小值
  * @param max 最大值
- * @param param_name 参数名称（用于日志）
+ * @param param_name 参数名称（静态字符串，越限时计入事件汇总）
  * @return 限制后的值
  */
 double validate_and_clamp(double value, double min, double max, const char* param_name);
 
+/**
+ * @brief 用新初始化的内容替换已登记的实例，保留其注册表 ID
+ * @param block 已登记的实例（首成员为 FunctionBlock）
+ * @param fresh 由 *_init() 初始化的临时实例（同一类型）
+ * @param size 实例结构大小
+ *
+ * *_init() 把 base.id 清零；直接对已登记的实例调用会使销毁时注销 ID 0，
+ * 注册表留下指向已释放实例的条目。重复调用 __init__ 等场合应先初始化临时实例，
+ * 成功后再用本函数替换（执行时间计数保留，自动 dt 重新开始）。
+ */
+void fb_reinit(void* block, const void* fresh, size_t size);
+
+/**
+ * @brief 按单调时钟计算距上次调用的时间差（用于 dt 为 0 时自动计算）
+ * @param base 功能块基础结构（更新其 last_update_time）
+ * @return 时间差（秒），首次调用返回 0.1
+ */
+double fb_auto_dt(FunctionBlock* base);
+
+/**
+ * @brief 获取功能块时钟
+ * @return 进程内（本模块）唯一的时钟
+ *
+ * 锁存后同一周期内所有自动 dt 使用同一时间点，dt 只取决于周期时间，
+ * 录制周期时间即可在回放时逐位复现 dt。
+ */
+FBClock* fb_clock(void);
+
+/**
+ * @brief 读取单调时钟
+ * @return 时间（秒）
+ */
+double fb_clock_monotonic(void);
+
 #endif // FB_COMMON_H
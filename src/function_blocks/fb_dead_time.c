@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_dead_time.c
+ * @brief 纯滞后（传输延迟）功能块实现
+ */
+
+#include "fb_dead_time.h"
+#include "fb_journal.h"
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
+#include "../runtime/logger.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEAD_TIME_ALIGN 64   // 缓冲区按缓存行对齐
+
+// 把延迟时间换算为整数周期数和小数部分；误差在舍入范围内的整数倍按整数处理
+static int split_delay(double delay, double period, int interpolate,
+                       uint32_t* steps, double* frac) {
+    if (!(delay >= 0.0) || !(period > 0.0)) {
+        return -1;
+    }
+
+    double d = delay / period;
+    if (!(d < (double)DEAD_TIME_MAX_SAMPLES)) {
+        return -1;
+    }
+
+    double nearest = nearbyint(d);
+    if (fabs(d - nearest) <= 1e-9 * (nearest > 1.0 ? nearest : 1.0)) {
+        d = nearest;
+    }
+
+    if (interpolate) {
+        double whole = floor(d);
+        *steps = (uint32_t)whole;
+        *frac = d - whole;
+    } else {
+        *steps = (uint32_t)nearbyint(d);
+        *frac = 0.0;
+    }
+    return 0;
+}
+
+// 读取 steps 周期前的样本（插值时还需再早一个）所需的缓冲区行数
+static uint32_t rows_needed(uint32_t steps, double frac) {
+    return steps + 1 + (frac > 0.0 ? 1 : 0);
+}
+
+// 按最大延迟计算 2 的幂容量，返回掩码；参数无效时返回 -1
+static int64_t capacity_mask(double delay, double period, double max_delay, int interpolate) {
+    uint32_t steps;
+    double frac;
+    if (split_delay(delay, period, interpolate, &steps, &frac) != 0 ||
+        split_delay(max_delay > delay ? max_delay : delay, period, interpolate,
+                    &steps, &frac) != 0) {
+        return -1;
+    }
+
+    uint32_t rows = rows_needed(steps, frac);
+    uint32_t capacity = 1;
+    while (capacity < rows) {
+        capacity <<= 1;
+    }
+    return (int64_t)capacity - 1;
+}
+
+static double* alloc_buffer(size_t doubles) {
+    void* buffer = NULL;
+    if (posix_memalign(&buffer, DEAD_TIME_ALIGN, doubles * sizeof(double)) != 0) {
+        return NULL;
+    }
+    return (double*)buffer;
+}
+
+static void fill(double* buffer, size_t doubles, double value) {
+    for (size_t i = 0; i < doubles; i++) {
+        buffer[i] = value;
+    }
+}
+
+int dead_time_init(DeadTimeFB* fb, double delay, double period, double max_delay,
+                   int interpolate, double initial) {
+    if (!fb) {
+        return -1;
+    }
+
+    interpolate = interpolate != 0;
+    int64_t mask = capacity_mask(delay, period, max_delay, interpolate);
+    if (mask < 0) {
+        LOG_ERROR_MSG("纯滞后参数无效：delay=%.3f, period=%.6f, max_delay=%.3f",
+                      delay, period, max_delay);
+        return -1;
+    }
+
+    // 单个实例的缓冲区从实例池的附属存储区分配（64 字节对齐）
+    double* buffer = (double*)fb_pool_storage_alloc(((size_t)mask + 1) * sizeof(double));
+    if (!buffer) {
+        LOG_ERROR_MSG("纯滞后缓冲区分配失败：%lld 个样本", (long long)mask + 1);
+        return -1;
+    }
+
+    fb->base.type = FB_TYPE_DEAD_TIME;
+    fb->base.id = 0;
+    fb->base.last_update_time = 0.0;
+
+    fb->params.delay = delay;
+    fb->params.period = period;
+    fb->params.initial = initial;
+    fb->params.interpolate = interpolate;
+
+    fb->buffer = buffer;
+    fb->mask = (uint32_t)mask;
+    fb->head = 0;
+    split_delay(delay, period, interpolate, &fb->steps, &fb->frac);
+    dead_time_reset(fb, initial);
+
+    return 0;
+}
+
+void dead_time_release(DeadTimeFB* fb) {
+    if (fb) {
+        fb_pool_storage_free(fb->buffer);
+        fb->buffer = NULL;
+    }
+}
+
+DeadTimeFB* dead_time_create(double delay, double period, double max_delay,
+                             int interpolate, double initial) {
+    // 从实例池分配
+    DeadTimeFB* fb = (DeadTimeFB*)fb_pool_alloc(FB_TYPE_DEAD_TIME);
+    if (!fb) {
+        LOG_ERROR_MSG("纯滞后创建失败：实例池已满");
+        return NULL;
+    }
+
+    if (dead_time_init(fb, delay, period, max_delay, interpolate, initial) != 0) {
+        fb_pool_free(FB_TYPE_DEAD_TIME, fb);
+        return NULL;
+    }
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        dead_time_release(fb);
+        fb_pool_free(FB_TYPE_DEAD_TIME, fb);
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_DEAD_TIME, fb->base.id, FB_EVENT_CREATE, "delay,period,capacity", delay,
+               period, (double)(fb->mask + 1));
+
+    return fb;
+}
+
+void dead_time_destroy(DeadTimeFB* fb) {
+    if (fb) {
+        FB_JOURNAL_EVENT(FB_TYPE_DEAD_TIME, fb->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(fb->base.id);
+        dead_time_release(fb);
+        fb_pool_free(FB_TYPE_DEAD_TIME, fb);
+    }
+}
+
+double dead_time_compute(DeadTimeFB* fb, double input) {
+    if (!fb || !fb->buffer) {
+        return 0.0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    uint32_t head = (fb->head + 1) & fb->mask;
+    fb->buffer[head] = input;
+    fb->head = head;
+
+    double output = fb->buffer[(head - fb->steps) & fb->mask];
+    if (fb->frac > 0.0) {
+        double older = fb->buffer[(head - fb->steps - 1) & fb->mask];
+        output += fb->frac * (older - output);
+    }
+
+    fb->output = output;
+    return output;
+}
+
+int dead_time_set_delay(DeadTimeFB* fb, double delay) {
+    uint32_t steps;
+    double frac;
+
+    if (!fb) {
+        return -1;
+    }
+    if (split_delay(delay, fb->params.period, fb->params.interpolate, &steps, &frac) != 0 ||
+        rows_needed(steps, frac) > fb->mask + 1) {
+        LOG_ERROR_MSG("纯滞后延迟无效：ID=%u, delay=%.3f（最大 %.3f）", fb->base.id, delay,
+                      dead_time_max_delay(fb));
+        return -1;
+    }
+
+    fb->params.delay = delay;
+    fb->steps = steps;
+    fb->frac = frac;
+
+    FB_JOURNAL(FB_TYPE_DEAD_TIME, fb->base.id, FB_EVENT_PARAM, "delay", delay);
+
+    return 0;
+}
+
+double dead_time_max_delay(const DeadTimeFB* fb) {
+    return fb ? (double)fb->mask * fb->params.period : 0.0;
+}
+
+void dead_time_reset(DeadTimeFB* fb, double initial) {
+    if (fb && fb->buffer) {
+        fill(fb->buffer, (size_t)fb->mask + 1, initial);
+        fb->params.initial = initial;
+        fb->output = initial;
+        fb->base.last_update_time = 0.0;
+    }
+}
+
+/* ========== 批量形式 ========== */
+
+DeadTimeBank* dead_time_bank_create(size_t count, double delay, double period,
+                                    double max_delay, int interpolate, double initial) {
+    if (count == 0 || count > DEAD_TIME_BANK_MAX_CHANNELS) {
+        LOG_ERROR_MSG("批量纯滞后创建失败：通道数 %zu 超出范围", count);
+        return NULL;
+    }
+
+    interpolate = interpolate != 0;
+    int64_t mask = capacity_mask(delay, period, max_delay, interpolate);
+    if (mask < 0) {
+        LOG_ERROR_MSG("批量纯滞后参数无效：delay=%.3f, period=%.6f, max_delay=%.3f",
+                      delay, period, max_delay);
+        return NULL;
+    }
+
+    size_t rows = (size_t)mask + 1;
+    if (rows > SIZE_MAX / sizeof(double) / count) {
+        LOG_ERROR_MSG("批量纯滞后创建失败：缓冲区过大");
+        return NULL;
+    }
+
+    DeadTimeBank* bank = (DeadTimeBank*)calloc(1, sizeof(DeadTimeBank));
+    if (!bank) {
+        LOG_ERROR_MSG("批量纯滞后创建失败：内存分配失败");
+        return NULL;
+    }
+
+    bank->buffer = alloc_buffer(rows * count);
+    bank->delay = (double*)malloc(count * sizeof(double));
+    bank->steps = (uint32_t*)malloc(count * sizeof(uint32_t));
+    bank->frac = (double*)malloc(count * sizeof(double));
+    if (!bank->buffer || !bank->delay || !bank->steps || !bank->frac) {
+        LOG_ERROR_MSG("批量纯滞后创建失败：内存分配失败（%zu 个样本）", rows * count);
+        dead_time_bank_destroy(bank);
+        return NULL;
+    }
+
+    bank->count = count;
+    bank->period = period;
+    bank->initial = initial;
+    bank->interpolate = interpolate;
+    bank->mask = (uint32_t)mask;
+
+    uint32_t steps;
+    double frac;
+    split_delay(delay, period, interpolate, &steps, &frac);
+    for (size_t i = 0; i < count; i++) {
+        bank->delay[i] = delay;
+        bank->steps[i] = steps;
+        bank->frac[i] = frac;
+    }
+    dead_time_bank_reset(bank, initial);
+
+    return bank;
+}
+
+void dead_time_bank_destroy(DeadTimeBank* bank) {
+    if (bank) {
+        free(bank->buffer);
+        free(bank->delay);
+        free(bank->steps);
+        free(bank->frac);
+        free(bank);
+    }
+}
+
+void dead_time_bank_compute(DeadTimeBank* bank, const double* in, double* out) {
+    size_t count = bank->count;
+    uint32_t mask = bank->mask;
+    uint32_t head = (bank->head + 1) & mask;
+
+    // 整行写入本周期样本（in 与 out 可能相同，先写后读）
+    memcpy(bank->buffer + (size_t)head * count, in, count * sizeof(double));
+    bank->head = head;
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t steps = bank->steps[i];
+        double output = bank->buffer[(size_t)((head - steps) & mask) * count + i];
+        double frac = bank->frac[i];
+        if (frac > 0.0) {
+            double older = bank->buffer[(size_t)((head - steps - 1) & mask) * count + i];
+            output += frac * (older - output);
+        }
+        out[i] = output;
+    }
+}
+
+int dead_time_bank_set_delay(DeadTimeBank* bank, size_t index, double delay) {
+    uint32_t steps;
+    double frac;
+
+    if (!bank || index >= bank->count ||
+        split_delay(delay, bank->period, bank->interpolate, &steps, &frac) != 0 ||
+        rows_needed(steps, frac) > bank->mask + 1) {
+        return -1;
+    }
+
+    bank->delay[index] = delay;
+    bank->steps[index] = steps;
+    bank->frac[index] = frac;
+    return 0;
+}
+
+double dead_time_bank_max_delay(const DeadTimeBank* bank) {
+    return bank ? (double)bank->mask * bank->period : 0.0;
+}
+
+void dead_time_bank_reset(DeadTimeBank* bank, double initial) {
+    if (bank) {
+        fill(bank->buffer, ((size_t)bank->mask + 1) * bank->count, initial);
+        bank->initial = initial;
+    }
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_dead_time.h
+ * @brief 纯滞后（传输延迟）功能块接口
+ *
+ * 传递函数：H(s) = e^(-L*s)
+ * 每个控制周期写入一个样本，输出 L/period 个周期之前的输入，用于模拟
+ * 皮带输送、管道输送等传输延迟。样本保存在创建时预分配的环形缓冲区中，
+ * 容量为 2 的幂，下标用掩码回绕，每周期 O(1) 且不分配内存。
+ * L/period 不是整数时可选线性插值（否则按最近的整数周期延迟）。
+ *
+ * DeadTimeBank 把 n 个通道的缓冲区按行交错存放（每行 n 个通道的同一时刻样本），
+ * 每周期整行写入、逐通道按各自延迟读取，结果与单实例逐位一致。
+ */
+
+#ifndef FB_DEAD_TIME_H
+#define FB_DEAD_TIME_H
+
+#include "fb_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define DEAD_TIME_MAX_SAMPLES (1u << 24)     // 最大延迟周期数
+#define DEAD_TIME_BANK_MAX_CHANNELS (1u << 20)  // 批量形式最大通道数
+
+// 纯滞后参数
+typedef struct {
+    double delay;       // 延迟时间（秒）
+    double period;      // 采样周期（秒），即调用 compute 的间隔
+    double initial;     // 缓冲区初值（延迟时间内的输出）
+    int interpolate;    // 1：小数周期延迟线性插值
+} DeadTimeParams;
+
+// 纯滞后功能块
+typedef struct {
+    FunctionBlock base;
+    DeadTimeParams params;
+    double* buffer;     // 环形缓冲区，长度 mask + 1（2 的幂）
+    uint32_t mask;      // 容量 - 1
+    uint32_t head;      // 最新样本下标
+    uint32_t steps;     // 延迟的整数周期数
+    double frac;        // 延迟的小数部分（插值权重）
+    double output;      // 最近一次输出
+} DeadTimeFB;
+
+// 批量纯滞后（所有通道共用采样周期和缓冲区容量，延迟可各不相同）
+typedef struct {
+    size_t count;       // 通道数
+    double period;      // 采样周期（秒）
+    double initial;     // 缓冲区初值
+    int interpolate;    // 1：小数周期延迟线性插值
+    uint32_t mask;      // 行数 - 1
+    uint32_t head;      // 最新一行的下标
+    double* delay;      // 各通道延迟时间（秒）
+    uint32_t* steps;    // 各通道延迟的整数周期数
+    double* frac;       // 各通道延迟的小数部分
+    double* buffer;     // (mask + 1) 行 × count 列
+} DeadTimeBank;
+
+/**
+ * @brief 就地初始化纯滞后功能块并分配环形缓冲区
+ * @param fb 功能块指针
+ * @param delay 延迟时间（秒），>= 0
+ * @param period 采样周期（秒），> 0
+ * @param max_delay 允许在线调整到的最大延迟（秒），小于 delay 时取 delay
+ * @param interpolate 1 线性插值，0 取最近的整数周期
+ * @param initial 缓冲区初值
+ * @return 0 成功，-1 参数无效或内存分配失败
+ *
+ * 缓冲区需用 dead_time_release() 释放。
+ */
+int dead_time_init(DeadTimeFB* fb, double delay, double period, double max_delay,
+                   int interpolate, double initial);
+
+/**
+ * @brief 释放 dead_time_init() 分配的缓冲区
+ * @param fb 功能块指针
+ */
+void dead_time_release(DeadTimeFB* fb);
+
+/**
+ * @brief 从实例池创建纯滞后功能块
+ * @param delay 延迟时间（秒）
+ * @param period 采样周期（秒）
+ * @param max_delay 最大延迟（秒）
+ * @param interpolate 1 线性插值
+ * @param initial 缓冲区初值
+ * @return 功能块指针，参数无效、实例池已满或内存不足时返回 NULL
+ */
+DeadTimeFB* dead_time_create(double delay, double period, double max_delay,
+                             int interpolate, double initial);
+
+/**
+ * @brief 销毁纯滞后功能块
+ * @param fb 功能块指针
+ */
+void dead_time_destroy(DeadTimeFB* fb);
+
+/**
+ * @brief 写入本周期输入并输出延迟后的值（每个采样周期调用一次）
+ * @param fb 功能块指针
+ * @param input 输入信号
+ * @return 延迟 delay 秒后的输入
+ */
+double dead_time_compute(DeadTimeFB* fb, double input);
+
+/**
+ * @brief 在线修改延迟时间（不超过创建时的缓冲区容量）
+ * @param fb 功能块指针
+ * @param delay 延迟时间（秒）
+ * @return 0 成功，-1 延迟无效或超过最大延迟
+ */
+int dead_time_set_delay(DeadTimeFB* fb, double delay);
+
+/**
+ * @brief 获取可设置的最大延迟
+ * @param fb 功能块指针
+ * @return 最大延迟（秒）
+ */
+double dead_time_max_delay(const DeadTimeFB* fb);
+
+/**
+ * @brief 重置：缓冲区全部填充为 initial
+ * @param fb 功能块指针
+ * @param initial 填充值
+ */
+void dead_time_reset(DeadTimeFB* fb, double initial);
+
+/**
+ * @brief 创建批量纯滞后，所有通道使用相同的初始延迟
+ * @param count 通道数 [1, DEAD_TIME_BANK_MAX_CHANNELS]
+ * @param delay 延迟时间（秒）
+ * @param period 采样周期（秒）
+ * @param max_delay 最大延迟（秒），小于 delay 时取 delay
+ * @param interpolate 1 线性插值
+ * @param initial 缓冲区初值
+ * @return 批量实例指针，失败返回 NULL
+ */
+DeadTimeBank* dead_time_bank_create(size_t count, double delay, double period,
+                                    double max_delay, int interpolate, double initial);
+
+/**
+ * @brief 销毁批量纯滞后
+ * @param bank 批量实例指针
+ */
+void dead_time_bank_destroy(DeadTimeBank* bank);
+
+/**
+ * @brief 写入全部通道的本周期输入并输出延迟后的值
+ * @param bank 批量实例指针
+ * @param in 输入数组（长度 count）
+ * @param out 输出数组（长度 count，可与 in 相同）
+ */
+void dead_time_bank_compute(DeadTimeBank* bank, const double* in, double* out);
+
+/**
+ * @brief 修改单个通道的延迟时间
+ * @param bank 批量实例指针
+ * @param index 通道下标
+ * @param delay 延迟时间（秒）
+ * @return 0 成功，-1 下标越界、延迟无效或超过最大延迟
+ */
+int dead_time_bank_set_delay(DeadTimeBank* bank, size_t index, double delay);
+
+/**
+ * @brief 获取批量实例可设置的最大延迟
+ * @param bank 批量实例指针
+ * @return 最大延迟（秒）
+ */
+double dead_time_bank_max_delay(const DeadTimeBank* bank);
+
+/**
+ * @brief 重置：全部通道的缓冲区填充为 initial
+ * @param bank 批量实例指针
+ * @param initial 填充值
+ */
+void dead_time_bank_reset(DeadTimeBank* bank, double initial);
+
+#endif // FB_DEAD_TIME_H
@@ -27,28 +27,25 @@
  */
 
 #include "fb_first_order.h"
+#include "fb_pool.h"
+#include "fb_journal.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
 #include "../runtime/logger.h"
 #include <stdlib.h>
-#include <time.h>
 
 // 时间常数范围
 #define T_MIN 0.001
 #define T_MAX 1e6
 
-// 全局实例计数器
-static uint32_t g_fo_id_counter = 0;
-
-FirstOrderFunctionBlock* first_order_create(double T) {
-    // 分配内存
-    FirstOrderFunctionBlock* fo = (FirstOrderFunctionBlock*)malloc(sizeof(FirstOrderFunctionBlock));
+int first_order_init(FirstOrderFunctionBlock* fo, double T) {
     if (!fo) {
-        LOG_ERROR_MSG("一阶惯性创建失败：内存分配失败");
-        return NULL;
+        return -1;
     }
 
     // 初始化基础属性
     fo->base.type = FB_TYPE_FIRST_ORDER;
-    fo->base.id = ++g_fo_id_counter;
+    fo->base.id = 0;
     fo->base.last_update_time = 0.0;
 
     // 验证并设置参数
@@ -56,16 +53,35 @@ FirstOrderFunctionBlock* first_order_create(double T) {
 
     // 初始化状态
     fo->state.prev_output = 0.0;
+    fo->alpha_dt = 0.0;
 
-    LOG_INFO_MSG("一阶惯性创建成功：ID=%u, T=%.3f", fo->base.id, fo->params.T);
+    return 0;
+}
+
+FirstOrderFunctionBlock* first_order_create(double T) {
+    // 从实例池分配
+    FirstOrderFunctionBlock* fo = (FirstOrderFunctionBlock*)fb_pool_alloc(FB_TYPE_FIRST_ORDER);
+    if (!fo) {
+        LOG_ERROR_MSG("一阶惯性创建失败：实例池已满");
+        return NULL;
+    }
+
+    first_order_init(fo, T);
+    if (fb_registry_register(&fo->base, NULL, NULL) == 0) {
+        fb_pool_free(FB_TYPE_FIRST_ORDER, fo);
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_FIRST_ORDER, fo->base.id, FB_EVENT_CREATE, "T", fo->params.T);
 
     return fo;
 }
 
 void first_order_destroy(FirstOrderFunctionBlock* fo) {
     if (fo) {
-        LOG_INFO_MSG("一阶惯性销毁：ID=%u", fo->base.id);
-        free(fo);
+        FB_JOURNAL_EVENT(FB_TYPE_FIRST_ORDER, fo->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(fo->base.id);
+        fb_pool_free(FB_TYPE_FIRST_ORDER, fo);
     }
 }
 
@@ -74,31 +90,21 @@ double first_order_compute(FirstOrderFunctionBlock* fo, double input, double dt)
         return 0.0;
     }
 
+    FB_TIMED(&fo->base);
+
     // 如果 dt 为 0，自动计算时间差
     if (dt <= 0.0) {
-        struct timespec now;
-        clock_gettime(CLOCK_MONOTONIC, &now);
-        double current_time = now.tv_sec + now.tv_nsec / 1e9;
-
-        if (fo->base.last_update_time > 0.0) {
-            dt = current_time - fo->base.last_update_time;
-        } else {
-            dt = 0.1;  // 默认 100ms
-        }
-
-        fo->base.last_update_time = current_time;
+        dt = fb_auto_dt(&fo->base);
     }
 
-    // 计算 alpha = dt / (T + dt)
-    double alpha = dt / (fo->params.T + dt);
+    // alpha = dt / (T + dt)：固定周期调用时只在第一次计算
+    if (dt != fo->alpha_dt) {
+        fo->alpha = first_order_alpha(fo->params.T, dt);
+        fo->alpha_dt = dt;
+    }
 
     // 计算输出：Output = alpha * Input + (1 - alpha) * prev_output
-    double output = alpha * input + (1.0 - alpha) * fo->state.prev_output;
-
-    // 更新状态
-    fo->state.prev_output = output;
-
-    return output;
+    return first_order_kernel(&fo->state, fo->alpha, input);
 }
 
 int first_order_set_time_constant(FirstOrderFunctionBlock* fo, double T) {
@@ -107,8 +113,9 @@ int first_order_set_time_constant(FirstOrderFunctionBlock* fo, double T) {
     }
 
     fo->params.T = validate_and_clamp(T, T_MIN, T_MAX, "T");
+    fo->alpha_dt = 0.0;
 
-    LOG_INFO_MSG("一阶惯性参数更新：ID=%u, T=%.3f", fo->base.id, fo->params.T);
+    FB_JOURNAL(FB_TYPE_FIRST_ORDER, fo->base.id, FB_EVENT_PARAM, "T", fo->params.T);
 
     return 0;
 }
@@ -121,6 +128,6 @@ void first_order_reset(FirstOrderFunctionBlock* fo) {
     if (fo) {
         fo->state.prev_output = 0.0;
         fo->base.last_update_time = 0.0;
-        LOG_INFO_MSG("一阶惯性状态重置：ID=%u", fo->base.id);
+        FB_JOURNAL_EVENT(FB_TYPE_FIRST_ORDER, fo->base.id, FB_EVENT_RESET);
     }
 }
@@ -27,7 +27,7 @@
  *
  * 传递函数：H(s) = 1 / (T*s + 1)
  * 离散化：Output = alpha * Input + (1 - alpha) * prev_output
- *         其中 alpha = dt / (T + dt)
+ *         其中 alpha = dt / (T + dt)，只在 dt 或 T 变化时重新计算
  */
 
 #ifndef FB_FIRST_ORDER_H
@@ -35,23 +35,25 @@
 
 #include "fb_common.h"
 
-// 一阶惯性参数
-typedef struct {
-    double T;  // 时间常数（秒）[0.001, 1e6]
-} FirstOrderParams;
-
-// 一阶惯性状态
-typedef struct {
-    double prev_output;  // 上一周期输出值
-} FirstOrderState;
+// FirstOrderParams（T）和 FirstOrderState（prev_output）由 fb_kernels.h 按 double 实例化
 
 // 一阶惯性功能块
 typedef struct {
     FunctionBlock base;
     FirstOrderParams params;
     FirstOrderState state;
+    double alpha_dt;     // alpha 对应的 dt，0 表示需要重新计算
+    double alpha;        // 缓存的 dt / (T + dt)
 } FirstOrderFunctionBlock;
 
+/**
+ * @brief 就地初始化一阶惯性功能块（用于数组或内嵌存储，不分配内存）
+ * @param fo 功能块指针
+ * @param T 时间常数（秒）
+ * @return 0 成功，-1 失败
+ */
+int first_order_init(FirstOrderFunctionBlock* fo, double T);
+
 /**
  * @brief 创建一阶惯性功能块实例
  * @param T 时间常数（秒）
@@ -0,0 +1,588 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_iec.c
+ * @brief IEC 61131-3 标准功能块实现（定时器、计数器、边沿检测）
+ */
+
+#include "fb_iec.h"
+#include "fb_journal.h"
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
+#include "../runtime/logger.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IEC_COUNT_MAX 9007199254740992.0   // PV 上限（2^53，double 可精确表示）
+
+static const struct {
+    const char* name;
+    FunctionBlockType type;
+} IEC_TYPES[] = {
+    {"TON", FB_TYPE_TON},       {"TOF", FB_TYPE_TOF}, {"TP", FB_TYPE_TP},
+    {"CTU", FB_TYPE_CTU},       {"CTD", FB_TYPE_CTD},
+    {"R_TRIG", FB_TYPE_R_TRIG}, {"F_TRIG", FB_TYPE_F_TRIG},
+};
+
+#define IEC_TYPE_COUNT (sizeof(IEC_TYPES) / sizeof(IEC_TYPES[0]))
+
+int iec_is_timer(FunctionBlockType type) {
+    return type == FB_TYPE_TON || type == FB_TYPE_TOF || type == FB_TYPE_TP;
+}
+
+int iec_is_counter(FunctionBlockType type) {
+    return type == FB_TYPE_CTU || type == FB_TYPE_CTD;
+}
+
+int iec_is_trigger(FunctionBlockType type) {
+    return type == FB_TYPE_R_TRIG || type == FB_TYPE_F_TRIG;
+}
+
+int iec_parse_type(const char* name, FunctionBlockType* type) {
+    for (size_t i = 0; name && i < IEC_TYPE_COUNT; i++) {
+        if (strcmp(IEC_TYPES[i].name, name) == 0) {
+            *type = IEC_TYPES[i].type;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+const char* iec_type_name(FunctionBlockType type) {
+    for (size_t i = 0; i < IEC_TYPE_COUNT; i++) {
+        if (IEC_TYPES[i].type == type) {
+            return IEC_TYPES[i].name;
+        }
+    }
+    return "?";
+}
+
+int iec_time_from_seconds(double seconds, int64_t* ns) {
+    if (!(seconds >= 0.0 && seconds <= IEC_TIME_MAX)) {
+        return -1;
+    }
+    *ns = llround(seconds * 1e9);
+    return 0;
+}
+
+// 时间步长换算为纳秒；非正数（含 NaN）按 0 处理
+static inline int64_t step_ns(double dt) {
+    if (!(dt > 0.0)) {
+        return 0;
+    }
+    return dt < IEC_TIME_MAX ? llround(dt * 1e9) : (int64_t)(IEC_TIME_MAX * 1e9);
+}
+
+// 预设值换算：定时器为纳秒，计数器须为整数
+static int preset_from_double(FunctionBlockType type, double preset, int64_t* out) {
+    if (iec_is_timer(type)) {
+        return iec_time_from_seconds(preset, out);
+    }
+    if (iec_is_counter(type) && fabs(preset) <= IEC_COUNT_MAX && preset == floor(preset)) {
+        *out = (int64_t)preset;
+        return 0;
+    }
+    return -1;
+}
+
+/* ========== 单周期逻辑（单实例与批量形式共用） ========== */
+
+static inline int64_t advance(int64_t et, int64_t dt, int64_t pt) {
+    return et < pt - dt ? et + dt : pt;
+}
+
+static inline int ton_step(int in, int prev, int64_t* et, int64_t pt, int64_t dt) {
+    if (!in) {
+        *et = 0;
+        return 0;
+    }
+    *et = prev ? advance(*et, dt, pt) : 0;   // 上升沿所在周期从 0 开始计时
+    return *et >= pt;
+}
+
+static inline int tof_step(int in, int prev, int q, int64_t* et, int64_t pt, int64_t dt) {
+    if (in) {
+        *et = 0;
+        return 1;
+    }
+    if (prev) {                              // 下降沿：开始计时
+        *et = 0;
+        return pt > 0;
+    }
+    if (q) {
+        *et = advance(*et, dt, pt);
+        return *et < pt;
+    }
+    return 0;                                // 计时结束后 ET 保持 PT
+}
+
+static inline int tp_step(int in, int prev, int q, int64_t* et, int64_t pt, int64_t dt) {
+    if (q) {                                 // 脉冲期间不可重触发
+        *et = advance(*et, dt, pt);
+        return *et < pt;
+    }
+    if (in && !prev) {
+        *et = 0;
+        return pt > 0;
+    }
+    if (!in) {
+        *et = 0;                             // 脉冲结束且 IN 为假时 ET 复位
+    }
+    return 0;
+}
+
+static inline int ctu_step(int cu, int prev, int reset, int64_t* cv, int64_t pv) {
+    if (reset) {
+        *cv = 0;
+    } else if (cu && !prev && *cv < INT64_MAX) {
+        (*cv)++;
+    }
+    return *cv >= pv;
+}
+
+static inline int ctd_step(int cd, int prev, int load, int64_t* cv, int64_t pv) {
+    if (load) {
+        *cv = pv;
+    } else if (cd && !prev && *cv > INT64_MIN) {
+        (*cv)--;
+    }
+    return *cv <= 0;
+}
+
+/* ========== 定时器 ========== */
+
+int iec_timer_init(TimerFB* fb, FunctionBlockType type, double PT) {
+    int64_t pt;
+    if (!fb || !iec_is_timer(type) || iec_time_from_seconds(PT, &pt) != 0) {
+        return -1;
+    }
+
+    memset(fb, 0, sizeof(*fb));
+    fb->base.type = type;
+    fb->PT = pt;
+    return 0;
+}
+
+TimerFB* iec_timer_create(FunctionBlockType type, double PT) {
+    if (!iec_is_timer(type)) {
+        return NULL;
+    }
+
+    TimerFB* fb = (TimerFB*)fb_pool_alloc(type);
+    if (!fb) {
+        LOG_ERROR_MSG("%s 创建失败：实例池已满", iec_type_name(type));
+        return NULL;
+    }
+
+    if (iec_timer_init(fb, type, PT) != 0) {
+        LOG_ERROR_MSG("%s 参数无效：PT=%.6f", iec_type_name(type), PT);
+        fb_pool_free(type, fb);
+        return NULL;
+    }
+
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        fb_pool_free(type, fb);
+        return NULL;
+    }
+
+    FB_JOURNAL(type, fb->base.id, FB_EVENT_CREATE, "PT", PT);
+    return fb;
+}
+
+void iec_timer_destroy(TimerFB* fb) {
+    if (fb) {
+        FB_JOURNAL_EVENT(fb->base.type, fb->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(fb->base.id);
+        fb_pool_free(fb->base.type, fb);
+    }
+}
+
+int iec_timer_compute(TimerFB* fb, int in, double dt) {
+    if (!fb) {
+        return 0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    if (dt <= 0.0) {
+        dt = fb_auto_dt(&fb->base);
+    }
+    int64_t step = step_ns(dt);
+    in = in != 0;
+
+    switch (fb->base.type) {
+    case FB_TYPE_TON:
+        fb->Q = ton_step(in, fb->IN, &fb->ET, fb->PT, step);
+        break;
+    case FB_TYPE_TOF:
+        fb->Q = tof_step(in, fb->IN, fb->Q, &fb->ET, fb->PT, step);
+        break;
+    default:
+        fb->Q = tp_step(in, fb->IN, fb->Q, &fb->ET, fb->PT, step);
+        break;
+    }
+    fb->IN = in;
+    return fb->Q;
+}
+
+int iec_timer_set_preset(TimerFB* fb, double PT) {
+    int64_t pt;
+    if (!fb || iec_time_from_seconds(PT, &pt) != 0) {
+        return -1;
+    }
+    fb->PT = pt;
+    if (fb->ET > pt) {
+        fb->ET = pt;
+    }
+    return 0;
+}
+
+void iec_timer_reset(TimerFB* fb) {
+    if (fb) {
+        fb->ET = 0;
+        fb->IN = 0;
+        fb->Q = 0;
+        fb->base.last_update_time = 0.0;
+    }
+}
+
+/* ========== 计数器 ========== */
+
+static int counter_output(const CounterFB* fb) {
+    return fb->base.type == FB_TYPE_CTU ? fb->CV >= fb->PV : fb->CV <= 0;
+}
+
+int iec_counter_init(CounterFB* fb, FunctionBlockType type, int64_t PV) {
+    if (!fb || !iec_is_counter(type)) {
+        return -1;
+    }
+
+    memset(fb, 0, sizeof(*fb));
+    fb->base.type = type;
+    fb->PV = PV;
+    fb->Q = counter_output(fb);
+    return 0;
+}
+
+CounterFB* iec_counter_create(FunctionBlockType type, int64_t PV) {
+    if (!iec_is_counter(type)) {
+        return NULL;
+    }
+
+    CounterFB* fb = (CounterFB*)fb_pool_alloc(type);
+    if (!fb) {
+        LOG_ERROR_MSG("%s 创建失败：实例池已满", iec_type_name(type));
+        return NULL;
+    }
+
+    iec_counter_init(fb, type, PV);
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        fb_pool_free(type, fb);
+        return NULL;
+    }
+
+    FB_JOURNAL(type, fb->base.id, FB_EVENT_CREATE, "PV", (double)PV);
+    return fb;
+}
+
+void iec_counter_destroy(CounterFB* fb) {
+    if (fb) {
+        FB_JOURNAL_EVENT(fb->base.type, fb->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(fb->base.id);
+        fb_pool_free(fb->base.type, fb);
+    }
+}
+
+int iec_counter_compute(CounterFB* fb, int count, int load) {
+    if (!fb) {
+        return 0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    count = count != 0;
+    if (fb->base.type == FB_TYPE_CTU) {
+        fb->Q = ctu_step(count, fb->prev, load, &fb->CV, fb->PV);
+    } else {
+        fb->Q = ctd_step(count, fb->prev, load, &fb->CV, fb->PV);
+    }
+    fb->prev = count;
+    return fb->Q;
+}
+
+void iec_counter_set_preset(CounterFB* fb, int64_t PV) {
+    if (fb) {
+        fb->PV = PV;
+        fb->Q = counter_output(fb);
+    }
+}
+
+void iec_counter_reset(CounterFB* fb) {
+    if (fb) {
+        fb->CV = 0;
+        fb->prev = 0;
+        fb->Q = counter_output(fb);
+    }
+}
+
+/* ========== 边沿检测 ========== */
+
+int iec_trigger_init(TriggerFB* fb, FunctionBlockType type) {
+    if (!fb || !iec_is_trigger(type)) {
+        return -1;
+    }
+
+    memset(fb, 0, sizeof(*fb));
+    fb->base.type = type;
+    return 0;
+}
+
+TriggerFB* iec_trigger_create(FunctionBlockType type) {
+    if (!iec_is_trigger(type)) {
+        return NULL;
+    }
+
+    TriggerFB* fb = (TriggerFB*)fb_pool_alloc(type);
+    if (!fb) {
+        LOG_ERROR_MSG("%s 创建失败：实例池已满", iec_type_name(type));
+        return NULL;
+    }
+
+    iec_trigger_init(fb, type);
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        fb_pool_free(type, fb);
+        return NULL;
+    }
+
+    FB_JOURNAL_EVENT(type, fb->base.id, FB_EVENT_CREATE);
+    return fb;
+}
+
+void iec_trigger_destroy(TriggerFB* fb) {
+    if (fb) {
+        FB_JOURNAL_EVENT(fb->base.type, fb->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(fb->base.id);
+        fb_pool_free(fb->base.type, fb);
+    }
+}
+
+int iec_trigger_compute(TriggerFB* fb, int clk) {
+    if (!fb) {
+        return 0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    clk = clk != 0;
+    fb->Q = fb->base.type == FB_TYPE_R_TRIG ? clk && !fb->prev : !clk && fb->prev;
+    fb->prev = clk;
+    return fb->Q;
+}
+
+void iec_trigger_reset(TriggerFB* fb) {
+    if (fb) {
+        fb->prev = 0;
+        fb->Q = 0;
+    }
+}
+
+/* ========== 批量形式 ========== */
+
+IECBank* iec_bank_create(FunctionBlockType type, size_t count, double preset) {
+    if (!iec_is_timer(type) && !iec_is_counter(type) && !iec_is_trigger(type)) {
+        return NULL;
+    }
+    if (count == 0 || count > IEC_BANK_MAX_CHANNELS) {
+        LOG_ERROR_MSG("批量 %s 创建失败：通道数 %zu 超出范围", iec_type_name(type), count);
+        return NULL;
+    }
+
+    int64_t initial = 0;
+    if (!iec_is_trigger(type) && preset_from_double(type, preset, &initial) != 0) {
+        LOG_ERROR_MSG("批量 %s 参数无效：预设值 %.6f", iec_type_name(type), preset);
+        return NULL;
+    }
+
+    IECBank* bank = (IECBank*)calloc(1, sizeof(IECBank));
+    if (!bank) {
+        LOG_ERROR_MSG("批量 %s 创建失败：内存分配失败", iec_type_name(type));
+        return NULL;
+    }
+
+    bank->preset = (int64_t*)malloc(count * sizeof(int64_t));
+    bank->value = (int64_t*)calloc(count, sizeof(int64_t));
+    bank->prev = (uint8_t*)calloc(count, 1);
+    bank->q = (uint8_t*)calloc(count, 1);
+    if (!bank->preset || !bank->value || !bank->prev || !bank->q) {
+        LOG_ERROR_MSG("批量 %s 创建失败：内存分配失败（%zu 个通道）", iec_type_name(type), count);
+        iec_bank_destroy(bank);
+        return NULL;
+    }
+
+    bank->type = type;
+    bank->count = count;
+    for (size_t i = 0; i < count; i++) {
+        bank->preset[i] = initial;
+    }
+    iec_bank_reset(bank);
+    return bank;
+}
+
+void iec_bank_destroy(IECBank* bank) {
+    if (bank) {
+        free(bank->preset);
+        free(bank->value);
+        free(bank->prev);
+        free(bank->q);
+        free(bank);
+    }
+}
+
+void iec_bank_compute(IECBank* bank, const double* in, const double* load, double* out,
+                      double dt) {
+    if (!bank || !in || !out) {
+        return;
+    }
+
+    // 所有通道共用一次 dt 计算
+    int64_t step = 0;
+    if (iec_is_timer(bank->type)) {
+        if (dt <= 0.0) {
+            dt = fb_auto_dt(&bank->clock);
+        }
+        step = step_ns(dt);
+    }
+
+    size_t n = bank->count;
+    int64_t* restrict pv = bank->preset;
+    int64_t* restrict value = bank->value;
+    uint8_t* restrict prev = bank->prev;
+    uint8_t* restrict q = bank->q;
+
+    // 类型分支放在循环外，每种类型一个紧凑循环
+    switch (bank->type) {
+    case FB_TYPE_TON:
+        for (size_t i = 0; i < n; i++) {
+            int x = in[i] != 0.0;
+            q[i] = (uint8_t)ton_step(x, prev[i], &value[i], pv[i], step);
+            prev[i] = (uint8_t)x;
+            out[i] = q[i];
+        }
+        break;
+    case FB_TYPE_TOF:
+        for (size_t i = 0; i < n; i++) {
+            int x = in[i] != 0.0;
+            q[i] = (uint8_t)tof_step(x, prev[i], q[i], &value[i], pv[i], step);
+            prev[i] = (uint8_t)x;
+            out[i] = q[i];
+        }
+        break;
+    case FB_TYPE_TP:
+        for (size_t i = 0; i < n; i++) {
+            int x = in[i] != 0.0;
+            q[i] = (uint8_t)tp_step(x, prev[i], q[i], &value[i], pv[i], step);
+            prev[i] = (uint8_t)x;
+            out[i] = q[i];
+        }
+        break;
+    case FB_TYPE_CTU:
+        for (size_t i = 0; i < n; i++) {
+            int x = in[i] != 0.0;
+            q[i] = (uint8_t)ctu_step(x, prev[i], load && load[i] != 0.0, &value[i], pv[i]);
+            prev[i] = (uint8_t)x;
+            out[i] = q[i];
+        }
+        break;
+    case FB_TYPE_CTD:
+        for (size_t i = 0; i < n; i++) {
+            int x = in[i] != 0.0;
+            q[i] = (uint8_t)ctd_step(x, prev[i], load && load[i] != 0.0, &value[i], pv[i]);
+            prev[i] = (uint8_t)x;
+            out[i] = q[i];
+        }
+        break;
+    case FB_TYPE_R_TRIG:
+        for (size_t i = 0; i < n; i++) {
+            int x = in[i] != 0.0;
+            q[i] = (uint8_t)(x && !prev[i]);
+            prev[i] = (uint8_t)x;
+            out[i] = q[i];
+        }
+        break;
+    default:
+        for (size_t i = 0; i < n; i++) {
+            int x = in[i] != 0.0;
+            q[i] = (uint8_t)(!x && prev[i]);
+            prev[i] = (uint8_t)x;
+            out[i] = q[i];
+        }
+        break;
+    }
+}
+
+int iec_bank_set_preset(IECBank* bank, size_t index, double preset) {
+    int64_t value;
+    if (!bank || index >= bank->count || preset_from_double(bank->type, preset, &value) != 0) {
+        return -1;
+    }
+
+    bank->preset[index] = value;
+    if (iec_is_timer(bank->type) && bank->value[index] > value) {
+        bank->value[index] = value;
+    }
+    return 0;
+}
+
+double iec_bank_get_preset(const IECBank* bank, size_t index) {
+    if (!bank || index >= bank->count) {
+        return 0.0;
+    }
+    double p = (double)bank->preset[index];
+    return iec_is_timer(bank->type) ? p / 1e9 : p;
+}
+
+double iec_bank_get_value(const IECBank* bank, size_t index) {
+    if (!bank || index >= bank->count) {
+        return 0.0;
+    }
+    double v = (double)bank->value[index];
+    return iec_is_timer(bank->type) ? v / 1e9 : v;
+}
+
+void iec_bank_reset(IECBank* bank) {
+    if (!bank) {
+        return;
+    }
+
+    memset(bank->value, 0, bank->count * sizeof(int64_t));
+    memset(bank->prev, 0, bank->count);
+    for (size_t i = 0; i < bank->count; i++) {
+        // 计数器复位后的 Q 与单实例初始状态一致（CTU：0 >= PV；CTD：恒为真）
+        bank->q[i] = (uint8_t)(bank->type == FB_TYPE_CTU ? bank->preset[i] <= 0
+                                : bank->type == FB_TYPE_CTD);
+    }
+    bank->clock.last_update_time = 0.0;
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_iec.h
+ * @brief IEC 61131-3 标准功能块：定时器、计数器、边沿检测
+ *
+ *   - TON（接通延时）：IN 持续为真达到 PT 后 Q 为真，IN 为假时复位；
+ *   - TOF（断开延时）：IN 为真时 Q 为真，IN 变假后再保持 PT；
+ *   - TP（脉冲）：IN 上升沿触发宽度为 PT 的脉冲，脉冲期间不可重触发；
+ *   - CTU / CTD：CU / CD 上升沿加 / 减计数，R 清零 / LD 装入 PV；
+ *   - R_TRIG / F_TRIG：CLK 的上升 / 下降沿输出一个周期的 Q。
+ *
+ * 定时器不读墙上时钟，而是累加每周期的时间步长 dt（dt 为 0 时由功能块
+ * 时钟 fb_auto_dt() 给出：平时为单调时钟，录制/回放时锁存为周期时间），
+ * 不受系统校时影响，回放时逐位复现。时间在内部按整数纳秒累加，PT 为
+ * 周期整数倍时不会因浮点舍入晚一个周期。上升沿所在周期 ET 为 0。
+ *
+ * IECBank 把同一类型的 n 个实例按结构数组存放，每周期一次循环处理全部
+ * 通道（所有通道共用一次 dt），结果与逐个调用单实例一致。
+ */
+
+#ifndef FB_IEC_H
+#define FB_IEC_H
+
+#include "fb_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define IEC_TIME_MAX 1e9                  // PT 上限（秒）
+#define IEC_BANK_MAX_CHANNELS (1u << 20)  // 批量形式最大通道数
+
+// 定时器（TON / TOF / TP，由 base.type 区分）
+typedef struct {
+    FunctionBlock base;
+    int64_t PT;          // 预设时间（纳秒）
+    int64_t ET;          // 已计时（纳秒）
+    int IN;              // 上一周期的输入
+    int Q;               // 输出
+} TimerFB;
+
+// 计数器（CTU / CTD，由 base.type 区分）
+typedef struct {
+    FunctionBlock base;
+    int64_t PV;          // 预设值
+    int64_t CV;          // 当前计数
+    int prev;            // 上一周期的计数输入（CU / CD）
+    int Q;               // CTU：CV >= PV；CTD：CV <= 0
+} CounterFB;
+
+// 边沿检测（R_TRIG / F_TRIG，由 base.type 区分）
+typedef struct {
+    FunctionBlock base;
+    int prev;            // 上一周期的 CLK（初值为假，F_TRIG 首周期不触发）
+    int Q;
+} TriggerFB;
+
+// 批量形式：同一类型的 n 个实例，状态按 SoA 存放
+typedef struct {
+    FunctionBlockType type;  // FB_TYPE_TON ... FB_TYPE_F_TRIG
+    size_t count;            // 通道数
+    int64_t* preset;         // PT（纳秒）或 PV；边沿检测不使用
+    int64_t* value;          // ET（纳秒）或 CV
+    uint8_t* prev;           // 上一周期的输入
+    uint8_t* q;              // 输出
+    FunctionBlock clock;     // dt 自动计算的共用时间戳
+} IECBank;
+
+/**
+ * @brief 类型是否为定时器（TON / TOF / TP）
+ */
+int iec_is_timer(FunctionBlockType type);
+
+/**
+ * @brief 类型是否为计数器（CTU / CTD）
+ */
+int iec_is_counter(FunctionBlockType type);
+
+/**
+ * @brief 类型是否为边沿检测（R_TRIG / F_TRIG）
+ */
+int iec_is_trigger(FunctionBlockType type);
+
+/**
+ * @brief 按名称解析类型
+ * @param name "TON"、"TOF"、"TP"、"CTU"、"CTD"、"R_TRIG" 或 "F_TRIG"
+ * @param type 输出功能块类型
+ * @return 0 成功，-1 未知名称
+ */
+int iec_parse_type(const char* name, FunctionBlockType* type);
+
+/**
+ * @brief 类型名称
+ * @return 名称，非 IEC 标准功能块类型返回 "?"
+ */
+const char* iec_type_name(FunctionBlockType type);
+
+/**
+ * @brief 秒转换为内部纳秒计时
+ * @param seconds 时间（秒），须为 [0, IEC_TIME_MAX] 内的有限值
+ * @param ns 输出纳秒数
+ * @return 0 成功，-1 超出范围
+ */
+int iec_time_from_seconds(double seconds, int64_t* ns);
+
+/**
+ * @brief 初始化定时器
+ * @param fb 定时器
+ * @param type FB_TYPE_TON、FB_TYPE_TOF 或 FB_TYPE_TP
+ * @param PT 预设时间（秒）
+ * @return 0 成功，-1 参数无效
+ */
+int iec_timer_init(TimerFB* fb, FunctionBlockType type, double PT);
+
+/**
+ * @brief 从实例池创建定时器
+ * @return 功能块指针，参数无效或实例池已满时返回 NULL
+ */
+TimerFB* iec_timer_create(FunctionBlockType type, double PT);
+
+/**
+ * @brief 销毁定时器
+ */
+void iec_timer_destroy(TimerFB* fb);
+
+/**
+ * @brief 执行一个周期
+ * @param fb 定时器
+ * @param in 输入 IN（非 0 为真）
+ * @param dt 距上个周期的时间（秒），0 表示按功能块时钟自动计算
+ * @return 输出 Q
+ */
+int iec_timer_compute(TimerFB* fb, int in, double dt);
+
+/**
+ * @brief 修改预设时间（正在计时的实例按新 PT 判断）
+ * @return 0 成功，-1 取值无效
+ */
+int iec_timer_set_preset(TimerFB* fb, double PT);
+
+/**
+ * @brief 复位为初始状态（Q 为假、ET 为 0）
+ */
+void iec_timer_reset(TimerFB* fb);
+
+/**
+ * @brief 初始化计数器
+ * @param fb 计数器
+ * @param type FB_TYPE_CTU 或 FB_TYPE_CTD
+ * @param PV 预设值
+ * @return 0 成功，-1 类型无效
+ */
+int iec_counter_init(CounterFB* fb, FunctionBlockType type, int64_t PV);
+
+/**
+ * @brief 从实例池创建计数器
+ * @return 功能块指针，参数无效或实例池已满时返回 NULL
+ */
+CounterFB* iec_counter_create(FunctionBlockType type, int64_t PV);
+
+/**
+ * @brief 销毁计数器
+ */
+void iec_counter_destroy(CounterFB* fb);
+
+/**
+ * @brief 执行一个周期
+ * @param fb 计数器
+ * @param count 计数输入 CU / CD（上升沿计数）
+ * @param load CTU 为复位 R（CV 清零），CTD 为装入 LD（CV = PV），优先于计数
+ * @return 输出 Q
+ */
+int iec_counter_compute(CounterFB* fb, int count, int load);
+
+/**
+ * @brief 修改预设值（立即按新 PV 更新 Q）
+ */
+void iec_counter_set_preset(CounterFB* fb, int64_t PV);
+
+/**
+ * @brief 复位为初始状态（CV 为 0）
+ */
+void iec_counter_reset(CounterFB* fb);
+
+/**
+ * @brief 初始化边沿检测
+ * @param fb 边沿检测
+ * @param type FB_TYPE_R_TRIG 或 FB_TYPE_F_TRIG
+ * @return 0 成功，-1 类型无效
+ */
+int iec_trigger_init(TriggerFB* fb, FunctionBlockType type);
+
+/**
+ * @brief 从实例池创建边沿检测
+ * @return 功能块指针，类型无效或实例池已满时返回 NULL
+ */
+TriggerFB* iec_trigger_create(FunctionBlockType type);
+
+/**
+ * @brief 销毁边沿检测
+ */
+void iec_trigger_destroy(TriggerFB* fb);
+
+/**
+ * @brief 执行一个周期
+ * @param fb 边沿检测
+ * @param clk 输入 CLK
+ * @return 输出 Q（检测到对应边沿的周期为真）
+ */
+int iec_trigger_compute(TriggerFB* fb, int clk);
+
+/**
+ * @brief 复位为初始状态（上一周期 CLK 视为假）
+ */
+void iec_trigger_reset(TriggerFB* fb);
+
+/**
+ * @brief 创建批量实例
+ * @param type 功能块类型（FB_TYPE_TON ... FB_TYPE_F_TRIG）
+ * @param count 通道数 [1, IEC_BANK_MAX_CHANNELS]
+ * @param preset 全部通道的 PT（秒，定时器）或 PV（计数器），边沿检测忽略
+ * @return 批量实例，参数无效或内存不足时返回 NULL
+ */
+IECBank* iec_bank_create(FunctionBlockType type, size_t count, double preset);
+
+/**
+ * @brief 销毁批量实例
+ */
+void iec_bank_destroy(IECBank* bank);
+
+/**
+ * @brief 执行一个周期
+ * @param bank 批量实例
+ * @param in 各通道输入（IN / CU / CD / CLK，非 0 为真）
+ * @param load 各通道的 R（CTU）或 LD（CTD），NULL 表示全部为假；其他类型忽略
+ * @param out 各通道输出 Q（1.0 / 0.0），可与 in 相同
+ * @param dt 距上个周期的时间（秒），0 表示自动计算；只对定时器有意义
+ */
+void iec_bank_compute(IECBank* bank, const double* in, const double* load, double* out,
+                      double dt);
+
+/**
+ * @brief 修改单个通道的预设值
+ * @param bank 批量实例
+ * @param index 通道下标
+ * @param preset PT（秒）或 PV
+ * @return 0 成功，-1 下标或取值无效，或类型没有预设值
+ */
+int iec_bank_set_preset(IECBank* bank, size_t index, double preset);
+
+/**
+ * @brief 读取单个通道的预设值（PT 为秒）
+ */
+double iec_bank_get_preset(const IECBank* bank, size_t index);
+
+/**
+ * @brief 读取单个通道的 ET（秒）或 CV
+ */
+double iec_bank_get_value(const IECBank* bank, size_t index);
+
+/**
+ * @brief 复位全部通道
+ */
+void iec_bank_reset(IECBank* bank);
+
+#endif // FB_IEC_H
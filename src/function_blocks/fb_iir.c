@@ -0,0 +1,523 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_iir.c
+ * @brief 离散传递函数（级联二阶节 IIR）功能块实现
+ */
+
+#include "fb_iir.h"
+#include "fb_journal.h"
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
+#include "../runtime/logger.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IIR_X86 1
+#endif
+
+// 采样周期上限（秒）
+#define IIR_PERIOD_MAX 1e9
+
+// 状态数组对齐（缓存行）与每个缓存行容纳的 double 个数
+#define IIR_BANK_ALIGN 64
+#define IIR_BANK_LINE_DOUBLES (IIR_BANK_ALIGN / sizeof(double))
+
+// 批量形式第 s 节的 s1 / s2 数组
+#define BANK_S1(b, s) ((b)->state + (size_t)(2 * (s)) * (b)->capacity)
+#define BANK_S2(b, s) (BANK_S1(b, s) + (b)->capacity)
+
+// 内核：计算 [0, n) 中按向量宽度对齐的部分，返回已处理的通道数
+typedef size_t (*IIRBankKernel)(IIRBank* bank, const double* in, double* out, size_t n);
+
+static IIRBankKernel g_kernel = NULL;
+static const char* g_kernel_name = "scalar";
+
+/* ========== 系数设计 ========== */
+
+// s 多项式 {p0*s^2 + p1*s + p2} 的阶次
+static int analog_order(const double* p) {
+    return p[0] != 0.0 ? 2 : p[1] != 0.0 ? 1 : 0;
+}
+
+// 双线性变换 s = K*(1 - z^-1)/(1 + z^-1)，多项式乘以 (1 + z^-1)^order 后的 z^-k 系数
+static void tustin(const double* p, int order, double K, double* q) {
+    if (order == 2) {
+        double c2 = p[0] * K * K;
+        double c1 = p[1] * K;
+        q[0] = c2 + c1 + p[2];
+        q[1] = 2.0 * (p[2] - c2);
+        q[2] = c2 - c1 + p[2];
+    } else if (order == 1) {
+        double c1 = p[1] * K;
+        q[0] = c1 + p[2];
+        q[1] = p[2] - c1;
+        q[2] = 0.0;
+    } else {
+        q[0] = p[2];
+        q[1] = 0.0;
+        q[2] = 0.0;
+    }
+}
+
+// 单个二阶节离散化并归一化 a0
+static int design_section(IIRSection* c, const IIRPrototype* p, int analog, double period) {
+    double b[3], a[3];
+
+    for (int k = 0; k < 3; k++) {
+        if (!isfinite(p->b[k]) || !isfinite(p->a[k])) {
+            return -1;
+        }
+    }
+
+    if (analog) {
+        // 分子阶次不能高于分母（真分式）；分子分母按分母阶次同乘
+        int order = analog_order(p->a);
+        if (analog_order(p->b) > order) {
+            return -1;
+        }
+        double K = 2.0 / period;
+        tustin(p->b, order, K, b);
+        tustin(p->a, order, K, a);
+    } else {
+        memcpy(b, p->b, sizeof(b));
+        memcpy(a, p->a, sizeof(a));
+    }
+
+    if (a[0] == 0.0) {
+        return -1;
+    }
+
+    c->b0 = b[0] / a[0];
+    c->b1 = b[1] / a[0];
+    c->b2 = b[2] / a[0];
+    c->a1 = a[1] / a[0];
+    c->a2 = a[2] / a[0];
+
+    return isfinite(c->b0) && isfinite(c->b1) && isfinite(c->b2) &&
+           isfinite(c->a1) && isfinite(c->a2) ? 0 : -1;
+}
+
+int iir_design(IIRSection* coef, const IIRPrototype* proto, uint32_t sections,
+               int analog, double period) {
+    if (!coef || !proto || sections == 0 || sections > IIR_MAX_SECTIONS) {
+        return -1;
+    }
+    if (analog && !(period > 0.0 && period < IIR_PERIOD_MAX)) {
+        return -1;
+    }
+
+    // 全部节设计成功后才写入，失败时调用者的系数保持不变
+    IIRSection tmp[IIR_MAX_SECTIONS];
+    for (uint32_t s = 0; s < sections; s++) {
+        if (design_section(&tmp[s], &proto[s], analog, period) != 0) {
+            return -1;
+        }
+    }
+    memcpy(coef, tmp, sections * sizeof(IIRSection));
+    return 0;
+}
+
+// 输入恒为 x 时单节的稳态：y = G*x，s2 = b2*x - a2*y，s1 = b1*x - a1*y + s2
+static double steady_state(const IIRSection* c, double x, double* s1, double* s2) {
+    double den = 1.0 + c->a1 + c->a2;
+
+    // 零输入或直流增益无穷大（积分环节）时状态清零
+    if (x == 0.0 || den == 0.0) {
+        *s1 = 0.0;
+        *s2 = 0.0;
+        return 0.0;
+    }
+
+    double y = (c->b0 + c->b1 + c->b2) / den * x;
+    *s2 = c->b2 * x - c->a2 * y;
+    *s1 = c->b1 * x - c->a1 * y + *s2;
+    return y;
+}
+
+/* ========== 单实例 ========== */
+
+int iir_init(IIRFB* fb, const IIRPrototype* proto, uint32_t sections, int analog,
+             double period) {
+    if (!fb || !(period >= 0.0 && period < IIR_PERIOD_MAX) ||
+        iir_design(fb->coef, proto, sections, analog, period) != 0) {
+        return -1;
+    }
+
+    fb->base.type = FB_TYPE_IIR;
+    fb->base.id = 0;
+    fb->base.last_update_time = 0.0;
+    fb->sections = sections;
+    fb->analog = analog != 0;
+    fb->period = period;
+    memcpy(fb->proto, proto, sections * sizeof(IIRPrototype));
+    iir_reset(fb, 0.0);
+
+    return 0;
+}
+
+IIRFB* iir_create(const IIRPrototype* proto, uint32_t sections, int analog, double period) {
+    IIRFB* fb = (IIRFB*)fb_pool_alloc(FB_TYPE_IIR);
+    if (!fb) {
+        LOG_ERROR_MSG("IIR 创建失败：实例池已满");
+        return NULL;
+    }
+
+    if (iir_init(fb, proto, sections, analog, period) != 0) {
+        LOG_ERROR_MSG("IIR 创建失败：系数无效（%u 节, period=%.6f）", sections, period);
+        fb_pool_free(FB_TYPE_IIR, fb);
+        return NULL;
+    }
+
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        fb_pool_free(FB_TYPE_IIR, fb);
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_IIR, fb->base.id, FB_EVENT_CREATE, "sections,analog,period",
+               (double)sections, (double)fb->analog, period);
+
+    return fb;
+}
+
+void iir_destroy(IIRFB* fb) {
+    if (fb) {
+        FB_JOURNAL_EVENT(FB_TYPE_IIR, fb->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(fb->base.id);
+        fb_pool_free(FB_TYPE_IIR, fb);
+    }
+}
+
+double iir_compute(IIRFB* fb, double input) {
+    if (!fb) {
+        return 0.0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    double x = input;
+    for (uint32_t s = 0; s < fb->sections; s++) {
+        const IIRSection* c = &fb->coef[s];
+        double* st = fb->state[s];
+        double y = c->b0 * x + st[0];
+        st[0] = c->b1 * x - c->a1 * y + st[1];
+        st[1] = c->b2 * x - c->a2 * y;
+        x = y;
+    }
+
+    fb->output = x;
+    return x;
+}
+
+int iir_set_sections(IIRFB* fb, const IIRPrototype* proto, uint32_t sections, int analog) {
+    if (!fb || iir_design(fb->coef, proto, sections, analog, fb->period) != 0) {
+        return -1;
+    }
+
+    // 新增的节从零状态开始
+    for (uint32_t s = fb->sections; s < sections; s++) {
+        fb->state[s][0] = 0.0;
+        fb->state[s][1] = 0.0;
+    }
+    fb->sections = sections;
+    fb->analog = analog != 0;
+    memcpy(fb->proto, proto, sections * sizeof(IIRPrototype));
+
+    FB_JOURNAL(FB_TYPE_IIR, fb->base.id, FB_EVENT_PARAM, "sections,analog", (double)sections,
+               (double)fb->analog);
+    return 0;
+}
+
+int iir_set_period(IIRFB* fb, double period) {
+    if (!fb || !(period > 0.0 && period < IIR_PERIOD_MAX)) {
+        return -1;
+    }
+    if (fb->analog && iir_design(fb->coef, fb->proto, fb->sections, 1, period) != 0) {
+        return -1;
+    }
+    fb->period = period;
+    return 0;
+}
+
+void iir_reset(IIRFB* fb, double initial) {
+    if (fb) {
+        double x = initial;
+        for (uint32_t s = 0; s < fb->sections; s++) {
+            x = steady_state(&fb->coef[s], x, &fb->state[s][0], &fb->state[s][1]);
+        }
+        fb->output = x;
+    }
+}
+
+/* ========== 批量形式 ========== */
+
+// 单个通道（标量），与 iir_compute() 逐步对应
+static inline double iir_bank_step(IIRBank* b, size_t i, double x) {
+    for (uint32_t s = 0; s < b->sections; s++) {
+        const IIRSection* c = &b->coef[s];
+        double* s1 = BANK_S1(b, s);
+        double* s2 = BANK_S2(b, s);
+        double y = c->b0 * x + s1[i];
+        s1[i] = c->b1 * x - c->a1 * y + s2[i];
+        s2[i] = c->b2 * x - c->a2 * y;
+        x = y;
+    }
+    return x;
+}
+
+static size_t kernel_scalar(IIRBank* bank, const double* in, double* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = iir_bank_step(bank, i, in[i]);
+    }
+    return n;
+}
+
+#ifdef IIR_X86
+// SSE2：每次 2 个通道（x86-64 基线指令集）
+static size_t kernel_sse2(IIRBank* b, const double* in, double* out, size_t n) {
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(in + i);
+        for (uint32_t s = 0; s < b->sections; s++) {
+            const IIRSection* c = &b->coef[s];
+            double* s1 = BANK_S1(b, s) + i;
+            double* s2 = BANK_S2(b, s) + i;
+            __m128d y = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(c->b0), x), _mm_load_pd(s1));
+            __m128d t = _mm_sub_pd(_mm_mul_pd(_mm_set1_pd(c->b1), x),
+                                   _mm_mul_pd(_mm_set1_pd(c->a1), y));
+            _mm_store_pd(s1, _mm_add_pd(t, _mm_load_pd(s2)));
+            _mm_store_pd(s2, _mm_sub_pd(_mm_mul_pd(_mm_set1_pd(c->b2), x),
+                                        _mm_mul_pd(_mm_set1_pd(c->a2), y)));
+            x = y;
+        }
+        _mm_storeu_pd(out + i, x);
+    }
+
+    return i;
+}
+
+// AVX2：每次 4 个通道（运行时检测 CPU 支持后才会调用）
+__attribute__((target("avx2")))
+static size_t kernel_avx2(IIRBank* b, const double* in, double* out, size_t n) {
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(in + i);
+        for (uint32_t s = 0; s < b->sections; s++) {
+            const IIRSection* c = &b->coef[s];
+            double* s1 = BANK_S1(b, s) + i;
+            double* s2 = BANK_S2(b, s) + i;
+            __m256d y = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(c->b0), x),
+                                      _mm256_load_pd(s1));
+            __m256d t = _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(c->b1), x),
+                                      _mm256_mul_pd(_mm256_set1_pd(c->a1), y));
+            _mm256_store_pd(s1, _mm256_add_pd(t, _mm256_load_pd(s2)));
+            _mm256_store_pd(s2, _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(c->b2), x),
+                                              _mm256_mul_pd(_mm256_set1_pd(c->a2), y)));
+            x = y;
+        }
+        _mm256_storeu_pd(out + i, x);
+    }
+
+    return i;
+}
+#endif
+
+// 选择计算内核：默认使用 CPU 支持的最宽指令集，
+// 可用环境变量 PLCOPEN_IIR_KERNEL=scalar|sse2|avx2 指定（用于对比测试）
+static void select_kernel(void) {
+    const char* forced = getenv("PLCOPEN_IIR_KERNEL");
+
+    g_kernel = kernel_scalar;
+    g_kernel_name = "scalar";
+
+#ifdef IIR_X86
+    if (forced && strcmp(forced, "scalar") == 0) {
+        return;
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+        g_kernel = kernel_sse2;
+        g_kernel_name = "sse2";
+    }
+    if ((!forced || strcmp(forced, "sse2") != 0) && __builtin_cpu_supports("avx2")) {
+        g_kernel = kernel_avx2;
+        g_kernel_name = "avx2";
+    }
+#else
+    (void)forced;
+#endif
+}
+
+const char* iir_bank_kernel_name(void) {
+    if (!g_kernel) {
+        select_kernel();
+    }
+    return g_kernel_name;
+}
+
+// 按 sections 节分配对齐的状态数组，复制已有各节状态，新增部分清零
+static int bank_alloc_state(IIRBank* bank, uint32_t sections) {
+    size_t bytes = (size_t)2 * sections * bank->capacity * sizeof(double);
+    void* state;
+
+    if (posix_memalign(&state, IIR_BANK_ALIGN, bytes) != 0) {
+        LOG_ERROR_MSG("批量 IIR 状态分配失败（%zu 字节）", bytes);
+        return -1;
+    }
+    memset(state, 0, bytes);
+    if (bank->state) {
+        memcpy(state, bank->state,
+               (size_t)2 * bank->sections * bank->capacity * sizeof(double));
+        free(bank->state);
+    }
+    bank->state = (double*)state;
+    bank->allocated = sections;
+    return 0;
+}
+
+IIRBank* iir_bank_create(size_t count, const IIRPrototype* proto, uint32_t sections,
+                         int analog, double period) {
+    if (count == 0 || count > IIR_BANK_MAX_CHANNELS) {
+        LOG_ERROR_MSG("批量 IIR 创建失败：通道数 %zu 超出范围", count);
+        return NULL;
+    }
+
+    IIRBank* bank = (IIRBank*)calloc(1, sizeof(IIRBank));
+    if (!bank) {
+        LOG_ERROR_MSG("批量 IIR 创建失败：内存分配失败");
+        return NULL;
+    }
+
+    if (!(period >= 0.0 && period < IIR_PERIOD_MAX) ||
+        iir_design(bank->coef, proto, sections, analog, period) != 0) {
+        LOG_ERROR_MSG("批量 IIR 创建失败：系数无效（%u 节, period=%.6f）", sections, period);
+        free(bank);
+        return NULL;
+    }
+
+    // 每个状态数组长度向上取整到整缓存行，保证各数组起始地址都按缓存行对齐
+    bank->count = count;
+    bank->capacity = (count + IIR_BANK_LINE_DOUBLES - 1) / IIR_BANK_LINE_DOUBLES
+                     * IIR_BANK_LINE_DOUBLES;
+    if (bank_alloc_state(bank, sections) != 0) {
+        free(bank);
+        return NULL;
+    }
+
+    bank->sections = sections;
+    bank->analog = analog != 0;
+    bank->period = period;
+    memcpy(bank->proto, proto, sections * sizeof(IIRPrototype));
+
+    FB_JOURNAL(FB_TYPE_IIR, 0, FB_EVENT_CREATE, "channels,sections,analog", (double)count,
+               (double)sections, (double)bank->analog);
+
+    return bank;
+}
+
+void iir_bank_destroy(IIRBank* bank) {
+    if (bank) {
+        FB_JOURNAL_EVENT(FB_TYPE_IIR, 0, FB_EVENT_DESTROY);
+        free(bank->state);
+        free(bank);
+    }
+}
+
+void iir_bank_compute(IIRBank* bank, const double* in, double* out) {
+    if (!bank || !in || !out) {
+        return;
+    }
+
+    if (!g_kernel) {
+        select_kernel();
+    }
+
+    // 向量内核处理整块，剩余通道走标量路径
+    size_t done = g_kernel(bank, in, out, bank->count);
+    for (size_t i = done; i < bank->count; i++) {
+        out[i] = iir_bank_step(bank, i, in[i]);
+    }
+}
+
+int iir_bank_set_sections(IIRBank* bank, const IIRPrototype* proto, uint32_t sections,
+                          int analog) {
+    IIRSection coef[IIR_MAX_SECTIONS];
+
+    if (!bank || iir_design(coef, proto, sections, analog, bank->period) != 0) {
+        return -1;
+    }
+    if (sections > bank->allocated && bank_alloc_state(bank, sections) != 0) {
+        return -1;
+    }
+
+    // 新增的节从零状态开始（节数减少后再增加时清掉旧状态）
+    for (uint32_t s = bank->sections; s < sections; s++) {
+        memset(BANK_S1(bank, s), 0, 2 * bank->capacity * sizeof(double));
+    }
+    memcpy(bank->coef, coef, sections * sizeof(IIRSection));
+    memcpy(bank->proto, proto, sections * sizeof(IIRPrototype));
+    bank->sections = sections;
+    bank->analog = analog != 0;
+
+    FB_JOURNAL(FB_TYPE_IIR, 0, FB_EVENT_PARAM, "sections,analog", (double)sections,
+               (double)bank->analog);
+    return 0;
+}
+
+int iir_bank_set_period(IIRBank* bank, double period) {
+    if (!bank || !(period > 0.0 && period < IIR_PERIOD_MAX)) {
+        return -1;
+    }
+    if (bank->analog && iir_design(bank->coef, bank->proto, bank->sections, 1, period) != 0) {
+        return -1;
+    }
+    bank->period = period;
+    return 0;
+}
+
+double iir_bank_reset(IIRBank* bank, double initial) {
+    if (!bank) {
+        return 0.0;
+    }
+
+    // 所有通道稳态相同：先按单通道求出各节状态再填充
+    double x = initial;
+    for (uint32_t s = 0; s < bank->sections; s++) {
+        double v1, v2;
+        x = steady_state(&bank->coef[s], x, &v1, &v2);
+        double* s1 = BANK_S1(bank, s);
+        double* s2 = BANK_S2(bank, s);
+        for (size_t i = 0; i < bank->count; i++) {
+            s1[i] = v1;
+            s2[i] = v2;
+        }
+    }
+    return x;
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_iir.h
+ * @brief 离散传递函数（级联二阶节 IIR）功能块接口
+ *
+ * 任意阶线性环节按二阶节（biquad）级联实现，每节为
+ *   H(z) = (b0 + b1*z^-1 + b2*z^-2) / (1 + a1*z^-1 + a2*z^-2)
+ * 采用转置直接 II 型（DF2T），每节 2 个状态：
+ *   y  = b0*x + s1
+ *   s1 = b1*x - a1*y + s2
+ *   s2 = b2*x - a2*y
+ *
+ * 系数可直接按 z 域给出，也可按连续域 s 多项式给出，由双线性变换（Tustin）
+ * 按固定采样周期离散化。离散系数只在创建、修改参数或修改采样周期时计算一次，
+ * 每周期只做乘加，不做除法。
+ *
+ * IIRBank 让 n 个通道共用同一组系数，状态按结构数组（SoA）存放在按缓存行
+ * 对齐的内存中；x86 上按 CPU 能力选择 AVX2 / SSE2 内核，其他平台使用标量实现。
+ * 内核不使用 FMA，运算顺序与 iir_compute() 相同，每个通道的结果逐位一致。
+ */
+
+#ifndef FB_IIR_H
+#define FB_IIR_H
+
+#include "fb_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define IIR_MAX_SECTIONS 8                 // 最多二阶节数（16 阶）
+#define IIR_BANK_MAX_CHANNELS (1u << 20)   // 批量形式最大通道数
+
+// 二阶节原型系数（按 scipy sos 约定，分母首项不要求为 1）
+//   z 域：(b[0] + b[1]*z^-1 + b[2]*z^-2) / (a[0] + a[1]*z^-1 + a[2]*z^-2)
+//   s 域：(b[0]*s^2 + b[1]*s + b[2]) / (a[0]*s^2 + a[1]*s + a[2])
+typedef struct {
+    double b[3];
+    double a[3];
+} IIRPrototype;
+
+// 离散二阶节系数（a0 已归一化为 1）
+typedef struct {
+    double b0, b1, b2;
+    double a1, a2;
+} IIRSection;
+
+// 离散 IIR 功能块（系数与状态内嵌，不另外分配内存）
+typedef struct {
+    FunctionBlock base;
+    uint32_t sections;                       // 二阶节数 [1, IIR_MAX_SECTIONS]
+    int analog;                              // 1：原型为 s 域，按 period 离散化
+    double period;                           // 采样周期（秒），z 域原型时仅作记录
+    double output;                           // 最近一次输出
+    IIRSection coef[IIR_MAX_SECTIONS];       // 离散系数
+    double state[IIR_MAX_SECTIONS][2];       // 各节 DF2T 状态 {s1, s2}
+    IIRPrototype proto[IIR_MAX_SECTIONS];    // 原型系数（修改 period 时重新离散化）
+} IIRFB;
+
+// 批量 IIR（所有通道共用系数）
+typedef struct {
+    size_t count;                            // 通道数
+    size_t capacity;                         // 每个状态数组的长度（count 向上取整到缓存行）
+    uint32_t sections;
+    uint32_t allocated;                      // state 已分配的二阶节数（>= sections）
+    int analog;
+    double period;
+    IIRSection coef[IIR_MAX_SECTIONS];
+    IIRPrototype proto[IIR_MAX_SECTIONS];
+    double* state;                           // [allocated][2][capacity]，按缓存行对齐
+} IIRBank;
+
+/**
+ * @brief 把原型系数离散化为 DF2T 二阶节系数
+ * @param coef 输出：sections 个离散二阶节
+ * @param proto 原型系数
+ * @param sections 二阶节数 [1, IIR_MAX_SECTIONS]
+ * @param analog 1 表示 s 域原型（双线性变换），0 表示 z 域原型（归一化 a0）
+ * @param period 采样周期（秒），analog 为 1 时须 > 0
+ * @return 0 成功，-1 系数非有限值、分母首项为 0、s 域原型非真分式或周期无效
+ *
+ * s 域二阶节按分母实际阶次离散化：一阶节（a[0] = b[0] = 0）只乘 (1 + z^-1)，
+ * 不会在 z = -1 处引入相消的零极点。
+ */
+int iir_design(IIRSection* coef, const IIRPrototype* proto, uint32_t sections,
+               int analog, double period);
+
+/**
+ * @brief 就地初始化 IIR 功能块（不分配内存），状态清零
+ * @param fb 功能块指针
+ * @param proto 原型系数
+ * @param sections 二阶节数
+ * @param analog 1：s 域原型
+ * @param period 采样周期（秒）
+ * @return 0 成功，-1 参数无效
+ */
+int iir_init(IIRFB* fb, const IIRPrototype* proto, uint32_t sections, int analog,
+             double period);
+
+/**
+ * @brief 从实例池创建 IIR 功能块
+ * @param proto 原型系数
+ * @param sections 二阶节数
+ * @param analog 1：s 域原型
+ * @param period 采样周期（秒）
+ * @return 功能块指针，参数无效或实例池已满时返回 NULL
+ */
+IIRFB* iir_create(const IIRPrototype* proto, uint32_t sections, int analog, double period);
+
+/**
+ * @brief 销毁 IIR 功能块
+ * @param fb 功能块指针
+ */
+void iir_destroy(IIRFB* fb);
+
+/**
+ * @brief 计算一个采样周期（每个 period 调用一次）
+ * @param fb 功能块指针
+ * @param input 输入信号
+ * @return 输出信号
+ */
+double iir_compute(IIRFB* fb, double input);
+
+/**
+ * @brief 修改原型系数（二阶节数可变），保留仍存在的各节状态
+ * @param fb 功能块指针
+ * @param proto 原型系数
+ * @param sections 二阶节数
+ * @param analog 1：s 域原型
+ * @return 0 成功，-1 参数无效（原系数不变）
+ */
+int iir_set_sections(IIRFB* fb, const IIRPrototype* proto, uint32_t sections, int analog);
+
+/**
+ * @brief 修改采样周期；s 域原型按新周期重新离散化
+ * @param fb 功能块指针
+ * @param period 采样周期（秒），> 0
+ * @return 0 成功，-1 周期无效
+ */
+int iir_set_period(IIRFB* fb, double period);
+
+/**
+ * @brief 重置为输入恒为 initial 时的稳态（直流增益无穷大的节状态清零）
+ * @param fb 功能块指针
+ * @param initial 稳态输入值
+ */
+void iir_reset(IIRFB* fb, double initial);
+
+/**
+ * @brief 创建批量 IIR，所有通道共用同一组系数
+ * @param count 通道数 [1, IIR_BANK_MAX_CHANNELS]
+ * @param proto 原型系数
+ * @param sections 二阶节数
+ * @param analog 1：s 域原型
+ * @param period 采样周期（秒）
+ * @return 批量实例指针，失败返回 NULL
+ */
+IIRBank* iir_bank_create(size_t count, const IIRPrototype* proto, uint32_t sections,
+                         int analog, double period);
+
+/**
+ * @brief 销毁批量 IIR
+ * @param bank 批量实例指针
+ */
+void iir_bank_destroy(IIRBank* bank);
+
+/**
+ * @brief 计算全部通道的一个采样周期
+ * @param bank 批量实例指针
+ * @param in 输入数组（长度 count）
+ * @param out 输出数组（长度 count，可与 in 相同）
+ */
+void iir_bank_compute(IIRBank* bank, const double* in, double* out);
+
+/**
+ * @brief 修改全部通道共用的原型系数，保留仍存在的各节状态
+ * @param bank 批量实例指针
+ * @param proto 原型系数
+ * @param sections 二阶节数
+ * @param analog 1：s 域原型
+ * @return 0 成功，-1 参数无效或内存不足（原系数不变）
+ *
+ * 二阶节数超过创建时的节数时重新分配状态数组，不应在控制周期内调用。
+ */
+int iir_bank_set_sections(IIRBank* bank, const IIRPrototype* proto, uint32_t sections,
+                          int analog);
+
+/**
+ * @brief 修改采样周期；s 域原型按新周期重新离散化
+ * @param bank 批量实例指针
+ * @param period 采样周期（秒），> 0
+ * @return 0 成功，-1 周期无效
+ */
+int iir_bank_set_period(IIRBank* bank, double period);
+
+/**
+ * @brief 全部通道重置为输入恒为 initial 时的稳态
+ * @param bank 批量实例指针
+ * @param initial 稳态输入值
+ * @return 稳态输出
+ */
+double iir_bank_reset(IIRBank* bank, double initial);
+
+/**
+ * @brief 获取批量 IIR 当前使用的计算内核名称
+ * @return "avx2"、"sse2" 或 "scalar"
+ */
+const char* iir_bank_kernel_name(void);
+
+#endif // FB_IIR_H
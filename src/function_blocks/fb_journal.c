@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_journal.c
+ * @brief 功能块事件计数与变更日志实现
+ *
+ * 变更记录按序号写入环形缓冲区的第 (seq - 1) % 容量 个槽位。写入方先把槽位序号
+ * 置 0，写完字段后再以 release 语义写入序号；读取方复制前后各读一次序号，
+ * 两次都等于期望值才接受（seqlock），序号更大说明已被覆盖。
+ */
+
+#include "fb_journal.h"
+#include "fb_pool.h"
+#include "../runtime/logger.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define JOURNAL_MASK (FB_JOURNAL_CAPACITY - 1)
+#define JOURNAL_GROUPS 64           // 每次汇总最多区分的（类型, ID, 事件）组数
+#define JOURNAL_LINE_MAX 1024
+
+static FBJournal g_journal;
+
+// 汇总线程
+static struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int running;
+    int stop;
+    int period_ms;
+    size_t source_count;
+    FBJournal* sources[FB_JOURNAL_SOURCES];
+    const char* names[FB_JOURNAL_SOURCES];
+} g_flusher = {.lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER};
+
+static const char* const EVENT_NAMES[FB_EVENT_COUNT] = {
+    "create", "destroy", "param", "reset", "tune",
+};
+
+static const char* const EVENT_TEXT[FB_EVENT_COUNT] = {
+    "创建", "销毁", "参数更新", "重置", "自整定结束",
+};
+
+// 同一（类型, ID, 事件）在一次汇总中的合并结果
+typedef struct {
+    FBJournalRecord last;
+    uint64_t count;
+} Group;
+
+FBJournal* fb_journal_default(void) {
+    return &g_journal;
+}
+
+void fb_journal_record(FunctionBlockType type, uint32_t id, FBEventKind kind, const char* labels,
+                       const double* values, size_t count) {
+    if ((unsigned)type >= FB_TYPE_COUNT || (unsigned)kind >= FB_EVENT_COUNT) {
+        return;
+    }
+    FBJournal* j = &g_journal;
+    __atomic_add_fetch(&j->counts[type][kind], 1, __ATOMIC_RELAXED);
+
+    uint64_t seq = __atomic_add_fetch(&j->head, 1, __ATOMIC_RELAXED);
+    FBJournalRecord* r = &j->records[(seq - 1) & JOURNAL_MASK];
+    __atomic_store_n(&r->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    if (count > FB_JOURNAL_VALUES) {
+        count = FB_JOURNAL_VALUES;
+    }
+    r->time = fb_clock_monotonic();
+    r->labels = labels;
+    r->id = id;
+    r->type = (uint16_t)type;
+    r->kind = (uint8_t)kind;
+    r->count = (uint8_t)(values ? count : 0);
+    for (size_t i = 0; i < r->count; i++) {
+        r->values[i] = values[i];
+    }
+    __atomic_store_n(&r->seq, seq, __ATOMIC_RELEASE);
+}
+
+void fb_journal_note_clamp(const char* param, double value, double min, double max) {
+    FBJournal* j = &g_journal;
+    // 诊断信息不要求与计数原子一致
+    j->clamp_param = param;
+    j->clamp_value = value;
+    j->clamp_min = min;
+    j->clamp_max = max;
+    __atomic_add_fetch(&j->clamps, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 按序号读取一条记录
+ * @return 1 成功，0 已被覆盖，-1 尚未写完
+ */
+static int read_record(const FBJournal* journal, uint64_t seq, FBJournalRecord* out) {
+    const FBJournalRecord* r = &journal->records[(seq - 1) & JOURNAL_MASK];
+    uint64_t before = __atomic_load_n(&r->seq, __ATOMIC_ACQUIRE);
+    if (before != seq) {
+        return before > seq ? 0 : -1;
+    }
+    memcpy(out, r, sizeof(*out));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&r->seq, __ATOMIC_RELAXED) == seq ? 1 : 0;
+}
+
+size_t fb_journal_read(const FBJournal* journal, uint64_t since, FBJournalRecord* out,
+                       size_t capacity, uint64_t* lost) {
+    uint64_t missing = 0;
+    size_t n = 0;
+
+    if (journal && out) {
+        uint64_t head = __atomic_load_n(&journal->head, __ATOMIC_ACQUIRE);
+        uint64_t first = since + 1;
+        if (head > FB_JOURNAL_CAPACITY && first <= head - FB_JOURNAL_CAPACITY) {
+            missing = head - FB_JOURNAL_CAPACITY + 1 - first;
+            first = head - FB_JOURNAL_CAPACITY + 1;
+        }
+        for (uint64_t seq = first; seq <= head && n < capacity; seq++) {
+            int rc = read_record(journal, seq, &out[n]);
+            if (rc > 0) {
+                n++;
+            } else if (rc == 0) {
+                missing++;
+            } else {
+                break;
+            }
+        }
+    }
+
+    if (lost) {
+        *lost = missing;
+    }
+    return n;
+}
+
+const char* fb_journal_event_name(FBEventKind kind) {
+    return (unsigned)kind < FB_EVENT_COUNT ? EVENT_NAMES[kind] : "unknown";
+}
+
+const char* fb_journal_type_name(FunctionBlockType type) {
+    const char* name = fb_pool_type_name(type);
+    if (name) {
+        return name;
+    }
+    switch (type) {
+    case FB_TYPE_PID_BANK:
+        return "PIDBank";
+    case FB_TYPE_ARRAY:
+        return "Array";
+    default:
+        return "unknown";
+    }
+}
+
+// 追加 "名称=值" 列表；labels 为 NULL 或名称不足时用 v0、v1……
+static size_t format_values(char* buf, size_t size, const FBJournalRecord* r) {
+    size_t len = 0;
+    const char* label = r->labels;
+
+    buf[0] = '\0';
+    for (uint8_t i = 0; i < r->count && len < size; i++) {
+        char name[32];
+        size_t k = 0;
+        if (label && *label) {
+            while (label[k] && label[k] != ',' && k < sizeof(name) - 1) {
+                name[k] = label[k];
+                k++;
+            }
+            name[k] = '\0';
+            label = strchr(label, ',');
+            label = label ? label + 1 : NULL;
+        } else {
+            snprintf(name, sizeof(name), "v%u", i);
+        }
+        int w = snprintf(buf + len, size - len, "%s%s=%.6g", i ? ", " : "", name, r->values[i]);
+        len += w > 0 ? (size_t)w : 0;
+    }
+    return len < size ? len : size - 1;
+}
+
+uint64_t fb_journal_flush(FBJournal* journal, const char* source) {
+    if (!journal) {
+        return 0;
+    }
+
+    double now = fb_clock_monotonic();
+    char line[JOURNAL_LINE_MAX];
+    size_t len = 0;
+    uint64_t total = 0;
+
+    // 1. 按类型和事件汇总计数增量
+    for (int t = 0; t < FB_TYPE_COUNT; t++) {
+        int first = 1;
+        for (int k = 0; k < FB_EVENT_COUNT; k++) {
+            uint64_t count = __atomic_load_n(&journal->counts[t][k], __ATOMIC_RELAXED);
+            uint64_t delta = count - journal->flushed_counts[t][k];
+            journal->flushed_counts[t][k] = count;
+            if (!delta) {
+                continue;
+            }
+            total += delta;
+            if (len < sizeof(line)) {
+                int w = first ? snprintf(line + len, sizeof(line) - len, "%s%s %s %llu",
+                                         len ? "；" : "",
+                                         fb_journal_type_name((FunctionBlockType)t),
+                                         EVENT_TEXT[k], (unsigned long long)delta)
+                              : snprintf(line + len, sizeof(line) - len, "、%s %llu",
+                                         EVENT_TEXT[k], (unsigned long long)delta);
+                len += w > 0 ? (size_t)w : 0;
+            }
+            first = 0;
+        }
+    }
+
+    uint64_t clamps = __atomic_load_n(&journal->clamps, __ATOMIC_ACQUIRE);
+    uint64_t new_clamps = clamps - journal->flushed_clamps;
+    journal->flushed_clamps = clamps;
+
+    if (total) {
+        if (journal->flushed_time > 0.0) {
+            LOG_INFO_MSG("功能块事件（%s，近 %.1f s）：%s", source, now - journal->flushed_time,
+                         line);
+        } else {
+            LOG_INFO_MSG("功能块事件（%s）：%s", source, line);
+        }
+    }
+
+    // 2. 按（类型, ID, 事件）合并变更记录，列出每组的最新取值
+    uint64_t head = __atomic_load_n(&journal->head, __ATOMIC_ACQUIRE);
+    uint64_t seq = journal->flushed_seq + 1;
+    uint64_t lost = 0;
+    if (head > FB_JOURNAL_CAPACITY && seq <= head - FB_JOURNAL_CAPACITY) {
+        lost = head - FB_JOURNAL_CAPACITY + 1 - seq;
+        seq = head - FB_JOURNAL_CAPACITY + 1;
+    }
+
+    Group groups[JOURNAL_GROUPS];
+    size_t group_count = 0;
+    uint64_t ungrouped = 0;
+    for (; seq <= head; seq++) {
+        FBJournalRecord r;
+        int rc = read_record(journal, seq, &r);
+        if (rc < 0) {
+            break;  // 尚未写完，留到下次汇总
+        }
+        if (rc == 0) {
+            lost++;
+            continue;
+        }
+
+        size_t g = 0;
+        while (g < group_count && !(groups[g].last.type == r.type && groups[g].last.id == r.id &&
+                                    groups[g].last.kind == r.kind)) {
+            g++;
+        }
+        if (g == group_count) {
+            if (group_count == JOURNAL_GROUPS) {
+                ungrouped++;
+                continue;
+            }
+            groups[group_count++].count = 0;
+        }
+        groups[g].last = r;
+        groups[g].count++;
+    }
+    journal->flushed_seq = seq - 1;
+
+    size_t shown = group_count < FB_JOURNAL_DETAIL_MAX ? group_count : FB_JOURNAL_DETAIL_MAX;
+    for (size_t g = 0; g < shown; g++) {
+        const FBJournalRecord* r = &groups[g].last;
+        char values[512];
+        format_values(values, sizeof(values), r);
+        char id[32];
+        if (r->id) {
+            snprintf(id, sizeof(id), "ID=%u", r->id);
+        } else {
+            snprintf(id, sizeof(id), "（批量）");
+        }
+        if (groups[g].count > 1) {
+            LOG_INFO_MSG("  %s %s %s ×%llu%s%s", fb_journal_type_name((FunctionBlockType)r->type),
+                         id, EVENT_TEXT[r->kind], (unsigned long long)groups[g].count,
+                         r->count ? "，最新 " : "", values);
+        } else {
+            LOG_INFO_MSG("  %s %s %s%s%s", fb_journal_type_name((FunctionBlockType)r->type), id,
+                         EVENT_TEXT[r->kind], r->count ? "：" : "", values);
+        }
+    }
+    if (group_count > shown || ungrouped) {
+        LOG_INFO_MSG("  另有 %zu 组变更未列出", group_count - shown + (ungrouped ? 1 : 0));
+    }
+    if (lost) {
+        LOG_INFO_MSG("  变更记录被覆盖 %llu 条（仅保留最近 %d 条，计数不受影响）",
+                     (unsigned long long)lost, FB_JOURNAL_CAPACITY);
+    }
+
+    if (new_clamps) {
+        LOG_WARNING_MSG("参数超出范围被限制 %llu 次（%s），最近一次：%s=%.6f，范围 [%.6f, %.6f]",
+                        (unsigned long long)new_clamps, source,
+                        journal->clamp_param ? journal->clamp_param : "?", journal->clamp_value,
+                        journal->clamp_min, journal->clamp_max);
+    }
+
+    journal->flushed_time = now;
+    return total;
+}
+
+int fb_journal_add_source(FBJournal* journal, const char* source) {
+    if (!journal || journal == &g_journal) {
+        return journal ? 0 : -1;
+    }
+
+    pthread_mutex_lock(&g_flusher.lock);
+    int rc = -1;
+    for (size_t i = 0; i < g_flusher.source_count; i++) {
+        if (g_flusher.sources[i] == journal) {
+            rc = 0;
+        }
+    }
+    if (rc != 0 && g_flusher.source_count < FB_JOURNAL_SOURCES) {
+        g_flusher.sources[g_flusher.source_count] = journal;
+        g_flusher.names[g_flusher.source_count] = source;
+        g_flusher.source_count++;
+        rc = 0;
+    }
+    pthread_mutex_unlock(&g_flusher.lock);
+    return rc;
+}
+
+// 汇总本模块和已加入的所有日志（调用方持有 g_flusher.lock）
+static void flush_all_locked(void) {
+    fb_journal_flush(&g_journal, "运行时");
+    for (size_t i = 0; i < g_flusher.source_count; i++) {
+        fb_journal_flush(g_flusher.sources[i], g_flusher.names[i]);
+    }
+}
+
+static void* flusher_main(void* arg) {
+    (void)arg;
+
+    pthread_mutex_lock(&g_flusher.lock);
+    while (!g_flusher.stop) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += g_flusher.period_ms / 1000;
+        deadline.tv_nsec += (long)(g_flusher.period_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        while (!g_flusher.stop &&
+               pthread_cond_timedwait(&g_flusher.cond, &g_flusher.lock, &deadline) != ETIMEDOUT) {
+        }
+        if (!g_flusher.stop) {
+            flush_all_locked();
+        }
+    }
+    pthread_mutex_unlock(&g_flusher.lock);
+    return NULL;
+}
+
+int fb_journal_start(int period_ms) {
+    if (period_ms <= 0 || g_flusher.running) {
+        return -1;
+    }
+
+    g_flusher.period_ms = period_ms;
+    g_flusher.stop = 0;
+    if (pthread_create(&g_flusher.thread, NULL, flusher_main, NULL) != 0) {
+        LOG_ERROR_MSG("功能块事件汇总线程创建失败");
+        return -1;
+    }
+    g_flusher.running = 1;
+
+    LOG_INFO_MSG("功能块事件汇总线程已启动：汇总间隔 %d ms", period_ms);
+    return 0;
+}
+
+void fb_journal_stop(void) {
+    if (g_flusher.running) {
+        pthread_mutex_lock(&g_flusher.lock);
+        g_flusher.stop = 1;
+        pthread_cond_signal(&g_flusher.cond);
+        pthread_mutex_unlock(&g_flusher.lock);
+        pthread_join(g_flusher.thread, NULL);
+        g_flusher.running = 0;
+    }
+
+    // 最后一次汇总
+    pthread_mutex_lock(&g_flusher.lock);
+    flush_all_locked();
+    pthread_mutex_unlock(&g_flusher.lock);
+}
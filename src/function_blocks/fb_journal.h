@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_journal.h
+ * @brief 功能块事件计数与变更日志
+ *
+ * 创建、销毁、参数更新、状态重置等事件不再同步写日志（加锁、stat()、格式化、
+ * 写文件），而是：
+ *   - 按类型 × 事件累加计数（原子加）；
+ *   - 把事件和新参数值写入定长环形变更记录（每条记录带序号，写入无锁）。
+ * 汇总线程按固定周期把上次汇总以来的计数和每个实例的最新取值合并成
+ * 少量日志行，每周期改参的脚本也只在每个汇总周期产生一组日志。
+ * 环形缓冲区满后覆盖最旧的记录，计数不受影响，汇总时报告被覆盖的条数。
+ *
+ * validate_and_clamp() 的越限限幅同样只计数，由汇总时报告一次。
+ *
+ * 扩展模块和运行时各编译一份，各有一个进程内日志（fb_journal_default()）。
+ * 运行时通过 fb_journal_add_source() 把扩展模块的日志也纳入汇总，
+ * 两者源码相同、结构布局一致。
+ */
+
+#ifndef FB_JOURNAL_H
+#define FB_JOURNAL_H
+
+#include "fb_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define FB_JOURNAL_CAPACITY 1024    // 变更记录条数（2 的幂）
+#define FB_JOURNAL_VALUES 6         // 每条记录最多携带的数值个数
+#define FB_JOURNAL_DETAIL_MAX 16    // 每次汇总最多列出的实例变更行数
+#define FB_JOURNAL_SOURCES 4        // 汇总线程最多汇总的日志个数
+#define FB_JOURNAL_CAPSULE_NAME "plcopen_c.FBJournal"
+
+// 事件类型
+typedef enum {
+    FB_EVENT_CREATE,    // 创建
+    FB_EVENT_DESTROY,   // 销毁
+    FB_EVENT_PARAM,     // 参数更新
+    FB_EVENT_RESET,     // 状态重置
+    FB_EVENT_TUNE,      // 自整定完成
+    FB_EVENT_COUNT
+} FBEventKind;
+
+// 一条变更记录
+typedef struct {
+    uint64_t seq;                       // 序号（从 1 开始，写入过程中为 0）
+    double time;                        // 单调时钟时间（秒）
+    const char* labels;                 // 数值名称，逗号分隔的静态字符串，可为 NULL
+    uint32_t id;                        // 功能块 ID（批量类型为 0）
+    uint16_t type;                      // FunctionBlockType
+    uint8_t kind;                       // FBEventKind
+    uint8_t count;                      // 数值个数
+    double values[FB_JOURNAL_VALUES];   // 事件后的参数值
+} FBJournalRecord;
+
+// 一个模块的事件日志
+typedef struct {
+    uint64_t head;                                    // 已分配的最大序号
+    uint64_t counts[FB_TYPE_COUNT][FB_EVENT_COUNT];   // 累计事件数
+    uint64_t clamps;                                  // 参数越限限幅次数
+    const char* clamp_param;                          // 最近一次限幅的参数名（诊断用）
+    double clamp_value;                               // 最近一次限幅的原值
+    double clamp_min;                                 // 最近一次限幅的范围
+    double clamp_max;
+    FBJournalRecord records[FB_JOURNAL_CAPACITY];
+
+    // 以下只由汇总方访问
+    uint64_t flushed_seq;
+    uint64_t flushed_counts[FB_TYPE_COUNT][FB_EVENT_COUNT];
+    uint64_t flushed_clamps;
+    double flushed_time;
+} FBJournal;
+
+/**
+ * @brief 获取本模块的事件日志
+ * @return 进程内（本模块）唯一的日志
+ */
+FBJournal* fb_journal_default(void);
+
+/**
+ * @brief 记录一个事件（计数并写入变更记录，不写日志文件）
+ * @param type 功能块类型
+ * @param id 功能块 ID
+ * @param kind 事件类型
+ * @param labels 数值名称（逗号分隔的静态字符串），可为 NULL
+ * @param values 数值，可为 NULL
+ * @param count 数值个数（超过 FB_JOURNAL_VALUES 的部分被丢弃）
+ */
+void fb_journal_record(FunctionBlockType type, uint32_t id, FBEventKind kind, const char* labels,
+                       const double* values, size_t count);
+
+/* 带数值 / 不带数值的记录便捷宏 */
+#define FB_JOURNAL(type, id, kind, labels, ...)                                          \
+    fb_journal_record((type), (id), (kind), (labels), (const double[]){__VA_ARGS__},     \
+                      sizeof((const double[]){__VA_ARGS__}) / sizeof(double))
+#define FB_JOURNAL_EVENT(type, id, kind) fb_journal_record((type), (id), (kind), NULL, NULL, 0)
+
+/**
+ * @brief 记录一次参数越限限幅（由 validate_and_clamp 调用）
+ * @param param 参数名（静态字符串）
+ * @param value 原值
+ * @param min 范围下限
+ * @param max 范围上限
+ */
+void fb_journal_note_clamp(const char* param, double value, double min, double max);
+
+/**
+ * @brief 读取变更记录
+ * @param journal 日志
+ * @param since 只返回序号大于 since 的记录
+ * @param out 输出数组
+ * @param capacity 数组容量
+ * @param lost 输出因覆盖而缺失的条数，可为 NULL
+ * @return 写入的记录数（按序号递增）
+ */
+size_t fb_journal_read(const FBJournal* journal, uint64_t since, FBJournalRecord* out,
+                       size_t capacity, uint64_t* lost);
+
+/**
+ * @brief 把上次汇总以来的事件合并写入日志文件
+ * @param journal 日志
+ * @param source 来源名称（如 "运行时"、"脚本"）
+ * @return 本次汇总的事件数
+ *
+ * @note 同一日志同时只能有一个汇总方
+ */
+uint64_t fb_journal_flush(FBJournal* journal, const char* source);
+
+/**
+ * @brief 把另一个模块的日志加入汇总线程（如扩展模块的日志）
+ * @param journal 日志
+ * @param source 来源名称（静态字符串）
+ * @return 0 成功，-1 已满
+ */
+int fb_journal_add_source(FBJournal* journal, const char* source);
+
+/**
+ * @brief 启动后台汇总线程
+ * @param period_ms 汇总周期（毫秒）
+ * @return 0 成功，-1 失败
+ */
+int fb_journal_start(int period_ms);
+
+/**
+ * @brief 停止后台汇总线程并做最后一次汇总
+ */
+void fb_journal_stop(void);
+
+/**
+ * @brief 事件名称
+ * @param kind 事件类型
+ * @return "create"、"destroy"、"param"、"reset"、"tune"
+ */
+const char* fb_journal_event_name(FBEventKind kind);
+
+/**
+ * @brief 功能块类型名称（含没有实例池的批量类型）
+ * @param type 功能块类型
+ * @return 类型名
+ */
+const char* fb_journal_type_name(FunctionBlockType type);
+
+#endif // FB_JOURNAL_H
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_kalman.c
+ * @brief 离散线性卡尔曼滤波功能块实现
+ */
+
+#include "fb_kalman.h"
+#include "fb_journal.h"
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "../runtime/logger.h"
+#include <math.h>
+#include <string.h>
+
+// 协方差矩阵对称性检查的相对容差（numpy 计算的 G·Gᵀ 等可能有舍入差异）
+#define KALMAN_SYMMETRY_TOL 1e-9
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define KALMAN_UNROLL _Pragma("GCC unroll 8")
+#elif defined(__clang__)
+#define KALMAN_UNROLL _Pragma("unroll")
+#else
+#define KALMAN_UNROLL
+#endif
+
+#define KALMAN_N 1
+#include "fb_kalman_impl.h"
+#define KALMAN_N 2
+#include "fb_kalman_impl.h"
+#define KALMAN_N 3
+#include "fb_kalman_impl.h"
+#define KALMAN_N 4
+#include "fb_kalman_impl.h"
+#define KALMAN_N 5
+#include "fb_kalman_impl.h"
+#define KALMAN_N 6
+#include "fb_kalman_impl.h"
+#define KALMAN_N 7
+#include "fb_kalman_impl.h"
+#define KALMAN_N 8
+#include "fb_kalman_impl.h"
+
+static const KalmanStepFn KALMAN_KERNELS[KALMAN_MAX_STATES + 1] = {
+    NULL, kalman_step_1, kalman_step_2, kalman_step_3, kalman_step_4,
+    kalman_step_5, kalman_step_6, kalman_step_7, kalman_step_8,
+};
+
+static int all_finite(const double* v, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (!isfinite(v[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// 校验 n×n 协方差矩阵（有限、对角非负、对称）并对称化后写入 out
+static int copy_covariance(double out[KALMAN_MAX_STATES][KALMAN_MAX_STATES], const double* src,
+                           uint32_t n) {
+    double tmp[KALMAN_MAX_STATES][KALMAN_MAX_STATES];
+
+    if (!all_finite(src, (size_t)n * n)) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        if (src[i * n + i] < 0.0) {
+            return -1;
+        }
+        for (uint32_t j = i; j < n; j++) {
+            double a = src[i * n + j];
+            double b = src[j * n + i];
+            if (fabs(a - b) > KALMAN_SYMMETRY_TOL * fmax(1.0, fmax(fabs(a), fabs(b)))) {
+                return -1;
+            }
+            tmp[i][j] = tmp[j][i] = a == b ? a : 0.5 * (a + b);
+        }
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        memcpy(out[i], tmp[i], n * sizeof(double));
+    }
+    return 0;
+}
+
+static int variances_valid(const double* R, uint32_t m) {
+    for (uint32_t j = 0; j < m; j++) {
+        if (!(R[j] > 0.0) || !isfinite(R[j])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int model_valid(const KalmanModel* model) {
+    if (!model || model->n < 1 || model->n > KALMAN_MAX_STATES || model->m < 1 ||
+        model->m > KALMAN_MAX_MEASUREMENTS || model->p > KALMAN_MAX_INPUTS ||
+        !model->F || !model->H || !model->Q || !model->R || (model->p > 0 && !model->B)) {
+        return 0;
+    }
+    size_t n = model->n;
+    return all_finite(model->F, n * n) && all_finite(model->H, model->m * n) &&
+           (model->p == 0 || all_finite(model->B, n * model->p)) &&
+           variances_valid(model->R, model->m);
+}
+
+int kalman_init(KalmanFB* fb, const KalmanModel* model, const double* x0, const double* P0) {
+    if (!fb || !model_valid(model) || (x0 && !all_finite(x0, model->n))) {
+        return -1;
+    }
+
+    uint32_t n = model->n;
+    KalmanFB fresh;
+    memset(&fresh, 0, sizeof(fresh));
+    if (copy_covariance(fresh.Q, model->Q, n) != 0) {
+        return -1;
+    }
+    if (P0) {
+        if (copy_covariance(fresh.P0, P0, n) != 0) {
+            return -1;
+        }
+    } else {
+        for (uint32_t i = 0; i < n; i++) {
+            fresh.P0[i][i] = 1.0;
+        }
+    }
+
+    fresh.base.type = FB_TYPE_KALMAN;
+    fresh.n = n;
+    fresh.m = model->m;
+    fresh.p = model->p;
+    for (uint32_t i = 0; i < n; i++) {
+        memcpy(fresh.F[i], model->F + i * n, n * sizeof(double));
+        for (uint32_t k = 0; k < model->p; k++) {
+            fresh.B[i][k] = model->B[i * model->p + k];
+        }
+        fresh.x0[i] = x0 ? x0[i] : 0.0;
+    }
+    for (uint32_t j = 0; j < model->m; j++) {
+        memcpy(fresh.H[j], model->H + j * n, n * sizeof(double));
+        fresh.R[j] = model->R[j];
+    }
+    fresh.step = KALMAN_KERNELS[n];
+
+    *fb = fresh;
+    kalman_reset(fb);
+    return 0;
+}
+
+KalmanFB* kalman_create(const KalmanModel* model, const double* x0, const double* P0) {
+    KalmanFB* fb = (KalmanFB*)fb_pool_alloc(FB_TYPE_KALMAN);
+    if (!fb) {
+        LOG_ERROR_MSG("卡尔曼滤波器创建失败：实例池已满");
+        return NULL;
+    }
+
+    if (kalman_init(fb, model, x0, P0) != 0) {
+        LOG_ERROR_MSG("卡尔曼滤波器创建失败：模型无效");
+        fb_pool_free(FB_TYPE_KALMAN, fb);
+        return NULL;
+    }
+
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        fb_pool_free(FB_TYPE_KALMAN, fb);
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_KALMAN, fb->base.id, FB_EVENT_CREATE, "n,m,p", (double)fb->n,
+               (double)fb->m, (double)fb->p);
+    return fb;
+}
+
+void kalman_destroy(KalmanFB* fb) {
+    if (fb) {
+        FB_JOURNAL_EVENT(FB_TYPE_KALMAN, fb->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(fb->base.id);
+        fb_pool_free(FB_TYPE_KALMAN, fb);
+    }
+}
+
+void kalman_reset(KalmanFB* fb) {
+    if (!fb) {
+        return;
+    }
+
+    memcpy(fb->x, fb->x0, sizeof(fb->x));
+    memcpy(fb->P, fb->P0, sizeof(fb->P));
+    for (uint32_t j = 0; j < KALMAN_MAX_MEASUREMENTS; j++) {
+        fb->innovation[j] = NAN;
+    }
+    fb->steps = 0;
+    fb->rejected = 0;
+}
+
+int kalman_set_state(KalmanFB* fb, const double* x, const double* P) {
+    if (!fb || (x && !all_finite(x, fb->n))) {
+        return -1;
+    }
+    if (P && copy_covariance(fb->P, P, fb->n) != 0) {
+        return -1;
+    }
+    if (x) {
+        memcpy(fb->x, x, fb->n * sizeof(double));
+    }
+    return 0;
+}
+
+int kalman_set_noise(KalmanFB* fb, const double* Q, const double* R) {
+    if (!fb || (R && !variances_valid(R, fb->m))) {
+        return -1;
+    }
+    if (Q && copy_covariance(fb->Q, Q, fb->n) != 0) {
+        return -1;
+    }
+    if (R) {
+        memcpy(fb->R, R, fb->m * sizeof(double));
+    }
+    return 0;
+}
+
+int kalman_set_gate(KalmanFB* fb, double gate) {
+    if (!fb || !(gate >= 0.0) || !isfinite(gate)) {
+        return -1;
+    }
+    fb->gate = gate;
+    return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_kalman.h
+ * @brief 离散线性卡尔曼滤波功能块
+ *
+ * 用于冗余传感器融合、带噪声测量的状态估计：
+ *   预测  x = F·x + B·u，P = F·P·Fᵀ + Q
+ *   更新  对每个量测 j 依次做标量更新（量测噪声互不相关，R 为对角阵）：
+ *         s = h·P·hᵀ + r，K = P·hᵀ / s，x += K·(z - h·x)，P -= K·h·P
+ * 标量逐个更新不需要求逆，P 按对称方式更新；量测为 NaN（传感器故障、
+ * 本周期无数据）时跳过该量测，设置 gate 时新息超过 gate 倍标准差的量测
+ * 视为野值同样跳过。
+ *
+ * 矩阵按最大维数定长存放在功能块内，计算不分配内存。状态数 1~8 各有一份
+ * 由 fb_kalman_impl.h 实例化的内核，状态维的循环次数为编译期常量，
+ * 由编译器完全展开；初始化时按状态数选定内核。
+ */
+
+#ifndef FB_KALMAN_H
+#define FB_KALMAN_H
+
+#include "fb_common.h"
+#include "fb_timing.h"
+#include <stdint.h>
+
+#define KALMAN_MAX_STATES 8          // 最大状态数
+#define KALMAN_MAX_MEASUREMENTS 8    // 最大量测数
+#define KALMAN_MAX_INPUTS 4          // 最大控制输入数
+
+// 系统模型（矩阵按行主序存放，初始化时复制）
+typedef struct {
+    uint32_t n;          // 状态数 [1, KALMAN_MAX_STATES]
+    uint32_t m;          // 量测数 [1, KALMAN_MAX_MEASUREMENTS]
+    uint32_t p;          // 控制输入数 [0, KALMAN_MAX_INPUTS]
+    const double* F;     // 状态转移矩阵 n×n
+    const double* B;     // 控制矩阵 n×p（p 为 0 时可为 NULL）
+    const double* H;     // 量测矩阵 m×n
+    const double* Q;     // 过程噪声协方差 n×n（对称半正定）
+    const double* R;     // 各量测的噪声方差 m 个（> 0）
+} KalmanModel;
+
+typedef struct KalmanFB KalmanFB;
+
+// 按状态数特化的单步内核
+typedef void (*KalmanStepFn)(KalmanFB* fb, const double* z, const double* u);
+
+// 卡尔曼滤波功能块
+struct KalmanFB {
+    FunctionBlock base;
+    uint32_t n, m, p;
+    double gate;             // 新息门限（标准差倍数），0 表示不检验
+    double F[KALMAN_MAX_STATES][KALMAN_MAX_STATES];
+    double B[KALMAN_MAX_STATES][KALMAN_MAX_INPUTS];
+    double H[KALMAN_MAX_MEASUREMENTS][KALMAN_MAX_STATES];
+    double Q[KALMAN_MAX_STATES][KALMAN_MAX_STATES];
+    double R[KALMAN_MAX_MEASUREMENTS];
+    double x[KALMAN_MAX_STATES];                        // 状态估计
+    double P[KALMAN_MAX_STATES][KALMAN_MAX_STATES];     // 估计误差协方差
+    double x0[KALMAN_MAX_STATES];                       // reset 时恢复的初值
+    double P0[KALMAN_MAX_STATES][KALMAN_MAX_STATES];
+    double innovation[KALMAN_MAX_MEASUREMENTS];         // 最近一次新息，跳过的量测为 NaN
+    uint64_t steps;          // 已执行周期数
+    uint64_t rejected;       // 被门限剔除的量测数
+    KalmanStepFn step;       // 按状态数选定的内核
+};
+
+/**
+ * @brief 就地初始化（不分配内存）
+ * @param fb 功能块指针
+ * @param model 系统模型
+ * @param x0 初始状态（n 个），NULL 表示全 0
+ * @param P0 初始协方差（n×n），NULL 表示单位阵
+ * @return 0 成功，-1 维数超出范围、矩阵含非有限值、Q/P0 不对称或 R 不为正
+ */
+int kalman_init(KalmanFB* fb, const KalmanModel* model, const double* x0, const double* P0);
+
+/**
+ * @brief 从实例池创建
+ * @param model 系统模型
+ * @param x0 初始状态，NULL 表示全 0
+ * @param P0 初始协方差，NULL 表示单位阵
+ * @return 功能块指针，参数无效或实例池已满时返回 NULL
+ */
+KalmanFB* kalman_create(const KalmanModel* model, const double* x0, const double* P0);
+
+/**
+ * @brief 销毁功能块
+ * @param fb 功能块指针
+ */
+void kalman_destroy(KalmanFB* fb);
+
+/**
+ * @brief 执行一个周期：预测后用本周期的量测更新
+ * @param fb 功能块指针
+ * @param z 量测值（m 个），NaN 表示该量测本周期无效；NULL 表示只预测
+ * @param u 控制输入（p 个），NULL 表示全 0
+ * @return 更新后的状态估计（fb->x，n 个）
+ */
+static inline const double* kalman_compute(KalmanFB* fb, const double* z, const double* u) {
+    FB_TIMED(&fb->base);
+    fb->step(fb, z, u);
+    return fb->x;
+}
+
+/**
+ * @brief 恢复初始状态和协方差，清零统计
+ * @param fb 功能块指针
+ */
+void kalman_reset(KalmanFB* fb);
+
+/**
+ * @brief 设置当前状态估计和协方差（例如由首个量测初始化）
+ * @param fb 功能块指针
+ * @param x 状态（n 个），NULL 表示不变
+ * @param P 协方差（n×n），NULL 表示不变
+ * @return 0 成功，-1 含非有限值或 P 不对称（状态不变）
+ */
+int kalman_set_state(KalmanFB* fb, const double* x, const double* P);
+
+/**
+ * @brief 修改噪声协方差（在线调整滤波带宽）
+ * @param fb 功能块指针
+ * @param Q 过程噪声协方差（n×n），NULL 表示不变
+ * @param R 量测噪声方差（m 个），NULL 表示不变
+ * @return 0 成功，-1 参数无效（原值不变）
+ */
+int kalman_set_noise(KalmanFB* fb, const double* Q, const double* R);
+
+/**
+ * @brief 设置新息门限
+ * @param fb 功能块指针
+ * @param gate 标准差倍数，0 表示不检验
+ * @return 0 成功，-1 gate 为负数或非有限值
+ */
+int kalman_set_gate(KalmanFB* fb, double gate);
+
+#endif // FB_KALMAN_H
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_kalman_impl.h
+ * @brief 卡尔曼滤波单步内核模板（由 fb_kalman.c 按状态数多次包含，无包含保护）
+ *
+ * 包含前需定义 KALMAN_N（状态数，1 ~ KALMAN_MAX_STATES）和 KALMAN_UNROLL
+ * （循环展开提示），生成 kalman_step_<N>()。状态维的循环次数均为编译期常量，
+ * 量测数和控制输入数在运行时取自功能块。包含结束时取消 KALMAN_N。
+ *
+ * 累加顺序固定为下标递增，tests/benchmark/kalman.py 的参考实现按同样顺序计算。
+ */
+
+#define KALMAN_STEP FB_CAT(kalman_step_, KALMAN_N)
+
+static void KALMAN_STEP(KalmanFB* fb, const double* z, const double* u) {
+    double x[KALMAN_N];
+    double FP[KALMAN_N][KALMAN_N];
+
+    // 预测：x = F·x + B·u
+    KALMAN_UNROLL
+    for (int i = 0; i < KALMAN_N; i++) {
+        double acc = 0.0;
+        KALMAN_UNROLL
+        for (int j = 0; j < KALMAN_N; j++) {
+            acc += fb->F[i][j] * fb->x[j];
+        }
+        if (u) {
+            for (uint32_t k = 0; k < fb->p; k++) {
+                acc += fb->B[i][k] * u[k];
+            }
+        }
+        x[i] = acc;
+    }
+
+    // P = F·P·Fᵀ + Q，只算上三角再镜像，保持严格对称
+    KALMAN_UNROLL
+    for (int i = 0; i < KALMAN_N; i++) {
+        KALMAN_UNROLL
+        for (int j = 0; j < KALMAN_N; j++) {
+            double acc = 0.0;
+            KALMAN_UNROLL
+            for (int k = 0; k < KALMAN_N; k++) {
+                acc += fb->F[i][k] * fb->P[k][j];
+            }
+            FP[i][j] = acc;
+        }
+    }
+    KALMAN_UNROLL
+    for (int i = 0; i < KALMAN_N; i++) {
+        KALMAN_UNROLL
+        for (int j = i; j < KALMAN_N; j++) {
+            double acc = 0.0;
+            KALMAN_UNROLL
+            for (int k = 0; k < KALMAN_N; k++) {
+                acc += FP[i][k] * fb->F[j][k];
+            }
+            fb->P[i][j] = fb->P[j][i] = acc + fb->Q[i][j];
+        }
+    }
+
+    // 逐个量测做标量更新
+    for (uint32_t j = 0; j < fb->m; j++) {
+        fb->innovation[j] = NAN;
+        if (!z || !isfinite(z[j])) {
+            continue;
+        }
+
+        const double* h = fb->H[j];
+        double ph[KALMAN_N];
+        double s = 0.0;
+        double hx = 0.0;
+        KALMAN_UNROLL
+        for (int i = 0; i < KALMAN_N; i++) {
+            double acc = 0.0;
+            KALMAN_UNROLL
+            for (int k = 0; k < KALMAN_N; k++) {
+                acc += fb->P[i][k] * h[k];
+            }
+            ph[i] = acc;
+        }
+        KALMAN_UNROLL
+        for (int i = 0; i < KALMAN_N; i++) {
+            s += h[i] * ph[i];
+            hx += h[i] * x[i];
+        }
+        s += fb->R[j];
+
+        double y = z[j] - hx;
+        fb->innovation[j] = y;
+        if (!(s > 0.0) || (fb->gate > 0.0 && y * y > fb->gate * fb->gate * s)) {
+            fb->rejected++;
+            continue;
+        }
+
+        double k[KALMAN_N];
+        KALMAN_UNROLL
+        for (int i = 0; i < KALMAN_N; i++) {
+            k[i] = ph[i] / s;
+            x[i] += k[i] * y;
+        }
+        KALMAN_UNROLL
+        for (int i = 0; i < KALMAN_N; i++) {
+            KALMAN_UNROLL
+            for (int l = i; l < KALMAN_N; l++) {
+                fb->P[i][l] = fb->P[l][i] = fb->P[i][l] - k[i] * ph[l];
+            }
+        }
+    }
+
+    KALMAN_UNROLL
+    for (int i = 0; i < KALMAN_N; i++) {
+        fb->x[i] = x[i];
+    }
+    fb->steps++;
+}
+
+#undef KALMAN_STEP
+#undef KALMAN_N
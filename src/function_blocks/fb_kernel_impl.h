@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_kernel_impl.h
+ * @brief 功能块计算内核模板（由 fb_kernels.h 按数值类型多次包含，无包含保护）
+ *
+ * 包含前需定义：
+ *   FB_REAL                          数值类型
+ *   FB_SUFFIX                        类型和函数名后缀（double 为空）
+ *   FB_ADD / FB_SUB / FB_MUL / FB_DIV  四则运算
+ *   FB_LIT(x)                        double 字面量转为 FB_REAL
+ * 比较直接使用 < > == !=（浮点和定点数均适用）。包含结束时取消以上定义。
+ *
+ * 运算顺序即 double 版本的运算顺序：FB_REAL 为 double 时展开后与手写的
+ * 浮点表达式相同，结果逐位不变。
+ */
+
+#define FB_NAME(x) FB_CAT(x, FB_SUFFIX)
+
+// PID 参数结构体
+typedef struct {
+    FB_REAL Kp;          // 比例系数 [0, 1e6]
+    FB_REAL Ki;          // 积分系数 [0, 1e6]
+    FB_REAL Kd;          // 微分系数 [0, 1e6]
+    FB_REAL output_min;  // 输出下限
+    FB_REAL output_max;  // 输出上限
+} FB_NAME(PIDParams);
+
+// PID 内部状态
+typedef struct {
+    FB_REAL integral;    // 积分累积值
+    FB_REAL prev_error;  // 上一周期误差
+} FB_NAME(PIDState);
+
+// 一阶惯性参数
+typedef struct {
+    FB_REAL T;           // 时间常数（秒）[0.001, 1e6]
+} FB_NAME(FirstOrderParams);
+
+// 一阶惯性状态
+typedef struct {
+    FB_REAL prev_output; // 上一周期输出值
+} FB_NAME(FirstOrderState);
+
+/**
+ * @brief 将数值限制到指定范围（先判断下限）
+ * @param value 输入值
+ * @param min 最小值
+ * @param max 最大值
+ * @return 限制后的值
+ */
+static inline FB_REAL FB_NAME(clamp)(FB_REAL value, FB_REAL min, FB_REAL max) {
+    if (value < min) return min;
+    if (value > max) return max;
+    return value;
+}
+
+/**
+ * @brief 标准位置式 PID 一个周期：CV = Kp*e + Ki*∫e + Kd*de/dt，输出限幅，
+ *        饱和且 Ki > 0 时回退本周期积分
+ * @param p 参数
+ * @param s 状态（更新 integral 和 prev_error）
+ * @param SP 设定值
+ * @param PV 过程变量
+ * @param dt 时间步长（秒），不大于 0 时不计算微分
+ * @return 限幅后的输出
+ */
+static inline FB_REAL FB_NAME(pid_kernel)(const FB_NAME(PIDParams)* p, FB_NAME(PIDState)* s,
+                                          FB_REAL SP, FB_REAL PV, FB_REAL dt) {
+    FB_REAL error = FB_SUB(SP, PV);
+    FB_REAL output = FB_MUL(p->Kp, error);
+
+    s->integral = FB_ADD(s->integral, FB_MUL(error, dt));
+    output = FB_ADD(output, FB_MUL(p->Ki, s->integral));
+
+    if (dt > FB_LIT(0.0)) {
+        FB_REAL derivative = FB_DIV(FB_SUB(error, s->prev_error), dt);
+        output = FB_ADD(output, FB_MUL(p->Kd, derivative));
+    }
+
+    s->prev_error = error;
+
+    FB_REAL limited = FB_NAME(clamp)(output, p->output_min, p->output_max);
+    if (__builtin_expect(limited != output && p->Ki > FB_LIT(0.0), 0)) {
+        s->integral = FB_SUB(s->integral, FB_MUL(error, dt));
+    }
+
+    return limited;
+}
+
+/**
+ * @brief 一阶惯性滤波系数 alpha = dt / (T + dt)
+ * @param T 时间常数（秒）
+ * @param dt 时间步长（秒）
+ * @return alpha
+ */
+static inline FB_REAL FB_NAME(first_order_alpha)(FB_REAL T, FB_REAL dt) {
+    return FB_DIV(dt, FB_ADD(T, dt));
+}
+
+/**
+ * @brief 一阶惯性一个周期：Output = alpha * Input + (1 - alpha) * prev_output
+ * @param s 状态（更新 prev_output）
+ * @param alpha 滤波系数
+ * @param input 输入值
+ * @return 输出值
+ */
+static inline FB_REAL FB_NAME(first_order_kernel)(FB_NAME(FirstOrderState)* s, FB_REAL alpha,
+                                                  FB_REAL input) {
+    FB_REAL output = FB_ADD(FB_MUL(alpha, input),
+                            FB_MUL(FB_SUB(FB_LIT(1.0), alpha), s->prev_output));
+    s->prev_output = output;
+    return output;
+}
+
+/**
+ * @brief 斜率限制一个周期：输出向输入靠近，每周期变化不超过 rate * dt
+ * @param output 当前输出（原地更新）
+ * @param rising_rate 上升速率（单位/秒）
+ * @param falling_rate 下降速率（单位/秒）
+ * @param input 输入值
+ * @param dt 时间步长（秒）
+ * @return 更新后的输出
+ */
+static inline FB_REAL FB_NAME(ramp_kernel)(FB_REAL* output, FB_REAL rising_rate,
+                                           FB_REAL falling_rate, FB_REAL input, FB_REAL dt) {
+    FB_REAL error = FB_SUB(input, *output);
+    FB_REAL max_change = error > FB_LIT(0.0) ? FB_MUL(rising_rate, dt)
+                                             : FB_MUL(falling_rate, dt);
+    FB_REAL abs_error = error < FB_LIT(0.0) ? FB_SUB(FB_LIT(0.0), error) : error;
+
+    if (abs_error <= max_change) {
+        *output = input;
+    } else if (error > FB_LIT(0.0)) {
+        *output = FB_ADD(*output, max_change);
+    } else {
+        *output = FB_SUB(*output, max_change);
+    }
+
+    return *output;
+}
+
+#undef FB_NAME
+#undef FB_REAL
+#undef FB_SUFFIX
+#undef FB_ADD
+#undef FB_SUB
+#undef FB_MUL
+#undef FB_DIV
+#undef FB_LIT
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_kernels.h
+ * @brief 功能块计算内核的 double / float32 / Q16.16 实例
+ *
+ * fb_kernel_impl.h 是与数值类型无关的内核模板，这里按三种类型各包含一次：
+ *   - double：不加后缀，即 PIDParams、PIDState、FirstOrderParams、FirstOrderState、
+ *     clamp() 以及 PID / 一阶惯性 / 斜率限制功能块使用的 pid_kernel() 等；
+ *   - float32：后缀 _f32（PIDParams_f32、pid_kernel_f32() ...），存储和访存减半，
+ *     SIMD 每个向量的通道数加倍；
+ *   - Q16.16 定点：后缀 _q16，无浮点单元的控制器使用，运算饱和（见 fb_numeric.h）。
+ * 三种实例共用同一份算法代码，修改算法只需修改模板。
+ */
+
+#ifndef FB_KERNELS_H
+#define FB_KERNELS_H
+
+#include "fb_numeric.h"
+
+#define FB_CAT_(a, b) a##b
+#define FB_CAT(a, b) FB_CAT_(a, b)
+
+// double
+#define FB_REAL double
+#define FB_SUFFIX
+#define FB_ADD(a, b) ((a) + (b))
+#define FB_SUB(a, b) ((a) - (b))
+#define FB_MUL(a, b) ((a) * (b))
+#define FB_DIV(a, b) ((a) / (b))
+#define FB_LIT(x) (x)
+#include "fb_kernel_impl.h"
+
+// float32
+#define FB_REAL float
+#define FB_SUFFIX _f32
+#define FB_ADD(a, b) ((a) + (b))
+#define FB_SUB(a, b) ((a) - (b))
+#define FB_MUL(a, b) ((a) * (b))
+#define FB_DIV(a, b) ((a) / (b))
+#define FB_LIT(x) ((float)(x))
+#include "fb_kernel_impl.h"
+
+// Q16.16 定点
+#define FB_REAL fb_q16_t
+#define FB_SUFFIX _q16
+#define FB_ADD(a, b) fb_q16_add(a, b)
+#define FB_SUB(a, b) fb_q16_sub(a, b)
+#define FB_MUL(a, b) fb_q16_mul(a, b)
+#define FB_DIV(a, b) fb_q16_div(a, b)
+#define FB_LIT(x) FB_Q16_LIT(x)
+#include "fb_kernel_impl.h"
+
+#endif // FB_KERNELS_H
@@ -27,6 +27,9 @@
  */
 
 #include "fb_limit.h"
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
 
 int limit_init(LimitFB* fb, double min_value, double max_value) {
     if (!fb) {
@@ -50,23 +53,41 @@ int limit_init(LimitFB* fb, double min_value, double max_value) {
     return 0;
 }
 
+LimitFB* limit_create(double min_value, double max_value) {
+    /* 参数验证（先于分配，避免占用槽位） */
+    if (min_value > max_value) {
+        return NULL;
+    }
+
+    LimitFB* fb = (LimitFB*)fb_pool_alloc(FB_TYPE_LIMIT);
+    if (!fb) {
+        return NULL;
+    }
+
+    limit_init(fb, min_value, max_value);
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        fb_pool_free(FB_TYPE_LIMIT, fb);
+        return NULL;
+    }
+    return fb;
+}
+
+void limit_destroy(LimitFB* fb) {
+    if (fb) {
+        fb_registry_unregister(fb->base.id);
+        fb_pool_free(FB_TYPE_LIMIT, fb);
+    }
+}
+
 double limit_compute(LimitFB* fb, double input) {
     if (!fb) {
         return 0.0;
     }
 
-    double output;
+    FB_TIMED(&fb->base);
 
     /* 限幅逻辑 */
-    if (input < fb->min_value) {
-        output = fb->min_value;
-    } else if (input > fb->max_value) {
-        output = fb->max_value;
-    } else {
-        output = input;
-    }
-
-    return output;
+    return clamp(input, fb->min_value, fb->max_value);
 }
 
 int limit_set_params(LimitFB* fb, double min_value, double max_value) {
@@ -53,6 +53,20 @@ typedef struct {
  */
 int limit_init(LimitFB* fb, double min_value, double max_value);
 
+/**
+ * @brief 从实例池创建 Limit 功能块
+ * @param min_value 最小值
+ * @param max_value 最大值
+ * @return 功能块指针，参数无效或实例池已满时返回 NULL
+ */
+LimitFB* limit_create(double min_value, double max_value);
+
+/**
+ * @brief 把 Limit 功能块归还实例池
+ * @param fb Limit 功能块指针
+ */
+void limit_destroy(LimitFB* fb);
+
 /**
  * @brief 执行 Limit 计算
  * @param fb Limit 功能块指针
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_lookup.c
+ * @brief 折线表（特性曲线）功能块实现
+ */
+
+#include "fb_lookup.h"
+#include "fb_journal.h"
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
+#include "../runtime/logger.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 断点偏离等间距网格不超过间距的该比例时按等间距处理（下标随后逐步修正）
+#define LOOKUP_UNIFORM_TOL 1e-9
+
+/* ========== 断点轴 ========== */
+
+int lookup_axis_init(LookupAxis* axis, const double* x, size_t n) {
+    if (!axis || !x || n < 2 || n > LOOKUP_MAX_POINTS) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (!isfinite(x[i]) || (i > 0 && !(x[i] > x[i - 1]))) {
+            return -1;
+        }
+    }
+
+    double dx = (x[n - 1] - x[0]) / (double)(n - 1);
+    int uniform = dx > 0.0;
+    for (size_t i = 1; i < n - 1 && uniform; i++) {
+        uniform = fabs(x[i] - (x[0] + (double)i * dx)) <= LOOKUP_UNIFORM_TOL * dx;
+    }
+
+    axis->x = x;
+    axis->n = (uint32_t)n;
+    axis->last = 0;
+    axis->uniform = uniform;
+    axis->x0 = x[0];
+    axis->inv_dx = uniform ? 1.0 / dx : 0.0;
+    return 0;
+}
+
+// value 是否落在区间 i 内（首尾区间向外延伸）
+static inline int in_segment(const double* x, uint32_t last_seg, uint32_t i, double value) {
+    return (i == 0 || x[i] <= value) && (i == last_seg || value < x[i + 1]);
+}
+
+uint32_t lookup_axis_find(LookupAxis* axis, double value) {
+    const double* x = axis->x;
+    uint32_t last_seg = axis->n - 2;
+    uint32_t i;
+
+    if (axis->uniform) {
+        // 等间距：直接算出下标，再按断点修正舍入造成的一格偏差
+        double pos = (value - axis->x0) * axis->inv_dx;
+        if (!(pos >= 0.0)) {
+            i = 0;
+        } else if (pos >= (double)last_seg) {
+            i = last_seg;
+        } else {
+            i = (uint32_t)pos;
+        }
+        while (i > 0 && value < x[i]) {
+            i--;
+        }
+        while (i < last_seg && value >= x[i + 1]) {
+            i++;
+        }
+    } else {
+        // 单调输入：先检查上次的区间及相邻区间
+        i = axis->last;
+        if (!in_segment(x, last_seg, i, value)) {
+            if (i < last_seg && in_segment(x, last_seg, i + 1, value)) {
+                i++;
+            } else if (i > 0 && in_segment(x, last_seg, i - 1, value)) {
+                i--;
+            } else {
+                uint32_t lo = 0, hi = last_seg;
+                while (lo < hi) {
+                    uint32_t mid = lo + (hi - lo + 1) / 2;
+                    if (x[mid] <= value) {
+                        lo = mid;
+                    } else {
+                        hi = mid - 1;
+                    }
+                }
+                i = lo;
+            }
+        }
+    }
+
+    axis->last = i;
+    return i;
+}
+
+// 区间 i 内的插值权重
+static inline double segment_weight(const LookupAxis* axis, uint32_t i, double value) {
+    return (value - axis->x[i]) / (axis->x[i + 1] - axis->x[i]);
+}
+
+// 线性插值，t 为 0 或 1 时恰好等于端点值
+static inline double lerp(double a, double b, double t) {
+    return (1.0 - t) * a + t * b;
+}
+
+static void init_base(FunctionBlock* base, FunctionBlockType type) {
+    base->type = type;
+    base->id = 0;
+    base->last_update_time = 0.0;
+}
+
+/* ========== 一维 ========== */
+
+// 换用表；storage 为新表的自有存储（引用外部数组时为 NULL）
+static int lookup1d_attach(Lookup1DFB* fb, const double* x, const double* y, size_t n,
+                           void* storage) {
+    LookupAxis axis;
+    if (!fb || !y || lookup_axis_init(&axis, x, n) != 0) {
+        return -1;
+    }
+
+    if (fb->storage != storage) {
+        fb_pool_storage_free(fb->storage);
+    }
+    fb->axis = axis;
+    fb->y = y;
+    fb->storage = storage;
+    return 0;
+}
+
+int lookup1d_init(Lookup1DFB* fb, const double* x, const double* y, size_t n, int clamped) {
+    if (!fb) {
+        return -1;
+    }
+
+    init_base(&fb->base, FB_TYPE_LOOKUP_1D);
+    fb->clamp = clamped != 0;
+    fb->output = 0.0;
+    fb->storage = NULL;
+    return lookup1d_attach(fb, x, y, n, NULL);
+}
+
+Lookup1DFB* lookup1d_create(const double* x, const double* y, size_t n, int clamped) {
+    Lookup1DFB* fb = (Lookup1DFB*)fb_pool_alloc(FB_TYPE_LOOKUP_1D);
+    if (!fb) {
+        LOG_ERROR_MSG("折线表创建失败：实例池已满");
+        return NULL;
+    }
+
+    if (lookup1d_init(fb, x, y, n, clamped) != 0) {
+        LOG_ERROR_MSG("折线表创建失败：断点无效（%zu 个，须严格递增）", n);
+        fb_pool_free(FB_TYPE_LOOKUP_1D, fb);
+        return NULL;
+    }
+
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        fb_pool_free(FB_TYPE_LOOKUP_1D, fb);
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_LOOKUP_1D, fb->base.id, FB_EVENT_CREATE, "points,uniform", (double)n,
+               (double)fb->axis.uniform);
+    return fb;
+}
+
+void lookup1d_release(Lookup1DFB* fb) {
+    if (fb) {
+        fb_pool_storage_free(fb->storage);
+        fb->storage = NULL;
+    }
+}
+
+void lookup1d_destroy(Lookup1DFB* fb) {
+    if (fb) {
+        FB_JOURNAL_EVENT(FB_TYPE_LOOKUP_1D, fb->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(fb->base.id);
+        lookup1d_release(fb);
+        fb_pool_free(FB_TYPE_LOOKUP_1D, fb);
+    }
+}
+
+double lookup1d_compute(Lookup1DFB* fb, double input) {
+    if (!fb) {
+        return 0.0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    const double* x = fb->axis.x;
+    uint32_t n = fb->axis.n;
+    if (fb->clamp) {
+        if (input <= x[0]) {
+            return fb->output = fb->y[0];
+        }
+        if (input >= x[n - 1]) {
+            return fb->output = fb->y[n - 1];
+        }
+    }
+
+    uint32_t i = lookup_axis_find(&fb->axis, input);
+    double t = segment_weight(&fb->axis, i, input);
+    fb->output = lerp(fb->y[i], fb->y[i + 1], t);
+    return fb->output;
+}
+
+int lookup1d_set_table(Lookup1DFB* fb, const double* x, const double* y, size_t n) {
+    return lookup1d_attach(fb, x, y, n, NULL);
+}
+
+int lookup1d_copy_table(Lookup1DFB* fb, const double* x, const double* y, size_t n) {
+    if (!fb || !x || !y || n < 2 || n > LOOKUP_MAX_POINTS) {
+        return -1;
+    }
+
+    // 表副本从实例池的附属存储区分配，网络和脚本中换表都不调用系统分配器
+    double* copy = (double*)fb_pool_storage_alloc(2 * n * sizeof(double));
+    if (!copy) {
+        LOG_ERROR_MSG("折线表复制失败：附属存储区不足（%zu 个断点）", n);
+        return -1;
+    }
+    memcpy(copy, x, n * sizeof(double));
+    memcpy(copy + n, y, n * sizeof(double));
+
+    if (lookup1d_attach(fb, copy, copy + n, n, copy) != 0) {
+        fb_pool_storage_free(copy);
+        return -1;
+    }
+    return 0;
+}
+
+/* ========== 二维 ========== */
+
+static int lookup2d_attach(Lookup2DFB* fb, const double* u, size_t nu, const double* v,
+                           size_t nv, const double* z, void* storage) {
+    LookupAxis ua, va;
+    if (!fb || !z || lookup_axis_init(&ua, u, nu) != 0 || lookup_axis_init(&va, v, nv) != 0) {
+        return -1;
+    }
+
+    if (fb->storage != storage) {
+        fb_pool_storage_free(fb->storage);
+    }
+    fb->u = ua;
+    fb->v = va;
+    fb->z = z;
+    fb->storage = storage;
+    return 0;
+}
+
+int lookup2d_init(Lookup2DFB* fb, const double* u, size_t nu, const double* v, size_t nv,
+                  const double* z, int clamped) {
+    if (!fb) {
+        return -1;
+    }
+
+    init_base(&fb->base, FB_TYPE_LOOKUP_2D);
+    fb->clamp = clamped != 0;
+    fb->output = 0.0;
+    fb->storage = NULL;
+    return lookup2d_attach(fb, u, nu, v, nv, z, NULL);
+}
+
+Lookup2DFB* lookup2d_create(const double* u, size_t nu, const double* v, size_t nv,
+                            const double* z, int clamped) {
+    Lookup2DFB* fb = (Lookup2DFB*)fb_pool_alloc(FB_TYPE_LOOKUP_2D);
+    if (!fb) {
+        LOG_ERROR_MSG("二维折线表创建失败：实例池已满");
+        return NULL;
+    }
+
+    if (lookup2d_init(fb, u, nu, v, nv, z, clamped) != 0) {
+        LOG_ERROR_MSG("二维折线表创建失败：断点无效（%zu × %zu，须严格递增）", nu, nv);
+        fb_pool_free(FB_TYPE_LOOKUP_2D, fb);
+        return NULL;
+    }
+
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        fb_pool_free(FB_TYPE_LOOKUP_2D, fb);
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_LOOKUP_2D, fb->base.id, FB_EVENT_CREATE, "nu,nv", (double)nu, (double)nv);
+    return fb;
+}
+
+void lookup2d_destroy(Lookup2DFB* fb) {
+    if (fb) {
+        FB_JOURNAL_EVENT(FB_TYPE_LOOKUP_2D, fb->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(fb->base.id);
+        fb_pool_storage_free(fb->storage);
+        fb_pool_free(FB_TYPE_LOOKUP_2D, fb);
+    }
+}
+
+double lookup2d_compute(Lookup2DFB* fb, double a, double b) {
+    if (!fb) {
+        return 0.0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    if (fb->clamp) {
+        a = clamp(a, fb->u.x[0], fb->u.x[fb->u.n - 1]);
+        b = clamp(b, fb->v.x[0], fb->v.x[fb->v.n - 1]);
+    }
+
+    uint32_t i = lookup_axis_find(&fb->u, a);
+    uint32_t j = lookup_axis_find(&fb->v, b);
+    double ta = segment_weight(&fb->u, i, a);
+    double tb = segment_weight(&fb->v, j, b);
+
+    const double* r0 = fb->z + (size_t)i * fb->v.n + j;
+    const double* r1 = r0 + fb->v.n;
+    fb->output = lerp(lerp(r0[0], r0[1], tb), lerp(r1[0], r1[1], tb), ta);
+    return fb->output;
+}
+
+int lookup2d_set_table(Lookup2DFB* fb, const double* u, size_t nu, const double* v, size_t nv,
+                       const double* z) {
+    return lookup2d_attach(fb, u, nu, v, nv, z, NULL);
+}
+
+int lookup2d_copy_table(Lookup2DFB* fb, const double* u, size_t nu, const double* v,
+                        size_t nv, const double* z) {
+    if (!fb || !u || !v || !z || nu < 2 || nv < 2 || nu > LOOKUP_MAX_POINTS ||
+        nv > LOOKUP_MAX_POINTS || nu > SIZE_MAX / sizeof(double) / nv - 2) {
+        return -1;
+    }
+
+    size_t count = nu + nv + nu * nv;
+    double* copy = (double*)fb_pool_storage_alloc(count * sizeof(double));
+    if (!copy) {
+        LOG_ERROR_MSG("二维折线表复制失败：附属存储区不足（%zu × %zu）", nu, nv);
+        return -1;
+    }
+    memcpy(copy, u, nu * sizeof(double));
+    memcpy(copy + nu, v, nv * sizeof(double));
+    memcpy(copy + nu + nv, z, nu * nv * sizeof(double));
+
+    if (lookup2d_attach(fb, copy, nu, copy + nu, nv, copy + nu + nv, copy) != 0) {
+        fb_pool_storage_free(copy);
+        return -1;
+    }
+    return 0;
+}
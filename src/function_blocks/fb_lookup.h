@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_lookup.h
+ * @brief 折线表（特性曲线）功能块接口
+ *
+ * 用于阀门流量特性、传感器线性化等分段线性曲线：
+ *   - Lookup1D：y = f(x)，断点之间线性插值；
+ *   - Lookup2D：z = f(u, v)，网格内双线性插值，表按行主序存放（u 为行）。
+ * 断点须严格递增。查找区间时：
+ *   - 等间距断点在初始化时识别，区间下标由 (x - x0) / dx 直接算出，O(1)；
+ *   - 非等间距断点先检查上次命中的区间及其相邻区间（单调变化的输入几乎
+ *     总是命中），否则二分查找，O(log n)。
+ * 两种方式得到的区间相同：i 为满足 x[i] <= input 的最大下标，限制在
+ * [0, n-2]，因此结果与断点是否等间距无关。
+ * 超出断点范围时可选限幅（输出端点值）或按端点区间线性外推。
+ *
+ * 表默认按指针引用调用者的数组，不复制（Python 绑定直接引用缓冲区）；
+ * xxx_copy_table() 把表复制到从实例池附属存储区分配的自有存储中（配置文件中的曲线）。
+ */
+
+#ifndef FB_LOOKUP_H
+#define FB_LOOKUP_H
+
+#include "fb_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define LOOKUP_MAX_POINTS (1u << 24)   // 每个轴的最大断点数
+
+// 断点轴
+typedef struct {
+    const double* x;     // 严格递增的断点（不复制）
+    uint32_t n;          // 断点数 [2, LOOKUP_MAX_POINTS]
+    uint32_t last;       // 上次命中的区间
+    int uniform;         // 1：等间距断点，区间下标直接计算
+    double x0;           // 首个断点
+    double inv_dx;       // 等间距时 1 / 间距
+} LookupAxis;
+
+// 一维折线表功能块
+typedef struct {
+    FunctionBlock base;
+    LookupAxis axis;
+    const double* y;     // 各断点的输出值（axis.n 个，不复制）
+    int clamp;           // 1：超出范围时输出端点值；0：按端点区间线性外推
+    double output;       // 最近一次输出
+    void* storage;       // lookup1d_copy_table() 复制的表，引用外部数组时为 NULL
+} Lookup1DFB;
+
+// 二维折线表功能块
+typedef struct {
+    FunctionBlock base;
+    LookupAxis u;        // 行断点（第一个输入）
+    LookupAxis v;        // 列断点（第二个输入）
+    const double* z;     // u.n × v.n 个输出值，行主序（不复制）
+    int clamp;           // 1：两个输入各自限制在断点范围内；0：线性外推
+    double output;       // 最近一次输出
+    void* storage;       // lookup2d_copy_table() 复制的表，引用外部数组时为 NULL
+} Lookup2DFB;
+
+/**
+ * @brief 初始化断点轴（校验断点并识别等间距）
+ * @param axis 断点轴
+ * @param x 断点数组（严格递增的有限值，不复制）
+ * @param n 断点数 [2, LOOKUP_MAX_POINTS]
+ * @return 0 成功，-1 断点无效
+ */
+int lookup_axis_init(LookupAxis* axis, const double* x, size_t n);
+
+/**
+ * @brief 查找输入所在区间
+ * @param axis 断点轴
+ * @param value 输入值
+ * @return 满足 x[i] <= value 的最大下标 i，限制在 [0, n-2]（value 为 NaN 时为 0）
+ */
+uint32_t lookup_axis_find(LookupAxis* axis, double value);
+
+/**
+ * @brief 就地初始化一维折线表（引用外部数组，不分配内存）
+ * @param fb 功能块指针
+ * @param x 断点数组（严格递增）
+ * @param y 输出值数组
+ * @param n 断点数
+ * @param clamped 1 限幅，0 外推
+ * @return 0 成功，-1 参数无效
+ */
+int lookup1d_init(Lookup1DFB* fb, const double* x, const double* y, size_t n, int clamped);
+
+/**
+ * @brief 从实例池创建一维折线表（引用外部数组）
+ * @param x 断点数组
+ * @param y 输出值数组
+ * @param n 断点数
+ * @param clamped 1 限幅，0 外推
+ * @return 功能块指针，参数无效或实例池已满时返回 NULL
+ */
+Lookup1DFB* lookup1d_create(const double* x, const double* y, size_t n, int clamped);
+
+/**
+ * @brief 销毁一维折线表（同时释放复制的表）
+ * @param fb 功能块指针
+ */
+void lookup1d_destroy(Lookup1DFB* fb);
+
+/**
+ * @brief 释放 lookup1d_copy_table() 复制的表（内嵌实例销毁前调用）
+ * @param fb 功能块指针
+ */
+void lookup1d_release(Lookup1DFB* fb);
+
+/**
+ * @brief 计算输出
+ * @param fb 功能块指针
+ * @param input 输入值
+ * @return 插值结果
+ */
+double lookup1d_compute(Lookup1DFB* fb, double input);
+
+/**
+ * @brief 换用新的外部表（不复制），释放之前复制的表
+ * @param fb 功能块指针
+ * @param x 断点数组
+ * @param y 输出值数组
+ * @param n 断点数
+ * @return 0 成功，-1 断点无效（原表不变）
+ */
+int lookup1d_set_table(Lookup1DFB* fb, const double* x, const double* y, size_t n);
+
+/**
+ * @brief 把表复制到功能块自有的存储中并换用
+ * @param fb 功能块指针
+ * @param x 断点数组
+ * @param y 输出值数组
+ * @param n 断点数
+ * @return 0 成功，-1 断点无效或内存不足（原表不变）
+ */
+int lookup1d_copy_table(Lookup1DFB* fb, const double* x, const double* y, size_t n);
+
+/**
+ * @brief 就地初始化二维折线表（引用外部数组，不分配内存）
+ * @param fb 功能块指针
+ * @param u 行断点（严格递增）
+ * @param nu 行断点数
+ * @param v 列断点（严格递增）
+ * @param nv 列断点数
+ * @param z 输出值（nu × nv，行主序）
+ * @param clamped 1 限幅，0 外推
+ * @return 0 成功，-1 参数无效
+ */
+int lookup2d_init(Lookup2DFB* fb, const double* u, size_t nu, const double* v, size_t nv,
+                  const double* z, int clamped);
+
+/**
+ * @brief 从实例池创建二维折线表（引用外部数组）
+ * @return 功能块指针，参数无效或实例池已满时返回 NULL
+ */
+Lookup2DFB* lookup2d_create(const double* u, size_t nu, const double* v, size_t nv,
+                            const double* z, int clamped);
+
+/**
+ * @brief 销毁二维折线表（同时释放复制的表）
+ * @param fb 功能块指针
+ */
+void lookup2d_destroy(Lookup2DFB* fb);
+
+/**
+ * @brief 计算输出
+ * @param fb 功能块指针
+ * @param a 第一个输入（行）
+ * @param b 第二个输入（列）
+ * @return 双线性插值结果
+ */
+double lookup2d_compute(Lookup2DFB* fb, double a, double b);
+
+/**
+ * @brief 换用新的外部表（不复制），释放之前复制的表
+ * @return 0 成功，-1 断点无效（原表不变）
+ */
+int lookup2d_set_table(Lookup2DFB* fb, const double* u, size_t nu, const double* v, size_t nv,
+                       const double* z);
+
+/**
+ * @brief 把表复制到功能块自有的存储中并换用
+ * @return 0 成功，-1 断点无效或内存不足（原表不变）
+ */
+int lookup2d_copy_table(Lookup2DFB* fb, const double* u, size_t nu, const double* v,
+                        size_t nv, const double* z);
+
+#endif // FB_LOOKUP_H
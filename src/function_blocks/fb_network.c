@@ -0,0 +1,865 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_network.c
+ * @brief 功能块图（FBD）网络执行引擎实现
+ */
+
+#include "fb_network.h"
+#include "fb_registry.h"
+#include "../runtime/logger.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FB_NETWORK_INITIAL_CAPACITY 8
+
+// 各类型的参数名、默认值（与 Python 绑定的构造函数默认值一致）
+static const char* const PID_PARAM_NAMES[] = {"Kp", "Ki", "Kd", "output_min", "output_max",
+                                              "b", "c", "Tf", "Tt", "velocity"};
+static const double PID_PARAM_DEFAULTS[] = {1.0, 0.0, 0.0, -1e6, 1e6, 1.0, 1.0, 0.0, 0.0, 0.0};
+static const char* const FIRST_ORDER_PARAM_NAMES[] = {"T"};
+static const double FIRST_ORDER_PARAM_DEFAULTS[] = {1.0};
+static const char* const RAMP_PARAM_NAMES[] = {"rising_rate", "falling_rate"};
+static const double RAMP_PARAM_DEFAULTS[] = {1.0, 1.0};
+static const char* const LIMIT_PARAM_NAMES[] = {"min_value", "max_value"};
+static const double LIMIT_PARAM_DEFAULTS[] = {0.0, 100.0};
+static const char* const LOOKUP_PARAM_NAMES[] = {"clamp"};
+static const double LOOKUP_PARAM_DEFAULTS[] = {1.0};
+
+// 各类型的输入端口名
+static const char* const PID_INPUT_PORTS[] = {"SP", "PV"};
+static const char* const SISO_INPUT_PORTS[] = {"in"};
+
+static void set_error(FBNetwork* net, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(net->error, sizeof(net->error), fmt, ap);
+    va_end(ap);
+}
+
+// 按需扩容动态数组
+static int ensure_capacity(void** items, size_t* capacity, size_t needed, size_t item_size) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+
+    size_t new_capacity = *capacity ? *capacity * 2 : FB_NETWORK_INITIAL_CAPACITY;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    void* grown = realloc(*items, new_capacity * item_size);
+    if (!grown) {
+        return -1;
+    }
+
+    *items = grown;
+    *capacity = new_capacity;
+    return 0;
+}
+
+static size_t input_port_names(FunctionBlockType type, const char* const** names) {
+    switch (type) {
+    case FB_TYPE_PID:
+        *names = PID_INPUT_PORTS;
+        return 2;
+    case FB_TYPE_FIRST_ORDER:
+    case FB_TYPE_RAMP:
+    case FB_TYPE_LIMIT:
+    case FB_TYPE_LOOKUP_1D:
+        *names = SISO_INPUT_PORTS;
+        return 1;
+    default:
+        *names = NULL;
+        return 0;
+    }
+}
+
+static int is_output_port(FunctionBlockType type, const char* port) {
+    return strcmp(port, "out") == 0 || (type == FB_TYPE_PID && strcmp(port, "CV") == 0);
+}
+
+static FBNetworkSignal* find_signal(FBNetworkSignal* signals, size_t count, const char* name) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(signals[i].name, name) == 0) {
+            return &signals[i];
+        }
+    }
+    return NULL;
+}
+
+// 检查名称合法（非空、不超长、不含 '.'）且未被占用
+static int check_new_name(FBNetwork* net, const char* name) {
+    if (!name || !name[0] || strlen(name) >= FB_NETWORK_NAME_MAX || strchr(name, '.')) {
+        set_error(net, "名称无效：'%s'（需非空、少于 %d 个字符且不含 '.'）",
+                  name ? name : "", FB_NETWORK_NAME_MAX);
+        return -1;
+    }
+
+    if (fb_network_find_block(net, name) ||
+        find_signal(net->inputs, net->input_count, name) ||
+        find_signal(net->outputs, net->output_count, name)) {
+        set_error(net, "名称重复：'%s'", name);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int64_t new_slot(FBNetwork* net, double value) {
+    if (ensure_capacity((void**)&net->slots, &net->slot_capacity, net->slot_count + 1,
+                        sizeof(double)) != 0) {
+        set_error(net, "内存分配失败");
+        return -1;
+    }
+
+    net->slots[net->slot_count] = value;
+    return (int64_t)net->slot_count++;
+}
+
+/*
+ * 解析端口地址
+ *   want_input = 1：地址必须是 "块名.输入端口"，返回该端口下标，*block 指向功能块
+ *   want_input = 0：地址是网络输入名或 "块名.输出端口"，返回源槽位
+ */
+static int64_t resolve(FBNetwork* net, const char* address, int want_input,
+                       FBNetworkBlock** block) {
+    char name[FB_NETWORK_NAME_MAX];
+    const char* dot = address ? strchr(address, '.') : NULL;
+
+    if (!address) {
+        set_error(net, "地址为空");
+        return -1;
+    }
+
+    if (!dot) {
+        FBNetworkSignal* input = want_input ? NULL
+                                            : find_signal(net->inputs, net->input_count, address);
+        if (!input) {
+            set_error(net, "未知%s：'%s'", want_input ? "输入端口" : "信号源", address);
+            return -1;
+        }
+        return input->slot;
+    }
+
+    size_t len = (size_t)(dot - address);
+    if (len >= sizeof(name)) {
+        set_error(net, "未知功能块：'%s'", address);
+        return -1;
+    }
+    memcpy(name, address, len);
+    name[len] = '\0';
+
+    FBNetworkBlock* b = fb_network_find_block(net, name);
+    if (!b) {
+        set_error(net, "未知功能块：'%s'", name);
+        return -1;
+    }
+
+    const char* port = dot + 1;
+    if (!want_input) {
+        if (!is_output_port(b->type, port)) {
+            set_error(net, "功能块 '%s' 没有输出端口 '%s'", name, port);
+            return -1;
+        }
+        return b->out;
+    }
+
+    const char* const* ports;
+    size_t port_count = input_port_names(b->type, &ports);
+    for (size_t k = 0; k < port_count; k++) {
+        if (strcmp(ports[k], port) == 0) {
+            *block = b;
+            return (int64_t)k;
+        }
+    }
+
+    set_error(net, "功能块 '%s' 没有输入端口 '%s'", name, port);
+    return -1;
+}
+
+// 从全局注册表注销全部功能块（blocks 数组可能被重新分配前调用）
+static void unregister_blocks(FBNetwork* net) {
+    for (size_t i = 0; i < net->block_count; i++) {
+        FunctionBlock* base = (FunctionBlock*)&net->blocks[i].fb;
+        fb_registry_unregister(base->id);
+        base->id = 0;
+    }
+}
+
+// 以实例名登记全部功能块；名称已被其他功能块使用时登记为未命名
+static void register_blocks(FBNetwork* net) {
+    for (size_t i = 0; i < net->block_count; i++) {
+        FBNetworkBlock* block = &net->blocks[i];
+        FunctionBlock* base = (FunctionBlock*)&block->fb;
+        if (base->id != 0) {
+            continue;
+        }
+
+        const char* name = block->name;
+        if (fb_registry_find_name(name, NULL) == 0) {
+            LOG_WARNING_MSG("FBD 网络功能块 '%s' 与已登记的名称冲突，按未命名登记", name);
+            name = NULL;
+        }
+        if (fb_registry_register(base, name, NULL) == 0) {
+            LOG_WARNING_MSG("FBD 网络功能块 '%s' 未能登记到注册表", block->name);
+        }
+    }
+}
+
+FBNetwork* fb_network_create(void) {
+    FBNetwork* net = (FBNetwork*)calloc(1, sizeof(FBNetwork));
+    if (!net) {
+        LOG_ERROR_MSG("FBD 网络创建失败：内存分配失败");
+        return NULL;
+    }
+    return net;
+}
+
+void fb_network_destroy(FBNetwork* net) {
+    if (!net) {
+        return;
+    }
+
+    unregister_blocks(net);
+    for (size_t i = 0; i < net->block_count; i++) {
+        if (net->blocks[i].type == FB_TYPE_LOOKUP_1D) {
+            lookup1d_release(&net->blocks[i].fb.lookup);
+        }
+    }
+    free(net->blocks);
+    free(net->inputs);
+    free(net->outputs);
+    free(net->slots);
+    free(net->ops);
+    free(net);
+}
+
+int fb_network_parse_type(const char* kind, FunctionBlockType* type) {
+    if (!kind || !type) {
+        return -1;
+    }
+
+    if (strcmp(kind, "PID") == 0) {
+        *type = FB_TYPE_PID;
+    } else if (strcmp(kind, "FirstOrder") == 0) {
+        *type = FB_TYPE_FIRST_ORDER;
+    } else if (strcmp(kind, "Ramp") == 0) {
+        *type = FB_TYPE_RAMP;
+    } else if (strcmp(kind, "Limit") == 0) {
+        *type = FB_TYPE_LIMIT;
+    } else if (strcmp(kind, "Lookup1D") == 0) {
+        *type = FB_TYPE_LOOKUP_1D;
+    } else {
+        return -1;
+    }
+
+    return 0;
+}
+
+size_t fb_network_param_info(FunctionBlockType type, const char* const** names,
+                             const double** defaults) {
+    switch (type) {
+    case FB_TYPE_PID:
+        *names = PID_PARAM_NAMES;
+        *defaults = PID_PARAM_DEFAULTS;
+        return 10;
+    case FB_TYPE_FIRST_ORDER:
+        *names = FIRST_ORDER_PARAM_NAMES;
+        *defaults = FIRST_ORDER_PARAM_DEFAULTS;
+        return 1;
+    case FB_TYPE_RAMP:
+        *names = RAMP_PARAM_NAMES;
+        *defaults = RAMP_PARAM_DEFAULTS;
+        return 2;
+    case FB_TYPE_LIMIT:
+        *names = LIMIT_PARAM_NAMES;
+        *defaults = LIMIT_PARAM_DEFAULTS;
+        return 2;
+    case FB_TYPE_LOOKUP_1D:
+        *names = LOOKUP_PARAM_NAMES;
+        *defaults = LOOKUP_PARAM_DEFAULTS;
+        return 1;
+    default:
+        *names = NULL;
+        *defaults = NULL;
+        return 0;
+    }
+}
+
+int fb_network_add_input(FBNetwork* net, const char* name, double value) {
+    if (!net || check_new_name(net, name) != 0) {
+        return -1;
+    }
+
+    if (ensure_capacity((void**)&net->inputs, &net->input_capacity, net->input_count + 1,
+                        sizeof(FBNetworkSignal)) != 0) {
+        set_error(net, "内存分配失败");
+        return -1;
+    }
+
+    int64_t slot = new_slot(net, value);
+    if (slot < 0) {
+        return -1;
+    }
+
+    FBNetworkSignal* input = &net->inputs[net->input_count++];
+    strcpy(input->name, name);
+    input->slot = (uint32_t)slot;
+    net->built = 0;
+    return 0;
+}
+
+int fb_network_add_block(FBNetwork* net, const char* name, FunctionBlockType type,
+                         const double* params) {
+    if (!net || check_new_name(net, name) != 0) {
+        return -1;
+    }
+
+    const char* const* names;
+    const double* defaults;
+    if (fb_network_param_info(type, &names, &defaults) == 0) {
+        set_error(net, "功能块 '%s' 的类型不支持在网络中使用", name);
+        return -1;
+    }
+    const double* p = params ? params : defaults;
+
+    FBNetworkBlock block;
+    memset(&block, 0, sizeof(block));
+    strcpy(block.name, name);
+    block.type = type;
+
+    int rc;
+    switch (type) {
+    case FB_TYPE_PID: {
+        PIDOptions options = {p[5], p[6], p[7], p[8], p[9] != 0.0};
+        rc = pid_init(&block.fb.pid, p[0], p[1], p[2], p[3], p[4]);
+        if (rc == 0) {
+            rc = pid_set_options(&block.fb.pid, &options);
+        }
+        break;
+    }
+    case FB_TYPE_FIRST_ORDER:
+        rc = first_order_init(&block.fb.first_order, p[0]);
+        break;
+    case FB_TYPE_RAMP:
+        rc = ramp_init(&block.fb.ramp, p[0], p[1]);
+        break;
+    case FB_TYPE_LOOKUP_1D:
+        // 折线表随后由 fb_network_set_table() 给出，构建前检查
+        block.fb.lookup.base.type = FB_TYPE_LOOKUP_1D;
+        block.fb.lookup.clamp = p[0] != 0.0;
+        rc = 0;
+        break;
+    default:
+        rc = limit_init(&block.fb.limit, p[0], p[1]);
+        break;
+    }
+    if (rc != 0) {
+        set_error(net, "功能块 '%s' 参数无效", name);
+        return -1;
+    }
+
+    unregister_blocks(net);
+    if (ensure_capacity((void**)&net->blocks, &net->block_capacity, net->block_count + 1,
+                        sizeof(FBNetworkBlock)) != 0) {
+        set_error(net, "内存分配失败");
+        return -1;
+    }
+
+    const char* const* ports;
+    size_t port_count = input_port_names(type, &ports);
+    for (size_t k = 0; k < port_count; k++) {
+        int64_t slot = new_slot(net, 0.0);
+        if (slot < 0) {
+            return -1;
+        }
+        block.in[k] = block.own_in[k] = (uint32_t)slot;
+    }
+
+    int64_t out = new_slot(net, 0.0);
+    if (out < 0) {
+        return -1;
+    }
+    block.out = (uint32_t)out;
+
+    net->blocks[net->block_count++] = block;
+    net->built = 0;
+    return 0;
+}
+
+int fb_network_connect(FBNetwork* net, const char* src, const char* dst) {
+    if (!net) {
+        return -1;
+    }
+
+    int64_t src_slot = resolve(net, src, 0, NULL);
+    if (src_slot < 0) {
+        return -1;
+    }
+
+    FBNetworkBlock* block = NULL;
+    int64_t port = resolve(net, dst, 1, &block);
+    if (port < 0) {
+        return -1;
+    }
+
+    if (block->in[port] != block->own_in[port]) {
+        set_error(net, "输入端口 '%s' 已有连线", dst);
+        return -1;
+    }
+
+    block->in[port] = (uint32_t)src_slot;
+    net->built = 0;
+    return 0;
+}
+
+int fb_network_add_output(FBNetwork* net, const char* name, const char* src) {
+    if (!net || check_new_name(net, name) != 0) {
+        return -1;
+    }
+
+    int64_t slot = resolve(net, src, 0, NULL);
+    if (slot < 0) {
+        return -1;
+    }
+
+    if (ensure_capacity((void**)&net->outputs, &net->output_capacity, net->output_count + 1,
+                        sizeof(FBNetworkSignal)) != 0) {
+        set_error(net, "内存分配失败");
+        return -1;
+    }
+
+    FBNetworkSignal* output = &net->outputs[net->output_count++];
+    strcpy(output->name, name);
+    output->slot = (uint32_t)slot;
+    return 0;
+}
+
+/*
+ * 代数环报告：Kahn 排序结束后剩余的功能块既包括环上的块，也包括环的下游；
+ * 反复剔除不再驱动任何剩余块的节点，留下的即为环（及环间路径）上的块。
+ */
+static void report_loop(FBNetwork* net, const int64_t* producer, size_t* indegree) {
+    size_t n = net->block_count;
+    int changed = 1;
+
+    while (changed) {
+        changed = 0;
+        for (size_t b = 0; b < n; b++) {
+            if (indegree[b] == 0) {
+                continue;
+            }
+
+            int drives_remaining = 0;
+            for (size_t c = 0; c < n && !drives_remaining; c++) {
+                if (indegree[c] == 0) {
+                    continue;
+                }
+                const char* const* ports;
+                size_t port_count = input_port_names(net->blocks[c].type, &ports);
+                for (size_t k = 0; k < port_count; k++) {
+                    if (producer[net->blocks[c].in[k]] == (int64_t)b) {
+                        drives_remaining = 1;
+                        break;
+                    }
+                }
+            }
+
+            if (!drives_remaining) {
+                indegree[b] = 0;
+                changed = 1;
+            }
+        }
+    }
+
+    size_t len = (size_t)snprintf(net->error, sizeof(net->error), "存在代数环：");
+    const char* sep = "";
+    for (size_t b = 0; b < n && len < sizeof(net->error); b++) {
+        if (indegree[b] > 0) {
+            len += (size_t)snprintf(net->error + len, sizeof(net->error) - len, "%s%s",
+                                    sep, net->blocks[b].name);
+            sep = ", ";
+        }
+    }
+}
+
+int fb_network_build(FBNetwork* net) {
+    if (!net) {
+        return -1;
+    }
+
+    size_t n = net->block_count;
+    net->error[0] = '\0';
+    net->built = 0;
+
+    for (size_t b = 0; b < n; b++) {
+        if (net->blocks[b].type == FB_TYPE_LOOKUP_1D && net->blocks[b].fb.lookup.axis.n == 0) {
+            set_error(net, "折线表 '%s' 未设置断点", net->blocks[b].name);
+            LOG_ERROR_MSG("FBD 网络构建失败：%s", net->error);
+            return -1;
+        }
+    }
+
+    FBNetworkOp* ops = (FBNetworkOp*)malloc((n ? n : 1) * sizeof(FBNetworkOp));
+    int64_t* producer = (int64_t*)malloc((net->slot_count ? net->slot_count : 1) *
+                                         sizeof(int64_t));
+    size_t* indegree = (size_t*)calloc(n ? n : 1, sizeof(size_t));
+    size_t* succ_start = (size_t*)calloc(n + 1, sizeof(size_t));
+    size_t* succ = (size_t*)malloc((n ? n : 1) * FB_NETWORK_MAX_INPUTS * sizeof(size_t));
+    size_t* queue = (size_t*)malloc((n ? n : 1) * sizeof(size_t));
+    int rc = -1;
+
+    if (!ops || !producer || !indegree || !succ_start || !succ || !queue) {
+        set_error(net, "内存分配失败");
+        goto done;
+    }
+
+    // 槽位 -> 产生该槽位的功能块
+    for (size_t s = 0; s < net->slot_count; s++) {
+        producer[s] = -1;
+    }
+    for (size_t b = 0; b < n; b++) {
+        producer[net->blocks[b].out] = (int64_t)b;
+    }
+
+    // 入度与后继表（CSR）；当前所有功能块均为直通型，任何闭环都是代数环
+    for (size_t b = 0; b < n; b++) {
+        const char* const* ports;
+        size_t port_count = input_port_names(net->blocks[b].type, &ports);
+        for (size_t k = 0; k < port_count; k++) {
+            int64_t p = producer[net->blocks[b].in[k]];
+            if (p >= 0) {
+                indegree[b]++;
+                succ_start[p + 1]++;
+            }
+        }
+    }
+    for (size_t b = 0; b < n; b++) {
+        succ_start[b + 1] += succ_start[b];
+    }
+    {
+        size_t* fill = queue;  // 暂借 queue 作为填充游标
+        memcpy(fill, succ_start, n * sizeof(size_t));
+        for (size_t b = 0; b < n; b++) {
+            const char* const* ports;
+            size_t port_count = input_port_names(net->blocks[b].type, &ports);
+            for (size_t k = 0; k < port_count; k++) {
+                int64_t p = producer[net->blocks[b].in[k]];
+                if (p >= 0) {
+                    succ[fill[p]++] = b;
+                }
+            }
+        }
+    }
+
+    // Kahn 拓扑排序：入度为 0 的块按声明顺序入队，保证结果稳定
+    size_t head = 0, tail = 0;
+    for (size_t b = 0; b < n; b++) {
+        if (indegree[b] == 0) {
+            queue[tail++] = b;
+        }
+    }
+
+    size_t op_count = 0;
+    while (head < tail) {
+        size_t b = queue[head++];
+        FBNetworkBlock* block = &net->blocks[b];
+        FBNetworkOp* op = &ops[op_count++];
+
+        op->type = block->type;
+        op->fb = &block->fb;
+        op->in0 = block->in[0];
+        op->in1 = block->type == FB_TYPE_PID ? block->in[1] : block->in[0];
+        op->out = block->out;
+
+        for (size_t e = succ_start[b]; e < succ_start[b + 1]; e++) {
+            if (--indegree[succ[e]] == 0) {
+                queue[tail++] = succ[e];
+            }
+        }
+    }
+
+    if (op_count < n) {
+        report_loop(net, producer, indegree);
+        LOG_ERROR_MSG("FBD 网络构建失败：%s", net->error);
+        goto done;
+    }
+
+    free(net->ops);
+    net->ops = ops;
+    net->op_count = op_count;
+    ops = NULL;
+    net->built = 1;
+    rc = 0;
+    register_blocks(net);
+
+    LOG_INFO_MSG("FBD 网络构建成功：%zu 个功能块，%zu 个信号槽位",
+                 net->op_count, net->slot_count);
+
+done:
+    free(ops);
+    free(producer);
+    free(indegree);
+    free(succ_start);
+    free(succ);
+    free(queue);
+    return rc;
+}
+
+void fb_network_execute(FBNetwork* net, double dt) {
+    if (!net || !net->built) {
+        return;
+    }
+
+    // 全网使用同一 dt，保证同一周期内各功能块的时间基准一致
+    if (dt <= 0.0) {
+        dt = fb_auto_dt(&net->clock);
+    }
+
+    double* slots = net->slots;
+    const FBNetworkOp* op = net->ops;
+    const FBNetworkOp* end = op + net->op_count;
+
+    for (; op < end; op++) {
+        switch (op->type) {
+        case FB_TYPE_PID:
+            slots[op->out] = pid_compute((PIDFunctionBlock*)op->fb, slots[op->in0],
+                                         slots[op->in1], dt);
+            break;
+        case FB_TYPE_FIRST_ORDER:
+            slots[op->out] = first_order_compute((FirstOrderFunctionBlock*)op->fb,
+                                                 slots[op->in0], dt);
+            break;
+        case FB_TYPE_RAMP:
+            slots[op->out] = ramp_compute((RampFB*)op->fb, slots[op->in0], dt);
+            break;
+        case FB_TYPE_LIMIT:
+            slots[op->out] = limit_compute((LimitFB*)op->fb, slots[op->in0]);
+            break;
+        case FB_TYPE_LOOKUP_1D:
+            slots[op->out] = lookup1d_compute((Lookup1DFB*)op->fb, slots[op->in0]);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+int64_t fb_network_find_slot(const FBNetwork* net, const char* name) {
+    if (!net || !name) {
+        return -1;
+    }
+
+    FBNetworkSignal* signal = find_signal(net->inputs, net->input_count, name);
+    if (!signal) {
+        signal = find_signal(net->outputs, net->output_count, name);
+    }
+    if (signal) {
+        return signal->slot;
+    }
+
+    const char* dot = strchr(name, '.');
+    if (!dot || (size_t)(dot - name) >= FB_NETWORK_NAME_MAX) {
+        return -1;
+    }
+
+    char block_name[FB_NETWORK_NAME_MAX];
+    memcpy(block_name, name, (size_t)(dot - name));
+    block_name[dot - name] = '\0';
+
+    const FBNetworkBlock* block = fb_network_find_block((FBNetwork*)net, block_name);
+    if (!block) {
+        return -1;
+    }
+
+    const char* port = dot + 1;
+    if (is_output_port(block->type, port)) {
+        return block->out;
+    }
+
+    const char* const* ports;
+    size_t port_count = input_port_names(block->type, &ports);
+    for (size_t k = 0; k < port_count; k++) {
+        if (strcmp(ports[k], port) == 0) {
+            return block->in[k];
+        }
+    }
+
+    return -1;
+}
+
+FBNetworkBlock* fb_network_find_block(FBNetwork* net, const char* name) {
+    if (!net || !name) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < net->block_count; i++) {
+        if (strcmp(net->blocks[i].name, name) == 0) {
+            return &net->blocks[i];
+        }
+    }
+    return NULL;
+}
+
+int fb_network_set_param(FBNetwork* net, const char* block, const char* param, double value) {
+    if (!net || !param) {
+        return -1;
+    }
+
+    FBNetworkBlock* b = fb_network_find_block(net, block);
+    if (!b) {
+        set_error(net, "未知功能块：'%s'", block ? block : "");
+        return -1;
+    }
+
+    int rc = fb_network_apply_param(b->type, &b->fb, param, value);
+    if (rc == -1) {
+        set_error(net, "功能块 '%s' 没有参数 '%s'", block, param);
+    } else if (rc != 0) {
+        set_error(net, "功能块 '%s' 参数 '%s' 取值无效：%g", block, param, value);
+    }
+    return rc == 0 ? 0 : -1;
+}
+
+int fb_network_apply_param(FunctionBlockType type, void* fb, const char* param, double value) {
+    const char* const* names;
+    const double* defaults;
+    size_t count = fb_network_param_info(type, &names, &defaults);
+    size_t index = 0;
+    if (!fb || !param) {
+        return -1;
+    }
+    while (index < count && strcmp(names[index], param) != 0) {
+        index++;
+    }
+    if (index == count) {
+        return -1;
+    }
+
+    int rc = 0;
+    switch (type) {
+    case FB_TYPE_PID: {
+        PIDFunctionBlock* pid = (PIDFunctionBlock*)fb;
+        PIDParams* p = &pid->params;
+        if (index < 3) {
+            rc = pid_set_params(pid, index == 0 ? &value : NULL,
+                                index == 1 ? &value : NULL, index == 2 ? &value : NULL);
+        } else if (index == 3 && value < p->output_max) {
+            p->output_min = value;
+        } else if (index == 4 && value > p->output_min) {
+            p->output_max = value;
+        } else if (index >= 5) {
+            PIDOptions options = pid->options;
+            double* fields[] = {&options.b, &options.c, &options.Tf, &options.Tt};
+            if (index < 9) {
+                *fields[index - 5] = value;
+            } else {
+                options.velocity = value != 0.0;
+            }
+            rc = pid_set_options(pid, &options);
+        } else {
+            rc = -1;
+        }
+        break;
+    }
+    case FB_TYPE_FIRST_ORDER:
+        rc = first_order_set_time_constant((FirstOrderFunctionBlock*)fb, value);
+        break;
+    case FB_TYPE_RAMP: {
+        RampFB* ramp = (RampFB*)fb;
+        rc = ramp_set_params(ramp, index == 0 ? value : ramp->rising_rate,
+                             index == 1 ? value : ramp->falling_rate);
+        break;
+    }
+    case FB_TYPE_LOOKUP_1D:
+        ((Lookup1DFB*)fb)->clamp = value != 0.0;
+        break;
+    default: {
+        LimitFB* limit = (LimitFB*)fb;
+        rc = limit_set_params(limit, index == 0 ? value : limit->min_value,
+                              index == 1 ? value : limit->max_value);
+        break;
+    }
+    }
+
+    return rc == 0 ? 0 : -2;
+}
+
+int fb_network_set_table(FBNetwork* net, const char* block, const double* x, const double* y,
+                         size_t n) {
+    if (!net) {
+        return -1;
+    }
+
+    FBNetworkBlock* b = fb_network_find_block(net, block);
+    if (!b) {
+        set_error(net, "未知功能块：'%s'", block ? block : "");
+        return -1;
+    }
+    if (b->type != FB_TYPE_LOOKUP_1D) {
+        set_error(net, "功能块 '%s' 不是折线表", block);
+        return -1;
+    }
+    if (lookup1d_copy_table(&b->fb.lookup, x, y, n) != 0) {
+        set_error(net, "折线表 '%s' 的断点无效（%zu 个，须严格递增且至少 2 个）或附属存储区不足",
+                  block, n);
+        return -1;
+    }
+    return 0;
+}
+
+void fb_network_reset(FBNetwork* net) {
+    if (!net) {
+        return;
+    }
+
+    for (size_t i = 0; i < net->block_count; i++) {
+        FBNetworkBlock* block = &net->blocks[i];
+        switch (block->type) {
+        case FB_TYPE_PID:
+            pid_reset(&block->fb.pid);
+            break;
+        case FB_TYPE_FIRST_ORDER:
+            first_order_reset(&block->fb.first_order);
+            break;
+        case FB_TYPE_RAMP:
+            // 只清状态；ramp_init() 会清零已登记的 base.id，销毁时无法注销
+            block->fb.ramp.output = 0.0;
+            block->fb.ramp.initialized = 0;
+            break;
+        default:
+            break;
+        }
+        net->slots[block->out] = 0.0;
+    }
+
+    net->clock.last_update_time = 0.0;
+}
+
+const char* fb_network_last_error(const FBNetwork* net) {
+    return net ? net->error : "";
+}
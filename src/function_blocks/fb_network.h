@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_network.h
+ * @brief 功能块图（FBD）网络执行引擎
+ *
+ * 网络由命名输入、功能块实例、连线和命名输出组成，一次声明后构建：
+ *   - 每个端口对应信号数组 slots[] 中的一个槽位，连线即让目标输入端口
+ *     指向源端口的槽位，未连接的输入端口保留自己的常量槽位；
+ *   - 构建时按拓扑序（Kahn 算法）展开为扁平的执行列表，输入/输出槽位
+ *     下标预先计算好；存在代数环（不经过任何状态的闭环）时构建失败，
+ *     错误信息列出环上的功能块名称；
+ *   - 每周期 fb_network_execute() 顺序执行列表，不经过 Python。
+ * 构建成功后网络中的功能块以实例名登记到全局注册表（见 fb_registry.h），
+ * 修改结构或销毁网络时注销。
+ *
+ * 端口命名：
+ *   PID：       输入 SP、PV，输出 CV（也可写作 out）
+ *   FirstOrder：输入 in，输出 out
+ *   Ramp：      输入 in，输出 out
+ *   Limit：     输入 in，输出 out
+ *   Lookup1D：  输入 in，输出 out（折线表须在构建前用 fb_network_set_table() 给出）
+ * 地址格式为 "块名.端口"，网络输入直接使用输入名。
+ */
+
+#ifndef FB_NETWORK_H
+#define FB_NETWORK_H
+
+#include "fb_common.h"
+#include "fb_pid.h"
+#include "fb_first_order.h"
+#include "fb_ramp.h"
+#include "fb_limit.h"
+#include "fb_lookup.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define FB_NETWORK_NAME_MAX 32      // 名称最大长度（含结尾 '\0'）
+#define FB_NETWORK_MAX_INPUTS 2     // 单个功能块最多输入端口数
+#define FB_NETWORK_MAX_PARAMS 10    // 单个功能块最多参数个数
+#define FB_NETWORK_ERROR_MAX 256    // 错误信息缓冲区长度
+
+// Python 绑定导出 FBNetwork 指针时使用的 PyCapsule 名称
+#define FB_NETWORK_CAPSULE_NAME "plcopen_c.FBNetwork"
+
+// 网络中的功能块实例（按值内嵌，不单独分配）
+typedef struct {
+    char name[FB_NETWORK_NAME_MAX];
+    FunctionBlockType type;
+    union {
+        PIDFunctionBlock pid;
+        FirstOrderFunctionBlock first_order;
+        RampFB ramp;
+        LimitFB limit;
+        Lookup1DFB lookup;
+    } fb;
+    uint32_t in[FB_NETWORK_MAX_INPUTS];  // 输入端口当前指向的槽位
+    uint32_t own_in[FB_NETWORK_MAX_INPUTS];  // 输入端口自己的常量槽位
+    uint32_t out;                        // 输出槽位
+} FBNetworkBlock;
+
+// 执行列表条目（构建时生成，按拓扑序排列）
+typedef struct {
+    FunctionBlockType type;
+    void* fb;
+    uint32_t in0;
+    uint32_t in1;
+    uint32_t out;
+} FBNetworkOp;
+
+// 命名信号（网络输入/输出）
+typedef struct {
+    char name[FB_NETWORK_NAME_MAX];
+    uint32_t slot;
+} FBNetworkSignal;
+
+// 网络
+typedef struct {
+    FBNetworkBlock* blocks;
+    size_t block_count;
+    size_t block_capacity;
+
+    FBNetworkSignal* inputs;
+    size_t input_count;
+    size_t input_capacity;
+
+    FBNetworkSignal* outputs;
+    size_t output_count;
+    size_t output_capacity;
+
+    double* slots;           // 信号槽位
+    size_t slot_count;
+    size_t slot_capacity;
+
+    FBNetworkOp* ops;        // 执行列表（构建后有效）
+    size_t op_count;
+    int built;               // 是否已构建（修改结构后清零）
+
+    FunctionBlock clock;     // dt 为 0 时用于自动计算时间差
+    char error[FB_NETWORK_ERROR_MAX];  // 最近一次失败的原因
+} FBNetwork;
+
+/**
+ * @brief 创建空网络
+ * @return 网络指针，失败返回 NULL
+ */
+FBNetwork* fb_network_create(void);
+
+/**
+ * @brief 销毁网络
+ * @param net 网络指针
+ */
+void fb_network_destroy(FBNetwork* net);
+
+/**
+ * @brief 按类型名解析功能块类型
+ * @param kind 类型名（"PID"、"FirstOrder"、"Ramp"、"Limit"、"Lookup1D"）
+ * @param type 输出功能块类型
+ * @return 0 成功，-1 未知类型
+ */
+int fb_network_parse_type(const char* kind, FunctionBlockType* type);
+
+/**
+ * @brief 获取功能块类型的参数名及默认值
+ * @param type 功能块类型
+ * @param names 输出参数名数组
+ * @param defaults 输出默认值数组
+ * @return 参数个数，不支持的类型返回 0
+ */
+size_t fb_network_param_info(FunctionBlockType type, const char* const** names,
+                             const double** defaults);
+
+/**
+ * @brief 添加网络输入
+ * @param net 网络指针
+ * @param name 输入名
+ * @param value 初始值
+ * @return 0 成功，-1 失败（原因见 fb_network_last_error）
+ */
+int fb_network_add_input(FBNetwork* net, const char* name, double value);
+
+/**
+ * @brief 添加功能块实例
+ * @param net 网络指针
+ * @param name 实例名
+ * @param type 功能块类型
+ * @param params 参数数组（顺序见 fb_network_param_info），NULL 表示全部使用默认值
+ * @return 0 成功，-1 失败
+ */
+int fb_network_add_block(FBNetwork* net, const char* name, FunctionBlockType type,
+                         const double* params);
+
+/**
+ * @brief 连线：源端口 -> 目标功能块输入端口
+ * @param net 网络指针
+ * @param src 源地址（网络输入名或 "块名.输出端口"）
+ * @param dst 目标地址（"块名.输入端口"）
+ * @return 0 成功，-1 失败
+ */
+int fb_network_connect(FBNetwork* net, const char* src, const char* dst);
+
+/**
+ * @brief 添加网络输出
+ * @param net 网络指针
+ * @param name 输出名
+ * @param src 源地址（网络输入名或 "块名.输出端口"）
+ * @return 0 成功，-1 失败
+ */
+int fb_network_add_output(FBNetwork* net, const char* name, const char* src);
+
+/**
+ * @brief 构建执行列表（拓扑排序，检测代数环）
+ * @param net 网络指针
+ * @return 0 成功，-1 失败（存在代数环时错误信息列出环上的功能块）
+ */
+int fb_network_build(FBNetwork* net);
+
+/**
+ * @brief 执行一个周期（需先构建）
+ * @param net 网络指针
+ * @param dt 时间步长（秒），0 表示按单调时钟自动计算
+ */
+void fb_network_execute(FBNetwork* net, double dt);
+
+/**
+ * @brief 查找信号槽位
+ * @param net 网络指针
+ * @param name 网络输入名、网络输出名或 "块名.端口"
+ * @return 槽位下标，未找到返回 -1
+ */
+int64_t fb_network_find_slot(const FBNetwork* net, const char* name);
+
+/**
+ * @brief 按名称查找功能块实例
+ * @param net 网络指针
+ * @param name 实例名
+ * @return 功能块指针，未找到返回 NULL
+ */
+FBNetworkBlock* fb_network_find_block(FBNetwork* net, const char* name);
+
+/**
+ * @brief 在线修改功能块参数（构建前后均可调用）
+ * @param net 网络指针
+ * @param block 实例名
+ * @param param 参数名（见 fb_network_param_info）
+ * @param value 参数值
+ * @return 0 成功，-1 失败（未知实例/参数或取值无效）
+ */
+int fb_network_set_param(FBNetwork* net, const char* block, const char* param, double value);
+
+/**
+ * @brief 按参数名修改单个功能块实例的参数（网络内外的实例通用）
+ * @param type 功能块类型
+ * @param fb 功能块实例
+ * @param param 参数名（见 fb_network_param_info）
+ * @param value 参数值
+ * @return 0 成功，-1 参数名未知，-2 取值无效
+ */
+int fb_network_apply_param(FunctionBlockType type, void* fb, const char* param, double value);
+
+/**
+ * @brief 设置 Lookup1D 实例的折线表（复制到实例自有的存储中，构建前后均可调用）
+ * @param net 网络指针
+ * @param block 实例名
+ * @param x 严格递增的断点
+ * @param y 各断点的输出值
+ * @param n 断点数
+ * @return 0 成功，-1 失败（未知实例、类型不是 Lookup1D 或断点无效）
+ */
+int fb_network_set_table(FBNetwork* net, const char* block, const double* x, const double* y,
+                         size_t n);
+
+/**
+ * @brief 重置所有功能块状态（输入槽位保持不变）
+ * @param net 网络指针
+ */
+void fb_network_reset(FBNetwork* net);
+
+/**
+ * @brief 获取最近一次失败的原因
+ * @param net 网络指针
+ * @return 错误信息（无错误时为空串）
+ */
+const char* fb_network_last_error(const FBNetwork* net);
+
+#endif // FB_NETWORK_H
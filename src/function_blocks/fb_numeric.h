@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_numeric.h
+ * @brief 功能块数值类型：Q16.16 定点数运算
+ *
+ * Q16.16 以 int32_t 存放，低 16 位为小数，分辨率 2^-16（约 1.5e-5），
+ * 范围约 [-32768, 32768)。加减乘除均饱和到表示范围（不回绕），乘除按
+ * 最近值舍入；除数为 0 时按被除数符号饱和。供 fb_kernels.h 的 Q16.16
+ * 实例使用。
+ */
+
+#ifndef FB_NUMERIC_H
+#define FB_NUMERIC_H
+
+#include <stdint.h>
+
+// Q16.16 定点数
+typedef int32_t fb_q16_t;
+
+#define FB_Q16_FRAC_BITS 16
+#define FB_Q16_ONE ((fb_q16_t)1 << FB_Q16_FRAC_BITS)
+#define FB_Q16_MAX INT32_MAX
+#define FB_Q16_MIN INT32_MIN
+
+// 编译期常量（仅用于字面量，不检查范围）
+#define FB_Q16_LIT(x) ((fb_q16_t)((x) * 65536.0))
+
+// 64 位中间结果饱和到 Q16.16
+static inline fb_q16_t fb_q16_saturate(int64_t v) {
+    if (v > FB_Q16_MAX) return FB_Q16_MAX;
+    if (v < FB_Q16_MIN) return FB_Q16_MIN;
+    return (fb_q16_t)v;
+}
+
+/**
+ * @brief double 转 Q16.16（最近值舍入，超出范围饱和，NaN 转为 0）
+ * @param x 输入值
+ * @return Q16.16 值
+ */
+static inline fb_q16_t fb_q16_from_double(double x) {
+    double scaled = x * 65536.0;
+    if (!(scaled == scaled)) return 0;
+    if (scaled >= 2147483647.0) return FB_Q16_MAX;
+    if (scaled <= -2147483648.0) return FB_Q16_MIN;
+    return (fb_q16_t)(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+}
+
+/**
+ * @brief Q16.16 转 double（精确）
+ * @param x Q16.16 值
+ * @return double 值
+ */
+static inline double fb_q16_to_double(fb_q16_t x) {
+    return x / 65536.0;
+}
+
+static inline fb_q16_t fb_q16_add(fb_q16_t a, fb_q16_t b) {
+    return fb_q16_saturate((int64_t)a + b);
+}
+
+static inline fb_q16_t fb_q16_sub(fb_q16_t a, fb_q16_t b) {
+    return fb_q16_saturate((int64_t)a - b);
+}
+
+// 乘法：64 位乘积加半个最低位后右移（算术移位，负数向负无穷舍入后即为最近值）
+static inline fb_q16_t fb_q16_mul(fb_q16_t a, fb_q16_t b) {
+    int64_t product = (int64_t)a * b;
+    return fb_q16_saturate((product + ((int64_t)1 << (FB_Q16_FRAC_BITS - 1))) >> FB_Q16_FRAC_BITS);
+}
+
+// 除法：被除数扩展到 64 位后整除，余数过半时远离 0 进位
+static inline fb_q16_t fb_q16_div(fb_q16_t a, fb_q16_t b) {
+    if (b == 0) {
+        return a >= 0 ? FB_Q16_MAX : FB_Q16_MIN;
+    }
+    int64_t num = (int64_t)a * FB_Q16_ONE;
+    int64_t q = num / b;
+    int64_t r = num % b;
+    int64_t abs_r = r < 0 ? -r : r;
+    int64_t abs_b = b < 0 ? -(int64_t)b : b;
+    if (2 * abs_r >= abs_b) {
+        q += (num < 0) != (b < 0) ? -1 : 1;
+    }
+    return fb_q16_saturate(q);
+}
+
+#endif // FB_NUMERIC_H
@@ -27,37 +27,27 @@
  */
 
 #include "fb_pid.h"
+#include "fb_journal.h"
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
 #include "../runtime/logger.h"
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
 // PID 参数范围
 #define PID_PARAM_MIN 0.0
 #define PID_PARAM_MAX 1e6
 
-// 全局 PID 实例计数器（用于生成唯一 ID）
-static uint32_t g_pid_id_counter = 0;
-
-PIDFunctionBlock* pid_create(double Kp, double Ki, double Kd,
-                              double output_min, double output_max) {
-    // 验证输出范围
-    if (output_min >= output_max) {
-        LOG_ERROR_MSG("PID 创建失败：output_min (%.6f) >= output_max (%.6f)",
-                      output_min, output_max);
-        return NULL;
-    }
-
-    // 分配内存
-    PIDFunctionBlock* pid = (PIDFunctionBlock*)malloc(sizeof(PIDFunctionBlock));
-    if (!pid) {
-        LOG_ERROR_MSG("PID 创建失败：内存分配失败");
-        return NULL;
+int pid_init(PIDFunctionBlock* pid, double Kp, double Ki, double Kd,
+             double output_min, double output_max) {
+    if (!pid || output_min >= output_max) {
+        return -1;
     }
 
     // 初始化基础属性
     pid->base.type = FB_TYPE_PID;
-    pid->base.id = ++g_pid_id_counter;
+    pid->base.id = 0;
     pid->base.last_update_time = 0.0;
 
     // 验证并设置参数
@@ -72,68 +62,145 @@ PIDFunctionBlock* pid_create(double Kp, double Ki, double Kd,
     pid->state.prev_error = 0.0;
     pid->last_error = 0.0;
 
-    LOG_INFO_MSG("PID 控制器创建成功：ID=%u, Kp=%.3f, Ki=%.3f, Kd=%.3f, 输出范围=[%.2f, %.2f]",
-                 pid->base.id, pid->params.Kp, pid->params.Ki, pid->params.Kd,
-                 pid->params.output_min, pid->params.output_max);
+    // 变体：默认标准位置式、自动模式
+    const PIDOptions defaults = PID_DEFAULT_OPTIONS;
+    memset(&pid->ext, 0, sizeof(pid->ext));
+    pid->options = defaults;
+    pid->variant = 0;
+    pid->primed = 0;
+    pid->manual = 0;
+    pid->manual_output = 0.0;
+
+    return 0;
+}
+
+// 选项全为默认值且处于自动模式时走标准算法
+static void pid_update_variant(PIDFunctionBlock* pid) {
+    const PIDOptions* o = &pid->options;
+    pid->variant = pid->manual || o->b != 1.0 || o->c != 1.0 || o->Tf > 0.0 || o->Tt > 0.0 ||
+                   o->velocity;
+}
+
+PIDFunctionBlock* pid_create(double Kp, double Ki, double Kd,
+                              double output_min, double output_max) {
+    // 验证输出范围
+    if (output_min >= output_max) {
+        LOG_ERROR_MSG("PID 创建失败：output_min (%.6f) >= output_max (%.6f)",
+                      output_min, output_max);
+        return NULL;
+    }
+
+    // 从实例池分配
+    PIDFunctionBlock* pid = (PIDFunctionBlock*)fb_pool_alloc(FB_TYPE_PID);
+    if (!pid) {
+        LOG_ERROR_MSG("PID 创建失败：实例池已满");
+        return NULL;
+    }
+
+    pid_init(pid, Kp, Ki, Kd, output_min, output_max);
+    if (fb_registry_register(&pid->base, NULL, NULL) == 0) {
+        fb_pool_free(FB_TYPE_PID, pid);
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_PID, pid->base.id, FB_EVENT_CREATE, "Kp,Ki,Kd,output_min,output_max",
+               pid->params.Kp, pid->params.Ki, pid->params.Kd, pid->params.output_min,
+               pid->params.output_max);
 
     return pid;
 }
 
 void pid_destroy(PIDFunctionBlock* pid) {
     if (pid) {
-        LOG_INFO_MSG("PID 控制器销毁：ID=%u", pid->base.id);
-        free(pid);
+        FB_JOURNAL_EVENT(FB_TYPE_PID, pid->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(pid->base.id);
+        fb_pool_free(FB_TYPE_PID, pid);
     }
 }
 
-double pid_compute(PIDFunctionBlock* pid, double SP, double PV, double dt) {
-    if (!pid) {
-        return 0.0;
-    }
+// 变体算法：设定值加权、微分滤波、反算抗饱和、速度式、手动跟踪
+static double pid_compute_variant(PIDFunctionBlock* pid, double SP, double PV, double dt) {
+    const PIDParams* p = &pid->params;
+    const PIDOptions* o = &pid->options;
+    PIDExtState* x = &pid->ext;
 
-    // 计算误差
     double error = SP - PV;
+    double pinput = o->b * SP - PV;
+    double dinput = o->c * SP - PV;
 
-    // 如果 dt 为 0，自动计算时间差
-    if (dt <= 0.0) {
-        struct timespec now;
-        clock_gettime(CLOCK_MONOTONIC, &now);
-        double current_time = now.tv_sec + now.tv_nsec / 1e9;
-
-        if (pid->base.last_update_time > 0.0) {
-            dt = current_time - pid->base.last_update_time;
-        } else {
-            dt = 0.1;  // 默认 100ms
-        }
-
-        pid->base.last_update_time = current_time;
+    // 首周期（或切换选项后）以当前输入为基准，避免比例/微分冲击
+    if (!pid->primed) {
+        x->prev_pinput = pinput;
+        x->prev_dinput = dinput;
+        x->derivative = 0.0;
+        pid->primed = 1;
     }
 
-    // 比例项（直接计算，避免临时变量）
-    double output = pid->params.Kp * error;
+    // 微分：d(c*SP - PV)/dt，经 Tf 一阶滤波（后向欧拉）
+    double prev_derivative = x->derivative;
+    if (dt > 0.0) {
+        double raw = (dinput - x->prev_dinput) / dt;
+        x->derivative = o->Tf > 0.0 ? prev_derivative + dt / (o->Tf + dt) * (raw - prev_derivative)
+                                    : raw;
+    }
 
-    // 积分项（累积误差）
-    pid->state.integral += error * dt;
-    output += pid->params.Ki * pid->state.integral;
+    double output;
+    if (pid->manual) {
+        output = clamp(pid->manual_output, p->output_min, p->output_max);
+        // 跟踪：位置式反推积分，使切回自动时 P + I + D 从手动输出连续变化
+        if (!o->velocity && p->Ki > 0.0) {
+            pid->state.integral = (output - p->Kp * pinput - p->Kd * x->derivative) / p->Ki;
+        }
+    } else if (o->velocity) {
+        // 速度式：输出即积分器，限幅本身就是抗积分饱和
+        double delta = p->Kp * (pinput - x->prev_pinput) + p->Ki * error * dt +
+                       p->Kd * (x->derivative - prev_derivative);
+        output = clamp(x->output + delta, p->output_min, p->output_max);
+    } else {
+        pid->state.integral += error * dt;
+        double unlimited = p->Kp * pinput + p->Ki * pid->state.integral + p->Kd * x->derivative;
+        output = clamp(unlimited, p->output_min, p->output_max);
 
-    // 微分项（基于误差变化率）
-    if (dt > 0.0) {
-        double derivative = (error - pid->state.prev_error) / dt;
-        output += pid->params.Kd * derivative;
+        if (output != unlimited && p->Ki > 0.0) {
+            if (o->Tt > 0.0) {
+                // 反算：积分按 (CV_sat - CV)·dt/Tt 回拉（单步最多回拉到饱和点）
+                double gain = dt < o->Tt ? dt / o->Tt : 1.0;
+                pid->state.integral += (output - unlimited) * gain / p->Ki;
+            } else {
+                pid->state.integral -= error * dt;
+            }
+        }
     }
 
-    // 更新状态（最小化写操作）
+    x->prev_pinput = pinput;
+    x->prev_dinput = dinput;
+    x->output = output;
     pid->state.prev_error = error;
     pid->last_error = error;
+    return output;
+}
+
+double pid_compute(PIDFunctionBlock* pid, double SP, double PV, double dt) {
+    if (!pid) {
+        return 0.0;
+    }
 
-    // 输出限幅（内联函数）
-    double limited_output = clamp(output, pid->params.output_min, pid->params.output_max);
+    FB_TIMED(&pid->base);
 
-    // 抗积分饱和（仅在输出饱和且启用积分时执行）
-    if (__builtin_expect(limited_output != output && pid->params.Ki > 0.0, 0)) {
-        pid->state.integral -= error * dt;  // 回退积分
+    // 如果 dt 为 0，自动计算时间差
+    if (dt <= 0.0) {
+        dt = fb_auto_dt(&pid->base);
     }
 
+    if (__builtin_expect(pid->variant, 0)) {
+        return pid_compute_variant(pid, SP, PV, dt);
+    }
+
+    // 标准算法（含输出限幅和抗积分饱和），与 float32 / Q16.16 版本同一模板
+    double limited_output = pid_kernel(&pid->params, &pid->state, SP, PV, dt);
+    pid->last_error = pid->state.prev_error;
+
+    pid->ext.output = limited_output;  // 切到手动或速度式时的起点
     return limited_output;
 }
 
@@ -153,12 +220,70 @@ int pid_set_params(PIDFunctionBlock* pid, const double* Kp,
         pid->params.Kd = validate_and_clamp(*Kd, PID_PARAM_MIN, PID_PARAM_MAX, "Kd");
     }
 
-    LOG_INFO_MSG("PID 参数更新：ID=%u, Kp=%.3f, Ki=%.3f, Kd=%.3f",
-                 pid->base.id, pid->params.Kp, pid->params.Ki, pid->params.Kd);
+    FB_JOURNAL(FB_TYPE_PID, pid->base.id, FB_EVENT_PARAM, "Kp,Ki,Kd", pid->params.Kp,
+               pid->params.Ki, pid->params.Kd);
+
+    return 0;
+}
+
+int pid_set_params_bumpless(PIDFunctionBlock* pid, const double* Kp,
+                            const double* Ki, const double* Kd) {
+    if (pid_set_params(pid, Kp, Ki, Kd) != 0) {
+        return -1;
+    }
+
+    // 位置式：按新参数反推积分，使 P + I + D 仍等于上一周期输出
+    const PIDParams* p = &pid->params;
+    if (!pid->manual && !pid->options.velocity && p->Ki > 0.0) {
+        double pinput = pid->variant && pid->primed ? pid->ext.prev_pinput : pid->state.prev_error;
+        double derivative = pid->variant && pid->primed ? pid->ext.derivative : 0.0;
+        pid->state.integral = (pid->ext.output - p->Kp * pinput - p->Kd * derivative) / p->Ki;
+    }
 
     return 0;
 }
 
+int pid_set_options(PIDFunctionBlock* pid, const PIDOptions* options) {
+    if (!pid || !options) {
+        return -1;
+    }
+
+    const PIDOptions* o = options;
+    if (!(o->b >= 0.0 && o->b <= 1.0) || !(o->c >= 0.0 && o->c <= 1.0) || !(o->Tf >= 0.0) ||
+        !(o->Tt >= 0.0)) {
+        LOG_ERROR_MSG("PID 选项无效：ID=%u, b=%.3f, c=%.3f, Tf=%.3f, Tt=%.3f", pid->base.id,
+                      o->b, o->c, o->Tf, o->Tt);
+        return -1;
+    }
+
+    pid->options = *options;
+    pid->options.velocity = options->velocity != 0;
+    pid->primed = 0;
+    pid_update_variant(pid);
+    return 0;
+}
+
+const PIDOptions* pid_get_options(const PIDFunctionBlock* pid) {
+    return pid ? &pid->options : NULL;
+}
+
+void pid_set_manual(PIDFunctionBlock* pid, int manual) {
+    if (!pid) {
+        return;
+    }
+
+    manual = manual != 0;
+    if (manual && !pid->manual) {
+        pid->manual_output = pid->ext.output;
+    }
+    // 标准算法不维护 ext 中的输入基准，切换时重新取基准
+    if (manual != pid->manual && !pid->variant) {
+        pid->primed = 0;
+    }
+    pid->manual = manual;
+    pid_update_variant(pid);
+}
+
 const PIDParams* pid_get_params(const PIDFunctionBlock* pid) {
     return pid ? &pid->params : NULL;
 }
@@ -172,7 +297,9 @@ void pid_reset(PIDFunctionBlock* pid) {
         pid->state.integral = 0.0;
         pid->state.prev_error = 0.0;
         pid->last_error = 0.0;
+        memset(&pid->ext, 0, sizeof(pid->ext));
+        pid->primed = 0;
         pid->base.last_update_time = 0.0;
-        LOG_INFO_MSG("PID 状态重置：ID=%u", pid->base.id);
+        FB_JOURNAL_EVENT(FB_TYPE_PID, pid->base.id, FB_EVENT_RESET);
     }
 }
@@ -26,6 +26,14 @@
  * @brief PID 控制器功能块接口
  *
  * 标准位置式 PID 算法：CV = Kp*e + Ki*∫e + Kd*de/dt
+ *
+ * 每个实例可选用以下变体（PIDOptions，默认值即标准算法，计算结果逐位不变）：
+ *   - 设定值加权（2 自由度）：CV = Kp*(b*SP - PV) + Ki*∫e + Kd*d(c*SP - PV)/dt，
+ *     c = 0 即微分作用于 PV，设定值阶跃不产生微分冲击；
+ *   - 微分一阶滤波：D = Kd*s/(1 + Tf*s)，抑制测量噪声放大；
+ *   - 反算抗积分饱和：积分按 (CV_sat - CV)/Tt 回拉，替代条件积分；
+ *   - 速度式（增量式）：CV += ΔP + Ki*e*dt + ΔD，输出限幅即抗饱和；
+ *   - 手动/自动无扰切换：手动时输出 manual_output，内部状态跟踪该值。
  */
 
 #ifndef FB_PID_H
@@ -33,20 +41,27 @@
 
 #include "fb_common.h"
 
-// PID 参数结构体
+// PIDParams（Kp, Ki, Kd, output_min, output_max）和 PIDState（integral, prev_error）
+// 由 fb_kernels.h 按 double 实例化，标准算法即其中的 pid_kernel()
+
+// PID 变体选项（默认值 PID_DEFAULT_OPTIONS 即标准位置式算法）
 typedef struct {
-    double Kp;          // 比例系数 [0, 1e6]
-    double Ki;          // 积分系数 [0, 1e6]
-    double Kd;          // 微分系数 [0, 1e6]
-    double output_min;  // 输出下限
-    double output_max;  // 输出上限
-} PIDParams;
-
-// PID 内部状态
+    double b;           // 比例项设定值权重 [0, 1]，默认 1
+    double c;           // 微分项设定值权重 [0, 1]，默认 1；0 表示微分作用于 PV
+    double Tf;          // 微分一阶滤波时间常数（秒），0 表示不滤波
+    double Tt;          // 反算抗积分饱和的跟踪时间常数（秒），0 表示条件积分（默认）
+    int velocity;       // 1：速度式（增量式）算法
+} PIDOptions;
+
+#define PID_DEFAULT_OPTIONS {1.0, 1.0, 0.0, 0.0, 0}
+
+// 变体算法的附加状态（紧跟 last_error 连续存放，保持时整体保存）
 typedef struct {
-    double integral;    // 积分累积值
-    double prev_error;  // 上一周期误差
-} PIDState;
+    double prev_pinput;  // 上一周期比例项输入 b*SP - PV（速度式）
+    double prev_dinput;  // 上一周期微分项输入 c*SP - PV
+    double derivative;   // 滤波后的微分（未乘 Kd）
+    double output;       // 上一周期输出（速度式的积分器，手动切换的起点）
+} PIDExtState;
 
 // PID 功能块完整结构
 typedef struct {
@@ -54,8 +69,27 @@ typedef struct {
     PIDParams params;    // 参数
     PIDState state;      // 状态
     double last_error;   // 当前误差（用于诊断）
+    PIDExtState ext;     // 变体状态
+    PIDOptions options;  // 变体选项
+    int variant;         // 选项非默认或处于手动模式时为 1，compute 走变体路径
+    int primed;          // ext 中的上一周期输入是否有效（首周期不产生微分冲击）
+    int manual;          // 手动模式
+    double manual_output;  // 手动输出值
 } PIDFunctionBlock;
 
+/**
+ * @brief 就地初始化 PID 功能块（用于数组或内嵌存储，不分配内存）
+ * @param pid PID 功能块指针
+ * @param Kp 比例系数
+ * @param Ki 积分系数
+ * @param Kd 微分系数
+ * @param output_min 输出下限
+ * @param output_max 输出上限
+ * @return 0 成功，-1 失败（output_min >= output_max）
+ */
+int pid_init(PIDFunctionBlock* pid, double Kp, double Ki, double Kd,
+             double output_min, double output_max);
+
 /**
  * @brief 创建 PID 功能块实例
  * @param Kp 比例系数
@@ -95,6 +129,48 @@ double pid_compute(PIDFunctionBlock* pid, double SP, double PV, double dt);
 int pid_set_params(PIDFunctionBlock* pid, const double* Kp,
                    const double* Ki, const double* Kd);
 
+/**
+ * @brief 无扰设置 PID 参数
+ * @param pid PID 功能块指针
+ * @param Kp 比例系数（NULL 表示不修改）
+ * @param Ki 积分系数（NULL 表示不修改）
+ * @param Kd 微分系数（NULL 表示不修改）
+ * @return 0 成功，-1 失败
+ *
+ * 位置式按新参数反推积分，使上一周期的输入在新参数下得到上一周期的输出，
+ * 下一周期输出从该值连续变化；速度式和手动模式本身无扰，与 pid_set_params() 相同。
+ * 新 Ki 为 0 时积分项不参与输出，无法补偿比例项的跳变。
+ */
+int pid_set_params_bumpless(PIDFunctionBlock* pid, const double* Kp,
+                            const double* Ki, const double* Kd);
+
+/**
+ * @brief 设置变体选项
+ * @param pid PID 功能块指针
+ * @param options 选项（b、c 在 [0, 1] 内，Tf、Tt 非负）
+ * @return 0 成功，-1 选项无效（不修改）
+ *
+ * 切换选项后首个周期重新取微分基准，速度式从当前输出继续增量调节。
+ */
+int pid_set_options(PIDFunctionBlock* pid, const PIDOptions* options);
+
+/**
+ * @brief 获取变体选项
+ * @param pid PID 功能块指针
+ * @return 选项结构体指针
+ */
+const PIDOptions* pid_get_options(const PIDFunctionBlock* pid);
+
+/**
+ * @brief 切换手动/自动模式
+ * @param pid PID 功能块指针
+ * @param manual 1 手动，0 自动
+ *
+ * 自动切到手动时 manual_output 取上一周期输出；手动期间积分（速度式为输出）
+ * 跟踪 manual_output，切回自动时输出从该值连续变化（Ki = 0 的位置式除外）。
+ */
+void pid_set_manual(PIDFunctionBlock* pid, int manual);
+
 /**
  * @brief 获取 PID 参数
  * @param pid PID 功能块指针
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_pid_bank.c
+ * @brief 批量 PID 功能块实现
+ *
+ * 每个回路的运算顺序与 pid_compute() 保持一致：
+ *   error = SP - PV
+ *   output = Kp*error
+ *   integral += error*dt;  output += Ki*integral
+ *   dt > 0 时 output += Kd*((error - prev_error)/dt)
+ *   输出限幅后若饱和且 Ki > 0，回退本周期积分
+ * SIMD 内核只使用加减乘除和比较/选择指令（不使用 FMA），保证结果逐位一致。
+ * 实现由 fb_pid_bank_impl.h 按 double 和 float32 各实例化一次。
+ */
+
+#include "fb_pid_bank.h"
+#include "fb_journal.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
+#include "../runtime/logger.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PID_BANK_X86 1
+#endif
+
+// PID 参数范围（与 fb_pid.c 相同）
+#define PID_PARAM_MIN 0.0
+#define PID_PARAM_MAX 1e6
+
+// 数组对齐（缓存行）
+#define PID_BANK_ALIGN 64
+
+// 对齐数组个数：Kp, Ki, Kd, output_min, output_max, integral, prev_error, output
+#define PID_BANK_ARRAYS 8
+
+// double：SSE2 每次 2 个回路，AVX2 每次 4 个
+#define FB_REAL double
+#define FB_SUFFIX
+#define PB_SIMD _pd
+#define PB_V128 __m128d
+#define PB_V256 __m256d
+#include "fb_pid_bank_impl.h"
+
+// float32：SSE2 每次 4 个回路，AVX2 每次 8 个
+#define FB_REAL float
+#define FB_SUFFIX _f32
+#define PB_SIMD _ps
+#define PB_V128 __m128
+#define PB_V256 __m256
+#include "fb_pid_bank_impl.h"
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_pid_bank.h
+ * @brief 批量 PID 功能块接口
+ *
+ * 把 N 个结构相同的 PID 回路按结构数组（SoA）形式存放，每个字段一个
+ * 按缓存行对齐的数组，一次调用计算全部回路。x86 上按 CPU 能力选择
+ * AVX2 / SSE2 内核，其他平台使用标量实现；每个回路的计算顺序与
+ * pid_compute() 完全相同（含抗积分饱和和输出限幅），结果逐位一致。
+ *
+ * 后缀 _f32 的接口是同一实现的 float32 实例：参数、状态和输入输出均为 float，
+ * 访存减半、每个向量的回路数加倍，结果与 pid_block_run_f32() 逐位一致。
+ */
+
+#ifndef FB_PID_BANK_H
+#define FB_PID_BANK_H
+
+#include "fb_common.h"
+#include <stddef.h>
+
+// 批量 PID 最大回路数
+#define PID_BANK_MAX_LOOPS (1u << 20)
+
+// 批量 PID 功能块（每个指针指向按 64 字节对齐的数组，长度为 capacity）
+typedef struct {
+    FunctionBlock base;    // 基础属性（last_update_time 供所有回路共用）
+    size_t count;          // 回路数
+    size_t capacity;       // 数组容量（count 向上取整到缓存行）
+
+    // 参数
+    double* Kp;
+    double* Ki;
+    double* Kd;
+    double* output_min;
+    double* output_max;
+
+    // 状态
+    double* integral;
+    double* prev_error;
+
+    // 最近一次计算的输出
+    double* output;
+
+    void* storage;         // 所有数组共用的一块对齐内存
+} PIDBankFunctionBlock;
+
+// float32 批量 PID（字段含义同 PIDBankFunctionBlock，数组元素为 float）
+typedef struct {
+    FunctionBlock base;
+    size_t count;
+    size_t capacity;
+    float* Kp;
+    float* Ki;
+    float* Kd;
+    float* output_min;
+    float* output_max;
+    float* integral;
+    float* prev_error;
+    float* output;
+    void* storage;
+} PIDBankFunctionBlock_f32;
+
+/**
+ * @brief 创建批量 PID 功能块，所有回路使用相同的初始参数
+ * @param count 回路数 [1, PID_BANK_MAX_LOOPS]
+ * @param Kp 比例系数
+ * @param Ki 积分系数
+ * @param Kd 微分系数
+ * @param output_min 输出下限
+ * @param output_max 输出上限
+ * @return 功能块指针（已登记到注册表），参数无效、内存不足或注册表已满时返回 NULL
+ */
+PIDBankFunctionBlock* pid_bank_create(size_t count, double Kp, double Ki, double Kd,
+                                      double output_min, double output_max);
+
+/**
+ * @brief 销毁批量 PID 功能块
+ * @param bank 功能块指针
+ */
+void pid_bank_destroy(PIDBankFunctionBlock* bank);
+
+/**
+ * @brief 计算全部回路
+ * @param bank 功能块指针
+ * @param SP 设定值数组（长度 count）
+ * @param PV 过程变量数组（长度 count）
+ * @param dt 时间步长（秒），0 表示自动计算（所有回路共用）
+ * @param out 输出数组（长度 count），NULL 表示只写入 bank->output
+ * @return 0 成功，-1 失败
+ */
+int pid_bank_compute(PIDBankFunctionBlock* bank, const double* SP, const double* PV,
+                     double dt, double* out);
+
+/**
+ * @brief 设置单个回路的 PID 参数
+ * @param bank 功能块指针
+ * @param index 回路下标
+ * @param Kp 比例系数（NULL 表示不修改）
+ * @param Ki 积分系数（NULL 表示不修改）
+ * @param Kd 微分系数（NULL 表示不修改）
+ * @return 0 成功，-1 失败
+ */
+int pid_bank_set_params(PIDBankFunctionBlock* bank, size_t index, const double* Kp,
+                        const double* Ki, const double* Kd);
+
+/**
+ * @brief 设置单个回路的输出限幅
+ * @param bank 功能块指针
+ * @param index 回路下标
+ * @param output_min 输出下限
+ * @param output_max 输出上限
+ * @return 0 成功，-1 失败（下标越界或 output_min >= output_max）
+ */
+int pid_bank_set_output_limits(PIDBankFunctionBlock* bank, size_t index,
+                               double output_min, double output_max);
+
+/**
+ * @brief 重置全部回路的内部状态
+ * @param bank 功能块指针
+ */
+void pid_bank_reset(PIDBankFunctionBlock* bank);
+
+/**
+ * @brief 获取当前使用的计算内核名称
+ * @return "avx2"、"sse2" 或 "scalar"
+ */
+const char* pid_bank_kernel_name(void);
+
+/* float32 实例：参数与返回值含义同上，SP / PV / out / dt 为 float */
+PIDBankFunctionBlock_f32* pid_bank_create_f32(size_t count, double Kp, double Ki, double Kd,
+                                              double output_min, double output_max);
+void pid_bank_destroy_f32(PIDBankFunctionBlock_f32* bank);
+int pid_bank_compute_f32(PIDBankFunctionBlock_f32* bank, const float* SP, const float* PV,
+                         float dt, float* out);
+int pid_bank_set_params_f32(PIDBankFunctionBlock_f32* bank, size_t index, const double* Kp,
+                            const double* Ki, const double* Kd);
+int pid_bank_set_output_limits_f32(PIDBankFunctionBlock_f32* bank, size_t index,
+                                   double output_min, double output_max);
+void pid_bank_reset_f32(PIDBankFunctionBlock_f32* bank);
+const char* pid_bank_kernel_name_f32(void);
+
+#endif // FB_PID_BANK_H
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_pid_bank_impl.h
+ * @brief 批量 PID 实现模板（由 fb_pid_bank.c 按 double / float32 各包含一次，无包含保护）
+ *
+ * 包含前需定义：
+ *   FB_REAL      数值类型
+ *   FB_SUFFIX    后缀（double 为空，float32 为 _f32）
+ *   PB_SIMD      SSE / AVX 指令后缀（_pd / _ps）
+ *   PB_V128      128 位向量类型（__m128d / __m128）
+ *   PB_V256      256 位向量类型（__m256d / __m256）
+ * 包含结束时取消以上定义。向量内核与标量路径使用同一运算顺序，
+ * float32 实例每个向量的回路数加倍，结果与 pid_kernel_f32() 逐位一致。
+ */
+
+#define FB_NAME(x) FB_CAT(x, FB_SUFFIX)
+#define PB_BANK FB_NAME(PIDBankFunctionBlock)
+#define PB_SSE(op) FB_CAT(FB_CAT(_mm_, op), PB_SIMD)
+#define PB_AVX(op) FB_CAT(FB_CAT(_mm256_, op), PB_SIMD)
+#define PB_LINE (PID_BANK_ALIGN / sizeof(FB_REAL))   // 每个缓存行容纳的元素个数
+
+// 内核：计算 [0, n) 中按向量宽度对齐的部分，返回已处理的回路数
+typedef size_t (*FB_NAME(PIDBankKernel))(PB_BANK* bank, const FB_REAL* SP,
+                                         const FB_REAL* PV, FB_REAL dt, size_t n);
+
+static FB_NAME(PIDBankKernel) FB_NAME(g_kernel) = NULL;
+static const char* FB_NAME(g_kernel_name) = "scalar";
+
+// 单个回路（标量）：与 pid_compute() / pid_block_run_f32() 使用同一个 pid_kernel()
+static inline void FB_NAME(pid_bank_step)(PB_BANK* b, size_t i,
+                                          FB_REAL SP, FB_REAL PV, FB_REAL dt) {
+    const FB_NAME(PIDParams) params = {b->Kp[i], b->Ki[i], b->Kd[i], b->output_min[i],
+                                       b->output_max[i]};
+    FB_NAME(PIDState) state = {b->integral[i], b->prev_error[i]};
+
+    b->output[i] = FB_NAME(pid_kernel)(&params, &state, SP, PV, dt);
+    b->integral[i] = state.integral;
+    b->prev_error[i] = state.prev_error;
+}
+
+static size_t FB_NAME(kernel_scalar)(PB_BANK* bank, const FB_REAL* SP,
+                                     const FB_REAL* PV, FB_REAL dt, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        FB_NAME(pid_bank_step)(bank, i, SP[i], PV[i], dt);
+    }
+    return n;
+}
+
+#ifdef PID_BANK_X86
+// SSE2：每次 2 个（double）/ 4 个（float32）回路（x86-64 基线指令集）
+#define PB_SSE_LANES (sizeof(PB_V128) / sizeof(FB_REAL))
+
+static inline PB_V128 FB_NAME(select_sse2)(PB_V128 mask, PB_V128 a, PB_V128 b) {
+    return PB_SSE(or)(PB_SSE(and)(mask, b), PB_SSE(andnot)(mask, a));
+}
+
+static size_t FB_NAME(kernel_sse2)(PB_BANK* b, const FB_REAL* SP,
+                                   const FB_REAL* PV, FB_REAL dt, size_t n) {
+    const PB_V128 vdt = PB_SSE(set1)(dt);
+    const PB_V128 zero = PB_SSE(setzero)();
+    size_t i = 0;
+
+    for (; i + PB_SSE_LANES <= n; i += PB_SSE_LANES) {
+        PB_V128 error = PB_SSE(sub)(PB_SSE(loadu)(SP + i), PB_SSE(loadu)(PV + i));
+        PB_V128 ki = PB_SSE(load)(b->Ki + i);
+        PB_V128 output = PB_SSE(mul)(PB_SSE(load)(b->Kp + i), error);
+
+        PB_V128 edt = PB_SSE(mul)(error, vdt);
+        PB_V128 integral = PB_SSE(add)(PB_SSE(load)(b->integral + i), edt);
+        output = PB_SSE(add)(output, PB_SSE(mul)(ki, integral));
+
+        if (dt > (FB_REAL)0) {
+            PB_V128 derivative = PB_SSE(div)(PB_SSE(sub)(error, PB_SSE(load)(b->prev_error + i)),
+                                              vdt);
+            output = PB_SSE(add)(output, PB_SSE(mul)(PB_SSE(load)(b->Kd + i), derivative));
+        }
+        PB_SSE(store)(b->prev_error + i, error);
+
+        // clamp()：先判断 < min，再判断 > max
+        PB_V128 mn = PB_SSE(load)(b->output_min + i);
+        PB_V128 mx = PB_SSE(load)(b->output_max + i);
+        PB_V128 limited = FB_NAME(select_sse2)(PB_SSE(cmpgt)(output, mx), output, mx);
+        limited = FB_NAME(select_sse2)(PB_SSE(cmplt)(output, mn), limited, mn);
+
+        // 抗积分饱和：limited != output（含 NaN）且 Ki > 0
+        PB_V128 saturated = PB_SSE(and)(PB_SSE(cmpneq)(limited, output), PB_SSE(cmpgt)(ki, zero));
+        integral = FB_NAME(select_sse2)(saturated, integral, PB_SSE(sub)(integral, edt));
+
+        PB_SSE(store)(b->integral + i, integral);
+        PB_SSE(store)(b->output + i, limited);
+    }
+
+    return i;
+}
+
+// AVX2：每次 4 个（double）/ 8 个（float32）回路（运行时检测 CPU 支持后才会调用）
+#define PB_AVX_LANES (sizeof(PB_V256) / sizeof(FB_REAL))
+
+__attribute__((target("avx2")))
+static size_t FB_NAME(kernel_avx2)(PB_BANK* b, const FB_REAL* SP,
+                                   const FB_REAL* PV, FB_REAL dt, size_t n) {
+    const PB_V256 vdt = PB_AVX(set1)(dt);
+    const PB_V256 zero = PB_AVX(setzero)();
+    size_t i = 0;
+
+    for (; i + PB_AVX_LANES <= n; i += PB_AVX_LANES) {
+        PB_V256 error = PB_AVX(sub)(PB_AVX(loadu)(SP + i), PB_AVX(loadu)(PV + i));
+        PB_V256 ki = PB_AVX(load)(b->Ki + i);
+        PB_V256 output = PB_AVX(mul)(PB_AVX(load)(b->Kp + i), error);
+
+        PB_V256 edt = PB_AVX(mul)(error, vdt);
+        PB_V256 integral = PB_AVX(add)(PB_AVX(load)(b->integral + i), edt);
+        output = PB_AVX(add)(output, PB_AVX(mul)(ki, integral));
+
+        if (dt > (FB_REAL)0) {
+            PB_V256 derivative = PB_AVX(div)(
+                PB_AVX(sub)(error, PB_AVX(load)(b->prev_error + i)), vdt);
+            output = PB_AVX(add)(output, PB_AVX(mul)(PB_AVX(load)(b->Kd + i), derivative));
+        }
+        PB_AVX(store)(b->prev_error + i, error);
+
+        // clamp()：先判断 < min，再判断 > max
+        PB_V256 mn = PB_AVX(load)(b->output_min + i);
+        PB_V256 mx = PB_AVX(load)(b->output_max + i);
+        PB_V256 limited = PB_AVX(blendv)(output, mx, PB_AVX(cmp)(output, mx, _CMP_GT_OQ));
+        limited = PB_AVX(blendv)(limited, mn, PB_AVX(cmp)(output, mn, _CMP_LT_OQ));
+
+        // 抗积分饱和：limited != output（含 NaN）且 Ki > 0
+        PB_V256 saturated = PB_AVX(and)(PB_AVX(cmp)(limited, output, _CMP_NEQ_UQ),
+                                        PB_AVX(cmp)(ki, zero, _CMP_GT_OQ));
+        integral = PB_AVX(blendv)(integral, PB_AVX(sub)(integral, edt), saturated);
+
+        PB_AVX(store)(b->integral + i, integral);
+        PB_AVX(store)(b->output + i, limited);
+    }
+
+    return i;
+}
+
+#undef PB_SSE_LANES
+#undef PB_AVX_LANES
+#endif
+
+// 选择计算内核：默认使用 CPU 支持的最宽指令集，
+// 可用环境变量 PLCOPEN_PID_BANK_KERNEL=scalar|sse2|avx2 指定（用于对比测试）
+static void FB_NAME(select_kernel)(void) {
+    const char* forced = getenv("PLCOPEN_PID_BANK_KERNEL");
+
+    FB_NAME(g_kernel) = FB_NAME(kernel_scalar);
+    FB_NAME(g_kernel_name) = "scalar";
+
+#ifdef PID_BANK_X86
+    if (forced && strcmp(forced, "scalar") == 0) {
+        return;
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+        FB_NAME(g_kernel) = FB_NAME(kernel_sse2);
+        FB_NAME(g_kernel_name) = "sse2";
+    }
+    if ((!forced || strcmp(forced, "sse2") != 0) && __builtin_cpu_supports("avx2")) {
+        FB_NAME(g_kernel) = FB_NAME(kernel_avx2);
+        FB_NAME(g_kernel_name) = "avx2";
+    }
+#else
+    (void)forced;
+#endif
+}
+
+const char* FB_NAME(pid_bank_kernel_name)(void) {
+    if (!FB_NAME(g_kernel)) {
+        FB_NAME(select_kernel)();
+    }
+    return FB_NAME(g_kernel_name);
+}
+
+PB_BANK* FB_NAME(pid_bank_create)(size_t count, double Kp, double Ki, double Kd,
+                                  double output_min, double output_max) {
+    if (count == 0 || count > PID_BANK_MAX_LOOPS) {
+        LOG_ERROR_MSG("批量 PID 创建失败：回路数 %zu 超出范围 [1, %u]",
+                      count, PID_BANK_MAX_LOOPS);
+        return NULL;
+    }
+
+    if (output_min >= output_max) {
+        LOG_ERROR_MSG("批量 PID 创建失败：output_min (%.6f) >= output_max (%.6f)",
+                      output_min, output_max);
+        return NULL;
+    }
+
+    PB_BANK* bank = (PB_BANK*)calloc(1, sizeof(PB_BANK));
+    if (!bank) {
+        LOG_ERROR_MSG("批量 PID 创建失败：内存分配失败");
+        return NULL;
+    }
+
+    // 每个数组长度向上取整到整缓存行，保证各数组起始地址都按缓存行对齐
+    size_t capacity = (count + PB_LINE - 1) / PB_LINE * PB_LINE;
+    size_t bytes = PID_BANK_ARRAYS * capacity * sizeof(FB_REAL);
+    if (posix_memalign(&bank->storage, PID_BANK_ALIGN, bytes) != 0) {
+        LOG_ERROR_MSG("批量 PID 创建失败：内存分配失败（%zu 字节）", bytes);
+        free(bank);
+        return NULL;
+    }
+    memset(bank->storage, 0, bytes);
+
+    FB_REAL* base = (FB_REAL*)bank->storage;
+    bank->Kp = base;
+    bank->Ki = base + capacity;
+    bank->Kd = base + 2 * capacity;
+    bank->output_min = base + 3 * capacity;
+    bank->output_max = base + 4 * capacity;
+    bank->integral = base + 5 * capacity;
+    bank->prev_error = base + 6 * capacity;
+    bank->output = base + 7 * capacity;
+
+    bank->base.type = FB_TYPE_PID_BANK;
+    bank->base.last_update_time = 0.0;
+    bank->count = count;
+    bank->capacity = capacity;
+
+    Kp = validate_and_clamp(Kp, PID_PARAM_MIN, PID_PARAM_MAX, "Kp");
+    Ki = validate_and_clamp(Ki, PID_PARAM_MIN, PID_PARAM_MAX, "Ki");
+    Kd = validate_and_clamp(Kd, PID_PARAM_MIN, PID_PARAM_MAX, "Kd");
+
+    for (size_t i = 0; i < count; i++) {
+        bank->Kp[i] = (FB_REAL)Kp;
+        bank->Ki[i] = (FB_REAL)Ki;
+        bank->Kd[i] = (FB_REAL)Kd;
+        bank->output_min[i] = (FB_REAL)output_min;
+        bank->output_max[i] = (FB_REAL)output_max;
+    }
+
+    if (fb_registry_register(&bank->base, NULL, NULL) == 0) {
+        free(bank->storage);
+        free(bank);
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_PID_BANK, bank->base.id, FB_EVENT_CREATE, "loops", (double)count);
+
+    return bank;
+}
+
+void FB_NAME(pid_bank_destroy)(PB_BANK* bank) {
+    if (bank) {
+        FB_JOURNAL_EVENT(FB_TYPE_PID_BANK, bank->base.id, FB_EVENT_DESTROY);
+        fb_registry_unregister(bank->base.id);
+        free(bank->storage);
+        free(bank);
+    }
+}
+
+int FB_NAME(pid_bank_compute)(PB_BANK* bank, const FB_REAL* SP, const FB_REAL* PV,
+                              FB_REAL dt, FB_REAL* out) {
+    if (!bank || !SP || !PV) {
+        return -1;
+    }
+    FB_TIMED(&bank->base);
+
+    // dt 为 0 时自动计算时间差（所有回路共用一个时间戳，与 pid_compute() 规则相同）
+    if (dt <= (FB_REAL)0) {
+        dt = (FB_REAL)fb_auto_dt(&bank->base);
+    }
+
+    if (!FB_NAME(g_kernel)) {
+        FB_NAME(select_kernel)();
+    }
+
+    // 向量内核处理整块，剩余回路走标量路径
+    size_t done = FB_NAME(g_kernel)(bank, SP, PV, dt, bank->count);
+    for (size_t i = done; i < bank->count; i++) {
+        FB_NAME(pid_bank_step)(bank, i, SP[i], PV[i], dt);
+    }
+
+    if (out && out != bank->output) {
+        memcpy(out, bank->output, bank->count * sizeof(FB_REAL));
+    }
+
+    return 0;
+}
+
+int FB_NAME(pid_bank_set_params)(PB_BANK* bank, size_t index, const double* Kp,
+                                 const double* Ki, const double* Kd) {
+    if (!bank || index >= bank->count) {
+        return -1;
+    }
+
+    if (Kp) {
+        bank->Kp[index] = (FB_REAL)validate_and_clamp(*Kp, PID_PARAM_MIN, PID_PARAM_MAX, "Kp");
+    }
+    if (Ki) {
+        bank->Ki[index] = (FB_REAL)validate_and_clamp(*Ki, PID_PARAM_MIN, PID_PARAM_MAX, "Ki");
+    }
+    if (Kd) {
+        bank->Kd[index] = (FB_REAL)validate_and_clamp(*Kd, PID_PARAM_MIN, PID_PARAM_MAX, "Kd");
+    }
+
+    return 0;
+}
+
+int FB_NAME(pid_bank_set_output_limits)(PB_BANK* bank, size_t index,
+                                        double output_min, double output_max) {
+    if (!bank || index >= bank->count || !(output_min < output_max)) {
+        return -1;
+    }
+
+    bank->output_min[index] = (FB_REAL)output_min;
+    bank->output_max[index] = (FB_REAL)output_max;
+    return 0;
+}
+
+void FB_NAME(pid_bank_reset)(PB_BANK* bank) {
+    if (bank) {
+        memset(bank->integral, 0, bank->count * sizeof(FB_REAL));
+        memset(bank->prev_error, 0, bank->count * sizeof(FB_REAL));
+        memset(bank->output, 0, bank->count * sizeof(FB_REAL));
+        bank->base.last_update_time = 0.0;
+        FB_JOURNAL_EVENT(FB_TYPE_PID_BANK, bank->base.id, FB_EVENT_RESET);
+    }
+}
+
+#undef PB_LINE
+#undef PB_AVX
+#undef PB_SSE
+#undef PB_BANK
+#undef FB_NAME
+#undef FB_REAL
+#undef FB_SUFFIX
+#undef PB_SIMD
+#undef PB_V128
+#undef PB_V256
@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_pool.c
+ * @brief 功能块实例池实现
+ */
+
+#include "fb_pool.h"
+#include "fb_pid.h"
+#include "fb_first_order.h"
+#include "fb_ramp.h"
+#include "fb_limit.h"
+#include "fb_dead_time.h"
+#include "fb_window.h"
+#include "fb_iir.h"
+#include "fb_lookup.h"
+#include "fb_iec.h"
+#include "fb_autotune.h"
+#include "fb_kalman.h"
+#include "../runtime/logger.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 单个类型的实例池
+typedef struct {
+    const char* name;
+    size_t object_size;      // 实例大小
+    size_t slot_size;        // 对齐后的槽位大小
+    size_t capacity;
+    uint8_t* storage;        // capacity * slot_size，按缓存行对齐
+    uint32_t* free_stack;    // 空闲槽位下标栈
+    size_t free_count;
+    size_t peak;
+    uint64_t failures;
+} FBPool;
+
+#define POOL_SLOT_SIZE(size) (((size) + FB_POOL_ALIGN - 1) / FB_POOL_ALIGN * FB_POOL_ALIGN)
+
+static FBPool g_pools[] = {
+    [FB_TYPE_PID] = {"PID", sizeof(PIDFunctionBlock),
+                     POOL_SLOT_SIZE(sizeof(PIDFunctionBlock)), 0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_FIRST_ORDER] = {"FirstOrder", sizeof(FirstOrderFunctionBlock),
+                             POOL_SLOT_SIZE(sizeof(FirstOrderFunctionBlock)),
+                             0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_RAMP] = {"Ramp", sizeof(RampFB), POOL_SLOT_SIZE(sizeof(RampFB)),
+                      0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_LIMIT] = {"Limit", sizeof(LimitFB), POOL_SLOT_SIZE(sizeof(LimitFB)),
+                       0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_DEAD_TIME] = {"DeadTime", sizeof(DeadTimeFB), POOL_SLOT_SIZE(sizeof(DeadTimeFB)),
+                           0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_MOVING_AVERAGE] = {"MovingAverage", sizeof(MovingAverageFB),
+                                POOL_SLOT_SIZE(sizeof(MovingAverageFB)), 0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_MOVING_MEDIAN] = {"MovingMedian", sizeof(MovingMedianFB),
+                               POOL_SLOT_SIZE(sizeof(MovingMedianFB)), 0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_SLOPE] = {"Slope", sizeof(SlopeFB), POOL_SLOT_SIZE(sizeof(SlopeFB)),
+                       0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_IIR] = {"IIR", sizeof(IIRFB), POOL_SLOT_SIZE(sizeof(IIRFB)),
+                     0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_LOOKUP_1D] = {"Lookup1D", sizeof(Lookup1DFB), POOL_SLOT_SIZE(sizeof(Lookup1DFB)),
+                           0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_LOOKUP_2D] = {"Lookup2D", sizeof(Lookup2DFB), POOL_SLOT_SIZE(sizeof(Lookup2DFB)),
+                           0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_TON] = {"TON", sizeof(TimerFB), POOL_SLOT_SIZE(sizeof(TimerFB)),
+                     0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_TOF] = {"TOF", sizeof(TimerFB), POOL_SLOT_SIZE(sizeof(TimerFB)),
+                     0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_TP] = {"TP", sizeof(TimerFB), POOL_SLOT_SIZE(sizeof(TimerFB)),
+                    0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_CTU] = {"CTU", sizeof(CounterFB), POOL_SLOT_SIZE(sizeof(CounterFB)),
+                     0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_CTD] = {"CTD", sizeof(CounterFB), POOL_SLOT_SIZE(sizeof(CounterFB)),
+                     0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_R_TRIG] = {"R_TRIG", sizeof(TriggerFB), POOL_SLOT_SIZE(sizeof(TriggerFB)),
+                        0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_F_TRIG] = {"F_TRIG", sizeof(TriggerFB), POOL_SLOT_SIZE(sizeof(TriggerFB)),
+                        0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_AUTOTUNE] = {"AutoTuner", sizeof(AutoTuneFB), POOL_SLOT_SIZE(sizeof(AutoTuneFB)),
+                          0, NULL, NULL, 0, 0, 0},
+    [FB_TYPE_KALMAN] = {"KalmanFilter", sizeof(KalmanFB), POOL_SLOT_SIZE(sizeof(KalmanFB)),
+                        0, NULL, NULL, 0, 0, 0},
+};
+
+#define POOL_COUNT (sizeof(g_pools) / sizeof(g_pools[0]))
+
+// 附属存储区中的块：空闲块按地址升序串成链表，已分配块的块头记录大小和标记
+typedef struct StorageChunk {
+    size_t size;                 // 含块头的字节数（FB_POOL_ALIGN 的整数倍）
+    struct StorageChunk* next;   // 空闲链表中的下一块；已分配块为 STORAGE_IN_USE
+} StorageChunk;
+
+#define STORAGE_HEADER FB_POOL_ALIGN
+#define STORAGE_IN_USE ((StorageChunk*)(uintptr_t)0x46425354u)
+
+typedef struct {
+    uint8_t* base;
+    size_t bytes;
+    StorageChunk* free_list;
+    size_t used;
+    size_t peak;
+    uint64_t failures;
+} FBStorage;
+
+static FBStorage g_storage;
+
+// free-threaded 构建下多个线程可能同时创建功能块
+static pthread_mutex_t g_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int g_pool_configured = 0;
+
+static FBPool* pool_for(FunctionBlockType type) {
+    if ((size_t)type >= POOL_COUNT || g_pools[type].object_size == 0) {
+        return NULL;
+    }
+    return &g_pools[type];
+}
+
+static void release_pool(FBPool* pool) {
+    free(pool->storage);
+    free(pool->free_stack);
+    pool->storage = NULL;
+    pool->free_stack = NULL;
+    pool->capacity = 0;
+    pool->free_count = 0;
+    pool->peak = 0;
+    pool->failures = 0;
+}
+
+static void release_storage(void) {
+    free(g_storage.base);
+    memset(&g_storage, 0, sizeof(g_storage));
+}
+
+// 调用者持有 g_pool_mutex
+static int configure_storage_locked(size_t bytes) {
+    release_storage();
+
+    bytes = bytes / FB_POOL_ALIGN * FB_POOL_ALIGN;
+    void* base = NULL;
+    if (bytes < 2 * STORAGE_HEADER || posix_memalign(&base, FB_POOL_ALIGN, bytes) != 0) {
+        LOG_ERROR_MSG("附属存储区分配失败：%zu 字节", bytes);
+        return -1;
+    }
+
+    g_storage.base = (uint8_t*)base;
+    g_storage.bytes = bytes;
+    g_storage.free_list = (StorageChunk*)base;
+    g_storage.free_list->size = bytes;
+    g_storage.free_list->next = NULL;
+    return 0;
+}
+
+// 调用者持有 g_pool_mutex
+static int configure_locked(size_t capacity, size_t storage_bytes) {
+    if (capacity == 0 || capacity > UINT32_MAX) {
+        LOG_ERROR_MSG("实例池容量无效：%zu", capacity);
+        return -1;
+    }
+    if (storage_bytes == 0) {
+        if (capacity > SIZE_MAX / FB_POOL_STORAGE_PER_SLOT) {
+            LOG_ERROR_MSG("实例池容量无效：%zu", capacity);
+            return -1;
+        }
+        storage_bytes = capacity * FB_POOL_STORAGE_PER_SLOT;
+    }
+    if (g_storage.used) {
+        LOG_ERROR_MSG("实例池重新配置失败：附属存储仍有 %zu 字节在使用", g_storage.used);
+        return -1;
+    }
+
+    for (size_t t = 0; t < POOL_COUNT; t++) {
+        FBPool* pool = &g_pools[t];
+        if (pool->object_size && pool->free_count != pool->capacity) {
+            LOG_ERROR_MSG("实例池重新配置失败：%s 仍有 %zu 个实例在使用",
+                          pool->name, pool->capacity - pool->free_count);
+            return -1;
+        }
+    }
+
+    for (size_t t = 0; t < POOL_COUNT; t++) {
+        FBPool* pool = &g_pools[t];
+        if (!pool->object_size) {
+            continue;
+        }
+
+        release_pool(pool);
+
+        void* storage = NULL;
+        if (posix_memalign(&storage, FB_POOL_ALIGN, capacity * pool->slot_size) != 0) {
+            storage = NULL;
+        }
+        pool->storage = (uint8_t*)storage;
+        pool->free_stack = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+        if (!pool->storage || !pool->free_stack) {
+            LOG_ERROR_MSG("实例池 %s 分配失败：容量 %zu", pool->name, capacity);
+            for (size_t u = 0; u <= t; u++) {
+                release_pool(&g_pools[u]);
+            }
+            g_pool_configured = 0;
+            return -1;
+        }
+
+        // 栈顶为下标 0，先分配的实例位于低地址、彼此相邻
+        for (size_t i = 0; i < capacity; i++) {
+            pool->free_stack[i] = (uint32_t)(capacity - 1 - i);
+        }
+        pool->capacity = capacity;
+        pool->free_count = capacity;
+    }
+
+    if (configure_storage_locked(storage_bytes) != 0) {
+        for (size_t t = 0; t < POOL_COUNT; t++) {
+            release_pool(&g_pools[t]);
+        }
+        g_pool_configured = 0;
+        return -1;
+    }
+
+    g_pool_configured = 1;
+    LOG_INFO_MSG("功能块实例池已配置：每种类型 %zu 个槽位，附属存储 %zu 字节",
+                 capacity, g_storage.bytes);
+    return 0;
+}
+
+int fb_pool_configure(size_t capacity, size_t storage_bytes) {
+    pthread_mutex_lock(&g_pool_mutex);
+    int rc = configure_locked(capacity, storage_bytes);
+    pthread_mutex_unlock(&g_pool_mutex);
+    return rc;
+}
+
+void* fb_pool_alloc(FunctionBlockType type) {
+    FBPool* pool = pool_for(type);
+    if (!pool) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&g_pool_mutex);
+
+    if (!g_pool_configured && configure_locked(FB_POOL_DEFAULT_CAPACITY, 0) != 0) {
+        pthread_mutex_unlock(&g_pool_mutex);
+        return NULL;
+    }
+
+    if (pool->free_count == 0) {
+        pool->failures++;
+        pthread_mutex_unlock(&g_pool_mutex);
+        LOG_ERROR_MSG("实例池 %s 已满（容量 %zu），请增大 performance.max_function_blocks",
+                      pool->name, pool->capacity);
+        return NULL;
+    }
+
+    uint32_t index = pool->free_stack[--pool->free_count];
+    size_t used = pool->capacity - pool->free_count;
+    if (used > pool->peak) {
+        pool->peak = used;
+    }
+
+    pthread_mutex_unlock(&g_pool_mutex);
+
+    void* block = pool->storage + (size_t)index * pool->slot_size;
+    memset(block, 0, pool->slot_size);
+    return block;
+}
+
+void fb_pool_free(FunctionBlockType type, void* block) {
+    FBPool* pool = pool_for(type);
+    if (!pool || !block) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_pool_mutex);
+
+    uint8_t* p = (uint8_t*)block;
+    size_t offset = (size_t)(p - pool->storage);
+    if (!pool->storage || p < pool->storage || offset >= pool->capacity * pool->slot_size ||
+        offset % pool->slot_size != 0 || pool->free_count == pool->capacity) {
+        pthread_mutex_unlock(&g_pool_mutex);
+        LOG_ERROR_MSG("实例池 %s 释放失败：%p 不是池中的实例", pool->name, block);
+        return;
+    }
+
+    pool->free_stack[pool->free_count++] = (uint32_t)(offset / pool->slot_size);
+    pthread_mutex_unlock(&g_pool_mutex);
+}
+
+void* fb_pool_storage_alloc(size_t size) {
+    if (size > SIZE_MAX / 2) {
+        return NULL;
+    }
+    size_t need = STORAGE_HEADER + POOL_SLOT_SIZE(size ? size : 1);
+
+    pthread_mutex_lock(&g_pool_mutex);
+
+    if (!g_pool_configured && configure_locked(FB_POOL_DEFAULT_CAPACITY, 0) != 0) {
+        pthread_mutex_unlock(&g_pool_mutex);
+        return NULL;
+    }
+
+    // 首次适配：创建/销毁不在控制周期的关键路径上，空闲块数通常很少
+    StorageChunk** link = &g_storage.free_list;
+    while (*link && (*link)->size < need) {
+        link = &(*link)->next;
+    }
+
+    StorageChunk* chunk = *link;
+    if (!chunk) {
+        g_storage.failures++;
+        size_t bytes = g_storage.bytes;
+        size_t used = g_storage.used;
+        pthread_mutex_unlock(&g_pool_mutex);
+        LOG_ERROR_MSG("附属存储区不足：需要 %zu 字节，已用 %zu / %zu 字节，"
+                      "请增大 performance.fb_storage_kb", need, used, bytes);
+        return NULL;
+    }
+
+    if (chunk->size - need >= 2 * STORAGE_HEADER) {
+        StorageChunk* rest = (StorageChunk*)((uint8_t*)chunk + need);
+        rest->size = chunk->size - need;
+        rest->next = chunk->next;
+        *link = rest;
+        chunk->size = need;
+    } else {
+        *link = chunk->next;
+    }
+    chunk->next = STORAGE_IN_USE;
+
+    g_storage.used += chunk->size;
+    if (g_storage.used > g_storage.peak) {
+        g_storage.peak = g_storage.used;
+    }
+
+    pthread_mutex_unlock(&g_pool_mutex);
+    return (uint8_t*)chunk + STORAGE_HEADER;
+}
+
+void fb_pool_storage_free(void* storage) {
+    if (!storage) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_pool_mutex);
+
+    uint8_t* p = (uint8_t*)storage - STORAGE_HEADER;
+    StorageChunk* chunk = (StorageChunk*)p;
+    if (!g_storage.base || p < g_storage.base || p >= g_storage.base + g_storage.bytes ||
+        (size_t)(p - g_storage.base) % FB_POOL_ALIGN != 0 || chunk->next != STORAGE_IN_USE) {
+        pthread_mutex_unlock(&g_pool_mutex);
+        LOG_ERROR_MSG("附属存储释放失败：%p 不是存储区中已分配的块", storage);
+        return;
+    }
+
+    g_storage.used -= chunk->size;
+
+    // 按地址插入空闲链表，并与前后相邻的空闲块合并
+    StorageChunk* prev = NULL;
+    StorageChunk* next = g_storage.free_list;
+    while (next && next < chunk) {
+        prev = next;
+        next = next->next;
+    }
+
+    chunk->next = next;
+    if (next && (uint8_t*)chunk + chunk->size == (uint8_t*)next) {
+        chunk->size += next->size;
+        chunk->next = next->next;
+    }
+    if (prev && (uint8_t*)prev + prev->size == (uint8_t*)chunk) {
+        prev->size += chunk->size;
+        prev->next = chunk->next;
+    } else if (prev) {
+        prev->next = chunk;
+    } else {
+        g_storage.free_list = chunk;
+    }
+
+    pthread_mutex_unlock(&g_pool_mutex);
+}
+
+void fb_pool_get_storage_stats(FBPoolStats* stats) {
+    if (!stats) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_pool_mutex);
+    stats->capacity = g_storage.bytes;
+    stats->used = g_storage.used;
+    stats->peak = g_storage.peak;
+    stats->failures = g_storage.failures;
+    stats->slot_size = FB_POOL_ALIGN;
+    pthread_mutex_unlock(&g_pool_mutex);
+}
+
+int fb_pool_get_stats(FunctionBlockType type, FBPoolStats* stats) {
+    FBPool* pool = pool_for(type);
+    if (!pool || !stats) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&g_pool_mutex);
+    stats->capacity = pool->capacity;
+    stats->used = pool->capacity - pool->free_count;
+    stats->peak = pool->peak;
+    stats->failures = pool->failures;
+    stats->slot_size = pool->slot_size;
+    pthread_mutex_unlock(&g_pool_mutex);
+    return 0;
+}
+
+const char* fb_pool_type_name(FunctionBlockType type) {
+    FBPool* pool = pool_for(type);
+    return pool ? pool->name : NULL;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_pool.h
+ * @brief 功能块实例池
+ *
+ * 每种功能块类型一个预分配的实例池，槽位按缓存行（64 字节）对齐，
+ * 空闲槽位用下标栈管理，分配/释放均为 O(1) 且不调用系统分配器。
+ * 运行时在启动时按 performance.max_function_blocks 配置各池容量；
+ * 未配置时（如直接在 Python 中使用扩展）首次分配按默认容量初始化。
+ * 池满时分配失败，不会回退到 malloc。
+ *
+ * 大小取决于参数的附属存储（DeadTime 环形缓冲区、滑动窗口、Lookup 表副本）
+ * 从同时预分配的存储区中按首次适配切分，块头和块大小按缓存行对齐，
+ * 释放时与相邻空闲块合并；存储区不足时同样分配失败。
+ * 批量形式（PIDBank、*Array）不使用实例池，其 SoA 存储在构造时由系统分配器
+ * 一次分配，计算中不再分配。
+ */
+
+#ifndef FB_POOL_H
+#define FB_POOL_H
+
+#include "fb_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define FB_POOL_ALIGN 64                 // 槽位对齐（缓存行）
+#define FB_POOL_DEFAULT_CAPACITY 1024    // 未配置时每种类型的默认容量
+#define FB_POOL_STORAGE_PER_SLOT 16384   // 未指定存储区大小时每个槽位对应的字节数
+
+// 池占用统计
+typedef struct {
+    size_t capacity;         // 槽位总数
+    size_t used;             // 当前占用
+    size_t peak;             // 历史最高占用
+    uint64_t failures;       // 池满导致的分配失败次数
+    size_t slot_size;        // 单个槽位字节数（对齐后）
+} FBPoolStats;
+
+/**
+ * @brief 配置全部实例池的容量并预分配存储
+ * @param capacity 每种类型的槽位数
+ * @param storage_bytes 附属存储区字节数，0 表示 capacity * FB_POOL_STORAGE_PER_SLOT
+ * @return 0 成功，-1 失败（有实例或附属存储仍在使用或内存分配失败）
+ */
+int fb_pool_configure(size_t capacity, size_t storage_bytes);
+
+/**
+ * @brief 从对应类型的池中分配一个实例（内容清零）
+ * @param type 功能块类型（PID、FirstOrder、Ramp、Limit、DeadTime、MovingAverage、
+ *             MovingMedian、Slope、IIR、Lookup1D、Lookup2D、TON、TOF、TP、CTU、CTD、
+ *             R_TRIG、F_TRIG、AutoTuner、KalmanFilter）
+ * @return 实例指针（64 字节对齐），池满或类型不支持时返回 NULL
+ */
+void* fb_pool_alloc(FunctionBlockType type);
+
+/**
+ * @brief 归还实例
+ * @param type 功能块类型
+ * @param block 由 fb_pool_alloc() 返回的指针
+ */
+void fb_pool_free(FunctionBlockType type, void* block);
+
+/**
+ * @brief 从附属存储区分配一块存储（内容未初始化）
+ * @param size 字节数
+ * @return 存储指针（64 字节对齐），存储区不足时返回 NULL
+ */
+void* fb_pool_storage_alloc(size_t size);
+
+/**
+ * @brief 归还附属存储
+ * @param storage 由 fb_pool_storage_alloc() 返回的指针，NULL 时不做任何事
+ */
+void fb_pool_storage_free(void* storage);
+
+/**
+ * @brief 获取附属存储区占用统计（capacity/used/peak 以字节计，slot_size 为对齐粒度）
+ * @param stats 输出统计
+ */
+void fb_pool_get_storage_stats(FBPoolStats* stats);
+
+/**
+ * @brief 获取池占用统计
+ * @param type 功能块类型
+ * @param stats 输出统计
+ * @return 0 成功，-1 类型不支持
+ */
+int fb_pool_get_stats(FunctionBlockType type, FBPoolStats* stats);
+
+/**
+ * @brief 获取池对应的类型名（用于报告）
+ * @param type 功能块类型
+ * @return 类型名，不支持的类型返回 NULL
+ */
+const char* fb_pool_type_name(FunctionBlockType type);
+
+#endif // FB_POOL_H
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_precision.c
+ * @brief float32 / Q16.16 功能块实例实现
+ *
+ * 计算函数由 fb_precision_impl.h 按精度实例化；参数校验在 double 下进行
+ * （范围与 double 版本相同），之后才转换为所选精度。
+ */
+
+#include "fb_precision.h"
+#include "../runtime/logger.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 参数范围（与 fb_pid.c / fb_first_order.c 相同）
+#define PID_PARAM_MIN 0.0
+#define PID_PARAM_MAX 1e6
+#define T_MIN 0.001
+#define T_MAX 1e6
+
+// float32
+#define FB_REAL float
+#define FB_SUFFIX _f32
+#define FB_FROM(x) ((float)(x))
+#define FB_TO(x) ((double)(x))
+#include "fb_precision_impl.h"
+
+// Q16.16 定点
+#define FB_REAL fb_q16_t
+#define FB_SUFFIX _q16
+#define FB_FROM(x) fb_q16_from_double(x)
+#define FB_TO(x) fb_q16_to_double(x)
+#include "fb_precision_impl.h"
+
+int fb_precision_parse(const char* name, FBPrecision* precision) {
+    static const char* const names[] = {"f64", "f32", "q16"};
+
+    for (int i = 0; i < 3; i++) {
+        if (name && strcmp(name, names[i]) == 0) {
+            *precision = (FBPrecision)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+const char* fb_precision_name(FBPrecision precision) {
+    switch (precision) {
+    case FB_PRECISION_F32: return "f32";
+    case FB_PRECISION_Q16: return "q16";
+    default: return "f64";
+    }
+}
+
+// 单个实例的大小，不支持的类型返回 0
+static size_t block_size(FunctionBlockType type, FBPrecision precision) {
+    int f32 = precision == FB_PRECISION_F32;
+
+    switch (type) {
+    case FB_TYPE_PID: return f32 ? sizeof(PIDBlock_f32) : sizeof(PIDBlock_q16);
+    case FB_TYPE_FIRST_ORDER: return f32 ? sizeof(FirstOrderBlock_f32) : sizeof(FirstOrderBlock_q16);
+    case FB_TYPE_RAMP: return f32 ? sizeof(RampBlock_f32) : sizeof(RampBlock_q16);
+    case FB_TYPE_LIMIT: return f32 ? sizeof(LimitBlock_f32) : sizeof(LimitBlock_q16);
+    default: return 0;
+    }
+}
+
+// 按类型校验参数，v 为校验（限幅）后的参数
+static int validate_params(FunctionBlockType type, const double* p, double* v) {
+    switch (type) {
+    case FB_TYPE_PID:
+        if (!(p[3] < p[4])) {
+            return -1;
+        }
+        v[0] = validate_and_clamp(p[0], PID_PARAM_MIN, PID_PARAM_MAX, "Kp");
+        v[1] = validate_and_clamp(p[1], PID_PARAM_MIN, PID_PARAM_MAX, "Ki");
+        v[2] = validate_and_clamp(p[2], PID_PARAM_MIN, PID_PARAM_MAX, "Kd");
+        v[3] = p[3];
+        v[4] = p[4];
+        return 0;
+    case FB_TYPE_FIRST_ORDER:
+        v[0] = validate_and_clamp(p[0], T_MIN, T_MAX, "T");
+        return 0;
+    case FB_TYPE_RAMP:
+        if (!(p[0] >= 0.0) || !(p[1] >= 0.0)) {
+            return -1;
+        }
+        v[0] = p[0];
+        v[1] = p[1];
+        return 0;
+    case FB_TYPE_LIMIT:
+        if (!(p[0] <= p[1])) {
+            return -1;
+        }
+        v[0] = p[0];
+        v[1] = p[1];
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+static void precision_set(FBPrecisionArray* array, size_t index, const double* v) {
+    if (array->precision == FB_PRECISION_F32) {
+        precision_set_f32(array, index, v);
+    } else {
+        precision_set_q16(array, index, v);
+    }
+}
+
+FBPrecisionArray* fb_precision_array_create(FunctionBlockType type, FBPrecision precision,
+                                            size_t count, const double* params) {
+    double v[FB_PRECISION_MAX_FIELDS];
+    size_t size = precision == FB_PRECISION_F64 ? 0 : block_size(type, precision);
+
+    if (size == 0 || count == 0 || !params || validate_params(type, params, v) != 0) {
+        LOG_ERROR_MSG("%s 实例数组创建失败：类型或参数无效", fb_precision_name(precision));
+        return NULL;
+    }
+
+    FBPrecisionArray* array = (FBPrecisionArray*)calloc(1, sizeof(FBPrecisionArray));
+    if (!array) {
+        return NULL;
+    }
+    array->blocks = calloc(count, size);
+    if (!array->blocks) {
+        free(array);
+        return NULL;
+    }
+
+    array->type = type;
+    array->precision = precision;
+    array->count = count;
+    for (size_t i = 0; i < count; i++) {
+        precision_set(array, i, v);
+    }
+
+    return array;
+}
+
+void fb_precision_array_destroy(FBPrecisionArray* array) {
+    if (array) {
+        free(array->blocks);
+        free(array);
+    }
+}
+
+int fb_precision_array_compute(FBPrecisionArray* array, const double* in, const double* in2,
+                               double dt, double* out) {
+    if (!array || !in || !out || (array->type == FB_TYPE_PID && !in2)) {
+        return -1;
+    }
+
+    if (array->precision == FB_PRECISION_F32) {
+        precision_compute_f32(array, in, in2, dt, out);
+    } else {
+        precision_compute_q16(array, in, in2, dt, out);
+    }
+    return 0;
+}
+
+int fb_precision_array_set_params(FBPrecisionArray* array, size_t index, const double* params) {
+    double v[FB_PRECISION_MAX_FIELDS];
+
+    if (!array || index >= array->count || !params ||
+        validate_params(array->type, params, v) != 0) {
+        return -1;
+    }
+
+    precision_set(array, index, v);
+    return 0;
+}
+
+int fb_precision_array_get(const FBPrecisionArray* array, size_t index, double* fields) {
+    if (!array || index >= array->count || !fields) {
+        return -1;
+    }
+
+    return array->precision == FB_PRECISION_F32 ? precision_get_f32(array, index, fields)
+                                                : precision_get_q16(array, index, fields);
+}
+
+void fb_precision_array_reset(FBPrecisionArray* array, double initial_value) {
+    if (!array) {
+        return;
+    }
+
+    if (array->precision == FB_PRECISION_F32) {
+        precision_reset_f32(array, initial_value);
+    } else {
+        precision_reset_q16(array, initial_value);
+    }
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_precision.h
+ * @brief float32 / Q16.16 功能块实例
+ *
+ * PID、一阶惯性、斜率限制、限幅的 float32（后缀 _f32）和 Q16.16 定点（后缀 _q16）
+ * 版本，计算调用 fb_kernels.h 中同一模板的对应实例。参数和状态按所选精度存放：
+ * float32 / Q16.16 的 PID 实例 28 字节（double 56 字节），数组访存减半。
+ *
+ * 两层接口：
+ *   - xxx_block_run_f32() / _q16()：原生精度的输入输出数组，供嵌入式调用方直接使用；
+ *   - FBPrecisionArray：n 个同类型实例，输入输出为 double 数组（边界处转换），
+ *     供 Python 实例数组的 precision 选项使用。
+ * Q16.16 的参数和信号范围约为 ±32768，超出部分饱和（见 fb_numeric.h）。
+ */
+
+#ifndef FB_PRECISION_H
+#define FB_PRECISION_H
+
+#include "fb_common.h"
+#include <stddef.h>
+
+// 数值精度
+typedef enum {
+    FB_PRECISION_F64,   // double（原有功能块）
+    FB_PRECISION_F32,   // float32
+    FB_PRECISION_Q16    // Q16.16 定点
+} FBPrecision;
+
+// FBPrecisionArray 参数 / 字段个数上限
+#define FB_PRECISION_MAX_FIELDS 8
+
+/*
+ * 按精度声明单实例结构和原生精度的数组计算函数（T 为数值类型，S 为后缀）：
+ *   PIDBlock##S / FirstOrderBlock##S / RampBlock##S / LimitBlock##S
+ *   pid_block_run##S(blocks, n, SP, PV, dt, out)      标准位置式 PID
+ *   first_order_block_run##S(blocks, n, in, dt, out)  一阶惯性（dt 变化时重算 alpha）
+ *   ramp_block_run##S(blocks, n, in, dt, out)         斜率限制（首周期输出等于输入，dt <= 0 时输出 0）
+ *   limit_block_run##S(blocks, n, in, out)            限幅
+ * 与 double 版本不同，这里的 dt 必须由调用方给出。
+ */
+#define FB_PRECISION_DECLARE(T, S)                                                           \
+    typedef struct {                                                                         \
+        PIDParams##S params;                                                                 \
+        PIDState##S state;                                                                   \
+    } PIDBlock##S;                                                                           \
+    typedef struct {                                                                         \
+        FirstOrderParams##S params;                                                          \
+        FirstOrderState##S state;                                                            \
+        T alpha_dt;                                                                          \
+        T alpha;                                                                             \
+    } FirstOrderBlock##S;                                                                    \
+    typedef struct {                                                                         \
+        T rising_rate;                                                                       \
+        T falling_rate;                                                                      \
+        T output;                                                                            \
+        int initialized;                                                                     \
+    } RampBlock##S;                                                                          \
+    typedef struct {                                                                         \
+        T min_value;                                                                         \
+        T max_value;                                                                         \
+    } LimitBlock##S;                                                                         \
+    void pid_block_run##S(PIDBlock##S* blocks, size_t n, const T* SP, const T* PV, T dt,     \
+                          T* out);                                                           \
+    void first_order_block_run##S(FirstOrderBlock##S* blocks, size_t n, const T* in, T dt,   \
+                                  T* out);                                                   \
+    void ramp_block_run##S(RampBlock##S* blocks, size_t n, const T* in, T dt, T* out);       \
+    void limit_block_run##S(const LimitBlock##S* blocks, size_t n, const T* in, T* out);
+
+FB_PRECISION_DECLARE(float, _f32)
+FB_PRECISION_DECLARE(fb_q16_t, _q16)
+
+// n 个同类型、同精度的实例
+typedef struct {
+    FunctionBlockType type;   // FB_TYPE_PID / FIRST_ORDER / RAMP / LIMIT
+    FBPrecision precision;    // FB_PRECISION_F32 或 FB_PRECISION_Q16
+    size_t count;             // 实例数
+    void* blocks;             // count 个 PIDBlock_f32 / FirstOrderBlock_q16 等
+} FBPrecisionArray;
+
+/**
+ * @brief 解析精度名称
+ * @param name "f64"、"f32" 或 "q16"
+ * @param precision 输出精度
+ * @return 0 成功，-1 名称无效
+ */
+int fb_precision_parse(const char* name, FBPrecision* precision);
+
+/**
+ * @brief 获取精度名称
+ * @param precision 精度
+ * @return "f64"、"f32" 或 "q16"
+ */
+const char* fb_precision_name(FBPrecision precision);
+
+/**
+ * @brief 创建实例数组，所有实例使用相同的初始参数
+ * @param type FB_TYPE_PID / FB_TYPE_FIRST_ORDER / FB_TYPE_RAMP / FB_TYPE_LIMIT
+ * @param precision FB_PRECISION_F32 或 FB_PRECISION_Q16
+ * @param count 实例数
+ * @param params 参数：PID {Kp, Ki, Kd, output_min, output_max}，一阶惯性 {T}，
+ *               斜率限制 {rising_rate, falling_rate}，限幅 {min_value, max_value}
+ * @return 实例数组，参数无效或内存不足返回 NULL
+ */
+FBPrecisionArray* fb_precision_array_create(FunctionBlockType type, FBPrecision precision,
+                                            size_t count, const double* params);
+
+/**
+ * @brief 销毁实例数组
+ * @param array 实例数组
+ */
+void fb_precision_array_destroy(FBPrecisionArray* array);
+
+/**
+ * @brief 计算全部实例（输入转换为所选精度，输出转换回 double）
+ * @param array 实例数组
+ * @param in 输入数组（PID 为 SP）
+ * @param in2 第二个输入数组（PID 为 PV，其他类型忽略）
+ * @param dt 时间步长（秒），由调用方给出
+ * @param out 输出数组
+ * @return 0 成功，-1 失败
+ */
+int fb_precision_array_compute(FBPrecisionArray* array, const double* in, const double* in2,
+                               double dt, double* out);
+
+/**
+ * @brief 设置单个实例的参数（校验规则与 double 版本相同）
+ * @param array 实例数组
+ * @param index 实例下标
+ * @param params 参数，格式同 fb_precision_array_create()
+ * @return 0 成功，-1 下标越界或参数无效
+ */
+int fb_precision_array_set_params(FBPrecisionArray* array, size_t index, const double* params);
+
+/**
+ * @brief 读取单个实例的参数和状态（转换为 double）
+ * @param array 实例数组
+ * @param index 实例下标
+ * @param fields 输出，至少 FB_PRECISION_MAX_FIELDS 个：PID {Kp, Ki, Kd, output_min,
+ *               output_max, integral, prev_error}，一阶惯性 {T, prev_output}，
+ *               斜率限制 {rising_rate, falling_rate, output}，限幅 {min_value, max_value}
+ * @return 字段个数，下标越界返回 -1
+ */
+int fb_precision_array_get(const FBPrecisionArray* array, size_t index, double* fields);
+
+/**
+ * @brief 重置全部实例的状态
+ * @param array 实例数组
+ * @param initial_value 斜率限制的初始输出（其他类型状态清零）
+ */
+void fb_precision_array_reset(FBPrecisionArray* array, double initial_value);
+
+#endif // FB_PRECISION_H
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_precision_impl.h
+ * @brief float32 / Q16.16 实例数组实现模板（由 fb_precision.c 按精度多次包含，无包含保护）
+ *
+ * 包含前需定义：
+ *   FB_REAL      数值类型
+ *   FB_SUFFIX    后缀（_f32 / _q16）
+ *   FB_FROM(x)   double 转为 FB_REAL
+ *   FB_TO(x)     FB_REAL 转为 double
+ * 包含结束时取消以上定义。
+ */
+
+#define FB_NAME(x) FB_CAT(x, FB_SUFFIX)
+
+static inline FB_REAL FB_NAME(first_order_block_step)(FB_NAME(FirstOrderBlock)* b,
+                                                      FB_REAL input, FB_REAL dt) {
+    // alpha 只在 dt 或 T 变化时重新计算
+    if (dt != b->alpha_dt) {
+        b->alpha = FB_NAME(first_order_alpha)(b->params.T, dt);
+        b->alpha_dt = dt;
+    }
+    return FB_NAME(first_order_kernel)(&b->state, b->alpha, input);
+}
+
+static inline FB_REAL FB_NAME(ramp_block_step)(FB_NAME(RampBlock)* b, FB_REAL input, FB_REAL dt) {
+    if (dt <= (FB_REAL)0) {
+        return (FB_REAL)0;
+    }
+    // 首次调用：直接使用输入值
+    if (!b->initialized) {
+        b->output = input;
+        b->initialized = 1;
+        return input;
+    }
+    return FB_NAME(ramp_kernel)(&b->output, b->rising_rate, b->falling_rate, input, dt);
+}
+
+void FB_NAME(pid_block_run)(FB_NAME(PIDBlock)* blocks, size_t n, const FB_REAL* SP,
+                            const FB_REAL* PV, FB_REAL dt, FB_REAL* out) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = FB_NAME(pid_kernel)(&blocks[i].params, &blocks[i].state, SP[i], PV[i], dt);
+    }
+}
+
+void FB_NAME(first_order_block_run)(FB_NAME(FirstOrderBlock)* blocks, size_t n,
+                                    const FB_REAL* in, FB_REAL dt, FB_REAL* out) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = FB_NAME(first_order_block_step)(&blocks[i], in[i], dt);
+    }
+}
+
+void FB_NAME(ramp_block_run)(FB_NAME(RampBlock)* blocks, size_t n, const FB_REAL* in,
+                             FB_REAL dt, FB_REAL* out) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = FB_NAME(ramp_block_step)(&blocks[i], in[i], dt);
+    }
+}
+
+void FB_NAME(limit_block_run)(const FB_NAME(LimitBlock)* blocks, size_t n, const FB_REAL* in,
+                              FB_REAL* out) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = FB_NAME(clamp)(in[i], blocks[i].min_value, blocks[i].max_value);
+    }
+}
+
+// double 边界：逐个转换输入，计算后转换输出
+static void FB_NAME(precision_compute)(FBPrecisionArray* a, const double* in, const double* in2,
+                                       double dt, double* out) {
+    FB_REAL step = FB_FROM(dt);
+    size_t n = a->count;
+
+    switch (a->type) {
+    case FB_TYPE_PID: {
+        FB_NAME(PIDBlock)* b = (FB_NAME(PIDBlock)*)a->blocks;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = FB_TO(FB_NAME(pid_kernel)(&b[i].params, &b[i].state, FB_FROM(in[i]),
+                                               FB_FROM(in2[i]), step));
+        }
+        break;
+    }
+    case FB_TYPE_FIRST_ORDER: {
+        FB_NAME(FirstOrderBlock)* b = (FB_NAME(FirstOrderBlock)*)a->blocks;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = FB_TO(FB_NAME(first_order_block_step)(&b[i], FB_FROM(in[i]), step));
+        }
+        break;
+    }
+    case FB_TYPE_RAMP: {
+        FB_NAME(RampBlock)* b = (FB_NAME(RampBlock)*)a->blocks;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = FB_TO(FB_NAME(ramp_block_step)(&b[i], FB_FROM(in[i]), step));
+        }
+        break;
+    }
+    case FB_TYPE_LIMIT: {
+        const FB_NAME(LimitBlock)* b = (const FB_NAME(LimitBlock)*)a->blocks;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = FB_TO(FB_NAME(clamp)(FB_FROM(in[i]), b[i].min_value, b[i].max_value));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// 写入第 index 个实例的参数（参数已校验）
+static void FB_NAME(precision_set)(FBPrecisionArray* a, size_t index, const double* p) {
+    switch (a->type) {
+    case FB_TYPE_PID: {
+        FB_NAME(PIDParams)* params = &((FB_NAME(PIDBlock)*)a->blocks)[index].params;
+        params->Kp = FB_FROM(p[0]);
+        params->Ki = FB_FROM(p[1]);
+        params->Kd = FB_FROM(p[2]);
+        params->output_min = FB_FROM(p[3]);
+        params->output_max = FB_FROM(p[4]);
+        break;
+    }
+    case FB_TYPE_FIRST_ORDER: {
+        FB_NAME(FirstOrderBlock)* b = &((FB_NAME(FirstOrderBlock)*)a->blocks)[index];
+        b->params.T = FB_FROM(p[0]);
+        b->alpha_dt = (FB_REAL)0;
+        break;
+    }
+    case FB_TYPE_RAMP: {
+        FB_NAME(RampBlock)* b = &((FB_NAME(RampBlock)*)a->blocks)[index];
+        b->rising_rate = FB_FROM(p[0]);
+        b->falling_rate = FB_FROM(p[1]);
+        break;
+    }
+    case FB_TYPE_LIMIT: {
+        FB_NAME(LimitBlock)* b = &((FB_NAME(LimitBlock)*)a->blocks)[index];
+        b->min_value = FB_FROM(p[0]);
+        b->max_value = FB_FROM(p[1]);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+static int FB_NAME(precision_get)(const FBPrecisionArray* a, size_t index, double* f) {
+    switch (a->type) {
+    case FB_TYPE_PID: {
+        const FB_NAME(PIDBlock)* b = &((const FB_NAME(PIDBlock)*)a->blocks)[index];
+        f[0] = FB_TO(b->params.Kp);
+        f[1] = FB_TO(b->params.Ki);
+        f[2] = FB_TO(b->params.Kd);
+        f[3] = FB_TO(b->params.output_min);
+        f[4] = FB_TO(b->params.output_max);
+        f[5] = FB_TO(b->state.integral);
+        f[6] = FB_TO(b->state.prev_error);
+        return 7;
+    }
+    case FB_TYPE_FIRST_ORDER: {
+        const FB_NAME(FirstOrderBlock)* b = &((const FB_NAME(FirstOrderBlock)*)a->blocks)[index];
+        f[0] = FB_TO(b->params.T);
+        f[1] = FB_TO(b->state.prev_output);
+        return 2;
+    }
+    case FB_TYPE_RAMP: {
+        const FB_NAME(RampBlock)* b = &((const FB_NAME(RampBlock)*)a->blocks)[index];
+        f[0] = FB_TO(b->rising_rate);
+        f[1] = FB_TO(b->falling_rate);
+        f[2] = FB_TO(b->output);
+        return 3;
+    }
+    case FB_TYPE_LIMIT: {
+        const FB_NAME(LimitBlock)* b = &((const FB_NAME(LimitBlock)*)a->blocks)[index];
+        f[0] = FB_TO(b->min_value);
+        f[1] = FB_TO(b->max_value);
+        return 2;
+    }
+    default:
+        return -1;
+    }
+}
+
+static void FB_NAME(precision_reset)(FBPrecisionArray* a, double initial_value) {
+    for (size_t i = 0; i < a->count; i++) {
+        switch (a->type) {
+        case FB_TYPE_PID: {
+            FB_NAME(PIDState)* s = &((FB_NAME(PIDBlock)*)a->blocks)[i].state;
+            s->integral = (FB_REAL)0;
+            s->prev_error = (FB_REAL)0;
+            break;
+        }
+        case FB_TYPE_FIRST_ORDER:
+            ((FB_NAME(FirstOrderBlock)*)a->blocks)[i].state.prev_output = (FB_REAL)0;
+            break;
+        case FB_TYPE_RAMP: {
+            FB_NAME(RampBlock)* b = &((FB_NAME(RampBlock)*)a->blocks)[i];
+            b->output = FB_FROM(initial_value);
+            b->initialized = 1;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+#undef FB_NAME
+#undef FB_REAL
+#undef FB_SUFFIX
+#undef FB_FROM
+#undef FB_TO
@@ -27,7 +27,9 @@
  */
 
 #include "fb_ramp.h"
-#include <math.h>
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
 #include <string.h>
 
 int ramp_init(RampFB* fb, double rising_rate, double falling_rate) {
@@ -56,11 +58,39 @@ int ramp_init(RampFB* fb, double rising_rate, double falling_rate) {
     return 0;
 }
 
+RampFB* ramp_create(double rising_rate, double falling_rate) {
+    /* 参数验证（先于分配，避免占用槽位） */
+    if (rising_rate < 0.0 || falling_rate < 0.0) {
+        return NULL;
+    }
+
+    RampFB* fb = (RampFB*)fb_pool_alloc(FB_TYPE_RAMP);
+    if (!fb) {
+        return NULL;
+    }
+
+    ramp_init(fb, rising_rate, falling_rate);
+    if (fb_registry_register(&fb->base, NULL, NULL) == 0) {
+        fb_pool_free(FB_TYPE_RAMP, fb);
+        return NULL;
+    }
+    return fb;
+}
+
+void ramp_destroy(RampFB* fb) {
+    if (fb) {
+        fb_registry_unregister(fb->base.id);
+        fb_pool_free(FB_TYPE_RAMP, fb);
+    }
+}
+
 double ramp_compute(RampFB* fb, double input, double dt) {
     if (!fb || dt <= 0.0) {
         return 0.0;
     }
 
+    FB_TIMED(&fb->base);
+
     /* 首次调用：直接使用输入值 */
     if (!fb->initialized) {
         fb->output = input;
@@ -68,34 +98,8 @@ double ramp_compute(RampFB* fb, double input, double dt) {
         return fb->output;
     }
 
-    /* 计算误差 */
-    double error = input - fb->output;
-
-    /* 计算最大允许变化量 */
-    double max_change;
-    if (error > 0.0) {
-        /* 上升：使用上升速率 */
-        max_change = fb->rising_rate * dt;
-    } else {
-        /* 下降：使用下降速率 */
-        max_change = fb->falling_rate * dt;
-    }
-
-    /* 限制变化量 */
-    double abs_error = fabs(error);
-    if (abs_error <= max_change) {
-        /* 误差小于限制，直接使用输入值 */
-        fb->output = input;
-    } else {
-        /* 误差大于限制，按速率变化 */
-        if (error > 0.0) {
-            fb->output += max_change;
-        } else {
-            fb->output -= max_change;
-        }
-    }
-
-    return fb->output;
+    /* 按上升/下降速率限制变化量（fb_kernels.h 模板） */
+    return ramp_kernel(&fb->output, fb->rising_rate, fb->falling_rate, input, dt);
 }
 
 int ramp_set_params(RampFB* fb, double rising_rate, double falling_rate) {
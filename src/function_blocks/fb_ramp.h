@@ -57,6 +57,20 @@ typedef struct {
  */
 int ramp_init(RampFB* fb, double rising_rate, double falling_rate);
 
+/**
+ * @brief 从实例池创建 Ramp 功能块
+ * @param rising_rate 上升速率（单位/秒）
+ * @param falling_rate 下降速率（单位/秒）
+ * @return 功能块指针，参数无效或实例池已满时返回 NULL
+ */
+RampFB* ramp_create(double rising_rate, double falling_rate);
+
+/**
+ * @brief 把 Ramp 功能块归还实例池
+ * @param fb Ramp 功能块指针
+ */
+void ramp_destroy(RampFB* fb);
+
 /**
  * @brief 执行 Ramp 计算
  * @param fb Ramp 功能块指针
@@ -0,0 +1,774 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_record.c
+ * @brief 输入录制与逐周期回放实现
+ */
+
+#include "fb_record.h"
+#include "fb_common.h"
+#include "../runtime/logger.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RECORD_MAGIC "PLCRECD"
+#define RECORD_VERSION 1u
+#define RECORD_FLUSH_MS 20          // 写线程写盘间隔
+#define RECORD_MIN_BUFFER 4096
+
+// 记录标签
+enum {
+    TAG_CHANNEL = 1,
+    TAG_CYCLE = 2,
+    TAG_VALUE = 3,
+    TAG_GAP = 4,
+    TAG_END = 5
+};
+
+#define CYCLE_RECORD_SIZE (1 + sizeof(double))
+#define VALUE_RECORD_SIZE (1 + sizeof(uint16_t) + sizeof(double))
+#define GAP_RECORD_SIZE (1 + sizeof(uint32_t))
+#define CHANNEL_RECORD_SIZE(len) (1 + sizeof(uint16_t) + 2 + (len))
+
+// 文件头（64 字节）
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    double start_time;       // 打开时锁存的时钟（第一个周期之前的自动 dt 以此为准）
+    uint8_t reserved[40];
+} RecordFileHeader;
+
+_Static_assert(sizeof(RecordFileHeader) == 64, "录制文件头必须为 64 字节");
+
+// 通道
+typedef struct {
+    char name[FB_RECORD_NAME_MAX];
+    uint8_t direction;
+    uint8_t recorded;        // 回放：录制文件中是否存在
+    size_t cursor;           // 回放：本周期内下一次查找的起点
+    uint64_t stamp;          // 回放：cursor 所属的周期
+} RecordChannel;
+
+// 回放：当前周期的数值记录
+typedef struct {
+    uint16_t channel;
+    uint8_t consumed;
+    double value;
+} RecordEntry;
+
+struct FBRecorder {
+    FBRecordMode mode;
+    pthread_mutex_t lock;    // 保护通道表、环形缓冲区写端和回放游标
+
+    RecordChannel* channels;
+    size_t channel_count;
+    size_t channel_capacity;
+
+    FBClock* clock;          // 打开时所在模块的功能块时钟
+    FBClock saved_clock;     // 关闭时恢复
+
+    uint64_t cycle;
+    double cycle_time;
+    uint64_t records;
+    FBRecordDivergence divergence;
+
+    // 录制
+    int fd;
+    uint8_t* ring;
+    size_t ring_size;
+    uint64_t head;           // 写端位置（控制线程，release 发布）
+    uint64_t tail;           // 读端位置（写线程）
+    uint64_t dropped;
+    uint32_t gap_pending;    // 尚未写出 GAP 记录的丢弃数
+    uint64_t bytes;
+    int write_failed;
+    pthread_mutex_t writer_lock;
+    pthread_cond_t writer_cond;
+    pthread_t writer;
+    int writer_running;
+    int stop;
+
+    // 回放
+    uint8_t* data;
+    size_t length;
+    size_t pos;
+    RecordEntry* entries;
+    size_t entry_count;
+    size_t entry_capacity;
+    int finished;
+};
+
+// ---------------------------------------------------------------------------
+// 录制
+// ---------------------------------------------------------------------------
+
+// 追加到环形缓冲区（调用方持有 lock），空间不足返回 -1
+static int ring_put(FBRecorder* rec, const void* bytes, size_t len) {
+    uint64_t tail = __atomic_load_n(&rec->tail, __ATOMIC_ACQUIRE);
+    if (rec->ring_size - (size_t)(rec->head - tail) < len) {
+        return -1;
+    }
+
+    size_t offset = (size_t)(rec->head % rec->ring_size);
+    size_t first = rec->ring_size - offset;
+    if (first >= len) {
+        memcpy(rec->ring + offset, bytes, len);
+    } else {
+        memcpy(rec->ring + offset, bytes, first);
+        memcpy(rec->ring, (const uint8_t*)bytes + first, len - first);
+    }
+    __atomic_store_n(&rec->head, rec->head + len, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// 追加一条记录，缓冲区满时丢弃并在下次有空间时写出 GAP
+static void emit(FBRecorder* rec, const void* bytes, size_t len) {
+    if (rec->gap_pending > 0) {
+        uint8_t gap[GAP_RECORD_SIZE];
+        gap[0] = TAG_GAP;
+        memcpy(gap + 1, &rec->gap_pending, sizeof(uint32_t));
+        if (ring_put(rec, gap, sizeof(gap)) != 0) {
+            rec->dropped++;
+            if (rec->gap_pending < UINT32_MAX) {
+                rec->gap_pending++;
+            }
+            return;
+        }
+        rec->gap_pending = 0;
+    }
+
+    if (ring_put(rec, bytes, len) != 0) {
+        if (rec->dropped++ == 0) {
+            LOG_WARNING_MSG("录制缓冲区已满（%zu 字节），丢弃记录；回放将在此处停止",
+                            rec->ring_size);
+        }
+        if (rec->gap_pending < UINT32_MAX) {
+            rec->gap_pending++;
+        }
+    }
+}
+
+static int write_all(int fd, const uint8_t* bytes, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, bytes, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        bytes += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+// 把缓冲区中已发布的记录写入文件（写线程或关闭时调用）
+static void drain(FBRecorder* rec) {
+    uint64_t head = __atomic_load_n(&rec->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = rec->tail;
+    if (head == tail) {
+        return;
+    }
+
+    size_t len = (size_t)(head - tail);
+    size_t offset = (size_t)(tail % rec->ring_size);
+    size_t first = rec->ring_size - offset < len ? rec->ring_size - offset : len;
+
+    if (!rec->write_failed) {
+        if (write_all(rec->fd, rec->ring + offset, first) != 0 ||
+            write_all(rec->fd, rec->ring, len - first) != 0) {
+            LOG_ERROR_MSG("录制文件写入失败：%s，后续记录将被丢弃", strerror(errno));
+            rec->write_failed = 1;
+        } else {
+            __atomic_add_fetch(&rec->bytes, len, __ATOMIC_RELAXED);
+        }
+    }
+
+    __atomic_store_n(&rec->tail, head, __ATOMIC_RELEASE);
+}
+
+static void* writer_main(void* arg) {
+    FBRecorder* rec = (FBRecorder*)arg;
+
+    pthread_mutex_lock(&rec->writer_lock);
+    while (!rec->stop) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += RECORD_FLUSH_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&rec->writer_cond, &rec->writer_lock, &deadline);
+
+        pthread_mutex_unlock(&rec->writer_lock);
+        drain(rec);
+        pthread_mutex_lock(&rec->writer_lock);
+    }
+    pthread_mutex_unlock(&rec->writer_lock);
+
+    return NULL;
+}
+
+static int open_record(FBRecorder* rec, const char* path, size_t buffer_size) {
+    rec->ring_size = buffer_size > 0 ? buffer_size : FB_RECORD_DEFAULT_BUFFER;
+    if (rec->ring_size < RECORD_MIN_BUFFER) {
+        rec->ring_size = RECORD_MIN_BUFFER;
+    }
+    rec->ring = (uint8_t*)malloc(rec->ring_size);
+    if (!rec->ring) {
+        LOG_ERROR_MSG("录制缓冲区分配失败（%zu 字节）", rec->ring_size);
+        return -1;
+    }
+
+    rec->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (rec->fd < 0) {
+        LOG_ERROR_MSG("录制文件打开失败：%s：%s", path, strerror(errno));
+        return -1;
+    }
+
+    RecordFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC));
+    header.version = RECORD_VERSION;
+    header.header_size = sizeof(RecordFileHeader);
+    header.start_time = fb_clock_monotonic();
+    if (write_all(rec->fd, (const uint8_t*)&header, sizeof(header)) != 0) {
+        LOG_ERROR_MSG("录制文件写入失败：%s：%s", path, strerror(errno));
+        return -1;
+    }
+    rec->bytes = sizeof(header);
+    rec->cycle_time = header.start_time;
+
+    pthread_mutex_init(&rec->writer_lock, NULL);
+    pthread_cond_init(&rec->writer_cond, NULL);
+    if (pthread_create(&rec->writer, NULL, writer_main, rec) != 0) {
+        LOG_ERROR_MSG("录制写线程创建失败");
+        pthread_mutex_destroy(&rec->writer_lock);
+        pthread_cond_destroy(&rec->writer_cond);
+        return -1;
+    }
+    rec->writer_running = 1;
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// 回放
+// ---------------------------------------------------------------------------
+
+static RecordChannel* add_channel(FBRecorder* rec, const char* name, size_t len, uint8_t direction) {
+    if (rec->channel_count >= FB_RECORD_MAX_CHANNELS) {
+        LOG_ERROR_MSG("录制通道数超过上限 %d", FB_RECORD_MAX_CHANNELS);
+        return NULL;
+    }
+    if (rec->channel_count == rec->channel_capacity) {
+        size_t capacity = rec->channel_capacity ? rec->channel_capacity * 2 : 16;
+        RecordChannel* channels =
+            (RecordChannel*)realloc(rec->channels, capacity * sizeof(RecordChannel));
+        if (!channels) {
+            LOG_ERROR_MSG("录制通道表内存分配失败");
+            return NULL;
+        }
+        rec->channels = channels;
+        rec->channel_capacity = capacity;
+    }
+
+    RecordChannel* ch = &rec->channels[rec->channel_count++];
+    memset(ch, 0, sizeof(*ch));
+    memcpy(ch->name, name, len);
+    ch->name[len] = '\0';
+    ch->direction = direction;
+    return ch;
+}
+
+// 解析 pos 处的一条记录；返回记录长度，截断或无法识别时返回 0
+static size_t record_size_at(const FBRecorder* rec, size_t pos) {
+    size_t left = rec->length - pos;
+    if (left < 1) {
+        return 0;
+    }
+
+    switch (rec->data[pos]) {
+        case TAG_CYCLE:
+            return left >= CYCLE_RECORD_SIZE ? CYCLE_RECORD_SIZE : 0;
+        case TAG_VALUE:
+            return left >= VALUE_RECORD_SIZE ? VALUE_RECORD_SIZE : 0;
+        case TAG_GAP:
+            return left >= GAP_RECORD_SIZE ? GAP_RECORD_SIZE : 0;
+        case TAG_END:
+            return 1;
+        case TAG_CHANNEL:
+            if (left < CHANNEL_RECORD_SIZE(0)) {
+                return 0;
+            }
+            return left >= CHANNEL_RECORD_SIZE(rec->data[pos + 4])
+                       ? CHANNEL_RECORD_SIZE(rec->data[pos + 4])
+                       : 0;
+        default:
+            return 0;
+    }
+}
+
+// 预先读取全部通道定义，并截掉末尾不完整的记录（录制进程崩溃时）；
+// 回放在第一个缺口处停止，缺口之后的通道定义可能已丢失，不再读取
+static int scan_channels(FBRecorder* rec) {
+    size_t pos = sizeof(RecordFileHeader);
+    while (pos < rec->length && rec->data[pos] != TAG_GAP) {
+        size_t size = record_size_at(rec, pos);
+        if (size == 0) {
+            LOG_WARNING_MSG("录制文件在偏移 %zu 处截断或损坏，回放到此为止", pos);
+            rec->length = pos;
+            break;
+        }
+
+        if (rec->data[pos] == TAG_CHANNEL) {
+            uint16_t id;
+            memcpy(&id, rec->data + pos + 1, sizeof(id));
+            uint8_t direction = rec->data[pos + 3];
+            uint8_t len = rec->data[pos + 4];
+            if (id != rec->channel_count || len >= FB_RECORD_NAME_MAX ||
+                direction > FB_RECORD_OUTPUT) {
+                LOG_ERROR_MSG("录制文件通道定义无效（偏移 %zu）", pos);
+                return -1;
+            }
+            RecordChannel* ch =
+                add_channel(rec, (const char*)rec->data + pos + 5, len, direction);
+            if (!ch) {
+                return -1;
+            }
+            ch->recorded = 1;
+        }
+        pos += size;
+    }
+    return 0;
+}
+
+// 读取直到下一个 CYCLE/GAP/END/文件末尾为止的数值记录，作为当前周期
+static int load_entries(FBRecorder* rec) {
+    rec->entry_count = 0;
+    while (rec->pos < rec->length) {
+        uint8_t tag = rec->data[rec->pos];
+        if (tag == TAG_CYCLE || tag == TAG_GAP || tag == TAG_END) {
+            break;
+        }
+
+        size_t size = record_size_at(rec, rec->pos);
+        if (tag == TAG_VALUE) {
+            if (rec->entry_count == rec->entry_capacity) {
+                size_t capacity = rec->entry_capacity ? rec->entry_capacity * 2 : 64;
+                RecordEntry* entries =
+                    (RecordEntry*)realloc(rec->entries, capacity * sizeof(RecordEntry));
+                if (!entries) {
+                    LOG_ERROR_MSG("回放缓冲区内存分配失败");
+                    return -1;
+                }
+                rec->entries = entries;
+                rec->entry_capacity = capacity;
+            }
+            RecordEntry* entry = &rec->entries[rec->entry_count];
+            memcpy(&entry->channel, rec->data + rec->pos + 1, sizeof(uint16_t));
+            memcpy(&entry->value, rec->data + rec->pos + 3, sizeof(double));
+            if (entry->channel >= rec->channel_count || !rec->channels[entry->channel].recorded) {
+                LOG_ERROR_MSG("录制文件数值记录引用了未定义的通道（偏移 %zu）", rec->pos);
+                return -1;
+            }
+            entry->consumed = 0;
+            rec->entry_count++;
+            rec->records++;
+        }
+        rec->pos += size;
+    }
+    return 0;
+}
+
+static int open_replay(FBRecorder* rec, const char* path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_ERROR_MSG("录制文件打开失败：%s：%s", path, strerror(errno));
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(RecordFileHeader)) {
+        LOG_ERROR_MSG("录制文件无效：%s", path);
+        close(fd);
+        return -1;
+    }
+
+    rec->length = (size_t)st.st_size;
+    rec->data = (uint8_t*)malloc(rec->length);
+    size_t got = 0;
+    while (rec->data && got < rec->length) {
+        ssize_t n = read(fd, rec->data + got, rec->length - got);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        got += (size_t)n;
+    }
+    close(fd);
+    if (!rec->data || got != rec->length) {
+        LOG_ERROR_MSG("录制文件读取失败：%s", path);
+        return -1;
+    }
+
+    RecordFileHeader header;
+    memcpy(&header, rec->data, sizeof(header));
+    if (memcmp(header.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0 ||
+        header.version != RECORD_VERSION || header.header_size != sizeof(RecordFileHeader)) {
+        LOG_ERROR_MSG("录制文件格式或版本不匹配：%s", path);
+        return -1;
+    }
+    rec->cycle_time = header.start_time;
+
+    if (scan_channels(rec) != 0) {
+        return -1;
+    }
+
+    // 第一个周期之前（init() 中）的数值记录属于第 0 周期
+    rec->pos = sizeof(RecordFileHeader);
+    return load_entries(rec);
+}
+
+// ---------------------------------------------------------------------------
+// 公共接口
+// ---------------------------------------------------------------------------
+
+FBRecorder* fb_record_open(const char* path, FBRecordMode mode, size_t buffer_size) {
+    if (!path || !path[0]) {
+        LOG_ERROR_MSG("录制文件路径为空");
+        return NULL;
+    }
+
+    FBRecorder* rec = (FBRecorder*)calloc(1, sizeof(FBRecorder));
+    if (!rec) {
+        LOG_ERROR_MSG("录制器内存分配失败");
+        return NULL;
+    }
+    rec->mode = mode;
+    rec->fd = -1;
+    pthread_mutex_init(&rec->lock, NULL);
+
+    int rc = mode == FB_RECORD_MODE_RECORD ? open_record(rec, path, buffer_size)
+                                           : open_replay(rec, path);
+    if (rc != 0) {
+        if (rec->fd >= 0) {
+            close(rec->fd);
+        }
+        free(rec->ring);
+        free(rec->data);
+        free(rec->entries);
+        free(rec->channels);
+        pthread_mutex_destroy(&rec->lock);
+        free(rec);
+        return NULL;
+    }
+
+    // 锁存功能块时钟：此后的自动 dt 只取决于周期时间
+    rec->clock = fb_clock();
+    rec->saved_clock = *rec->clock;
+    __atomic_store(&rec->clock->now, &rec->cycle_time, __ATOMIC_RELAXED);
+    __atomic_store_n(&rec->clock->latched, 1, __ATOMIC_RELEASE);
+
+    if (mode == FB_RECORD_MODE_RECORD) {
+        LOG_INFO_MSG("开始录制：%s（缓冲区 %zu 字节）", path, rec->ring_size);
+    } else {
+        LOG_INFO_MSG("开始回放：%s（%zu 字节，%zu 个通道）", path, rec->length,
+                     rec->channel_count);
+    }
+    return rec;
+}
+
+void fb_record_close(FBRecorder* rec) {
+    if (!rec) {
+        return;
+    }
+
+    if (rec->writer_running) {
+        // 结束标记：没有该标记的录制（进程崩溃）最后一个周期可能不完整
+        uint8_t end = TAG_END;
+        pthread_mutex_lock(&rec->lock);
+        emit(rec, &end, 1);
+        pthread_mutex_unlock(&rec->lock);
+
+        pthread_mutex_lock(&rec->writer_lock);
+        rec->stop = 1;
+        pthread_cond_signal(&rec->writer_cond);
+        pthread_mutex_unlock(&rec->writer_lock);
+        pthread_join(rec->writer, NULL);
+        pthread_mutex_destroy(&rec->writer_lock);
+        pthread_cond_destroy(&rec->writer_cond);
+
+        drain(rec);
+        LOG_INFO_MSG("录制结束：%llu 个周期，%llu 条记录，%llu 字节，丢弃 %llu 条",
+                     (unsigned long long)rec->cycle, (unsigned long long)rec->records,
+                     (unsigned long long)rec->bytes, (unsigned long long)rec->dropped);
+    }
+    if (rec->fd >= 0) {
+        close(rec->fd);
+    }
+
+    __atomic_store_n(&rec->clock->latched, rec->saved_clock.latched, __ATOMIC_RELEASE);
+    __atomic_store(&rec->clock->now, &rec->saved_clock.now, __ATOMIC_RELAXED);
+
+    free(rec->ring);
+    free(rec->data);
+    free(rec->entries);
+    free(rec->channels);
+    pthread_mutex_destroy(&rec->lock);
+    free(rec);
+}
+
+FBRecordMode fb_record_mode(const FBRecorder* rec) {
+    return rec->mode;
+}
+
+// 记录第一个不一致（调用方持有 lock）
+static void diverge(FBRecorder* rec, const RecordChannel* ch, double expected, double actual) {
+    if (rec->divergence.found) {
+        return;
+    }
+
+    rec->divergence.found = 1;
+    rec->divergence.cycle = rec->cycle;
+    snprintf(rec->divergence.channel, sizeof(rec->divergence.channel), "%s", ch->name);
+    rec->divergence.expected = expected;
+    rec->divergence.actual = actual;
+}
+
+// 回放：上一周期录制了但本次没有产生的输出也算不一致
+static void check_unconsumed_outputs(FBRecorder* rec) {
+    for (size_t i = 0; i < rec->entry_count && !rec->divergence.found; i++) {
+        const RecordEntry* entry = &rec->entries[i];
+        const RecordChannel* ch = &rec->channels[entry->channel];
+        if (!entry->consumed && ch->direction == FB_RECORD_OUTPUT) {
+            diverge(rec, ch, entry->value, NAN);
+        }
+    }
+}
+
+int fb_record_begin_cycle(FBRecorder* rec, double now, double* cycle_time) {
+    if (!rec) {
+        return -1;
+    }
+
+    int rc = 0;
+    pthread_mutex_lock(&rec->lock);
+    if (rec->mode == FB_RECORD_MODE_RECORD) {
+        uint8_t record[CYCLE_RECORD_SIZE];
+        record[0] = TAG_CYCLE;
+        memcpy(record + 1, &now, sizeof(double));
+        emit(rec, record, sizeof(record));
+        rec->cycle_time = now;
+        rec->cycle++;
+    } else if (rec->finished) {
+        rc = 1;
+    } else {
+        check_unconsumed_outputs(rec);
+        if (rec->pos >= rec->length || rec->data[rec->pos] != TAG_CYCLE) {
+            rec->finished = 1;
+            rec->entry_count = 0;
+            rc = 1;
+        } else {
+            memcpy(&rec->cycle_time, rec->data + rec->pos + 1, sizeof(double));
+            rec->pos += CYCLE_RECORD_SIZE;
+            if (load_entries(rec) != 0) {
+                rec->finished = 1;
+                rc = -1;
+            } else if (rec->pos >= rec->length || rec->data[rec->pos] == TAG_GAP) {
+                // 缺口之前或未正常结束的录制末尾的周期可能不完整，不回放
+                LOG_WARNING_MSG("录制在第 %llu 周期%s，回放到此为止",
+                                (unsigned long long)rec->cycle + 1,
+                                rec->pos >= rec->length ? "处截止（录制未正常结束）"
+                                                        : "有缺口（缓冲区溢出）");
+                rec->finished = 1;
+                rec->entry_count = 0;
+                rc = 1;
+            } else {
+                rec->cycle++;
+            }
+        }
+    }
+
+    if (rc == 0) {
+        __atomic_store(&rec->clock->now, &rec->cycle_time, __ATOMIC_RELAXED);
+    }
+    if (cycle_time) {
+        *cycle_time = rec->cycle_time;
+    }
+    pthread_mutex_unlock(&rec->lock);
+    return rc;
+}
+
+int fb_record_channel(FBRecorder* rec, const char* name, FBRecordDirection direction) {
+    size_t len = name ? strlen(name) : 0;
+    if (len == 0 || len >= FB_RECORD_NAME_MAX) {
+        LOG_ERROR_MSG("录制通道名为空或过长（最多 %d 字节）", FB_RECORD_NAME_MAX - 1);
+        return -1;
+    }
+
+    pthread_mutex_lock(&rec->lock);
+    for (size_t i = 0; i < rec->channel_count; i++) {
+        if (rec->channels[i].direction == direction && strcmp(rec->channels[i].name, name) == 0) {
+            pthread_mutex_unlock(&rec->lock);
+            return (int)i;
+        }
+    }
+
+    int id = -1;
+    if (add_channel(rec, name, len, (uint8_t)direction)) {
+        id = (int)(rec->channel_count - 1);
+        if (rec->mode == FB_RECORD_MODE_RECORD) {
+            uint8_t record[CHANNEL_RECORD_SIZE(FB_RECORD_NAME_MAX)];
+            uint16_t id16 = (uint16_t)id;
+            record[0] = TAG_CHANNEL;
+            memcpy(record + 1, &id16, sizeof(id16));
+            record[3] = (uint8_t)direction;
+            record[4] = (uint8_t)len;
+            memcpy(record + 5, name, len);
+            emit(rec, record, CHANNEL_RECORD_SIZE(len));
+        } else {
+            LOG_WARNING_MSG("录制文件中没有%s通道 '%s'",
+                            direction == FB_RECORD_INPUT ? "输入" : "输出", name);
+        }
+    }
+    pthread_mutex_unlock(&rec->lock);
+    return id;
+}
+
+// 回放：在本周期中查找通道的下一条记录（调用方持有 lock）
+static RecordEntry* next_entry(FBRecorder* rec, RecordChannel* ch, int channel) {
+    if (ch->stamp != rec->cycle) {
+        ch->stamp = rec->cycle;
+        ch->cursor = 0;
+    }
+
+    for (size_t i = ch->cursor; i < rec->entry_count; i++) {
+        if (rec->entries[i].channel == channel) {
+            ch->cursor = i + 1;
+            rec->entries[i].consumed = 1;
+            return &rec->entries[i];
+        }
+    }
+    ch->cursor = rec->entry_count;
+    return NULL;
+}
+
+static void emit_value(FBRecorder* rec, int channel, double value) {
+    uint8_t record[VALUE_RECORD_SIZE];
+    uint16_t id16 = (uint16_t)channel;
+    record[0] = TAG_VALUE;
+    memcpy(record + 1, &id16, sizeof(id16));
+    memcpy(record + 3, &value, sizeof(double));
+    emit(rec, record, sizeof(record));
+    rec->records++;
+}
+
+double fb_record_input(FBRecorder* rec, int channel, double value) {
+    if (!rec || channel < 0) {
+        return value;
+    }
+
+    pthread_mutex_lock(&rec->lock);
+    if ((size_t)channel < rec->channel_count) {
+        if (rec->mode == FB_RECORD_MODE_RECORD) {
+            emit_value(rec, channel, value);
+        } else if (!rec->finished) {
+            RecordChannel* ch = &rec->channels[channel];
+            RecordEntry* entry = next_entry(rec, ch, channel);
+            if (entry) {
+                value = entry->value;
+            } else {
+                diverge(rec, ch, NAN, value);
+            }
+        }
+    }
+    pthread_mutex_unlock(&rec->lock);
+    return value;
+}
+
+static int same_value(double a, double b) {
+    return memcmp(&a, &b, sizeof(double)) == 0 || (isnan(a) && isnan(b));
+}
+
+int fb_record_output(FBRecorder* rec, int channel, double value) {
+    if (!rec || channel < 0) {
+        return 0;
+    }
+
+    int mismatch = 0;
+    pthread_mutex_lock(&rec->lock);
+    if ((size_t)channel < rec->channel_count) {
+        if (rec->mode == FB_RECORD_MODE_RECORD) {
+            emit_value(rec, channel, value);
+        } else if (!rec->finished) {
+            RecordChannel* ch = &rec->channels[channel];
+            RecordEntry* entry = next_entry(rec, ch, channel);
+            double expected = entry ? entry->value : NAN;
+            if (!entry || !same_value(expected, value)) {
+                mismatch = 1;
+                diverge(rec, ch, expected, value);
+            }
+        }
+    }
+    pthread_mutex_unlock(&rec->lock);
+    return mismatch;
+}
+
+void fb_record_get_divergence(FBRecorder* rec, FBRecordDivergence* divergence) {
+    if (!rec || !divergence) {
+        return;
+    }
+
+    pthread_mutex_lock(&rec->lock);
+    *divergence = rec->divergence;
+    pthread_mutex_unlock(&rec->lock);
+}
+
+void fb_record_get_stats(FBRecorder* rec, FBRecordStats* stats) {
+    if (!rec || !stats) {
+        return;
+    }
+
+    pthread_mutex_lock(&rec->lock);
+    stats->cycles = rec->cycle;
+    stats->records = rec->records;
+    stats->dropped = rec->dropped;
+    stats->bytes = __atomic_load_n(&rec->bytes, __ATOMIC_RELAXED);
+    stats->channels = rec->channel_count;
+    stats->finished = rec->finished;
+    pthread_mutex_unlock(&rec->lock);
+}
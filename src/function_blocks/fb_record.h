@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_record.h
+ * @brief 输入录制与逐周期回放
+ *
+ * 录制每个控制周期的周期时间、脚本声明的外部输入和需要核对的输出，
+ * 回放时按虚拟时间把同样的输入送回同一脚本和功能块，报告第一个不一致的输出。
+ *
+ * 文件布局（版本 1）：
+ *   [文件头 64 字节][记录...]
+ *   记录以 1 字节标签开头（小端，紧凑排列）：
+ *     CHANNEL  [u16 通道][u8 方向][u8 名称长度][名称]   首次使用通道时写入
+ *     CYCLE    [f64 周期时间]                             每个周期开始
+ *     VALUE    [u16 通道][f64 数值]                       输入或输出
+ *     GAP      [u32 丢弃的记录数]                         缓冲区溢出
+ *     END      （无数据）                                 正常关闭
+ *   回放在缺口或文件末尾（没有 END 时）之前的那个可能不完整的周期处停止。
+ *
+ * 确定性：
+ *   录制和回放期间功能块时钟（fb_clock()）按周期锁存，dt 为 0 的自动 dt
+ *   只取决于录制的周期时间，回放时逐位复现。
+ *
+ * 线程模型（录制）：
+ *   - 控制线程把记录追加到内存环形缓冲区（不做 I/O），缓冲区满时丢弃并计数；
+ *   - 后台写线程周期性地把缓冲区写入文件。
+ */
+
+#ifndef FB_RECORD_H
+#define FB_RECORD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FB_RECORD_NAME_MAX 64                  // 通道名最大长度（含结尾 '\0'）
+#define FB_RECORD_MAX_CHANNELS 65535           // 通道数上限
+#define FB_RECORD_DEFAULT_BUFFER (256 * 1024)  // 默认环形缓冲区大小（字节）
+
+// Python 绑定导出 FBRecorder 指针时使用的 PyCapsule 名称
+#define FB_RECORD_CAPSULE_NAME "plcopen_c.FBRecorder"
+
+typedef struct FBRecorder FBRecorder;
+
+// 工作模式
+typedef enum {
+    FB_RECORD_MODE_RECORD,   // 录制
+    FB_RECORD_MODE_REPLAY    // 回放
+} FBRecordMode;
+
+// 通道方向
+typedef enum {
+    FB_RECORD_INPUT = 0,     // 外部输入：回放时以录制值替代实时值
+    FB_RECORD_OUTPUT = 1     // 输出：回放时与录制值比较
+} FBRecordDirection;
+
+// 第一个不一致
+typedef struct {
+    int found;               // 是否发现不一致
+    uint64_t cycle;          // 周期序号（从 1 开始）
+    char channel[FB_RECORD_NAME_MAX];
+    double expected;         // 录制值（通道在该周期未录制时为 NaN）
+    double actual;           // 回放值
+} FBRecordDivergence;
+
+// 统计
+typedef struct {
+    uint64_t cycles;         // 已录制/已回放的周期数
+    uint64_t records;        // 已写入/已读取的数值记录数
+    uint64_t dropped;        // 缓冲区满丢弃的记录数（录制）
+    uint64_t bytes;          // 已写入文件的字节数（录制）
+    size_t channels;         // 通道数
+    int finished;            // 回放已到达录制结尾或缺口
+} FBRecordStats;
+
+/**
+ * @brief 打开录制文件（录制时创建/截断，回放时整体读入内存）
+ * @param path 文件路径
+ * @param mode 工作模式
+ * @param buffer_size 录制环形缓冲区大小（字节），0 表示默认值；回放时忽略
+ * @return 句柄，失败返回 NULL
+ *
+ * 打开后功能块时钟切换为锁存模式，关闭时恢复。录制时同时启动后台写线程。
+ */
+FBRecorder* fb_record_open(const char* path, FBRecordMode mode, size_t buffer_size);
+
+/**
+ * @brief 停止写线程、写出剩余记录并关闭（恢复功能块时钟）
+ * @param rec 句柄（NULL 被忽略）
+ */
+void fb_record_close(FBRecorder* rec);
+
+/**
+ * @brief 获取工作模式
+ * @param rec 句柄
+ * @return 工作模式
+ */
+FBRecordMode fb_record_mode(const FBRecorder* rec);
+
+/**
+ * @brief 开始一个周期
+ * @param rec 句柄
+ * @param now 录制：实际周期时间（秒）；回放：忽略
+ * @param cycle_time 输出本周期时间（回放时为录制值），可为 NULL
+ * @return 0 成功，1 回放已结束（到达结尾或缺口），-1 失败
+ *
+ * 同时把功能块时钟锁存为本周期时间。
+ */
+int fb_record_begin_cycle(FBRecorder* rec, double now, double* cycle_time);
+
+/**
+ * @brief 按名称取得通道（首次使用时创建），供调用方缓存
+ * @param rec 句柄
+ * @param name 通道名
+ * @param direction 通道方向
+ * @return 通道号，失败返回 -1
+ */
+int fb_record_channel(FBRecorder* rec, const char* name, FBRecordDirection direction);
+
+/**
+ * @brief 外部输入
+ * @param rec 句柄
+ * @param channel 输入通道号
+ * @param value 实时值
+ * @return 录制：value；回放：录制值（本周期未录制时返回 value 并记为不一致）
+ */
+double fb_record_input(FBRecorder* rec, int channel, double value);
+
+/**
+ * @brief 需要核对的输出
+ * @param rec 句柄
+ * @param channel 输出通道号
+ * @param value 本周期计算值
+ * @return 录制：0；回放：0 一致，1 不一致（只保留第一个不一致）
+ *
+ * 回放按位比较（两边都是 NaN 视为一致）。
+ */
+int fb_record_output(FBRecorder* rec, int channel, double value);
+
+/**
+ * @brief 获取第一个不一致
+ * @param rec 句柄
+ * @param divergence 输出
+ */
+void fb_record_get_divergence(FBRecorder* rec, FBRecordDivergence* divergence);
+
+/**
+ * @brief 获取统计信息
+ * @param rec 句柄
+ * @param stats 输出统计
+ */
+void fb_record_get_stats(FBRecorder* rec, FBRecordStats* stats);
+
+#endif // FB_RECORD_H
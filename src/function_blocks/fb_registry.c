@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_registry.c
+ * @brief 全局功能块注册表实现
+ *
+ * 条目存放在固定容量的数组中，空闲槽位用下标栈管理；ID 和名称各有一张
+ * 开放寻址（线性探测）散列表，表中存放“槽位下标 + 1”，0 表示空位。
+ * 删除时向后移位，不使用墓碑，查找长度不随登记/注销次数退化。
+ */
+
+#include "fb_registry.h"
+#include "fb_network.h"
+#include "../runtime/logger.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    FBRegistryEntry* entries;   // capacity 个条目
+    uint32_t* free_stack;       // 空闲槽位下标栈
+    size_t free_count;
+    size_t capacity;
+    uint32_t* id_index;         // ID -> 槽位 + 1
+    uint32_t* name_index;       // 名称 -> 槽位 + 1（只含已命名条目）
+    size_t mask;                // 散列表大小 - 1（大小为 2 的幂）
+} FBRegistry;
+
+static FBRegistry g_registry = {0};
+static uint32_t g_next_id = 1;  // 进程内递增，不随重新配置复位
+static pthread_mutex_t g_registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static size_t id_hash(uint32_t id) {
+    return ((size_t)id * 2654435761u) & g_registry.mask;
+}
+
+// FNV-1a
+static size_t name_hash(const char* name) {
+    uint32_t h = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)name; *p; p++) {
+        h = (h ^ *p) * 16777619u;
+    }
+    return h & g_registry.mask;
+}
+
+static size_t id_home(uint32_t slot) {
+    return id_hash(g_registry.entries[slot].id);
+}
+
+static size_t name_home(uint32_t slot) {
+    return name_hash(g_registry.entries[slot].name);
+}
+
+static void index_insert(uint32_t* table, size_t pos, uint32_t slot) {
+    while (table[pos]) {
+        pos = (pos + 1) & g_registry.mask;
+    }
+    table[pos] = slot + 1;
+}
+
+// 删除 pos 处的条目并把后续探测链向前移位
+static void index_remove(uint32_t* table, size_t pos, size_t (*home)(uint32_t)) {
+    size_t hole = pos;
+    size_t next = (pos + 1) & g_registry.mask;
+
+    while (table[next]) {
+        size_t h = home(table[next] - 1);
+        if (((next - h) & g_registry.mask) >= ((next - hole) & g_registry.mask)) {
+            table[hole] = table[next];
+            hole = next;
+        }
+        next = (next + 1) & g_registry.mask;
+    }
+    table[hole] = 0;
+}
+
+// 返回 ID 在 id_index 中的位置，未找到返回 -1
+static long find_id_pos(uint32_t id) {
+    if (!g_registry.id_index || id == 0) {
+        return -1;
+    }
+    for (size_t pos = id_hash(id); g_registry.id_index[pos]; pos = (pos + 1) & g_registry.mask) {
+        if (g_registry.entries[g_registry.id_index[pos] - 1].id == id) {
+            return (long)pos;
+        }
+    }
+    return -1;
+}
+
+static long find_name_pos(const char* name) {
+    if (!g_registry.name_index || !name || !name[0]) {
+        return -1;
+    }
+    for (size_t pos = name_hash(name); g_registry.name_index[pos];
+         pos = (pos + 1) & g_registry.mask) {
+        if (strcmp(g_registry.entries[g_registry.name_index[pos] - 1].name, name) == 0) {
+            return (long)pos;
+        }
+    }
+    return -1;
+}
+
+static FBRegistryEntry* find_entry(uint32_t id) {
+    long pos = find_id_pos(id);
+    return pos < 0 ? NULL : &g_registry.entries[g_registry.id_index[pos] - 1];
+}
+
+static void release_registry(void) {
+    free(g_registry.entries);
+    free(g_registry.free_stack);
+    free(g_registry.id_index);
+    free(g_registry.name_index);
+    memset(&g_registry, 0, sizeof(g_registry));
+}
+
+// 调用者持有 g_registry_mutex
+static int configure_locked(size_t capacity) {
+    if (capacity == 0 || capacity > UINT32_MAX / 4) {
+        LOG_ERROR_MSG("注册表容量无效：%zu", capacity);
+        return -1;
+    }
+    if (g_registry.free_count != g_registry.capacity) {
+        LOG_ERROR_MSG("注册表重新配置失败：仍有 %zu 个功能块登记",
+                      g_registry.capacity - g_registry.free_count);
+        return -1;
+    }
+
+    release_registry();
+
+    size_t table_size = 1;
+    while (table_size < capacity * 2) {
+        table_size <<= 1;
+    }
+
+    g_registry.entries = (FBRegistryEntry*)calloc(capacity, sizeof(FBRegistryEntry));
+    g_registry.free_stack = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    g_registry.id_index = (uint32_t*)calloc(table_size, sizeof(uint32_t));
+    g_registry.name_index = (uint32_t*)calloc(table_size, sizeof(uint32_t));
+    if (!g_registry.entries || !g_registry.free_stack || !g_registry.id_index ||
+        !g_registry.name_index) {
+        LOG_ERROR_MSG("注册表分配失败：容量 %zu", capacity);
+        release_registry();
+        return -1;
+    }
+
+    for (size_t i = 0; i < capacity; i++) {
+        g_registry.free_stack[i] = (uint32_t)(capacity - 1 - i);
+    }
+    g_registry.capacity = capacity;
+    g_registry.free_count = capacity;
+    g_registry.mask = table_size - 1;
+
+    LOG_INFO_MSG("功能块注册表已配置：容量 %zu", capacity);
+    return 0;
+}
+
+int fb_registry_configure(size_t capacity) {
+    pthread_mutex_lock(&g_registry_mutex);
+    int rc = configure_locked(capacity);
+    pthread_mutex_unlock(&g_registry_mutex);
+    return rc;
+}
+
+static int valid_name(const char* name) {
+    return strlen(name) < FB_REGISTRY_NAME_MAX;
+}
+
+uint32_t fb_registry_register(FunctionBlock* block, const char* name, void* owner) {
+    if (!block) {
+        return 0;
+    }
+    if (name && name[0] && !valid_name(name)) {
+        LOG_ERROR_MSG("功能块登记失败：名称过长（最多 %d 个字符）", FB_REGISTRY_NAME_MAX - 1);
+        return 0;
+    }
+
+    pthread_mutex_lock(&g_registry_mutex);
+
+    if (!g_registry.entries && configure_locked(FB_REGISTRY_DEFAULT_CAPACITY) != 0) {
+        pthread_mutex_unlock(&g_registry_mutex);
+        return 0;
+    }
+    if (g_registry.free_count == 0) {
+        size_t capacity = g_registry.capacity;
+        pthread_mutex_unlock(&g_registry_mutex);
+        LOG_ERROR_MSG("功能块登记失败：注册表已满（容量 %zu）", capacity);
+        return 0;
+    }
+    if (name && name[0] && find_name_pos(name) >= 0) {
+        pthread_mutex_unlock(&g_registry_mutex);
+        LOG_ERROR_MSG("功能块登记失败：名称 '%s' 已被使用", name);
+        return 0;
+    }
+
+    uint32_t slot = g_registry.free_stack[--g_registry.free_count];
+    FBRegistryEntry* entry = &g_registry.entries[slot];
+
+    entry->id = g_next_id++;
+    if (g_next_id == 0) {
+        g_next_id = 1;
+    }
+    entry->type = block->type;
+    entry->block = block;
+    entry->owner = owner;
+    entry->name[0] = '\0';
+    if (name && name[0]) {
+        strcpy(entry->name, name);
+        index_insert(g_registry.name_index, name_hash(name), slot);
+    }
+    index_insert(g_registry.id_index, id_hash(entry->id), slot);
+    block->id = entry->id;
+
+    uint32_t id = entry->id;
+    pthread_mutex_unlock(&g_registry_mutex);
+    return id;
+}
+
+void fb_registry_unregister(uint32_t id) {
+    pthread_mutex_lock(&g_registry_mutex);
+
+    long pos = find_id_pos(id);
+    if (pos >= 0) {
+        uint32_t slot = g_registry.id_index[pos] - 1;
+        FBRegistryEntry* entry = &g_registry.entries[slot];
+
+        long name_pos = find_name_pos(entry->name);
+        if (name_pos >= 0) {
+            index_remove(g_registry.name_index, (size_t)name_pos, name_home);
+        }
+        index_remove(g_registry.id_index, (size_t)pos, id_home);
+
+        memset(entry, 0, sizeof(*entry));
+        g_registry.free_stack[g_registry.free_count++] = slot;
+    }
+
+    pthread_mutex_unlock(&g_registry_mutex);
+}
+
+int fb_registry_set_name(uint32_t id, const char* name) {
+    if (name && name[0] && !valid_name(name)) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&g_registry_mutex);
+
+    FBRegistryEntry* entry = find_entry(id);
+    int rc = -1;
+    if (entry) {
+        long other = find_name_pos(name);
+        if (other >= 0 && &g_registry.entries[g_registry.name_index[other] - 1] != entry) {
+            pthread_mutex_unlock(&g_registry_mutex);
+            return -1;
+        }
+
+        uint32_t slot = (uint32_t)(entry - g_registry.entries);
+        long old = find_name_pos(entry->name);
+        if (old >= 0) {
+            index_remove(g_registry.name_index, (size_t)old, name_home);
+        }
+
+        entry->name[0] = '\0';
+        if (name && name[0]) {
+            strcpy(entry->name, name);
+            index_insert(g_registry.name_index, name_hash(name), slot);
+        }
+        rc = 0;
+    }
+
+    pthread_mutex_unlock(&g_registry_mutex);
+    return rc;
+}
+
+int fb_registry_set_owner(uint32_t id, void* owner) {
+    pthread_mutex_lock(&g_registry_mutex);
+    FBRegistryEntry* entry = find_entry(id);
+    if (entry) {
+        entry->owner = owner;
+    }
+    pthread_mutex_unlock(&g_registry_mutex);
+    return entry ? 0 : -1;
+}
+
+int fb_registry_find(uint32_t id, FBRegistryEntry* entry) {
+    pthread_mutex_lock(&g_registry_mutex);
+    FBRegistryEntry* found = find_entry(id);
+    if (found && entry) {
+        *entry = *found;
+    }
+    pthread_mutex_unlock(&g_registry_mutex);
+    return found ? 0 : -1;
+}
+
+int fb_registry_find_name(const char* name, FBRegistryEntry* entry) {
+    pthread_mutex_lock(&g_registry_mutex);
+    long pos = find_name_pos(name);
+    if (pos >= 0 && entry) {
+        *entry = g_registry.entries[g_registry.name_index[pos] - 1];
+    }
+    pthread_mutex_unlock(&g_registry_mutex);
+    return pos >= 0 ? 0 : -1;
+}
+
+size_t fb_registry_count(void) {
+    pthread_mutex_lock(&g_registry_mutex);
+    size_t count = g_registry.capacity - g_registry.free_count;
+    pthread_mutex_unlock(&g_registry_mutex);
+    return count;
+}
+
+size_t fb_registry_foreach(FBRegistryVisitor visitor, void* user) {
+    if (!visitor) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&g_registry_mutex);
+    size_t visited = 0;
+    for (size_t i = 0; i < g_registry.capacity; i++) {
+        if (g_registry.entries[i].id == 0) {
+            continue;
+        }
+        visited++;
+        if (visitor(&g_registry.entries[i], user) != 0) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_registry_mutex);
+    return visited;
+}
+
+int fb_registry_set_param(uint32_t id, const char* param, double value) {
+    pthread_mutex_lock(&g_registry_mutex);
+    FBRegistryEntry* entry = find_entry(id);
+    int rc = entry ? fb_network_apply_param(entry->type, entry->block, param, value) : -1;
+    pthread_mutex_unlock(&g_registry_mutex);
+    return rc == 0 ? 0 : -1;
+}
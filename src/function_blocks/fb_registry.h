@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_registry.h
+ * @brief 全局功能块注册表
+ *
+ * 所有存活的功能块实例（实例池中创建的独立功能块、已构建网络中的功能块）
+ * 在创建时登记，获得进程内唯一的 ID（从 1 递增，不复用），可选设置名称。
+ * 按 ID 或名称查找均为 O(1)（开放寻址散列表），遍历接口用于诊断、
+ * 在线改参和快照。
+ *
+ * 注册表容量在启动时固定（未配置时首次登记按默认容量初始化），
+ * 登记/注销只发生在功能块创建/销毁时，控制周期内的计算路径不访问注册表。
+ */
+
+#ifndef FB_REGISTRY_H
+#define FB_REGISTRY_H
+
+#include "fb_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define FB_REGISTRY_NAME_MAX 32             // 名称最大长度（含结尾 '\0'）
+#define FB_REGISTRY_DEFAULT_CAPACITY 8192   // 未配置时的默认容量
+
+// 注册表条目
+typedef struct {
+    uint32_t id;                      // 唯一 ID（0 表示无效）
+    FunctionBlockType type;           // 功能块类型
+    char name[FB_REGISTRY_NAME_MAX];  // 名称，空串表示未命名
+    FunctionBlock* block;             // 功能块实例（各类型均以 FunctionBlock 开头）
+    void* owner;                      // 宿主对象（如 Python 包装对象），可为 NULL
+} FBRegistryEntry;
+
+/**
+ * @brief 遍历回调
+ * @param entry 当前条目（仅在回调期间有效）
+ * @param user 用户数据
+ * @return 0 继续遍历，非 0 停止
+ *
+ * 回调在注册表锁内执行，不得再调用注册表接口。
+ */
+typedef int (*FBRegistryVisitor)(const FBRegistryEntry* entry, void* user);
+
+/**
+ * @brief 配置注册表容量并预分配存储
+ * @param capacity 最多同时登记的功能块数量
+ * @return 0 成功，-1 失败（仍有功能块登记或内存分配失败）
+ */
+int fb_registry_configure(size_t capacity);
+
+/**
+ * @brief 登记功能块并分配唯一 ID（写入 block->id）
+ * @param block 功能块实例
+ * @param name 名称，NULL 或空串表示未命名
+ * @param owner 宿主对象，可为 NULL
+ * @return 新 ID，注册表已满或名称冲突时返回 0
+ */
+uint32_t fb_registry_register(FunctionBlock* block, const char* name, void* owner);
+
+/**
+ * @brief 注销功能块
+ * @param id 功能块 ID（0 或未登记的 ID 被忽略）
+ */
+void fb_registry_unregister(uint32_t id);
+
+/**
+ * @brief 设置或清除功能块名称
+ * @param id 功能块 ID
+ * @param name 新名称，NULL 或空串表示清除
+ * @return 0 成功，-1 ID 未登记、名称过长或已被其他功能块使用
+ */
+int fb_registry_set_name(uint32_t id, const char* name);
+
+/**
+ * @brief 设置宿主对象
+ * @param id 功能块 ID
+ * @param owner 宿主对象
+ * @return 0 成功，-1 ID 未登记
+ */
+int fb_registry_set_owner(uint32_t id, void* owner);
+
+/**
+ * @brief 按 ID 查找
+ * @param id 功能块 ID
+ * @param entry 输出条目副本，可为 NULL
+ * @return 0 找到，-1 未登记
+ */
+int fb_registry_find(uint32_t id, FBRegistryEntry* entry);
+
+/**
+ * @brief 按名称查找
+ * @param name 功能块名称
+ * @param entry 输出条目副本，可为 NULL
+ * @return 0 找到，-1 未登记
+ */
+int fb_registry_find_name(const char* name, FBRegistryEntry* entry);
+
+/**
+ * @brief 当前登记的功能块数量
+ */
+size_t fb_registry_count(void);
+
+/**
+ * @brief 按登记槽位顺序遍历全部功能块
+ * @param visitor 回调
+ * @param user 用户数据
+ * @return 访问的条目数
+ */
+size_t fb_registry_foreach(FBRegistryVisitor visitor, void* user);
+
+/**
+ * @brief 在线修改已登记功能块的参数
+ * @param id 功能块 ID
+ * @param param 参数名（同构造参数，如 Kp、T、rising_rate、min_value）
+ * @param value 新值
+ * @return 0 成功，-1 ID 未登记、参数名未知或取值无效
+ *
+ * 修改在注册表锁内完成，期间功能块不会被销毁。
+ */
+int fb_registry_set_param(uint32_t id, const char* param, double value);
+
+#endif // FB_REGISTRY_H
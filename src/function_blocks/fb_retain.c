@@ -0,0 +1,635 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_retain.c
+ * @brief 保持型（RETAIN）变量检查点实现
+ */
+
+#include "fb_retain.h"
+#include "fb_pid.h"
+#include "fb_first_order.h"
+#include "fb_ramp.h"
+#include "../runtime/logger.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RETAIN_MAGIC "PLCRETN"
+#define RETAIN_VERSION 1u
+#define RETAIN_RECORD_HEADER (FB_RETAIN_KEY_MAX + 2 * sizeof(uint32_t))
+#define RETAIN_MIN_BANK_SIZE 256
+
+// 文件头（64 字节）
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t bank_size;
+    uint8_t reserved[40];
+} RetainFileHeader;
+
+// 存储区头（32 字节），checksum 覆盖 sequence/length/records 和记录数据
+typedef struct {
+    uint64_t sequence;
+    uint32_t checksum;
+    uint32_t length;
+    uint32_t records;
+    uint32_t reserved[3];
+} RetainBankHeader;
+
+_Static_assert(sizeof(RetainFileHeader) == 64, "保持文件头必须为 64 字节");
+_Static_assert(sizeof(RetainBankHeader) == 32, "存储区头必须为 32 字节");
+
+// 保持项
+typedef struct {
+    char key[FB_RETAIN_KEY_MAX];
+    uint32_t kind;           // FunctionBlockType 或 FB_RETAIN_KIND_VAR
+    uint32_t count;          // double 个数
+    double* data;            // 源数据（功能块状态字段或变量单元）
+    double* cell;            // 变量单元（由 retain 分配和释放），功能块为 NULL
+    size_t offset;           // 数值在暂存区中的偏移
+} RetainItem;
+
+struct FBRetain {
+    int fd;
+    uint8_t* map;
+    size_t map_size;
+    size_t bank_size;        // 单个存储区可容纳的记录字节数
+    uint64_t sequence;       // 最近写入（或恢复）的序号
+    int next_bank;           // 下一次写入的存储区
+
+    RetainItem* items;
+    size_t item_count;
+    size_t item_capacity;
+
+    uint8_t* staging;        // 暂存区：记录头在声明时写好，捕获时只更新数值
+    size_t used;
+    uint8_t* pending;        // 写入前的私有副本（受 io_lock 保护）
+    int dirty;
+
+    uint8_t* restore;        // 打开时读取的最近有效检查点
+    size_t restore_len;
+    int restored;
+
+    pthread_mutex_t lock;    // 保护 items/staging/dirty/stop
+    pthread_mutex_t io_lock; // 串行化存储区写入（写线程与 flush）
+    pthread_cond_t cond;
+    pthread_t writer;
+    int writer_running;
+    int stop;
+    int period_ms;
+
+    uint64_t captures;
+    uint64_t skipped;
+    uint64_t writes;
+};
+
+// CRC32（IEEE 802.3），首次使用时生成查找表
+static uint32_t g_crc_table[256];
+static pthread_once_t g_crc_once = PTHREAD_ONCE_INIT;
+
+static void crc_init(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        g_crc_table[i] = c;
+    }
+}
+
+static uint32_t crc_update(uint32_t crc, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        crc = g_crc_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static uint32_t bank_checksum(const RetainBankHeader* hdr, const uint8_t* payload) {
+    uint32_t crc = 0xFFFFFFFFu;
+    crc = crc_update(crc, &hdr->sequence, sizeof(hdr->sequence));
+    crc = crc_update(crc, &hdr->length, sizeof(hdr->length));
+    crc = crc_update(crc, &hdr->records, sizeof(hdr->records));
+    crc = crc_update(crc, payload, hdr->length);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static uint8_t* bank_at(FBRetain* retain, int bank) {
+    return retain->map + sizeof(RetainFileHeader) +
+           (size_t)bank * (sizeof(RetainBankHeader) + retain->bank_size);
+}
+
+// 各功能块类型需要保持的状态字段（连续存放的 double）
+static int block_state(FunctionBlockType type, void* block, double** data, uint32_t* count) {
+    switch (type) {
+    case FB_TYPE_PID:
+        // integral、prev_error、last_error 与变体状态 ext 连续存放，整体保持
+        _Static_assert(offsetof(PIDState, prev_error) == sizeof(double), "PIDState 必须连续存放");
+        _Static_assert(offsetof(PIDFunctionBlock, last_error) ==
+                           offsetof(PIDFunctionBlock, state) + sizeof(PIDState),
+                       "last_error 必须紧跟 state");
+        _Static_assert(offsetof(PIDFunctionBlock, ext) ==
+                               offsetof(PIDFunctionBlock, last_error) + sizeof(double) &&
+                           sizeof(PIDExtState) == 4 * sizeof(double),
+                       "ext 必须紧跟 last_error");
+        *data = &((PIDFunctionBlock*)block)->state.integral;
+        *count = 7;
+        return 0;
+    case FB_TYPE_FIRST_ORDER:
+        *data = &((FirstOrderFunctionBlock*)block)->state.prev_output;
+        *count = 1;
+        return 0;
+    case FB_TYPE_RAMP:
+        *data = &((RampFB*)block)->output;
+        *count = 1;
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+// 恢复后的修正：Ramp 从恢复的输出继续限速，而不是跳到第一个输入
+static void block_restored(FunctionBlockType type, void* block) {
+    if (type == FB_TYPE_RAMP) {
+        ((RampFB*)block)->initialized = 1;
+    } else if (type == FB_TYPE_PID) {
+        ((PIDFunctionBlock*)block)->primed = 1;  // 恢复的上一周期输入有效，不重新取基准
+    }
+}
+
+// 在恢复数据中查找记录，键、类型、个数都匹配才返回数值
+static const double* find_restored(const FBRetain* retain, const char* key, uint32_t kind,
+                                   uint32_t count) {
+    size_t pos = 0;
+    while (retain->restore && pos + RETAIN_RECORD_HEADER <= retain->restore_len) {
+        const uint8_t* record = retain->restore + pos;
+        uint32_t record_kind, record_count;
+        memcpy(&record_kind, record + FB_RETAIN_KEY_MAX, sizeof(uint32_t));
+        memcpy(&record_count, record + FB_RETAIN_KEY_MAX + sizeof(uint32_t), sizeof(uint32_t));
+
+        size_t size = RETAIN_RECORD_HEADER + (size_t)record_count * sizeof(double);
+        if (pos + size > retain->restore_len) {
+            break;
+        }
+        if (strncmp((const char*)record, key, FB_RETAIN_KEY_MAX) == 0) {
+            if (record_kind != kind || record_count != count) {
+                LOG_WARNING_MSG("保持记录 '%s' 的类型或长度已变化，不恢复", key);
+                return NULL;
+            }
+            return (const double*)(record + RETAIN_RECORD_HEADER);
+        }
+        pos += size;
+    }
+    return NULL;
+}
+
+// 读取两个存储区中 CRC 有效且序号最大的一个
+static void load_latest(FBRetain* retain) {
+    int best = -1;
+    uint64_t best_sequence = 0;
+
+    for (int bank = 0; bank < 2; bank++) {
+        const RetainBankHeader* hdr = (const RetainBankHeader*)bank_at(retain, bank);
+        if (hdr->sequence == 0 || hdr->length > retain->bank_size) {
+            continue;
+        }
+        if (bank_checksum(hdr, (const uint8_t*)(hdr + 1)) != hdr->checksum) {
+            LOG_WARNING_MSG("保持文件存储区 %c 校验失败（序号 %llu），忽略", 'A' + bank,
+                            (unsigned long long)hdr->sequence);
+            continue;
+        }
+        if (hdr->sequence > best_sequence) {
+            best = bank;
+            best_sequence = hdr->sequence;
+        }
+    }
+
+    if (best < 0) {
+        retain->next_bank = 0;
+        return;
+    }
+
+    const RetainBankHeader* hdr = (const RetainBankHeader*)bank_at(retain, best);
+    retain->restore = (uint8_t*)malloc(hdr->length ? hdr->length : 1);
+    if (!retain->restore) {
+        LOG_ERROR_MSG("保持数据读取失败：内存分配失败");
+        return;
+    }
+    memcpy(retain->restore, hdr + 1, hdr->length);
+    retain->restore_len = hdr->length;
+    retain->restored = 1;
+    retain->sequence = best_sequence;
+    retain->next_bank = 1 - best;
+
+    LOG_INFO_MSG("读取保持数据：存储区 %c，序号 %llu，%u 条记录", 'A' + best,
+                 (unsigned long long)best_sequence, hdr->records);
+}
+
+FBRetain* fb_retain_open(const char* path, size_t bank_size) {
+    if (!path || !path[0]) {
+        return NULL;
+    }
+
+    pthread_once(&g_crc_once, crc_init);
+
+    if (bank_size == 0) {
+        bank_size = FB_RETAIN_DEFAULT_SIZE;
+    }
+    if (bank_size < RETAIN_MIN_BANK_SIZE) {
+        bank_size = RETAIN_MIN_BANK_SIZE;
+    }
+    bank_size = (bank_size + 7) & ~(size_t)7;
+
+    FBRetain* retain = (FBRetain*)calloc(1, sizeof(FBRetain));
+    if (!retain) {
+        LOG_ERROR_MSG("保持文件打开失败：内存分配失败");
+        return NULL;
+    }
+    retain->fd = -1;
+    retain->bank_size = bank_size;
+    retain->map_size = sizeof(RetainFileHeader) + 2 * (sizeof(RetainBankHeader) + bank_size);
+    pthread_mutex_init(&retain->lock, NULL);
+    pthread_mutex_init(&retain->io_lock, NULL);
+    pthread_cond_init(&retain->cond, NULL);
+
+    retain->staging = (uint8_t*)calloc(1, bank_size);
+    retain->pending = (uint8_t*)malloc(bank_size);
+    if (!retain->staging || !retain->pending) {
+        LOG_ERROR_MSG("保持文件打开失败：内存分配失败");
+        goto fail;
+    }
+
+    retain->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (retain->fd < 0) {
+        LOG_ERROR_MSG("保持文件打开失败：%s：%s", path, strerror(errno));
+        goto fail;
+    }
+
+    struct stat st;
+    if (fstat(retain->fd, &st) != 0) {
+        LOG_ERROR_MSG("保持文件打开失败：%s：%s", path, strerror(errno));
+        goto fail;
+    }
+    int size_matches = (size_t)st.st_size == retain->map_size;
+    if (!size_matches && ftruncate(retain->fd, (off_t)retain->map_size) != 0) {
+        LOG_ERROR_MSG("保持文件扩展失败：%s：%s", path, strerror(errno));
+        goto fail;
+    }
+
+    void* map = mmap(NULL, retain->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, retain->fd, 0);
+    if (map == MAP_FAILED) {
+        LOG_ERROR_MSG("保持文件映射失败：%s：%s", path, strerror(errno));
+        goto fail;
+    }
+    retain->map = (uint8_t*)map;
+
+    RetainFileHeader* header = (RetainFileHeader*)retain->map;
+    int compatible = size_matches && memcmp(header->magic, RETAIN_MAGIC, sizeof(RETAIN_MAGIC)) == 0 &&
+                     header->version == RETAIN_VERSION &&
+                     header->header_size == sizeof(RetainFileHeader) &&
+                     header->bank_size == bank_size;
+
+    if (compatible) {
+        load_latest(retain);
+    } else {
+        if (st.st_size > 0) {
+            LOG_WARNING_MSG("保持文件 %s 版本或大小不一致，丢弃旧数据并重新初始化", path);
+        }
+        memset(retain->map, 0, retain->map_size);
+        memcpy(header->magic, RETAIN_MAGIC, sizeof(RETAIN_MAGIC));
+        header->version = RETAIN_VERSION;
+        header->header_size = sizeof(RetainFileHeader);
+        header->bank_size = bank_size;
+        if (msync(retain->map, retain->map_size, MS_SYNC) != 0) {
+            LOG_WARNING_MSG("保持文件初始化同步失败：%s", strerror(errno));
+        }
+    }
+
+    LOG_INFO_MSG("保持文件已打开：%s（存储区 %zu 字节，%s）", path, bank_size,
+                 retain->restored ? "已读取检查点" : "无有效检查点");
+    return retain;
+
+fail:
+    if (retain->fd >= 0) {
+        close(retain->fd);
+    }
+    free(retain->staging);
+    free(retain->pending);
+    pthread_mutex_destroy(&retain->lock);
+    pthread_mutex_destroy(&retain->io_lock);
+    pthread_cond_destroy(&retain->cond);
+    free(retain);
+    return NULL;
+}
+
+// 追加保持项（调用者持有 lock），返回 1 已恢复，0 未恢复，-1 失败
+static int add_item_locked(FBRetain* retain, const char* key, uint32_t kind, double* data,
+                           uint32_t count, double* cell) {
+    if (!key || !key[0] || strlen(key) >= FB_RETAIN_KEY_MAX) {
+        LOG_ERROR_MSG("保持项声明失败：键为空或过长（最多 %d 个字符）", FB_RETAIN_KEY_MAX - 1);
+        return -1;
+    }
+    for (size_t i = 0; i < retain->item_count; i++) {
+        if (strcmp(retain->items[i].key, key) == 0) {
+            LOG_ERROR_MSG("保持项声明失败：键 '%s' 重复", key);
+            return -1;
+        }
+    }
+
+    size_t size = RETAIN_RECORD_HEADER + (size_t)count * sizeof(double);
+    if (retain->used + size > retain->bank_size) {
+        LOG_ERROR_MSG("保持项 '%s' 声明失败：保持区空间不足（%zu/%zu 字节）", key,
+                      retain->used, retain->bank_size);
+        return -1;
+    }
+
+    if (retain->item_count == retain->item_capacity) {
+        size_t capacity = retain->item_capacity ? retain->item_capacity * 2 : 16;
+        RetainItem* items = (RetainItem*)realloc(retain->items, capacity * sizeof(RetainItem));
+        if (!items) {
+            LOG_ERROR_MSG("保持项 '%s' 声明失败：内存分配失败", key);
+            return -1;
+        }
+        retain->items = items;
+        retain->item_capacity = capacity;
+    }
+
+    RetainItem* item = &retain->items[retain->item_count++];
+    memset(item, 0, sizeof(*item));
+    strcpy(item->key, key);
+    item->kind = kind;
+    item->count = count;
+    item->data = data;
+    item->cell = cell;
+    item->offset = retain->used + RETAIN_RECORD_HEADER;
+
+    uint8_t* record = retain->staging + retain->used;
+    memset(record, 0, RETAIN_RECORD_HEADER);
+    memcpy(record, key, strlen(key));
+    memcpy(record + FB_RETAIN_KEY_MAX, &kind, sizeof(uint32_t));
+    memcpy(record + FB_RETAIN_KEY_MAX + sizeof(uint32_t), &count, sizeof(uint32_t));
+    retain->used += size;
+
+    const double* saved = find_restored(retain, key, kind, count);
+    if (saved) {
+        memcpy(data, saved, count * sizeof(double));
+    }
+    memcpy(retain->staging + item->offset, data, count * sizeof(double));
+    return saved ? 1 : 0;
+}
+
+int fb_retain_add_block(FBRetain* retain, const char* key, FunctionBlockType type, void* block) {
+    double* data;
+    uint32_t count;
+
+    if (!retain || !block) {
+        return -1;
+    }
+    if (block_state(type, block, &data, &count) != 0) {
+        LOG_ERROR_MSG("保持项 '%s' 声明失败：该类型功能块没有需要保持的状态", key ? key : "");
+        return -1;
+    }
+
+    pthread_mutex_lock(&retain->lock);
+    int rc = add_item_locked(retain, key, (uint32_t)type, data, count, NULL);
+    pthread_mutex_unlock(&retain->lock);
+
+    if (rc == 1) {
+        block_restored(type, block);
+    }
+    return rc;
+}
+
+double* fb_retain_add_var(FBRetain* retain, const char* key, double initial, int* restored) {
+    if (!retain) {
+        return NULL;
+    }
+
+    double* cell = (double*)malloc(sizeof(double));
+    if (!cell) {
+        LOG_ERROR_MSG("保持变量 '%s' 声明失败：内存分配失败", key ? key : "");
+        return NULL;
+    }
+    *cell = initial;
+
+    pthread_mutex_lock(&retain->lock);
+    int rc = add_item_locked(retain, key, FB_RETAIN_KIND_VAR, cell, 1, cell);
+    pthread_mutex_unlock(&retain->lock);
+
+    if (rc < 0) {
+        free(cell);
+        return NULL;
+    }
+    if (restored) {
+        *restored = rc;
+    }
+    return cell;
+}
+
+// 把全部保持项的当前值复制到暂存区（调用者持有 lock）
+static void capture_locked(FBRetain* retain) {
+    for (size_t i = 0; i < retain->item_count; i++) {
+        const RetainItem* item = &retain->items[i];
+        memcpy(retain->staging + item->offset, item->data, item->count * sizeof(double));
+    }
+    retain->dirty = 1;
+    retain->captures++;
+}
+
+void fb_retain_capture(FBRetain* retain) {
+    if (!retain) {
+        return;
+    }
+
+    // 写线程正在复制暂存区时跳过本次，控制线程从不等待
+    if (pthread_mutex_trylock(&retain->lock) != 0) {
+        __atomic_add_fetch(&retain->skipped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    capture_locked(retain);
+    pthread_cond_signal(&retain->cond);
+    pthread_mutex_unlock(&retain->lock);
+}
+
+// 把暂存区写入下一个存储区并 msync（调用者持有 io_lock）
+static int write_bank_locked(FBRetain* retain, int capture) {
+    pthread_mutex_lock(&retain->lock);
+    if (capture) {
+        capture_locked(retain);
+    }
+    size_t length = retain->used;
+    uint32_t records = (uint32_t)retain->item_count;
+    memcpy(retain->pending, retain->staging, length);
+    retain->dirty = 0;
+    pthread_mutex_unlock(&retain->lock);
+
+    uint8_t* bank = bank_at(retain, retain->next_bank);
+    RetainBankHeader* hdr = (RetainBankHeader*)bank;
+
+    // 先使本区失效再写数据，崩溃时另一存储区保持完整
+    hdr->sequence = 0;
+    memcpy(bank + sizeof(RetainBankHeader), retain->pending, length);
+    hdr->length = (uint32_t)length;
+    hdr->records = records;
+    hdr->sequence = retain->sequence + 1;
+    hdr->checksum = bank_checksum(hdr, bank + sizeof(RetainBankHeader));
+
+    long page = sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)bank & ~(uintptr_t)(page - 1);
+    size_t span = (uintptr_t)bank + sizeof(RetainBankHeader) + length - start;
+    if (msync((void*)start, span, MS_SYNC) != 0) {
+        LOG_ERROR_MSG("保持数据同步失败：%s", strerror(errno));
+        return -1;
+    }
+
+    retain->sequence = hdr->sequence;
+    retain->next_bank ^= 1;
+    retain->writes++;
+    return 0;
+}
+
+static void* writer_main(void* arg) {
+    FBRetain* retain = (FBRetain*)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&retain->lock);
+        while (!retain->dirty && !retain->stop) {
+            pthread_cond_wait(&retain->cond, &retain->lock);
+        }
+        int stopping = retain->stop;
+        pthread_mutex_unlock(&retain->lock);
+        if (stopping) {
+            break;
+        }
+
+        pthread_mutex_lock(&retain->io_lock);
+        write_bank_locked(retain, 0);
+        pthread_mutex_unlock(&retain->io_lock);
+
+        // 限制写盘频率：两次写入间隔不小于 period_ms
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += retain->period_ms / 1000;
+        deadline.tv_nsec += (long)(retain->period_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        pthread_mutex_lock(&retain->lock);
+        while (!retain->stop &&
+               pthread_cond_timedwait(&retain->cond, &retain->lock, &deadline) != ETIMEDOUT) {
+        }
+        pthread_mutex_unlock(&retain->lock);
+    }
+
+    return NULL;
+}
+
+int fb_retain_start(FBRetain* retain, int period_ms) {
+    if (!retain || retain->writer_running) {
+        return -1;
+    }
+
+    retain->period_ms = period_ms > 0 ? period_ms : 1;
+    retain->stop = 0;
+    if (pthread_create(&retain->writer, NULL, writer_main, retain) != 0) {
+        LOG_ERROR_MSG("保持数据写线程创建失败");
+        return -1;
+    }
+    retain->writer_running = 1;
+
+    LOG_INFO_MSG("保持数据写线程已启动：写盘间隔 %d ms", retain->period_ms);
+    return 0;
+}
+
+int fb_retain_flush(FBRetain* retain) {
+    if (!retain) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&retain->io_lock);
+    int rc = write_bank_locked(retain, 1);
+    pthread_mutex_unlock(&retain->io_lock);
+    return rc;
+}
+
+void fb_retain_get_stats(FBRetain* retain, FBRetainStats* stats) {
+    if (!retain || !stats) {
+        return;
+    }
+
+    pthread_mutex_lock(&retain->lock);
+    stats->captures = retain->captures;
+    stats->skipped = __atomic_load_n(&retain->skipped, __ATOMIC_RELAXED);
+    stats->writes = retain->writes;
+    stats->sequence = retain->sequence;
+    stats->used = retain->used;
+    stats->bank_size = retain->bank_size;
+    stats->item_count = retain->item_count;
+    stats->restored = retain->restored;
+    pthread_mutex_unlock(&retain->lock);
+}
+
+void fb_retain_close(FBRetain* retain) {
+    if (!retain) {
+        return;
+    }
+
+    if (retain->writer_running) {
+        pthread_mutex_lock(&retain->lock);
+        retain->stop = 1;
+        pthread_cond_signal(&retain->cond);
+        pthread_mutex_unlock(&retain->lock);
+        pthread_join(retain->writer, NULL);
+        retain->writer_running = 0;
+    }
+
+    // 最终检查点
+    if (retain->item_count > 0 && fb_retain_flush(retain) == 0) {
+        LOG_INFO_MSG("保持数据已保存：序号 %llu，%zu 项",
+                     (unsigned long long)retain->sequence, retain->item_count);
+    }
+
+    munmap(retain->map, retain->map_size);
+    close(retain->fd);
+    for (size_t i = 0; i < retain->item_count; i++) {
+        free(retain->items[i].cell);
+    }
+    free(retain->items);
+    free(retain->staging);
+    free(retain->pending);
+    free(retain->restore);
+    pthread_mutex_destroy(&retain->lock);
+    pthread_mutex_destroy(&retain->io_lock);
+    pthread_cond_destroy(&retain->cond);
+    free(retain);
+}
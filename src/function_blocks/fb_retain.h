@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_retain.h
+ * @brief 保持型（RETAIN）变量检查点
+ *
+ * 选定功能块的状态和声明的保持变量周期性写入内存映射文件，启动时恢复，
+ * 避免重启后积分、滤波、斜坡输出从 0 开始造成扰动。
+ *
+ * 文件布局（版本 1）：
+ *   [文件头 64 字节][存储区 A][存储区 B]
+ *   每个存储区 = [区头 32 字节：序号、CRC32、长度、记录数][记录...]
+ *   记录 = [键 32 字节][类型 u32][个数 u32][double × 个数]
+ * 两个存储区交替写入，写完一区后 msync 再写另一区；崩溃时最多丢失正在
+ * 写的那一区，恢复时取 CRC 有效且序号最大的存储区。记录按键匹配，
+ * 增删保持项不影响其余项的恢复。
+ *
+ * 线程模型：
+ *   - fb_retain_capture() 在控制线程调用，只把数据复制到内存暂存区
+ *     （trylock，写线程占用时跳过本次），不做任何 I/O；
+ *   - 后台写线程按周期把暂存区写入映射文件并 msync；
+ *   - 声明保持项（add_block/add_var）应在控制周期开始前完成。
+ */
+
+#ifndef FB_RETAIN_H
+#define FB_RETAIN_H
+
+#include "fb_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define FB_RETAIN_KEY_MAX 32                 // 键最大长度（含结尾 '\0'）
+#define FB_RETAIN_DEFAULT_SIZE (64 * 1024)   // 默认存储区大小（字节）
+#define FB_RETAIN_KIND_VAR 0x100u            // 记录类型：保持变量（其余为 FunctionBlockType）
+
+// Python 绑定导出 FBRetain 指针时使用的 PyCapsule 名称
+#define FB_RETAIN_CAPSULE_NAME "plcopen_c.FBRetain"
+
+typedef struct FBRetain FBRetain;
+
+// 检查点统计
+typedef struct {
+    uint64_t captures;       // 成功的捕获次数
+    uint64_t skipped;        // 写线程占用导致跳过的捕获次数
+    uint64_t writes;         // 完成的存储区写入次数
+    uint64_t sequence;       // 最近写入的序号
+    size_t used;             // 当前记录占用字节数
+    size_t bank_size;        // 存储区大小
+    size_t item_count;       // 保持项个数
+    int restored;            // 打开时是否找到有效数据
+} FBRetainStats;
+
+/**
+ * @brief 打开（不存在时创建）保持文件并读取最近一次有效检查点
+ * @param path 文件路径
+ * @param bank_size 单个存储区大小（字节），0 表示默认值
+ * @return 句柄，失败返回 NULL
+ *
+ * 文件头与当前版本或存储区大小不一致时丢弃旧数据并重新初始化。
+ */
+FBRetain* fb_retain_open(const char* path, size_t bank_size);
+
+/**
+ * @brief 停止写线程、写入最终检查点并关闭文件
+ * @param retain 句柄（NULL 被忽略）
+ */
+void fb_retain_close(FBRetain* retain);
+
+/**
+ * @brief 声明保持的功能块状态，检查点中有同名记录时立即恢复
+ * @param retain 句柄
+ * @param key 记录键（通常为功能块名称）
+ * @param type 功能块类型
+ * @param block 功能块实例（需在 retain 关闭前一直有效）
+ * @return 1 已恢复，0 无可恢复数据，-1 失败（键重复、类型无状态或空间不足）
+ *
+ * 保持的状态：PID 积分值和上一周期误差，FirstOrder 上一周期输出，
+ * Ramp 当前输出（恢复后从该值继续限速）；Limit 无状态。
+ */
+int fb_retain_add_block(FBRetain* retain, const char* key, FunctionBlockType type, void* block);
+
+/**
+ * @brief 声明保持变量
+ * @param retain 句柄
+ * @param key 变量名
+ * @param initial 检查点中没有该变量时的初值
+ * @param restored 输出是否从检查点恢复，可为 NULL
+ * @return 变量存储单元（读写该单元即读写变量，retain 关闭前有效），失败返回 NULL
+ */
+double* fb_retain_add_var(FBRetain* retain, const char* key, double initial, int* restored);
+
+/**
+ * @brief 捕获全部保持项的当前值（控制线程调用，无 I/O、不阻塞）
+ * @param retain 句柄
+ */
+void fb_retain_capture(FBRetain* retain);
+
+/**
+ * @brief 启动后台写线程
+ * @param retain 句柄
+ * @param period_ms 最短写盘间隔（毫秒）
+ * @return 0 成功，-1 失败
+ */
+int fb_retain_start(FBRetain* retain, int period_ms);
+
+/**
+ * @brief 捕获并同步写入一个检查点（在调用线程做 I/O，用于关闭前或手动保存）
+ * @param retain 句柄
+ * @return 0 成功，-1 失败
+ */
+int fb_retain_flush(FBRetain* retain);
+
+/**
+ * @brief 获取统计信息
+ * @param retain 句柄
+ * @param stats 输出统计
+ */
+void fb_retain_get_stats(FBRetain* retain, FBRetainStats* stats);
+
+#endif // FB_RETAIN_H
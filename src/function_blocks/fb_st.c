@@ -0,0 +1,1444 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_st.c
+ * @brief 结构化文本编译器与字节码解释器实现
+ *
+ * 递归下降解析，边解析边生成代码。出错时只记录第一个错误，此后词法分析器
+ * 只返回文件结束，各层解析函数随之自然返回，不需要逐层检查返回值。
+ */
+
+#include "fb_st.h"
+#include "../runtime/logger.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ST_INITIAL_CAPACITY 16
+#define ST_CONST_TAG 0x80000000u     // 编译期操作数：常量表下标
+#define ST_TEMP_TAG 0x40000000u      // 编译期操作数：临时单元下标
+#define ST_REF_MASK 0x3fffffffu
+#define ST_DECL_MAX 32               // 一条声明中最多的变量名个数
+#define ST_NEST_MAX 256              // 括号、函数调用、一元运算符和 IF 的最大嵌套层数
+#define ST_INT_LIMIT 9007199254740992.0  // 2^53，double 可精确表示的整数范围
+
+static const char* const OP_NAMES[ST_OP_COUNT] = {
+    "MOV", "NEG", "NOT",
+    "ADD", "SUB", "MUL", "DIV", "IDIV", "MOD", "EXPT",
+    "EQ", "NE", "LT", "LE", "GT", "GE",
+    "AND", "OR", "XOR",
+    "ABS", "SQRT", "EXP", "LN", "LOG",
+    "SIN", "COS", "TAN", "ASIN", "ACOS", "ATAN",
+    "TRUNC", "ROUND",
+    "MIN", "MAX", "LIMIT", "SEL",
+    "JMP", "JZ"
+};
+
+/*
+ * 单条指令的运算，解释器和编译期常量折叠共用，保证两者结果一致
+ * MIN / MAX / LIMIT 的比较顺序与 Python 的 min() / max() 相同
+ */
+static inline double st_apply(uint32_t op, double a, double b, double c) {
+    switch (op) {
+    case ST_OP_MOV: return a;
+    case ST_OP_NEG: return -a;
+    case ST_OP_NOT: return a == 0.0 ? 1.0 : 0.0;
+    case ST_OP_ADD: return a + b;
+    case ST_OP_SUB: return a - b;
+    case ST_OP_MUL: return a * b;
+    case ST_OP_DIV: return a / b;
+    case ST_OP_IDIV: return b == 0.0 ? 0.0 : trunc(a / b);
+    case ST_OP_MOD: return b == 0.0 ? 0.0 : fmod(a, b);
+    case ST_OP_EXPT: return pow(a, b);
+    case ST_OP_EQ: return a == b ? 1.0 : 0.0;
+    case ST_OP_NE: return a != b ? 1.0 : 0.0;
+    case ST_OP_LT: return a < b ? 1.0 : 0.0;
+    case ST_OP_LE: return a <= b ? 1.0 : 0.0;
+    case ST_OP_GT: return a > b ? 1.0 : 0.0;
+    case ST_OP_GE: return a >= b ? 1.0 : 0.0;
+    case ST_OP_AND: return (a != 0.0 && b != 0.0) ? 1.0 : 0.0;
+    case ST_OP_OR: return (a != 0.0 || b != 0.0) ? 1.0 : 0.0;
+    case ST_OP_XOR: return ((a != 0.0) != (b != 0.0)) ? 1.0 : 0.0;
+    case ST_OP_ABS: return fabs(a);
+    case ST_OP_SQRT: return sqrt(a);
+    case ST_OP_EXP: return exp(a);
+    case ST_OP_LN: return log(a);
+    case ST_OP_LOG: return log10(a);
+    case ST_OP_SIN: return sin(a);
+    case ST_OP_COS: return cos(a);
+    case ST_OP_TAN: return tan(a);
+    case ST_OP_ASIN: return asin(a);
+    case ST_OP_ACOS: return acos(a);
+    case ST_OP_ATAN: return atan(a);
+    case ST_OP_TRUNC: return trunc(a);
+    case ST_OP_ROUND: return round(a);
+    case ST_OP_MIN: return b < a ? b : a;
+    case ST_OP_MAX: return b > a ? b : a;
+    case ST_OP_LIMIT: {
+        double t = a > b ? a : b;
+        return c < t ? c : t;
+    }
+    case ST_OP_SEL: return a != 0.0 ? c : b;
+    default: return 0.0;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * 词法分析
+ * ------------------------------------------------------------------------- */
+
+typedef enum {
+    TK_EOF, TK_IDENT, TK_INT, TK_REAL,
+    TK_ASSIGN, TK_SEMI, TK_COLON, TK_COMMA, TK_LPAREN, TK_RPAREN,
+    TK_PLUS, TK_MINUS, TK_STAR, TK_POW, TK_SLASH,
+    TK_LT, TK_LE, TK_GT, TK_GE, TK_EQ, TK_NE, TK_AMP
+} TokenKind;
+
+typedef struct {
+    TokenKind kind;
+    const char* text;
+    size_t len;
+    double value;        // 数字字面量的值
+    int line;
+    int col;
+} Token;
+
+// 编译期操作数：常量在使用前不占内存单元
+typedef struct {
+    uint32_t ref;
+    STType type;
+    int is_const;
+    double value;
+} Operand;
+
+typedef struct {
+    const char* pos;
+    const char* line_start;
+    int line;
+    Token tok;
+
+    int failed;
+    char* error;
+    size_t error_size;
+
+    STVar* vars;
+    size_t var_count;
+    size_t var_capacity;
+    double* consts;
+    size_t const_count;
+    size_t const_capacity;
+    STInsn* code;
+    size_t code_count;
+    size_t code_capacity;
+    uint32_t temp_top;   // 当前语句已占用的临时单元
+    uint32_t temp_max;
+    int depth;           // 当前嵌套层数（递归下降的深度，见 nest_enter）
+} Compiler;
+
+static const char* const RESERVED[] = {
+    "PROGRAM", "END_PROGRAM", "VAR", "VAR_INPUT", "VAR_OUTPUT", "VAR_IN_OUT", "CONSTANT",
+    "END_VAR", "IF", "THEN", "ELSIF", "ELSE", "END_IF", "AND", "OR", "XOR", "NOT", "MOD",
+    "TRUE", "FALSE"
+};
+
+static const struct {
+    const char* name;
+    STType type;
+} TYPES[] = {
+    {"BOOL", ST_TYPE_BOOL},
+    {"SINT", ST_TYPE_INT}, {"INT", ST_TYPE_INT}, {"DINT", ST_TYPE_INT}, {"LINT", ST_TYPE_INT},
+    {"USINT", ST_TYPE_INT}, {"UINT", ST_TYPE_INT}, {"UDINT", ST_TYPE_INT}, {"ULINT", ST_TYPE_INT},
+    {"REAL", ST_TYPE_REAL}, {"LREAL", ST_TYPE_REAL}
+};
+
+typedef enum {
+    FN_REAL1,            // 一个数值参数，结果 REAL
+    FN_ABS,              // 一个数值参数，结果类型不变
+    FN_MINMAX,           // 两个及以上数值参数
+    FN_LIMIT,            // LIMIT(MN, IN, MX)
+    FN_SEL,              // SEL(G, IN0, IN1)
+    FN_TO_INT,           // 一个数值参数，结果 INT
+    FN_INT_TO_REAL,
+    FN_BOOL_TO_INT,
+    FN_INT_TO_BOOL
+} FunctionKind;
+
+static const struct {
+    const char* name;
+    FunctionKind kind;
+    STOp op;
+} FUNCTIONS[] = {
+    {"ABS", FN_ABS, ST_OP_ABS}, {"SQRT", FN_REAL1, ST_OP_SQRT}, {"EXP", FN_REAL1, ST_OP_EXP},
+    {"LN", FN_REAL1, ST_OP_LN}, {"LOG", FN_REAL1, ST_OP_LOG}, {"SIN", FN_REAL1, ST_OP_SIN},
+    {"COS", FN_REAL1, ST_OP_COS}, {"TAN", FN_REAL1, ST_OP_TAN}, {"ASIN", FN_REAL1, ST_OP_ASIN},
+    {"ACOS", FN_REAL1, ST_OP_ACOS}, {"ATAN", FN_REAL1, ST_OP_ATAN},
+    {"MIN", FN_MINMAX, ST_OP_MIN}, {"MAX", FN_MINMAX, ST_OP_MAX},
+    {"LIMIT", FN_LIMIT, ST_OP_LIMIT}, {"SEL", FN_SEL, ST_OP_SEL},
+    {"TRUNC", FN_TO_INT, ST_OP_TRUNC}, {"REAL_TO_INT", FN_TO_INT, ST_OP_ROUND},
+    {"INT_TO_REAL", FN_INT_TO_REAL, ST_OP_MOV}, {"BOOL_TO_INT", FN_BOOL_TO_INT, ST_OP_MOV},
+    {"INT_TO_BOOL", FN_INT_TO_BOOL, ST_OP_NE}
+};
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+// 不区分大小写比较两段文本
+static int same_name(const char* a, size_t a_len, const char* b, size_t b_len) {
+    if (a_len != b_len) {
+        return 0;
+    }
+    for (size_t i = 0; i < a_len; i++) {
+        if (toupper((unsigned char)a[i]) != toupper((unsigned char)b[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int name_equals(const char* text, size_t len, const char* name) {
+    return same_name(text, len, name, strlen(name));
+}
+
+static void fail_at(Compiler* c, int line, int col, const char* fmt, ...) {
+    if (c->failed) {
+        return;
+    }
+    c->failed = 1;
+    c->tok.kind = TK_EOF;
+
+    if (!c->error || c->error_size == 0) {
+        return;
+    }
+    int n = snprintf(c->error, c->error_size, "第 %d 行第 %d 列：", line, col);
+    if (n < 0 || (size_t)n >= c->error_size) {
+        return;
+    }
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(c->error + n, c->error_size - (size_t)n, fmt, ap);
+    va_end(ap);
+}
+
+#define FAIL_AT(c, t, ...) fail_at((c), (t).line, (t).col, __VA_ARGS__)
+#define FAIL(c, ...) fail_at((c), (c)->tok.line, (c)->tok.col, __VA_ARGS__)
+
+// 进入一层嵌套；超过 ST_NEST_MAX 时报错，避免深度嵌套的源码耗尽 C 栈。
+// 无论成败都须以 nest_leave() 配对
+static int nest_enter(Compiler* c) {
+    if (++c->depth > ST_NEST_MAX) {
+        FAIL(c, "嵌套超过 %d 层", ST_NEST_MAX);
+        return 0;
+    }
+    return 1;
+}
+
+static void nest_leave(Compiler* c) {
+    c->depth--;
+}
+
+// 当前位置的列号（按 UTF-8 字符计数，从 1 开始）
+static int column(const Compiler* c, const char* p) {
+    int col = 1;
+    for (const char* q = c->line_start; q < p; q++) {
+        if (((unsigned char)*q & 0xC0) != 0x80) {
+            col++;
+        }
+    }
+    return col;
+}
+
+static void skip_blank(Compiler* c) {
+    for (;;) {
+        const char* p = c->pos;
+        if (*p == '\n') {
+            c->line++;
+            c->line_start = ++c->pos;
+        } else if (isspace((unsigned char)*p)) {
+            c->pos++;
+        } else if (p[0] == '(' && p[1] == '*') {
+            int line = c->line, col = column(c, p);
+            c->pos += 2;
+            while (*c->pos && !(c->pos[0] == '*' && c->pos[1] == ')')) {
+                if (*c->pos++ == '\n') {
+                    c->line++;
+                    c->line_start = c->pos;
+                }
+            }
+            if (!*c->pos) {
+                fail_at(c, line, col, "注释未结束");
+                return;
+            }
+            c->pos += 2;
+        } else if (p[0] == '/' && p[1] == '/') {
+            while (*c->pos && *c->pos != '\n') {
+                c->pos++;
+            }
+        } else {
+            return;
+        }
+    }
+}
+
+static void lex_number(Compiler* c) {
+    Token* t = &c->tok;
+    char digits[64];
+    size_t n = 0;
+    const char* p = c->pos;
+    int is_real = 0;
+
+    // 整数部分（可含 '_'），后跟 '#' 时为进制前缀
+    while (isdigit((unsigned char)*p) || *p == '_') {
+        if (*p != '_' && n < sizeof(digits) - 1) {
+            digits[n++] = *p;
+        }
+        p++;
+    }
+    if (*p == '#') {
+        digits[n] = '\0';
+        long base = strtol(digits, NULL, 10);
+        if (base != 2 && base != 8 && base != 16) {
+            FAIL(c, "不支持的进制 %ld（只支持 2、8、16）", base);
+            return;
+        }
+        p++;
+        double value = 0.0;
+        int any = 0;
+        for (;; p++) {
+            int d;
+            if (*p == '_') {
+                continue;
+            } else if (isdigit((unsigned char)*p)) {
+                d = *p - '0';
+            } else if (isxdigit((unsigned char)*p)) {
+                d = toupper((unsigned char)*p) - 'A' + 10;
+            } else {
+                break;
+            }
+            if (d >= base) {
+                break;
+            }
+            value = value * (double)base + (double)d;
+            any = 1;
+        }
+        if (!any || value > ST_INT_LIMIT) {
+            FAIL(c, any ? "整数字面量超出范围" : "进制字面量缺少数字");
+            return;
+        }
+        t->kind = TK_INT;
+        t->value = value;
+        t->len = (size_t)(p - t->text);
+        c->pos = p;
+        return;
+    }
+
+    if (p[0] == '.' && isdigit((unsigned char)p[1])) {
+        is_real = 1;
+        while (*p == '.' || isdigit((unsigned char)*p) || *p == '_') {
+            if (*p != '_' && n < sizeof(digits) - 1) {
+                digits[n++] = *p;
+            }
+            p++;
+        }
+    }
+    if ((*p == 'e' || *p == 'E') &&
+        (isdigit((unsigned char)p[1]) ||
+         ((p[1] == '+' || p[1] == '-') && isdigit((unsigned char)p[2])))) {
+        is_real = 1;
+        while (n < sizeof(digits) - 1 &&
+               (isdigit((unsigned char)*p) || *p == 'e' || *p == 'E' ||
+                ((*p == '+' || *p == '-') && (p[-1] == 'e' || p[-1] == 'E')))) {
+            digits[n++] = *p++;
+        }
+    }
+    if (n >= sizeof(digits) - 1) {
+        FAIL(c, "数字字面量过长");
+        return;
+    }
+    digits[n] = '\0';
+
+    t->kind = is_real ? TK_REAL : TK_INT;
+    t->value = strtod(digits, NULL);
+    t->len = (size_t)(p - t->text);
+    c->pos = p;
+    if (!is_real && t->value > ST_INT_LIMIT) {
+        FAIL(c, "整数字面量超出范围");
+    }
+}
+
+static void next(Compiler* c) {
+    if (c->failed) {
+        return;
+    }
+    skip_blank(c);
+    if (c->failed) {
+        return;
+    }
+
+    Token* t = &c->tok;
+    const char* p = c->pos;
+    t->text = p;
+    t->line = c->line;
+    t->col = column(c, p);
+    t->len = 1;
+
+    if (!*p) {
+        t->kind = TK_EOF;
+        t->len = 0;
+        return;
+    }
+    if (isalpha((unsigned char)*p) || *p == '_') {
+        while (isalnum((unsigned char)*p) || *p == '_') {
+            p++;
+        }
+        t->kind = TK_IDENT;
+        t->len = (size_t)(p - t->text);
+        c->pos = p;
+        return;
+    }
+    if (isdigit((unsigned char)*p)) {
+        lex_number(c);
+        return;
+    }
+
+    switch (*p) {
+    case ':':
+        t->kind = p[1] == '=' ? TK_ASSIGN : TK_COLON;
+        break;
+    case ';': t->kind = TK_SEMI; break;
+    case ',': t->kind = TK_COMMA; break;
+    case '(': t->kind = TK_LPAREN; break;
+    case ')': t->kind = TK_RPAREN; break;
+    case '+': t->kind = TK_PLUS; break;
+    case '-': t->kind = TK_MINUS; break;
+    case '*':
+        t->kind = p[1] == '*' ? TK_POW : TK_STAR;
+        break;
+    case '/': t->kind = TK_SLASH; break;
+    case '<':
+        t->kind = p[1] == '=' ? TK_LE : p[1] == '>' ? TK_NE : TK_LT;
+        break;
+    case '>':
+        t->kind = p[1] == '=' ? TK_GE : TK_GT;
+        break;
+    case '=': t->kind = TK_EQ; break;
+    case '&': t->kind = TK_AMP; break;
+    default:
+        if ((unsigned char)*p >= 0x80) {
+            FAIL(c, "无法识别的字符");
+        } else {
+            FAIL(c, "无法识别的字符 '%c'", *p);
+        }
+        return;
+    }
+    if (t->kind == TK_ASSIGN || t->kind == TK_POW || t->kind == TK_LE ||
+        t->kind == TK_NE || t->kind == TK_GE) {
+        t->len = 2;
+    }
+    c->pos = p + t->len;
+}
+
+static int is_kw(const Compiler* c, const char* keyword) {
+    return c->tok.kind == TK_IDENT && name_equals(c->tok.text, c->tok.len, keyword);
+}
+
+static int is_reserved(const char* text, size_t len) {
+    for (size_t i = 0; i < COUNT_OF(RESERVED); i++) {
+        if (name_equals(text, len, RESERVED[i])) {
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < COUNT_OF(TYPES); i++) {
+        if (name_equals(text, len, TYPES[i].name)) {
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < COUNT_OF(FUNCTIONS); i++) {
+        if (name_equals(text, len, FUNCTIONS[i].name)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 当前记号描述（错误信息用）
+static void describe(const Token* t, char* buf, size_t size) {
+    if (t->kind == TK_EOF) {
+        snprintf(buf, size, "文件结束");
+    } else {
+        snprintf(buf, size, "'%.*s'", (int)(t->len < 40 ? t->len : 40), t->text);
+    }
+}
+
+static void expect(Compiler* c, TokenKind kind, const char* what) {
+    if (c->tok.kind != kind) {
+        char got[64];
+        describe(&c->tok, got, sizeof(got));
+        FAIL(c, "此处需要 %s，遇到 %s", what, got);
+        return;
+    }
+    next(c);
+}
+
+static void expect_kw(Compiler* c, const char* keyword) {
+    if (!is_kw(c, keyword)) {
+        char got[64];
+        describe(&c->tok, got, sizeof(got));
+        FAIL(c, "此处需要 %s，遇到 %s", keyword, got);
+        return;
+    }
+    next(c);
+}
+
+/* ---------------------------------------------------------------------------
+ * 代码生成
+ * ------------------------------------------------------------------------- */
+
+static int grow(Compiler* c, void** items, size_t* capacity, size_t needed, size_t item_size) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+
+    size_t new_capacity = *capacity ? *capacity * 2 : ST_INITIAL_CAPACITY;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    void* grown = realloc(*items, new_capacity * item_size);
+    if (!grown) {
+        FAIL(c, "内存分配失败");
+        return -1;
+    }
+
+    *items = grown;
+    *capacity = new_capacity;
+    return 0;
+}
+
+static size_t emit(Compiler* c, STOp op, uint32_t d, uint32_t a, uint32_t b, uint32_t cc) {
+    if (c->failed ||
+        grow(c, (void**)&c->code, &c->code_capacity, c->code_count + 1, sizeof(STInsn)) != 0) {
+        return 0;
+    }
+
+    STInsn* insn = &c->code[c->code_count];
+    insn->op = (uint32_t)op;
+    insn->d = d;
+    insn->a = a;
+    insn->b = b;
+    insn->c = cc;
+    return c->code_count++;
+}
+
+static uint32_t const_ref(Compiler* c, double value) {
+    for (size_t i = 0; i < c->const_count; i++) {
+        if (memcmp(&c->consts[i], &value, sizeof(double)) == 0) {
+            return ST_CONST_TAG | (uint32_t)i;
+        }
+    }
+    if (grow(c, (void**)&c->consts, &c->const_capacity, c->const_count + 1,
+             sizeof(double)) != 0) {
+        return 0;
+    }
+    c->consts[c->const_count] = value;
+    return ST_CONST_TAG | (uint32_t)c->const_count++;
+}
+
+static void materialize(Compiler* c, Operand* o) {
+    if (o->is_const) {
+        o->ref = const_ref(c, o->value);
+    }
+}
+
+// 临时单元按栈分配：操作数用完后若位于栈顶即释放
+static void release(Compiler* c, const Operand* o) {
+    if (!o->is_const && (o->ref & ST_TEMP_TAG) && (o->ref & ST_REF_MASK) + 1 == c->temp_top) {
+        c->temp_top--;
+    }
+}
+
+static Operand constant(STType type, double value) {
+    Operand o = {0, type, 1, value};
+    return o;
+}
+
+// 生成一条运算指令；操作数全为常量时在编译期求值
+static Operand apply(Compiler* c, STOp op, STType type, Operand* args, int argc) {
+    double v[3] = {0.0, 0.0, 0.0};
+    uint32_t ref[3] = {0, 0, 0};
+    int folded = 1;
+
+    for (int i = 0; i < argc; i++) {
+        folded = folded && args[i].is_const;
+        v[i] = args[i].value;
+    }
+    if (folded) {
+        return constant(type, st_apply(op, v[0], v[1], v[2]));
+    }
+
+    for (int i = 0; i < argc; i++) {
+        materialize(c, &args[i]);
+        ref[i] = args[i].ref;
+    }
+    for (int i = argc; i-- > 0;) {
+        release(c, &args[i]);
+    }
+
+    Operand r = {ST_TEMP_TAG | c->temp_top++, type, 0, 0.0};
+    if (c->temp_top > c->temp_max) {
+        c->temp_max = c->temp_top;
+    }
+    emit(c, op, r.ref, ref[0], ref[1], ref[2]);
+    return r;
+}
+
+static const char* type_name(STType type) {
+    return type == ST_TYPE_BOOL ? "BOOL" : type == ST_TYPE_INT ? "INT" : "REAL";
+}
+
+static int64_t find_var(const Compiler* c, const char* text, size_t len) {
+    for (size_t i = 0; i < c->var_count; i++) {
+        if (name_equals(text, len, c->vars[i].name)) {
+            return (int64_t)i;
+        }
+    }
+    return -1;
+}
+
+/* ---------------------------------------------------------------------------
+ * 表达式
+ * ------------------------------------------------------------------------- */
+
+typedef enum {
+    BIN_OR, BIN_XOR, BIN_AND, BIN_EQ, BIN_NE, BIN_LT, BIN_LE, BIN_GT, BIN_GE,
+    BIN_ADD, BIN_SUB, BIN_MUL, BIN_DIV, BIN_MOD, BIN_POW
+} BinaryOp;
+
+static const char* const BIN_NAMES[] = {
+    "OR", "XOR", "AND", "=", "<>", "<", "<=", ">", ">=", "+", "-", "*", "/", "MOD", "**"
+};
+static const STOp BIN_OPS[] = {
+    ST_OP_OR, ST_OP_XOR, ST_OP_AND, ST_OP_EQ, ST_OP_NE, ST_OP_LT, ST_OP_LE, ST_OP_GT, ST_OP_GE,
+    ST_OP_ADD, ST_OP_SUB, ST_OP_MUL, ST_OP_DIV, ST_OP_MOD, ST_OP_EXPT
+};
+
+static Operand parse_expr(Compiler* c);
+
+static Operand binary(Compiler* c, const Token* at, BinaryOp bop, Operand a, Operand b) {
+    Operand args[2] = {a, b};
+    STOp op = BIN_OPS[bop];
+    STType type = ST_TYPE_BOOL;
+    int numeric = a.type != ST_TYPE_BOOL && b.type != ST_TYPE_BOOL;
+    int both_int = a.type == ST_TYPE_INT && b.type == ST_TYPE_INT;
+
+    switch (bop) {
+    case BIN_OR:
+    case BIN_XOR:
+    case BIN_AND:
+        if (a.type != ST_TYPE_BOOL || b.type != ST_TYPE_BOOL) {
+            FAIL_AT(c, *at, "%s 的操作数必须是 BOOL", BIN_NAMES[bop]);
+        }
+        break;
+    case BIN_EQ:
+    case BIN_NE:
+        if (!numeric && a.type != b.type) {
+            FAIL_AT(c, *at, "%s 两侧类型不匹配：%s 与 %s", BIN_NAMES[bop],
+                    type_name(a.type), type_name(b.type));
+        }
+        break;
+    case BIN_MOD:
+        if (!both_int) {
+            FAIL_AT(c, *at, "MOD 的操作数必须是整数");
+        }
+        type = ST_TYPE_INT;
+        break;
+    default:
+        if (!numeric) {
+            FAIL_AT(c, *at, "%s 的操作数必须是数值", BIN_NAMES[bop]);
+        }
+        if (bop >= BIN_LT && bop <= BIN_GE) {
+            type = ST_TYPE_BOOL;
+        } else if (bop == BIN_POW) {
+            type = ST_TYPE_REAL;
+        } else if (bop == BIN_DIV && both_int) {
+            op = ST_OP_IDIV;
+            type = ST_TYPE_INT;
+        } else {
+            type = both_int ? ST_TYPE_INT : ST_TYPE_REAL;
+        }
+        break;
+    }
+    return apply(c, op, type, args, 2);
+}
+
+// 检查 value 能否赋给 target 类型（INT 可隐式转为 REAL，其余必须相同）
+static void check_assignable(Compiler* c, const Token* at, STType target, STType value,
+                             const char* name) {
+    if (target == value || (target == ST_TYPE_REAL && value == ST_TYPE_INT)) {
+        return;
+    }
+    if (target == ST_TYPE_INT && value == ST_TYPE_REAL) {
+        FAIL_AT(c, *at, "REAL 不能直接赋给整数变量 '%s'，请使用 TRUNC 或 REAL_TO_INT", name);
+    } else {
+        FAIL_AT(c, *at, "类型不匹配：%s 不能赋给 %s 变量 '%s'", type_name(value),
+                type_name(target), name);
+    }
+}
+
+static Operand parse_call(Compiler* c, size_t fn, const Token* name) {
+    const char* fname = FUNCTIONS[fn].name;
+    FunctionKind kind = FUNCTIONS[fn].kind;
+    STOp op = FUNCTIONS[fn].op;
+    Operand args[3];
+    int argc = 0;
+    int all_int = 1;
+
+    next(c);
+    expect(c, TK_LPAREN, "'('");
+    if (c->tok.kind != TK_RPAREN) {
+        for (;;) {
+            Operand a = parse_expr(c);
+            if (kind != FN_SEL || argc > 0) {
+                all_int = all_int && a.type == ST_TYPE_INT;
+            }
+            if (argc < 3) {
+                args[argc] = a;
+            }
+            argc++;
+            if (c->tok.kind != TK_COMMA) {
+                break;
+            }
+            next(c);
+            if (kind == FN_MINMAX && argc == 2) {
+                // 多参数 MIN / MAX 逐个合并，不需要保存全部参数
+                if (args[0].type == ST_TYPE_BOOL || args[1].type == ST_TYPE_BOOL) {
+                    FAIL_AT(c, *name, "%s 的参数必须是数值", fname);
+                }
+                STType type = (args[0].type == ST_TYPE_INT && args[1].type == ST_TYPE_INT)
+                                  ? ST_TYPE_INT : ST_TYPE_REAL;
+                args[0] = apply(c, op, type, args, 2);
+                argc = 1;
+            }
+        }
+    }
+    expect(c, TK_RPAREN, "')'");
+    if (c->failed) {
+        return constant(ST_TYPE_REAL, 0.0);
+    }
+
+    int wanted = kind == FN_MINMAX ? 2 : (kind == FN_LIMIT || kind == FN_SEL) ? 3 : 1;
+    if (kind == FN_MINMAX ? argc < 2 : argc != wanted) {
+        FAIL_AT(c, *name, "函数 %s 需要%s %d 个参数", fname,
+                kind == FN_MINMAX ? "至少" : "", wanted);
+        return constant(ST_TYPE_REAL, 0.0);
+    }
+
+    switch (kind) {
+    case FN_SEL:
+        if (args[0].type != ST_TYPE_BOOL) {
+            FAIL_AT(c, *name, "SEL 的第一个参数必须是 BOOL");
+        } else if ((args[1].type == ST_TYPE_BOOL) != (args[2].type == ST_TYPE_BOOL)) {
+            FAIL_AT(c, *name, "SEL 的两个候选值类型不匹配");
+        }
+        return apply(c, op, args[1].type == ST_TYPE_BOOL ? ST_TYPE_BOOL
+                            : all_int ? ST_TYPE_INT : ST_TYPE_REAL, args, 3);
+    case FN_INT_TO_REAL:
+    case FN_INT_TO_BOOL:
+        if (args[0].type != ST_TYPE_INT) {
+            FAIL_AT(c, *name, "%s 的参数必须是整数", fname);
+        }
+        break;
+    case FN_BOOL_TO_INT:
+        if (args[0].type != ST_TYPE_BOOL) {
+            FAIL_AT(c, *name, "%s 的参数必须是 BOOL", fname);
+        }
+        break;
+    default:
+        for (int i = 0; i < argc && i < 3; i++) {
+            if (args[i].type == ST_TYPE_BOOL) {
+                FAIL_AT(c, *name, "%s 的参数必须是数值", fname);
+            }
+        }
+        break;
+    }
+
+    switch (kind) {
+    case FN_REAL1:
+        return apply(c, op, ST_TYPE_REAL, args, 1);
+    case FN_ABS:
+        return apply(c, op, args[0].type, args, 1);
+    case FN_MINMAX:
+        // 前面已合并到剩两个参数
+        return apply(c, op, all_int ? ST_TYPE_INT : ST_TYPE_REAL, args, 2);
+    case FN_LIMIT:
+        return apply(c, op, all_int ? ST_TYPE_INT : ST_TYPE_REAL, args, 3);
+    case FN_TO_INT:
+        return apply(c, op, ST_TYPE_INT, args, 1);
+    case FN_INT_TO_BOOL: {
+        Operand pair[2] = {args[0], constant(ST_TYPE_INT, 0.0)};
+        return apply(c, op, ST_TYPE_BOOL, pair, 2);
+    }
+    default:
+        // INT_TO_REAL / BOOL_TO_INT 的存储表示不变，只改类型
+        args[0].type = kind == FN_INT_TO_REAL ? ST_TYPE_REAL : ST_TYPE_INT;
+        return args[0];
+    }
+}
+
+static Operand parse_primary_body(Compiler* c) {
+    Token t = c->tok;
+
+    switch (t.kind) {
+    case TK_INT:
+    case TK_REAL:
+        next(c);
+        return constant(t.kind == TK_INT ? ST_TYPE_INT : ST_TYPE_REAL, t.value);
+    case TK_LPAREN: {
+        next(c);
+        Operand o = parse_expr(c);
+        expect(c, TK_RPAREN, "')'");
+        return o;
+    }
+    case TK_IDENT:
+        if (is_kw(c, "TRUE") || is_kw(c, "FALSE")) {
+            next(c);
+            return constant(ST_TYPE_BOOL, name_equals(t.text, t.len, "TRUE") ? 1.0 : 0.0);
+        }
+        for (size_t i = 0; i < COUNT_OF(FUNCTIONS); i++) {
+            if (name_equals(t.text, t.len, FUNCTIONS[i].name)) {
+                return parse_call(c, i, &t);
+            }
+        }
+        if (!is_reserved(t.text, t.len)) {
+            int64_t index = find_var(c, t.text, t.len);
+            if (index < 0) {
+                FAIL(c, "未声明的变量 '%.*s'", (int)t.len, t.text);
+                break;
+            }
+            next(c);
+            const STVar* var = &c->vars[index];
+            if (var->kind == ST_VAR_CONSTANT) {
+                return constant(var->type, var->init);
+            }
+            Operand o = {(uint32_t)index, var->type, 0, 0.0};
+            return o;
+        }
+        /* fall through */
+    default: {
+        char got[64];
+        describe(&t, got, sizeof(got));
+        FAIL(c, "此处需要表达式，遇到 %s", got);
+        break;
+    }
+    }
+    return constant(ST_TYPE_REAL, 0.0);
+}
+
+// 括号和函数调用经 parse_expr() 递归，每层计入嵌套深度
+static Operand parse_primary(Compiler* c) {
+    Operand o = constant(ST_TYPE_REAL, 0.0);
+    if (nest_enter(c)) {
+        o = parse_primary_body(c);
+    }
+    nest_leave(c);
+    return o;
+}
+
+static Operand parse_unary(Compiler* c);
+
+// 连续的一元运算符（如 - - - x）逐层计入嵌套深度
+static Operand parse_unary_operand(Compiler* c) {
+    Operand o = constant(ST_TYPE_REAL, 0.0);
+    if (nest_enter(c)) {
+        o = parse_unary(c);
+    }
+    nest_leave(c);
+    return o;
+}
+
+static Operand parse_unary(Compiler* c) {
+    Token t = c->tok;
+    if (t.kind == TK_MINUS) {
+        next(c);
+        Operand a = parse_unary_operand(c);
+        if (a.type == ST_TYPE_BOOL) {
+            FAIL_AT(c, t, "一元 - 的操作数必须是数值");
+        }
+        return apply(c, ST_OP_NEG, a.type, &a, 1);
+    }
+    if (is_kw(c, "NOT")) {
+        next(c);
+        Operand a = parse_unary_operand(c);
+        if (a.type != ST_TYPE_BOOL) {
+            FAIL_AT(c, t, "NOT 的操作数必须是 BOOL");
+        }
+        return apply(c, ST_OP_NOT, ST_TYPE_BOOL, &a, 1);
+    }
+    return parse_primary(c);
+}
+
+static Operand parse_power(Compiler* c) {
+    Operand a = parse_unary(c);
+    while (c->tok.kind == TK_POW) {
+        Token t = c->tok;
+        next(c);
+        a = binary(c, &t, BIN_POW, a, parse_unary(c));
+    }
+    return a;
+}
+
+static Operand parse_term(Compiler* c) {
+    Operand a = parse_power(c);
+    for (;;) {
+        Token t = c->tok;
+        BinaryOp op;
+        if (t.kind == TK_STAR) {
+            op = BIN_MUL;
+        } else if (t.kind == TK_SLASH) {
+            op = BIN_DIV;
+        } else if (is_kw(c, "MOD")) {
+            op = BIN_MOD;
+        } else {
+            return a;
+        }
+        next(c);
+        a = binary(c, &t, op, a, parse_power(c));
+    }
+}
+
+static Operand parse_sum(Compiler* c) {
+    Operand a = parse_term(c);
+    while (c->tok.kind == TK_PLUS || c->tok.kind == TK_MINUS) {
+        Token t = c->tok;
+        next(c);
+        a = binary(c, &t, t.kind == TK_PLUS ? BIN_ADD : BIN_SUB, a, parse_term(c));
+    }
+    return a;
+}
+
+static Operand parse_comparison(Compiler* c) {
+    Operand a = parse_sum(c);
+    for (;;) {
+        Token t = c->tok;
+        BinaryOp op;
+        switch (t.kind) {
+        case TK_LT: op = BIN_LT; break;
+        case TK_LE: op = BIN_LE; break;
+        case TK_GT: op = BIN_GT; break;
+        case TK_GE: op = BIN_GE; break;
+        default: return a;
+        }
+        next(c);
+        a = binary(c, &t, op, a, parse_sum(c));
+    }
+}
+
+static Operand parse_equality(Compiler* c) {
+    Operand a = parse_comparison(c);
+    while (c->tok.kind == TK_EQ || c->tok.kind == TK_NE) {
+        Token t = c->tok;
+        next(c);
+        a = binary(c, &t, t.kind == TK_EQ ? BIN_EQ : BIN_NE, a, parse_comparison(c));
+    }
+    return a;
+}
+
+static Operand parse_and(Compiler* c) {
+    Operand a = parse_equality(c);
+    while (c->tok.kind == TK_AMP || is_kw(c, "AND")) {
+        Token t = c->tok;
+        next(c);
+        a = binary(c, &t, BIN_AND, a, parse_equality(c));
+    }
+    return a;
+}
+
+static Operand parse_xor(Compiler* c) {
+    Operand a = parse_and(c);
+    while (is_kw(c, "XOR")) {
+        Token t = c->tok;
+        next(c);
+        a = binary(c, &t, BIN_XOR, a, parse_and(c));
+    }
+    return a;
+}
+
+static Operand parse_expr(Compiler* c) {
+    Operand a = parse_xor(c);
+    while (is_kw(c, "OR")) {
+        Token t = c->tok;
+        next(c);
+        a = binary(c, &t, BIN_OR, a, parse_xor(c));
+    }
+    return a;
+}
+
+/* ---------------------------------------------------------------------------
+ * 语句与声明
+ * ------------------------------------------------------------------------- */
+
+static void parse_statement_list(Compiler* c);
+
+static int at_block_end(const Compiler* c) {
+    return c->tok.kind == TK_EOF || is_kw(c, "END_PROGRAM") || is_kw(c, "ELSIF") ||
+           is_kw(c, "ELSE") || is_kw(c, "END_IF");
+}
+
+static void parse_assignment(Compiler* c) {
+    Token t = c->tok;
+    int64_t index = find_var(c, t.text, t.len);
+    if (index < 0) {
+        FAIL(c, "未声明的变量 '%.*s'", (int)t.len, t.text);
+        return;
+    }
+    const STVar* var = &c->vars[index];
+    if (var->kind == ST_VAR_INPUT || var->kind == ST_VAR_CONSTANT) {
+        FAIL(c, "不能给%s '%s' 赋值", var->kind == ST_VAR_INPUT ? "输入变量" : "常量",
+             var->name);
+        return;
+    }
+    next(c);
+    expect(c, TK_ASSIGN, "':='");
+
+    Token at = c->tok;
+    size_t start = c->code_count;
+    c->temp_top = 0;
+    Operand value = parse_expr(c);
+    check_assignable(c, &at, var->type, value.type, var->name);
+    expect(c, TK_SEMI, "';'");
+    if (c->failed) {
+        return;
+    }
+
+    // 结果是本语句最后一条指令写入的临时单元时，直接改写该指令的目标
+    uint32_t d = (uint32_t)index;
+    if (!value.is_const && (value.ref & ST_TEMP_TAG) && c->code_count > start &&
+        c->code[c->code_count - 1].d == value.ref) {
+        c->code[c->code_count - 1].d = d;
+    } else if (value.is_const || value.ref != d) {
+        materialize(c, &value);
+        emit(c, ST_OP_MOV, d, value.ref, 0, 0);
+    }
+}
+
+/*
+ * IF / ELSIF / ELSE / END_IF
+ * 条件为常量的分支在编译期裁剪：恒假分支和恒真分支之后的分支只做检查，不保留代码
+ */
+static void parse_if_body(Compiler* c) {
+    uint32_t end_chain = UINT32_MAX;    // 跳到 END_IF 的 JMP 链表，经 d 字段串接
+    int taken = 0;                      // 已有恒真分支，其后的分支都不会执行
+    int first = 1;
+
+    for (;;) {
+        size_t mark = c->code_count;
+        Operand cond = constant(ST_TYPE_BOOL, 1.0);
+        int is_else = !first && is_kw(c, "ELSE");
+        size_t jz = SIZE_MAX;
+
+        next(c);                        // IF / ELSIF / ELSE
+        if (!is_else) {
+            Token at = c->tok;
+            c->temp_top = 0;
+            cond = parse_expr(c);
+            if (cond.type != ST_TYPE_BOOL) {
+                FAIL_AT(c, at, "条件必须是 BOOL 表达式");
+            }
+            expect_kw(c, "THEN");
+            if (!taken && !cond.is_const) {
+                jz = emit(c, ST_OP_JZ, 0, cond.ref, 0, 0);
+                release(c, &cond);
+            }
+        }
+        first = 0;
+
+        int live = !taken && (!cond.is_const || cond.value != 0.0);
+        parse_statement_list(c);
+        if (!live) {
+            c->code_count = mark;
+        } else if (cond.is_const) {
+            taken = 1;
+        } else {
+            if (is_kw(c, "ELSIF") || is_kw(c, "ELSE")) {
+                size_t jmp = emit(c, ST_OP_JMP, end_chain, 0, 0, 0);
+                end_chain = (uint32_t)jmp;
+            }
+            if (!c->failed) {
+                c->code[jz].d = (uint32_t)c->code_count;
+            }
+        }
+
+        if (is_else || !(is_kw(c, "ELSIF") || is_kw(c, "ELSE"))) {
+            break;
+        }
+    }
+    expect_kw(c, "END_IF");
+    if (c->tok.kind == TK_SEMI) {
+        next(c);
+    }
+
+    while (!c->failed && end_chain != UINT32_MAX) {
+        uint32_t prev = c->code[end_chain].d;
+        c->code[end_chain].d = (uint32_t)c->code_count;
+        end_chain = prev;
+    }
+}
+
+// IF 内的语句经 parse_statement_list() 递归，每层计入嵌套深度
+static void parse_if(Compiler* c) {
+    if (nest_enter(c)) {
+        parse_if_body(c);
+    }
+    nest_leave(c);
+}
+
+static void parse_statement_list(Compiler* c) {
+    while (!at_block_end(c)) {
+        if (c->tok.kind == TK_SEMI) {
+            next(c);
+        } else if (is_kw(c, "IF")) {
+            parse_if(c);
+        } else if (c->tok.kind == TK_IDENT && !is_reserved(c->tok.text, c->tok.len)) {
+            parse_assignment(c);
+        } else {
+            char got[64];
+            describe(&c->tok, got, sizeof(got));
+            FAIL(c, "此处需要语句，遇到 %s", got);
+        }
+    }
+}
+
+static void parse_declaration(Compiler* c, STVarKind kind) {
+    Token names[ST_DECL_MAX];
+    size_t count = 0;
+
+    for (;;) {
+        Token t = c->tok;
+        if (t.kind != TK_IDENT) {
+            expect(c, TK_IDENT, "变量名");
+            return;
+        }
+        if (is_reserved(t.text, t.len)) {
+            FAIL(c, "'%.*s' 是保留字，不能作为变量名", (int)t.len, t.text);
+            return;
+        }
+        if (t.len >= ST_NAME_MAX) {
+            FAIL(c, "变量名过长（最多 %d 个字符）", ST_NAME_MAX - 1);
+            return;
+        }
+        int duplicate = find_var(c, t.text, t.len) >= 0;
+        for (size_t i = 0; i < count; i++) {
+            duplicate = duplicate || same_name(names[i].text, names[i].len, t.text, t.len);
+        }
+        if (duplicate) {
+            FAIL(c, "变量 '%.*s' 重复声明", (int)t.len, t.text);
+            return;
+        }
+        if (count == ST_DECL_MAX) {
+            FAIL(c, "一条声明最多 %d 个变量", ST_DECL_MAX);
+            return;
+        }
+        names[count++] = t;
+        next(c);
+        if (c->tok.kind != TK_COMMA) {
+            break;
+        }
+        next(c);
+    }
+    expect(c, TK_COLON, "':'");
+
+    Token type_tok = c->tok;
+    STType type = ST_TYPE_REAL;
+    size_t k = 0;
+    for (; k < COUNT_OF(TYPES); k++) {
+        if (type_tok.kind == TK_IDENT && name_equals(type_tok.text, type_tok.len, TYPES[k].name)) {
+            type = TYPES[k].type;
+            break;
+        }
+    }
+    if (k == COUNT_OF(TYPES)) {
+        char got[64];
+        describe(&type_tok, got, sizeof(got));
+        FAIL(c, "未知类型 %s（支持 BOOL、整数类型和 REAL / LREAL）", got);
+        return;
+    }
+    next(c);
+
+    double init = 0.0;
+    if (c->tok.kind == TK_ASSIGN) {
+        next(c);
+        Token at = c->tok;
+        Operand value = parse_expr(c);
+        if (!c->failed && !value.is_const) {
+            FAIL_AT(c, at, "初值必须是常量表达式");
+        }
+        char name[ST_NAME_MAX];
+        snprintf(name, sizeof(name), "%.*s", (int)names[0].len, names[0].text);
+        check_assignable(c, &at, type, value.type, name);
+        init = value.value;
+    } else if (kind == ST_VAR_CONSTANT) {
+        FAIL(c, "常量 '%.*s' 缺少初值", (int)names[0].len, names[0].text);
+    }
+    expect(c, TK_SEMI, "';'");
+    if (c->failed ||
+        grow(c, (void**)&c->vars, &c->var_capacity, c->var_count + count, sizeof(STVar)) != 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        STVar* var = &c->vars[c->var_count++];
+        memset(var, 0, sizeof(*var));
+        memcpy(var->name, names[i].text, names[i].len);
+        var->type = type;
+        var->kind = kind;
+        var->init = init;
+    }
+}
+
+static void parse_declarations(Compiler* c) {
+    for (;;) {
+        STVarKind kind;
+        if (is_kw(c, "VAR")) {
+            kind = ST_VAR_LOCAL;
+        } else if (is_kw(c, "VAR_INPUT")) {
+            kind = ST_VAR_INPUT;
+        } else if (is_kw(c, "VAR_OUTPUT")) {
+            kind = ST_VAR_OUTPUT;
+        } else if (is_kw(c, "VAR_IN_OUT")) {
+            kind = ST_VAR_IN_OUT;
+        } else {
+            return;
+        }
+        next(c);
+        if (kind == ST_VAR_LOCAL && is_kw(c, "CONSTANT")) {
+            kind = ST_VAR_CONSTANT;
+            next(c);
+        }
+        while (c->tok.kind != TK_EOF && !is_kw(c, "END_VAR")) {
+            parse_declaration(c, kind);
+        }
+        expect_kw(c, "END_VAR");
+    }
+}
+
+static void parse_program(Compiler* c) {
+    int wrapped = is_kw(c, "PROGRAM");
+    if (wrapped) {
+        next(c);
+        expect(c, TK_IDENT, "程序名");
+    }
+
+    parse_declarations(c);
+    parse_statement_list(c);
+    if (c->failed) {
+        return;
+    }
+
+    if (is_kw(c, "END_PROGRAM")) {
+        if (!wrapped) {
+            FAIL(c, "END_PROGRAM 没有对应的 PROGRAM");
+            return;
+        }
+        next(c);
+    } else if (wrapped && c->tok.kind == TK_EOF) {
+        FAIL(c, "缺少 END_PROGRAM");
+        return;
+    }
+    if (c->tok.kind != TK_EOF) {
+        char got[64];
+        describe(&c->tok, got, sizeof(got));
+        FAIL(c, "多余的 %s", got);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * 公共接口
+ * ------------------------------------------------------------------------- */
+
+// 把编译期操作数换算成内存单元下标
+static uint32_t relocate(uint32_t ref, uint32_t const_base, uint32_t temp_base) {
+    if (ref & ST_CONST_TAG) {
+        return const_base + (ref & ST_REF_MASK);
+    }
+    if (ref & ST_TEMP_TAG) {
+        return temp_base + (ref & ST_REF_MASK);
+    }
+    return ref;
+}
+
+STProgram* st_program_compile(const char* source, char* error, size_t error_size) {
+    Compiler c;
+    memset(&c, 0, sizeof(c));
+    c.error = error;
+    c.error_size = error_size;
+    if (error && error_size) {
+        error[0] = '\0';
+    }
+
+    if (!source) {
+        fail_at(&c, 1, 1, "源码为空");
+    } else {
+        c.pos = c.line_start = source;
+        c.line = 1;
+        next(&c);
+        parse_program(&c);
+    }
+
+    STProgram* prog = NULL;
+    if (!c.failed) {
+        prog = (STProgram*)calloc(1, sizeof(STProgram));
+        size_t mem_count = c.var_count + c.const_count + c.temp_max;
+        if (prog) {
+            prog->mem = (double*)calloc(mem_count ? mem_count : 1, sizeof(double));
+        }
+        if (!prog || !prog->mem) {
+            free(prog);
+            prog = NULL;
+            fail_at(&c, c.line, 1, "内存分配失败");
+        } else {
+            prog->vars = c.vars;
+            prog->var_count = c.var_count;
+            prog->code = c.code;
+            prog->code_count = c.code_count;
+            prog->mem_count = mem_count ? mem_count : 1;
+            prog->const_count = c.const_count;
+            c.vars = NULL;
+            c.code = NULL;
+
+            uint32_t const_base = (uint32_t)c.var_count;
+            uint32_t temp_base = (uint32_t)(c.var_count + c.const_count);
+            for (size_t i = 0; i < prog->code_count; i++) {
+                STInsn* insn = &prog->code[i];
+                if (insn->op == ST_OP_JMP) {
+                    continue;
+                }
+                if (insn->op != ST_OP_JZ) {
+                    insn->d = relocate(insn->d, const_base, temp_base);
+                }
+                insn->a = relocate(insn->a, const_base, temp_base);
+                insn->b = relocate(insn->b, const_base, temp_base);
+                insn->c = relocate(insn->c, const_base, temp_base);
+            }
+            memcpy(prog->mem + const_base, c.consts, c.const_count * sizeof(double));
+            st_program_reset(prog);
+        }
+    }
+
+    free(c.vars);
+    free(c.consts);
+    free(c.code);
+    if (!prog) {
+        LOG_ERROR_MSG("ST 程序编译失败：%s", error && error_size ? error : "");
+        return NULL;
+    }
+
+    LOG_INFO_MSG("ST 程序编译成功：%zu 个变量，%zu 条指令", prog->var_count, prog->code_count);
+    return prog;
+}
+
+void st_program_destroy(STProgram* prog) {
+    if (!prog) {
+        return;
+    }
+
+    free(prog->vars);
+    free(prog->code);
+    free(prog->mem);
+    free(prog);
+}
+
+void st_program_run(STProgram* prog) {
+    double* m = prog->mem;
+    const STInsn* code = prog->code;
+    size_t n = prog->code_count;
+
+    for (size_t pc = 0; pc < n;) {
+        const STInsn* insn = &code[pc++];
+        switch (insn->op) {
+        case ST_OP_JMP:
+            pc = insn->d;
+            break;
+        case ST_OP_JZ:
+            if (m[insn->a] == 0.0) {
+                pc = insn->d;
+            }
+            break;
+        default:
+            m[insn->d] = st_apply(insn->op, m[insn->a], m[insn->b], m[insn->c]);
+            break;
+        }
+    }
+    prog->runs++;
+}
+
+int64_t st_program_find(const STProgram* prog, const char* name) {
+    if (!prog || !name) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < prog->var_count; i++) {
+        if (name_equals(name, strlen(name), prog->vars[i].name)) {
+            return (int64_t)i;
+        }
+    }
+    return -1;
+}
+
+int st_program_set(STProgram* prog, size_t index, double value) {
+    if (!prog || index >= prog->var_count || prog->vars[index].kind == ST_VAR_CONSTANT) {
+        return -1;
+    }
+
+    switch (prog->vars[index].type) {
+    case ST_TYPE_BOOL:
+        value = value != 0.0 ? 1.0 : 0.0;
+        break;
+    case ST_TYPE_INT:
+        if (!isfinite(value) || fabs(value) > ST_INT_LIMIT) {
+            return -1;
+        }
+        value = trunc(value);
+        break;
+    default:
+        break;
+    }
+    prog->mem[index] = value;
+    return 0;
+}
+
+void st_program_reset(STProgram* prog) {
+    if (!prog) {
+        return;
+    }
+
+    for (size_t i = 0; i < prog->var_count; i++) {
+        prog->mem[i] = prog->vars[i].init;
+    }
+    prog->runs = 0;
+}
+
+const char* st_op_name(STOp op) {
+    return (unsigned)op < ST_OP_COUNT ? OP_NAMES[op] : "?";
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_st.h
+ * @brief 结构化文本（IEC 61131-3 ST 子集）编译器与字节码解释器
+ *
+ * 把只含算术、比较和布尔逻辑的 step() 写成 ST，编译一次后每周期由
+ * st_program_run() 在 C 中执行，不经过 Python：
+ *
+ *   VAR_INPUT  level : REAL; pump_ok : BOOL; END_VAR
+ *   VAR_OUTPUT valve : REAL; alarm : BOOL; END_VAR
+ *   VAR CONSTANT high : REAL := 90.0; END_VAR
+ *   valve := LIMIT(0.0, (high - level) * 2.5, 100.0);
+ *   IF level > high OR NOT pump_ok THEN alarm := TRUE; ELSE alarm := FALSE; END_IF;
+ *
+ * 支持的语法：
+ *   - 声明：VAR / VAR_INPUT / VAR_OUTPUT / VAR_IN_OUT / VAR CONSTANT ... END_VAR，
+ *     类型 BOOL、SINT/INT/DINT/LINT/USINT/UINT/UDINT/ULINT、REAL/LREAL，可带初值；
+ *     可选的 PROGRAM 名称 ... END_PROGRAM 外壳；
+ *   - 语句：赋值 :=、IF / ELSIF / ELSE / END_IF（不支持循环，执行时间有界）；
+ *   - 运算（优先级从高到低，同级从左到右）：一元 - NOT；**；* / MOD；+ -；
+ *     < > <= >=；= <>；AND &；XOR；OR（与标准语法一致，-2**2 为 4）；
+ *   - 函数：ABS SQRT EXP LN LOG SIN COS TAN ASIN ACOS ATAN、MIN / MAX（两个及以上
+ *     参数）、LIMIT(MN, IN, MX)、SEL(G, IN0, IN1)、TRUNC、REAL_TO_INT、INT_TO_REAL、
+ *     BOOL_TO_INT、INT_TO_BOOL；
+ *   - 字面量：整数（可含 '_'，支持 2#、8#、16# 进制）、实数、TRUE / FALSE；
+ *   - 注释 (* ... *) 和 // ...；关键字和标识符不区分大小写。
+ *
+ * 所有值按 double 存放在变量映像中（BOOL 为 0/1），编译时做静态类型检查：
+ * 整数之间的 / 按截断除法，MOD 只用于整数，逻辑运算只用于 BOOL，REAL 赋给整数
+ * 变量需显式 TRUNC / REAL_TO_INT。整数除以 0 结果为 0（不抛出运行时错误）。
+ *
+ * 编译结果为三地址寄存器字节码：每条指令的操作数都是内存单元下标，内存依次
+ * 存放变量、常量和临时值；常量子表达式在编译时折叠，表达式结果直接写入被赋值
+ * 的变量，执行时没有装载/存储指令。
+ */
+
+#ifndef FB_ST_H
+#define FB_ST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ST_NAME_MAX 32          // 变量名最大长度（含结尾 '\0'）
+#define ST_ERROR_MAX 256        // 编译错误信息缓冲区长度
+
+// Python 绑定导出 STProgram 指针时使用的 PyCapsule 名称
+#define ST_PROGRAM_CAPSULE_NAME "plcopen_c.STProgram"
+
+// 值类型
+typedef enum {
+    ST_TYPE_BOOL,
+    ST_TYPE_INT,
+    ST_TYPE_REAL
+} STType;
+
+// 变量类别
+typedef enum {
+    ST_VAR_LOCAL,        // VAR
+    ST_VAR_INPUT,        // VAR_INPUT（程序内只读）
+    ST_VAR_OUTPUT,       // VAR_OUTPUT
+    ST_VAR_IN_OUT,       // VAR_IN_OUT
+    ST_VAR_CONSTANT      // VAR CONSTANT（编译时折叠）
+} STVarKind;
+
+// 操作码
+typedef enum {
+    ST_OP_MOV, ST_OP_NEG, ST_OP_NOT,
+    ST_OP_ADD, ST_OP_SUB, ST_OP_MUL, ST_OP_DIV, ST_OP_IDIV, ST_OP_MOD, ST_OP_EXPT,
+    ST_OP_EQ, ST_OP_NE, ST_OP_LT, ST_OP_LE, ST_OP_GT, ST_OP_GE,
+    ST_OP_AND, ST_OP_OR, ST_OP_XOR,
+    ST_OP_ABS, ST_OP_SQRT, ST_OP_EXP, ST_OP_LN, ST_OP_LOG,
+    ST_OP_SIN, ST_OP_COS, ST_OP_TAN, ST_OP_ASIN, ST_OP_ACOS, ST_OP_ATAN,
+    ST_OP_TRUNC, ST_OP_ROUND,
+    ST_OP_MIN, ST_OP_MAX, ST_OP_LIMIT, ST_OP_SEL,
+    ST_OP_JMP,           // 跳转到 d
+    ST_OP_JZ,            // a 为 0 时跳转到 d
+    ST_OP_COUNT
+} STOp;
+
+// 指令：m[d] = op(m[a], m[b], m[c])；跳转指令的 d 为目标指令下标
+typedef struct {
+    uint32_t op;
+    uint32_t d, a, b, c;
+} STInsn;
+
+// 变量
+typedef struct {
+    char name[ST_NAME_MAX];
+    STType type;
+    STVarKind kind;
+    double init;         // 初值（reset 时恢复）
+} STVar;
+
+// 编译后的程序
+typedef struct {
+    STVar* vars;         // 变量表，下标即变量在 mem 中的单元
+    size_t var_count;
+    STInsn* code;
+    size_t code_count;
+    double* mem;         // [变量 | 常量 | 临时值]
+    size_t mem_count;
+    size_t const_count;
+    uint64_t runs;       // 执行次数
+} STProgram;
+
+/**
+ * @brief 编译 ST 源码
+ * @param source 源码（UTF-8）
+ * @param error 编译失败时写入 "第 L 行第 C 列：原因"（可为 NULL）
+ * @param error_size error 缓冲区长度
+ * @return 程序指针，失败返回 NULL
+ */
+STProgram* st_program_compile(const char* source, char* error, size_t error_size);
+
+/**
+ * @brief 释放程序
+ * @param prog 程序指针
+ */
+void st_program_destroy(STProgram* prog);
+
+/**
+ * @brief 执行一个周期
+ * @param prog 程序指针
+ */
+void st_program_run(STProgram* prog);
+
+/**
+ * @brief 按名称查找变量（不区分大小写）
+ * @param prog 程序指针
+ * @param name 变量名
+ * @return 变量下标（即在 prog->mem 中的单元），未找到返回 -1
+ */
+int64_t st_program_find(const STProgram* prog, const char* name);
+
+/**
+ * @brief 按变量类型写入值（BOOL 取 0/1，整数向零截断）
+ * @param prog 程序指针
+ * @param index 变量下标
+ * @param value 值
+ * @return 0 成功，-1 下标无效、变量为常量或整数变量的值超出 ±2^53
+ */
+int st_program_set(STProgram* prog, size_t index, double value);
+
+/**
+ * @brief 所有变量恢复初值，清零执行次数
+ * @param prog 程序指针
+ */
+void st_program_reset(STProgram* prog);
+
+/**
+ * @brief 操作码名称（反汇编用）
+ * @param op 操作码
+ * @return 名称，未知操作码返回 "?"
+ */
+const char* st_op_name(STOp op);
+
+#endif // FB_ST_H
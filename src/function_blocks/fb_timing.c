@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_timing.c
+ * @brief 功能块执行时间计数的查询、清零与导出
+ */
+
+#include "fb_timing.h"
+#include "fb_journal.h"
+#include "../runtime/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef FB_TIMING
+
+// TSC 标定时长（纳秒）
+#define FB_TIMING_CALIBRATE_NS 20000000ull
+
+#ifdef FB_TIMING_TSC
+static double g_ns_per_tick = 0.0;
+
+static uint64_t monotonic_raw_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+#endif
+
+typedef struct {
+    FBTimingSample* items;
+    size_t count;
+    size_t capacity;
+} Snapshot;
+
+static int snapshot_visit(const FBRegistryEntry* entry, void* user) {
+    Snapshot* snapshot = (Snapshot*)user;
+
+    if (snapshot->count == snapshot->capacity) {
+        return 1;
+    }
+    FBTimingSample* sample = &snapshot->items[snapshot->count++];
+    sample->entry = *entry;
+    sample->timing = entry->block->timing;
+    return 0;
+}
+
+static int reset_visit(const FBRegistryEntry* entry, void* user) {
+    (void)user;
+    FBTiming* timing = &entry->block->timing;
+    timing->calls = 0;
+    timing->total = 0;
+    timing->max = 0;
+    return 0;
+}
+
+// 按累计耗时降序
+static int compare_total(const void* a, const void* b) {
+    uint64_t x = ((const FBTimingSample*)a)->timing.total;
+    uint64_t y = ((const FBTimingSample*)b)->timing.total;
+    return x < y ? 1 : x > y ? -1 : 0;
+}
+
+#endif // FB_TIMING
+
+int fb_timing_enabled(void) {
+#ifdef FB_TIMING
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+const char* fb_timing_clock_name(void) {
+#if defined(FB_TIMING_TSC)
+    return "tsc";
+#elif defined(FB_TIMING)
+    return "monotonic_raw";
+#else
+    return "none";
+#endif
+}
+
+double fb_timing_ns_per_tick(void) {
+#ifdef FB_TIMING_TSC
+    double cached;
+    __atomic_load(&g_ns_per_tick, &cached, __ATOMIC_RELAXED);
+    if (cached > 0.0) {
+        return cached;
+    }
+
+    // 忙等一段时间，对照单调原始时钟求 TSC 频率
+    uint64_t ns0 = monotonic_raw_ns();
+    uint64_t tsc0 = fb_timing_ticks();
+    uint64_t ns1;
+    do {
+        ns1 = monotonic_raw_ns();
+    } while (ns1 - ns0 < FB_TIMING_CALIBRATE_NS);
+    uint64_t tsc1 = fb_timing_ticks();
+
+    double ratio = tsc1 > tsc0 ? (double)(ns1 - ns0) / (double)(tsc1 - tsc0) : 1.0;
+    __atomic_store(&g_ns_per_tick, &ratio, __ATOMIC_RELAXED);
+    return ratio;
+#else
+    return 1.0;
+#endif
+}
+
+size_t fb_timing_snapshot(FBTimingSample* out, size_t capacity) {
+#ifdef FB_TIMING
+    Snapshot snapshot = {out, 0, out ? capacity : 0};
+
+    fb_registry_foreach(snapshot_visit, &snapshot);
+    return snapshot.count;
+#else
+    (void)out;
+    (void)capacity;
+    return 0;
+#endif
+}
+
+void fb_timing_reset_all(void) {
+#ifdef FB_TIMING
+    fb_registry_foreach(reset_visit, NULL);
+#endif
+}
+
+int fb_timing_dump(const char* path, const char* mode) {
+#ifdef FB_TIMING
+    if (!path || !mode) {
+        return -1;
+    }
+
+    // 多留一些余量，导出期间新登记的实例被截断也无妨
+    size_t capacity = fb_registry_count() + 64;
+    FBTimingSample* samples = malloc(capacity * sizeof(FBTimingSample));
+    if (!samples) {
+        LOG_ERROR_MSG("功能块计时导出失败：内存不足");
+        return -1;
+    }
+    size_t count = fb_timing_snapshot(samples, capacity);
+    qsort(samples, count, sizeof(FBTimingSample), compare_total);
+
+    FILE* file = fopen(path, mode);
+    if (!file) {
+        LOG_ERROR_MSG("无法打开功能块计时输出文件：%s", path);
+        free(samples);
+        return -1;
+    }
+
+    double scale = fb_timing_ns_per_tick();
+    fprintf(file, "# 功能块执行时间：%zu 个实例，时钟 %s，1 刻度 = %.4f ns\n", count,
+            fb_timing_clock_name(), scale);
+    fprintf(file, "# %8s %-12s %-24s %12s %14s %10s %10s\n", "id", "type", "name", "calls",
+            "total_us", "mean_ns", "max_ns");
+    for (size_t i = 0; i < count; i++) {
+        const FBTimingSample* s = &samples[i];
+        double total_ns = (double)s->timing.total * scale;
+        double mean_ns = s->timing.calls ? total_ns / (double)s->timing.calls : 0.0;
+        fprintf(file, "  %8u %-12s %-24s %12llu %14.3f %10.1f %10.1f\n", s->entry.id,
+                fb_journal_type_name(s->entry.type), s->entry.name[0] ? s->entry.name : "-",
+                (unsigned long long)s->timing.calls, total_ns / 1000.0, mean_ns,
+                (double)s->timing.max * scale);
+    }
+    fclose(file);
+    free(samples);
+
+    LOG_INFO_MSG("功能块计时已导出：%s（%zu 个实例）", path, count);
+    return (int)count;
+#else
+    (void)path;
+    (void)mode;
+    LOG_WARNING_MSG("未以 FB_TIMING 构建，没有功能块计时可导出");
+    return -1;
+#endif
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_timing.h
+ * @brief 功能块执行时间计数（编译期开关 FB_TIMING）
+ *
+ * 以 FB_TIMING 构建时，每个功能块实例在 FunctionBlock 基础结构中带一组
+ * FBTiming 计数，各 *_compute 入口处的 FB_TIMED() 在函数返回时累加调用次数、
+ * 累计耗时和单次最大耗时（所有返回路径都会计入）。FBD 网络中的功能块
+ * 经由同一组计算函数，因此同样被计数。
+ *
+ * 时钟：x86 上读 TSC（rdtsc，假定为不变 TSC），首次换算时对照
+ * CLOCK_MONOTONIC_RAW 标定刻度长度；其他平台直接读 CLOCK_MONOTONIC_RAW（纳秒）。
+ *
+ * 未定义 FB_TIMING 时 FBTiming 成员和 FB_TIMED() 都不存在，计算路径上没有任何
+ * 额外指令；本文件的查询接口仍可调用，fb_timing_enabled() 返回 0。
+ *
+ * 计数只由执行计算的线程写入，读取方（Python、导出）不加锁，
+ * 64 位对齐读写在支持的平台上不会撕裂，但三项之间不保证是同一时刻的值。
+ *
+ * @note 扩展模块和运行时各编译一份功能块，两者必须使用相同的 FB_TIMING 设置，
+ *       否则挂接到运行时的网络结构布局不一致（挂接时会检查并拒绝）。
+ */
+
+#ifndef FB_TIMING_H
+#define FB_TIMING_H
+
+#include "fb_registry.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef FB_TIMING
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define FB_TIMING_TSC 1
+#else
+#include <time.h>
+#endif
+
+/**
+ * @brief 读取计时时钟
+ * @return 刻度（TSC 周期数或纳秒）
+ */
+static inline uint64_t fb_timing_ticks(void) {
+#ifdef FB_TIMING_TSC
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+// FB_TIMED() 的作用域变量，离开作用域时由 cleanup 属性结算
+typedef struct {
+    FBTiming* timing;
+    uint64_t start;
+} FBTimingScope;
+
+static inline void fb_timing_scope_end(FBTimingScope* scope) {
+    uint64_t elapsed = fb_timing_ticks() - scope->start;
+    FBTiming* timing = scope->timing;
+    timing->calls++;
+    timing->total += elapsed;
+    if (elapsed > timing->max) {
+        timing->max = elapsed;
+    }
+}
+
+/**
+ * @brief 对当前函数的剩余部分计时
+ * @param base 功能块基础结构指针（必须非空）
+ */
+#define FB_TIMED(base)                                                              \
+    FBTimingScope fb_timing_scope_ __attribute__((cleanup(fb_timing_scope_end))) = \
+        {&(base)->timing, fb_timing_ticks()}
+
+#else
+
+#define FB_TIMED(base) ((void)0)
+
+#endif // FB_TIMING
+
+// 一个实例的计数快照
+typedef struct {
+    FBRegistryEntry entry;   // 注册表条目副本
+    FBTiming timing;         // 计数（刻度）
+} FBTimingSample;
+
+/**
+ * @brief 本模块是否以 FB_TIMING 构建
+ * @return 1 是，0 否
+ */
+int fb_timing_enabled(void);
+
+/**
+ * @brief 时钟名称
+ * @return "tsc"、"monotonic_raw"，未启用时为 "none"
+ */
+const char* fb_timing_clock_name(void);
+
+/**
+ * @brief 每个刻度对应的纳秒数
+ * @return TSC 按首次调用时的标定结果（约 20 ms），其他时钟为 1.0
+ *
+ * @note 首次调用会短暂忙等，不要在控制周期内首次调用
+ */
+double fb_timing_ns_per_tick(void);
+
+/**
+ * @brief 复制所有已登记实例的计数
+ * @param out 输出数组
+ * @param capacity 数组容量
+ * @return 写入的个数（未启用时为 0）
+ */
+size_t fb_timing_snapshot(FBTimingSample* out, size_t capacity);
+
+/**
+ * @brief 清零所有已登记实例的计数
+ *
+ * @note 与计算并发时个别调用可能仍计入旧值，应在周期边界调用
+ */
+void fb_timing_reset_all(void);
+
+/**
+ * @brief 按累计耗时降序导出所有实例的计数（文本表格）
+ * @param path 输出文件路径
+ * @param mode fopen 模式，"w" 覆盖或 "a" 追加
+ * @return 导出的实例数，未启用或打开文件失败返回 -1
+ */
+int fb_timing_dump(const char* path, const char* mode);
+
+#endif // FB_TIMING_H
@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_window.c
+ * @brief 滑动窗口滤波功能块实现
+ */
+
+#include "fb_window.h"
+#include "fb_journal.h"
+#include "fb_pool.h"
+#include "fb_registry.h"
+#include "fb_timing.h"
+#include "../runtime/logger.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int valid_window(uint32_t window, uint32_t min) {
+    return window >= min && window <= FB_WINDOW_MAX;
+}
+
+static void init_base(FunctionBlock* base, FunctionBlockType type) {
+    base->type = type;
+    base->id = 0;
+    base->last_update_time = 0.0;
+}
+
+// 从实例池分配功能块和窗口存储并登记；失败返回 NULL
+static void* create_block(FunctionBlockType type, const char* name, size_t storage_size,
+                          void** storage) {
+    void* block = fb_pool_alloc(type);
+    if (!block) {
+        LOG_ERROR_MSG("%s 创建失败：实例池已满", name);
+        return NULL;
+    }
+
+    *storage = fb_pool_storage_alloc(storage_size);
+    if (!*storage) {
+        LOG_ERROR_MSG("%s 创建失败：附属存储区不足（%zu 字节）", name, storage_size);
+        fb_pool_free(type, block);
+        return NULL;
+    }
+    return block;
+}
+
+// 初始化完成后登记到注册表；失败时释放存储和槽位
+static int register_block(FunctionBlock* base, void* storage) {
+    if (fb_registry_register(base, NULL, NULL) == 0) {
+        fb_pool_storage_free(storage);
+        fb_pool_free(base->type, base);
+        return -1;
+    }
+    return 0;
+}
+
+static void destroy_block(FunctionBlock* base, void* storage) {
+    FB_JOURNAL_EVENT(base->type, base->id, FB_EVENT_DESTROY);
+    fb_registry_unregister(base->id);
+    fb_pool_storage_free(storage);
+    fb_pool_free(base->type, base);
+}
+
+/* ========== 滑动平均 ========== */
+
+size_t moving_average_storage_size(uint32_t window) {
+    return (size_t)window * sizeof(double);
+}
+
+int moving_average_init(MovingAverageFB* fb, uint32_t window, void* storage) {
+    if (!fb || !storage || !valid_window(window, 1)) {
+        return -1;
+    }
+
+    init_base(&fb->base, FB_TYPE_MOVING_AVERAGE);
+    fb->window = window;
+    fb->samples = (double*)storage;
+    fb->storage = NULL;
+    moving_average_reset(fb);
+    return 0;
+}
+
+MovingAverageFB* moving_average_create(uint32_t window) {
+    if (!valid_window(window, 1)) {
+        LOG_ERROR_MSG("滑动平均创建失败：窗口长度 %u 超出范围", window);
+        return NULL;
+    }
+
+    void* storage;
+    MovingAverageFB* fb = (MovingAverageFB*)create_block(
+        FB_TYPE_MOVING_AVERAGE, "滑动平均", moving_average_storage_size(window), &storage);
+    if (!fb) {
+        return NULL;
+    }
+
+    moving_average_init(fb, window, storage);
+    fb->storage = storage;
+    if (register_block(&fb->base, storage) != 0) {
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_MOVING_AVERAGE, fb->base.id, FB_EVENT_CREATE, "window", (double)window);
+    return fb;
+}
+
+void moving_average_destroy(MovingAverageFB* fb) {
+    if (fb) {
+        destroy_block(&fb->base, fb->storage);
+    }
+}
+
+double moving_average_compute(MovingAverageFB* fb, double input) {
+    if (!fb) {
+        return 0.0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    if (fb->count < fb->window) {
+        fb->count++;
+    } else {
+        fb->sum -= fb->samples[fb->head];
+    }
+    fb->samples[fb->head] = input;
+    fb->sum += input;
+
+    // 每回绕一次重新求和，舍入误差不随运行时间累积
+    if (++fb->head == fb->window) {
+        fb->head = 0;
+        double sum = 0.0;
+        for (uint32_t i = 0; i < fb->window; i++) {
+            sum += fb->samples[i];
+        }
+        fb->sum = sum;
+    }
+
+    fb->output = fb->sum / (double)fb->count;
+    return fb->output;
+}
+
+void moving_average_reset(MovingAverageFB* fb) {
+    if (fb) {
+        fb->count = 0;
+        fb->head = 0;
+        fb->sum = 0.0;
+        fb->output = 0.0;
+        fb->base.last_update_time = 0.0;
+    }
+}
+
+/* ========== 滑动中值 ========== */
+
+// 最小堆（下标 > 0）和最大堆（下标 < 0）中的元素个数
+#define MIN_HEAP_COUNT(fb) (((int32_t)(fb)->count - 1) / 2)
+#define MAX_HEAP_COUNT(fb) ((int32_t)(fb)->count / 2)
+
+size_t moving_median_storage_size(uint32_t window) {
+    return (size_t)window * (sizeof(double) + 2 * sizeof(int32_t));
+}
+
+static int heap_less(const MovingMedianFB* fb, int32_t i, int32_t j) {
+    return fb->samples[fb->heap[i]] < fb->samples[fb->heap[j]];
+}
+
+// 堆中 i、j 两个位置互换，并更新样本到堆位置的映射
+static int heap_swap(MovingMedianFB* fb, int32_t i, int32_t j) {
+    int32_t t = fb->heap[i];
+    fb->heap[i] = fb->heap[j];
+    fb->heap[j] = t;
+    fb->pos[fb->heap[i]] = i;
+    fb->pos[fb->heap[j]] = j;
+    return 1;
+}
+
+// heap[i] < heap[j] 时互换，返回是否互换
+static int heap_order(MovingMedianFB* fb, int32_t i, int32_t j) {
+    return heap_less(fb, i, j) && heap_swap(fb, i, j);
+}
+
+// 最小堆下沉：i 为起始节点的第一个子节点（从中值开始时为 1）
+static void min_heap_down(MovingMedianFB* fb, int32_t i) {
+    for (; i <= MIN_HEAP_COUNT(fb); i *= 2) {
+        if (i > 1 && i < MIN_HEAP_COUNT(fb) && heap_less(fb, i + 1, i)) {
+            ++i;
+        }
+        if (!heap_order(fb, i, i / 2)) {
+            break;
+        }
+    }
+}
+
+// 最大堆下沉：i 为起始节点的第一个子节点（从中值开始时为 -1）
+static void max_heap_down(MovingMedianFB* fb, int32_t i) {
+    for (; i >= -MAX_HEAP_COUNT(fb); i *= 2) {
+        if (i < -1 && i > -MAX_HEAP_COUNT(fb) && heap_less(fb, i, i - 1)) {
+            --i;
+        }
+        if (!heap_order(fb, i / 2, i)) {
+            break;
+        }
+    }
+}
+
+// 上浮，返回是否到达中值位置
+static int min_heap_up(MovingMedianFB* fb, int32_t i) {
+    while (i > 0 && heap_order(fb, i, i / 2)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+static int max_heap_up(MovingMedianFB* fb, int32_t i) {
+    while (i < 0 && heap_order(fb, i / 2, i)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+int moving_median_init(MovingMedianFB* fb, uint32_t window, void* storage) {
+    if (!fb || !storage || !valid_window(window, 1)) {
+        return -1;
+    }
+
+    init_base(&fb->base, FB_TYPE_MOVING_MEDIAN);
+    fb->window = window;
+    fb->samples = (double*)storage;
+    fb->pos = (int32_t*)(fb->samples + window);
+    fb->heap = fb->pos + window + window / 2;
+    fb->storage = NULL;
+    moving_median_reset(fb);
+    return 0;
+}
+
+MovingMedianFB* moving_median_create(uint32_t window) {
+    if (!valid_window(window, 1)) {
+        LOG_ERROR_MSG("滑动中值创建失败：窗口长度 %u 超出范围", window);
+        return NULL;
+    }
+
+    void* storage;
+    MovingMedianFB* fb = (MovingMedianFB*)create_block(
+        FB_TYPE_MOVING_MEDIAN, "滑动中值", moving_median_storage_size(window), &storage);
+    if (!fb) {
+        return NULL;
+    }
+
+    moving_median_init(fb, window, storage);
+    fb->storage = storage;
+    if (register_block(&fb->base, storage) != 0) {
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_MOVING_MEDIAN, fb->base.id, FB_EVENT_CREATE, "window", (double)window);
+    return fb;
+}
+
+void moving_median_destroy(MovingMedianFB* fb) {
+    if (fb) {
+        destroy_block(&fb->base, fb->storage);
+    }
+}
+
+double moving_median_compute(MovingMedianFB* fb, double input) {
+    if (!fb) {
+        return 0.0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    int is_new = fb->count < fb->window;
+    int32_t p = fb->pos[fb->head];
+    double old = fb->samples[fb->head];
+
+    // 新样本原地替换最旧样本（窗口未满时占用预先排好的空位）
+    fb->samples[fb->head] = input;
+    fb->head = fb->head + 1 == fb->window ? 0 : fb->head + 1;
+    fb->count += is_new;
+
+    if (p > 0) {
+        if (!is_new && old < input) {
+            min_heap_down(fb, p * 2);
+        } else if (min_heap_up(fb, p)) {
+            max_heap_down(fb, -1);
+        }
+    } else if (p < 0) {
+        if (!is_new && input < old) {
+            max_heap_down(fb, p * 2);
+        } else if (max_heap_up(fb, p)) {
+            min_heap_down(fb, 1);
+        }
+    } else {
+        if (MAX_HEAP_COUNT(fb)) {
+            max_heap_down(fb, -1);
+        }
+        if (MIN_HEAP_COUNT(fb)) {
+            min_heap_down(fb, 1);
+        }
+    }
+
+    double median = fb->samples[fb->heap[0]];
+    if ((fb->count & 1) == 0) {
+        median = (median + fb->samples[fb->heap[-1]]) / 2.0;
+    }
+    fb->output = median;
+    return median;
+}
+
+void moving_median_reset(MovingMedianFB* fb) {
+    if (!fb) {
+        return;
+    }
+
+    // 第 k 个样本预先排在：中值、最大堆、最小堆、最大堆……交替的位置
+    for (uint32_t k = 0; k < fb->window; k++) {
+        int32_t p = (int32_t)((k + 1) / 2) * ((k & 1) ? -1 : 1);
+        fb->pos[k] = p;
+        fb->heap[p] = (int32_t)k;
+    }
+    fb->count = 0;
+    fb->head = 0;
+    fb->output = 0.0;
+    fb->base.last_update_time = 0.0;
+}
+
+/* ========== 变化率 ========== */
+
+size_t slope_storage_size(uint32_t window) {
+    return (size_t)window * sizeof(double);
+}
+
+static int valid_period(double period) {
+    return period > 0.0 && period < 1e9;
+}
+
+int slope_init(SlopeFB* fb, uint32_t window, double period, void* storage) {
+    if (!fb || !storage || !valid_window(window, 2) || !valid_period(period)) {
+        return -1;
+    }
+
+    init_base(&fb->base, FB_TYPE_SLOPE);
+    fb->window = window;
+    fb->period = period;
+    fb->samples = (double*)storage;
+    fb->storage = NULL;
+    slope_reset(fb);
+    return 0;
+}
+
+SlopeFB* slope_create(uint32_t window, double period) {
+    if (!valid_window(window, 2) || !valid_period(period)) {
+        LOG_ERROR_MSG("变化率创建失败：window=%u, period=%.6f", window, period);
+        return NULL;
+    }
+
+    void* storage;
+    SlopeFB* fb = (SlopeFB*)create_block(FB_TYPE_SLOPE, "变化率",
+                                         slope_storage_size(window), &storage);
+    if (!fb) {
+        return NULL;
+    }
+
+    slope_init(fb, window, period, storage);
+    fb->storage = storage;
+    if (register_block(&fb->base, storage) != 0) {
+        return NULL;
+    }
+
+    FB_JOURNAL(FB_TYPE_SLOPE, fb->base.id, FB_EVENT_CREATE, "window,period", (double)window,
+               period);
+    return fb;
+}
+
+void slope_destroy(SlopeFB* fb) {
+    if (fb) {
+        destroy_block(&fb->base, fb->storage);
+    }
+}
+
+double slope_compute(SlopeFB* fb, double input) {
+    if (!fb) {
+        return 0.0;
+    }
+
+    FB_TIMED(&fb->base);
+
+    uint32_t n = fb->window;
+    if (fb->count < n) {
+        // 新样本序号为 count
+        fb->weighted += (double)fb->count * input;
+        fb->sum += input;
+        fb->count++;
+    } else {
+        // 窗口滑动：其余样本序号减 1，新样本序号为 n - 1
+        double oldest = fb->samples[fb->head];
+        fb->weighted += (double)(n - 1) * input - (fb->sum - oldest);
+        fb->sum += input - oldest;
+    }
+    fb->samples[fb->head] = input;
+
+    // 回绕时最旧样本位于下标 0，按序号重新求和
+    if (++fb->head == n) {
+        fb->head = 0;
+        double sum = 0.0;
+        double weighted = 0.0;
+        for (uint32_t j = 0; j < n; j++) {
+            sum += fb->samples[j];
+            weighted += (double)j * fb->samples[j];
+        }
+        fb->sum = sum;
+        fb->weighted = weighted;
+    }
+
+    // 斜率 = Σ(j - j̄)(x - x̄) / Σ(j - j̄)²，j̄ = (m - 1)/2，Σ(j - j̄)² = m(m² - 1)/12
+    double m = (double)fb->count;
+    if (fb->count < 2) {
+        fb->output = 0.0;
+    } else {
+        double sxy = fb->weighted - (m - 1.0) / 2.0 * fb->sum;
+        double sxx = m * (m * m - 1.0) / 12.0;
+        fb->output = sxy / sxx / fb->period;
+    }
+    return fb->output;
+}
+
+int slope_set_period(SlopeFB* fb, double period) {
+    if (!fb || !valid_period(period)) {
+        return -1;
+    }
+    fb->period = period;
+    return 0;
+}
+
+void slope_reset(SlopeFB* fb) {
+    if (fb) {
+        fb->count = 0;
+        fb->head = 0;
+        fb->sum = 0.0;
+        fb->weighted = 0.0;
+        fb->output = 0.0;
+        fb->base.last_update_time = 0.0;
+    }
+}
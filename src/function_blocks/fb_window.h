@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file fb_window.h
+ * @brief 滑动窗口滤波功能块接口
+ *
+ * 三个功能块都在最近 window 个样本上计算（窗口未满时使用已有样本），
+ * 样本保存在初始化时给定的固定存储中，每周期不分配内存：
+ *   - MovingAverage：滑动平均，维护累加和，O(1)；
+ *   - MovingMedian：滑动中值（抑制尖峰），双堆结构，O(log n)：
+ *     窗口中较小的一半在最大堆、较大的一半在最小堆，两个堆共用一个以
+ *     中值为中心的下标数组，环形缓冲区中每个样本记录自己在堆中的位置，
+ *     新样本原地替换最旧样本后上浮/下沉即可；
+ *   - Slope：变化率，窗口内样本对时间的最小二乘斜率，维护 Σx 与 Σj·x，O(1)。
+ * 累加和在环形缓冲区每回绕一次时按窗口内样本重新求和，避免舍入误差累积。
+ *
+ * 存储可由 xxx_create() 从实例池的附属存储区分配（destroy 时归还），也可由调用者按
+ * xxx_storage_size() 提供（如批量形式一次分配 n 个通道的存储）。
+ */
+
+#ifndef FB_WINDOW_H
+#define FB_WINDOW_H
+
+#include "fb_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define FB_WINDOW_MAX (1u << 20)   // 最大窗口长度（样本数）
+
+// 滑动平均功能块
+typedef struct {
+    FunctionBlock base;
+    uint32_t window;     // 窗口长度（样本数）
+    uint32_t count;      // 窗口内样本数（<= window）
+    uint32_t head;       // 下一个写入位置（窗口满时即最旧样本）
+    double* samples;     // 环形缓冲区（window 个）
+    double sum;          // 窗口内样本之和
+    double output;       // 最近一次输出
+    void* storage;       // create() 分配的存储，调用者提供存储时为 NULL
+} MovingAverageFB;
+
+// 滑动中值功能块
+typedef struct {
+    FunctionBlock base;
+    uint32_t window;     // 窗口长度（样本数）
+    uint32_t count;      // 窗口内样本数（<= window）
+    uint32_t head;       // 下一个写入位置
+    double* samples;     // 环形缓冲区（window 个）
+    int32_t* pos;        // 每个样本在堆中的位置：0 为中值，<0 最大堆，>0 最小堆
+    int32_t* heap;       // 指向堆数组中点，有效下标 [-(count/2), (count-1)/2]
+    double output;       // 最近一次输出
+    void* storage;       // create() 分配的存储，调用者提供存储时为 NULL
+} MovingMedianFB;
+
+// 变化率（最小二乘斜率）功能块
+typedef struct {
+    FunctionBlock base;
+    uint32_t window;     // 窗口长度（样本数）
+    uint32_t count;      // 窗口内样本数（<= window）
+    uint32_t head;       // 下一个写入位置
+    double period;       // 采样周期（秒）
+    double* samples;     // 环形缓冲区（window 个）
+    double sum;          // Σx
+    double weighted;     // Σj·x，j 为样本在窗口中的序号（最旧为 0）
+    double output;       // 最近一次输出（单位/秒）
+    void* storage;       // create() 分配的存储，调用者提供存储时为 NULL
+} SlopeFB;
+
+/* ========== 滑动平均 ========== */
+
+/**
+ * @brief 滑动平均所需的存储字节数
+ * @param window 窗口长度
+ * @return 字节数
+ */
+size_t moving_average_storage_size(uint32_t window);
+
+/**
+ * @brief 就地初始化滑动平均
+ * @param fb 功能块指针
+ * @param window 窗口长度 [1, FB_WINDOW_MAX]
+ * @param storage 至少 moving_average_storage_size(window) 字节、按 double 对齐的存储
+ * @return 0 成功，-1 参数无效
+ */
+int moving_average_init(MovingAverageFB* fb, uint32_t window, void* storage);
+
+/**
+ * @brief 从实例池创建滑动平均并分配存储
+ * @param window 窗口长度
+ * @return 功能块指针，失败返回 NULL
+ */
+MovingAverageFB* moving_average_create(uint32_t window);
+
+/**
+ * @brief 销毁滑动平均（释放 create() 分配的存储）
+ * @param fb 功能块指针
+ */
+void moving_average_destroy(MovingAverageFB* fb);
+
+/**
+ * @brief 写入一个样本并返回窗口平均值
+ * @param fb 功能块指针
+ * @param input 输入信号
+ * @return 窗口内样本的平均值
+ */
+double moving_average_compute(MovingAverageFB* fb, double input);
+
+/**
+ * @brief 重置：清空窗口
+ * @param fb 功能块指针
+ */
+void moving_average_reset(MovingAverageFB* fb);
+
+/* ========== 滑动中值 ========== */
+
+/**
+ * @brief 滑动中值所需的存储字节数
+ * @param window 窗口长度
+ * @return 字节数
+ */
+size_t moving_median_storage_size(uint32_t window);
+
+/**
+ * @brief 就地初始化滑动中值
+ * @param fb 功能块指针
+ * @param window 窗口长度 [1, FB_WINDOW_MAX]
+ * @param storage 至少 moving_median_storage_size(window) 字节、按 double 对齐的存储
+ * @return 0 成功，-1 参数无效
+ */
+int moving_median_init(MovingMedianFB* fb, uint32_t window, void* storage);
+
+/**
+ * @brief 从实例池创建滑动中值并分配存储
+ * @param window 窗口长度
+ * @return 功能块指针，失败返回 NULL
+ */
+MovingMedianFB* moving_median_create(uint32_t window);
+
+/**
+ * @brief 销毁滑动中值（释放 create() 分配的存储）
+ * @param fb 功能块指针
+ */
+void moving_median_destroy(MovingMedianFB* fb);
+
+/**
+ * @brief 写入一个样本并返回窗口中值
+ * @param fb 功能块指针
+ * @param input 输入信号
+ * @return 窗口内样本的中值（样本数为偶数时取中间两个的平均）
+ */
+double moving_median_compute(MovingMedianFB* fb, double input);
+
+/**
+ * @brief 重置：清空窗口
+ * @param fb 功能块指针
+ */
+void moving_median_reset(MovingMedianFB* fb);
+
+/* ========== 变化率 ========== */
+
+/**
+ * @brief 变化率所需的存储字节数
+ * @param window 窗口长度
+ * @return 字节数
+ */
+size_t slope_storage_size(uint32_t window);
+
+/**
+ * @brief 就地初始化变化率
+ * @param fb 功能块指针
+ * @param window 窗口长度 [2, FB_WINDOW_MAX]
+ * @param period 采样周期（秒），> 0
+ * @param storage 至少 slope_storage_size(window) 字节、按 double 对齐的存储
+ * @return 0 成功，-1 参数无效
+ */
+int slope_init(SlopeFB* fb, uint32_t window, double period, void* storage);
+
+/**
+ * @brief 从实例池创建变化率并分配存储
+ * @param window 窗口长度
+ * @param period 采样周期（秒）
+ * @return 功能块指针，失败返回 NULL
+ */
+SlopeFB* slope_create(uint32_t window, double period);
+
+/**
+ * @brief 销毁变化率（释放 create() 分配的存储）
+ * @param fb 功能块指针
+ */
+void slope_destroy(SlopeFB* fb);
+
+/**
+ * @brief 写入一个样本并返回窗口内的最小二乘斜率
+ * @param fb 功能块指针
+ * @param input 输入信号
+ * @return 变化率（单位/秒），样本少于 2 个时为 0
+ */
+double slope_compute(SlopeFB* fb, double input);
+
+/**
+ * @brief 修改采样周期（只影响斜率的时间单位换算）
+ * @param fb 功能块指针
+ * @param period 采样周期（秒），> 0
+ * @return 0 成功，-1 参数无效
+ */
+int slope_set_period(SlopeFB* fb, double period);
+
+/**
+ * @brief 重置：清空窗口
+ * @param fb 功能块指针
+ */
+void slope_reset(SlopeFB* fb);
+
+#endif // FB_WINDOW_H
@@ -31,16 +31,157 @@
 #include "../function_blocks/fb_first_order.h"
 #include "../function_blocks/fb_ramp.h"
 #include "../function_blocks/fb_limit.h"
+#include "../function_blocks/fb_pool.h"
+#include "../function_blocks/fb_registry.h"
+#include "../function_blocks/fb_journal.h"
+#include "../function_blocks/fb_timing.h"
+#include "py_registry.h"
 #include "../runtime/logger.h"
 
 extern PyTypeObject PIDType;
 extern PyTypeObject FirstOrderType;
 extern PyTypeObject RampType;
 extern PyTypeObject LimitType;
+extern PyTypeObject DeadTimeType;
+extern PyTypeObject MovingAverageType;
+extern PyTypeObject MovingMedianType;
+extern PyTypeObject SlopeType;
+extern PyTypeObject IIRType;
+extern PyTypeObject Lookup1DType;
+extern PyTypeObject Lookup2DType;
+extern PyTypeObject TONType;
+extern PyTypeObject TOFType;
+extern PyTypeObject TPType;
+extern PyTypeObject CTUType;
+extern PyTypeObject CTDType;
+extern PyTypeObject R_TRIGType;
+extern PyTypeObject F_TRIGType;
+extern PyTypeObject AutoTunerType;
+extern PyTypeObject KalmanFilterType;
+extern PyTypeObject FBViewType;
+extern PyTypeObject PIDBankType;
+extern PyTypeObject FirstOrderArrayType;
+extern PyTypeObject RampArrayType;
+extern PyTypeObject LimitArrayType;
+extern PyTypeObject DeadTimeArrayType;
+extern PyTypeObject MovingAverageArrayType;
+extern PyTypeObject MovingMedianArrayType;
+extern PyTypeObject SlopeArrayType;
+extern PyTypeObject IIRArrayType;
+extern PyTypeObject TimerArrayType;
+extern PyTypeObject CounterArrayType;
+extern PyTypeObject TriggerArrayType;
+extern PyTypeObject NetworkType;
+extern PyTypeObject STProgramType;
+extern PyTypeObject RetainType;
+extern PyTypeObject RetainVarType;
+extern PyTypeObject RecorderType;
 
 PyDoc_STRVAR(module_doc, "PLCopen function blocks");
 
+static const FunctionBlockType pool_types[] = {
+    FB_TYPE_PID, FB_TYPE_FIRST_ORDER, FB_TYPE_RAMP, FB_TYPE_LIMIT, FB_TYPE_DEAD_TIME,
+    FB_TYPE_MOVING_AVERAGE, FB_TYPE_MOVING_MEDIAN, FB_TYPE_SLOPE, FB_TYPE_IIR,
+    FB_TYPE_LOOKUP_1D, FB_TYPE_LOOKUP_2D, FB_TYPE_TON, FB_TYPE_TOF, FB_TYPE_TP, FB_TYPE_CTU,
+    FB_TYPE_CTD, FB_TYPE_R_TRIG, FB_TYPE_F_TRIG, FB_TYPE_AUTOTUNE,
+    FB_TYPE_KALMAN
+};
+
+// configure_pools(capacity, storage_bytes=0)：按容量重新预分配各类型实例池、附属存储区和注册表
+static PyObject* plcopen_configure_pools(PyObject* Py_UNUSED(module), PyObject* args) {
+    Py_ssize_t capacity;
+    Py_ssize_t storage_bytes = 0;
+    if (!PyArg_ParseTuple(args, "n|n:configure_pools", &capacity, &storage_bytes)) {
+        return NULL;
+    }
+    if (capacity <= 0) {
+        PyErr_SetString(PyExc_ValueError, "capacity must be positive");
+        return NULL;
+    }
+    if (storage_bytes < 0) {
+        PyErr_SetString(PyExc_ValueError, "storage_bytes must not be negative");
+        return NULL;
+    }
+
+    if (fb_pool_configure((size_t)capacity, (size_t)storage_bytes) != 0) {
+        PyErr_SetString(PyExc_RuntimeError, "实例池配置失败：仍有实例在使用或内存不足");
+        return NULL;
+    }
+
+    // 注册表容纳全部池内实例，另留 capacity 个位置给网络中的功能块
+    size_t registry_capacity = (size_t)capacity * (sizeof(pool_types) / sizeof(pool_types[0]) + 1);
+    if (fb_registry_configure(registry_capacity) != 0) {
+        PyErr_SetString(PyExc_RuntimeError, "注册表配置失败：仍有功能块登记或内存不足");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* stats_to_dict(const FBPoolStats* stats) {
+    return Py_BuildValue("{s:n,s:n,s:n,s:K,s:n}",
+                         "capacity", (Py_ssize_t)stats->capacity,
+                         "used", (Py_ssize_t)stats->used,
+                         "peak", (Py_ssize_t)stats->peak,
+                         "failures", (unsigned long long)stats->failures,
+                         "slot_size", (Py_ssize_t)stats->slot_size);
+}
+
+// pool_stats() -> {类型名: {capacity, used, peak, failures, slot_size}}，
+// 附属存储区以 "storage" 为键，容量和占用以字节计
+static PyObject* plcopen_pool_stats(PyObject* Py_UNUSED(module), PyObject* Py_UNUSED(args)) {
+    PyObject* result = PyDict_New();
+    if (!result) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < sizeof(pool_types) / sizeof(pool_types[0]); i++) {
+        FBPoolStats stats;
+        fb_pool_get_stats(pool_types[i], &stats);
+
+        PyObject* entry = stats_to_dict(&stats);
+        if (!entry || PyDict_SetItemString(result, fb_pool_type_name(pool_types[i]), entry) < 0) {
+            Py_XDECREF(entry);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(entry);
+    }
+
+    FBPoolStats stats;
+    fb_pool_get_storage_stats(&stats);
+    PyObject* entry = stats_to_dict(&stats);
+    if (!entry || PyDict_SetItemString(result, "storage", entry) < 0) {
+        Py_XDECREF(entry);
+        Py_DECREF(result);
+        return NULL;
+    }
+    Py_DECREF(entry);
+
+    return result;
+}
+
 static PyMethodDef plcopen_methods[] = {
+    {"configure_pools", plcopen_configure_pools, METH_VARARGS,
+     "Preallocate per-type instance pools and the block storage arena"},
+    {"pool_stats", plcopen_pool_stats, METH_NOARGS,
+     "Return instance pool occupancy per function block type"},
+    {"blocks", fb_py_blocks, METH_NOARGS,
+     "List registered function blocks as dicts {id, type, name, object}"},
+    {"find_block", fb_py_find_block, METH_O,
+     "Find a registered function block by id or name, None if absent"},
+    {"set_block_param", (PyCFunction)(void(*)(void))fb_py_set_block_param, METH_FASTCALL,
+     "Change a parameter of a registered function block by id or name"},
+    {"timing", fb_py_timing, METH_NOARGS,
+     "List execution time counters of registered function blocks (FB_TIMING builds)"},
+    {"timing_reset", fb_py_timing_reset, METH_NOARGS,
+     "Reset execution time counters of all registered function blocks"},
+    {"timing_dump", fb_py_timing_dump, METH_VARARGS,
+     "Write execution time counters to a text file, sorted by total time"},
+    {"journal", fb_py_journal, METH_VARARGS,
+     "Return function block change records with seq greater than since"},
+    {"journal_stats", fb_py_journal_stats, METH_NOARGS,
+     "Return function block event counts per type and the number of clamped parameters"},
     {NULL, NULL, 0, NULL}
 };
 
@@ -59,6 +200,40 @@ PyMODINIT_FUNC PyInit_plcopen_c(void) {
     if (PyType_Ready(&FirstOrderType) < 0) return NULL;
     if (PyType_Ready(&RampType) < 0) return NULL;
     if (PyType_Ready(&LimitType) < 0) return NULL;
+    if (PyType_Ready(&DeadTimeType) < 0) return NULL;
+    if (PyType_Ready(&MovingAverageType) < 0) return NULL;
+    if (PyType_Ready(&MovingMedianType) < 0) return NULL;
+    if (PyType_Ready(&SlopeType) < 0) return NULL;
+    if (PyType_Ready(&IIRType) < 0) return NULL;
+    if (PyType_Ready(&Lookup1DType) < 0) return NULL;
+    if (PyType_Ready(&Lookup2DType) < 0) return NULL;
+    if (PyType_Ready(&TONType) < 0) return NULL;
+    if (PyType_Ready(&TOFType) < 0) return NULL;
+    if (PyType_Ready(&TPType) < 0) return NULL;
+    if (PyType_Ready(&CTUType) < 0) return NULL;
+    if (PyType_Ready(&CTDType) < 0) return NULL;
+    if (PyType_Ready(&R_TRIGType) < 0) return NULL;
+    if (PyType_Ready(&F_TRIGType) < 0) return NULL;
+    if (PyType_Ready(&AutoTunerType) < 0) return NULL;
+    if (PyType_Ready(&KalmanFilterType) < 0) return NULL;
+    if (PyType_Ready(&FBViewType) < 0) return NULL;
+    if (PyType_Ready(&PIDBankType) < 0) return NULL;
+    if (PyType_Ready(&FirstOrderArrayType) < 0) return NULL;
+    if (PyType_Ready(&RampArrayType) < 0) return NULL;
+    if (PyType_Ready(&LimitArrayType) < 0) return NULL;
+    if (PyType_Ready(&DeadTimeArrayType) < 0) return NULL;
+    if (PyType_Ready(&MovingAverageArrayType) < 0) return NULL;
+    if (PyType_Ready(&MovingMedianArrayType) < 0) return NULL;
+    if (PyType_Ready(&SlopeArrayType) < 0) return NULL;
+    if (PyType_Ready(&IIRArrayType) < 0) return NULL;
+    if (PyType_Ready(&TimerArrayType) < 0) return NULL;
+    if (PyType_Ready(&CounterArrayType) < 0) return NULL;
+    if (PyType_Ready(&TriggerArrayType) < 0) return NULL;
+    if (PyType_Ready(&NetworkType) < 0) return NULL;
+    if (PyType_Ready(&STProgramType) < 0) return NULL;
+    if (PyType_Ready(&RetainType) < 0) return NULL;
+    if (PyType_Ready(&RetainVarType) < 0) return NULL;
+    if (PyType_Ready(&RecorderType) < 0) return NULL;
 
     module = PyModule_Create(&plcopen_module);
     if (module == NULL) return NULL;
@@ -91,6 +266,248 @@ PyMODINIT_FUNC PyInit_plcopen_c(void) {
         return NULL;
     }
 
+    Py_INCREF(&DeadTimeType);
+    if (PyModule_AddObject(module, "DeadTime", (PyObject*)&DeadTimeType) < 0) {
+        Py_DECREF(&DeadTimeType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&MovingAverageType);
+    if (PyModule_AddObject(module, "MovingAverage", (PyObject*)&MovingAverageType) < 0) {
+        Py_DECREF(&MovingAverageType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&MovingMedianType);
+    if (PyModule_AddObject(module, "MovingMedian", (PyObject*)&MovingMedianType) < 0) {
+        Py_DECREF(&MovingMedianType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&SlopeType);
+    if (PyModule_AddObject(module, "Slope", (PyObject*)&SlopeType) < 0) {
+        Py_DECREF(&SlopeType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&IIRType);
+    if (PyModule_AddObject(module, "IIR", (PyObject*)&IIRType) < 0) {
+        Py_DECREF(&IIRType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&Lookup1DType);
+    if (PyModule_AddObject(module, "Lookup1D", (PyObject*)&Lookup1DType) < 0) {
+        Py_DECREF(&Lookup1DType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&Lookup2DType);
+    if (PyModule_AddObject(module, "Lookup2D", (PyObject*)&Lookup2DType) < 0) {
+        Py_DECREF(&Lookup2DType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&TONType);
+    if (PyModule_AddObject(module, "TON", (PyObject*)&TONType) < 0) {
+        Py_DECREF(&TONType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&TOFType);
+    if (PyModule_AddObject(module, "TOF", (PyObject*)&TOFType) < 0) {
+        Py_DECREF(&TOFType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&TPType);
+    if (PyModule_AddObject(module, "TP", (PyObject*)&TPType) < 0) {
+        Py_DECREF(&TPType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&CTUType);
+    if (PyModule_AddObject(module, "CTU", (PyObject*)&CTUType) < 0) {
+        Py_DECREF(&CTUType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&CTDType);
+    if (PyModule_AddObject(module, "CTD", (PyObject*)&CTDType) < 0) {
+        Py_DECREF(&CTDType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&R_TRIGType);
+    if (PyModule_AddObject(module, "R_TRIG", (PyObject*)&R_TRIGType) < 0) {
+        Py_DECREF(&R_TRIGType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&F_TRIGType);
+    if (PyModule_AddObject(module, "F_TRIG", (PyObject*)&F_TRIGType) < 0) {
+        Py_DECREF(&F_TRIGType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&AutoTunerType);
+    if (PyModule_AddObject(module, "AutoTuner", (PyObject*)&AutoTunerType) < 0) {
+        Py_DECREF(&AutoTunerType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&KalmanFilterType);
+    if (PyModule_AddObject(module, "KalmanFilter", (PyObject*)&KalmanFilterType) < 0) {
+        Py_DECREF(&KalmanFilterType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&PIDBankType);
+    if (PyModule_AddObject(module, "PIDBank", (PyObject*)&PIDBankType) < 0) {
+        Py_DECREF(&PIDBankType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&FirstOrderArrayType);
+    if (PyModule_AddObject(module, "FirstOrderArray", (PyObject*)&FirstOrderArrayType) < 0) {
+        Py_DECREF(&FirstOrderArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&RampArrayType);
+    if (PyModule_AddObject(module, "RampArray", (PyObject*)&RampArrayType) < 0) {
+        Py_DECREF(&RampArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&LimitArrayType);
+    if (PyModule_AddObject(module, "LimitArray", (PyObject*)&LimitArrayType) < 0) {
+        Py_DECREF(&LimitArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&DeadTimeArrayType);
+    if (PyModule_AddObject(module, "DeadTimeArray", (PyObject*)&DeadTimeArrayType) < 0) {
+        Py_DECREF(&DeadTimeArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&MovingAverageArrayType);
+    if (PyModule_AddObject(module, "MovingAverageArray", (PyObject*)&MovingAverageArrayType) < 0) {
+        Py_DECREF(&MovingAverageArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&MovingMedianArrayType);
+    if (PyModule_AddObject(module, "MovingMedianArray", (PyObject*)&MovingMedianArrayType) < 0) {
+        Py_DECREF(&MovingMedianArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&SlopeArrayType);
+    if (PyModule_AddObject(module, "SlopeArray", (PyObject*)&SlopeArrayType) < 0) {
+        Py_DECREF(&SlopeArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&IIRArrayType);
+    if (PyModule_AddObject(module, "IIRArray", (PyObject*)&IIRArrayType) < 0) {
+        Py_DECREF(&IIRArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&TimerArrayType);
+    if (PyModule_AddObject(module, "TimerArray", (PyObject*)&TimerArrayType) < 0) {
+        Py_DECREF(&TimerArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&CounterArrayType);
+    if (PyModule_AddObject(module, "CounterArray", (PyObject*)&CounterArrayType) < 0) {
+        Py_DECREF(&CounterArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&TriggerArrayType);
+    if (PyModule_AddObject(module, "TriggerArray", (PyObject*)&TriggerArrayType) < 0) {
+        Py_DECREF(&TriggerArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&NetworkType);
+    if (PyModule_AddObject(module, "Network", (PyObject*)&NetworkType) < 0) {
+        Py_DECREF(&NetworkType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&STProgramType);
+    if (PyModule_AddObject(module, "STProgram", (PyObject*)&STProgramType) < 0) {
+        Py_DECREF(&STProgramType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&RetainType);
+    if (PyModule_AddObject(module, "Retain", (PyObject*)&RetainType) < 0) {
+        Py_DECREF(&RetainType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&RetainVarType);
+    if (PyModule_AddObject(module, "RetainVar", (PyObject*)&RetainVarType) < 0) {
+        Py_DECREF(&RetainVarType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&RecorderType);
+    if (PyModule_AddObject(module, "Recorder", (PyObject*)&RecorderType) < 0) {
+        Py_DECREF(&RecorderType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&FBViewType);
+    if (PyModule_AddObject(module, "FBView", (PyObject*)&FBViewType) < 0) {
+        Py_DECREF(&FBViewType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
     PyModule_AddStringConstant(module, "__version__", "0.1.0");
+    PyModule_AddObject(module, "FB_TIMING", PyBool_FromLong(fb_timing_enabled()));
+    // 供嵌入运行时把本模块的事件日志纳入汇总线程（py_embed_attach_journal）
+    PyModule_AddObject(module, "_journal",
+                       PyCapsule_New(fb_journal_default(), FB_JOURNAL_CAPSULE_NAME, NULL));
     return module;
 }
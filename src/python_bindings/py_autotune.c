@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_autotune.c
+ * @brief 继电器反馈自整定功能块 Python 绑定实现
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_autotune.h"
+#include "py_fastcall.h"
+#include "py_pid.h"
+#include "py_registry.h"
+#include <stddef.h>
+
+// AutoTuner Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    AutoTuneFB* at;
+    PyObject* pid;       // 关联的 PID 对象（持有引用）或 NULL
+} AutoTunerObject;
+
+static const char AutoTuner_uninit[] = "实例未初始化";
+
+static const char* const AutoTuner_kwlist[] = {"pid", "relay", "hysteresis", "rule", "cycles",
+                                               "tolerance", "timeout", "auto_apply", NULL};
+
+static const char AutoTuner_param_error[] =
+    "AutoTuner 参数无效：要求 relay 非 0、hysteresis >= 0、cycles 在 [2, 100] 内、"
+    "0 < tolerance < 1、timeout >= 0";
+
+// 析构函数
+static void AutoTuner_dealloc(AutoTunerObject* self) {
+    if (self->at) {
+        autotune_destroy(self->at);
+    }
+    Py_XDECREF(self->pid);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 按 AutoTuner_kwlist 顺序的槽位解析配置；未提供的可选参数为 NULL，*pid_obj 为借用引用
+static int AutoTuner_parse(PyObject* const* slots, PyObject** pid_obj, AutoTuneConfig* config) {
+    const AutoTuneConfig defaults = AUTOTUNE_DEFAULT_CONFIG;
+
+    *config = defaults;
+    if (fastcall_as_double(slots[1], &config->relay) != 0 ||
+        (slots[2] && fastcall_as_double(slots[2], &config->hysteresis) != 0) ||
+        (slots[5] && fastcall_as_double(slots[5], &config->tolerance) != 0) ||
+        (slots[6] && fastcall_as_double(slots[6], &config->timeout) != 0) ||
+        (slots[7] && (config->auto_apply = PyObject_IsTrue(slots[7])) < 0)) {
+        return -1;
+    }
+
+    *pid_obj = slots[0] == Py_None ? NULL : slots[0];
+    if (*pid_obj && !PyObject_TypeCheck(*pid_obj, &PIDType)) {
+        PyErr_SetString(PyExc_TypeError, "pid 必须是 PID 实例或 None");
+        return -1;
+    }
+    if (*pid_obj && !((PIDObject*)*pid_obj)->pid) {
+        PyErr_SetString(PyExc_RuntimeError, "PID 实例未初始化");
+        return -1;
+    }
+
+    if (slots[3]) {
+        const char* rule = PyUnicode_AsUTF8(slots[3]);
+        if (!rule) {
+            return -1;
+        }
+        if (autotune_parse_rule(rule, &config->rule) != 0) {
+            PyErr_Format(PyExc_ValueError,
+                         "unknown tuning rule '%s' (zn, zn_pi, tyreus_luyben, some_overshoot, "
+                         "no_overshoot)", rule);
+            return -1;
+        }
+    }
+    if (slots[4]) {
+        long cycles = PyLong_AsLong(slots[4]);
+        if (cycles == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        config->cycles = cycles < 0 || cycles > 1000 ? 0 : (int)cycles;
+    }
+    return 0;
+}
+
+// 创建 C 功能块；重复调用 __init__ 时中止试验并原地重新初始化，保持 ID 和名称
+static int AutoTuner_setup(AutoTunerObject* self, PyObject* pid_obj,
+                           const AutoTuneConfig* config) {
+    PIDFunctionBlock* pid = pid_obj ? ((PIDObject*)pid_obj)->pid : NULL;
+
+    if (self->at) {
+        AutoTuneFB fresh;
+        if (autotune_init(&fresh, pid, config) != 0) {
+            PyErr_SetString(PyExc_ValueError, AutoTuner_param_error);
+            return -1;
+        }
+        autotune_stop(self->at);
+        fb_reinit(self->at, &fresh, sizeof(fresh));
+    } else {
+        self->at = autotune_create(pid, config);
+        if (!self->at) {
+            PyErr_SetString(PyExc_ValueError, AutoTuner_param_error);
+            return -1;
+        }
+        fb_py_register_owner((PyObject*)self, self->at);
+    }
+
+    Py_XINCREF(pid_obj);
+    Py_XSETREF(self->pid, pid_obj);
+    return 0;
+}
+
+// 构造函数：__init__(self, pid, relay, hysteresis=0.0, rule="zn", cycles=3, tolerance=0.05,
+//                    timeout=0.0, auto_apply=True)
+static int AutoTuner_init(AutoTunerObject* self, PyObject* args, PyObject* kwds) {
+    PyObject* slots[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+    PyObject* pid_obj;
+    AutoTuneConfig config;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOOOOO", (char**)AutoTuner_kwlist,
+                                     &slots[0], &slots[1], &slots[2], &slots[3], &slots[4],
+                                     &slots[5], &slots[6], &slots[7]) ||
+        AutoTuner_parse(slots, &pid_obj, &config) != 0) {
+        return -1;
+    }
+
+    return AutoTuner_setup(self, pid_obj, &config);
+}
+
+// vectorcall 构造：AutoTuner(...) 直接创建实例
+static PyObject* AutoTuner_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                      PyObject* kwnames) {
+    PyObject* slots[8];
+    PyObject* pid_obj;
+    AutoTuneConfig config;
+
+    if (fastcall_unpack("AutoTuner", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        AutoTuner_kwlist, 2, slots) != 0 ||
+        AutoTuner_parse(slots, &pid_obj, &config) != 0) {
+        return NULL;
+    }
+
+    AutoTunerObject* self =
+        (AutoTunerObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (AutoTuner_setup(self, pid_obj, &config) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// start(SP, bias=None)
+static PyObject* AutoTuner_start(AutoTunerObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                 PyObject* kwnames) {
+    static const char* const kwlist[] = {"SP", "bias", NULL};
+    PyObject* slots[2];
+    double SP, bias;
+
+    if (fastcall_unpack("start", args, nargs, kwnames, kwlist, 1, slots) != 0 ||
+        fastcall_as_double(slots[0], &SP) != 0 ||
+        (slots[1] && slots[1] != Py_None && fastcall_as_double(slots[1], &bias) != 0)) {
+        return NULL;
+    }
+    if (!self->at) {
+        PyErr_SetString(PyExc_RuntimeError, AutoTuner_uninit);
+        return NULL;
+    }
+
+    int has_bias = slots[1] && slots[1] != Py_None;
+    if (autotune_start(self->at, SP, has_bias ? &bias : NULL) != 0) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        self->at->state == AUTOTUNE_RUNNING
+                            ? "试验已在进行"
+                            : "启动失败：SP/bias 无效，或继电器两档输出被 PID 输出范围限成同一值");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// compute(PV, dt=0.0) -> float
+static PyObject* AutoTuner_compute(AutoTunerObject* self, PyObject* const* args,
+                                   Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"PV", "dt", NULL};
+    double v[2] = {0.0, 0.0};
+
+    if (fastcall_parse_doubles("compute", args, nargs, kwnames, kwlist, 1, v) != 0) {
+        return NULL;
+    }
+    if (!self->at) {
+        PyErr_SetString(PyExc_RuntimeError, AutoTuner_uninit);
+        return NULL;
+    }
+
+    return PyFloat_FromDouble(autotune_compute(self->at, v[0], v[1]));
+}
+
+// stop()
+static PyObject* AutoTuner_stop(AutoTunerObject* self, PyObject* Py_UNUSED(ignored)) {
+    if (!self->at) {
+        PyErr_SetString(PyExc_RuntimeError, AutoTuner_uninit);
+        return NULL;
+    }
+    autotune_stop(self->at);
+    Py_RETURN_NONE;
+}
+
+// apply()
+static PyObject* AutoTuner_apply(AutoTunerObject* self, PyObject* Py_UNUSED(ignored)) {
+    if (!self->at) {
+        PyErr_SetString(PyExc_RuntimeError, AutoTuner_uninit);
+        return NULL;
+    }
+    if (autotune_apply(self->at) != 0) {
+        PyErr_SetString(PyExc_RuntimeError, self->at->pid ? "尚无整定结果" : "未关联 PID");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// 只读属性：closure 为字段偏移
+static PyObject* AutoTuner_get_double(AutoTunerObject* self, void* closure) {
+    if (!self->at) {
+        PyErr_SetString(PyExc_RuntimeError, AutoTuner_uninit);
+        return NULL;
+    }
+    return PyFloat_FromDouble(*(double*)((char*)self->at + (size_t)closure));
+}
+
+static PyObject* AutoTuner_get_int(AutoTunerObject* self, void* closure) {
+    if (!self->at) {
+        PyErr_SetString(PyExc_RuntimeError, AutoTuner_uninit);
+        return NULL;
+    }
+    return PyLong_FromLong(*(int*)((char*)self->at + (size_t)closure));
+}
+
+static PyObject* AutoTuner_get_state(AutoTunerObject* self, void* Py_UNUSED(closure)) {
+    if (!self->at) {
+        PyErr_SetString(PyExc_RuntimeError, AutoTuner_uninit);
+        return NULL;
+    }
+    return PyUnicode_FromString(autotune_state_name(self->at->state));
+}
+
+static PyObject* AutoTuner_get_running(AutoTunerObject* self, void* Py_UNUSED(closure)) {
+    return PyBool_FromLong(self->at && self->at->state == AUTOTUNE_RUNNING);
+}
+
+static PyObject* AutoTuner_get_rule(AutoTunerObject* self, void* Py_UNUSED(closure)) {
+    if (!self->at) {
+        PyErr_SetString(PyExc_RuntimeError, AutoTuner_uninit);
+        return NULL;
+    }
+    return PyUnicode_FromString(autotune_rule_name(self->at->config.rule));
+}
+
+static PyObject* AutoTuner_get_pid(AutoTunerObject* self, void* Py_UNUSED(closure)) {
+    PyObject* pid = self->pid ? self->pid : Py_None;
+    Py_INCREF(pid);
+    return pid;
+}
+
+// result：{Kp, Ki, Kd, Ku, Tu}，尚无结果时为 None
+static PyObject* AutoTuner_get_result(AutoTunerObject* self, void* Py_UNUSED(closure)) {
+    if (!self->at || self->at->state != AUTOTUNE_DONE) {
+        Py_RETURN_NONE;
+    }
+    const AutoTuneFB* at = self->at;
+    return Py_BuildValue("{s:d,s:d,s:d,s:d,s:d}", "Kp", at->Kp, "Ki", at->Ki, "Kd", at->Kd,
+                         "Ku", at->Ku, "Tu", at->Tu);
+}
+
+#define AUTOTUNE_DOUBLE(name, field, doc) \
+    {name, (getter)AutoTuner_get_double, NULL, doc, (void*)offsetof(AutoTuneFB, field)}
+
+static PyGetSetDef AutoTuner_getset[] = {
+    {"state", (getter)AutoTuner_get_state, NULL,
+     "状态：idle、running、done、failed（只读）", NULL},
+    {"running", (getter)AutoTuner_get_running, NULL, "试验是否进行中（只读）", NULL},
+    {"rule", (getter)AutoTuner_get_rule, NULL, "整定规则（只读）", NULL},
+    {"pid", (getter)AutoTuner_get_pid, NULL, "关联的 PID（只读）", NULL},
+    {"result", (getter)AutoTuner_get_result, NULL,
+     "建议参数 {Kp, Ki, Kd, Ku, Tu}，尚无结果时为 None（只读）", NULL},
+    AUTOTUNE_DOUBLE("relay", config.relay, "继电器幅值（只读）"),
+    AUTOTUNE_DOUBLE("hysteresis", config.hysteresis, "滞环（只读）"),
+    AUTOTUNE_DOUBLE("SP", SP, "试验设定值（只读）"),
+    AUTOTUNE_DOUBLE("bias", bias, "继电器中心输出（只读）"),
+    AUTOTUNE_DOUBLE("output", output, "最近一次输出（只读）"),
+    AUTOTUNE_DOUBLE("elapsed", elapsed, "试验已进行时间（秒，只读）"),
+    AUTOTUNE_DOUBLE("period", period, "最近一个完整周期的周期（秒，只读）"),
+    AUTOTUNE_DOUBLE("amplitude", amplitude, "最近一个完整周期的 PV 振幅（只读）"),
+    AUTOTUNE_DOUBLE("Ku", Ku, "临界增益（只读）"),
+    AUTOTUNE_DOUBLE("Tu", Tu, "临界周期（秒，只读）"),
+    AUTOTUNE_DOUBLE("Kp", Kp, "建议比例系数（只读）"),
+    AUTOTUNE_DOUBLE("Ki", Ki, "建议积分系数（只读）"),
+    AUTOTUNE_DOUBLE("Kd", Kd, "建议微分系数（只读）"),
+    {"periods", (getter)AutoTuner_get_int, NULL, "已完成的振荡周期数（只读）",
+     (void*)offsetof(AutoTuneFB, periods)},
+    FB_REGISTRY_GETSET(AutoTunerObject, at),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef AutoTuner_methods[] = {
+    {"start", (PyCFunction)(void(*)(void))AutoTuner_start, METH_FASTCALL | METH_KEYWORDS,
+     "开始继电器试验（关联的 PID 切到手动并跟踪继电器输出）\n\n参数:\n  SP: 试验设定值\n"
+     "  bias: 继电器中心输出，None 表示取 PID 上一周期的输出"},
+    {"compute", (PyCFunction)(void(*)(void))AutoTuner_compute, METH_FASTCALL | METH_KEYWORDS,
+     "执行一个周期\n\n参数:\n  PV: 过程变量\n  dt: 可选，时间步长（秒），0 表示自动计算\n\n"
+     "返回:\n  float: 试验期间为继电器输出（代替 PID 输出），其他状态为最近一次输出"},
+    {"stop", (PyCFunction)AutoTuner_stop, METH_NOARGS,
+     "中止试验，关联的 PID 以原参数无扰切回自动"},
+    {"apply", (PyCFunction)AutoTuner_apply, METH_NOARGS, "把建议参数无扰写入关联的 PID"},
+    {NULL, NULL, 0, NULL}
+};
+
+// 类型定义
+PyTypeObject AutoTunerType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.AutoTuner",
+    .tp_doc = "继电器反馈自整定功能块（Åström–Hägglund）\n\n"
+              "AutoTuner(pid, relay, hysteresis=0.0, rule=\"zn\", cycles=3, tolerance=0.05,\n"
+              "          timeout=0.0, auto_apply=True)\n\n"
+              "试验期间以继电器输出代替 PID 输出，逐周期检测振荡周期和振幅（O(1)），\n"
+              "收敛后给出 Kp/Ki/Kd，并无扰写入关联的 PID（auto_apply）。",
+    .tp_basicsize = sizeof(AutoTunerObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)AutoTuner_init,
+    .tp_dealloc = (destructor)AutoTuner_dealloc,
+    .tp_methods = AutoTuner_methods,
+    .tp_getset = AutoTuner_getset,
+    .tp_vectorcall = AutoTuner_vectorcall,
+};
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_dead_time.c
+ * @brief 纯滞后功能块 Python 绑定实现
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_dead_time.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include "py_view.h"
+#include <stddef.h>
+
+// DeadTime Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    DeadTimeFB* dt;
+} DeadTimeObject;
+
+// 析构函数
+static void DeadTime_dealloc(DeadTimeObject* self) {
+    if (self->dt) {
+        dead_time_destroy(self->dt);
+    }
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static const char* const DeadTime_kwlist[] = {"delay", "period", "max_delay", "interpolate",
+                                              "initial", NULL};
+
+static const char DeadTime_param_error[] =
+    "DeadTime 参数无效：要求 delay >= 0、period > 0，且延迟不超过 16777216 个周期";
+
+// 按参数 {delay, period, max_delay, interpolate, initial} 创建 C 功能块
+static int DeadTime_setup(DeadTimeObject* self, const double* v) {
+    if (!(v[0] >= 0.0) || !(v[1] > 0.0)) {
+        PyErr_SetString(PyExc_ValueError, DeadTime_param_error);
+        return -1;
+    }
+
+    // 重复调用 __init__ 时原地替换缓冲区，保持 ID 和注册表名称
+    if (self->dt) {
+        DeadTimeFB fresh;
+        if (dead_time_init(&fresh, v[0], v[1], v[2], v[3] != 0.0, v[4]) != 0) {
+            PyErr_SetString(PyExc_MemoryError,
+                            "DeadTime 初始化失败：延迟过长或附属存储区不足");
+            return -1;
+        }
+        dead_time_release(self->dt);
+        fb_reinit(self->dt, &fresh, sizeof(fresh));
+        return 0;
+    }
+
+    self->dt = dead_time_create(v[0], v[1], v[2], v[3] != 0.0, v[4]);
+    if (!self->dt) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "DeadTime 创建失败：延迟过长、实例池、附属存储区或注册表已满");
+        return -1;
+    }
+    fb_py_register_owner((PyObject*)self, self->dt);
+
+    return 0;
+}
+
+// 解析构造参数：delay、period 必填
+static int DeadTime_parse(const char* fname, PyObject* const* args, Py_ssize_t nargs,
+                          PyObject* kwnames, double* v) {
+    PyObject* slots[5];
+
+    if (fastcall_unpack(fname, args, nargs, kwnames, DeadTime_kwlist, 2, slots) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < 5; i++) {
+        if (!slots[i]) {
+            continue;
+        }
+        if (i == 3) {
+            int flag = PyObject_IsTrue(slots[i]);
+            if (flag < 0) {
+                return -1;
+            }
+            v[i] = flag;
+        } else if (fastcall_as_double(slots[i], &v[i]) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 构造函数：__init__(self, delay, period, max_delay=0.0, interpolate=False, initial=0.0)
+static int DeadTime_init(DeadTimeObject* self, PyObject* args, PyObject* kwds) {
+    double v[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    int interpolate = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "dd|dpd", (char**)DeadTime_kwlist,
+                                     &v[0], &v[1], &v[2], &interpolate, &v[4])) {
+        return -1;
+    }
+    v[3] = interpolate;
+
+    return DeadTime_setup(self, v);
+}
+
+// vectorcall 构造：DeadTime(...) 直接创建实例
+static PyObject* DeadTime_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                     PyObject* kwnames) {
+    double v[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+
+    if (DeadTime_parse("DeadTime", args, PyVectorcall_NARGS(nargsf), kwnames, v) != 0) {
+        return NULL;
+    }
+
+    DeadTimeObject* self =
+        (DeadTimeObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (DeadTime_setup(self, v) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(input) -> float
+static PyObject* DeadTime_compute(DeadTimeObject* self, PyObject* arg) {
+    double input;
+
+    if (fastcall_as_double(arg, &input) != 0) {
+        return NULL;
+    }
+
+    if (!self->dt) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return NULL;
+    }
+
+    return PyFloat_FromDouble(dead_time_compute(self->dt, input));
+}
+
+// set_delay(delay)
+static int DeadTime_apply_delay(DeadTimeObject* self, PyObject* value) {
+    double delay;
+
+    if (!self->dt) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return -1;
+    }
+    if (fastcall_as_double(value, &delay) != 0) {
+        return -1;
+    }
+    if (dead_time_set_delay(self->dt, delay) != 0) {
+        PyErr_SetString(PyExc_ValueError, "delay 必须非负且不超过 max_delay");
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject* DeadTime_set_delay(DeadTimeObject* self, PyObject* arg) {
+    if (DeadTime_apply_delay(self, arg) != 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// reset(initial=None)：缓冲区填充为 initial，省略时使用上次的初值
+static PyObject* DeadTime_reset(DeadTimeObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    if (fastcall_check_nargs("reset", nargs, 0, 1) != 0) {
+        return NULL;
+    }
+    if (!self->dt) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return NULL;
+    }
+
+    double initial = self->dt->params.initial;
+    if (nargs == 1 && args[0] != Py_None && fastcall_as_double(args[0], &initial) != 0) {
+        return NULL;
+    }
+
+    dead_time_reset(self->dt, initial);
+    Py_RETURN_NONE;
+}
+
+static const char* const DeadTime_param_fields[] = {"delay", "period", "initial"};
+
+_Static_assert(offsetof(DeadTimeParams, initial) == 2 * sizeof(double),
+               "DeadTimeParams 前 3 个字段必须为连续 double");
+
+static double* DeadTime_params_data(PyObject* owner) {
+    DeadTimeFB* dt = ((DeadTimeObject*)owner)->dt;
+    return dt ? &dt->params.delay : NULL;
+}
+
+// 只读 double 属性：closure 为字段在 DeadTimeFB 中的偏移
+static PyObject* DeadTime_get_field(DeadTimeObject* self, void* closure) {
+    if (!self->dt) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return NULL;
+    }
+    return PyFloat_FromDouble(*(double*)((char*)self->dt + (size_t)closure));
+}
+
+static int DeadTime_set_delay_attr(DeadTimeObject* self, PyObject* value,
+                                   void* Py_UNUSED(closure)) {
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 delay");
+        return -1;
+    }
+    return DeadTime_apply_delay(self, value);
+}
+
+static PyObject* DeadTime_get_max_delay(DeadTimeObject* self, void* Py_UNUSED(closure)) {
+    if (!self->dt) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return NULL;
+    }
+    return PyFloat_FromDouble(dead_time_max_delay(self->dt));
+}
+
+static PyObject* DeadTime_get_interpolate(DeadTimeObject* self, void* Py_UNUSED(closure)) {
+    if (!self->dt) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return NULL;
+    }
+    return PyBool_FromLong(self->dt->params.interpolate);
+}
+
+static PyObject* DeadTime_get_capacity(DeadTimeObject* self, void* Py_UNUSED(closure)) {
+    if (!self->dt) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return NULL;
+    }
+    return PyLong_FromUnsignedLong((unsigned long)self->dt->mask + 1);
+}
+
+// params -> FBView
+static PyObject* DeadTime_get_params_view(DeadTimeObject* self, void* Py_UNUSED(closure)) {
+    return fb_view_new((PyObject*)self, DeadTime_params_data, DeadTime_param_fields, 3);
+}
+
+#define DEAD_TIME_FIELD(name, member, doc) \
+    {name, (getter)DeadTime_get_field, NULL, doc, (void*)offsetof(DeadTimeFB, member)}
+
+// 属性表
+static PyGetSetDef DeadTime_getset[] = {
+    {"delay", (getter)DeadTime_get_field, (setter)DeadTime_set_delay_attr,
+     "延迟时间（秒），可在线修改到 max_delay", (void*)offsetof(DeadTimeFB, params.delay)},
+    DEAD_TIME_FIELD("period", params.period, "采样周期（秒，只读）"),
+    DEAD_TIME_FIELD("initial", params.initial, "缓冲区初值（只读，reset() 时修改）"),
+    DEAD_TIME_FIELD("output", output, "最近一次输出（只读）"),
+    {"max_delay", (getter)DeadTime_get_max_delay, NULL, "缓冲区容量允许的最大延迟（秒）", NULL},
+    {"interpolate", (getter)DeadTime_get_interpolate, NULL, "是否线性插值（只读）", NULL},
+    {"capacity", (getter)DeadTime_get_capacity, NULL, "环形缓冲区样本数（2 的幂）", NULL},
+    {"params", (getter)DeadTime_get_params_view, NULL,
+     "参数的零拷贝只读视图 {delay, period, initial}", NULL},
+    FB_REGISTRY_GETSET(DeadTimeObject, dt),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+// 方法表
+static PyMethodDef DeadTime_methods[] = {
+    {"compute", (PyCFunction)DeadTime_compute, METH_O,
+     "写入本周期输入并返回 delay 秒之前的输入（每个 period 调用一次）\n\n"
+     "参数:\n  input: 输入信号\n\n返回:\n  float: 延迟后的信号"},
+    {"set_delay", (PyCFunction)DeadTime_set_delay, METH_O,
+     "在线修改延迟时间\n\n参数:\n  delay: 延迟时间（秒），不超过 max_delay"},
+    {"reset", (PyCFunction)(void(*)(void))DeadTime_reset, METH_FASTCALL,
+     "重置缓冲区\n\n参数:\n  initial: 可选，填充值，省略时使用当前初值"},
+    {NULL, NULL, 0, NULL}
+};
+
+// 类型定义
+PyTypeObject DeadTimeType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.DeadTime",
+    .tp_doc = "纯滞后功能块\n\n"
+              "传递函数：H(s) = e^(-L*s)。DeadTime(delay, period, max_delay=0.0, "
+              "interpolate=False, initial=0.0)：\n"
+              "每个 period 调用一次 compute()，输出 delay 秒之前的输入；样本保存在\n"
+              "按 max(delay, max_delay) 预分配的 2 的幂环形缓冲区中。",
+    .tp_basicsize = sizeof(DeadTimeObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)DeadTime_init,
+    .tp_dealloc = (destructor)DeadTime_dealloc,
+    .tp_methods = DeadTime_methods,
+    .tp_getset = DeadTime_getset,
+    .tp_vectorcall = DeadTime_vectorcall,
+};
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_fastcall.h
+ * @brief METH_FASTCALL / vectorcall 参数解析辅助函数
+ *
+ * 功能块方法是脚本中调用最频繁的接口。METH_VARARGS 每次调用都要构造参数
+ * 元组（带关键字时还要构造字典）并解析格式字符串；这里直接在
+ * vectorcall 参数数组上按参数名解析，不分配任何对象。
+ */
+
+#ifndef PY_FASTCALL_H
+#define PY_FASTCALL_H
+
+#include <Python.h>
+
+// 单个函数支持的最大参数个数
+#define FASTCALL_MAX_ARGS 12
+
+/**
+ * @brief 把 Python 数值转换为 double（float 精确类型走快速路径）
+ * @param obj Python 对象
+ * @param out 输出值
+ * @return 0 成功，-1 失败（已设置异常）
+ */
+static inline int fastcall_as_double(PyObject* obj, double* out) {
+    if (PyFloat_CheckExact(obj)) {
+        *out = PyFloat_AS_DOUBLE(obj);
+        return 0;
+    }
+
+    double value = PyFloat_AsDouble(obj);
+    if (value == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+
+    *out = value;
+    return 0;
+}
+
+/**
+ * @brief 把位置参数和关键字参数按参数名放入槽位
+ * @param fname 函数名（用于错误信息）
+ * @param args 位置参数，后接关键字参数值
+ * @param nargs 位置参数个数
+ * @param kwnames 关键字参数名元组，可为 NULL
+ * @param kwlist 参数名列表（NULL 结尾，最多 FASTCALL_MAX_ARGS 个）
+ * @param required 必需参数个数（kwlist 前 required 个）
+ * @param slots 输出槽位（借用引用），未提供的参数为 NULL
+ * @return 0 成功，-1 失败（已设置 TypeError）
+ */
+static inline int fastcall_unpack(const char* fname, PyObject* const* args, Py_ssize_t nargs,
+                                  PyObject* kwnames, const char* const* kwlist,
+                                  Py_ssize_t required, PyObject** slots) {
+    Py_ssize_t total = 0;
+    while (kwlist[total]) {
+        slots[total++] = NULL;
+    }
+
+    if (nargs > total) {
+        PyErr_Format(PyExc_TypeError, "%s() takes at most %zd arguments (%zd given)",
+                     fname, total, nargs);
+        return -1;
+    }
+
+    for (Py_ssize_t i = 0; i < nargs; i++) {
+        slots[i] = args[i];
+    }
+
+    Py_ssize_t nkw = kwnames ? PyTuple_GET_SIZE(kwnames) : 0;
+    for (Py_ssize_t k = 0; k < nkw; k++) {
+        PyObject* key = PyTuple_GET_ITEM(kwnames, k);
+        Py_ssize_t j = 0;
+        while (j < total && PyUnicode_CompareWithASCIIString(key, kwlist[j]) != 0) {
+            j++;
+        }
+
+        if (j == total) {
+            PyErr_Format(PyExc_TypeError, "%s() got an unexpected keyword argument '%U'",
+                         fname, key);
+            return -1;
+        }
+        if (slots[j]) {
+            PyErr_Format(PyExc_TypeError, "%s() got multiple values for argument '%s'",
+                         fname, kwlist[j]);
+            return -1;
+        }
+        slots[j] = args[nargs + k];
+    }
+
+    for (Py_ssize_t j = 0; j < required; j++) {
+        if (!slots[j]) {
+            PyErr_Format(PyExc_TypeError, "%s() missing required argument '%s' (pos %zd)",
+                         fname, kwlist[j], j + 1);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 解析全部为 double 的参数
+ * @param values 输出值；未提供的可选参数保持调用者设置的默认值
+ * @return 0 成功，-1 失败（已设置异常）
+ *
+ * 其余参数同 fastcall_unpack()。
+ */
+static inline int fastcall_parse_doubles(const char* fname, PyObject* const* args,
+                                         Py_ssize_t nargs, PyObject* kwnames,
+                                         const char* const* kwlist, Py_ssize_t required,
+                                         double* values) {
+    PyObject* slots[FASTCALL_MAX_ARGS];
+
+    if (fastcall_unpack(fname, args, nargs, kwnames, kwlist, required, slots) != 0) {
+        return -1;
+    }
+
+    for (Py_ssize_t i = 0; kwlist[i]; i++) {
+        if (slots[i] && fastcall_as_double(slots[i], &values[i]) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 检查位置参数个数（用于不接受关键字的 METH_FASTCALL 方法）
+ * @return 0 成功，-1 失败（已设置 TypeError）
+ */
+static inline int fastcall_check_nargs(const char* fname, Py_ssize_t nargs,
+                                       Py_ssize_t min, Py_ssize_t max) {
+    if (nargs < min || nargs > max) {
+        if (min == max) {
+            PyErr_Format(PyExc_TypeError, "%s() takes exactly %zd arguments (%zd given)",
+                         fname, min, nargs);
+        } else {
+            PyErr_Format(PyExc_TypeError, "%s() takes from %zd to %zd arguments (%zd given)",
+                         fname, min, max, nargs);
+        }
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 以元组/字典形式的参数调用 vectorcall 函数（用于 tp_new 等传统调用路径）
+ * @param func vectorcall 实现
+ * @param callable 被调用对象
+ * @param args 位置参数元组
+ * @param kwds 关键字参数字典，可为 NULL
+ * @return func 的返回值
+ */
+static inline PyObject* fastcall_from_tuple(vectorcallfunc func, PyObject* callable,
+                                            PyObject* args, PyObject* kwds) {
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t nkw = kwds ? PyDict_GET_SIZE(kwds) : 0;
+    PyObject* stack[FASTCALL_MAX_ARGS];
+
+    if (nargs + nkw > FASTCALL_MAX_ARGS) {
+        PyErr_SetString(PyExc_TypeError, "too many arguments");
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < nargs; i++) {
+        stack[i] = PyTuple_GET_ITEM(args, i);
+    }
+
+    PyObject* kwnames = NULL;
+    if (nkw > 0) {
+        kwnames = PyTuple_New(nkw);
+        if (!kwnames) {
+            return NULL;
+        }
+
+        PyObject* key;
+        PyObject* value;
+        Py_ssize_t pos = 0, k = 0;
+        while (PyDict_Next(kwds, &pos, &key, &value)) {
+            Py_INCREF(key);
+            PyTuple_SET_ITEM(kwnames, k, key);
+            stack[nargs + k] = value;
+            k++;
+        }
+    }
+
+    PyObject* result = func(callable, stack, (size_t)nargs, kwnames);
+    Py_XDECREF(kwnames);
+    return result;
+}
+
+#endif // PY_FASTCALL_H
@@ -0,0 +1,1712 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_fb_arrays.c
+ * @brief 功能块实例数组 Python 绑定实现
+ *
+ * FirstOrderArray / RampArray / LimitArray 各保存 n 个独立通道的 C 功能块，
+ * DeadTimeArray 保存一个 n 通道的 DeadTimeBank（缓冲区按行交错存放），
+ * MovingAverageArray / MovingMedianArray / SlopeArray 的 n 个窗口共用一次分配的存储，
+ * IIRArray 保存一个 n 通道共用系数的 IIRBank（状态按 SoA 存放，SIMD 内核计算），
+ * TimerArray / CounterArray / TriggerArray 保存一个 n 通道的 IECBank，
+ * compute() 一次处理整个输入数组：输入接受任意 float64 缓冲区（零拷贝）或
+ * 普通序列，结果写入调用者提供的缓冲区，或返回内部输出数组的只读
+ * memoryview。每个通道直接调用对应的标量 C 函数，结果与单实例逐位一致，
+ * 整个过程不创建逐元素的 Python 对象。
+ * 每个数组整体登记到注册表（FB_TYPE_ARRAY），各通道不单独登记。
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_first_order.h"
+#include "../function_blocks/fb_ramp.h"
+#include "../function_blocks/fb_limit.h"
+#include "../function_blocks/fb_dead_time.h"
+#include "../function_blocks/fb_window.h"
+#include "../function_blocks/fb_iec.h"
+#include "../function_blocks/fb_precision.h"
+#include "../function_blocks/fb_registry.h"
+#include "py_iir.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include "py_view.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 通道数上限
+#define FB_ARRAY_MAX_CHANNELS (1 << 20)
+
+// 所有实例数组类型的公共头部
+#define FB_ARRAY_HEAD            \
+    PyObject_HEAD                \
+    Py_ssize_t n;                \
+    Py_ssize_t stride;           \
+    double* output;              \
+    double* scratch;             \
+    FBPrecisionArray* reduced;   /* precision 为 f32 / q16 时的实例（不使用 blocks） */ \
+    FunctionBlock base;          /* 整个数组登记为一个 FB_TYPE_ARRAY 条目 */          \
+    FunctionBlock* registered;   /* 指向 base，供 FB_REGISTRY_GETSET 使用 */
+
+typedef struct {
+    FB_ARRAY_HEAD
+} FBArrayObject;
+
+typedef struct {
+    FB_ARRAY_HEAD
+    FirstOrderFunctionBlock* blocks;
+    FunctionBlock clock;         // dt 自动计算的共用时间戳
+} FirstOrderArrayObject;
+
+typedef struct {
+    FB_ARRAY_HEAD
+    RampFB* blocks;
+} RampArrayObject;
+
+typedef struct {
+    FB_ARRAY_HEAD
+    LimitFB* blocks;
+} LimitArrayObject;
+
+typedef struct {
+    FB_ARRAY_HEAD
+    DeadTimeBank* bank;
+} DeadTimeArrayObject;
+
+// 滑动窗口类数组：blocks 为 MovingAverageFB / MovingMedianFB / SlopeFB 数组
+typedef struct {
+    FB_ARRAY_HEAD
+    FunctionBlockType type;
+    void* blocks;
+    void* storage;               // n 段窗口存储
+} WindowArrayObject;
+
+typedef struct {
+    FB_ARRAY_HEAD
+    IIRBank* bank;
+} IIRArrayObject;
+
+// 定时器 / 计数器 / 边沿检测数组
+typedef struct {
+    FB_ARRAY_HEAD
+    IECBank* bank;
+    double* load_scratch;        // 序列形式 load 的临时存储
+} IECArrayObject;
+
+/* ========== 公共部分 ========== */
+
+// 分配实例和公共缓冲区，block_size 为单个 C 功能块大小，blocks 返回功能块数组
+// （block_size 为 0 时不分配功能块数组）
+static FBArrayObject* fb_array_alloc(PyTypeObject* type, PyObject* n_obj,
+                                     size_t block_size, void** blocks) {
+    Py_ssize_t n = PyNumber_AsSsize_t(n_obj, PyExc_OverflowError);
+    if (n == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (n < 1 || n > FB_ARRAY_MAX_CHANNELS) {
+        PyErr_Format(PyExc_ValueError, "n must be in [1, %d]", FB_ARRAY_MAX_CHANNELS);
+        return NULL;
+    }
+
+    FBArrayObject* self = (FBArrayObject*)type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    self->n = n;
+    self->stride = sizeof(double);
+    self->output = (double*)calloc((size_t)n, sizeof(double));
+    *blocks = block_size ? calloc((size_t)n, block_size) : NULL;
+    if (!self->output || (block_size && !*blocks)) {
+        free(*blocks);
+        *blocks = NULL;
+        Py_DECREF(self);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    // 整个数组登记为一个条目（各通道不单独登记，不支持 set_block_param）
+    self->base.type = FB_TYPE_ARRAY;
+    if (fb_registry_register(&self->base, NULL, (PyObject*)self) == 0) {
+        free(*blocks);
+        *blocks = NULL;
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_MemoryError, "实例数组创建失败：注册表已满");
+        return NULL;
+    }
+    self->registered = &self->base;
+
+    return self;
+}
+
+static void fb_array_free(FBArrayObject* self, void* blocks) {
+    fb_registry_unregister(self->base.id);
+    fb_precision_array_destroy(self->reduced);
+    free(blocks);
+    free(self->output);
+    free(self->scratch);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static Py_ssize_t FBArray_length(FBArrayObject* self) {
+    return self->n;
+}
+
+static int FBArray_getbuffer(FBArrayObject* self, Py_buffer* view, int flags) {
+    return fb_export_doubles(view, (PyObject*)self, self->output, &self->n, &self->stride, flags);
+}
+
+// 解析通道下标（支持负数下标）
+static int FBArray_index(FBArrayObject* self, PyObject* obj, Py_ssize_t* index) {
+    Py_ssize_t i = PyNumber_AsSsize_t(obj, PyExc_IndexError);
+    if (i == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (i < 0) {
+        i += self->n;
+    }
+    if (i < 0 || i >= self->n) {
+        PyErr_SetString(PyExc_IndexError, "channel index out of range");
+        return -1;
+    }
+    *index = i;
+    return 0;
+}
+
+// 取得输入数组和可选输出数组；*dst 为结果写入位置
+static int FBArray_begin(FBArrayObject* self, PyObject* in_obj, PyObject* out_obj,
+                         Py_buffer* in_view, Py_buffer* out_view,
+                         double** src, double** dst) {
+    if (!self->scratch && !PyObject_CheckBuffer(in_obj)) {
+        self->scratch = (double*)malloc((size_t)self->n * sizeof(double));
+        if (!self->scratch) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+
+    out_view->obj = NULL;
+    if (fb_get_doubles(in_obj, "inputs", self->n, 0, in_view, self->scratch, src) != 0) {
+        return -1;
+    }
+
+    *dst = self->output;
+    if (out_obj && out_obj != Py_None &&
+        fb_get_doubles(out_obj, "out", self->n, 1, out_view, NULL, dst) != 0) {
+        if (in_view->obj) {
+            PyBuffer_Release(in_view);
+        }
+        return -1;
+    }
+
+    return 0;
+}
+
+// 释放缓冲区并返回 out 或内部输出的 memoryview
+static PyObject* FBArray_finish(FBArrayObject* self, PyObject* out_obj,
+                                Py_buffer* in_view, Py_buffer* out_view) {
+    if (in_view->obj) {
+        PyBuffer_Release(in_view);
+    }
+
+    if (out_view->obj) {
+        PyBuffer_Release(out_view);
+        Py_INCREF(out_obj);
+        return out_obj;
+    }
+
+    return PyMemoryView_FromObject((PyObject*)self);
+}
+
+// 解析 precision 参数，缺省或 None 为 "f64"
+static int FBArray_parse_precision(PyObject* obj, FBPrecision* precision) {
+    *precision = FB_PRECISION_F64;
+    if (!obj || obj == Py_None) {
+        return 0;
+    }
+
+    const char* name = PyUnicode_Check(obj) ? PyUnicode_AsUTF8(obj) : NULL;
+    if (!name || fb_precision_parse(name, precision) != 0) {
+        PyErr_SetString(PyExc_ValueError, "precision must be 'f64', 'f32' or 'q16'");
+        return -1;
+    }
+    return 0;
+}
+
+// f32 / q16：创建同精度实例，失败时释放 self 并设置异常
+static int FBArray_init_reduced(FBArrayObject* self, FunctionBlockType type,
+                                FBPrecision precision, const double* params) {
+    self->reduced = fb_precision_array_create(type, precision, (size_t)self->n, params);
+    if (!self->reduced) {
+        PyErr_Format(PyExc_ValueError, "Failed to initialize %s array (invalid parameters)",
+                     fb_precision_name(precision));
+        Py_DECREF(self);
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject* FBArray_get_precision(FBArrayObject* self, void* Py_UNUSED(closure)) {
+    return PyUnicode_FromString(
+        fb_precision_name(self->reduced ? self->reduced->precision : FB_PRECISION_F64));
+}
+
+static PyGetSetDef FBArray_precision_getset[] = {
+    FB_REGISTRY_GETSET(FBArrayObject, registered),
+    {"precision", (getter)FBArray_get_precision, NULL,
+     "Numeric precision of parameters and state: 'f64', 'f32' or 'q16'", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PySequenceMethods FBArray_as_sequence = {
+    .sq_length = (lenfunc)FBArray_length,
+};
+
+static PyBufferProcs FBArray_as_buffer = {
+    .bf_getbuffer = (getbufferproc)FBArray_getbuffer,
+    .bf_releasebuffer = NULL,
+};
+
+/* ========== FirstOrderArray ========== */
+
+static void FirstOrderArray_dealloc(FirstOrderArrayObject* self) {
+    fb_array_free((FBArrayObject*)self, self->blocks);
+}
+
+// FirstOrderArray(n, T=1.0, precision="f64")
+static PyObject* FirstOrderArray_vectorcall(PyObject* type, PyObject* const* args,
+                                            size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "T", "precision", NULL};
+    PyObject* slots[3];
+    double T = 1.0;
+    FBPrecision precision;
+
+    if (fastcall_unpack("FirstOrderArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 1, slots) != 0 ||
+        (slots[1] && fastcall_as_double(slots[1], &T) != 0) ||
+        FBArray_parse_precision(slots[2], &precision) != 0) {
+        return NULL;
+    }
+
+    void* blocks;
+    int reduced = precision != FB_PRECISION_F64;
+    FirstOrderArrayObject* self = (FirstOrderArrayObject*)fb_array_alloc(
+        (PyTypeObject*)type, slots[0], reduced ? 0 : sizeof(FirstOrderFunctionBlock), &blocks);
+    if (!self) {
+        return NULL;
+    }
+    if (reduced) {
+        return FBArray_init_reduced((FBArrayObject*)self, FB_TYPE_FIRST_ORDER, precision, &T) == 0
+                   ? (PyObject*)self : NULL;
+    }
+
+    self->blocks = (FirstOrderFunctionBlock*)blocks;
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        first_order_init(&self->blocks[i], T);
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(inputs, out=None, dt=0.0)
+static PyObject* FirstOrderArray_compute(FirstOrderArrayObject* self, PyObject* const* args,
+                                         Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"inputs", "out", "dt", NULL};
+    PyObject* slots[3];
+    double dt = 0.0;
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0 ||
+        (slots[2] && fastcall_as_double(slots[2], &dt) != 0)) {
+        return NULL;
+    }
+
+    Py_buffer in_view, out_view;
+    double* src;
+    double* dst;
+    if (FBArray_begin((FBArrayObject*)self, slots[0], slots[1], &in_view, &out_view,
+                      &src, &dst) != 0) {
+        return NULL;
+    }
+
+    // 所有通道共用一次 dt 计算
+    if (dt <= 0.0) {
+        dt = fb_auto_dt(&self->clock);
+    }
+
+    if (self->reduced) {
+        fb_precision_array_compute(self->reduced, src, NULL, dt, dst);
+    } else {
+        for (Py_ssize_t i = 0; i < self->n; i++) {
+            dst[i] = first_order_compute(&self->blocks[i], src[i], dt);
+        }
+    }
+    if (dst != self->output) {
+        memcpy(self->output, dst, (size_t)self->n * sizeof(double));
+    }
+
+    return FBArray_finish((FBArrayObject*)self, slots[1], &in_view, &out_view);
+}
+
+// set_time_constant(index, T)
+static PyObject* FirstOrderArray_set_time_constant(FirstOrderArrayObject* self,
+                                                   PyObject* const* args, Py_ssize_t nargs) {
+    Py_ssize_t index;
+    double T;
+
+    if (fastcall_check_nargs("set_time_constant", nargs, 2, 2) != 0 ||
+        FBArray_index((FBArrayObject*)self, args[0], &index) != 0 ||
+        fastcall_as_double(args[1], &T) != 0) {
+        return NULL;
+    }
+
+    if (self->reduced) {
+        fb_precision_array_set_params(self->reduced, (size_t)index, &T);
+    } else {
+        first_order_set_time_constant(&self->blocks[index], T);
+    }
+    Py_RETURN_NONE;
+}
+
+// reset()
+static PyObject* FirstOrderArray_reset(FirstOrderArrayObject* self, PyObject* Py_UNUSED(ignored)) {
+    fb_precision_array_reset(self->reduced, 0.0);
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        if (!self->reduced) {
+            self->blocks[i].state.prev_output = 0.0;
+        }
+        self->output[i] = 0.0;
+    }
+    self->clock.last_update_time = 0.0;
+    Py_RETURN_NONE;
+}
+
+// 传统调用路径（如 FirstOrderArray.__new__(FirstOrderArray, ...)）转到 vectorcall 实现
+static PyObject* FirstOrderArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(FirstOrderArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyMethodDef FirstOrderArray_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))FirstOrderArray_compute, METH_FASTCALL | METH_KEYWORDS,
+     "计算全部通道\n\n参数:\n  inputs: 长度 n 的 float64 缓冲区或序列\n"
+     "  out: 可选，可写 float64 输出缓冲区\n  dt: 时间步长（秒），0 表示自动计算\n\n"
+     "返回:\n  out，或内部输出缓冲区的 memoryview"},
+    {"set_time_constant", (PyCFunction)(void(*)(void))FirstOrderArray_set_time_constant,
+     METH_FASTCALL, "修改单个通道的时间常数\n\n参数:\n  index: 通道下标\n  T: 时间常数（秒）"},
+    {"reset", (PyCFunction)FirstOrderArray_reset, METH_NOARGS, "重置全部通道（输出清零）"},
+    {NULL, NULL, 0, NULL}
+};
+
+PyTypeObject FirstOrderArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.FirstOrderArray",
+    .tp_doc = "一阶惯性实例数组\n\nFirstOrderArray(n, T=1.0, precision=\"f64\")：n 个独立通道，"
+              "一次计算整个输入数组；precision 为 \"f32\" / \"q16\" 时参数和状态按该精度存放。",
+    .tp_basicsize = sizeof(FirstOrderArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = FirstOrderArray_new,
+    .tp_dealloc = (destructor)FirstOrderArray_dealloc,
+    .tp_methods = FirstOrderArray_methods,
+    .tp_getset = FBArray_precision_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = FirstOrderArray_vectorcall,
+};
+
+/* ========== RampArray ========== */
+
+static void RampArray_dealloc(RampArrayObject* self) {
+    fb_array_free((FBArrayObject*)self, self->blocks);
+}
+
+// RampArray(n, rising_rate=1.0, falling_rate=1.0, precision="f64")
+static PyObject* RampArray_vectorcall(PyObject* type, PyObject* const* args,
+                                      size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "rising_rate", "falling_rate", "precision", NULL};
+    PyObject* slots[4];
+    double rates[2] = {1.0, 1.0};
+    FBPrecision precision;
+
+    if (fastcall_unpack("RampArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 1, slots) != 0 ||
+        (slots[1] && fastcall_as_double(slots[1], &rates[0]) != 0) ||
+        (slots[2] && fastcall_as_double(slots[2], &rates[1]) != 0) ||
+        FBArray_parse_precision(slots[3], &precision) != 0) {
+        return NULL;
+    }
+
+    void* blocks;
+    int reduced = precision != FB_PRECISION_F64;
+    RampArrayObject* self = (RampArrayObject*)fb_array_alloc(
+        (PyTypeObject*)type, slots[0], reduced ? 0 : sizeof(RampFB), &blocks);
+    if (!self) {
+        return NULL;
+    }
+    if (reduced) {
+        return FBArray_init_reduced((FBArrayObject*)self, FB_TYPE_RAMP, precision, rates) == 0
+                   ? (PyObject*)self : NULL;
+    }
+
+    self->blocks = (RampFB*)blocks;
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        if (ramp_init(&self->blocks[i], rates[0], rates[1]) != 0) {
+            PyErr_SetString(PyExc_ValueError, "Failed to initialize RampArray");
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(inputs, dt, out=None)
+static PyObject* RampArray_compute(RampArrayObject* self, PyObject* const* args,
+                                   Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"inputs", "dt", "out", NULL};
+    PyObject* slots[3];
+    double dt;
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 2, slots) != 0 ||
+        fastcall_as_double(slots[1], &dt) != 0) {
+        return NULL;
+    }
+
+    Py_buffer in_view, out_view;
+    double* src;
+    double* dst;
+    if (FBArray_begin((FBArrayObject*)self, slots[0], slots[2], &in_view, &out_view,
+                      &src, &dst) != 0) {
+        return NULL;
+    }
+
+    if (self->reduced) {
+        fb_precision_array_compute(self->reduced, src, NULL, dt, dst);
+    } else {
+        for (Py_ssize_t i = 0; i < self->n; i++) {
+            dst[i] = ramp_compute(&self->blocks[i], src[i], dt);
+        }
+    }
+    if (dst != self->output) {
+        memcpy(self->output, dst, (size_t)self->n * sizeof(double));
+    }
+
+    return FBArray_finish((FBArrayObject*)self, slots[2], &in_view, &out_view);
+}
+
+// set_params(index, rising_rate, falling_rate)
+static PyObject* RampArray_set_params(RampArrayObject* self, PyObject* const* args,
+                                      Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"index", "rising_rate", "falling_rate", NULL};
+    PyObject* slots[3];
+    Py_ssize_t index;
+    double rising_rate, falling_rate;
+
+    if (fastcall_unpack("set_params", args, nargs, kwnames, kwlist, 3, slots) != 0 ||
+        FBArray_index((FBArrayObject*)self, slots[0], &index) != 0 ||
+        fastcall_as_double(slots[1], &rising_rate) != 0 ||
+        fastcall_as_double(slots[2], &falling_rate) != 0) {
+        return NULL;
+    }
+
+    double rates[2] = {rising_rate, falling_rate};
+    if (self->reduced ? fb_precision_array_set_params(self->reduced, (size_t)index, rates) != 0
+                      : ramp_set_params(&self->blocks[index], rising_rate, falling_rate) != 0) {
+        PyErr_SetString(PyExc_ValueError, "Invalid parameters");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// reset(initial_value=0.0)
+static PyObject* RampArray_reset(RampArrayObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    double initial_value = 0.0;
+
+    if (fastcall_check_nargs("reset", nargs, 0, 1) != 0 ||
+        (nargs == 1 && fastcall_as_double(args[0], &initial_value) != 0)) {
+        return NULL;
+    }
+
+    fb_precision_array_reset(self->reduced, initial_value);
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        if (!self->reduced) {
+            ramp_reset(&self->blocks[i], initial_value);
+        }
+        self->output[i] = initial_value;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// 传统调用路径（如 RampArray.__new__(RampArray, ...)）转到 vectorcall 实现
+static PyObject* RampArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(RampArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyMethodDef RampArray_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))RampArray_compute, METH_FASTCALL | METH_KEYWORDS,
+     "Compute all channels\n\ninputs: float64 buffer or sequence of length n\n"
+     "dt: time step (s)\nout: optional writable float64 buffer"},
+    {"set_params", (PyCFunction)(void(*)(void))RampArray_set_params, METH_FASTCALL | METH_KEYWORDS,
+     "Set rates of one channel"},
+    {"reset", (PyCFunction)(void(*)(void))RampArray_reset, METH_FASTCALL,
+     "Reset all channels"},
+    {NULL, NULL, 0, NULL}
+};
+
+PyTypeObject RampArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.RampArray",
+    .tp_doc = "Array of independent Ramp channels\n\n"
+              "RampArray(n, rising_rate=1.0, falling_rate=1.0, precision=\"f64\")",
+    .tp_basicsize = sizeof(RampArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = RampArray_new,
+    .tp_dealloc = (destructor)RampArray_dealloc,
+    .tp_methods = RampArray_methods,
+    .tp_getset = FBArray_precision_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = RampArray_vectorcall,
+};
+
+/* ========== LimitArray ========== */
+
+static void LimitArray_dealloc(LimitArrayObject* self) {
+    fb_array_free((FBArrayObject*)self, self->blocks);
+}
+
+// LimitArray(n, min_value=0.0, max_value=100.0, precision="f64")
+static PyObject* LimitArray_vectorcall(PyObject* type, PyObject* const* args,
+                                       size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "min_value", "max_value", "precision", NULL};
+    PyObject* slots[4];
+    double bounds[2] = {0.0, 100.0};
+    FBPrecision precision;
+
+    if (fastcall_unpack("LimitArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 1, slots) != 0 ||
+        (slots[1] && fastcall_as_double(slots[1], &bounds[0]) != 0) ||
+        (slots[2] && fastcall_as_double(slots[2], &bounds[1]) != 0) ||
+        FBArray_parse_precision(slots[3], &precision) != 0) {
+        return NULL;
+    }
+
+    void* blocks;
+    int reduced = precision != FB_PRECISION_F64;
+    LimitArrayObject* self = (LimitArrayObject*)fb_array_alloc(
+        (PyTypeObject*)type, slots[0], reduced ? 0 : sizeof(LimitFB), &blocks);
+    if (!self) {
+        return NULL;
+    }
+    if (reduced) {
+        return FBArray_init_reduced((FBArrayObject*)self, FB_TYPE_LIMIT, precision, bounds) == 0
+                   ? (PyObject*)self : NULL;
+    }
+
+    self->blocks = (LimitFB*)blocks;
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        if (limit_init(&self->blocks[i], bounds[0], bounds[1]) != 0) {
+            PyErr_SetString(PyExc_ValueError, "Failed to initialize LimitArray (min > max)");
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(inputs, out=None)
+static PyObject* LimitArray_compute(LimitArrayObject* self, PyObject* const* args,
+                                    Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"inputs", "out", NULL};
+    PyObject* slots[2];
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+
+    Py_buffer in_view, out_view;
+    double* src;
+    double* dst;
+    if (FBArray_begin((FBArrayObject*)self, slots[0], slots[1], &in_view, &out_view,
+                      &src, &dst) != 0) {
+        return NULL;
+    }
+
+    if (self->reduced) {
+        fb_precision_array_compute(self->reduced, src, NULL, 0.0, dst);
+    } else {
+        for (Py_ssize_t i = 0; i < self->n; i++) {
+            dst[i] = limit_compute(&self->blocks[i], src[i]);
+        }
+    }
+    if (dst != self->output) {
+        memcpy(self->output, dst, (size_t)self->n * sizeof(double));
+    }
+
+    return FBArray_finish((FBArrayObject*)self, slots[1], &in_view, &out_view);
+}
+
+// set_params(index, min_value, max_value)
+static PyObject* LimitArray_set_params(LimitArrayObject* self, PyObject* const* args,
+                                       Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"index", "min_value", "max_value", NULL};
+    PyObject* slots[3];
+    Py_ssize_t index;
+    double min_value, max_value;
+
+    if (fastcall_unpack("set_params", args, nargs, kwnames, kwlist, 3, slots) != 0 ||
+        FBArray_index((FBArrayObject*)self, slots[0], &index) != 0 ||
+        fastcall_as_double(slots[1], &min_value) != 0 ||
+        fastcall_as_double(slots[2], &max_value) != 0) {
+        return NULL;
+    }
+
+    double bounds[2] = {min_value, max_value};
+    if (self->reduced ? fb_precision_array_set_params(self->reduced, (size_t)index, bounds) != 0
+                      : limit_set_params(&self->blocks[index], min_value, max_value) != 0) {
+        PyErr_SetString(PyExc_ValueError, "Invalid parameters (min > max)");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// 传统调用路径（如 LimitArray.__new__(LimitArray, ...)）转到 vectorcall 实现
+static PyObject* LimitArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(LimitArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyMethodDef LimitArray_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))LimitArray_compute, METH_FASTCALL | METH_KEYWORDS,
+     "Compute all channels\n\ninputs: float64 buffer or sequence of length n\n"
+     "out: optional writable float64 buffer"},
+    {"set_params", (PyCFunction)(void(*)(void))LimitArray_set_params, METH_FASTCALL | METH_KEYWORDS,
+     "Set bounds of one channel"},
+    {NULL, NULL, 0, NULL}
+};
+
+PyTypeObject LimitArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.LimitArray",
+    .tp_doc = "Array of independent Limit channels\n\n"
+              "LimitArray(n, min_value=0.0, max_value=100.0, precision=\"f64\")",
+    .tp_basicsize = sizeof(LimitArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = LimitArray_new,
+    .tp_dealloc = (destructor)LimitArray_dealloc,
+    .tp_methods = LimitArray_methods,
+    .tp_getset = FBArray_precision_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = LimitArray_vectorcall,
+};
+
+/* ========== DeadTimeArray ========== */
+
+static void DeadTimeArray_dealloc(DeadTimeArrayObject* self) {
+    dead_time_bank_destroy(self->bank);
+    fb_array_free((FBArrayObject*)self, NULL);
+}
+
+// DeadTimeArray(n, delay, period, max_delay=0.0, interpolate=False, initial=0.0)
+static PyObject* DeadTimeArray_vectorcall(PyObject* type, PyObject* const* args,
+                                          size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "delay", "period", "max_delay", "interpolate",
+                                         "initial", NULL};
+    PyObject* slots[6];
+    double delay, period, max_delay = 0.0, initial = 0.0;
+    int interpolate = 0;
+
+    if (fastcall_unpack("DeadTimeArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 3, slots) != 0 ||
+        fastcall_as_double(slots[1], &delay) != 0 ||
+        fastcall_as_double(slots[2], &period) != 0 ||
+        (slots[3] && fastcall_as_double(slots[3], &max_delay) != 0) ||
+        (slots[4] && (interpolate = PyObject_IsTrue(slots[4])) < 0) ||
+        (slots[5] && fastcall_as_double(slots[5], &initial) != 0)) {
+        return NULL;
+    }
+
+    void* blocks;
+    DeadTimeArrayObject* self = (DeadTimeArrayObject*)fb_array_alloc(
+        (PyTypeObject*)type, slots[0], 0, &blocks);
+    if (!self) {
+        return NULL;
+    }
+
+    self->bank = dead_time_bank_create((size_t)self->n, delay, period, max_delay,
+                                       interpolate, initial);
+    if (!self->bank) {
+        PyErr_SetString(PyExc_ValueError, "Failed to initialize DeadTimeArray "
+                        "(delay must be >= 0, period > 0, at most 16777216 periods)");
+        Py_DECREF(self);
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        self->output[i] = initial;
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(inputs, out=None)
+static PyObject* DeadTimeArray_compute(DeadTimeArrayObject* self, PyObject* const* args,
+                                       Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"inputs", "out", NULL};
+    PyObject* slots[2];
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+
+    Py_buffer in_view, out_view;
+    double* src;
+    double* dst;
+    if (FBArray_begin((FBArrayObject*)self, slots[0], slots[1], &in_view, &out_view,
+                      &src, &dst) != 0) {
+        return NULL;
+    }
+
+    dead_time_bank_compute(self->bank, src, dst);
+    if (dst != self->output) {
+        memcpy(self->output, dst, (size_t)self->n * sizeof(double));
+    }
+
+    return FBArray_finish((FBArrayObject*)self, slots[1], &in_view, &out_view);
+}
+
+// set_delay(index, delay)
+static PyObject* DeadTimeArray_set_delay(DeadTimeArrayObject* self, PyObject* const* args,
+                                         Py_ssize_t nargs) {
+    Py_ssize_t index;
+    double delay;
+
+    if (fastcall_check_nargs("set_delay", nargs, 2, 2) != 0 ||
+        FBArray_index((FBArrayObject*)self, args[0], &index) != 0 ||
+        fastcall_as_double(args[1], &delay) != 0) {
+        return NULL;
+    }
+
+    if (dead_time_bank_set_delay(self->bank, (size_t)index, delay) != 0) {
+        PyErr_SetString(PyExc_ValueError, "delay must be >= 0 and <= max_delay");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// get_delay(index) -> float
+static PyObject* DeadTimeArray_get_delay(DeadTimeArrayObject* self, PyObject* arg) {
+    Py_ssize_t index;
+
+    if (FBArray_index((FBArrayObject*)self, arg, &index) != 0) {
+        return NULL;
+    }
+    return PyFloat_FromDouble(self->bank->delay[index]);
+}
+
+// reset(initial=None)
+static PyObject* DeadTimeArray_reset(DeadTimeArrayObject* self, PyObject* const* args,
+                                     Py_ssize_t nargs) {
+    double initial = self->bank->initial;
+
+    if (fastcall_check_nargs("reset", nargs, 0, 1) != 0 ||
+        (nargs == 1 && args[0] != Py_None && fastcall_as_double(args[0], &initial) != 0)) {
+        return NULL;
+    }
+
+    dead_time_bank_reset(self->bank, initial);
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        self->output[i] = initial;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* DeadTimeArray_get_max_delay(DeadTimeArrayObject* self,
+                                             void* Py_UNUSED(closure)) {
+    return PyFloat_FromDouble(dead_time_bank_max_delay(self->bank));
+}
+
+static PyObject* DeadTimeArray_get_period(DeadTimeArrayObject* self, void* Py_UNUSED(closure)) {
+    return PyFloat_FromDouble(self->bank->period);
+}
+
+static PyObject* DeadTimeArray_get_capacity(DeadTimeArrayObject* self,
+                                            void* Py_UNUSED(closure)) {
+    return PyLong_FromUnsignedLong((unsigned long)self->bank->mask + 1);
+}
+
+// 传统调用路径（如 DeadTimeArray.__new__(DeadTimeArray, ...)）转到 vectorcall 实现
+static PyObject* DeadTimeArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(DeadTimeArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyGetSetDef DeadTimeArray_getset[] = {
+    FB_REGISTRY_GETSET(FBArrayObject, registered),
+    {"period", (getter)DeadTimeArray_get_period, NULL, "Sample period in seconds", NULL},
+    {"max_delay", (getter)DeadTimeArray_get_max_delay, NULL,
+     "Largest delay the preallocated buffer can hold", NULL},
+    {"capacity", (getter)DeadTimeArray_get_capacity, NULL,
+     "Ring buffer rows (power of two)", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef DeadTimeArray_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))DeadTimeArray_compute, METH_FASTCALL | METH_KEYWORDS,
+     "Push one sample per channel and return the delayed values\n\n"
+     "inputs: float64 buffer or sequence of length n\n"
+     "out: optional writable float64 buffer"},
+    {"set_delay", (PyCFunction)(void(*)(void))DeadTimeArray_set_delay, METH_FASTCALL,
+     "Set delay of one channel (up to max_delay)"},
+    {"get_delay", (PyCFunction)DeadTimeArray_get_delay, METH_O, "Delay of one channel"},
+    {"reset", (PyCFunction)(void(*)(void))DeadTimeArray_reset, METH_FASTCALL,
+     "Fill all buffers with initial (defaults to the current initial value)"},
+    {NULL, NULL, 0, NULL}
+};
+
+PyTypeObject DeadTimeArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.DeadTimeArray",
+    .tp_doc = "Array of independent DeadTime channels sharing one ring buffer\n\n"
+              "DeadTimeArray(n, delay, period, max_delay=0.0, interpolate=False, initial=0.0)",
+    .tp_basicsize = sizeof(DeadTimeArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = DeadTimeArray_new,
+    .tp_dealloc = (destructor)DeadTimeArray_dealloc,
+    .tp_methods = DeadTimeArray_methods,
+    .tp_getset = DeadTimeArray_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = DeadTimeArray_vectorcall,
+};
+
+/* ========== MovingAverageArray / MovingMedianArray / SlopeArray ========== */
+
+static void WindowArray_dealloc(WindowArrayObject* self) {
+    free(self->storage);
+    fb_array_free((FBArrayObject*)self, self->blocks);
+}
+
+// 创建 n 个窗口功能块，窗口存储一次分配、按通道切分
+static PyObject* WindowArray_create(PyTypeObject* type, FunctionBlockType fb_type,
+                                    PyObject* n_obj, PyObject* window_obj, double period) {
+    uint32_t min = fb_type == FB_TYPE_SLOPE ? 2 : 1;
+    long window = PyLong_AsLong(window_obj);
+    if (window == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (window < (long)min || window > (long)FB_WINDOW_MAX) {
+        PyErr_Format(PyExc_ValueError, "window must be in [%u, %u]", min, FB_WINDOW_MAX);
+        return NULL;
+    }
+    if (fb_type == FB_TYPE_SLOPE && !(period > 0.0 && period < 1e9)) {
+        PyErr_SetString(PyExc_ValueError, "period must be positive");
+        return NULL;
+    }
+
+    size_t block_size, storage_size;
+    switch (fb_type) {
+    case FB_TYPE_MOVING_AVERAGE:
+        block_size = sizeof(MovingAverageFB);
+        storage_size = moving_average_storage_size((uint32_t)window);
+        break;
+    case FB_TYPE_MOVING_MEDIAN:
+        block_size = sizeof(MovingMedianFB);
+        storage_size = moving_median_storage_size((uint32_t)window);
+        break;
+    default:
+        block_size = sizeof(SlopeFB);
+        storage_size = slope_storage_size((uint32_t)window);
+        break;
+    }
+
+    void* blocks;
+    WindowArrayObject* self = (WindowArrayObject*)fb_array_alloc(type, n_obj, block_size,
+                                                                 &blocks);
+    if (!self) {
+        return NULL;
+    }
+    self->type = fb_type;
+    self->blocks = blocks;
+
+    if ((size_t)self->n > SIZE_MAX / storage_size ||
+        !(self->storage = malloc((size_t)self->n * storage_size))) {
+        Py_DECREF(self);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        char* storage = (char*)self->storage + (size_t)i * storage_size;
+        char* block = (char*)self->blocks + (size_t)i * block_size;
+        switch (fb_type) {
+        case FB_TYPE_MOVING_AVERAGE:
+            moving_average_init((MovingAverageFB*)block, (uint32_t)window, storage);
+            break;
+        case FB_TYPE_MOVING_MEDIAN:
+            moving_median_init((MovingMedianFB*)block, (uint32_t)window, storage);
+            break;
+        default:
+            slope_init((SlopeFB*)block, (uint32_t)window, period, storage);
+            break;
+        }
+    }
+
+    return (PyObject*)self;
+}
+
+// MovingAverageArray(n, window)
+static PyObject* MovingAverageArray_vectorcall(PyObject* type, PyObject* const* args,
+                                               size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "window", NULL};
+    PyObject* slots[2];
+
+    if (fastcall_unpack("MovingAverageArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 2, slots) != 0) {
+        return NULL;
+    }
+    return WindowArray_create((PyTypeObject*)type, FB_TYPE_MOVING_AVERAGE, slots[0], slots[1],
+                              0.0);
+}
+
+// MovingMedianArray(n, window)
+static PyObject* MovingMedianArray_vectorcall(PyObject* type, PyObject* const* args,
+                                              size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "window", NULL};
+    PyObject* slots[2];
+
+    if (fastcall_unpack("MovingMedianArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 2, slots) != 0) {
+        return NULL;
+    }
+    return WindowArray_create((PyTypeObject*)type, FB_TYPE_MOVING_MEDIAN, slots[0], slots[1],
+                              0.0);
+}
+
+// SlopeArray(n, window, period)
+static PyObject* SlopeArray_vectorcall(PyObject* type, PyObject* const* args,
+                                       size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "window", "period", NULL};
+    PyObject* slots[3];
+    double period;
+
+    if (fastcall_unpack("SlopeArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 3, slots) != 0 ||
+        fastcall_as_double(slots[2], &period) != 0) {
+        return NULL;
+    }
+    return WindowArray_create((PyTypeObject*)type, FB_TYPE_SLOPE, slots[0], slots[1], period);
+}
+
+// compute(inputs, out=None)
+static PyObject* WindowArray_compute(WindowArrayObject* self, PyObject* const* args,
+                                     Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"inputs", "out", NULL};
+    PyObject* slots[2];
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+
+    Py_buffer in_view, out_view;
+    double* src;
+    double* dst;
+    if (FBArray_begin((FBArrayObject*)self, slots[0], slots[1], &in_view, &out_view,
+                      &src, &dst) != 0) {
+        return NULL;
+    }
+
+    switch (self->type) {
+    case FB_TYPE_MOVING_AVERAGE: {
+        MovingAverageFB* blocks = (MovingAverageFB*)self->blocks;
+        for (Py_ssize_t i = 0; i < self->n; i++) {
+            dst[i] = moving_average_compute(&blocks[i], src[i]);
+        }
+        break;
+    }
+    case FB_TYPE_MOVING_MEDIAN: {
+        MovingMedianFB* blocks = (MovingMedianFB*)self->blocks;
+        for (Py_ssize_t i = 0; i < self->n; i++) {
+            dst[i] = moving_median_compute(&blocks[i], src[i]);
+        }
+        break;
+    }
+    default: {
+        SlopeFB* blocks = (SlopeFB*)self->blocks;
+        for (Py_ssize_t i = 0; i < self->n; i++) {
+            dst[i] = slope_compute(&blocks[i], src[i]);
+        }
+        break;
+    }
+    }
+    if (dst != self->output) {
+        memcpy(self->output, dst, (size_t)self->n * sizeof(double));
+    }
+
+    return FBArray_finish((FBArrayObject*)self, slots[1], &in_view, &out_view);
+}
+
+// reset()
+static PyObject* WindowArray_reset(WindowArrayObject* self, PyObject* Py_UNUSED(ignored)) {
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        switch (self->type) {
+        case FB_TYPE_MOVING_AVERAGE:
+            moving_average_reset(&((MovingAverageFB*)self->blocks)[i]);
+            break;
+        case FB_TYPE_MOVING_MEDIAN:
+            moving_median_reset(&((MovingMedianFB*)self->blocks)[i]);
+            break;
+        default:
+            slope_reset(&((SlopeFB*)self->blocks)[i]);
+            break;
+        }
+        self->output[i] = 0.0;
+    }
+    Py_RETURN_NONE;
+}
+
+// window 属性（所有通道相同）
+static PyObject* WindowArray_get_window(WindowArrayObject* self, void* Py_UNUSED(closure)) {
+    return PyLong_FromUnsignedLong(((MovingAverageFB*)self->blocks)->window);
+}
+
+// 传统调用路径转到 vectorcall 实现
+static PyObject* MovingAverageArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(MovingAverageArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyObject* MovingMedianArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(MovingMedianArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyObject* SlopeArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(SlopeArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyGetSetDef WindowArray_getset[] = {
+    FB_REGISTRY_GETSET(FBArrayObject, registered),
+    {"window", (getter)WindowArray_get_window, NULL, "Window length in samples", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef WindowArray_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))WindowArray_compute, METH_FASTCALL | METH_KEYWORDS,
+     "Push one sample per channel and return the filtered values\n\n"
+     "inputs: float64 buffer or sequence of length n\n"
+     "out: optional writable float64 buffer"},
+    {"reset", (PyCFunction)WindowArray_reset, METH_NOARGS, "Empty all windows"},
+    {NULL, NULL, 0, NULL}
+};
+
+PyTypeObject MovingAverageArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.MovingAverageArray",
+    .tp_doc = "Array of independent MovingAverage channels\n\nMovingAverageArray(n, window)",
+    .tp_basicsize = sizeof(WindowArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = MovingAverageArray_new,
+    .tp_dealloc = (destructor)WindowArray_dealloc,
+    .tp_methods = WindowArray_methods,
+    .tp_getset = WindowArray_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = MovingAverageArray_vectorcall,
+};
+
+PyTypeObject MovingMedianArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.MovingMedianArray",
+    .tp_doc = "Array of independent MovingMedian channels\n\nMovingMedianArray(n, window)",
+    .tp_basicsize = sizeof(WindowArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = MovingMedianArray_new,
+    .tp_dealloc = (destructor)WindowArray_dealloc,
+    .tp_methods = WindowArray_methods,
+    .tp_getset = WindowArray_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = MovingMedianArray_vectorcall,
+};
+
+PyTypeObject SlopeArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.SlopeArray",
+    .tp_doc = "Array of independent Slope channels\n\nSlopeArray(n, window, period)",
+    .tp_basicsize = sizeof(WindowArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = SlopeArray_new,
+    .tp_dealloc = (destructor)WindowArray_dealloc,
+    .tp_methods = WindowArray_methods,
+    .tp_getset = WindowArray_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = SlopeArray_vectorcall,
+};
+
+/* ========== IIRArray ========== */
+
+static void IIRArray_dealloc(IIRArrayObject* self) {
+    iir_bank_destroy(self->bank);
+    fb_array_free((FBArrayObject*)self, NULL);
+}
+
+static const char IIRArray_param_error[] =
+    "Invalid IIR coefficients (must be finite, a0 != 0, analog sections proper "
+    "with period > 0)";
+
+// IIRArray(n, sections, period=0.0, analog=False)
+static PyObject* IIRArray_vectorcall(PyObject* type, PyObject* const* args,
+                                     size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "sections", "period", "analog", NULL};
+    PyObject* slots[4];
+    IIRPrototype proto[IIR_MAX_SECTIONS];
+    uint32_t sections;
+    double period = 0.0;
+    int analog = 0;
+
+    if (fastcall_unpack("IIRArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 2, slots) != 0 ||
+        iir_parse_sections(slots[1], proto, &sections) != 0 ||
+        (slots[2] && fastcall_as_double(slots[2], &period) != 0) ||
+        (slots[3] && (analog = PyObject_IsTrue(slots[3])) < 0)) {
+        return NULL;
+    }
+
+    void* blocks;
+    IIRArrayObject* self = (IIRArrayObject*)fb_array_alloc(
+        (PyTypeObject*)type, slots[0], 0, &blocks);
+    if (!self) {
+        return NULL;
+    }
+
+    self->bank = iir_bank_create((size_t)self->n, proto, sections, analog, period);
+    if (!self->bank) {
+        PyErr_SetString(PyExc_ValueError, IIRArray_param_error);
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(inputs, out=None)
+static PyObject* IIRArray_compute(IIRArrayObject* self, PyObject* const* args,
+                                  Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"inputs", "out", NULL};
+    PyObject* slots[2];
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+
+    Py_buffer in_view, out_view;
+    double* src;
+    double* dst;
+    if (FBArray_begin((FBArrayObject*)self, slots[0], slots[1], &in_view, &out_view,
+                      &src, &dst) != 0) {
+        return NULL;
+    }
+
+    iir_bank_compute(self->bank, src, dst);
+    if (dst != self->output) {
+        memcpy(self->output, dst, (size_t)self->n * sizeof(double));
+    }
+
+    return FBArray_finish((FBArrayObject*)self, slots[1], &in_view, &out_view);
+}
+
+// set_sections(sections, analog=None)
+static PyObject* IIRArray_set_sections(IIRArrayObject* self, PyObject* const* args,
+                                       Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"sections", "analog", NULL};
+    PyObject* slots[2];
+    IIRPrototype proto[IIR_MAX_SECTIONS];
+    uint32_t sections;
+
+    if (fastcall_unpack("set_sections", args, nargs, kwnames, kwlist, 1, slots) != 0 ||
+        iir_parse_sections(slots[0], proto, &sections) != 0) {
+        return NULL;
+    }
+
+    int analog = self->bank->analog;
+    if (slots[1] && slots[1] != Py_None && (analog = PyObject_IsTrue(slots[1])) < 0) {
+        return NULL;
+    }
+
+    if (iir_bank_set_sections(self->bank, proto, sections, analog) != 0) {
+        PyErr_SetString(PyExc_ValueError, IIRArray_param_error);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// reset(initial=0.0)
+static PyObject* IIRArray_reset(IIRArrayObject* self, PyObject* const* args,
+                                Py_ssize_t nargs) {
+    double initial = 0.0;
+
+    if (fastcall_check_nargs("reset", nargs, 0, 1) != 0 ||
+        (nargs == 1 && fastcall_as_double(args[0], &initial) != 0)) {
+        return NULL;
+    }
+
+    double steady = iir_bank_reset(self->bank, initial);
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        self->output[i] = steady;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* IIRArray_get_period(IIRArrayObject* self, void* Py_UNUSED(closure)) {
+    return PyFloat_FromDouble(self->bank->period);
+}
+
+static int IIRArray_set_period(IIRArrayObject* self, PyObject* value, void* Py_UNUSED(closure)) {
+    double period;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "cannot delete period");
+        return -1;
+    }
+    if (fastcall_as_double(value, &period) != 0) {
+        return -1;
+    }
+    if (iir_bank_set_period(self->bank, period) != 0) {
+        PyErr_SetString(PyExc_ValueError, "period must be positive");
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject* IIRArray_get_analog(IIRArrayObject* self, void* Py_UNUSED(closure)) {
+    return PyBool_FromLong(self->bank->analog);
+}
+
+static PyObject* IIRArray_get_coefficients(IIRArrayObject* self, void* Py_UNUSED(closure)) {
+    return iir_coefficients_to_list(self->bank->coef, self->bank->sections);
+}
+
+static PyObject* IIRArray_get_kernel(IIRArrayObject* Py_UNUSED(self),
+                                     void* Py_UNUSED(closure)) {
+    return PyUnicode_FromString(iir_bank_kernel_name());
+}
+
+// 传统调用路径转到 vectorcall 实现
+static PyObject* IIRArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(IIRArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyGetSetDef IIRArray_getset[] = {
+    FB_REGISTRY_GETSET(FBArrayObject, registered),
+    {"period", (getter)IIRArray_get_period, (setter)IIRArray_set_period,
+     "Sample period in seconds; analog prototypes are re-discretized on change", NULL},
+    {"analog", (getter)IIRArray_get_analog, NULL, "Whether the prototype is in the s domain",
+     NULL},
+    {"coefficients", (getter)IIRArray_get_coefficients, NULL,
+     "Discrete sections [(b0, b1, b2, 1.0, a1, a2), ...] shared by all channels", NULL},
+    {"kernel", (getter)IIRArray_get_kernel, NULL, "Active kernel (avx2, sse2 or scalar)", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef IIRArray_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))IIRArray_compute, METH_FASTCALL | METH_KEYWORDS,
+     "Filter one sample per channel\n\n"
+     "inputs: float64 buffer or sequence of length n\n"
+     "out: optional writable float64 buffer"},
+    {"set_sections", (PyCFunction)(void(*)(void))IIRArray_set_sections,
+     METH_FASTCALL | METH_KEYWORDS,
+     "Replace the shared sections, keeping the state of surviving sections"},
+    {"reset", (PyCFunction)(void(*)(void))IIRArray_reset, METH_FASTCALL,
+     "Set every channel to its steady state for a constant input (default 0.0)"},
+    {NULL, NULL, 0, NULL}
+};
+
+PyTypeObject IIRArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.IIRArray",
+    .tp_doc = "Array of IIR channels sharing one set of second-order sections\n\n"
+              "IIRArray(n, sections, period=0.0, analog=False)",
+    .tp_basicsize = sizeof(IIRArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = IIRArray_new,
+    .tp_dealloc = (destructor)IIRArray_dealloc,
+    .tp_methods = IIRArray_methods,
+    .tp_getset = IIRArray_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = IIRArray_vectorcall,
+};
+
+/* ========== TimerArray / CounterArray / TriggerArray ========== */
+
+static void IECArray_dealloc(IECArrayObject* self) {
+    iec_bank_destroy(self->bank);
+    free(self->load_scratch);
+    fb_array_free((FBArrayObject*)self, NULL);
+}
+
+// 按 kind 创建 IECBank；is_kind 限定该数组类型接受的功能块种类
+static PyObject* IECArray_create(PyTypeObject* type, int (*is_kind)(FunctionBlockType),
+                                 PyObject* n_obj, PyObject* kind_obj, const char* kind_default,
+                                 double preset) {
+    const char* kind = kind_default;
+    FunctionBlockType fb_type;
+
+    if (kind_obj && !(kind = PyUnicode_AsUTF8(kind_obj))) {
+        return NULL;
+    }
+    if (iec_parse_type(kind, &fb_type) != 0 || !is_kind(fb_type)) {
+        PyErr_Format(PyExc_ValueError, "unsupported kind '%s' for %s", kind, type->tp_name);
+        return NULL;
+    }
+
+    void* blocks;
+    IECArrayObject* self = (IECArrayObject*)fb_array_alloc(type, n_obj, 0, &blocks);
+    if (!self) {
+        return NULL;
+    }
+
+    self->bank = iec_bank_create(fb_type, (size_t)self->n, preset);
+    if (!self->bank) {
+        PyErr_SetString(PyExc_ValueError, iec_is_timer(fb_type)
+                        ? "Failed to initialize TimerArray (PT must be in [0, 1e9] seconds)"
+                        : "Failed to initialize CounterArray (PV must be an integer, |PV| <= 2**53)");
+        Py_DECREF(self);
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        self->output[i] = self->bank->q[i];
+    }
+
+    return (PyObject*)self;
+}
+
+// TimerArray(n, kind="TON", PT=0.0)
+static PyObject* TimerArray_vectorcall(PyObject* type, PyObject* const* args,
+                                       size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "kind", "PT", NULL};
+    PyObject* slots[3];
+    double pt = 0.0;
+
+    if (fastcall_unpack("TimerArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 1, slots) != 0 ||
+        (slots[2] && fastcall_as_double(slots[2], &pt) != 0)) {
+        return NULL;
+    }
+    return IECArray_create((PyTypeObject*)type, iec_is_timer, slots[0], slots[1], "TON", pt);
+}
+
+// CounterArray(n, kind="CTU", PV=1)
+static PyObject* CounterArray_vectorcall(PyObject* type, PyObject* const* args,
+                                         size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "kind", "PV", NULL};
+    PyObject* slots[3];
+    long long pv = 1;
+
+    if (fastcall_unpack("CounterArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 1, slots) != 0 ||
+        (slots[2] && (pv = PyLong_AsLongLong(slots[2])) == -1 && PyErr_Occurred())) {
+        return NULL;
+    }
+    return IECArray_create((PyTypeObject*)type, iec_is_counter, slots[0], slots[1], "CTU",
+                           (double)pv);
+}
+
+// TriggerArray(n, kind="R_TRIG")
+static PyObject* TriggerArray_vectorcall(PyObject* type, PyObject* const* args,
+                                         size_t nargsf, PyObject* kwnames) {
+    static const char* const kwlist[] = {"n", "kind", NULL};
+    PyObject* slots[2];
+
+    if (fastcall_unpack("TriggerArray", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+    return IECArray_create((PyTypeObject*)type, iec_is_trigger, slots[0], slots[1], "R_TRIG",
+                           0.0);
+}
+
+// 执行一个周期；load 只用于计数器（R / LD），dt 只用于定时器
+static PyObject* IECArray_run(IECArrayObject* self, PyObject* in_obj, PyObject* load_obj,
+                              PyObject* out_obj, double dt) {
+    Py_buffer load_view = {.obj = NULL};
+    double* load = NULL;
+
+    if (load_obj && load_obj != Py_None) {
+        if (!self->load_scratch && !PyObject_CheckBuffer(load_obj)) {
+            self->load_scratch = (double*)malloc((size_t)self->n * sizeof(double));
+            if (!self->load_scratch) {
+                return PyErr_NoMemory();
+            }
+        }
+        if (fb_get_doubles(load_obj, "load", self->n, 0, &load_view, self->load_scratch,
+                           &load) != 0) {
+            return NULL;
+        }
+    }
+
+    Py_buffer in_view, out_view;
+    double* src;
+    double* dst;
+    if (FBArray_begin((FBArrayObject*)self, in_obj, out_obj, &in_view, &out_view,
+                      &src, &dst) != 0) {
+        if (load_view.obj) {
+            PyBuffer_Release(&load_view);
+        }
+        return NULL;
+    }
+
+    iec_bank_compute(self->bank, src, load, dst, dt);
+    if (dst != self->output) {
+        memcpy(self->output, dst, (size_t)self->n * sizeof(double));
+    }
+    if (load_view.obj) {
+        PyBuffer_Release(&load_view);
+    }
+
+    return FBArray_finish((FBArrayObject*)self, out_obj, &in_view, &out_view);
+}
+
+// TimerArray.compute(inputs, out=None, dt=0.0)
+static PyObject* TimerArray_compute(IECArrayObject* self, PyObject* const* args,
+                                    Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"inputs", "out", "dt", NULL};
+    PyObject* slots[3];
+    double dt = 0.0;
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0 ||
+        (slots[2] && fastcall_as_double(slots[2], &dt) != 0)) {
+        return NULL;
+    }
+    return IECArray_run(self, slots[0], NULL, slots[1], dt);
+}
+
+// CounterArray.compute(inputs, load=None, out=None)
+static PyObject* CounterArray_compute(IECArrayObject* self, PyObject* const* args,
+                                      Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"inputs", "load", "out", NULL};
+    PyObject* slots[3];
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+    return IECArray_run(self, slots[0], slots[1], slots[2], 0.0);
+}
+
+// TriggerArray.compute(inputs, out=None)
+static PyObject* TriggerArray_compute(IECArrayObject* self, PyObject* const* args,
+                                      Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"inputs", "out", NULL};
+    PyObject* slots[2];
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+    return IECArray_run(self, slots[0], NULL, slots[1], 0.0);
+}
+
+// set_preset(index, value)
+static PyObject* IECArray_set_preset(IECArrayObject* self, PyObject* const* args,
+                                     Py_ssize_t nargs) {
+    Py_ssize_t index;
+    double value;
+
+    if (fastcall_check_nargs("set_preset", nargs, 2, 2) != 0 ||
+        FBArray_index((FBArrayObject*)self, args[0], &index) != 0 ||
+        fastcall_as_double(args[1], &value) != 0) {
+        return NULL;
+    }
+    if (iec_bank_set_preset(self->bank, (size_t)index, value) != 0) {
+        PyErr_SetString(PyExc_ValueError, iec_is_timer(self->bank->type)
+                        ? "PT must be in [0, 1e9] seconds"
+                        : "PV must be an integer, |PV| <= 2**53");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// get_preset(index)
+static PyObject* IECArray_get_preset(IECArrayObject* self, PyObject* arg) {
+    Py_ssize_t index;
+
+    if (FBArray_index((FBArrayObject*)self, arg, &index) != 0) {
+        return NULL;
+    }
+    if (iec_is_counter(self->bank->type)) {
+        return PyLong_FromLongLong(self->bank->preset[index]);
+    }
+    return PyFloat_FromDouble(iec_bank_get_preset(self->bank, (size_t)index));
+}
+
+// reset()
+static PyObject* IECArray_reset(IECArrayObject* self, PyObject* Py_UNUSED(ignored)) {
+    iec_bank_reset(self->bank);
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        self->output[i] = self->bank->q[i];
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* IECArray_get_kind(IECArrayObject* self, void* Py_UNUSED(closure)) {
+    return PyUnicode_FromString(iec_type_name(self->bank->type));
+}
+
+// values：定时器为各通道 ET（秒），计数器为各通道 CV
+static PyObject* IECArray_get_values(IECArrayObject* self, void* Py_UNUSED(closure)) {
+    PyObject* list = PyList_New(self->n);
+    if (!list) {
+        return NULL;
+    }
+    int counter = iec_is_counter(self->bank->type);
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        PyObject* item = counter ? PyLong_FromLongLong(self->bank->value[i])
+                                 : PyFloat_FromDouble(iec_bank_get_value(self->bank, (size_t)i));
+        if (!item) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
+
+// 传统调用路径转到 vectorcall 实现
+static PyObject* TimerArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(TimerArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyObject* CounterArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(CounterArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyObject* TriggerArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    return fastcall_from_tuple(TriggerArray_vectorcall, (PyObject*)type, args, kwds);
+}
+
+static PyGetSetDef IECArray_getset[] = {
+    FB_REGISTRY_GETSET(FBArrayObject, registered),
+    {"kind", (getter)IECArray_get_kind, NULL, "Block kind (TON, CTU, R_TRIG, ...)", NULL},
+    {"values", (getter)IECArray_get_values, NULL,
+     "Elapsed time ET in seconds (timers) or count CV (counters) of every channel", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyGetSetDef TriggerArray_getset[] = {
+    FB_REGISTRY_GETSET(FBArrayObject, registered),
+    {"kind", (getter)IECArray_get_kind, NULL, "Block kind (R_TRIG or F_TRIG)", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef TimerArray_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))TimerArray_compute, METH_FASTCALL | METH_KEYWORDS,
+     "Advance every timer by one cycle and return Q (1.0 / 0.0)\n\n"
+     "inputs: IN per channel (non-zero is true), float64 buffer or sequence of length n\n"
+     "out: optional writable float64 buffer\n"
+     "dt: elapsed time in seconds, 0 = automatic (one clock read for all channels)"},
+    {"set_preset", (PyCFunction)(void(*)(void))IECArray_set_preset, METH_FASTCALL,
+     "Set PT of one channel in seconds\n\nindex: channel index\nvalue: PT"},
+    {"get_preset", (PyCFunction)IECArray_get_preset, METH_O, "PT of one channel in seconds"},
+    {"reset", (PyCFunction)IECArray_reset, METH_NOARGS, "Reset all channels"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyMethodDef CounterArray_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))CounterArray_compute, METH_FASTCALL | METH_KEYWORDS,
+     "Count rising edges on every channel and return Q (1.0 / 0.0)\n\n"
+     "inputs: CU / CD per channel, float64 buffer or sequence of length n\n"
+     "load: optional R (CTU) / LD (CTD) per channel\n"
+     "out: optional writable float64 buffer"},
+    {"set_preset", (PyCFunction)(void(*)(void))IECArray_set_preset, METH_FASTCALL,
+     "Set PV of one channel\n\nindex: channel index\nvalue: PV"},
+    {"get_preset", (PyCFunction)IECArray_get_preset, METH_O, "PV of one channel"},
+    {"reset", (PyCFunction)IECArray_reset, METH_NOARGS, "Reset all channels (CV = 0)"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyMethodDef TriggerArray_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))TriggerArray_compute, METH_FASTCALL | METH_KEYWORDS,
+     "Detect edges on every channel and return Q (1.0 / 0.0)\n\n"
+     "inputs: CLK per channel, float64 buffer or sequence of length n\n"
+     "out: optional writable float64 buffer"},
+    {"reset", (PyCFunction)IECArray_reset, METH_NOARGS, "Reset all channels"},
+    {NULL, NULL, 0, NULL}
+};
+
+PyTypeObject TimerArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.TimerArray",
+    .tp_doc = "Array of IEC 61131-3 timers sharing one kind\n\n"
+              "TimerArray(n, kind=\"TON\", PT=0.0), kind is TON, TOF or TP",
+    .tp_basicsize = sizeof(IECArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = TimerArray_new,
+    .tp_dealloc = (destructor)IECArray_dealloc,
+    .tp_methods = TimerArray_methods,
+    .tp_getset = IECArray_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = TimerArray_vectorcall,
+};
+
+PyTypeObject CounterArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.CounterArray",
+    .tp_doc = "Array of IEC 61131-3 counters sharing one kind\n\n"
+              "CounterArray(n, kind=\"CTU\", PV=1), kind is CTU or CTD",
+    .tp_basicsize = sizeof(IECArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = CounterArray_new,
+    .tp_dealloc = (destructor)IECArray_dealloc,
+    .tp_methods = CounterArray_methods,
+    .tp_getset = IECArray_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = CounterArray_vectorcall,
+};
+
+PyTypeObject TriggerArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.TriggerArray",
+    .tp_doc = "Array of IEC 61131-3 edge detectors sharing one kind\n\n"
+              "TriggerArray(n, kind=\"R_TRIG\"), kind is R_TRIG or F_TRIG",
+    .tp_basicsize = sizeof(IECArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = TriggerArray_new,
+    .tp_dealloc = (destructor)IECArray_dealloc,
+    .tp_methods = TriggerArray_methods,
+    .tp_getset = TriggerArray_getset,
+    .tp_as_sequence = &FBArray_as_sequence,
+    .tp_as_buffer = &FBArray_as_buffer,
+    .tp_vectorcall = TriggerArray_vectorcall,
+};
@@ -28,6 +28,9 @@
 
 #include <Python.h>
 #include "../function_blocks/fb_first_order.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include "py_view.h"
 
 // FirstOrder Python 对象结构
 typedef struct {
@@ -43,30 +46,68 @@ static void FirstOrder_dealloc(FirstOrderObject* self) {
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
-// 构造函数：__init__(self, T=1.0)
-static int FirstOrder_init(FirstOrderObject* self, PyObject* args, PyObject* kwds) {
-    double T = 1.0;
+static const char* const FirstOrder_kwlist[] = {"T", NULL};
 
-    static char* kwlist[] = {"T", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|d", kwlist, &T)) {
-        return -1;
+// 按时间常数 T 创建 C 功能块
+static int FirstOrder_setup(FirstOrderObject* self, double T) {
+    // 重复调用 __init__ 时原地更新，保持已导出视图的地址有效且不占用新槽位
+    if (self->fo) {
+        FirstOrderFunctionBlock fresh;
+        first_order_init(&fresh, T);
+        fb_reinit(self->fo, &fresh, sizeof(fresh));
+        return 0;
     }
 
     self->fo = first_order_create(T);
     if (!self->fo) {
-        PyErr_SetString(PyExc_RuntimeError, "一阶惯性创建失败");
+        PyErr_SetString(PyExc_MemoryError, "一阶惯性创建失败：实例池或注册表已满");
         return -1;
     }
+    fb_py_register_owner((PyObject*)self, self->fo);
 
     return 0;
 }
 
+// 构造函数：__init__(self, T=1.0)
+static int FirstOrder_init(FirstOrderObject* self, PyObject* args, PyObject* kwds) {
+    double T = 1.0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|d", (char**)FirstOrder_kwlist, &T)) {
+        return -1;
+    }
+
+    return FirstOrder_setup(self, T);
+}
+
+// vectorcall 构造：FirstOrder(...) 直接创建实例
+static PyObject* FirstOrder_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                       PyObject* kwnames) {
+    double T = 1.0;
+
+    if (fastcall_parse_doubles("FirstOrder", args, PyVectorcall_NARGS(nargsf), kwnames,
+                               FirstOrder_kwlist, 0, &T) != 0) {
+        return NULL;
+    }
+
+    FirstOrderObject* self =
+        (FirstOrderObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (FirstOrder_setup(self, T) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
 // compute(input) -> float
-static PyObject* FirstOrder_compute(FirstOrderObject* self, PyObject* args) {
+static PyObject* FirstOrder_compute(FirstOrderObject* self, PyObject* arg) {
     double input;
 
-    if (!PyArg_ParseTuple(args, "d", &input)) {
+    if (fastcall_as_double(arg, &input) != 0) {
         return NULL;
     }
 
@@ -80,10 +121,10 @@ static PyObject* FirstOrder_compute(FirstOrderObject* self, PyObject* args) {
 }
 
 // set_time_constant(T)
-static PyObject* FirstOrder_set_time_constant(FirstOrderObject* self, PyObject* args) {
+static PyObject* FirstOrder_set_time_constant(FirstOrderObject* self, PyObject* arg) {
     double T;
 
-    if (!PyArg_ParseTuple(args, "d", &T)) {
+    if (fastcall_as_double(arg, &T) != 0) {
         return NULL;
     }
 
@@ -95,7 +136,94 @@ static PyObject* FirstOrder_set_time_constant(FirstOrderObject* self, PyObject*
     Py_RETURN_NONE;
 }
 
-// get_params() -> dict
+static const char* const FirstOrder_param_fields[] = {"T"};
+static const char* const FirstOrder_state_fields[] = {"prev_output"};
+
+static double* FirstOrder_params_data(PyObject* owner) {
+    FirstOrderFunctionBlock* fo = ((FirstOrderObject*)owner)->fo;
+    return fo ? &fo->params.T : NULL;
+}
+
+static double* FirstOrder_state_data(PyObject* owner) {
+    FirstOrderFunctionBlock* fo = ((FirstOrderObject*)owner)->fo;
+    return fo ? &fo->state.prev_output : NULL;
+}
+
+// T 属性
+static PyObject* FirstOrder_get_T(FirstOrderObject* self, void* Py_UNUSED(closure)) {
+    double* data = FirstOrder_params_data((PyObject*)self);
+    if (!data) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return NULL;
+    }
+    return PyFloat_FromDouble(*data);
+}
+
+static int FirstOrder_set_T(FirstOrderObject* self, PyObject* value, void* Py_UNUSED(closure)) {
+    double T;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除时间常数");
+        return -1;
+    }
+    if (fastcall_as_double(value, &T) != 0) {
+        return -1;
+    }
+    if (first_order_set_time_constant(self->fo, T) != 0) {
+        PyErr_SetString(PyExc_RuntimeError, "时间常数设置失败");
+        return -1;
+    }
+    return 0;
+}
+
+// prev_output 属性（可写，用于预置输出）
+static PyObject* FirstOrder_get_prev_output(FirstOrderObject* self, void* Py_UNUSED(closure)) {
+    double* data = FirstOrder_state_data((PyObject*)self);
+    if (!data) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return NULL;
+    }
+    return PyFloat_FromDouble(*data);
+}
+
+static int FirstOrder_set_prev_output(FirstOrderObject* self, PyObject* value,
+                                      void* Py_UNUSED(closure)) {
+    double* data = FirstOrder_state_data((PyObject*)self);
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除状态");
+        return -1;
+    }
+    if (!data) {
+        PyErr_SetString(PyExc_RuntimeError, "实例未初始化");
+        return -1;
+    }
+    return fastcall_as_double(value, data);
+}
+
+// params -> FBView
+static PyObject* FirstOrder_get_params_view(FirstOrderObject* self, void* Py_UNUSED(closure)) {
+    return fb_view_new((PyObject*)self, FirstOrder_params_data, FirstOrder_param_fields, 1);
+}
+
+// state -> FBView
+static PyObject* FirstOrder_get_state_view(FirstOrderObject* self, void* Py_UNUSED(closure)) {
+    return fb_view_new((PyObject*)self, FirstOrder_state_data, FirstOrder_state_fields, 1);
+}
+
+// 属性表
+static PyGetSetDef FirstOrder_getset[] = {
+    {"T", (getter)FirstOrder_get_T, (setter)FirstOrder_set_T, "时间常数（秒）", NULL},
+    {"prev_output", (getter)FirstOrder_get_prev_output, (setter)FirstOrder_set_prev_output,
+     "上一周期输出值", NULL},
+    {"params", (getter)FirstOrder_get_params_view, NULL, "参数的零拷贝只读视图 {T}", NULL},
+    {"state", (getter)FirstOrder_get_state_view, NULL,
+     "状态的零拷贝只读视图 {prev_output}", NULL},
+    FB_REGISTRY_GETSET(FirstOrderObject, fo),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+// get_params() -> dict（兼容接口，推荐使用属性或 params 视图）
 static PyObject* FirstOrder_get_params(FirstOrderObject* self, PyObject* Py_UNUSED(ignored)) {
     const FirstOrderParams* params = first_order_get_params(self->fo);
     if (!params) {
@@ -103,10 +231,7 @@ static PyObject* FirstOrder_get_params(FirstOrderObject* self, PyObject* Py_UNUS
         return NULL;
     }
 
-    PyObject* dict = PyDict_New();
-    PyDict_SetItemString(dict, "T", PyFloat_FromDouble(params->T));
-
-    return dict;
+    return fb_fields_to_dict(FirstOrder_param_fields, &params->T, 1);
 }
 
 // reset()
@@ -117,9 +242,9 @@ static PyObject* FirstOrder_reset(FirstOrderObject* self, PyObject* Py_UNUSED(ig
 
 // 方法表
 static PyMethodDef FirstOrder_methods[] = {
-    {"compute", (PyCFunction)FirstOrder_compute, METH_VARARGS,
+    {"compute", (PyCFunction)FirstOrder_compute, METH_O,
      "计算一阶惯性输出\n\n参数:\n  input: 输入信号\n\n返回:\n  float: 输出信号"},
-    {"set_time_constant", (PyCFunction)FirstOrder_set_time_constant, METH_VARARGS,
+    {"set_time_constant", (PyCFunction)FirstOrder_set_time_constant, METH_O,
      "动态修改时间常数\n\n参数:\n  T: 时间常数（秒）"},
     {"get_params", (PyCFunction)FirstOrder_get_params, METH_NOARGS,
      "获取参数\n\n返回:\n  dict: {T}"},
@@ -140,4 +265,6 @@ PyTypeObject FirstOrderType = {
     .tp_init = (initproc)FirstOrder_init,
     .tp_dealloc = (destructor)FirstOrder_dealloc,
     .tp_methods = FirstOrder_methods,
+    .tp_getset = FirstOrder_getset,
+    .tp_vectorcall = FirstOrder_vectorcall,
 };
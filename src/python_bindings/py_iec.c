@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_iec.c
+ * @brief IEC 61131-3 标准功能块（TON、TOF、TP、CTU、CTD、R_TRIG、F_TRIG）Python 绑定实现
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_iec.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include <stddef.h>
+
+// 七种功能块共用的 Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    FunctionBlock* fb;   // TimerFB / CounterFB / TriggerFB
+} IECObject;
+
+static const char IEC_uninit[] = "实例未初始化";
+
+static FunctionBlockType IEC_type_of(PyTypeObject* type);
+
+// 析构函数
+static void IEC_dealloc(IECObject* self) {
+    if (self->fb) {
+        if (iec_is_timer(self->fb->type)) {
+            iec_timer_destroy((TimerFB*)self->fb);
+        } else if (iec_is_counter(self->fb->type)) {
+            iec_counter_destroy((CounterFB*)self->fb);
+        } else {
+            iec_trigger_destroy((TriggerFB*)self->fb);
+        }
+    }
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 解析 PT（秒）
+static int IEC_parse_time(PyObject* obj, double* seconds) {
+    int64_t ns;
+    if (fastcall_as_double(obj, seconds) != 0) {
+        return -1;
+    }
+    if (iec_time_from_seconds(*seconds, &ns) != 0) {
+        PyErr_SetString(PyExc_ValueError, "PT must be in [0, 1e9] seconds");
+        return -1;
+    }
+    return 0;
+}
+
+// 解析 PV（整数）
+static int IEC_parse_count(PyObject* obj, int64_t* pv) {
+    long long value = PyLong_AsLongLong(obj);
+    if (value == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    *pv = (int64_t)value;
+    return 0;
+}
+
+// 创建 C 功能块；重复调用 __init__ 时原地重新初始化，保持 ID 和名称
+static int IEC_setup(IECObject* self, FunctionBlockType type, double pt, int64_t pv) {
+    if (!self->fb) {
+        if (iec_is_timer(type)) {
+            self->fb = (FunctionBlock*)iec_timer_create(type, pt);
+        } else if (iec_is_counter(type)) {
+            self->fb = (FunctionBlock*)iec_counter_create(type, pv);
+        } else {
+            self->fb = (FunctionBlock*)iec_trigger_create(type);
+        }
+        if (!self->fb) {
+            PyErr_SetString(PyExc_MemoryError, "创建失败：实例池或注册表已满");
+            return -1;
+        }
+        fb_py_register_owner((PyObject*)self, self->fb);
+        return 0;
+    }
+
+    if (iec_is_timer(type)) {
+        TimerFB fresh;
+        iec_timer_init(&fresh, type, pt);
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+    } else if (iec_is_counter(type)) {
+        CounterFB fresh;
+        iec_counter_init(&fresh, type, pv);
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+    } else {
+        TriggerFB fresh;
+        iec_trigger_init(&fresh, type);
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+    }
+    return 0;
+}
+
+static const char* const IEC_timer_kwlist[] = {"PT", NULL};
+static const char* const IEC_counter_kwlist[] = {"PV", NULL};
+static const char* const IEC_trigger_kwlist[] = {NULL};
+
+// 按类型解析构造参数：定时器 (PT)，计数器 (PV)，边沿检测无参数
+static int IEC_parse_preset(FunctionBlockType type, PyObject* obj, double* pt, int64_t* pv) {
+    if (iec_is_timer(type)) {
+        return IEC_parse_time(obj, pt);
+    }
+    if (iec_is_counter(type)) {
+        return IEC_parse_count(obj, pv);
+    }
+    return 0;
+}
+
+// vectorcall 构造
+static PyObject* IEC_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                PyObject* kwnames) {
+    FunctionBlockType fb_type = IEC_type_of((PyTypeObject*)type);
+    const char* const* kwlist = iec_is_timer(fb_type)     ? IEC_timer_kwlist
+                                : iec_is_counter(fb_type) ? IEC_counter_kwlist
+                                                          : IEC_trigger_kwlist;
+    PyObject* slots[1] = {NULL};
+    double pt = 0.0;
+    int64_t pv = 0;
+
+    if (fastcall_unpack(((PyTypeObject*)type)->tp_name, args, PyVectorcall_NARGS(nargsf),
+                        kwnames, kwlist, kwlist[0] ? 1 : 0, slots) != 0 ||
+        IEC_parse_preset(fb_type, slots[0], &pt, &pv) != 0) {
+        return NULL;
+    }
+
+    IECObject* self = (IECObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (IEC_setup(self, fb_type, pt, pv) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// 构造函数：TON/TOF/TP(PT)、CTU/CTD(PV)、R_TRIG/F_TRIG()
+static int IEC_init(IECObject* self, PyObject* args, PyObject* kwds) {
+    FunctionBlockType fb_type = IEC_type_of(Py_TYPE(self));
+    PyObject* preset = NULL;
+    double pt = 0.0;
+    int64_t pv = 0;
+
+    if (iec_is_trigger(fb_type)) {
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "", (char**)IEC_trigger_kwlist)) {
+            return -1;
+        }
+    } else if (!PyArg_ParseTupleAndKeywords(args, kwds, "O",
+                                            (char**)(iec_is_timer(fb_type) ? IEC_timer_kwlist
+                                                                           : IEC_counter_kwlist),
+                                            &preset) ||
+               IEC_parse_preset(fb_type, preset, &pt, &pv) != 0) {
+        return -1;
+    }
+
+    return IEC_setup(self, fb_type, pt, pv);
+}
+
+// 定时器 compute(IN, dt=0.0) -> bool
+static PyObject* Timer_compute(IECObject* self, PyObject* const* args, Py_ssize_t nargs,
+                               PyObject* kwnames) {
+    static const char* const kwlist[] = {"IN", "dt", NULL};
+    PyObject* slots[2];
+    double dt = 0.0;
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0 ||
+        (slots[1] && fastcall_as_double(slots[1], &dt) != 0)) {
+        return NULL;
+    }
+    int in = PyObject_IsTrue(slots[0]);
+    if (in < 0) {
+        return NULL;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IEC_uninit);
+        return NULL;
+    }
+
+    return PyBool_FromLong(iec_timer_compute((TimerFB*)self->fb, in, dt));
+}
+
+// 计数器 compute(CU, R=False) / compute(CD, LD=False) -> bool
+static PyObject* Counter_compute(IECObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                 PyObject* kwnames) {
+    static const char* const ctu_kwlist[] = {"CU", "R", NULL};
+    static const char* const ctd_kwlist[] = {"CD", "LD", NULL};
+    PyObject* slots[2];
+
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IEC_uninit);
+        return NULL;
+    }
+    if (fastcall_unpack("compute", args, nargs, kwnames,
+                        self->fb->type == FB_TYPE_CTU ? ctu_kwlist : ctd_kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+    int count = PyObject_IsTrue(slots[0]);
+    int load = slots[1] ? PyObject_IsTrue(slots[1]) : 0;
+    if (count < 0 || load < 0) {
+        return NULL;
+    }
+
+    return PyBool_FromLong(iec_counter_compute((CounterFB*)self->fb, count, load));
+}
+
+// 边沿检测 compute(CLK) -> bool
+static PyObject* Trigger_compute(IECObject* self, PyObject* arg) {
+    int clk = PyObject_IsTrue(arg);
+    if (clk < 0) {
+        return NULL;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IEC_uninit);
+        return NULL;
+    }
+
+    return PyBool_FromLong(iec_trigger_compute((TriggerFB*)self->fb, clk));
+}
+
+// reset()：恢复初始状态
+static PyObject* IEC_reset(IECObject* self, PyObject* Py_UNUSED(ignored)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IEC_uninit);
+        return NULL;
+    }
+
+    if (iec_is_timer(self->fb->type)) {
+        iec_timer_reset((TimerFB*)self->fb);
+    } else if (iec_is_counter(self->fb->type)) {
+        iec_counter_reset((CounterFB*)self->fb);
+    } else {
+        iec_trigger_reset((TriggerFB*)self->fb);
+    }
+    Py_RETURN_NONE;
+}
+
+// 只读属性：closure 为字段偏移
+static PyObject* IEC_get_bool(IECObject* self, void* closure) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IEC_uninit);
+        return NULL;
+    }
+    return PyBool_FromLong(*(int*)((char*)self->fb + (size_t)closure));
+}
+
+static PyObject* IEC_get_seconds(IECObject* self, void* closure) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IEC_uninit);
+        return NULL;
+    }
+    return PyFloat_FromDouble((double)*(int64_t*)((char*)self->fb + (size_t)closure) / 1e9);
+}
+
+static PyObject* IEC_get_count(IECObject* self, void* closure) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IEC_uninit);
+        return NULL;
+    }
+    return PyLong_FromLongLong(*(int64_t*)((char*)self->fb + (size_t)closure));
+}
+
+// 定时器 PT（可写）
+static int Timer_set_PT(IECObject* self, PyObject* value, void* Py_UNUSED(closure)) {
+    double pt;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 PT");
+        return -1;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IEC_uninit);
+        return -1;
+    }
+    if (IEC_parse_time(value, &pt) != 0) {
+        return -1;
+    }
+    return iec_timer_set_preset((TimerFB*)self->fb, pt);
+}
+
+// 计数器 PV（可写）
+static int Counter_set_PV(IECObject* self, PyObject* value, void* Py_UNUSED(closure)) {
+    int64_t pv;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 PV");
+        return -1;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IEC_uninit);
+        return -1;
+    }
+    if (IEC_parse_count(value, &pv) != 0) {
+        return -1;
+    }
+    iec_counter_set_preset((CounterFB*)self->fb, pv);
+    return 0;
+}
+
+static PyGetSetDef Timer_getset[] = {
+    {"Q", (getter)IEC_get_bool, NULL, "输出（只读）", (void*)offsetof(TimerFB, Q)},
+    {"IN", (getter)IEC_get_bool, NULL, "最近一次输入（只读）", (void*)offsetof(TimerFB, IN)},
+    {"ET", (getter)IEC_get_seconds, NULL, "已计时（秒，只读）", (void*)offsetof(TimerFB, ET)},
+    {"PT", (getter)IEC_get_seconds, (setter)Timer_set_PT, "预设时间（秒）",
+     (void*)offsetof(TimerFB, PT)},
+    FB_REGISTRY_GETSET(IECObject, fb),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyGetSetDef Counter_getset[] = {
+    {"Q", (getter)IEC_get_bool, NULL, "输出（只读）", (void*)offsetof(CounterFB, Q)},
+    {"CV", (getter)IEC_get_count, NULL, "当前计数（只读）", (void*)offsetof(CounterFB, CV)},
+    {"PV", (getter)IEC_get_count, (setter)Counter_set_PV, "预设值",
+     (void*)offsetof(CounterFB, PV)},
+    FB_REGISTRY_GETSET(IECObject, fb),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyGetSetDef Trigger_getset[] = {
+    {"Q", (getter)IEC_get_bool, NULL, "输出（只读）", (void*)offsetof(TriggerFB, Q)},
+    FB_REGISTRY_GETSET(IECObject, fb),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef Timer_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))Timer_compute, METH_FASTCALL | METH_KEYWORDS,
+     "执行一个周期\n\n参数:\n  IN: 输入\n  dt: 距上个周期的时间（秒），0 表示自动计算\n\n"
+     "返回:\n  bool: 输出 Q"},
+    {"reset", (PyCFunction)IEC_reset, METH_NOARGS, "复位（Q 为假、ET 为 0）"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyMethodDef CTU_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))Counter_compute, METH_FASTCALL | METH_KEYWORDS,
+     "执行一个周期\n\n参数:\n  CU: 计数输入（上升沿加 1）\n  R: 复位（CV 清零，优先于计数）\n\n"
+     "返回:\n  bool: 输出 Q（CV >= PV）"},
+    {"reset", (PyCFunction)IEC_reset, METH_NOARGS, "复位（CV 为 0）"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyMethodDef CTD_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))Counter_compute, METH_FASTCALL | METH_KEYWORDS,
+     "执行一个周期\n\n参数:\n  CD: 计数输入（上升沿减 1）\n  LD: 装入（CV = PV，优先于计数）\n\n"
+     "返回:\n  bool: 输出 Q（CV <= 0）"},
+    {"reset", (PyCFunction)IEC_reset, METH_NOARGS, "复位（CV 为 0）"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyMethodDef Trigger_methods[] = {
+    {"compute", (PyCFunction)Trigger_compute, METH_O,
+     "执行一个周期\n\n参数:\n  CLK: 输入\n\n返回:\n  bool: 检测到边沿的周期为真"},
+    {"reset", (PyCFunction)IEC_reset, METH_NOARGS, "复位（上一周期 CLK 视为假）"},
+    {NULL, NULL, 0, NULL}
+};
+
+// 类型定义
+#define IEC_TYPE_DEF(Name, doc, methods, getset)          \
+    PyTypeObject Name##Type = {                            \
+        PyVarObject_HEAD_INIT(NULL, 0)                     \
+        .tp_name = "plcopen_c." #Name,                     \
+        .tp_doc = doc,                                     \
+        .tp_basicsize = sizeof(IECObject),                 \
+        .tp_itemsize = 0,                                  \
+        .tp_flags = Py_TPFLAGS_DEFAULT,                    \
+        .tp_new = PyType_GenericNew,                       \
+        .tp_init = (initproc)IEC_init,                     \
+        .tp_dealloc = (destructor)IEC_dealloc,             \
+        .tp_methods = methods,                             \
+        .tp_getset = getset,                               \
+        .tp_vectorcall = IEC_vectorcall,                   \
+    }
+
+IEC_TYPE_DEF(TON, "接通延时定时器\n\nTON(PT)：IN 持续为真达到 PT 秒后 Q 为真，IN 为假时复位。",
+             Timer_methods, Timer_getset);
+IEC_TYPE_DEF(TOF, "断开延时定时器\n\nTOF(PT)：IN 为真时 Q 为真，IN 变假后 Q 再保持 PT 秒。",
+             Timer_methods, Timer_getset);
+IEC_TYPE_DEF(TP, "脉冲定时器\n\nTP(PT)：IN 上升沿触发宽度为 PT 秒的脉冲，脉冲期间不可重触发。",
+             Timer_methods, Timer_getset);
+IEC_TYPE_DEF(CTU, "加计数器\n\nCTU(PV)：CU 上升沿 CV 加 1，R 清零，CV >= PV 时 Q 为真。",
+             CTU_methods, Counter_getset);
+IEC_TYPE_DEF(CTD, "减计数器\n\nCTD(PV)：CD 上升沿 CV 减 1，LD 装入 PV，CV <= 0 时 Q 为真。",
+             CTD_methods, Counter_getset);
+IEC_TYPE_DEF(R_TRIG, "上升沿检测\n\nR_TRIG()：CLK 由假变真的周期 Q 为真。",
+             Trigger_methods, Trigger_getset);
+IEC_TYPE_DEF(F_TRIG, "下降沿检测\n\nF_TRIG()：CLK 由真变假的周期 Q 为真。",
+             Trigger_methods, Trigger_getset);
+
+// 子类也按基类确定功能块类型
+static FunctionBlockType IEC_type_of(PyTypeObject* type) {
+    static PyTypeObject* const types[] = {&TONType, &TOFType, &TPType, &CTUType,
+                                          &CTDType, &R_TRIGType, &F_TRIGType};
+    static const FunctionBlockType fb_types[] = {FB_TYPE_TON, FB_TYPE_TOF, FB_TYPE_TP,
+                                                 FB_TYPE_CTU, FB_TYPE_CTD, FB_TYPE_R_TRIG,
+                                                 FB_TYPE_F_TRIG};
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]) - 1; i++) {
+        if (PyType_IsSubtype(type, types[i])) {
+            return fb_types[i];
+        }
+    }
+    return FB_TYPE_F_TRIG;
+}
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_iir.c
+ * @brief 离散传递函数（级联二阶节 IIR）功能块 Python 绑定实现
+ */
+
+#include <Python.h>
+#include "py_iir.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include <stddef.h>
+
+// IIR Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    IIRFB* fb;
+} IIRObject;
+
+static const char IIR_uninit[] = "实例未初始化";
+
+static const char IIR_param_error[] =
+    "IIR 参数无效：系数须为有限值，分母首项不为 0，s 域二阶节须为真分式且 period > 0";
+
+int iir_parse_sections(PyObject* obj, IIRPrototype* proto, uint32_t* sections) {
+    PyObject* rows = PySequence_Fast(obj, "sections must be a sequence of 6-element rows");
+    if (!rows) {
+        return -1;
+    }
+
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(rows);
+    if (n < 1 || n > IIR_MAX_SECTIONS) {
+        PyErr_Format(PyExc_ValueError, "sections must have 1 to %d rows", IIR_MAX_SECTIONS);
+        Py_DECREF(rows);
+        return -1;
+    }
+
+    for (Py_ssize_t s = 0; s < n; s++) {
+        double v[6];
+        PyObject* row = PySequence_Fast(PySequence_Fast_GET_ITEM(rows, s),
+                                        "each section must be [b0, b1, b2, a0, a1, a2]");
+        if (!row) {
+            Py_DECREF(rows);
+            return -1;
+        }
+        if (PySequence_Fast_GET_SIZE(row) != 6) {
+            PyErr_Format(PyExc_ValueError, "section %zd must have 6 coefficients", s);
+            Py_DECREF(row);
+            Py_DECREF(rows);
+            return -1;
+        }
+        for (int k = 0; k < 6; k++) {
+            if (fastcall_as_double(PySequence_Fast_GET_ITEM(row, k), &v[k]) != 0) {
+                Py_DECREF(row);
+                Py_DECREF(rows);
+                return -1;
+            }
+        }
+        Py_DECREF(row);
+
+        proto[s].b[0] = v[0];
+        proto[s].b[1] = v[1];
+        proto[s].b[2] = v[2];
+        proto[s].a[0] = v[3];
+        proto[s].a[1] = v[4];
+        proto[s].a[2] = v[5];
+    }
+
+    Py_DECREF(rows);
+    *sections = (uint32_t)n;
+    return 0;
+}
+
+PyObject* iir_coefficients_to_list(const IIRSection* coef, uint32_t sections) {
+    PyObject* list = PyList_New(sections);
+    if (!list) {
+        return NULL;
+    }
+    for (uint32_t s = 0; s < sections; s++) {
+        const IIRSection* c = &coef[s];
+        PyObject* row = Py_BuildValue("(dddddd)", c->b0, c->b1, c->b2, 1.0, c->a1, c->a2);
+        if (!row) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, s, row);
+    }
+    return list;
+}
+
+PyObject* iir_prototype_to_list(const IIRPrototype* proto, uint32_t sections) {
+    PyObject* list = PyList_New(sections);
+    if (!list) {
+        return NULL;
+    }
+    for (uint32_t s = 0; s < sections; s++) {
+        const IIRPrototype* p = &proto[s];
+        PyObject* row = Py_BuildValue("(dddddd)", p->b[0], p->b[1], p->b[2],
+                                      p->a[0], p->a[1], p->a[2]);
+        if (!row) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, s, row);
+    }
+    return list;
+}
+
+// 析构函数
+static void IIR_dealloc(IIRObject* self) {
+    if (self->fb) {
+        iir_destroy(self->fb);
+    }
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 按参数创建 C 功能块
+static int IIR_setup(IIRObject* self, PyObject* sections_obj, double period, int analog) {
+    IIRPrototype proto[IIR_MAX_SECTIONS];
+    uint32_t sections;
+
+    if (iir_parse_sections(sections_obj, proto, &sections) != 0) {
+        return -1;
+    }
+
+    IIRFB fresh;
+    if (iir_init(&fresh, proto, sections, analog, period) != 0) {
+        PyErr_SetString(PyExc_ValueError, IIR_param_error);
+        return -1;
+    }
+
+    // 重复调用 __init__ 时原地重新初始化，保持 ID 和注册表名称
+    if (self->fb) {
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+        return 0;
+    }
+
+    self->fb = iir_create(proto, sections, analog, period);
+    if (!self->fb) {
+        PyErr_SetString(PyExc_MemoryError, "IIR 创建失败：实例池或注册表已满");
+        return -1;
+    }
+    fb_py_register_owner((PyObject*)self, self->fb);
+
+    return 0;
+}
+
+static const char* const IIR_kwlist[] = {"sections", "period", "analog", NULL};
+
+// 构造函数：__init__(self, sections, period=0.0, analog=False)
+static int IIR_init(IIRObject* self, PyObject* args, PyObject* kwds) {
+    PyObject* sections;
+    double period = 0.0;
+    int analog = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|dp", (char**)IIR_kwlist,
+                                     &sections, &period, &analog)) {
+        return -1;
+    }
+
+    return IIR_setup(self, sections, period, analog);
+}
+
+// vectorcall 构造：IIR(...) 直接创建实例
+static PyObject* IIR_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                PyObject* kwnames) {
+    PyObject* slots[3];
+    double period = 0.0;
+    int analog = 0;
+
+    if (fastcall_unpack("IIR", args, PyVectorcall_NARGS(nargsf), kwnames, IIR_kwlist,
+                        1, slots) != 0 ||
+        (slots[1] && fastcall_as_double(slots[1], &period) != 0) ||
+        (slots[2] && (analog = PyObject_IsTrue(slots[2])) < 0)) {
+        return NULL;
+    }
+
+    IIRObject* self = (IIRObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (IIR_setup(self, slots[0], period, analog) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(input) -> float
+static PyObject* IIR_compute(IIRObject* self, PyObject* arg) {
+    double input;
+
+    if (fastcall_as_double(arg, &input) != 0) {
+        return NULL;
+    }
+
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IIR_uninit);
+        return NULL;
+    }
+
+    return PyFloat_FromDouble(iir_compute(self->fb, input));
+}
+
+// set_sections(sections, analog=None)：analog 省略时保持当前的域
+static PyObject* IIR_set_sections(IIRObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                  PyObject* kwnames) {
+    static const char* const kwlist[] = {"sections", "analog", NULL};
+    PyObject* slots[2];
+    IIRPrototype proto[IIR_MAX_SECTIONS];
+    uint32_t sections;
+
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IIR_uninit);
+        return NULL;
+    }
+    if (fastcall_unpack("set_sections", args, nargs, kwnames, kwlist, 1, slots) != 0 ||
+        iir_parse_sections(slots[0], proto, &sections) != 0) {
+        return NULL;
+    }
+
+    int analog = self->fb->analog;
+    if (slots[1] && slots[1] != Py_None && (analog = PyObject_IsTrue(slots[1])) < 0) {
+        return NULL;
+    }
+
+    if (iir_set_sections(self->fb, proto, sections, analog) != 0) {
+        PyErr_SetString(PyExc_ValueError, IIR_param_error);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// reset(initial=0.0)：重置为输入恒为 initial 时的稳态
+static PyObject* IIR_reset(IIRObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    double initial = 0.0;
+
+    if (fastcall_check_nargs("reset", nargs, 0, 1) != 0 ||
+        (nargs == 1 && fastcall_as_double(args[0], &initial) != 0)) {
+        return NULL;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IIR_uninit);
+        return NULL;
+    }
+
+    iir_reset(self->fb, initial);
+    Py_RETURN_NONE;
+}
+
+static PyObject* IIR_get_period(IIRObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IIR_uninit);
+        return NULL;
+    }
+    return PyFloat_FromDouble(self->fb->period);
+}
+
+// period 可写：s 域原型按新周期重新离散化
+static int IIR_set_period(IIRObject* self, PyObject* value, void* Py_UNUSED(closure)) {
+    double period;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 period");
+        return -1;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IIR_uninit);
+        return -1;
+    }
+    if (fastcall_as_double(value, &period) != 0) {
+        return -1;
+    }
+    if (iir_set_period(self->fb, period) != 0) {
+        PyErr_SetString(PyExc_ValueError, "period 必须为正数");
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject* IIR_get_output(IIRObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IIR_uninit);
+        return NULL;
+    }
+    return PyFloat_FromDouble(self->fb->output);
+}
+
+static PyObject* IIR_get_analog(IIRObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IIR_uninit);
+        return NULL;
+    }
+    return PyBool_FromLong(self->fb->analog);
+}
+
+static PyObject* IIR_get_coefficients(IIRObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IIR_uninit);
+        return NULL;
+    }
+    return iir_coefficients_to_list(self->fb->coef, self->fb->sections);
+}
+
+static PyObject* IIR_get_prototype(IIRObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, IIR_uninit);
+        return NULL;
+    }
+    return iir_prototype_to_list(self->fb->proto, self->fb->sections);
+}
+
+// 属性表
+static PyGetSetDef IIR_getset[] = {
+    {"period", (getter)IIR_get_period, (setter)IIR_set_period,
+     "采样周期（秒）；s 域原型修改后按新周期重新离散化", NULL},
+    {"output", (getter)IIR_get_output, NULL, "最近一次输出（只读）", NULL},
+    {"analog", (getter)IIR_get_analog, NULL, "原型是否为 s 域（只读）", NULL},
+    {"coefficients", (getter)IIR_get_coefficients, NULL,
+     "离散二阶节系数 [(b0, b1, b2, 1.0, a1, a2), ...]", NULL},
+    {"prototype", (getter)IIR_get_prototype, NULL,
+     "构造时给定的原型系数 [(b0, b1, b2, a0, a1, a2), ...]", NULL},
+    FB_REGISTRY_GETSET(IIRObject, fb),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+// 方法表
+static PyMethodDef IIR_methods[] = {
+    {"compute", (PyCFunction)IIR_compute, METH_O,
+     "计算一个采样周期（每个 period 调用一次）\n\n"
+     "参数:\n  input: 输入信号\n\n返回:\n  float: 输出信号"},
+    {"set_sections", (PyCFunction)(void(*)(void))IIR_set_sections,
+     METH_FASTCALL | METH_KEYWORDS,
+     "修改二阶节系数，保留仍存在的各节状态\n\n"
+     "参数:\n  sections: [[b0, b1, b2, a0, a1, a2], ...]\n"
+     "  analog: 可选，True 为 s 域；省略时保持当前的域"},
+    {"reset", (PyCFunction)(void(*)(void))IIR_reset, METH_FASTCALL,
+     "重置为输入恒为 initial 时的稳态\n\n参数:\n  initial: 可选，默认 0.0"},
+    {NULL, NULL, 0, NULL}
+};
+
+// 类型定义
+PyTypeObject IIRType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.IIR",
+    .tp_doc = "离散传递函数（级联二阶节 IIR）功能块\n\n"
+              "IIR(sections, period=0.0, analog=False)：sections 为 [[b0, b1, b2, a0, a1, a2], ...]，\n"
+              "analog=False 时为 z 域系数；analog=True 时为 s 多项式系数（高次在前），\n"
+              "按 period 用双线性变换离散化。系数只在构造或修改参数、周期时计算一次。",
+    .tp_basicsize = sizeof(IIRObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)IIR_init,
+    .tp_dealloc = (destructor)IIR_dealloc,
+    .tp_methods = IIR_methods,
+    .tp_getset = IIR_getset,
+    .tp_vectorcall = IIR_vectorcall,
+};
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_iir.h
+ * @brief IIR 功能块与 IIRArray 共用的系数转换
+ */
+
+#ifndef PY_IIR_H
+#define PY_IIR_H
+
+#include <Python.h>
+#include "../function_blocks/fb_iir.h"
+
+/**
+ * @brief 解析二阶节系数 [[b0, b1, b2, a0, a1, a2], ...]
+ * @param obj 1 至 IIR_MAX_SECTIONS 行、每行 6 个数的序列
+ * @param proto 输出：原型系数（IIR_MAX_SECTIONS 个）
+ * @param sections 输出：二阶节数
+ * @return 0 成功，-1 失败（已设置异常）
+ */
+int iir_parse_sections(PyObject* obj, IIRPrototype* proto, uint32_t* sections);
+
+/**
+ * @brief 离散系数转为 sos 列表 [(b0, b1, b2, 1.0, a1, a2), ...]
+ * @return 新引用，失败返回 NULL
+ */
+PyObject* iir_coefficients_to_list(const IIRSection* coef, uint32_t sections);
+
+/**
+ * @brief 原型系数转为列表 [(b0, b1, b2, a0, a1, a2), ...]
+ * @return 新引用，失败返回 NULL
+ */
+PyObject* iir_prototype_to_list(const IIRPrototype* proto, uint32_t sections);
+
+#endif // PY_IIR_H
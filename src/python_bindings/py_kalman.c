@@ -0,0 +1,695 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_kalman.c
+ * @brief 卡尔曼滤波功能块 Python 绑定实现
+ *
+ * 模型矩阵只在构造和 set_noise()/set_state() 时解析（数值、一维序列或按行嵌套的
+ * 序列，numpy 数组亦可），复制到功能块内。每周期的量测和控制输入按缓冲区协议
+ * 直接读取（array('d')、numpy float64 数组），不复制、不分配。
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_kalman.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include "py_view.h"
+#include <stddef.h>
+#include <string.h>
+
+#define KALMAN_MATRIX_CAPACITY (KALMAN_MAX_STATES * KALMAN_MAX_STATES)
+
+// KalmanFilter Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    KalmanFB* fb;
+    Py_ssize_t shape;        // 导出缓冲区的元素个数（状态数）
+    Py_ssize_t stride;
+} KalmanFilterObject;
+
+// 解析后的矩阵参数
+typedef struct {
+    double v[KALMAN_MATRIX_CAPACITY];
+    Py_ssize_t rows, cols;
+    int ndim;                // 0：数值，1：一维序列，2：按行嵌套
+} KalmanMatrix;
+
+static const char Kalman_uninit[] = "实例未初始化";
+
+static const char* const Kalman_kwlist[] = {"F", "H", "Q", "R", "B", "x0", "P0", "gate", NULL};
+
+/**
+ * @brief 解析矩阵参数
+ * @param obj 数值、一维数值序列或按行嵌套的序列
+ * @param name 参数名（用于错误信息）
+ * @param out 输出（行主序）
+ * @return 0 成功，-1 失败（已设置异常）
+ */
+static int Kalman_parse_matrix(PyObject* obj, const char* name, KalmanMatrix* out) {
+    out->rows = out->cols = 1;
+    out->ndim = 0;
+    if (PyFloat_Check(obj) || PyLong_Check(obj)) {
+        return fastcall_as_double(obj, &out->v[0]);
+    }
+
+    PyObject* seq = PySequence_Fast(obj, "");
+    if (!seq) {
+        PyErr_Format(PyExc_TypeError, "%s must be a number or a sequence of numbers", name);
+        return -1;
+    }
+
+    Py_ssize_t rows = PySequence_Fast_GET_SIZE(seq);
+    Py_ssize_t count = 0;
+    out->ndim = 1;
+    out->cols = rows;
+    for (Py_ssize_t i = 0; i < rows; i++) {
+        PyObject* item = PySequence_Fast_GET_ITEM(seq, i);
+        if (i == 0 && PySequence_Check(item) && !PyUnicode_Check(item)) {
+            out->ndim = 2;
+        }
+        if (out->ndim == 1) {
+            if (count >= KALMAN_MATRIX_CAPACITY || fastcall_as_double(item, &out->v[count]) != 0) {
+                goto fail;
+            }
+            count++;
+            continue;
+        }
+
+        PyObject* row = PySequence_Fast(item, "");
+        if (!row) {
+            goto fail;
+        }
+        Py_ssize_t cols = PySequence_Fast_GET_SIZE(row);
+        if (i == 0) {
+            out->cols = cols;
+        }
+        if (cols != out->cols || count + cols > KALMAN_MATRIX_CAPACITY) {
+            Py_DECREF(row);
+            goto fail;
+        }
+        for (Py_ssize_t j = 0; j < cols; j++) {
+            if (fastcall_as_double(PySequence_Fast_GET_ITEM(row, j), &out->v[count++]) != 0) {
+                Py_DECREF(row);
+                goto fail;
+            }
+        }
+        Py_DECREF(row);
+    }
+    Py_DECREF(seq);
+
+    out->rows = out->ndim == 2 ? rows : 1;
+    if (count == 0) {
+        PyErr_Format(PyExc_ValueError, "%s must not be empty", name);
+        return -1;
+    }
+    return 0;
+
+fail:
+    Py_DECREF(seq);
+    if (!PyErr_Occurred() || PyErr_ExceptionMatches(PyExc_TypeError)) {
+        PyErr_Clear();
+        PyErr_Format(PyExc_ValueError, "%s must be a rectangular numeric matrix of at most %dx%d", name,
+                     KALMAN_MAX_STATES, KALMAN_MAX_STATES);
+    }
+    return -1;
+}
+
+// 解析 rows×cols 矩阵（一维序列按一行；数值按 1×1）
+static int Kalman_parse_shape(PyObject* obj, const char* name, Py_ssize_t rows, Py_ssize_t cols,
+                              KalmanMatrix* out) {
+    if (Kalman_parse_matrix(obj, name, out) != 0) {
+        return -1;
+    }
+    if (out->rows != rows || out->cols != cols) {
+        PyErr_Format(PyExc_ValueError, "%s must be %zdx%zd, got %zdx%zd", name, rows,
+                     cols, out->rows, out->cols);
+        return -1;
+    }
+    return 0;
+}
+
+// 解析长度为 n 的向量（数值、一维序列或 n×1 列）
+static int Kalman_parse_vector(PyObject* obj, const char* name, Py_ssize_t n,
+                               KalmanMatrix* out) {
+    if (Kalman_parse_matrix(obj, name, out) != 0) {
+        return -1;
+    }
+    if (out->rows * out->cols != n || (out->ndim == 2 && out->cols != 1 && out->rows != 1)) {
+        PyErr_Format(PyExc_ValueError, "%s must have %zd elements", name, n);
+        return -1;
+    }
+    return 0;
+}
+
+// 量测噪声：m 个方差，或对角的 m×m 矩阵（非对角元须为 0，即量测噪声互不相关）
+static int Kalman_parse_variances(PyObject* obj, Py_ssize_t m, KalmanMatrix* out) {
+    if (Kalman_parse_matrix(obj, "R", out) != 0) {
+        return -1;
+    }
+    if (out->ndim == 2 && out->rows == m && out->cols == m && m > 1) {
+        for (Py_ssize_t i = 0; i < m; i++) {
+            for (Py_ssize_t j = 0; j < m; j++) {
+                if (i != j && out->v[i * m + j] != 0.0) {
+                    PyErr_SetString(PyExc_ValueError,
+                                    "R 必须为对角阵（不支持相关的量测噪声）");
+                    return -1;
+                }
+            }
+            out->v[i] = out->v[i * m + i];
+        }
+        return 0;
+    }
+    return Kalman_parse_vector(obj, "R", m, out);
+}
+
+// 按 Kalman_kwlist 顺序的槽位解析模型；x0 / P0 未提供时对应指针为 NULL
+static int Kalman_parse(PyObject* const* slots, KalmanModel* model, KalmanMatrix* mats,
+                        const double** x0, const double** P0, double* gate) {
+    KalmanMatrix* F = &mats[0];
+    KalmanMatrix* H = &mats[1];
+    KalmanMatrix* Q = &mats[2];
+    KalmanMatrix* R = &mats[3];
+    KalmanMatrix* B = &mats[4];
+    KalmanMatrix* X = &mats[5];
+    KalmanMatrix* P = &mats[6];
+
+    if (Kalman_parse_matrix(slots[0], "F", F) != 0) {
+        return -1;
+    }
+    Py_ssize_t n = F->rows;
+    if (F->rows != F->cols || n > KALMAN_MAX_STATES) {
+        PyErr_Format(PyExc_ValueError, "F must be a square n x n matrix (1 <= n <= %d)", KALMAN_MAX_STATES);
+        return -1;
+    }
+
+    // H 为一维序列时表示单个量测
+    if (Kalman_parse_matrix(slots[1], "H", H) != 0) {
+        return -1;
+    }
+    Py_ssize_t m = H->rows;
+    if (H->cols != n || m > KALMAN_MAX_MEASUREMENTS) {
+        PyErr_Format(PyExc_ValueError, "H must be an m x %zd matrix (1 <= m <= %d)", n,
+                     KALMAN_MAX_MEASUREMENTS);
+        return -1;
+    }
+
+    if (Kalman_parse_shape(slots[2], "Q", n, n, Q) != 0 ||
+        Kalman_parse_variances(slots[3], m, R) != 0) {
+        return -1;
+    }
+
+    // B 为一维序列时表示单个控制输入（n×1）
+    Py_ssize_t p = 0;
+    if (slots[4] && slots[4] != Py_None) {
+        if (Kalman_parse_matrix(slots[4], "B", B) != 0) {
+            return -1;
+        }
+        if (B->ndim < 2) {
+            B->rows = B->cols;
+            B->cols = 1;
+        }
+        p = B->cols;
+        if (B->rows != n || p > KALMAN_MAX_INPUTS) {
+            PyErr_Format(PyExc_ValueError, "B must be a %zd x p matrix (p <= %d)", n,
+                         KALMAN_MAX_INPUTS);
+            return -1;
+        }
+    }
+
+    *x0 = NULL;
+    *P0 = NULL;
+    if (slots[5] && slots[5] != Py_None) {
+        if (Kalman_parse_vector(slots[5], "x0", n, X) != 0) {
+            return -1;
+        }
+        *x0 = X->v;
+    }
+    if (slots[6] && slots[6] != Py_None) {
+        if (Kalman_parse_shape(slots[6], "P0", n, n, P) != 0) {
+            return -1;
+        }
+        *P0 = P->v;
+    }
+
+    *gate = 0.0;
+    if (slots[7] && fastcall_as_double(slots[7], gate) != 0) {
+        return -1;
+    }
+
+    model->n = (uint32_t)n;
+    model->m = (uint32_t)m;
+    model->p = (uint32_t)p;
+    model->F = F->v;
+    model->B = p > 0 ? B->v : NULL;
+    model->H = H->v;
+    model->Q = Q->v;
+    model->R = R->v;
+    return 0;
+}
+
+static const char Kalman_param_error[] =
+    "KalmanFilter 参数无效：矩阵须为有限值，Q / P0 对称且对角元非负，R 的方差须为正，"
+    "gate >= 0";
+
+// 析构函数
+static void KalmanFilter_dealloc(KalmanFilterObject* self) {
+    if (self->fb) {
+        kalman_destroy(self->fb);
+    }
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 校验模型并创建 C 功能块
+static int KalmanFilter_setup(KalmanFilterObject* self, PyObject* const* slots) {
+    KalmanModel model;
+    KalmanMatrix mats[7];
+    const double* x0;
+    const double* P0;
+    double gate;
+
+    if (Kalman_parse(slots, &model, mats, &x0, &P0, &gate) != 0) {
+        return -1;
+    }
+    if (!(gate >= 0.0) || !isfinite(gate)) {
+        PyErr_SetString(PyExc_ValueError, Kalman_param_error);
+        return -1;
+    }
+
+    KalmanFB fresh;
+    if (kalman_init(&fresh, &model, x0, P0) != 0) {
+        PyErr_SetString(PyExc_ValueError, Kalman_param_error);
+        return -1;
+    }
+
+    // 重复调用 __init__ 时原地重新初始化，保持 ID 和注册表名称
+    if (self->fb) {
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+    } else {
+        self->fb = kalman_create(&model, x0, P0);
+        if (!self->fb) {
+            PyErr_SetString(PyExc_MemoryError, "卡尔曼滤波器创建失败：实例池或注册表已满");
+            return -1;
+        }
+        fb_py_register_owner((PyObject*)self, self->fb);
+    }
+
+    kalman_set_gate(self->fb, gate);
+    self->shape = (Py_ssize_t)self->fb->n;
+    self->stride = sizeof(double);
+    return 0;
+}
+
+// 构造函数：__init__(self, F, H, Q, R, B=None, x0=None, P0=None, gate=0.0)
+static int KalmanFilter_init(KalmanFilterObject* self, PyObject* args, PyObject* kwds) {
+    PyObject* slots[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|OOOO", (char**)Kalman_kwlist,
+                                     &slots[0], &slots[1], &slots[2], &slots[3], &slots[4],
+                                     &slots[5], &slots[6], &slots[7])) {
+        return -1;
+    }
+
+    return KalmanFilter_setup(self, slots);
+}
+
+// vectorcall 构造：KalmanFilter(...) 直接创建实例
+static PyObject* KalmanFilter_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                         PyObject* kwnames) {
+    PyObject* slots[8];
+
+    if (fastcall_unpack("KalmanFilter", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        Kalman_kwlist, 4, slots) != 0) {
+        return NULL;
+    }
+
+    KalmanFilterObject* self =
+        (KalmanFilterObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (KalmanFilter_setup(self, slots) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// 取得长度为 n 的只读输入：缓冲区直接引用，序列复制到 fallback；单个量测/输入可为数值
+static int Kalman_input(PyObject* obj, const char* name, Py_ssize_t n, Py_buffer* view,
+                        double* fallback, const double** data) {
+    view->obj = NULL;
+    if (n == 1 && (PyFloat_Check(obj) || PyLong_Check(obj))) {
+        *data = fallback;
+        return fastcall_as_double(obj, fallback);
+    }
+
+    double* ptr;
+    if (fb_get_doubles(obj, name, n, 0, view, fallback, &ptr) != 0) {
+        return -1;
+    }
+    *data = ptr;
+    return 0;
+}
+
+// compute(z, u=None, out=None) -> out 或状态估计的 memoryview
+static PyObject* KalmanFilter_compute(KalmanFilterObject* self, PyObject* const* args,
+                                      Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"z", "u", "out", NULL};
+    PyObject* slots[3];
+    double z_buf[KALMAN_MAX_MEASUREMENTS];
+    double u_buf[KALMAN_MAX_INPUTS];
+    Py_buffer z_view = {0}, u_view = {0}, out_view = {0};
+    const double* z = NULL;
+    const double* u = NULL;
+    double* out = NULL;
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+
+    KalmanFB* fb = self->fb;
+    int has_u = slots[1] && slots[1] != Py_None;
+    int has_out = slots[2] && slots[2] != Py_None;
+    if (has_u && fb->p == 0) {
+        PyErr_SetString(PyExc_ValueError, "模型没有控制输入（未给出 B）");
+        return NULL;
+    }
+
+    if ((slots[0] != Py_None &&
+         Kalman_input(slots[0], "z", (Py_ssize_t)fb->m, &z_view, z_buf, &z) != 0) ||
+        (has_u && Kalman_input(slots[1], "u", (Py_ssize_t)fb->p, &u_view, u_buf, &u) != 0) ||
+        (has_out && fb_get_doubles(slots[2], "out", (Py_ssize_t)fb->n, 1, &out_view, NULL,
+                                   &out) != 0)) {
+        if (z_view.obj) {
+            PyBuffer_Release(&z_view);
+        }
+        if (u_view.obj) {
+            PyBuffer_Release(&u_view);
+        }
+        return NULL;
+    }
+
+    const double* x = kalman_compute(fb, z, u);
+
+    if (z_view.obj) {
+        PyBuffer_Release(&z_view);
+    }
+    if (u_view.obj) {
+        PyBuffer_Release(&u_view);
+    }
+    if (has_out) {
+        memcpy(out, x, fb->n * sizeof(double));
+        PyBuffer_Release(&out_view);
+        Py_INCREF(slots[2]);
+        return slots[2];
+    }
+    return PyMemoryView_FromObject((PyObject*)self);
+}
+
+// reset()
+static PyObject* KalmanFilter_reset(KalmanFilterObject* self, PyObject* Py_UNUSED(ignored)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+    kalman_reset(self->fb);
+    Py_RETURN_NONE;
+}
+
+// set_state(x=None, P=None)
+static PyObject* KalmanFilter_set_state(KalmanFilterObject* self, PyObject* const* args,
+                                        Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"x", "P", NULL};
+    PyObject* slots[2];
+    KalmanMatrix X, P;
+    const double* x = NULL;
+    const double* cov = NULL;
+
+    if (fastcall_unpack("set_state", args, nargs, kwnames, kwlist, 0, slots) != 0) {
+        return NULL;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+
+    Py_ssize_t n = (Py_ssize_t)self->fb->n;
+    if (slots[0] && slots[0] != Py_None) {
+        if (Kalman_parse_vector(slots[0], "x", n, &X) != 0) {
+            return NULL;
+        }
+        x = X.v;
+    }
+    if (slots[1] && slots[1] != Py_None) {
+        if (Kalman_parse_shape(slots[1], "P", n, n, &P) != 0) {
+            return NULL;
+        }
+        cov = P.v;
+    }
+
+    if (kalman_set_state(self->fb, x, cov) != 0) {
+        PyErr_SetString(PyExc_ValueError, "状态须为有限值，P 须对称且对角元非负");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// set_noise(Q=None, R=None)
+static PyObject* KalmanFilter_set_noise(KalmanFilterObject* self, PyObject* const* args,
+                                        Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"Q", "R", NULL};
+    PyObject* slots[2];
+    KalmanMatrix Q, R;
+    const double* q = NULL;
+    const double* r = NULL;
+
+    if (fastcall_unpack("set_noise", args, nargs, kwnames, kwlist, 0, slots) != 0) {
+        return NULL;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+
+    Py_ssize_t n = (Py_ssize_t)self->fb->n;
+    if (slots[0] && slots[0] != Py_None) {
+        if (Kalman_parse_shape(slots[0], "Q", n, n, &Q) != 0) {
+            return NULL;
+        }
+        q = Q.v;
+    }
+    if (slots[1] && slots[1] != Py_None) {
+        if (Kalman_parse_variances(slots[1], (Py_ssize_t)self->fb->m, &R) != 0) {
+            return NULL;
+        }
+        r = R.v;
+    }
+
+    if (kalman_set_noise(self->fb, q, r) != 0) {
+        PyErr_SetString(PyExc_ValueError, "Q 须对称且对角元非负，R 的方差须为正");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* Kalman_tuple(const double* v, uint32_t n) {
+    PyObject* t = PyTuple_New((Py_ssize_t)n);
+    if (!t) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        PyObject* item = PyFloat_FromDouble(v[i]);
+        if (!item) {
+            Py_DECREF(t);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(t, (Py_ssize_t)i, item);
+    }
+    return t;
+}
+
+static PyObject* KalmanFilter_get_x(KalmanFilterObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+    return Kalman_tuple(self->fb->x, self->fb->n);
+}
+
+static PyObject* KalmanFilter_get_P(KalmanFilterObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+
+    PyObject* rows = PyTuple_New((Py_ssize_t)self->fb->n);
+    if (!rows) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < self->fb->n; i++) {
+        PyObject* row = Kalman_tuple(self->fb->P[i], self->fb->n);
+        if (!row) {
+            Py_DECREF(rows);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(rows, (Py_ssize_t)i, row);
+    }
+    return rows;
+}
+
+static PyObject* KalmanFilter_get_innovation(KalmanFilterObject* self,
+                                             void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+    return Kalman_tuple(self->fb->innovation, self->fb->m);
+}
+
+// 只读计数属性：closure 为字段偏移
+static PyObject* KalmanFilter_get_u64(KalmanFilterObject* self, void* closure) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(*(uint64_t*)((char*)self->fb + (size_t)closure));
+}
+
+static PyObject* KalmanFilter_get_dim(KalmanFilterObject* self, void* closure) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+    return PyLong_FromUnsignedLong(*(uint32_t*)((char*)self->fb + (size_t)closure));
+}
+
+static PyObject* KalmanFilter_get_gate(KalmanFilterObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return NULL;
+    }
+    return PyFloat_FromDouble(self->fb->gate);
+}
+
+static int KalmanFilter_set_gate(KalmanFilterObject* self, PyObject* value,
+                                 void* Py_UNUSED(closure)) {
+    double gate;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 gate");
+        return -1;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Kalman_uninit);
+        return -1;
+    }
+    if (fastcall_as_double(value, &gate) != 0) {
+        return -1;
+    }
+    if (kalman_set_gate(self->fb, gate) != 0) {
+        PyErr_SetString(PyExc_ValueError, "gate 必须 >= 0");
+        return -1;
+    }
+    return 0;
+}
+
+static int KalmanFilter_getbuffer(KalmanFilterObject* self, Py_buffer* view, int flags) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_BufferError, Kalman_uninit);
+        view->obj = NULL;
+        return -1;
+    }
+    return fb_export_doubles(view, (PyObject*)self, self->fb->x, &self->shape, &self->stride,
+                             flags);
+}
+
+static PyGetSetDef KalmanFilter_getset[] = {
+    {"x", (getter)KalmanFilter_get_x, NULL, "状态估计（只读 tuple）", NULL},
+    {"P", (getter)KalmanFilter_get_P, NULL, "估计误差协方差（只读，按行的 tuple）", NULL},
+    {"innovation", (getter)KalmanFilter_get_innovation, NULL,
+     "最近一次各量测的新息 z - H·x，跳过的量测为 NaN（只读）", NULL},
+    {"gate", (getter)KalmanFilter_get_gate, (setter)KalmanFilter_set_gate,
+     "新息门限（标准差倍数），0 表示不检验", NULL},
+    {"n", (getter)KalmanFilter_get_dim, NULL, "状态数（只读）",
+     (void*)offsetof(KalmanFB, n)},
+    {"m", (getter)KalmanFilter_get_dim, NULL, "量测数（只读）",
+     (void*)offsetof(KalmanFB, m)},
+    {"p", (getter)KalmanFilter_get_dim, NULL, "控制输入数（只读）",
+     (void*)offsetof(KalmanFB, p)},
+    {"steps", (getter)KalmanFilter_get_u64, NULL, "reset 以来的周期数（只读）",
+     (void*)offsetof(KalmanFB, steps)},
+    {"rejected", (getter)KalmanFilter_get_u64, NULL, "被门限剔除的量测数（只读）",
+     (void*)offsetof(KalmanFB, rejected)},
+    FB_REGISTRY_GETSET(KalmanFilterObject, fb),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef KalmanFilter_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))KalmanFilter_compute, METH_FASTCALL | METH_KEYWORDS,
+     "执行一个周期：预测后用量测更新\n\n参数:\n"
+     "  z: m 个量测（float64 缓冲区或序列，单个量测可为数值），NaN 表示该量测无效，\n"
+     "     None 表示只预测\n"
+     "  u: 可选，p 个控制输入\n"
+     "  out: 可选，可写的 float64 缓冲区（长度 n），写入状态估计\n\n"
+     "返回:\n  out，或状态估计的 memoryview"},
+    {"reset", (PyCFunction)KalmanFilter_reset, METH_NOARGS, "恢复 x0 / P0，清零统计"},
+    {"set_state", (PyCFunction)(void(*)(void))KalmanFilter_set_state,
+     METH_FASTCALL | METH_KEYWORDS, "设置当前状态估计和/或协方差\n\n参数:\n  x: n 个状态\n"
+     "  P: n×n 协方差"},
+    {"set_noise", (PyCFunction)(void(*)(void))KalmanFilter_set_noise,
+     METH_FASTCALL | METH_KEYWORDS, "修改噪声协方差\n\n参数:\n  Q: n×n 过程噪声协方差\n"
+     "  R: m 个量测噪声方差（或对角阵）"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyBufferProcs KalmanFilter_as_buffer = {
+    .bf_getbuffer = (getbufferproc)KalmanFilter_getbuffer,
+    .bf_releasebuffer = NULL,
+};
+
+// 类型定义
+PyTypeObject KalmanFilterType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.KalmanFilter",
+    .tp_doc = "离散线性卡尔曼滤波功能块（最多 8 个状态、8 个量测、4 个控制输入）\n\n"
+              "KalmanFilter(F, H, Q, R, B=None, x0=None, P0=None, gate=0.0)\n\n"
+              "x = F·x + B·u，z = H·x + v；R 为各量测的噪声方差（量测噪声互不相关）。\n"
+              "每周期先预测再逐个量测做标量更新，不分配内存；对象的缓冲区即状态估计。",
+    .tp_basicsize = sizeof(KalmanFilterObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)KalmanFilter_init,
+    .tp_dealloc = (destructor)KalmanFilter_dealloc,
+    .tp_methods = KalmanFilter_methods,
+    .tp_getset = KalmanFilter_getset,
+    .tp_as_buffer = &KalmanFilter_as_buffer,
+    .tp_vectorcall = KalmanFilter_vectorcall,
+};
@@ -28,37 +28,47 @@
 
 #include <Python.h>
 #include "../function_blocks/fb_limit.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include "py_view.h"
+#include <stddef.h>
 
 /* Limit 对象结构 */
 typedef struct {
     PyObject_HEAD
-    LimitFB fb;
+    LimitFB* fb;  /* C 功能块实例（来自实例池） */
 } LimitObject;
 
+static const char* const Limit_range_kwlist[] = {"min_value", "max_value", NULL};
+
 /* Limit.compute() */
-static PyObject* Limit_compute(LimitObject* self, PyObject* args, PyObject* kwargs) {
+static PyObject* Limit_compute(LimitObject* self, PyObject* const* args, Py_ssize_t nargs,
+                               PyObject* kwnames) {
+    static const char* const kwlist[] = {"input", NULL};
     double input;
-    static char* kwlist[] = {"input", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d", kwlist, &input)) {
+    if (nargs == 1 && !kwnames) {
+        if (fastcall_as_double(args[0], &input) != 0) {
+            return NULL;
+        }
+    } else if (fastcall_parse_doubles("compute", args, nargs, kwnames, kwlist, 1, &input) != 0) {
         return NULL;
     }
 
-    double output = limit_compute(&self->fb, input);
+    double output = limit_compute(self->fb, input);
     return PyFloat_FromDouble(output);
 }
 
 /* Limit.set_params() */
-static PyObject* Limit_set_params(LimitObject* self, PyObject* args, PyObject* kwargs) {
-    double min_value, max_value;
-    static char* kwlist[] = {"min_value", "max_value", NULL};
+static PyObject* Limit_set_params(LimitObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                  PyObject* kwnames) {
+    double v[2];
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "dd", kwlist,
-                                      &min_value, &max_value)) {
+    if (fastcall_parse_doubles("set_params", args, nargs, kwnames, Limit_range_kwlist, 2, v) != 0) {
         return NULL;
     }
 
-    if (limit_set_params(&self->fb, min_value, max_value) != 0) {
+    if (limit_set_params(self->fb, v[0], v[1]) != 0) {
         PyErr_SetString(PyExc_ValueError, "Invalid parameters (min > max)");
         return NULL;
     }
@@ -66,48 +76,115 @@ static PyObject* Limit_set_params(LimitObject* self, PyObject* args, PyObject* k
     Py_RETURN_NONE;
 }
 
-/* Limit.get_params() */
+/* 视图字段：min_value、max_value 在 LimitFB 中连续存放 */
+static const char* const Limit_param_fields[] = {"min_value", "max_value"};
+
+_Static_assert(offsetof(LimitFB, max_value) == offsetof(LimitFB, min_value) + sizeof(double),
+               "Limit 参数必须连续存放");
+
+static double* Limit_params_data(PyObject* owner) {
+    return &((LimitObject*)owner)->fb->min_value;
+}
+
+/* Limit.get_params()（兼容接口，推荐使用属性或 params 视图） */
 static PyObject* Limit_get_params(LimitObject* self, PyObject* Py_UNUSED(args)) {
-    double min_value, max_value;
-    limit_get_params(&self->fb, &min_value, &max_value);
+    return fb_fields_to_dict(Limit_param_fields, Limit_params_data((PyObject*)self), 2);
+}
 
-    PyObject* dict = PyDict_New();
-    if (!dict) return NULL;
+/* Limit.min_value / Limit.max_value 属性：closure 为 0/1 */
+static PyObject* Limit_get_bound(LimitObject* self, void* closure) {
+    return PyFloat_FromDouble(Limit_params_data((PyObject*)self)[(size_t)closure]);
+}
 
-    PyDict_SetItemString(dict, "min_value", PyFloat_FromDouble(min_value));
-    PyDict_SetItemString(dict, "max_value", PyFloat_FromDouble(max_value));
+static int Limit_set_bound(LimitObject* self, PyObject* value, void* closure) {
+    double bounds[2] = {self->fb->min_value, self->fb->max_value};
 
-    return dict;
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "Cannot delete limit parameter");
+        return -1;
+    }
+    if (fastcall_as_double(value, &bounds[(size_t)closure]) != 0) {
+        return -1;
+    }
+    if (limit_set_params(self->fb, bounds[0], bounds[1]) != 0) {
+        PyErr_SetString(PyExc_ValueError, "Invalid parameters (min > max)");
+        return -1;
+    }
+    return 0;
+}
+
+/* Limit.params 零拷贝视图 */
+static PyObject* Limit_get_params_view(LimitObject* self, void* Py_UNUSED(closure)) {
+    return fb_view_new((PyObject*)self, Limit_params_data, Limit_param_fields, 2);
 }
 
+/* 属性表 */
+static PyGetSetDef Limit_getset[] = {
+    {"min_value", (getter)Limit_get_bound, (setter)Limit_set_bound, "Lower bound", (void*)0},
+    {"max_value", (getter)Limit_get_bound, (setter)Limit_set_bound, "Upper bound", (void*)1},
+    {"params", (getter)Limit_get_params_view, NULL,
+     "Zero-copy read-only view {min_value, max_value}", NULL},
+    FB_REGISTRY_GETSET(LimitObject, fb),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
 /* 方法表 */
 static PyMethodDef Limit_methods[] = {
-    {"compute", (PyCFunction)Limit_compute, METH_VARARGS | METH_KEYWORDS,
+    {"compute", (PyCFunction)(void(*)(void))Limit_compute, METH_FASTCALL | METH_KEYWORDS,
      "Compute limited output"},
-    {"set_params", (PyCFunction)Limit_set_params, METH_VARARGS | METH_KEYWORDS,
+    {"set_params", (PyCFunction)(void(*)(void))Limit_set_params, METH_FASTCALL | METH_KEYWORDS,
      "Set limit parameters"},
     {"get_params", (PyCFunction)Limit_get_params, METH_NOARGS,
      "Get limit parameters"},
     {NULL, NULL, 0, NULL}
 };
 
+/* Limit.__del__()：实例归还实例池 */
+static void Limit_dealloc(LimitObject* self) {
+    if (self->fb) {
+        limit_destroy(self->fb);
+    }
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* 按参数创建 C 功能块；重复调用 __init__ 时原地更新，保持已导出视图的地址有效 */
+static int Limit_setup(LimitObject* self, double min_value, double max_value) {
+    if (self->fb) {
+        LimitFB fresh;
+        if (limit_init(&fresh, min_value, max_value) != 0) {
+            PyErr_SetString(PyExc_ValueError, "Failed to initialize Limit (min > max)");
+            return -1;
+        }
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+        return 0;
+    }
+
+    if (min_value > max_value) {
+        PyErr_SetString(PyExc_ValueError, "Failed to initialize Limit (min > max)");
+        return -1;
+    }
+
+    self->fb = limit_create(min_value, max_value);
+    if (!self->fb) {
+        PyErr_SetString(PyExc_MemoryError, "Limit 创建失败：实例池或注册表已满");
+        return -1;
+    }
+    fb_py_register_owner((PyObject*)self, self->fb);
+
+    return 0;
+}
+
 /* Limit.__init__() */
 static int Limit_init(LimitObject* self, PyObject* args, PyObject* kwargs) {
     double min_value = 0.0;
     double max_value = 100.0;
-    static char* kwlist[] = {"min_value", "max_value", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|dd", kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|dd", (char**)Limit_range_kwlist,
                                       &min_value, &max_value)) {
         return -1;
     }
 
-    if (limit_init(&self->fb, min_value, max_value) != 0) {
-        PyErr_SetString(PyExc_ValueError, "Failed to initialize Limit (min > max)");
-        return -1;
-    }
-
-    return 0;
+    return Limit_setup(self, min_value, max_value);
 }
 
 /* Limit.__new__() */
@@ -116,6 +193,29 @@ static PyObject* Limit_new(PyTypeObject* type, PyObject* args, PyObject* kwargs)
     return (PyObject*)self;
 }
 
+/* Limit(...) vectorcall 构造 */
+static PyObject* Limit_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                  PyObject* kwnames) {
+    double v[2] = {0.0, 100.0};
+
+    if (fastcall_parse_doubles("Limit", args, PyVectorcall_NARGS(nargsf), kwnames,
+                               Limit_range_kwlist, 0, v) != 0) {
+        return NULL;
+    }
+
+    LimitObject* self = (LimitObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (Limit_setup(self, v[0], v[1]) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
 /* Limit 类型对象 */
 PyTypeObject LimitType = {
     PyVarObject_HEAD_INIT(NULL, 0)
@@ -124,7 +224,10 @@ PyTypeObject LimitType = {
     .tp_basicsize = sizeof(LimitObject),
     .tp_itemsize = 0,
     .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)Limit_dealloc,
     .tp_new = Limit_new,
     .tp_init = (initproc)Limit_init,
     .tp_methods = Limit_methods,
+    .tp_getset = Limit_getset,
+    .tp_vectorcall = Limit_vectorcall,
 };
@@ -0,0 +1,700 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_lookup.c
+ * @brief 折线表功能块 Python 绑定实现
+ *
+ * 表参数为 C 连续、格式 'd' 的缓冲区（array('d')、numpy float64 数组等）时直接
+ * 引用，不复制：对象持有缓冲区视图直到换表或析构，期间缓冲区不能改变大小，
+ * 就地修改输出值立即生效。其他序列复制到对象自有的数组中。
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_lookup.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include <string.h>
+
+// 表参数的持有方式：缓冲区视图（view.obj 非 NULL）或复制的数组（owned）
+typedef struct {
+    Py_buffer view;
+    double* owned;
+} LookupHold;
+
+// Lookup1D Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    Lookup1DFB* fb;
+    LookupHold hold[2];      // x, y
+} Lookup1DObject;
+
+// Lookup2D Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    Lookup2DFB* fb;
+    LookupHold hold[3];      // u, v, z
+} Lookup2DObject;
+
+static const char Lookup_uninit[] = "实例未初始化";
+
+static const char Lookup_param_error[] =
+    "折线表参数无效：断点须为严格递增的有限值，至少 2 个，输出值个数须与断点匹配";
+
+static void hold_release(LookupHold* h) {
+    if (h->view.obj) {
+        PyBuffer_Release(&h->view);
+    }
+    PyMem_Free(h->owned);
+    memset(h, 0, sizeof(*h));
+}
+
+static void holds_release(LookupHold* h, int count) {
+    for (int i = 0; i < count; i++) {
+        hold_release(&h[i]);
+    }
+}
+
+// 缓冲区是否可直接按 double 数组引用
+static int buffer_is_double(const Py_buffer* view) {
+    const char* f = view->format ? view->format : "B";
+    return view->itemsize == (Py_ssize_t)sizeof(double) &&
+           (strcmp(f, "d") == 0 || strcmp(f, "@d") == 0 || strcmp(f, "=d") == 0);
+}
+
+// 把序列元素追加到 out；flatten 为 1 时元素本身可以是一行数值
+static Py_ssize_t copy_sequence(PyObject* seq, double* out, Py_ssize_t capacity,
+                                int flatten) {
+    Py_ssize_t count = 0;
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject* item = PySequence_Fast_GET_ITEM(seq, i);
+        if (flatten && (PyList_Check(item) || PyTuple_Check(item))) {
+            PyObject* row = PySequence_Fast(item, "table rows must be sequences");
+            if (!row) {
+                return -1;
+            }
+            Py_ssize_t got = copy_sequence(row, out + count, capacity - count, 0);
+            Py_DECREF(row);
+            if (got < 0) {
+                return -1;
+            }
+            count += got;
+            continue;
+        }
+        if (count >= capacity) {
+            PyErr_SetString(PyExc_ValueError, "table has too many values");
+            return -1;
+        }
+        if (fastcall_as_double(item, &out[count]) != 0) {
+            return -1;
+        }
+        count++;
+    }
+    return count;
+}
+
+// 序列中数值的总个数（flatten 时展开一层）
+static Py_ssize_t sequence_length(PyObject* seq, int flatten) {
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    Py_ssize_t total = 0;
+
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject* item = PySequence_Fast_GET_ITEM(seq, i);
+        if (flatten && (PyList_Check(item) || PyTuple_Check(item))) {
+            total += PySequence_Size(item);
+        } else {
+            total++;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief 取得表参数的数据：double 缓冲区直接引用，其他序列复制
+ * @param obj 表参数
+ * @param flatten 1：序列元素可以是一行数值（二维表的 z）
+ * @param h 输出持有方式（调用者负责 hold_release）
+ * @param data 输出数据指针
+ * @param n 输出数值个数
+ * @return 0 成功，-1 失败（已设置 Python 异常）
+ */
+static int hold_acquire(PyObject* obj, int flatten, LookupHold* h, const double** data,
+                        Py_ssize_t* n) {
+    memset(h, 0, sizeof(*h));
+
+    if (PyObject_CheckBuffer(obj)) {
+        if (PyObject_GetBuffer(obj, &h->view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0) {
+            if (buffer_is_double(&h->view)) {
+                *data = (const double*)h->view.buf;
+                *n = h->view.len / (Py_ssize_t)sizeof(double);
+                return 0;
+            }
+            PyBuffer_Release(&h->view);
+            memset(&h->view, 0, sizeof(h->view));
+        } else {
+            PyErr_Clear();           // 非连续缓冲区按序列复制
+        }
+    }
+
+    PyObject* seq = PySequence_Fast(obj, "table must be a sequence of numbers");
+    if (!seq) {
+        return -1;
+    }
+
+    Py_ssize_t total = sequence_length(seq, flatten);
+    if (total < 0 || (size_t)total > (size_t)LOOKUP_MAX_POINTS * LOOKUP_MAX_POINTS) {
+        Py_DECREF(seq);
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_ValueError, "table is too large");
+        }
+        return -1;
+    }
+
+    h->owned = PyMem_New(double, total > 0 ? total : 1);
+    if (!h->owned) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    Py_ssize_t got = copy_sequence(seq, h->owned, total, flatten);
+    Py_DECREF(seq);
+    if (got < 0) {
+        hold_release(h);
+        return -1;
+    }
+
+    *data = h->owned;
+    *n = got;
+    return 0;
+}
+
+/* ========== Lookup1D ========== */
+
+static void Lookup1D_dealloc(Lookup1DObject* self) {
+    if (self->fb) {
+        lookup1d_destroy(self->fb);
+    }
+    holds_release(self->hold, 2);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 取得 x、y 两个表参数并校验个数
+static int Lookup1D_acquire(PyObject* x_obj, PyObject* y_obj, LookupHold* hold,
+                            const double** x, const double** y, size_t* n) {
+    Py_ssize_t nx, ny;
+
+    if (hold_acquire(x_obj, 0, &hold[0], x, &nx) != 0) {
+        return -1;
+    }
+    if (hold_acquire(y_obj, 0, &hold[1], y, &ny) != 0) {
+        hold_release(&hold[0]);
+        return -1;
+    }
+    if (nx != ny) {
+        PyErr_Format(PyExc_ValueError, "x and y must have the same length (%zd != %zd)",
+                     nx, ny);
+        holds_release(hold, 2);
+        return -1;
+    }
+    *n = (size_t)nx;
+    return 0;
+}
+
+// 按参数创建 C 功能块
+static int Lookup1D_setup(Lookup1DObject* self, PyObject* x_obj, PyObject* y_obj, int clamped) {
+    LookupHold hold[2];
+    const double *x, *y;
+    size_t n;
+
+    if (Lookup1D_acquire(x_obj, y_obj, hold, &x, &y, &n) != 0) {
+        return -1;
+    }
+
+    Lookup1DFB fresh;
+    if (lookup1d_init(&fresh, x, y, n, clamped) != 0) {
+        holds_release(hold, 2);
+        PyErr_SetString(PyExc_ValueError, Lookup_param_error);
+        return -1;
+    }
+
+    // 重复调用 __init__ 时原地重新初始化，保持 ID 和注册表名称
+    if (self->fb) {
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+    } else {
+        self->fb = lookup1d_create(x, y, n, clamped);
+        if (!self->fb) {
+            holds_release(hold, 2);
+            PyErr_SetString(PyExc_MemoryError, "折线表创建失败：实例池或注册表已满");
+            return -1;
+        }
+        fb_py_register_owner((PyObject*)self, self->fb);
+    }
+
+    holds_release(self->hold, 2);
+    memcpy(self->hold, hold, sizeof(hold));
+    return 0;
+}
+
+static const char* const Lookup1D_kwlist[] = {"x", "y", "clamp", NULL};
+
+// 构造函数：__init__(self, x, y, clamp=True)
+static int Lookup1D_init(Lookup1DObject* self, PyObject* args, PyObject* kwds) {
+    PyObject *x, *y;
+    int clamped = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|p", (char**)Lookup1D_kwlist,
+                                     &x, &y, &clamped)) {
+        return -1;
+    }
+
+    return Lookup1D_setup(self, x, y, clamped);
+}
+
+// vectorcall 构造：Lookup1D(...) 直接创建实例
+static PyObject* Lookup1D_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                     PyObject* kwnames) {
+    PyObject* slots[3];
+    int clamped = 1;
+
+    if (fastcall_unpack("Lookup1D", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        Lookup1D_kwlist, 2, slots) != 0 ||
+        (slots[2] && (clamped = PyObject_IsTrue(slots[2])) < 0)) {
+        return NULL;
+    }
+
+    Lookup1DObject* self =
+        (Lookup1DObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (Lookup1D_setup(self, slots[0], slots[1], clamped) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(input) -> float
+static PyObject* Lookup1D_compute(Lookup1DObject* self, PyObject* arg) {
+    double input;
+
+    if (fastcall_as_double(arg, &input) != 0) {
+        return NULL;
+    }
+
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+
+    return PyFloat_FromDouble(lookup1d_compute(self->fb, input));
+}
+
+// set_table(x, y)：换表，失败时原表不变
+static PyObject* Lookup1D_set_table(Lookup1DObject* self, PyObject* const* args,
+                                    Py_ssize_t nargs) {
+    LookupHold hold[2];
+    const double *x, *y;
+    size_t n;
+
+    if (fastcall_check_nargs("set_table", nargs, 2, 2) != 0) {
+        return NULL;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    if (Lookup1D_acquire(args[0], args[1], hold, &x, &y, &n) != 0) {
+        return NULL;
+    }
+
+    if (lookup1d_set_table(self->fb, x, y, n) != 0) {
+        holds_release(hold, 2);
+        PyErr_SetString(PyExc_ValueError, Lookup_param_error);
+        return NULL;
+    }
+
+    holds_release(self->hold, 2);
+    memcpy(self->hold, hold, sizeof(hold));
+    Py_RETURN_NONE;
+}
+
+static PyObject* Lookup1D_get_clamp(Lookup1DObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    return PyBool_FromLong(self->fb->clamp);
+}
+
+static int Lookup1D_set_clamp(Lookup1DObject* self, PyObject* value, void* Py_UNUSED(closure)) {
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 clamp");
+        return -1;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return -1;
+    }
+    int clamped = PyObject_IsTrue(value);
+    if (clamped < 0) {
+        return -1;
+    }
+    self->fb->clamp = clamped;
+    return 0;
+}
+
+static PyObject* Lookup1D_get_output(Lookup1DObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    return PyFloat_FromDouble(self->fb->output);
+}
+
+static PyObject* Lookup1D_get_points(Lookup1DObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    return PyLong_FromUnsignedLong(self->fb->axis.n);
+}
+
+static PyObject* Lookup1D_get_uniform(Lookup1DObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    return PyBool_FromLong(self->fb->axis.uniform);
+}
+
+static PyObject* Lookup1D_get_shared(Lookup1DObject* self, void* Py_UNUSED(closure)) {
+    return PyBool_FromLong(self->hold[0].view.obj && self->hold[1].view.obj);
+}
+
+// 属性表
+static PyGetSetDef Lookup1D_getset[] = {
+    {"clamp", (getter)Lookup1D_get_clamp, (setter)Lookup1D_set_clamp,
+     "True：超出断点范围时输出端点值；False：按端点区间线性外推", NULL},
+    {"output", (getter)Lookup1D_get_output, NULL, "最近一次输出（只读）", NULL},
+    {"points", (getter)Lookup1D_get_points, NULL, "断点数（只读）", NULL},
+    {"uniform", (getter)Lookup1D_get_uniform, NULL,
+     "断点是否等间距（只读；等间距时区间下标直接计算）", NULL},
+    {"shared", (getter)Lookup1D_get_shared, NULL,
+     "x、y 是否都直接引用调用者的缓冲区（只读）", NULL},
+    FB_REGISTRY_GETSET(Lookup1DObject, fb),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+// 方法表
+static PyMethodDef Lookup1D_methods[] = {
+    {"compute", (PyCFunction)Lookup1D_compute, METH_O,
+     "查表并线性插值\n\n参数:\n  input: 输入值\n\n返回:\n  float: 插值结果"},
+    {"set_table", (PyCFunction)(void(*)(void))Lookup1D_set_table, METH_FASTCALL,
+     "换用新表（失败时原表不变）；就地修改了断点后也应调用一次\n\n"
+     "参数:\n  x: 严格递增的断点\n  y: 各断点的输出值"},
+    {NULL, NULL, 0, NULL}
+};
+
+// 类型定义
+PyTypeObject Lookup1DType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.Lookup1D",
+    .tp_doc = "一维折线表功能块\n\n"
+              "Lookup1D(x, y, clamp=True)：x 为严格递增的断点，y 为各断点的输出值，\n"
+              "断点之间线性插值。等间距断点 O(1) 定位区间，其他断点先查上次的区间再二分。\n"
+              "array('d') 等 double 缓冲区直接引用不复制，就地修改 y 立即生效。",
+    .tp_basicsize = sizeof(Lookup1DObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Lookup1D_init,
+    .tp_dealloc = (destructor)Lookup1D_dealloc,
+    .tp_methods = Lookup1D_methods,
+    .tp_getset = Lookup1D_getset,
+    .tp_vectorcall = Lookup1D_vectorcall,
+};
+
+/* ========== Lookup2D ========== */
+
+static void Lookup2D_dealloc(Lookup2DObject* self) {
+    if (self->fb) {
+        lookup2d_destroy(self->fb);
+    }
+    holds_release(self->hold, 3);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 取得 u、v、z 三个表参数并校验个数
+static int Lookup2D_acquire(PyObject* u_obj, PyObject* v_obj, PyObject* z_obj,
+                            LookupHold* hold, const double** u, size_t* nu,
+                            const double** v, size_t* nv, const double** z) {
+    Py_ssize_t n_u, n_v, n_z;
+
+    if (hold_acquire(u_obj, 0, &hold[0], u, &n_u) != 0) {
+        return -1;
+    }
+    if (hold_acquire(v_obj, 0, &hold[1], v, &n_v) != 0) {
+        hold_release(&hold[0]);
+        return -1;
+    }
+    if (hold_acquire(z_obj, 1, &hold[2], z, &n_z) != 0) {
+        holds_release(hold, 2);
+        return -1;
+    }
+    if (n_u < 2 || n_v < 2 || n_z / n_v != n_u || n_z % n_v != 0) {
+        PyErr_Format(PyExc_ValueError, "z must have len(x) * len(y) = %zd * %zd values, got %zd",
+                     n_u, n_v, n_z);
+        holds_release(hold, 3);
+        return -1;
+    }
+    *nu = (size_t)n_u;
+    *nv = (size_t)n_v;
+    return 0;
+}
+
+static int Lookup2D_setup(Lookup2DObject* self, PyObject* u_obj, PyObject* v_obj,
+                          PyObject* z_obj, int clamped) {
+    LookupHold hold[3];
+    const double *u, *v, *z;
+    size_t nu, nv;
+
+    if (Lookup2D_acquire(u_obj, v_obj, z_obj, hold, &u, &nu, &v, &nv, &z) != 0) {
+        return -1;
+    }
+
+    Lookup2DFB fresh;
+    if (lookup2d_init(&fresh, u, nu, v, nv, z, clamped) != 0) {
+        holds_release(hold, 3);
+        PyErr_SetString(PyExc_ValueError, Lookup_param_error);
+        return -1;
+    }
+
+    // 重复调用 __init__ 时原地重新初始化，保持 ID 和注册表名称
+    if (self->fb) {
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+    } else {
+        self->fb = lookup2d_create(u, nu, v, nv, z, clamped);
+        if (!self->fb) {
+            holds_release(hold, 3);
+            PyErr_SetString(PyExc_MemoryError, "二维折线表创建失败：实例池或注册表已满");
+            return -1;
+        }
+        fb_py_register_owner((PyObject*)self, self->fb);
+    }
+
+    holds_release(self->hold, 3);
+    memcpy(self->hold, hold, sizeof(hold));
+    return 0;
+}
+
+static const char* const Lookup2D_kwlist[] = {"x", "y", "z", "clamp", NULL};
+
+// 构造函数：__init__(self, x, y, z, clamp=True)
+static int Lookup2D_init(Lookup2DObject* self, PyObject* args, PyObject* kwds) {
+    PyObject *u, *v, *z;
+    int clamped = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO|p", (char**)Lookup2D_kwlist,
+                                     &u, &v, &z, &clamped)) {
+        return -1;
+    }
+
+    return Lookup2D_setup(self, u, v, z, clamped);
+}
+
+// vectorcall 构造：Lookup2D(...) 直接创建实例
+static PyObject* Lookup2D_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                     PyObject* kwnames) {
+    PyObject* slots[4];
+    int clamped = 1;
+
+    if (fastcall_unpack("Lookup2D", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        Lookup2D_kwlist, 3, slots) != 0 ||
+        (slots[3] && (clamped = PyObject_IsTrue(slots[3])) < 0)) {
+        return NULL;
+    }
+
+    Lookup2DObject* self =
+        (Lookup2DObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (Lookup2D_setup(self, slots[0], slots[1], slots[2], clamped) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(a, b) -> float
+static PyObject* Lookup2D_compute(Lookup2DObject* self, PyObject* const* args,
+                                  Py_ssize_t nargs) {
+    double a, b;
+
+    if (fastcall_check_nargs("compute", nargs, 2, 2) != 0 ||
+        fastcall_as_double(args[0], &a) != 0 || fastcall_as_double(args[1], &b) != 0) {
+        return NULL;
+    }
+
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+
+    return PyFloat_FromDouble(lookup2d_compute(self->fb, a, b));
+}
+
+// set_table(x, y, z)：换表，失败时原表不变
+static PyObject* Lookup2D_set_table(Lookup2DObject* self, PyObject* const* args,
+                                    Py_ssize_t nargs) {
+    LookupHold hold[3];
+    const double *u, *v, *z;
+    size_t nu, nv;
+
+    if (fastcall_check_nargs("set_table", nargs, 3, 3) != 0) {
+        return NULL;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    if (Lookup2D_acquire(args[0], args[1], args[2], hold, &u, &nu, &v, &nv, &z) != 0) {
+        return NULL;
+    }
+
+    if (lookup2d_set_table(self->fb, u, nu, v, nv, z) != 0) {
+        holds_release(hold, 3);
+        PyErr_SetString(PyExc_ValueError, Lookup_param_error);
+        return NULL;
+    }
+
+    holds_release(self->hold, 3);
+    memcpy(self->hold, hold, sizeof(hold));
+    Py_RETURN_NONE;
+}
+
+static PyObject* Lookup2D_get_clamp(Lookup2DObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    return PyBool_FromLong(self->fb->clamp);
+}
+
+static int Lookup2D_set_clamp(Lookup2DObject* self, PyObject* value, void* Py_UNUSED(closure)) {
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 clamp");
+        return -1;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return -1;
+    }
+    int clamped = PyObject_IsTrue(value);
+    if (clamped < 0) {
+        return -1;
+    }
+    self->fb->clamp = clamped;
+    return 0;
+}
+
+static PyObject* Lookup2D_get_output(Lookup2DObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    return PyFloat_FromDouble(self->fb->output);
+}
+
+static PyObject* Lookup2D_get_shape(Lookup2DObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    return Py_BuildValue("(kk)", (unsigned long)self->fb->u.n, (unsigned long)self->fb->v.n);
+}
+
+static PyObject* Lookup2D_get_uniform(Lookup2DObject* self, void* Py_UNUSED(closure)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Lookup_uninit);
+        return NULL;
+    }
+    return Py_BuildValue("(OO)", self->fb->u.uniform ? Py_True : Py_False,
+                         self->fb->v.uniform ? Py_True : Py_False);
+}
+
+static PyObject* Lookup2D_get_shared(Lookup2DObject* self, void* Py_UNUSED(closure)) {
+    return PyBool_FromLong(self->hold[0].view.obj && self->hold[1].view.obj &&
+                           self->hold[2].view.obj);
+}
+
+// 属性表
+static PyGetSetDef Lookup2D_getset[] = {
+    {"clamp", (getter)Lookup2D_get_clamp, (setter)Lookup2D_set_clamp,
+     "True：两个输入各自限制在断点范围内；False：按边缘网格线性外推", NULL},
+    {"output", (getter)Lookup2D_get_output, NULL, "最近一次输出（只读）", NULL},
+    {"shape", (getter)Lookup2D_get_shape, NULL, "(len(x), len(y))（只读）", NULL},
+    {"uniform", (getter)Lookup2D_get_uniform, NULL, "两个轴的断点是否等间距（只读）", NULL},
+    {"shared", (getter)Lookup2D_get_shared, NULL,
+     "x、y、z 是否都直接引用调用者的缓冲区（只读）", NULL},
+    FB_REGISTRY_GETSET(Lookup2DObject, fb),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+// 方法表
+static PyMethodDef Lookup2D_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))Lookup2D_compute, METH_FASTCALL,
+     "查表并双线性插值\n\n参数:\n  a: 第一个输入（对应 x）\n  b: 第二个输入（对应 y）\n\n"
+     "返回:\n  float: 插值结果"},
+    {"set_table", (PyCFunction)(void(*)(void))Lookup2D_set_table, METH_FASTCALL,
+     "换用新表（失败时原表不变）\n\n"
+     "参数:\n  x: 行断点\n  y: 列断点\n  z: len(x) × len(y) 个输出值，行主序或按行嵌套"},
+    {NULL, NULL, 0, NULL}
+};
+
+// 类型定义
+PyTypeObject Lookup2DType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.Lookup2D",
+    .tp_doc = "二维折线表功能块\n\n"
+              "Lookup2D(x, y, z, clamp=True)：x、y 为两个输入的严格递增断点，\n"
+              "z 为 len(x) × len(y) 个输出值（行主序的一维缓冲区，或 [[...], ...] 按行嵌套），\n"
+              "网格内双线性插值。double 缓冲区直接引用不复制。",
+    .tp_basicsize = sizeof(Lookup2DObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Lookup2D_init,
+    .tp_dealloc = (destructor)Lookup2D_dealloc,
+    .tp_methods = Lookup2D_methods,
+    .tp_getset = Lookup2D_getset,
+    .tp_vectorcall = Lookup2D_vectorcall,
+};
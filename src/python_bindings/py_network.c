@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_network.c
+ * @brief FBD 网络 Python 绑定实现
+ *
+ * Python 侧只负责一次性声明功能块和连线，构建后每周期由
+ * fb_network_execute() 在 C 中顺序执行；信号按名称读写（net["pid.CV"]）。
+ * 运行时通过 _capsule 取得底层 FBNetwork 指针，在 step() 前后直接执行网络。
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_network.h"
+#include "py_fastcall.h"
+
+// Network Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    FBNetwork* net;  // C 网络实例
+} NetworkObject;
+
+// 以最近一次 C 侧错误信息抛出 ValueError
+static PyObject* Network_error(NetworkObject* self) {
+    PyErr_SetString(PyExc_ValueError, fb_network_last_error(self->net));
+    return NULL;
+}
+
+// 析构函数
+static void Network_dealloc(NetworkObject* self) {
+    if (self->net) {
+        fb_network_destroy(self->net);
+    }
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 构造：Network()
+static PyObject* Network_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    if (PyTuple_GET_SIZE(args) != 0 || (kwds && PyDict_GET_SIZE(kwds) != 0)) {
+        PyErr_SetString(PyExc_TypeError, "Network() takes no arguments");
+        return NULL;
+    }
+
+    NetworkObject* self = (NetworkObject*)type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    self->net = fb_network_create();
+    if (!self->net) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+
+    return (PyObject*)self;
+}
+
+// 取出 str 参数的 UTF-8 内容
+static const char* Network_str(PyObject* obj, const char* what) {
+    if (!PyUnicode_Check(obj)) {
+        PyErr_Format(PyExc_TypeError, "%s must be str", what);
+        return NULL;
+    }
+    return PyUnicode_AsUTF8(obj);
+}
+
+// add_input(name, value=0.0)
+static PyObject* Network_add_input(NetworkObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                   PyObject* kwnames) {
+    static const char* const kwlist[] = {"name", "value", NULL};
+    PyObject* slots[2];
+    double value = 0.0;
+
+    if (fastcall_unpack("add_input", args, nargs, kwnames, kwlist, 1, slots) != 0 ||
+        (slots[1] && fastcall_as_double(slots[1], &value) != 0)) {
+        return NULL;
+    }
+
+    const char* name = Network_str(slots[0], "name");
+    if (!name) {
+        return NULL;
+    }
+
+    if (fb_network_add_input(self->net, name, value) != 0) {
+        return Network_error(self);
+    }
+    Py_RETURN_NONE;
+}
+
+// add_block(name, kind, **params)，参数名见各功能块构造函数
+static PyObject* Network_add_block(NetworkObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                   PyObject* kwnames) {
+    if (nargs < 2) {
+        PyErr_SetString(PyExc_TypeError, "add_block() requires name and kind");
+        return NULL;
+    }
+
+    const char* name = Network_str(args[0], "name");
+    const char* kind = name ? Network_str(args[1], "kind") : NULL;
+    if (!kind) {
+        return NULL;
+    }
+
+    FunctionBlockType type;
+    if (fb_network_parse_type(kind, &type) != 0) {
+        PyErr_Format(PyExc_ValueError, "unknown block kind '%s' "
+                     "(expected PID, FirstOrder, Ramp, Limit or Lookup1D)", kind);
+        return NULL;
+    }
+
+    // kwlist = {"name", "kind", <该类型的参数名>..., NULL}
+    const char* const* names;
+    const double* defaults;
+    size_t count = fb_network_param_info(type, &names, &defaults);
+    const char* kwlist[FB_NETWORK_MAX_PARAMS + 3] = {"name", "kind"};
+    double params[FB_NETWORK_MAX_PARAMS];
+    for (size_t i = 0; i < count; i++) {
+        kwlist[i + 2] = names[i];
+        params[i] = defaults[i];
+    }
+    kwlist[count + 2] = NULL;
+
+    PyObject* slots[FB_NETWORK_MAX_PARAMS + 2];
+    if (fastcall_unpack("add_block", args, nargs, kwnames, kwlist, 2, slots) != 0) {
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (slots[i + 2] && fastcall_as_double(slots[i + 2], &params[i]) != 0) {
+            return NULL;
+        }
+    }
+
+    if (fb_network_add_block(self->net, name, type, params) != 0) {
+        return Network_error(self);
+    }
+    Py_RETURN_NONE;
+}
+
+// connect(src, dst)
+static PyObject* Network_connect(NetworkObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    if (fastcall_check_nargs("connect", nargs, 2, 2) != 0) {
+        return NULL;
+    }
+
+    const char* src = Network_str(args[0], "src");
+    const char* dst = src ? Network_str(args[1], "dst") : NULL;
+    if (!dst) {
+        return NULL;
+    }
+
+    if (fb_network_connect(self->net, src, dst) != 0) {
+        return Network_error(self);
+    }
+    Py_RETURN_NONE;
+}
+
+// add_output(name, src)
+static PyObject* Network_add_output(NetworkObject* self, PyObject* const* args,
+                                    Py_ssize_t nargs) {
+    if (fastcall_check_nargs("add_output", nargs, 2, 2) != 0) {
+        return NULL;
+    }
+
+    const char* name = Network_str(args[0], "name");
+    const char* src = name ? Network_str(args[1], "src") : NULL;
+    if (!src) {
+        return NULL;
+    }
+
+    if (fb_network_add_output(self->net, name, src) != 0) {
+        return Network_error(self);
+    }
+    Py_RETURN_NONE;
+}
+
+// build()
+static PyObject* Network_build(NetworkObject* self, PyObject* Py_UNUSED(ignored)) {
+    if (fb_network_build(self->net) != 0) {
+        return Network_error(self);
+    }
+    Py_RETURN_NONE;
+}
+
+// execute(dt=0.0)
+static PyObject* Network_execute(NetworkObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    double dt = 0.0;
+
+    if (fastcall_check_nargs("execute", nargs, 0, 1) != 0 ||
+        (nargs == 1 && fastcall_as_double(args[0], &dt) != 0)) {
+        return NULL;
+    }
+
+    if (!self->net->built) {
+        PyErr_SetString(PyExc_RuntimeError, "网络尚未构建，请先调用 build()");
+        return NULL;
+    }
+
+    fb_network_execute(self->net, dt);
+    Py_RETURN_NONE;
+}
+
+// set_params(block, **params)
+static PyObject* Network_set_params(NetworkObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                    PyObject* kwnames) {
+    if (nargs != 1) {
+        PyErr_SetString(PyExc_TypeError, "set_params() takes exactly one positional argument");
+        return NULL;
+    }
+
+    const char* block = Network_str(args[0], "block");
+    if (!block) {
+        return NULL;
+    }
+
+    Py_ssize_t nkw = kwnames ? PyTuple_GET_SIZE(kwnames) : 0;
+    for (Py_ssize_t k = 0; k < nkw; k++) {
+        const char* param = PyUnicode_AsUTF8(PyTuple_GET_ITEM(kwnames, k));
+        double value;
+        if (!param || fastcall_as_double(args[nargs + k], &value) != 0) {
+            return NULL;
+        }
+        if (fb_network_set_param(self->net, block, param, value) != 0) {
+            return Network_error(self);
+        }
+    }
+
+    Py_RETURN_NONE;
+}
+
+// 把数值序列复制为 PyMem 数组（调用者 PyMem_Free）
+static double* Network_doubles(PyObject* obj, Py_ssize_t* n) {
+    PyObject* seq = PySequence_Fast(obj, "table must be a sequence of numbers");
+    if (!seq) {
+        return NULL;
+    }
+
+    *n = PySequence_Fast_GET_SIZE(seq);
+    double* values = PyMem_New(double, *n > 0 ? *n : 1);
+    if (!values) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < *n; i++) {
+        if (fastcall_as_double(PySequence_Fast_GET_ITEM(seq, i), &values[i]) != 0) {
+            PyMem_Free(values);
+            Py_DECREF(seq);
+            return NULL;
+        }
+    }
+    Py_DECREF(seq);
+    return values;
+}
+
+// set_table(block, x, y)：表复制到网络中，之后可以丢弃 x、y
+static PyObject* Network_set_table(NetworkObject* self, PyObject* const* args,
+                                   Py_ssize_t nargs) {
+    if (fastcall_check_nargs("set_table", nargs, 3, 3) != 0) {
+        return NULL;
+    }
+
+    const char* block = Network_str(args[0], "block");
+    if (!block) {
+        return NULL;
+    }
+
+    Py_ssize_t nx, ny;
+    double* x = Network_doubles(args[1], &nx);
+    double* y = x ? Network_doubles(args[2], &ny) : NULL;
+    if (!y) {
+        PyMem_Free(x);
+        return NULL;
+    }
+    if (nx != ny) {
+        PyMem_Free(x);
+        PyMem_Free(y);
+        PyErr_Format(PyExc_ValueError, "x and y must have the same length (%zd != %zd)",
+                     nx, ny);
+        return NULL;
+    }
+
+    int rc = fb_network_set_table(self->net, block, x, y, (size_t)nx);
+    PyMem_Free(x);
+    PyMem_Free(y);
+    if (rc != 0) {
+        return Network_error(self);
+    }
+    Py_RETURN_NONE;
+}
+
+// reset()
+static PyObject* Network_reset(NetworkObject* self, PyObject* Py_UNUSED(ignored)) {
+    fb_network_reset(self->net);
+    Py_RETURN_NONE;
+}
+
+// 按名称查找槽位
+static int64_t Network_slot(NetworkObject* self, PyObject* key) {
+    const char* name = Network_str(key, "signal name");
+    if (!name) {
+        return -1;
+    }
+
+    int64_t slot = fb_network_find_slot(self->net, name);
+    if (slot < 0) {
+        PyErr_SetObject(PyExc_KeyError, key);
+    }
+    return slot;
+}
+
+// net[name] -> float
+static PyObject* Network_subscript(NetworkObject* self, PyObject* key) {
+    int64_t slot = Network_slot(self, key);
+    if (slot < 0) {
+        return NULL;
+    }
+    return PyFloat_FromDouble(self->net->slots[slot]);
+}
+
+// net[name] = value
+static int Network_ass_subscript(NetworkObject* self, PyObject* key, PyObject* value) {
+    if (!value) {
+        PyErr_SetString(PyExc_TypeError, "不能删除网络信号");
+        return -1;
+    }
+
+    double v;
+    int64_t slot = Network_slot(self, key);
+    if (slot < 0 || fastcall_as_double(value, &v) != 0) {
+        return -1;
+    }
+
+    self->net->slots[slot] = v;
+    return 0;
+}
+
+// order -> tuple，构建后的执行顺序
+static PyObject* Network_get_order(NetworkObject* self, void* Py_UNUSED(closure)) {
+    const FBNetwork* net = self->net;
+    PyObject* order = PyTuple_New(net->built ? (Py_ssize_t)net->op_count : 0);
+    if (!order || !net->built) {
+        return order;
+    }
+
+    for (size_t i = 0; i < net->op_count; i++) {
+        // op->fb 指向 FBNetworkBlock.fb，由此反推所属功能块
+        const FBNetworkBlock* block = (const FBNetworkBlock*)
+            ((const char*)net->ops[i].fb - offsetof(FBNetworkBlock, fb));
+        PyObject* name = PyUnicode_FromString(block->name);
+        if (!name) {
+            Py_DECREF(order);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(order, (Py_ssize_t)i, name);
+    }
+
+    return order;
+}
+
+// built -> bool
+static PyObject* Network_get_built(NetworkObject* self, void* Py_UNUSED(closure)) {
+    return PyBool_FromLong(self->net->built);
+}
+
+// 以元组返回命名信号列表
+static PyObject* Network_names(const FBNetworkSignal* signals, size_t count) {
+    PyObject* names = PyTuple_New((Py_ssize_t)count);
+    if (!names) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        PyObject* name = PyUnicode_FromString(signals[i].name);
+        if (!name) {
+            Py_DECREF(names);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(names, (Py_ssize_t)i, name);
+    }
+
+    return names;
+}
+
+// inputs -> tuple
+static PyObject* Network_get_inputs(NetworkObject* self, void* Py_UNUSED(closure)) {
+    return Network_names(self->net->inputs, self->net->input_count);
+}
+
+// outputs -> tuple
+static PyObject* Network_get_outputs(NetworkObject* self, void* Py_UNUSED(closure)) {
+    return Network_names(self->net->outputs, self->net->output_count);
+}
+
+// _capsule -> PyCapsule(FBNetwork*)，供运行时在 C 中直接执行网络
+static PyObject* Network_get_capsule(NetworkObject* self, void* Py_UNUSED(closure)) {
+    return PyCapsule_New(self->net, FB_NETWORK_CAPSULE_NAME, NULL);
+}
+
+// 方法表
+static PyMethodDef Network_methods[] = {
+    {"add_input", (PyCFunction)(void(*)(void))Network_add_input, METH_FASTCALL | METH_KEYWORDS,
+     "添加网络输入\n\n参数:\n  name: 输入名\n  value: 初始值"},
+    {"add_block", (PyCFunction)(void(*)(void))Network_add_block, METH_FASTCALL | METH_KEYWORDS,
+     "添加功能块实例\n\n参数:\n  name: 实例名\n  kind: PID/FirstOrder/Ramp/Limit/Lookup1D\n"
+     "  **params: 功能块参数（同各类型构造函数），未给出的取默认值"},
+    {"connect", (PyCFunction)(void(*)(void))Network_connect, METH_FASTCALL,
+     "连线\n\n参数:\n  src: 网络输入名或 \"块名.输出端口\"\n  dst: \"块名.输入端口\""},
+    {"add_output", (PyCFunction)(void(*)(void))Network_add_output, METH_FASTCALL,
+     "添加网络输出\n\n参数:\n  name: 输出名\n  src: 网络输入名或 \"块名.输出端口\""},
+    {"build", (PyCFunction)Network_build, METH_NOARGS,
+     "拓扑排序生成执行列表\n\n存在代数环时抛出 ValueError，信息中列出环上的功能块"},
+    {"execute", (PyCFunction)(void(*)(void))Network_execute, METH_FASTCALL,
+     "执行一个周期\n\n参数:\n  dt: 时间步长（秒），0 表示自动计算"},
+    {"set_params", (PyCFunction)(void(*)(void))Network_set_params, METH_FASTCALL | METH_KEYWORDS,
+     "在线修改功能块参数\n\n参数:\n  block: 实例名\n  **params: 参数名=值"},
+    {"set_table", (PyCFunction)(void(*)(void))Network_set_table, METH_FASTCALL,
+     "设置 Lookup1D 实例的折线表（复制）\n\n参数:\n  block: 实例名\n"
+     "  x: 严格递增的断点\n  y: 各断点的输出值"},
+    {"reset", (PyCFunction)Network_reset, METH_NOARGS,
+     "重置所有功能块的内部状态"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef Network_getset[] = {
+    {"order", (getter)Network_get_order, NULL, "执行顺序（功能块名元组，构建前为空）", NULL},
+    {"built", (getter)Network_get_built, NULL, "是否已构建", NULL},
+    {"inputs", (getter)Network_get_inputs, NULL, "网络输入名元组", NULL},
+    {"outputs", (getter)Network_get_outputs, NULL, "网络输出名元组", NULL},
+    {"_capsule", (getter)Network_get_capsule, NULL, "底层 FBNetwork 指针（运行时内部使用）",
+     NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMappingMethods Network_as_mapping = {
+    .mp_subscript = (binaryfunc)Network_subscript,
+    .mp_ass_subscript = (objobjargproc)Network_ass_subscript,
+};
+
+// 类型定义
+PyTypeObject NetworkType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.Network",
+    .tp_doc = "功能块图（FBD）网络\n\n"
+              "声明功能块和连线后调用 build()，之后每周期 execute() 在 C 中\n"
+              "按拓扑序执行全部功能块；信号通过 net[\"名称\"] 读写。",
+    .tp_basicsize = sizeof(NetworkObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = Network_new,
+    .tp_dealloc = (destructor)Network_dealloc,
+    .tp_methods = Network_methods,
+    .tp_getset = Network_getset,
+    .tp_as_mapping = &Network_as_mapping,
+};
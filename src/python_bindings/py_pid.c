@@ -30,12 +30,11 @@
 
 #include <Python.h>
 #include "../function_blocks/fb_pid.h"
-
-// PID Python 对象结构
-typedef struct {
-    PyObject_HEAD
-    PIDFunctionBlock* pid;  // C 功能块实例
-} PIDObject;
+#include "py_fastcall.h"
+#include "py_pid.h"
+#include "py_registry.h"
+#include "py_view.h"
+#include <stddef.h>
 
 // 析构函数
 static void PID_dealloc(PIDObject* self) {
@@ -45,32 +44,98 @@ static void PID_dealloc(PIDObject* self) {
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
-// 构造函数：__init__(self, Kp=1.0, Ki=0.0, Kd=0.0, output_min=-1e6, output_max=1e6)
-static int PID_init(PIDObject* self, PyObject* args, PyObject* kwds) {
-    double Kp = 1.0, Ki = 0.0, Kd = 0.0;
-    double output_min = -1e6, output_max = 1e6;
+static const char* const PID_kwlist[] = {"Kp", "Ki", "Kd", "output_min", "output_max",
+                                         "b", "c", "Tf", "Tt", "velocity", NULL};
+
+#define PID_ARG_DEFAULTS {1.0, 0.0, 0.0, -1e6, 1e6, 1.0, 1.0, 0.0, 0.0, 0.0}
 
-    static char* kwlist[] = {"Kp", "Ki", "Kd", "output_min", "output_max", NULL};
+static const char PID_options_error[] = "b 和 c 必须在 [0, 1] 内，Tf 和 Tt 不能为负";
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|ddddd", kwlist,
-                                     &Kp, &Ki, &Kd, &output_min, &output_max)) {
+// 按参数 {Kp, Ki, Kd, output_min, output_max, b, c, Tf, Tt, velocity} 创建 C 功能块
+static int PID_setup(PIDObject* self, const double* v) {
+    if (v[3] >= v[4]) {
+        PyErr_SetString(PyExc_ValueError, "PID 创建失败：output_min 必须小于 output_max");
         return -1;
     }
+    PIDOptions options = {v[5], v[6], v[7], v[8], v[9] != 0.0};
 
-    self->pid = pid_create(Kp, Ki, Kd, output_min, output_max);
+    // 重复调用 __init__ 时原地更新，保持已导出视图的地址有效且不占用新槽位；
+    // 选项无效时恢复原实例
+    if (self->pid) {
+        PIDFunctionBlock saved = *self->pid;
+        PIDFunctionBlock fresh;
+        pid_init(&fresh, v[0], v[1], v[2], v[3], v[4]);
+        fb_reinit(self->pid, &fresh, sizeof(fresh));
+        if (pid_set_options(self->pid, &options) != 0) {
+            *self->pid = saved;
+            PyErr_SetString(PyExc_ValueError, PID_options_error);
+            return -1;
+        }
+        return 0;
+    }
+
+    self->pid = pid_create(v[0], v[1], v[2], v[3], v[4]);
     if (!self->pid) {
-        PyErr_SetString(PyExc_ValueError, "PID 创建失败：output_min 必须小于 output_max");
+        PyErr_SetString(PyExc_MemoryError, "PID 创建失败：实例池或注册表已满");
+        return -1;
+    }
+    fb_py_register_owner((PyObject*)self, self->pid);
+
+    if (pid_set_options(self->pid, &options) != 0) {
+        PyErr_SetString(PyExc_ValueError, PID_options_error);
         return -1;
     }
 
     return 0;
 }
 
-// compute(SP, PV) -> float
-static PyObject* PID_compute(PIDObject* self, PyObject* args) {
-    double SP, PV;
+// 构造函数：__init__(self, Kp=1.0, Ki=0.0, Kd=0.0, output_min=-1e6, output_max=1e6,
+//                    b=1.0, c=1.0, Tf=0.0, Tt=0.0, velocity=False)
+static int PID_init(PIDObject* self, PyObject* args, PyObject* kwds) {
+    double v[10] = PID_ARG_DEFAULTS;
+    int velocity = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|ddddddddp", (char**)PID_kwlist,
+                                     &v[0], &v[1], &v[2], &v[3], &v[4],
+                                     &v[5], &v[6], &v[7], &v[8], &velocity)) {
+        return -1;
+    }
+    v[9] = velocity;
+
+    return PID_setup(self, v);
+}
 
-    if (!PyArg_ParseTuple(args, "dd", &SP, &PV)) {
+// vectorcall 构造：PID(...) 直接创建实例，不经过 tp_new/tp_init 的参数元组
+static PyObject* PID_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                PyObject* kwnames) {
+    double v[10] = PID_ARG_DEFAULTS;
+
+    if (fastcall_parse_doubles("PID", args, PyVectorcall_NARGS(nargsf), kwnames,
+                               PID_kwlist, 0, v) != 0) {
+        return NULL;
+    }
+
+    PIDObject* self = (PIDObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (PID_setup(self, v) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// compute(SP, PV[, dt]) -> float，dt 省略或为 0 时自动计算
+static PyObject* PID_compute(PIDObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    double SP, PV, dt = 0.0;
+
+    if (fastcall_check_nargs("compute", nargs, 2, 3) != 0 ||
+        fastcall_as_double(args[0], &SP) != 0 ||
+        fastcall_as_double(args[1], &PV) != 0 ||
+        (nargs == 3 && fastcall_as_double(args[2], &dt) != 0)) {
         return NULL;
     }
 
@@ -79,55 +144,254 @@ static PyObject* PID_compute(PIDObject* self, PyObject* args) {
         return NULL;
     }
 
-    double output = pid_compute(self->pid, SP, PV, 0.0);
+    double output = pid_compute(self->pid, SP, PV, dt);
     return PyFloat_FromDouble(output);
 }
 
-// set_params(Kp=None, Ki=None, Kd=None)
-static PyObject* PID_set_params(PIDObject* self, PyObject* args, PyObject* kwds) {
-    PyObject* Kp_obj = NULL;
-    PyObject* Ki_obj = NULL;
-    PyObject* Kd_obj = NULL;
+// set_params(Kp=None, Ki=None, Kd=None, bumpless=False)
+static PyObject* PID_set_params(PIDObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                PyObject* kwnames) {
+    static const char* const kwlist[] = {"Kp", "Ki", "Kd", "bumpless", NULL};
+    PyObject* slots[4];
+
+    if (fastcall_unpack("set_params", args, nargs, kwnames, kwlist, 0, slots) != 0) {
+        return NULL;
+    }
 
-    static char* kwlist[] = {"Kp", "Ki", "Kd", NULL};
+    double values[3];
+    double* ptrs[3] = {NULL, NULL, NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOO", kwlist,
-                                     &Kp_obj, &Ki_obj, &Kd_obj)) {
+    for (int i = 0; i < 3; i++) {
+        if (slots[i] && slots[i] != Py_None) {
+            if (fastcall_as_double(slots[i], &values[i]) != 0) {
+                return NULL;
+            }
+            ptrs[i] = &values[i];
+        }
+    }
+
+    int bumpless = slots[3] ? PyObject_IsTrue(slots[3]) : 0;
+    if (bumpless < 0) {
+        return NULL;
+    }
+
+    if ((bumpless ? pid_set_params_bumpless : pid_set_params)(self->pid, ptrs[0], ptrs[1],
+                                                              ptrs[2]) != 0) {
+        PyErr_SetString(PyExc_RuntimeError, "参数设置失败");
         return NULL;
     }
 
-    double Kp, Ki, Kd;
-    double* Kp_ptr = NULL;
-    double* Ki_ptr = NULL;
-    double* Kd_ptr = NULL;
+    Py_RETURN_NONE;
+}
+
+// 视图字段：PIDParams 与 {PIDState, last_error} 都是连续存放的 double
+static const char* const PID_param_fields[] = {"Kp", "Ki", "Kd", "output_min", "output_max"};
+static const char* const PID_state_fields[] = {"integral", "prev_error", "last_error"};
+
+_Static_assert(sizeof(PIDParams) == 5 * sizeof(double), "PIDParams 必须为 5 个连续 double");
+_Static_assert(offsetof(PIDFunctionBlock, last_error) ==
+               offsetof(PIDFunctionBlock, state) + 2 * sizeof(double),
+               "last_error 必须紧跟 PIDState");
+
+static double* PID_params_data(PyObject* owner) {
+    PIDFunctionBlock* pid = ((PIDObject*)owner)->pid;
+    return pid ? &pid->params.Kp : NULL;
+}
+
+static double* PID_state_data(PyObject* owner) {
+    PIDFunctionBlock* pid = ((PIDObject*)owner)->pid;
+    return pid ? &pid->state.integral : NULL;
+}
 
-    if (Kp_obj && Kp_obj != Py_None) {
-        Kp = PyFloat_AsDouble(Kp_obj);
-        if (PyErr_Occurred()) return NULL;
-        Kp_ptr = &Kp;
+// 属性读取：closure 为字段在 PIDFunctionBlock 中的偏移
+static PyObject* PID_get_field(PIDObject* self, void* closure) {
+    if (!self->pid) {
+        PyErr_SetString(PyExc_RuntimeError, "PID 实例未初始化");
+        return NULL;
     }
 
-    if (Ki_obj && Ki_obj != Py_None) {
-        Ki = PyFloat_AsDouble(Ki_obj);
-        if (PyErr_Occurred()) return NULL;
-        Ki_ptr = &Ki;
+    return PyFloat_FromDouble(*(double*)((char*)self->pid + (size_t)closure));
+}
+
+// 设置 Kp/Ki/Kd（经 pid_set_params 校验并限幅）
+static int PID_set_gain(PIDObject* self, PyObject* value, void* closure) {
+    double gain;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 PID 参数");
+        return -1;
+    }
+    if (!self->pid) {
+        PyErr_SetString(PyExc_RuntimeError, "PID 实例未初始化");
+        return -1;
+    }
+    if (fastcall_as_double(value, &gain) != 0) {
+        return -1;
     }
 
-    if (Kd_obj && Kd_obj != Py_None) {
-        Kd = PyFloat_AsDouble(Kd_obj);
-        if (PyErr_Occurred()) return NULL;
-        Kd_ptr = &Kd;
+    size_t offset = (size_t)closure;
+    return pid_set_params(self->pid,
+                          offset == offsetof(PIDFunctionBlock, params.Kp) ? &gain : NULL,
+                          offset == offsetof(PIDFunctionBlock, params.Ki) ? &gain : NULL,
+                          offset == offsetof(PIDFunctionBlock, params.Kd) ? &gain : NULL);
+}
+
+// 设置 output_min/output_max（要求 output_min < output_max）
+static int PID_set_output_limit(PIDObject* self, PyObject* value, void* closure) {
+    double limit;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 PID 参数");
+        return -1;
+    }
+    if (!self->pid) {
+        PyErr_SetString(PyExc_RuntimeError, "PID 实例未初始化");
+        return -1;
+    }
+    if (fastcall_as_double(value, &limit) != 0) {
+        return -1;
     }
 
-    if (pid_set_params(self->pid, Kp_ptr, Ki_ptr, Kd_ptr) != 0) {
-        PyErr_SetString(PyExc_RuntimeError, "参数设置失败");
+    PIDParams* params = &self->pid->params;
+    int is_min = (size_t)closure == offsetof(PIDFunctionBlock, params.output_min);
+    double new_min = is_min ? limit : params->output_min;
+    double new_max = is_min ? params->output_max : limit;
+    if (!(new_min < new_max)) {
+        PyErr_SetString(PyExc_ValueError, "output_min 必须小于 output_max");
+        return -1;
+    }
+
+    params->output_min = new_min;
+    params->output_max = new_max;
+    return 0;
+}
+
+// 设置内部状态（如无扰切换时预置积分项）
+static int PID_set_state_field(PIDObject* self, PyObject* value, void* closure) {
+    double state;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 PID 状态");
+        return -1;
+    }
+    if (!self->pid) {
+        PyErr_SetString(PyExc_RuntimeError, "PID 实例未初始化");
+        return -1;
+    }
+    if (fastcall_as_double(value, &state) != 0) {
+        return -1;
+    }
+
+    *(double*)((char*)self->pid + (size_t)closure) = state;
+    return 0;
+}
+
+// 设置变体选项 b/c/Tf/Tt（经 pid_set_options 校验）
+static int PID_set_option(PIDObject* self, PyObject* value, void* closure) {
+    double option;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 PID 选项");
+        return -1;
+    }
+    if (!self->pid) {
+        PyErr_SetString(PyExc_RuntimeError, "PID 实例未初始化");
+        return -1;
+    }
+    if (fastcall_as_double(value, &option) != 0) {
+        return -1;
+    }
+
+    PIDOptions options = self->pid->options;
+    size_t offset = (size_t)closure - offsetof(PIDFunctionBlock, options);
+    *(double*)((char*)&options + offset) = option;
+    if (pid_set_options(self->pid, &options) != 0) {
+        PyErr_SetString(PyExc_ValueError, PID_options_error);
+        return -1;
+    }
+    return 0;
+}
+
+// 开关量读取：closure 为 int 字段的偏移
+static PyObject* PID_get_flag(PIDObject* self, void* closure) {
+    if (!self->pid) {
+        PyErr_SetString(PyExc_RuntimeError, "PID 实例未初始化");
         return NULL;
     }
 
-    Py_RETURN_NONE;
+    return PyBool_FromLong(*(int*)((char*)self->pid + (size_t)closure));
+}
+
+// 设置 velocity（选项）或 manual（手动/自动无扰切换）
+static int PID_set_flag(PIDObject* self, PyObject* value, void* closure) {
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 PID 选项");
+        return -1;
+    }
+    if (!self->pid) {
+        PyErr_SetString(PyExc_RuntimeError, "PID 实例未初始化");
+        return -1;
+    }
+    int flag = PyObject_IsTrue(value);
+    if (flag < 0) {
+        return -1;
+    }
+
+    if ((size_t)closure == offsetof(PIDFunctionBlock, manual)) {
+        pid_set_manual(self->pid, flag);
+        return 0;
+    }
+    PIDOptions options = self->pid->options;
+    options.velocity = flag;
+    return pid_set_options(self->pid, &options);
+}
+
+// params -> FBView
+static PyObject* PID_get_params_view(PIDObject* self, void* Py_UNUSED(closure)) {
+    return fb_view_new((PyObject*)self, PID_params_data, PID_param_fields, 5);
+}
+
+// state -> FBView
+static PyObject* PID_get_state_view(PIDObject* self, void* Py_UNUSED(closure)) {
+    return fb_view_new((PyObject*)self, PID_state_data, PID_state_fields, 3);
 }
 
-// get_params() -> dict
+#define PID_FIELD(name, member, set_func, doc) \
+    {name, (getter)PID_get_field, (setter)set_func, doc, \
+     (void*)offsetof(PIDFunctionBlock, member)}
+
+// 属性表
+static PyGetSetDef PID_getset[] = {
+    PID_FIELD("Kp", params.Kp, PID_set_gain, "比例系数"),
+    PID_FIELD("Ki", params.Ki, PID_set_gain, "积分系数"),
+    PID_FIELD("Kd", params.Kd, PID_set_gain, "微分系数"),
+    PID_FIELD("output_min", params.output_min, PID_set_output_limit, "输出下限"),
+    PID_FIELD("output_max", params.output_max, PID_set_output_limit, "输出上限"),
+    PID_FIELD("integral", state.integral, PID_set_state_field, "积分累积值"),
+    PID_FIELD("prev_error", state.prev_error, PID_set_state_field, "上一周期误差"),
+    PID_FIELD("last_error", last_error, NULL, "当前误差（只读）"),
+    PID_FIELD("b", options.b, PID_set_option, "比例项设定值权重 [0, 1]"),
+    PID_FIELD("c", options.c, PID_set_option, "微分项设定值权重 [0, 1]，0 表示微分作用于 PV"),
+    PID_FIELD("Tf", options.Tf, PID_set_option, "微分滤波时间常数（秒），0 表示不滤波"),
+    PID_FIELD("Tt", options.Tt, PID_set_option,
+              "反算抗积分饱和的跟踪时间常数（秒），0 表示条件积分"),
+    {"velocity", (getter)PID_get_flag, (setter)PID_set_flag, "是否使用速度式（增量式）算法",
+     (void*)offsetof(PIDFunctionBlock, options.velocity)},
+    {"manual", (getter)PID_get_flag, (setter)PID_set_flag,
+     "手动模式；切换时输出无扰，手动期间输出 manual_output",
+     (void*)offsetof(PIDFunctionBlock, manual)},
+    PID_FIELD("manual_output", manual_output, PID_set_state_field, "手动输出值"),
+    PID_FIELD("output", ext.output, PID_set_state_field,
+              "上一周期输出（速度式的累积输出，可预置）"),
+    {"params", (getter)PID_get_params_view, NULL,
+     "参数的零拷贝只读视图 {Kp, Ki, Kd, output_min, output_max}", NULL},
+    {"state", (getter)PID_get_state_view, NULL,
+     "状态的零拷贝只读视图 {integral, prev_error, last_error}", NULL},
+    FB_REGISTRY_GETSET(PIDObject, pid),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+// get_params() -> dict（兼容接口，推荐使用属性或 params 视图）
 static PyObject* PID_get_params(PIDObject* self, PyObject* Py_UNUSED(ignored)) {
     const PIDParams* params = pid_get_params(self->pid);
     if (!params) {
@@ -135,17 +399,10 @@ static PyObject* PID_get_params(PIDObject* self, PyObject* Py_UNUSED(ignored)) {
         return NULL;
     }
 
-    PyObject* dict = PyDict_New();
-    PyDict_SetItemString(dict, "Kp", PyFloat_FromDouble(params->Kp));
-    PyDict_SetItemString(dict, "Ki", PyFloat_FromDouble(params->Ki));
-    PyDict_SetItemString(dict, "Kd", PyFloat_FromDouble(params->Kd));
-    PyDict_SetItemString(dict, "output_min", PyFloat_FromDouble(params->output_min));
-    PyDict_SetItemString(dict, "output_max", PyFloat_FromDouble(params->output_max));
-
-    return dict;
+    return fb_fields_to_dict(PID_param_fields, &params->Kp, 5);
 }
 
-// get_state() -> dict
+// get_state() -> dict（兼容接口，推荐使用属性或 state 视图）
 static PyObject* PID_get_state(PIDObject* self, PyObject* Py_UNUSED(ignored)) {
     const PIDState* state = pid_get_state(self->pid);
     if (!state) {
@@ -153,12 +410,7 @@ static PyObject* PID_get_state(PIDObject* self, PyObject* Py_UNUSED(ignored)) {
         return NULL;
     }
 
-    PyObject* dict = PyDict_New();
-    PyDict_SetItemString(dict, "integral", PyFloat_FromDouble(state->integral));
-    PyDict_SetItemString(dict, "prev_error", PyFloat_FromDouble(state->prev_error));
-    PyDict_SetItemString(dict, "last_error", PyFloat_FromDouble(self->pid->last_error));
-
-    return dict;
+    return fb_fields_to_dict(PID_state_fields, &state->integral, 3);
 }
 
 // reset()
@@ -169,10 +421,11 @@ static PyObject* PID_reset(PIDObject* self, PyObject* Py_UNUSED(ignored)) {
 
 // 方法表
 static PyMethodDef PID_methods[] = {
-    {"compute", (PyCFunction)PID_compute, METH_VARARGS,
-     "计算 PID 控制输出\n\n参数:\n  SP: 设定值\n  PV: 过程变量/反馈值\n\n返回:\n  float: 控制变量"},
-    {"set_params", (PyCFunction)PID_set_params, METH_VARARGS | METH_KEYWORDS,
-     "动态修改 PID 参数\n\n参数:\n  Kp, Ki, Kd: 可选，仅修改提供的参数"},
+    {"compute", (PyCFunction)(void(*)(void))PID_compute, METH_FASTCALL,
+     "计算 PID 控制输出\n\n参数:\n  SP: 设定值\n  PV: 过程变量/反馈值\n  dt: 可选，时间步长（秒），0 表示自动计算\n\n返回:\n  float: 控制变量"},
+    {"set_params", (PyCFunction)(void(*)(void))PID_set_params, METH_FASTCALL | METH_KEYWORDS,
+     "动态修改 PID 参数\n\n参数:\n  Kp, Ki, Kd: 可选，仅修改提供的参数\n"
+     "  bumpless: 为 True 时反推积分，输出从上一周期的值连续变化"},
     {"get_params", (PyCFunction)PID_get_params, METH_NOARGS,
      "获取当前 PID 参数\n\n返回:\n  dict: {Kp, Ki, Kd, output_min, output_max}"},
     {"get_state", (PyCFunction)PID_get_state, METH_NOARGS,
@@ -186,7 +439,10 @@ static PyMethodDef PID_methods[] = {
 PyTypeObject PIDType = {
     PyVarObject_HEAD_INIT(NULL, 0)
     .tp_name = "plcopen_c.PID",
-    .tp_doc = "PID 控制器功能块\n\n标准位置式 PID 算法，支持输出限幅和抗积分饱和。",
+    .tp_doc = "PID 控制器功能块\n\n"
+              "默认为标准位置式 PID 算法，支持输出限幅和抗积分饱和。\n"
+              "可选变体：设定值加权 b/c（c=0 即微分作用于 PV）、微分滤波 Tf、\n"
+              "反算抗积分饱和 Tt、速度式 velocity，以及手动/自动无扰切换 manual。",
     .tp_basicsize = sizeof(PIDObject),
     .tp_itemsize = 0,
     .tp_flags = Py_TPFLAGS_DEFAULT,
@@ -194,4 +450,6 @@ PyTypeObject PIDType = {
     .tp_init = (initproc)PID_init,
     .tp_dealloc = (destructor)PID_dealloc,
     .tp_methods = PID_methods,
+    .tp_getset = PID_getset,
+    .tp_vectorcall = PID_vectorcall,
 };
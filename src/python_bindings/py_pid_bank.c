@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_pid_bank.c
+ * @brief 批量 PID Python 绑定实现
+ *
+ * SP/PV 接受任意 C 连续的 double 缓冲区（array('d')、numpy float64、
+ * memoryview 等，零拷贝），也接受普通序列（复制到内部缓冲区）。
+ * 对象本身实现缓冲区协议，导出最近一次计算的输出数组（只读）。
+ * precision 为 "f32" 时使用 float32 SoA 实例（pid_bank_compute_f32()，SIMD 内核），
+ * float32 缓冲区（array('f')、numpy float32）零拷贝传入传出，float64 输入在边界处转换；
+ * "q16" 时参数和状态按 Q16.16 存放（fb_precision.h，标量内核）。
+ * 整个 PIDBank 登记为一个注册表条目（FB_TYPE_PID_BANK）。
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_pid_bank.h"
+#include "../function_blocks/fb_precision.h"
+#include "../function_blocks/fb_registry.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include "py_view.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// PIDBank Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    PIDBankFunctionBlock* bank;  // C 功能块实例（precision 为 f64）
+    PIDBankFunctionBlock_f32* bank_f32;  // float32 实例（precision 为 f32）
+    FBPrecisionArray* reduced;   // q16 实例（此时 bank / bank_f32 为 NULL）
+    double* output;              // bank_f32 / reduced 的 double 输出（count）
+    FunctionBlock clock;         // reduced 的 dt 自动计算时间戳，同时代表 reduced 登记到注册表
+    FunctionBlock* registered;   // 注册表中登记的实例（bank / bank_f32 的 base 或 &clock）
+    double* scratch;             // 序列或 float32 输入的 double 临时缓冲区（2 * count）
+    float* scratch_f32;          // bank_f32 的 float64 / 序列输入转换缓冲区（2 * count）
+    Py_ssize_t shape;            // 缓冲区形状（= count）
+    Py_ssize_t stride;           // 缓冲区步长（= sizeof(double)）
+} PIDBankObject;
+
+// 析构函数
+static void PIDBank_dealloc(PIDBankObject* self) {
+    pid_bank_destroy(self->bank);
+    pid_bank_destroy_f32(self->bank_f32);
+    fb_registry_unregister(self->clock.id);
+    fb_precision_array_destroy(self->reduced);
+    free(self->output);
+    free(self->scratch);
+    free(self->scratch_f32);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static const char* const PIDBank_kwlist[] = {"n", "Kp", "Ki", "Kd", "output_min", "output_max",
+                                             "precision", NULL};
+
+// 解析 precision 参数，缺省或 None 为 "f64"
+static int PIDBank_parse_precision(PyObject* obj, FBPrecision* precision) {
+    *precision = FB_PRECISION_F64;
+    if (!obj || obj == Py_None) {
+        return 0;
+    }
+
+    const char* name = PyUnicode_Check(obj) ? PyUnicode_AsUTF8(obj) : NULL;
+    if (!name || fb_precision_parse(name, precision) != 0) {
+        PyErr_SetString(PyExc_ValueError, "precision 必须为 \"f64\"、\"f32\" 或 \"q16\"");
+        return -1;
+    }
+    return 0;
+}
+
+// 创建实例，v 为 {Kp, Ki, Kd, output_min, output_max}
+static PyObject* PIDBank_create(PyTypeObject* type, Py_ssize_t n, const double* v,
+                                FBPrecision precision) {
+    if (n < 1 || (size_t)n > PID_BANK_MAX_LOOPS) {
+        PyErr_Format(PyExc_ValueError, "n must be in [1, %u]", PID_BANK_MAX_LOOPS);
+        return NULL;
+    }
+    if (!(v[3] < v[4])) {
+        PyErr_SetString(PyExc_ValueError, "批量 PID 创建失败：output_min 必须小于 output_max");
+        return NULL;
+    }
+
+    PIDBankObject* self = (PIDBankObject*)type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (precision != FB_PRECISION_F64) {
+        self->output = (double*)calloc((size_t)n, sizeof(double));
+        if (!self->output) {
+            Py_DECREF(self);
+            return PyErr_NoMemory();
+        }
+    }
+
+    if (precision == FB_PRECISION_F32) {
+        self->bank_f32 = pid_bank_create_f32((size_t)n, v[0], v[1], v[2], v[3], v[4]);
+        self->registered = self->bank_f32 ? &self->bank_f32->base : NULL;
+    } else if (precision == FB_PRECISION_Q16) {
+        self->reduced = fb_precision_array_create(FB_TYPE_PID, precision, (size_t)n, v);
+        self->clock.type = FB_TYPE_PID_BANK;
+        if (self->reduced && fb_registry_register(&self->clock, NULL, NULL) != 0) {
+            self->registered = &self->clock;
+        }
+    } else {
+        self->bank = pid_bank_create((size_t)n, v[0], v[1], v[2], v[3], v[4]);
+        self->registered = self->bank ? &self->bank->base : NULL;
+    }
+    if (!self->registered) {
+        PyErr_SetString(PyExc_MemoryError, "批量 PID 创建失败：内存不足或注册表已满");
+        Py_DECREF(self);
+        return NULL;
+    }
+    fb_py_register_owner((PyObject*)self, self->registered);
+
+    self->shape = n;
+    self->stride = sizeof(double);
+    return (PyObject*)self;
+}
+
+// 构造：PIDBank(n, Kp=1.0, Ki=0.0, Kd=0.0, output_min=-1e6, output_max=1e6, precision="f64")
+static PyObject* PIDBank_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    Py_ssize_t n;
+    double v[5] = {1.0, 0.0, 0.0, -1e6, 1e6};
+    PyObject* precision_obj = NULL;
+    FBPrecision precision;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|dddddO", (char**)PIDBank_kwlist,
+                                     &n, &v[0], &v[1], &v[2], &v[3], &v[4], &precision_obj) ||
+        PIDBank_parse_precision(precision_obj, &precision) != 0) {
+        return NULL;
+    }
+
+    return PIDBank_create(type, n, v, precision);
+}
+
+// vectorcall 构造
+static PyObject* PIDBank_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                    PyObject* kwnames) {
+    PyObject* slots[7];
+    FBPrecision precision;
+
+    if (fastcall_unpack("PIDBank", args, PyVectorcall_NARGS(nargsf), kwnames,
+                        PIDBank_kwlist, 1, slots) != 0 ||
+        PIDBank_parse_precision(slots[6], &precision) != 0) {
+        return NULL;
+    }
+
+    Py_ssize_t n = PyNumber_AsSsize_t(slots[0], PyExc_OverflowError);
+    if (n == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    double v[5] = {1.0, 0.0, 0.0, -1e6, 1e6};
+    for (int i = 0; i < 5; i++) {
+        if (slots[i + 1] && fastcall_as_double(slots[i + 1], &v[i]) != 0) {
+            return NULL;
+        }
+    }
+
+    return PIDBank_create((PyTypeObject*)type, n, v, precision);
+}
+
+// float64 / float32 边界转换（SSE2 每次 4 个，舍入与标量转换相同）
+static void to_f32(float* dst, const double* src, size_t n) {
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 4 <= n; i += 4) {
+        __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+        __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+        _mm_storeu_ps(dst + i, _mm_movelh_ps(lo, hi));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = (float)src[i];
+    }
+}
+
+static void to_f64(double* dst, const float* src, size_t n) {
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(src + i);
+        _mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+        _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = (double)src[i];
+    }
+}
+
+// compute(SP, PV, dt=0.0, out=None) -> out 或输出缓冲区的 memoryview
+static PyObject* PIDBank_compute(PIDBankObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                 PyObject* kwnames) {
+    static const char* const kwlist[] = {"SP", "PV", "dt", "out", NULL};
+    PyObject* slots[4];
+
+    if (fastcall_unpack("compute", args, nargs, kwnames, kwlist, 2, slots) != 0) {
+        return NULL;
+    }
+
+    double dt = 0.0;
+    if (slots[2] && fastcall_as_double(slots[2], &dt) != 0) {
+        return NULL;
+    }
+
+    size_t count = (size_t)self->shape;
+    if (!self->scratch) {
+        self->scratch = (double*)malloc(2 * count * sizeof(double));
+        if (!self->scratch) {
+            return PyErr_NoMemory();
+        }
+    }
+    if (self->bank_f32 && !self->scratch_f32) {
+        self->scratch_f32 = (float*)malloc(2 * count * sizeof(float));
+        if (!self->scratch_f32) {
+            return PyErr_NoMemory();
+        }
+    }
+
+    Py_buffer sp_view, pv_view, out_view;
+    void* SP;
+    void* PV;
+    void* out = NULL;
+    int sp_f32, pv_f32, out_f32 = 0;
+    PyObject* result = NULL;
+
+    if (fb_get_reals(slots[0], "SP", self->shape, 0, &sp_view, self->scratch, &SP,
+                     &sp_f32) != 0) {
+        return NULL;
+    }
+    if (fb_get_reals(slots[1], "PV", self->shape, 0, &pv_view, self->scratch + count, &PV,
+                     &pv_f32) != 0) {
+        goto release_sp;
+    }
+    if (slots[3] && slots[3] != Py_None &&
+        fb_get_reals(slots[3], "out", self->shape, 1, &out_view, NULL, &out, &out_f32) != 0) {
+        goto release_pv;
+    }
+
+    if (self->bank_f32) {
+        // float32 输入直接使用，float64 / 序列输入在边界处转换
+        if (!sp_f32) {
+            to_f32(self->scratch_f32, (const double*)SP, count);
+            SP = self->scratch_f32;
+        }
+        if (!pv_f32) {
+            to_f32(self->scratch_f32 + count, (const double*)PV, count);
+            PV = self->scratch_f32 + count;
+        }
+        pid_bank_compute_f32(self->bank_f32, (const float*)SP, (const float*)PV, (float)dt,
+                             out_f32 ? (float*)out : NULL);
+        if (out && !out_f32) {
+            to_f64((double*)out, self->bank_f32->output, count);
+        }
+    } else {
+        // double 实例：float32 输入转换到 double 临时缓冲区
+        if (sp_f32) {
+            to_f64(self->scratch, (const float*)SP, count);
+            SP = self->scratch;
+        }
+        if (pv_f32) {
+            to_f64(self->scratch + count, (const float*)PV, count);
+            PV = self->scratch + count;
+        }
+        double* out64 = out && !out_f32 ? (double*)out : NULL;
+        if (self->reduced) {
+            // 所有回路共用一次 dt 计算
+            if (dt <= 0.0) {
+                dt = fb_auto_dt(&self->clock);
+            }
+            fb_precision_array_compute(self->reduced, (const double*)SP, (const double*)PV, dt,
+                                       self->output);
+            if (out64) {
+                memcpy(out64, self->output, count * sizeof(double));
+            }
+        } else {
+            pid_bank_compute(self->bank, (const double*)SP, (const double*)PV, dt, out64);
+        }
+        if (out_f32) {
+            to_f32((float*)out, self->bank ? self->bank->output : self->output, count);
+        }
+    }
+
+    if (out) {
+        Py_INCREF(slots[3]);
+        result = slots[3];
+        PyBuffer_Release(&out_view);
+    } else {
+        result = PyMemoryView_FromObject((PyObject*)self);
+    }
+
+release_pv:
+    if (pv_view.obj) {
+        PyBuffer_Release(&pv_view);
+    }
+release_sp:
+    if (sp_view.obj) {
+        PyBuffer_Release(&sp_view);
+    }
+    return result;
+}
+
+// 解析回路下标
+static int PIDBank_index(PIDBankObject* self, PyObject* obj, size_t* index) {
+    Py_ssize_t i = PyLong_AsSsize_t(obj);
+    if (i == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (i < 0) {
+        i += self->shape;
+    }
+    if (i < 0 || i >= self->shape) {
+        PyErr_SetString(PyExc_IndexError, "回路下标越界");
+        return -1;
+    }
+    *index = (size_t)i;
+    return 0;
+}
+
+// set_params(index, Kp=None, Ki=None, Kd=None)
+static PyObject* PIDBank_set_params(PIDBankObject* self, PyObject* const* args,
+                                    Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"index", "Kp", "Ki", "Kd", NULL};
+    PyObject* slots[4];
+    size_t index;
+
+    if (fastcall_unpack("set_params", args, nargs, kwnames, kwlist, 1, slots) != 0 ||
+        PIDBank_index(self, slots[0], &index) != 0) {
+        return NULL;
+    }
+
+    double values[3];
+    double* ptrs[3] = {NULL, NULL, NULL};
+    for (int i = 0; i < 3; i++) {
+        if (slots[i + 1] && slots[i + 1] != Py_None) {
+            if (fastcall_as_double(slots[i + 1], &values[i]) != 0) {
+                return NULL;
+            }
+            ptrs[i] = &values[i];
+        }
+    }
+
+    if (self->reduced) {
+        double fields[FB_PRECISION_MAX_FIELDS];
+        fb_precision_array_get(self->reduced, index, fields);
+        for (int i = 0; i < 3; i++) {
+            if (ptrs[i]) {
+                fields[i] = values[i];
+            }
+        }
+        fb_precision_array_set_params(self->reduced, index, fields);
+    } else if (self->bank_f32) {
+        pid_bank_set_params_f32(self->bank_f32, index, ptrs[0], ptrs[1], ptrs[2]);
+    } else {
+        pid_bank_set_params(self->bank, index, ptrs[0], ptrs[1], ptrs[2]);
+    }
+    Py_RETURN_NONE;
+}
+
+// set_output_limits(index, output_min, output_max)
+static PyObject* PIDBank_set_output_limits(PIDBankObject* self, PyObject* const* args,
+                                           Py_ssize_t nargs, PyObject* kwnames) {
+    static const char* const kwlist[] = {"index", "output_min", "output_max", NULL};
+    PyObject* slots[3];
+    size_t index;
+    double output_min, output_max;
+
+    if (fastcall_unpack("set_output_limits", args, nargs, kwnames, kwlist, 3, slots) != 0 ||
+        PIDBank_index(self, slots[0], &index) != 0 ||
+        fastcall_as_double(slots[1], &output_min) != 0 ||
+        fastcall_as_double(slots[2], &output_max) != 0) {
+        return NULL;
+    }
+
+    int rc;
+    if (self->reduced) {
+        double fields[FB_PRECISION_MAX_FIELDS];
+        fb_precision_array_get(self->reduced, index, fields);
+        fields[3] = output_min;
+        fields[4] = output_max;
+        rc = fb_precision_array_set_params(self->reduced, index, fields);
+    } else if (self->bank_f32) {
+        rc = pid_bank_set_output_limits_f32(self->bank_f32, index, output_min, output_max);
+    } else {
+        rc = pid_bank_set_output_limits(self->bank, index, output_min, output_max);
+    }
+    if (rc != 0) {
+        PyErr_SetString(PyExc_ValueError, "output_min 必须小于 output_max");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// get_loop(index) -> dict
+static PyObject* PIDBank_get_loop(PIDBankObject* self, PyObject* arg) {
+    static const char* const fields[] = {"Kp", "Ki", "Kd", "output_min", "output_max",
+                                         "integral", "prev_error", "output"};
+    size_t index;
+
+    if (PIDBank_index(self, arg, &index) != 0) {
+        return NULL;
+    }
+
+    double values[FB_PRECISION_MAX_FIELDS];
+    if (self->reduced) {
+        // 参数和状态按所选精度存放，这里转换回 double
+        fb_precision_array_get(self->reduced, index, values);
+        values[7] = self->output[index];
+    } else if (self->bank_f32) {
+        const PIDBankFunctionBlock_f32* b = self->bank_f32;
+        double v[8] = {b->Kp[index], b->Ki[index], b->Kd[index], b->output_min[index],
+                       b->output_max[index], b->integral[index], b->prev_error[index],
+                       b->output[index]};
+        memcpy(values, v, sizeof(v));
+    } else {
+        const PIDBankFunctionBlock* b = self->bank;
+        double v[8] = {b->Kp[index], b->Ki[index], b->Kd[index], b->output_min[index],
+                       b->output_max[index], b->integral[index], b->prev_error[index],
+                       b->output[index]};
+        memcpy(values, v, sizeof(v));
+    }
+    return fb_fields_to_dict(fields, values, 8);
+}
+
+// reset()
+static PyObject* PIDBank_reset(PIDBankObject* self, PyObject* Py_UNUSED(ignored)) {
+    if (self->reduced) {
+        fb_precision_array_reset(self->reduced, 0.0);
+        memset(self->output, 0, (size_t)self->shape * sizeof(double));
+        self->clock.last_update_time = 0.0;
+    } else if (self->bank_f32) {
+        pid_bank_reset_f32(self->bank_f32);
+    } else {
+        pid_bank_reset(self->bank);
+    }
+    Py_RETURN_NONE;
+}
+
+static Py_ssize_t PIDBank_length(PIDBankObject* self) {
+    return self->shape;
+}
+
+// 缓冲区协议：只读导出最近一次计算的输出
+// （f32 实例在导出时把 float 输出转换为 double 副本）
+static int PIDBank_getbuffer(PIDBankObject* self, Py_buffer* view, int flags) {
+    if (self->bank_f32) {
+        to_f64(self->output, self->bank_f32->output, (size_t)self->shape);
+    }
+    return fb_export_doubles(view, (PyObject*)self, self->bank ? self->bank->output : self->output,
+                             &self->shape, &self->stride, flags);
+}
+
+// kernel -> str
+static PyObject* PIDBank_get_kernel(PIDBankObject* self, void* Py_UNUSED(closure)) {
+    if (self->bank_f32) {
+        return PyUnicode_FromString(pid_bank_kernel_name_f32());
+    }
+    return PyUnicode_FromString(self->reduced ? "scalar" : pid_bank_kernel_name());
+}
+
+// precision -> str
+static PyObject* PIDBank_get_precision(PIDBankObject* self, void* Py_UNUSED(closure)) {
+    FBPrecision precision = self->bank_f32 ? FB_PRECISION_F32 : FB_PRECISION_F64;
+    return PyUnicode_FromString(
+        fb_precision_name(self->reduced ? self->reduced->precision : precision));
+}
+
+// 方法表
+static PyMethodDef PIDBank_methods[] = {
+    {"compute", (PyCFunction)(void(*)(void))PIDBank_compute, METH_FASTCALL | METH_KEYWORDS,
+     "计算全部回路\n\n参数:\n  SP: 设定值数组（长度 n，float64 或 float32）\n"
+     "  PV: 过程变量数组（长度 n，float64 或 float32）\n"
+     "  dt: 时间步长（秒），0 表示自动计算\n  out: 可选，可写 float64 或 float32 输出缓冲区\n\n"
+     "返回:\n  out，或内部输出缓冲区的 memoryview（下次计算时被覆盖）"},
+    {"set_params", (PyCFunction)(void(*)(void))PIDBank_set_params, METH_FASTCALL | METH_KEYWORDS,
+     "修改单个回路的参数\n\n参数:\n  index: 回路下标\n  Kp, Ki, Kd: 可选，仅修改提供的参数"},
+    {"set_output_limits", (PyCFunction)(void(*)(void))PIDBank_set_output_limits,
+     METH_FASTCALL | METH_KEYWORDS,
+     "修改单个回路的输出限幅\n\n参数:\n  index: 回路下标\n  output_min, output_max: 输出范围"},
+    {"get_loop", (PyCFunction)PIDBank_get_loop, METH_O,
+     "获取单个回路的参数和状态\n\n返回:\n  dict: {Kp, Ki, Kd, output_min, output_max, "
+     "integral, prev_error, output}"},
+    {"reset", (PyCFunction)PIDBank_reset, METH_NOARGS,
+     "重置全部回路的内部状态"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef PIDBank_getset[] = {
+    FB_REGISTRY_GETSET(PIDBankObject, registered),
+    {"kernel", (getter)PIDBank_get_kernel, NULL, "当前计算内核（avx2/sse2/scalar）", NULL},
+    {"precision", (getter)PIDBank_get_precision, NULL, "参数和状态的数值精度（f64/f32/q16）", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PySequenceMethods PIDBank_as_sequence = {
+    .sq_length = (lenfunc)PIDBank_length,
+};
+
+static PyBufferProcs PIDBank_as_buffer = {
+    .bf_getbuffer = (getbufferproc)PIDBank_getbuffer,
+    .bf_releasebuffer = NULL,
+};
+
+// 类型定义
+PyTypeObject PIDBankType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.PIDBank",
+    .tp_doc = "批量 PID 功能块\n\n"
+              "以 SoA 形式保存 n 个 PID 回路，一次调用计算全部回路（SIMD），\n"
+              "每个回路的结果与 PID.compute() 逐位一致。\n"
+              "precision=\"f32\" 时按 float32 存放和计算（SIMD，每个向量的回路数加倍），\n"
+              "precision=\"q16\" 时按 Q16.16 定点存放和计算（标量内核）。",
+    .tp_basicsize = sizeof(PIDBankObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PIDBank_new,
+    .tp_dealloc = (destructor)PIDBank_dealloc,
+    .tp_methods = PIDBank_methods,
+    .tp_getset = PIDBank_getset,
+    .tp_as_sequence = &PIDBank_as_sequence,
+    .tp_as_buffer = &PIDBank_as_buffer,
+    .tp_vectorcall = PIDBank_vectorcall,
+};
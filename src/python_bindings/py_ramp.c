@@ -28,37 +28,43 @@
 
 #include <Python.h>
 #include "../function_blocks/fb_ramp.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include "py_view.h"
+#include <stddef.h>
 
 /* Ramp 对象结构 */
 typedef struct {
     PyObject_HEAD
-    RampFB fb;
+    RampFB* fb;  /* C 功能块实例（来自实例池） */
 } RampObject;
 
+static const char* const Ramp_rate_kwlist[] = {"rising_rate", "falling_rate", NULL};
+
 /* Ramp.compute() */
-static PyObject* Ramp_compute(RampObject* self, PyObject* args, PyObject* kwargs) {
-    double input, dt;
-    static char* kwlist[] = {"input", "dt", NULL};
+static PyObject* Ramp_compute(RampObject* self, PyObject* const* args, Py_ssize_t nargs,
+                              PyObject* kwnames) {
+    static const char* const kwlist[] = {"input", "dt", NULL};
+    double v[2];
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "dd", kwlist, &input, &dt)) {
+    if (fastcall_parse_doubles("compute", args, nargs, kwnames, kwlist, 2, v) != 0) {
         return NULL;
     }
 
-    double output = ramp_compute(&self->fb, input, dt);
+    double output = ramp_compute(self->fb, v[0], v[1]);
     return PyFloat_FromDouble(output);
 }
 
 /* Ramp.set_params() */
-static PyObject* Ramp_set_params(RampObject* self, PyObject* args, PyObject* kwargs) {
-    double rising_rate, falling_rate;
-    static char* kwlist[] = {"rising_rate", "falling_rate", NULL};
+static PyObject* Ramp_set_params(RampObject* self, PyObject* const* args, Py_ssize_t nargs,
+                                 PyObject* kwnames) {
+    double v[2];
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "dd", kwlist,
-                                      &rising_rate, &falling_rate)) {
+    if (fastcall_parse_doubles("set_params", args, nargs, kwnames, Ramp_rate_kwlist, 2, v) != 0) {
         return NULL;
     }
 
-    if (ramp_set_params(&self->fb, rising_rate, falling_rate) != 0) {
+    if (ramp_set_params(self->fb, v[0], v[1]) != 0) {
         PyErr_SetString(PyExc_ValueError, "Invalid parameters");
         return NULL;
     }
@@ -66,62 +72,149 @@ static PyObject* Ramp_set_params(RampObject* self, PyObject* args, PyObject* kwa
     Py_RETURN_NONE;
 }
 
-/* Ramp.get_params() */
+/* 视图字段：rising_rate、falling_rate、output 在 RampFB 中连续存放 */
+static const char* const Ramp_param_fields[] = {"rising_rate", "falling_rate"};
+static const char* const Ramp_state_fields[] = {"output"};
+
+_Static_assert(offsetof(RampFB, falling_rate) == offsetof(RampFB, rising_rate) + sizeof(double),
+               "Ramp 参数必须连续存放");
+
+static double* Ramp_params_data(PyObject* owner) {
+    return &((RampObject*)owner)->fb->rising_rate;
+}
+
+static double* Ramp_state_data(PyObject* owner) {
+    return &((RampObject*)owner)->fb->output;
+}
+
+/* Ramp.get_params()（兼容接口，推荐使用属性或 params 视图） */
 static PyObject* Ramp_get_params(RampObject* self, PyObject* Py_UNUSED(args)) {
-    double rising_rate, falling_rate;
-    ramp_get_params(&self->fb, &rising_rate, &falling_rate);
+    return fb_fields_to_dict(Ramp_param_fields, Ramp_params_data((PyObject*)self), 2);
+}
+
+/* Ramp.rising_rate / Ramp.falling_rate 属性：closure 为 0/1 */
+static PyObject* Ramp_get_rate(RampObject* self, void* closure) {
+    return PyFloat_FromDouble(Ramp_params_data((PyObject*)self)[(size_t)closure]);
+}
+
+static int Ramp_set_rate(RampObject* self, PyObject* value, void* closure) {
+    double rates[2] = {self->fb->rising_rate, self->fb->falling_rate};
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "Cannot delete ramp parameter");
+        return -1;
+    }
+    if (fastcall_as_double(value, &rates[(size_t)closure]) != 0) {
+        return -1;
+    }
+    if (ramp_set_params(self->fb, rates[0], rates[1]) != 0) {
+        PyErr_SetString(PyExc_ValueError, "Invalid parameters");
+        return -1;
+    }
+    return 0;
+}
 
-    PyObject* dict = PyDict_New();
-    if (!dict) return NULL;
+/* Ramp.params / Ramp.state 零拷贝视图 */
+static PyObject* Ramp_get_params_view(RampObject* self, void* Py_UNUSED(closure)) {
+    return fb_view_new((PyObject*)self, Ramp_params_data, Ramp_param_fields, 2);
+}
 
-    PyDict_SetItemString(dict, "rising_rate", PyFloat_FromDouble(rising_rate));
-    PyDict_SetItemString(dict, "falling_rate", PyFloat_FromDouble(falling_rate));
+static PyObject* Ramp_get_state_view(RampObject* self, void* Py_UNUSED(closure)) {
+    return fb_view_new((PyObject*)self, Ramp_state_data, Ramp_state_fields, 1);
+}
 
-    return dict;
+/* Ramp.output 只读属性 */
+static PyObject* Ramp_get_output(RampObject* self, void* Py_UNUSED(closure)) {
+    return PyFloat_FromDouble(self->fb->output);
 }
 
+/* 属性表 */
+static PyGetSetDef Ramp_getset[] = {
+    {"output", (getter)Ramp_get_output, NULL,
+     "Current output (read-only, use reset() to preset)", NULL},
+    {"rising_rate", (getter)Ramp_get_rate, (setter)Ramp_set_rate,
+     "Rising rate (units/s)", (void*)0},
+    {"falling_rate", (getter)Ramp_get_rate, (setter)Ramp_set_rate,
+     "Falling rate (units/s)", (void*)1},
+    {"params", (getter)Ramp_get_params_view, NULL,
+     "Zero-copy read-only view {rising_rate, falling_rate}", NULL},
+    {"state", (getter)Ramp_get_state_view, NULL, "Zero-copy read-only view {output}", NULL},
+    FB_REGISTRY_GETSET(RampObject, fb),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
 /* Ramp.reset() */
-static PyObject* Ramp_reset(RampObject* self, PyObject* args) {
+static PyObject* Ramp_reset(RampObject* self, PyObject* const* args, Py_ssize_t nargs) {
     double initial_value = 0.0;
 
-    if (!PyArg_ParseTuple(args, "|d", &initial_value)) {
+    if (fastcall_check_nargs("reset", nargs, 0, 1) != 0 ||
+        (nargs == 1 && fastcall_as_double(args[0], &initial_value) != 0)) {
         return NULL;
     }
 
-    ramp_reset(&self->fb, initial_value);
+    ramp_reset(self->fb, initial_value);
     Py_RETURN_NONE;
 }
 
 /* 方法表 */
 static PyMethodDef Ramp_methods[] = {
-    {"compute", (PyCFunction)Ramp_compute, METH_VARARGS | METH_KEYWORDS,
+    {"compute", (PyCFunction)(void(*)(void))Ramp_compute, METH_FASTCALL | METH_KEYWORDS,
      "Compute ramp output with rate limiting"},
-    {"set_params", (PyCFunction)Ramp_set_params, METH_VARARGS | METH_KEYWORDS,
+    {"set_params", (PyCFunction)(void(*)(void))Ramp_set_params, METH_FASTCALL | METH_KEYWORDS,
      "Set ramp parameters"},
     {"get_params", (PyCFunction)Ramp_get_params, METH_NOARGS,
      "Get ramp parameters"},
-    {"reset", (PyCFunction)Ramp_reset, METH_VARARGS,
+    {"reset", (PyCFunction)(void(*)(void))Ramp_reset, METH_FASTCALL,
      "Reset ramp state"},
     {NULL, NULL, 0, NULL}
 };
 
+/* Ramp.__del__()：实例归还实例池 */
+static void Ramp_dealloc(RampObject* self) {
+    if (self->fb) {
+        ramp_destroy(self->fb);
+    }
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* 按参数创建 C 功能块；重复调用 __init__ 时原地更新，保持已导出视图的地址有效 */
+static int Ramp_setup(RampObject* self, double rising_rate, double falling_rate) {
+    if (self->fb) {
+        RampFB fresh;
+        if (ramp_init(&fresh, rising_rate, falling_rate) != 0) {
+            PyErr_SetString(PyExc_ValueError, "Failed to initialize Ramp");
+            return -1;
+        }
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+        return 0;
+    }
+
+    if (rising_rate < 0.0 || falling_rate < 0.0) {
+        PyErr_SetString(PyExc_ValueError, "Failed to initialize Ramp");
+        return -1;
+    }
+
+    self->fb = ramp_create(rising_rate, falling_rate);
+    if (!self->fb) {
+        PyErr_SetString(PyExc_MemoryError, "Ramp 创建失败：实例池或注册表已满");
+        return -1;
+    }
+    fb_py_register_owner((PyObject*)self, self->fb);
+
+    return 0;
+}
+
 /* Ramp.__init__() */
 static int Ramp_init(RampObject* self, PyObject* args, PyObject* kwargs) {
     double rising_rate = 1.0;
     double falling_rate = 1.0;
-    static char* kwlist[] = {"rising_rate", "falling_rate", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|dd", kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|dd", (char**)Ramp_rate_kwlist,
                                       &rising_rate, &falling_rate)) {
         return -1;
     }
 
-    if (ramp_init(&self->fb, rising_rate, falling_rate) != 0) {
-        PyErr_SetString(PyExc_ValueError, "Failed to initialize Ramp");
-        return -1;
-    }
-
-    return 0;
+    return Ramp_setup(self, rising_rate, falling_rate);
 }
 
 /* Ramp.__new__() */
@@ -130,6 +223,29 @@ static PyObject* Ramp_new(PyTypeObject* type, PyObject* args, PyObject* kwargs)
     return (PyObject*)self;
 }
 
+/* Ramp(...) vectorcall 构造 */
+static PyObject* Ramp_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                 PyObject* kwnames) {
+    double v[2] = {1.0, 1.0};
+
+    if (fastcall_parse_doubles("Ramp", args, PyVectorcall_NARGS(nargsf), kwnames,
+                               Ramp_rate_kwlist, 0, v) != 0) {
+        return NULL;
+    }
+
+    RampObject* self = (RampObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (Ramp_setup(self, v[0], v[1]) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
 /* Ramp 类型对象 */
 PyTypeObject RampType = {
     PyVarObject_HEAD_INIT(NULL, 0)
@@ -138,7 +254,10 @@ PyTypeObject RampType = {
     .tp_basicsize = sizeof(RampObject),
     .tp_itemsize = 0,
     .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)Ramp_dealloc,
     .tp_new = Ramp_new,
     .tp_init = (initproc)Ramp_init,
     .tp_methods = Ramp_methods,
+    .tp_getset = Ramp_getset,
+    .tp_vectorcall = Ramp_vectorcall,
 };
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_record.c
+ * @brief 输入录制与回放的 Python 绑定
+ *
+ * Recorder(path, mode) 封装一个录制文件：input(name, value) 声明并记录外部
+ * 输入（回放时返回录制值），output(name, value) 记录需要核对的输出（回放时
+ * 与录制值比较），cycle() 开始一个周期。通道名到通道号的映射缓存在字典中，
+ * 每次调用只做一次字典查找和一次内存追加。运行时通过 _capsule 取得底层
+ * FBRecorder 指针，每周期在 C 中开始周期。
+ */
+
+#include <Python.h>
+#include <math.h>
+#include "../function_blocks/fb_common.h"
+#include "../function_blocks/fb_record.h"
+#include "py_fastcall.h"
+
+// Recorder Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    FBRecorder* rec;      // C 句柄，close() 后为 NULL
+    PyObject* channels[2];  // 按方向（输入/输出）的 {名称: 通道号} 缓存
+} RecorderObject;
+
+static int Recorder_check_open(RecorderObject* self) {
+    if (!self->rec) {
+        PyErr_SetString(PyExc_ValueError, "recorder is closed");
+        return -1;
+    }
+    return 0;
+}
+
+static void Recorder_close_rec(RecorderObject* self) {
+    if (self->rec) {
+        FBRecorder* rec = self->rec;
+        self->rec = NULL;
+        Py_BEGIN_ALLOW_THREADS
+        fb_record_close(rec);
+        Py_END_ALLOW_THREADS
+    }
+}
+
+static void Recorder_dealloc(RecorderObject* self) {
+    Recorder_close_rec(self);
+    Py_XDECREF(self->channels[FB_RECORD_INPUT]);
+    Py_XDECREF(self->channels[FB_RECORD_OUTPUT]);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 构造：Recorder(path, mode="record", buffer_size=0)
+static PyObject* Recorder_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"path", "mode", "buffer_size", NULL};
+    PyObject* path;
+    const char* mode_name = "record";
+    Py_ssize_t buffer_size = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&|sn", kwlist, PyUnicode_FSConverter, &path,
+                                     &mode_name, &buffer_size)) {
+        return NULL;
+    }
+
+    FBRecordMode mode;
+    if (strcmp(mode_name, "record") == 0) {
+        mode = FB_RECORD_MODE_RECORD;
+    } else if (strcmp(mode_name, "replay") == 0) {
+        mode = FB_RECORD_MODE_REPLAY;
+    } else {
+        Py_DECREF(path);
+        PyErr_Format(PyExc_ValueError, "mode must be 'record' or 'replay', not '%s'", mode_name);
+        return NULL;
+    }
+    if (buffer_size < 0) {
+        Py_DECREF(path);
+        PyErr_SetString(PyExc_ValueError, "buffer_size must be non-negative");
+        return NULL;
+    }
+
+    RecorderObject* self = (RecorderObject*)type->tp_alloc(type, 0);
+    if (!self) {
+        Py_DECREF(path);
+        return NULL;
+    }
+
+    self->channels[FB_RECORD_INPUT] = PyDict_New();
+    self->channels[FB_RECORD_OUTPUT] = PyDict_New();
+    self->rec = self->channels[FB_RECORD_INPUT] && self->channels[FB_RECORD_OUTPUT]
+                    ? fb_record_open(PyBytes_AS_STRING(path), mode, (size_t)buffer_size)
+                    : NULL;
+    if (!self->rec) {
+        if (!PyErr_Occurred()) {
+            PyErr_Format(PyExc_OSError, "cannot open recording '%s'", PyBytes_AS_STRING(path));
+        }
+        Py_DECREF(path);
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    Py_DECREF(path);
+    return (PyObject*)self;
+}
+
+// 取得通道号（首次使用时创建并缓存）
+static int Recorder_channel(RecorderObject* self, PyObject* name, FBRecordDirection direction) {
+    if (!PyUnicode_Check(name)) {
+        PyErr_SetString(PyExc_TypeError, "channel name must be a str");
+        return -1;
+    }
+
+    PyObject* cache = self->channels[direction];
+    PyObject* cached = PyDict_GetItemWithError(cache, name);  // 借用引用
+    if (cached) {
+        return (int)PyLong_AsLong(cached);
+    }
+    if (PyErr_Occurred()) {
+        return -1;
+    }
+
+    const char* utf8 = PyUnicode_AsUTF8(name);
+    int channel = utf8 ? fb_record_channel(self->rec, utf8, direction) : -1;
+    if (channel < 0) {
+        if (!PyErr_Occurred()) {
+            PyErr_Format(PyExc_ValueError, "invalid channel name '%U'", name);
+        }
+        return -1;
+    }
+
+    PyObject* value = PyLong_FromLong(channel);
+    int rc = value ? PyDict_SetItem(cache, name, value) : -1;
+    Py_XDECREF(value);
+    return rc == 0 ? channel : -1;
+}
+
+// 解析 (name, value) 参数并取得通道号
+static int Recorder_parse_value(RecorderObject* self, const char* fname, PyObject* const* args,
+                                Py_ssize_t nargs, FBRecordDirection direction, double* value) {
+    if (Recorder_check_open(self) != 0 || fastcall_check_nargs(fname, nargs, 2, 2) != 0 ||
+        fastcall_as_double(args[1], value) != 0) {
+        return -1;
+    }
+    return Recorder_channel(self, args[0], direction);
+}
+
+// input(name, value) -> float：记录外部输入；回放时返回录制值
+static PyObject* Recorder_input(RecorderObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    double value;
+    int channel = Recorder_parse_value(self, "input", args, nargs, FB_RECORD_INPUT, &value);
+    if (channel < 0) {
+        return NULL;
+    }
+    return PyFloat_FromDouble(fb_record_input(self->rec, channel, value));
+}
+
+// output(name, value) -> bool：记录输出；回放时返回是否与录制值不一致
+static PyObject* Recorder_output(RecorderObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    double value;
+    int channel = Recorder_parse_value(self, "output", args, nargs, FB_RECORD_OUTPUT, &value);
+    if (channel < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(fb_record_output(self->rec, channel, value));
+}
+
+// cycle(now=None) -> float | None：开始一个周期，返回周期时间；回放结束返回 None
+static PyObject* Recorder_cycle(RecorderObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    double now = 0.0;
+    double cycle_time;
+
+    if (Recorder_check_open(self) != 0 || fastcall_check_nargs("cycle", nargs, 0, 1) != 0) {
+        return NULL;
+    }
+    if (nargs == 1 && args[0] != Py_None) {
+        if (fastcall_as_double(args[0], &now) != 0) {
+            return NULL;
+        }
+    } else {
+        now = fb_clock_monotonic();
+    }
+
+    int rc = fb_record_begin_cycle(self->rec, now, &cycle_time);
+    if (rc < 0) {
+        PyErr_SetString(PyExc_RuntimeError, "recording is corrupted");
+        return NULL;
+    }
+    if (rc > 0) {
+        Py_RETURN_NONE;
+    }
+    return PyFloat_FromDouble(cycle_time);
+}
+
+// close()：写出剩余记录并关闭
+static PyObject* Recorder_close(RecorderObject* self, PyObject* Py_UNUSED(args)) {
+    Recorder_close_rec(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Recorder_get_mode(RecorderObject* self, void* Py_UNUSED(closure)) {
+    if (Recorder_check_open(self) != 0) {
+        return NULL;
+    }
+    return PyUnicode_FromString(fb_record_mode(self->rec) == FB_RECORD_MODE_RECORD ? "record"
+                                                                                   : "replay");
+}
+
+static PyObject* Recorder_get_stats(RecorderObject* self, void* Py_UNUSED(closure)) {
+    FBRecordStats stats;
+
+    if (Recorder_check_open(self) != 0) {
+        return NULL;
+    }
+    fb_record_get_stats(self->rec, &stats);
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:n,s:O}",
+                         "cycles", (unsigned long long)stats.cycles,
+                         "records", (unsigned long long)stats.records,
+                         "dropped", (unsigned long long)stats.dropped,
+                         "bytes", (unsigned long long)stats.bytes,
+                         "channels", (Py_ssize_t)stats.channels,
+                         "finished", stats.finished ? Py_True : Py_False);
+}
+
+// divergence -> None | {cycle, channel, expected, actual}
+static PyObject* Recorder_get_divergence(RecorderObject* self, void* Py_UNUSED(closure)) {
+    FBRecordDivergence div;
+
+    if (Recorder_check_open(self) != 0) {
+        return NULL;
+    }
+    fb_record_get_divergence(self->rec, &div);
+    if (!div.found) {
+        Py_RETURN_NONE;
+    }
+    return Py_BuildValue("{s:K,s:s,s:d,s:d}",
+                         "cycle", (unsigned long long)div.cycle,
+                         "channel", div.channel,
+                         "expected", div.expected,
+                         "actual", div.actual);
+}
+
+static PyObject* Recorder_get_closed(RecorderObject* self, void* Py_UNUSED(closure)) {
+    return PyBool_FromLong(self->rec == NULL);
+}
+
+// _capsule -> PyCapsule(FBRecorder*)，供运行时在 C 中开始周期
+static PyObject* Recorder_get_capsule(RecorderObject* self, void* Py_UNUSED(closure)) {
+    if (Recorder_check_open(self) != 0) {
+        return NULL;
+    }
+    return PyCapsule_New(self->rec, FB_RECORD_CAPSULE_NAME, NULL);
+}
+
+static PyMethodDef Recorder_methods[] = {
+    {"input", (PyCFunction)(void(*)(void))Recorder_input, METH_FASTCALL,
+     "input(name, value) -> float: record an external input (replay: recorded value)"},
+    {"output", (PyCFunction)(void(*)(void))Recorder_output, METH_FASTCALL,
+     "output(name, value) -> bool: record an output (replay: True if it diverges)"},
+    {"cycle", (PyCFunction)(void(*)(void))Recorder_cycle, METH_FASTCALL,
+     "cycle(now=None) -> float | None: begin a cycle; None when the replay is finished"},
+    {"close", (PyCFunction)Recorder_close, METH_NOARGS,
+     "Flush remaining records and close the file"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef Recorder_getset[] = {
+    {"mode", (getter)Recorder_get_mode, NULL, "'record' 或 'replay'", NULL},
+    {"stats", (getter)Recorder_get_stats, NULL, "录制/回放统计", NULL},
+    {"divergence", (getter)Recorder_get_divergence, NULL, "第一个不一致，没有时为 None", NULL},
+    {"closed", (getter)Recorder_get_closed, NULL, "是否已关闭", NULL},
+    {"_capsule", (getter)Recorder_get_capsule, NULL, "底层 FBRecorder 指针（运行时内部使用）",
+     NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+PyTypeObject RecorderType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.Recorder",
+    .tp_doc = "Recorder(path, mode='record', buffer_size=0): cycle input recording and replay",
+    .tp_basicsize = sizeof(RecorderObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = Recorder_new,
+    .tp_dealloc = (destructor)Recorder_dealloc,
+    .tp_methods = Recorder_methods,
+    .tp_getset = Recorder_getset,
+};
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_registry.c
+ * @brief 全局功能块注册表的 Python 绑定实现
+ */
+
+#include "py_registry.h"
+#include "py_fastcall.h"
+#include "../function_blocks/fb_journal.h"
+#include "../function_blocks/fb_registry.h"
+#include "../function_blocks/fb_timing.h"
+
+static FunctionBlock* block_of(PyObject* self, void* closure) {
+    return *(FunctionBlock**)((char*)self + (size_t)closure);
+}
+
+PyObject* fb_py_get_id(PyObject* self, void* closure) {
+    return PyLong_FromUnsignedLong(block_of(self, closure)->id);
+}
+
+PyObject* fb_py_get_name(PyObject* self, void* closure) {
+    FBRegistryEntry entry;
+    if (fb_registry_find(block_of(self, closure)->id, &entry) != 0 || !entry.name[0]) {
+        Py_RETURN_NONE;
+    }
+    return PyUnicode_FromString(entry.name);
+}
+
+int fb_py_set_name(PyObject* self, PyObject* value, void* closure) {
+    const char* name = NULL;
+
+    if (value && value != Py_None) {
+        name = PyUnicode_AsUTF8(value);
+        if (!name) {
+            return -1;
+        }
+    }
+
+    if (fb_registry_set_name(block_of(self, closure)->id, name) != 0) {
+        PyErr_Format(PyExc_ValueError, "name '%s' is too long or already in use",
+                     name ? name : "");
+        return -1;
+    }
+    return 0;
+}
+
+// 计数换算为 {calls, total_ns, mean_ns, max_ns}
+static PyObject* timing_to_dict(const FBTiming* timing) {
+    double scale = fb_timing_ns_per_tick();
+    double total_ns = (double)timing->total * scale;
+    double mean_ns = timing->calls ? total_ns / (double)timing->calls : 0.0;
+    return Py_BuildValue("{s:K,s:d,s:d,s:d}",
+                         "calls", (unsigned long long)timing->calls,
+                         "total_ns", total_ns,
+                         "mean_ns", mean_ns,
+                         "max_ns", (double)timing->max * scale);
+}
+
+PyObject* fb_py_get_timing(PyObject* self, void* closure) {
+#ifdef FB_TIMING
+    FBTiming timing = block_of(self, closure)->timing;
+    return timing_to_dict(&timing);
+#else
+    (void)self;
+    (void)closure;
+    Py_RETURN_NONE;
+#endif
+}
+
+void fb_py_register_owner(PyObject* self, void* block) {
+    fb_registry_set_owner(((FunctionBlock*)block)->id, self);
+}
+
+static PyObject* entry_to_dict(const FBRegistryEntry* entry) {
+    PyObject* name = entry->name[0] ? PyUnicode_FromString(entry->name) : Py_NewRef(Py_None);
+    if (!name) {
+        return NULL;
+    }
+
+    // 实例数组按 Python 类型名区分（FirstOrderArray、IIRArray……）
+    const char* type = fb_journal_type_name(entry->type);
+    if (entry->type == FB_TYPE_ARRAY && entry->owner) {
+        type = _PyType_Name(Py_TYPE((PyObject*)entry->owner));
+    }
+    return Py_BuildValue("{s:k,s:s,s:N,s:O}",
+                         "id", (unsigned long)entry->id,
+                         "type", type,
+                         "name", name,
+                         "object", entry->owner ? (PyObject*)entry->owner : Py_None);
+}
+
+typedef struct {
+    FBRegistryEntry* items;
+    size_t count;
+    size_t capacity;
+} Snapshot;
+
+static int snapshot_visit(const FBRegistryEntry* entry, void* user) {
+    Snapshot* snapshot = (Snapshot*)user;
+    if (snapshot->count == snapshot->capacity) {
+        return 1;
+    }
+    snapshot->items[snapshot->count++] = *entry;
+    return 0;
+}
+
+// blocks() -> [{id, type, name, object}, ...]
+PyObject* fb_py_blocks(PyObject* Py_UNUSED(module), PyObject* Py_UNUSED(args)) {
+    Snapshot snapshot = {NULL, 0, fb_registry_count()};
+
+    snapshot.items = PyMem_Malloc((snapshot.capacity ? snapshot.capacity : 1) *
+                                  sizeof(FBRegistryEntry));
+    if (!snapshot.items) {
+        return PyErr_NoMemory();
+    }
+    fb_registry_foreach(snapshot_visit, &snapshot);
+
+    PyObject* result = PyList_New((Py_ssize_t)snapshot.count);
+    for (size_t i = 0; result && i < snapshot.count; i++) {
+        PyObject* item = entry_to_dict(&snapshot.items[i]);
+        if (!item) {
+            Py_CLEAR(result);
+            break;
+        }
+        PyList_SET_ITEM(result, (Py_ssize_t)i, item);
+    }
+
+    PyMem_Free(snapshot.items);
+    return result;
+}
+
+// 按 int（ID）或 str（名称）查找；未找到返回 1，参数类型错误返回 -1
+static int lookup(PyObject* key, FBRegistryEntry* entry) {
+    if (PyLong_Check(key)) {
+        unsigned long id = PyLong_AsUnsignedLong(key);
+        if (id == (unsigned long)-1 && PyErr_Occurred()) {
+            PyErr_Clear();
+            return 1;
+        }
+        return id <= UINT32_MAX && fb_registry_find((uint32_t)id, entry) == 0 ? 0 : 1;
+    }
+    if (PyUnicode_Check(key)) {
+        const char* name = PyUnicode_AsUTF8(key);
+        if (!name) {
+            return -1;
+        }
+        return fb_registry_find_name(name, entry) == 0 ? 0 : 1;
+    }
+
+    PyErr_SetString(PyExc_TypeError, "block key must be an int id or a str name");
+    return -1;
+}
+
+// find_block(key) -> dict 或 None
+PyObject* fb_py_find_block(PyObject* Py_UNUSED(module), PyObject* key) {
+    FBRegistryEntry entry;
+    int rc = lookup(key, &entry);
+    if (rc < 0) {
+        return NULL;
+    }
+    if (rc > 0) {
+        Py_RETURN_NONE;
+    }
+    return entry_to_dict(&entry);
+}
+
+// set_block_param(key, param, value)
+PyObject* fb_py_set_block_param(PyObject* Py_UNUSED(module), PyObject* const* args,
+                                Py_ssize_t nargs) {
+    double value;
+
+    if (fastcall_check_nargs("set_block_param", nargs, 3, 3) != 0) {
+        return NULL;
+    }
+    const char* param = PyUnicode_AsUTF8(args[1]);
+    if (!param || fastcall_as_double(args[2], &value) != 0) {
+        return NULL;
+    }
+
+    FBRegistryEntry entry;
+    int rc = lookup(args[0], &entry);
+    if (rc < 0) {
+        return NULL;
+    }
+    if (rc > 0) {
+        PyErr_SetObject(PyExc_KeyError, args[0]);
+        return NULL;
+    }
+
+    if (fb_registry_set_param(entry.id, param, value) != 0) {
+        PyErr_Format(PyExc_ValueError, "unknown parameter '%s' or invalid value for block %lu",
+                     param, (unsigned long)entry.id);
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// timing() -> [{id, type, name, object, calls, total_ns, mean_ns, max_ns}, ...]
+PyObject* fb_py_timing(PyObject* Py_UNUSED(module), PyObject* Py_UNUSED(args)) {
+    size_t capacity = fb_registry_count();
+    FBTimingSample* samples = PyMem_Malloc((capacity ? capacity : 1) * sizeof(FBTimingSample));
+    if (!samples) {
+        return PyErr_NoMemory();
+    }
+    size_t count = fb_timing_snapshot(samples, capacity);
+
+    PyObject* result = PyList_New((Py_ssize_t)count);
+    for (size_t i = 0; result && i < count; i++) {
+        PyObject* item = entry_to_dict(&samples[i].entry);
+        PyObject* timing = item ? timing_to_dict(&samples[i].timing) : NULL;
+        if (!timing || PyDict_Update(item, timing) != 0) {
+            Py_XDECREF(timing);
+            Py_XDECREF(item);
+            Py_CLEAR(result);
+            break;
+        }
+        Py_DECREF(timing);
+        PyList_SET_ITEM(result, (Py_ssize_t)i, item);
+    }
+
+    PyMem_Free(samples);
+    return result;
+}
+
+// timing_reset()
+PyObject* fb_py_timing_reset(PyObject* Py_UNUSED(module), PyObject* Py_UNUSED(args)) {
+    fb_timing_reset_all();
+    Py_RETURN_NONE;
+}
+
+// timing_dump(path, append=False) -> 导出的实例数
+PyObject* fb_py_timing_dump(PyObject* Py_UNUSED(module), PyObject* args) {
+    const char* path;
+    int append = 0;
+
+    if (!PyArg_ParseTuple(args, "s|p:timing_dump", &path, &append)) {
+        return NULL;
+    }
+    if (!fb_timing_enabled()) {
+        PyErr_SetString(PyExc_RuntimeError, "未以 FB_TIMING 构建，没有功能块计时可导出");
+        return NULL;
+    }
+
+    int count = fb_timing_dump(path, append ? "a" : "w");
+    if (count < 0) {
+        PyErr_Format(PyExc_OSError, "cannot write timing dump to '%s'", path);
+        return NULL;
+    }
+    return PyLong_FromLong(count);
+}
+
+// 变更记录的数值按 labels 命名；名称不足时用 v0、v1……
+static PyObject* record_values(const FBJournalRecord* r) {
+    PyObject* values = PyDict_New();
+    const char* label = r->labels;
+
+    for (uint8_t i = 0; values && i < r->count; i++) {
+        PyObject* key;
+        if (label && *label) {
+            const char* end = strchr(label, ',');
+            size_t len = end ? (size_t)(end - label) : strlen(label);
+            key = PyUnicode_FromStringAndSize(label, (Py_ssize_t)len);
+            label = end ? end + 1 : NULL;
+        } else {
+            key = PyUnicode_FromFormat("v%u", (unsigned)i);
+        }
+        PyObject* value = key ? PyFloat_FromDouble(r->values[i]) : NULL;
+        if (!value || PyDict_SetItem(values, key, value) != 0) {
+            Py_CLEAR(values);
+        }
+        Py_XDECREF(key);
+        Py_XDECREF(value);
+    }
+    return values;
+}
+
+// journal(since=0) -> 序号大于 since 的变更记录列表（最多保留最近 FB_JOURNAL_CAPACITY 条）
+PyObject* fb_py_journal(PyObject* Py_UNUSED(module), PyObject* args) {
+    unsigned long long since = 0;
+
+    if (!PyArg_ParseTuple(args, "|K:journal", &since)) {
+        return NULL;
+    }
+    FBJournalRecord* records = PyMem_Malloc(FB_JOURNAL_CAPACITY * sizeof(FBJournalRecord));
+    if (!records) {
+        return PyErr_NoMemory();
+    }
+    size_t count = fb_journal_read(fb_journal_default(), since, records, FB_JOURNAL_CAPACITY,
+                                   NULL);
+
+    PyObject* result = PyList_New((Py_ssize_t)count);
+    for (size_t i = 0; result && i < count; i++) {
+        const FBJournalRecord* r = &records[i];
+        PyObject* values = record_values(r);
+        PyObject* item = values ? Py_BuildValue(
+            "{s:K,s:d,s:s,s:k,s:s,s:N}",
+            "seq", (unsigned long long)r->seq,
+            "time", r->time,
+            "type", fb_journal_type_name((FunctionBlockType)r->type),
+            "id", (unsigned long)r->id,
+            "event", fb_journal_event_name((FBEventKind)r->kind),
+            "values", values) : NULL;
+        if (!item) {
+            Py_CLEAR(result);
+            break;
+        }
+        PyList_SET_ITEM(result, (Py_ssize_t)i, item);
+    }
+
+    PyMem_Free(records);
+    return result;
+}
+
+// journal_stats() -> {"events": {类型: {事件: 次数}}, "clamped": n, "records": n}
+PyObject* fb_py_journal_stats(PyObject* Py_UNUSED(module), PyObject* Py_UNUSED(args)) {
+    const FBJournal* journal = fb_journal_default();
+    PyObject* events = PyDict_New();
+
+    for (int t = 0; events && t < FB_TYPE_COUNT; t++) {
+        PyObject* per_type = NULL;
+        for (int k = 0; k < FB_EVENT_COUNT; k++) {
+            uint64_t n = __atomic_load_n(&journal->counts[t][k], __ATOMIC_RELAXED);
+            if (n == 0) {
+                continue;
+            }
+            if (!per_type) {
+                per_type = PyDict_New();
+                if (!per_type || PyDict_SetItemString(events,
+                                                      fb_journal_type_name((FunctionBlockType)t),
+                                                      per_type) != 0) {
+                    Py_CLEAR(events);
+                    break;
+                }
+            }
+            PyObject* value = PyLong_FromUnsignedLongLong(n);
+            if (!value || PyDict_SetItemString(per_type, fb_journal_event_name((FBEventKind)k),
+                                               value) != 0) {
+                Py_XDECREF(value);
+                Py_CLEAR(events);
+                break;
+            }
+            Py_DECREF(value);
+        }
+        Py_XDECREF(per_type);
+    }
+    if (!events) {
+        return NULL;
+    }
+
+    return Py_BuildValue("{s:N,s:K,s:K,s:i}",
+                         "events", events,
+                         "clamped", (unsigned long long)__atomic_load_n(&journal->clamps,
+                                                                        __ATOMIC_RELAXED),
+                         "records", (unsigned long long)__atomic_load_n(&journal->head,
+                                                                        __ATOMIC_ACQUIRE),
+                         "capacity", FB_JOURNAL_CAPACITY);
+}
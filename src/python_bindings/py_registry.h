@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_registry.h
+ * @brief 全局功能块注册表的 Python 绑定
+ *
+ * 各功能块类型通过 FB_REGISTRY_GETSET 暴露 id（只读）、name（可写）和
+ * timing（只读，执行时间计数）属性，模块级函数 blocks()/find_block()/
+ * set_block_param() 提供枚举、查找和在线改参，timing()/timing_reset()/
+ * timing_dump() 汇总执行时间计数（见 fb_timing.h），journal()/journal_stats()
+ * 读取功能块事件计数和变更记录（见 fb_journal.h）。
+ * 注册表条目的 owner 指向 Python 包装对象（借用引用，对象析构时先注销）。
+ */
+
+#ifndef PY_REGISTRY_H
+#define PY_REGISTRY_H
+
+#include <Python.h>
+#include <stddef.h>
+
+/* id/name/timing 属性；closure 为对象中功能块指针成员的偏移 */
+PyObject* fb_py_get_id(PyObject* self, void* closure);
+PyObject* fb_py_get_name(PyObject* self, void* closure);
+int fb_py_set_name(PyObject* self, PyObject* value, void* closure);
+PyObject* fb_py_get_timing(PyObject* self, void* closure);
+
+#define FB_REGISTRY_GETSET(ObjType, member)                                        \
+    {"id", fb_py_get_id, NULL, "注册表 ID（只读）", (void*)offsetof(ObjType, member)}, \
+    {"name", fb_py_get_name, fb_py_set_name, "注册表名称（None 表示未命名）",         \
+     (void*)offsetof(ObjType, member)},                                             \
+    {"timing", fb_py_get_timing, NULL,                                              \
+     "执行时间计数 {calls, total_ns, mean_ns, max_ns}（未以 FB_TIMING 构建时为 None）", \
+     (void*)offsetof(ObjType, member)}
+
+/**
+ * @brief 把新创建的功能块的注册表 owner 设为 Python 包装对象
+ * @param self 包装对象
+ * @param block 功能块实例（以 FunctionBlock 开头）
+ */
+void fb_py_register_owner(PyObject* self, void* block);
+
+/* 模块级函数：blocks()、find_block(key)、set_block_param(key, param, value) */
+PyObject* fb_py_blocks(PyObject* module, PyObject* args);
+PyObject* fb_py_find_block(PyObject* module, PyObject* key);
+PyObject* fb_py_set_block_param(PyObject* module, PyObject* const* args, Py_ssize_t nargs);
+
+/* 模块级函数：timing()、timing_reset()、timing_dump(path, append=False) */
+PyObject* fb_py_timing(PyObject* module, PyObject* args);
+PyObject* fb_py_timing_reset(PyObject* module, PyObject* args);
+PyObject* fb_py_timing_dump(PyObject* module, PyObject* args);
+
+/* 模块级函数：journal(since=0)、journal_stats() */
+PyObject* fb_py_journal(PyObject* module, PyObject* args);
+PyObject* fb_py_journal_stats(PyObject* module, PyObject* args);
+
+#endif // PY_REGISTRY_H
@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_retain.c
+ * @brief 保持型（RETAIN）变量的 Python 绑定
+ *
+ * Retain 封装一个保持文件：block() 声明保持的功能块状态，var() 声明保持变量
+ * （返回 RetainVar，读写 .value 即读写映射文件对应的存储单元）。
+ * checkpoint() 只做内存复制，写盘由 start() 启动的后台线程完成。
+ * 运行时通过 _capsule 取得底层 FBRetain 指针，每周期在 C 中捕获。
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_registry.h"
+#include "../function_blocks/fb_retain.h"
+#include "py_fastcall.h"
+
+// Retain Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    FBRetain* retain;     // C 句柄，close() 后为 NULL
+    PyObject* blocks;     // 已声明的功能块对象（持有引用，保证实例在关闭前有效）
+} RetainObject;
+
+// RetainVar Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    RetainObject* owner;  // 所属 Retain（持有引用）
+    double* cell;         // 存储单元
+    PyObject* key;
+    int restored;
+} RetainVarObject;
+
+PyTypeObject RetainVarType;
+
+static int Retain_check_open(RetainObject* self) {
+    if (!self->retain) {
+        PyErr_SetString(PyExc_ValueError, "retain store is closed");
+        return -1;
+    }
+    return 0;
+}
+
+// 关闭：停止写线程并写入最终检查点
+static void Retain_close_store(RetainObject* self) {
+    if (self->retain) {
+        FBRetain* retain = self->retain;
+        self->retain = NULL;
+        Py_BEGIN_ALLOW_THREADS
+        fb_retain_close(retain);
+        Py_END_ALLOW_THREADS
+    }
+}
+
+static void Retain_dealloc(RetainObject* self) {
+    Retain_close_store(self);
+    Py_XDECREF(self->blocks);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 构造：Retain(path, size=0)
+static PyObject* Retain_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"path", "size", NULL};
+    PyObject* path;
+    Py_ssize_t size = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&|n", kwlist, PyUnicode_FSConverter, &path,
+                                     &size)) {
+        return NULL;
+    }
+    if (size < 0) {
+        Py_DECREF(path);
+        PyErr_SetString(PyExc_ValueError, "size must be non-negative");
+        return NULL;
+    }
+
+    RetainObject* self = (RetainObject*)type->tp_alloc(type, 0);
+    if (!self) {
+        Py_DECREF(path);
+        return NULL;
+    }
+
+    self->blocks = PyList_New(0);
+    self->retain = self->blocks ? fb_retain_open(PyBytes_AS_STRING(path), (size_t)size) : NULL;
+    if (!self->retain) {
+        if (!PyErr_Occurred()) {
+            PyErr_Format(PyExc_OSError, "cannot open retain file '%s'", PyBytes_AS_STRING(path));
+        }
+        Py_DECREF(path);
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    Py_DECREF(path);
+    return (PyObject*)self;
+}
+
+// block(fb, key=None) -> bool：声明保持的功能块，返回是否从检查点恢复
+static PyObject* Retain_block(RetainObject* self, PyObject* const* args, Py_ssize_t nargs,
+                              PyObject* kwnames) {
+    static const char* const kwlist[] = {"fb", "key", NULL};
+    PyObject* slots[2] = {NULL, NULL};
+
+    if (Retain_check_open(self) != 0 ||
+        fastcall_unpack("block", args, nargs, kwnames, kwlist, 1, slots) != 0) {
+        return NULL;
+    }
+
+    // 通过注册表取得包装对象对应的 C 实例
+    PyObject* id_obj = PyObject_GetAttrString(slots[0], "id");
+    unsigned long id = id_obj ? PyLong_AsUnsignedLong(id_obj) : 0;
+    Py_XDECREF(id_obj);
+    if (PyErr_Occurred()) {
+        PyErr_Clear();
+        PyErr_SetString(PyExc_TypeError, "block() expects a PID, FirstOrder or Ramp instance");
+        return NULL;
+    }
+
+    FBRegistryEntry entry;
+    if (fb_registry_find((uint32_t)id, &entry) != 0 || entry.owner != slots[0]) {
+        PyErr_SetString(PyExc_TypeError, "block() expects a PID, FirstOrder or Ramp instance");
+        return NULL;
+    }
+
+    const char* key = entry.name;
+    if (slots[1] && slots[1] != Py_None) {
+        key = PyUnicode_AsUTF8(slots[1]);
+        if (!key) {
+            return NULL;
+        }
+    }
+    if (!key[0]) {
+        PyErr_SetString(PyExc_ValueError, "block has no name: set fb.name or pass key=");
+        return NULL;
+    }
+
+    int rc = fb_retain_add_block(self->retain, key, entry.type, entry.block);
+    if (rc < 0) {
+        PyErr_Format(PyExc_ValueError,
+                     "cannot retain '%s': duplicate key, stateless block or retain file full",
+                     key);
+        return NULL;
+    }
+    if (PyList_Append(self->blocks, slots[0]) < 0) {
+        return NULL;
+    }
+
+    return PyBool_FromLong(rc);
+}
+
+// var(key, initial=0.0) -> RetainVar
+static PyObject* Retain_var(RetainObject* self, PyObject* const* args, Py_ssize_t nargs,
+                            PyObject* kwnames) {
+    static const char* const kwlist[] = {"key", "initial", NULL};
+    PyObject* slots[2] = {NULL, NULL};
+    double initial = 0.0;
+
+    if (Retain_check_open(self) != 0 ||
+        fastcall_unpack("var", args, nargs, kwnames, kwlist, 1, slots) != 0 ||
+        (slots[1] && fastcall_as_double(slots[1], &initial) != 0)) {
+        return NULL;
+    }
+    const char* key = PyUnicode_AsUTF8(slots[0]);
+    if (!key) {
+        return NULL;
+    }
+
+    RetainVarObject* var = PyObject_New(RetainVarObject, &RetainVarType);
+    if (!var) {
+        return NULL;
+    }
+    var->owner = NULL;
+    var->key = NULL;
+
+    var->cell = fb_retain_add_var(self->retain, key, initial, &var->restored);
+    if (!var->cell) {
+        Py_DECREF(var);
+        PyErr_Format(PyExc_ValueError, "cannot retain '%s': duplicate key or retain file full",
+                     key);
+        return NULL;
+    }
+
+    Py_INCREF(self);
+    var->owner = self;
+    Py_INCREF(slots[0]);
+    var->key = slots[0];
+    return (PyObject*)var;
+}
+
+// checkpoint()：捕获当前值到暂存区（不做 I/O）
+static PyObject* Retain_checkpoint(RetainObject* self, PyObject* Py_UNUSED(args)) {
+    if (Retain_check_open(self) != 0) {
+        return NULL;
+    }
+    fb_retain_capture(self->retain);
+    Py_RETURN_NONE;
+}
+
+// start(period_ms=100)：启动后台写线程
+static PyObject* Retain_start(RetainObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    double period_ms = 100.0;
+
+    if (Retain_check_open(self) != 0 || fastcall_check_nargs("start", nargs, 0, 1) != 0 ||
+        (nargs == 1 && fastcall_as_double(args[0], &period_ms) != 0)) {
+        return NULL;
+    }
+    if (period_ms < 1.0) {
+        PyErr_SetString(PyExc_ValueError, "period_ms must be >= 1");
+        return NULL;
+    }
+    if (fb_retain_start(self->retain, (int)period_ms) != 0) {
+        PyErr_SetString(PyExc_RuntimeError, "保持数据写线程启动失败或已启动");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// flush()：捕获并同步写盘
+static PyObject* Retain_flush(RetainObject* self, PyObject* Py_UNUSED(args)) {
+    int rc;
+
+    if (Retain_check_open(self) != 0) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    rc = fb_retain_flush(self->retain);
+    Py_END_ALLOW_THREADS
+    if (rc != 0) {
+        PyErr_SetString(PyExc_OSError, "保持数据写盘失败");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// close()：停止写线程并写入最终检查点
+static PyObject* Retain_close(RetainObject* self, PyObject* Py_UNUSED(args)) {
+    Retain_close_store(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Retain_get_stats(RetainObject* self, void* Py_UNUSED(closure)) {
+    FBRetainStats stats;
+
+    if (Retain_check_open(self) != 0) {
+        return NULL;
+    }
+    fb_retain_get_stats(self->retain, &stats);
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:n,s:n,s:n}",
+                         "captures", (unsigned long long)stats.captures,
+                         "skipped", (unsigned long long)stats.skipped,
+                         "writes", (unsigned long long)stats.writes,
+                         "sequence", (unsigned long long)stats.sequence,
+                         "used", (Py_ssize_t)stats.used,
+                         "size", (Py_ssize_t)stats.bank_size,
+                         "items", (Py_ssize_t)stats.item_count);
+}
+
+static PyObject* Retain_get_restored(RetainObject* self, void* Py_UNUSED(closure)) {
+    FBRetainStats stats;
+
+    if (Retain_check_open(self) != 0) {
+        return NULL;
+    }
+    fb_retain_get_stats(self->retain, &stats);
+    return PyBool_FromLong(stats.restored);
+}
+
+static PyObject* Retain_get_closed(RetainObject* self, void* Py_UNUSED(closure)) {
+    return PyBool_FromLong(self->retain == NULL);
+}
+
+// _capsule -> PyCapsule(FBRetain*)，供运行时在 C 中每周期捕获
+static PyObject* Retain_get_capsule(RetainObject* self, void* Py_UNUSED(closure)) {
+    if (Retain_check_open(self) != 0) {
+        return NULL;
+    }
+    return PyCapsule_New(self->retain, FB_RETAIN_CAPSULE_NAME, NULL);
+}
+
+static PyMethodDef Retain_methods[] = {
+    {"block", (PyCFunction)(void(*)(void))Retain_block, METH_FASTCALL | METH_KEYWORDS,
+     "block(fb, key=None) -> bool: retain the state of a PID/FirstOrder/Ramp"},
+    {"var", (PyCFunction)(void(*)(void))Retain_var, METH_FASTCALL | METH_KEYWORDS,
+     "var(key, initial=0.0) -> RetainVar: declare a retained variable"},
+    {"checkpoint", (PyCFunction)Retain_checkpoint, METH_NOARGS,
+     "Capture current values into the staging buffer (no I/O)"},
+    {"start", (PyCFunction)(void(*)(void))Retain_start, METH_FASTCALL,
+     "start(period_ms=100): start the background writer"},
+    {"flush", (PyCFunction)Retain_flush, METH_NOARGS,
+     "Capture and write a checkpoint synchronously"},
+    {"close", (PyCFunction)Retain_close, METH_NOARGS,
+     "Stop the writer, write a final checkpoint and close the file"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef Retain_getset[] = {
+    {"stats", (getter)Retain_get_stats, NULL, "检查点统计", NULL},
+    {"restored", (getter)Retain_get_restored, NULL, "打开时是否读取到有效检查点", NULL},
+    {"closed", (getter)Retain_get_closed, NULL, "是否已关闭", NULL},
+    {"_capsule", (getter)Retain_get_capsule, NULL, "底层 FBRetain 指针（运行时内部使用）",
+     NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+PyTypeObject RetainType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.Retain",
+    .tp_doc = "Retain(path, size=0): memory-mapped RETAIN checkpoint file",
+    .tp_basicsize = sizeof(RetainObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = Retain_new,
+    .tp_dealloc = (destructor)Retain_dealloc,
+    .tp_methods = Retain_methods,
+    .tp_getset = Retain_getset,
+};
+
+static void RetainVar_dealloc(RetainVarObject* self) {
+    Py_XDECREF(self->key);
+    Py_XDECREF(self->owner);
+    PyObject_Free(self);
+}
+
+static int RetainVar_check(RetainVarObject* self) {
+    return Retain_check_open(self->owner);
+}
+
+static PyObject* RetainVar_get_value(RetainVarObject* self, void* Py_UNUSED(closure)) {
+    if (RetainVar_check(self) != 0) {
+        return NULL;
+    }
+    return PyFloat_FromDouble(*self->cell);
+}
+
+static int RetainVar_set_value(RetainVarObject* self, PyObject* value, void* Py_UNUSED(closure)) {
+    double v;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "Cannot delete retained value");
+        return -1;
+    }
+    if (RetainVar_check(self) != 0 || fastcall_as_double(value, &v) != 0) {
+        return -1;
+    }
+    *self->cell = v;
+    return 0;
+}
+
+static PyObject* RetainVar_get_key(RetainVarObject* self, void* Py_UNUSED(closure)) {
+    return Py_NewRef(self->key);
+}
+
+static PyObject* RetainVar_get_restored(RetainVarObject* self, void* Py_UNUSED(closure)) {
+    return PyBool_FromLong(self->restored);
+}
+
+static PyObject* RetainVar_repr(RetainVarObject* self) {
+    if (!self->owner->retain) {
+        return PyUnicode_FromFormat("<RetainVar %R (closed)>", self->key);
+    }
+    PyObject* value = PyFloat_FromDouble(*self->cell);
+    if (!value) {
+        return NULL;
+    }
+    PyObject* repr = PyUnicode_FromFormat("<RetainVar %R = %R>", self->key, value);
+    Py_DECREF(value);
+    return repr;
+}
+
+static PyGetSetDef RetainVar_getset[] = {
+    {"value", (getter)RetainVar_get_value, (setter)RetainVar_set_value, "当前值", NULL},
+    {"key", (getter)RetainVar_get_key, NULL, "变量名", NULL},
+    {"restored", (getter)RetainVar_get_restored, NULL, "是否从检查点恢复", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+PyTypeObject RetainVarType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.RetainVar",
+    .tp_doc = "Retained variable created by Retain.var()",
+    .tp_basicsize = sizeof(RetainVarObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)RetainVar_dealloc,
+    .tp_repr = (reprfunc)RetainVar_repr,
+    .tp_getset = RetainVar_getset,
+};
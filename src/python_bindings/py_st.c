@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_st.c
+ * @brief 结构化文本程序 Python 绑定实现
+ *
+ * STProgram(source) 编译一次，之后每周期 run() 在 C 中执行字节码；
+ * 变量按名称读写（prog["level"] = 42.0），返回值按声明类型转换为 bool / int / float。
+ * 运行时通过 _capsule 取得底层 STProgram 指针，与 FBD 网络一样在 step() 后直接执行。
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_st.h"
+#include "py_fastcall.h"
+#include "py_view.h"
+#include <math.h>
+
+// STProgram Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    STProgram* prog;     // 编译后的程序
+    Py_ssize_t shape;    // 缓冲区导出用：变量个数
+    Py_ssize_t stride;
+} STProgramObject;
+
+static void STProgram_dealloc(STProgramObject* self) {
+    st_program_destroy(self->prog);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 构造：STProgram(source)，编译错误抛出 SyntaxError
+static PyObject* STProgram_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"source", NULL};
+    const char* source;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s:STProgram", kwlist, &source)) {
+        return NULL;
+    }
+
+    char error[ST_ERROR_MAX];
+    STProgram* prog = st_program_compile(source, error, sizeof(error));
+    if (!prog) {
+        PyErr_SetString(PyExc_SyntaxError, error);
+        return NULL;
+    }
+
+    STProgramObject* self = (STProgramObject*)type->tp_alloc(type, 0);
+    if (!self) {
+        st_program_destroy(prog);
+        return NULL;
+    }
+    self->prog = prog;
+    self->shape = (Py_ssize_t)prog->var_count;
+    self->stride = sizeof(double);
+    return (PyObject*)self;
+}
+
+// run(cycles=1)
+static PyObject* STProgram_run(STProgramObject* self, PyObject* const* args, Py_ssize_t nargs) {
+    Py_ssize_t cycles = 1;
+
+    if (fastcall_check_nargs("run", nargs, 0, 1) != 0) {
+        return NULL;
+    }
+    if (nargs == 1) {
+        cycles = PyLong_AsSsize_t(args[0]);
+        if (cycles == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (cycles < 0) {
+            PyErr_SetString(PyExc_ValueError, "cycles 必须 >= 0");
+            return NULL;
+        }
+    }
+
+    for (Py_ssize_t i = 0; i < cycles; i++) {
+        st_program_run(self->prog);
+    }
+    Py_RETURN_NONE;
+}
+
+// reset()
+static PyObject* STProgram_reset(STProgramObject* self, PyObject* Py_UNUSED(ignored)) {
+    st_program_reset(self->prog);
+    Py_RETURN_NONE;
+}
+
+// 按名称查找变量
+static int64_t STProgram_lookup(STProgramObject* self, PyObject* key) {
+    if (!PyUnicode_Check(key)) {
+        PyErr_SetString(PyExc_TypeError, "variable name must be str");
+        return -1;
+    }
+    const char* name = PyUnicode_AsUTF8(key);
+    if (!name) {
+        return -1;
+    }
+
+    int64_t index = st_program_find(self->prog, name);
+    if (index < 0) {
+        PyErr_SetObject(PyExc_KeyError, key);
+    }
+    return index;
+}
+
+// 按变量类型转换为 Python 对象
+static PyObject* STProgram_value(const STProgram* prog, size_t index) {
+    double v = prog->mem[index];
+    switch (prog->vars[index].type) {
+    case ST_TYPE_BOOL:
+        return PyBool_FromLong(v != 0.0);
+    case ST_TYPE_INT:
+        // 整数变量只有经 TRUNC / REAL_TO_INT 转换无穷大或 NaN 时才不是有限数
+        return isfinite(v) ? PyLong_FromDouble(v) : PyFloat_FromDouble(v);
+    default:
+        return PyFloat_FromDouble(v);
+    }
+}
+
+// prog[name]
+static PyObject* STProgram_subscript(STProgramObject* self, PyObject* key) {
+    int64_t index = STProgram_lookup(self, key);
+    if (index < 0) {
+        return NULL;
+    }
+    return STProgram_value(self->prog, (size_t)index);
+}
+
+// prog[name] = value（BOOL 取真值，整数向零截断）
+static int STProgram_ass_subscript(STProgramObject* self, PyObject* key, PyObject* value) {
+    if (!value) {
+        PyErr_SetString(PyExc_TypeError, "不能删除程序变量");
+        return -1;
+    }
+
+    double v;
+    int64_t index = STProgram_lookup(self, key);
+    if (index < 0 || fastcall_as_double(value, &v) != 0) {
+        return -1;
+    }
+
+    if (st_program_set(self->prog, (size_t)index, v) != 0) {
+        const STVar* var = &self->prog->vars[index];
+        if (var->kind == ST_VAR_CONSTANT) {
+            PyErr_Format(PyExc_ValueError, "'%s' is a constant", var->name);
+        } else {
+            PyErr_Format(PyExc_ValueError, "value out of range for integer variable '%s'",
+                         var->name);
+        }
+        return -1;
+    }
+    return 0;
+}
+
+static Py_ssize_t STProgram_length(STProgramObject* self) {
+    return (Py_ssize_t)self->prog->var_count;
+}
+
+// index(name) -> int，变量在缓冲区中的下标
+static PyObject* STProgram_index(STProgramObject* self, PyObject* name) {
+    int64_t index = STProgram_lookup(self, name);
+    if (index < 0) {
+        return NULL;
+    }
+    return PyLong_FromLongLong(index);
+}
+
+// 以元组返回指定类别的变量名；kinds 为类别位掩码
+static PyObject* STProgram_names(const STProgram* prog, unsigned kinds) {
+    PyObject* names = PyList_New(0);
+    if (!names) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < prog->var_count; i++) {
+        if (!(kinds & (1u << prog->vars[i].kind))) {
+            continue;
+        }
+        PyObject* name = PyUnicode_FromString(prog->vars[i].name);
+        if (!name || PyList_Append(names, name) != 0) {
+            Py_XDECREF(name);
+            Py_DECREF(names);
+            return NULL;
+        }
+        Py_DECREF(name);
+    }
+
+    PyObject* tuple = PyList_AsTuple(names);
+    Py_DECREF(names);
+    return tuple;
+}
+
+static PyObject* STProgram_get_names(STProgramObject* self, void* closure) {
+    return STProgram_names(self->prog, (unsigned)(uintptr_t)closure);
+}
+
+// disassemble() -> str
+static PyObject* STProgram_disassemble(STProgramObject* self, PyObject* Py_UNUSED(ignored)) {
+    const STProgram* prog = self->prog;
+    size_t const_base = prog->var_count;
+    size_t temp_base = prog->var_count + prog->const_count;
+    PyObject* lines = PyList_New(0);
+    if (!lines) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < prog->code_count; i++) {
+        const STInsn* insn = &prog->code[i];
+        uint32_t operands[3] = {insn->a, insn->b, insn->c};
+        int argc = 1;
+        char text[256];
+        int n;
+
+        switch (insn->op) {
+        case ST_OP_JMP:
+            n = snprintf(text, sizeof(text), "%4zu  JMP    %u", i, insn->d);
+            argc = 0;
+            break;
+        case ST_OP_JZ:
+            n = snprintf(text, sizeof(text), "%4zu  JZ     %u, ", i, insn->d);
+            break;
+        default:
+            argc = insn->op <= ST_OP_NOT || (insn->op >= ST_OP_ABS && insn->op <= ST_OP_ROUND)
+                       ? 1 : (insn->op == ST_OP_LIMIT || insn->op == ST_OP_SEL) ? 3 : 2;
+            if (insn->d < const_base) {
+                n = snprintf(text, sizeof(text), "%4zu  %-6s %s, ", i,
+                             st_op_name((STOp)insn->op), prog->vars[insn->d].name);
+            } else {
+                n = snprintf(text, sizeof(text), "%4zu  %-6s t%zu, ", i,
+                             st_op_name((STOp)insn->op), (size_t)insn->d - temp_base);
+            }
+            break;
+        }
+
+        for (int k = 0; k < argc && n > 0 && (size_t)n < sizeof(text); k++) {
+            uint32_t ref = operands[k];
+            const char* sep = k + 1 < argc ? ", " : "";
+            if (ref < const_base) {
+                n += snprintf(text + n, sizeof(text) - (size_t)n, "%s%s",
+                              prog->vars[ref].name, sep);
+            } else if (ref < temp_base) {
+                n += snprintf(text + n, sizeof(text) - (size_t)n, "%.17g%s",
+                              prog->mem[ref], sep);
+            } else {
+                n += snprintf(text + n, sizeof(text) - (size_t)n, "t%zu%s",
+                              (size_t)ref - temp_base, sep);
+            }
+        }
+
+        PyObject* line = PyUnicode_FromString(text);
+        if (!line || PyList_Append(lines, line) != 0) {
+            Py_XDECREF(line);
+            Py_DECREF(lines);
+            return NULL;
+        }
+        Py_DECREF(line);
+    }
+
+    PyObject* sep = PyUnicode_FromString("\n");
+    PyObject* result = sep ? PyUnicode_Join(sep, lines) : NULL;
+    Py_XDECREF(sep);
+    Py_DECREF(lines);
+    return result;
+}
+
+// instructions -> int
+static PyObject* STProgram_get_instructions(STProgramObject* self, void* Py_UNUSED(closure)) {
+    return PyLong_FromSize_t(self->prog->code_count);
+}
+
+// runs -> int
+static PyObject* STProgram_get_runs(STProgramObject* self, void* Py_UNUSED(closure)) {
+    return PyLong_FromUnsignedLongLong(self->prog->runs);
+}
+
+// built -> True，与 Network 一致，供 plcopen.network.attach() 判断
+static PyObject* STProgram_get_built(STProgramObject* Py_UNUSED(self),
+                                     void* Py_UNUSED(closure)) {
+    Py_RETURN_TRUE;
+}
+
+// _capsule -> PyCapsule(STProgram*)，供运行时在 C 中直接执行程序
+static PyObject* STProgram_get_capsule(STProgramObject* self, void* Py_UNUSED(closure)) {
+    return PyCapsule_New(self->prog, ST_PROGRAM_CAPSULE_NAME, NULL);
+}
+
+static int STProgram_getbuffer(STProgramObject* self, Py_buffer* view, int flags) {
+    return fb_export_doubles(view, (PyObject*)self, self->prog->mem, &self->shape,
+                             &self->stride, flags);
+}
+
+#define ST_KINDS(k) ((void*)(uintptr_t)(k))
+
+static PyMethodDef STProgram_methods[] = {
+    {"run", (PyCFunction)(void(*)(void))STProgram_run, METH_FASTCALL,
+     "执行程序\n\n参数:\n  cycles: 连续执行的周期数（默认 1）"},
+    {"reset", (PyCFunction)STProgram_reset, METH_NOARGS, "所有变量恢复初值"},
+    {"index", (PyCFunction)STProgram_index, METH_O,
+     "变量在缓冲区中的下标\n\n参数:\n  name: 变量名（不区分大小写）"},
+    {"disassemble", (PyCFunction)STProgram_disassemble, METH_NOARGS, "字节码反汇编文本"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef STProgram_getset[] = {
+    {"variables", (getter)STProgram_get_names, NULL, "全部变量名（声明顺序，即缓冲区顺序）",
+     ST_KINDS(0x1f)},
+    {"inputs", (getter)STProgram_get_names, NULL, "VAR_INPUT 和 VAR_IN_OUT 变量名",
+     ST_KINDS((1u << ST_VAR_INPUT) | (1u << ST_VAR_IN_OUT))},
+    {"outputs", (getter)STProgram_get_names, NULL, "VAR_OUTPUT 和 VAR_IN_OUT 变量名",
+     ST_KINDS((1u << ST_VAR_OUTPUT) | (1u << ST_VAR_IN_OUT))},
+    {"instructions", (getter)STProgram_get_instructions, NULL, "字节码指令条数", NULL},
+    {"runs", (getter)STProgram_get_runs, NULL, "reset 以来的执行次数", NULL},
+    {"built", (getter)STProgram_get_built, NULL, "总是 True（编译即完成）", NULL},
+    {"_capsule", (getter)STProgram_get_capsule, NULL, "底层 STProgram 指针（运行时内部使用）",
+     NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMappingMethods STProgram_as_mapping = {
+    .mp_length = (lenfunc)STProgram_length,
+    .mp_subscript = (binaryfunc)STProgram_subscript,
+    .mp_ass_subscript = (objobjargproc)STProgram_ass_subscript,
+};
+
+static PyBufferProcs STProgram_as_buffer = {
+    .bf_getbuffer = (getbufferproc)STProgram_getbuffer,
+    .bf_releasebuffer = NULL,
+};
+
+// 类型定义
+PyTypeObject STProgramType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.STProgram",
+    .tp_doc = "结构化文本（IEC 61131-3 ST 子集）程序\n\n"
+              "STProgram(source)\n\n"
+              "编译 VAR 声明、赋值和 IF 语句为字节码，每周期 run() 在 C 中执行；\n"
+              "变量通过 prog[\"名称\"] 读写，对象的只读缓冲区为全部变量（声明顺序）。\n"
+              "语法错误抛出 SyntaxError，信息包含行号和列号。",
+    .tp_basicsize = sizeof(STProgramObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = STProgram_new,
+    .tp_dealloc = (destructor)STProgram_dealloc,
+    .tp_methods = STProgram_methods,
+    .tp_getset = STProgram_getset,
+    .tp_as_mapping = &STProgram_as_mapping,
+    .tp_as_buffer = &STProgram_as_buffer,
+};
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_view.c
+ * @brief 功能块参数/状态的零拷贝只读视图实现
+ */
+
+#include "py_view.h"
+#include <string.h>
+
+typedef struct {
+    PyObject_HEAD
+    PyObject* owner;              // 所属功能块对象
+    FBViewResolve resolve;        // 字段地址解析函数
+    const char* const* fields;    // 字段名
+    Py_ssize_t n;                 // 字段个数
+    Py_ssize_t shape;             // 缓冲区形状（= n）
+    Py_ssize_t stride;            // 缓冲区步长（= sizeof(double)）
+} FBViewObject;
+
+static double* FBView_data(FBViewObject* self) {
+    double* data = self->resolve(self->owner);
+    if (!data) {
+        PyErr_SetString(PyExc_RuntimeError, "功能块实例未初始化");
+    }
+    return data;
+}
+
+PyObject* fb_view_new(PyObject* owner, FBViewResolve resolve,
+                      const char* const* fields, Py_ssize_t n) {
+    FBViewObject* self = PyObject_New(FBViewObject, &FBViewType);
+    if (!self) {
+        return NULL;
+    }
+
+    Py_INCREF(owner);
+    self->owner = owner;
+    self->resolve = resolve;
+    self->fields = fields;
+    self->n = n;
+    self->shape = n;
+    self->stride = sizeof(double);
+
+    return (PyObject*)self;
+}
+
+PyObject* fb_fields_to_dict(const char* const* fields, const double* values, Py_ssize_t n) {
+    PyObject* dict = PyDict_New();
+    if (!dict) {
+        return NULL;
+    }
+
+    // PyDict_SetItemString 不窃取引用，值对象需要自行释放
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject* value = PyFloat_FromDouble(values[i]);
+        if (!value || PyDict_SetItemString(dict, fields[i], value) < 0) {
+            Py_XDECREF(value);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+
+    return dict;
+}
+
+int fb_get_reals(PyObject* obj, const char* name, Py_ssize_t n, int writable,
+                 Py_buffer* view, double* fallback, void** data, int* f32) {
+    view->obj = NULL;
+    if (f32) {
+        *f32 = 0;
+    }
+
+    if (PyObject_CheckBuffer(obj)) {
+        int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+        if (PyObject_GetBuffer(obj, view, flags) != 0) {
+            return -1;
+        }
+
+        const char* fmt = view->format;
+        if ((fmt[0] == '@' || fmt[0] == '=') && (fmt[1] == 'd' || fmt[1] == 'f')) {
+            fmt++;
+        }
+        int is_f32 = f32 && strcmp(fmt, "f") == 0;
+        size_t size = is_f32 ? sizeof(float) : sizeof(double);
+        if ((!is_f32 && strcmp(fmt, "d") != 0) || view->len != n * (Py_ssize_t)size) {
+            PyErr_Format(PyExc_ValueError, f32 ? "%s must be a float64 or float32 array of "
+                         "length %zd" : "%s must be a float64 array of length %zd", name, n);
+            PyBuffer_Release(view);
+            return -1;
+        }
+
+        if (f32) {
+            *f32 = is_f32;
+        }
+        *data = view->buf;
+        return 0;
+    }
+
+    if (writable || !fallback) {
+        PyErr_Format(PyExc_TypeError, "%s must be a writable float64 buffer", name);
+        return -1;
+    }
+
+    PyObject* seq = PySequence_Fast(obj, "expected a float64 buffer or a sequence of numbers");
+    if (!seq) {
+        return -1;
+    }
+    if (PySequence_Fast_GET_SIZE(seq) != n) {
+        PyErr_Format(PyExc_ValueError, "%s must have length %zd", name, n);
+        Py_DECREF(seq);
+        return -1;
+    }
+
+    PyObject** items = PySequence_Fast_ITEMS(seq);
+    for (Py_ssize_t i = 0; i < n; i++) {
+        double value = PyFloat_AsDouble(items[i]);
+        if (value == -1.0 && PyErr_Occurred()) {
+            Py_DECREF(seq);
+            return -1;
+        }
+        fallback[i] = value;
+    }
+    Py_DECREF(seq);
+
+    *data = fallback;
+    return 0;
+}
+
+int fb_get_doubles(PyObject* obj, const char* name, Py_ssize_t n, int writable,
+                   Py_buffer* view, double* fallback, double** data) {
+    return fb_get_reals(obj, name, n, writable, view, fallback, (void**)data, NULL);
+}
+
+int fb_export_doubles(Py_buffer* view, PyObject* owner, double* data,
+                      Py_ssize_t* shape, Py_ssize_t* stride, int flags) {
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "buffer is read-only");
+        return -1;
+    }
+
+    Py_INCREF(owner);
+    view->obj = owner;
+    view->buf = data;
+    view->len = *shape * (Py_ssize_t)sizeof(double);
+    view->readonly = 1;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? "d" : NULL;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? stride : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+
+    return 0;
+}
+
+static void FBView_dealloc(FBViewObject* self) {
+    Py_XDECREF(self->owner);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static Py_ssize_t FBView_length(FBViewObject* self) {
+    return self->n;
+}
+
+static PyObject* FBView_item(FBViewObject* self, Py_ssize_t i) {
+    if (i < 0 || i >= self->n) {
+        PyErr_SetString(PyExc_IndexError, "视图下标越界");
+        return NULL;
+    }
+
+    double* data = FBView_data(self);
+    return data ? PyFloat_FromDouble(data[i]) : NULL;
+}
+
+// 按字段名读取（view.Kp），其余属性走通用查找
+static PyObject* FBView_getattro(FBViewObject* self, PyObject* name) {
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        if (PyUnicode_CompareWithASCIIString(name, self->fields[i]) == 0) {
+            double* data = FBView_data(self);
+            return data ? PyFloat_FromDouble(data[i]) : NULL;
+        }
+    }
+
+    return PyObject_GenericGetAttr((PyObject*)self, name);
+}
+
+static int FBView_getbuffer(FBViewObject* self, Py_buffer* view, int flags) {
+    double* data = FBView_data(self);
+    if (!data) {
+        return -1;
+    }
+
+    return fb_export_doubles(view, (PyObject*)self, data, &self->shape, &self->stride, flags);
+}
+
+// to_dict() -> dict
+static PyObject* FBView_to_dict(FBViewObject* self, PyObject* Py_UNUSED(ignored)) {
+    double* data = FBView_data(self);
+    return data ? fb_fields_to_dict(self->fields, data, self->n) : NULL;
+}
+
+// fields -> tuple
+static PyObject* FBView_get_fields(FBViewObject* self, void* Py_UNUSED(closure)) {
+    PyObject* tuple = PyTuple_New(self->n);
+    if (!tuple) {
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < self->n; i++) {
+        PyObject* name = PyUnicode_FromString(self->fields[i]);
+        if (!name) {
+            Py_DECREF(tuple);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(tuple, i, name);
+    }
+
+    return tuple;
+}
+
+static PyObject* FBView_repr(FBViewObject* self) {
+    PyObject* dict = FBView_to_dict(self, NULL);
+    if (!dict) {
+        return NULL;
+    }
+
+    PyObject* repr = PyUnicode_FromFormat("FBView(%R)", dict);
+    Py_DECREF(dict);
+    return repr;
+}
+
+static PySequenceMethods FBView_as_sequence = {
+    .sq_length = (lenfunc)FBView_length,
+    .sq_item = (ssizeargfunc)FBView_item,
+};
+
+static PyBufferProcs FBView_as_buffer = {
+    .bf_getbuffer = (getbufferproc)FBView_getbuffer,
+    .bf_releasebuffer = NULL,
+};
+
+static PyMethodDef FBView_methods[] = {
+    {"to_dict", (PyCFunction)FBView_to_dict, METH_NOARGS,
+     "复制为 dict\n\n返回:\n  dict: {字段名: 值}"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef FBView_getset[] = {
+    {"fields", (getter)FBView_get_fields, NULL, "字段名元组", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+PyTypeObject FBViewType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.FBView",
+    .tp_doc = "功能块参数/状态的零拷贝只读视图\n\n"
+              "支持按名称（view.Kp）、按下标访问和缓冲区协议（格式 'd'）。",
+    .tp_basicsize = sizeof(FBViewObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)FBView_dealloc,
+    .tp_repr = (reprfunc)FBView_repr,
+    .tp_getattro = (getattrofunc)FBView_getattro,
+    .tp_as_sequence = &FBView_as_sequence,
+    .tp_as_buffer = &FBView_as_buffer,
+    .tp_methods = FBView_methods,
+    .tp_getset = FBView_getset,
+};
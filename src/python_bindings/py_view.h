@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_view.h
+ * @brief 功能块参数/状态的零拷贝只读视图
+ *
+ * FBView 直接引用功能块内部连续存放的 double 字段，支持按名称访问
+ * （view.Kp）、按下标访问以及缓冲区协议（格式 "d"，可直接交给
+ * memoryview / numpy），读取时不分配新对象，适合每周期记录状态。
+ */
+
+#ifndef PY_VIEW_H
+#define PY_VIEW_H
+
+#include <Python.h>
+
+/**
+ * @brief 从视图所属对象取得字段起始地址
+ * @return 字段数组首地址；功能块未初始化时返回 NULL
+ */
+typedef double* (*FBViewResolve)(PyObject* owner);
+
+extern PyTypeObject FBViewType;
+
+/**
+ * @brief 创建视图
+ * @param owner 所属功能块对象（视图持有其引用）
+ * @param resolve 字段地址解析函数
+ * @param fields 字段名列表（静态存储，长度为 n）
+ * @param n 字段个数
+ * @return 新引用，失败返回 NULL
+ */
+PyObject* fb_view_new(PyObject* owner, FBViewResolve resolve,
+                      const char* const* fields, Py_ssize_t n);
+
+/**
+ * @brief 由字段名和值构建 dict（兼容旧的 get_params()/get_state() 接口）
+ * @return 新引用，失败返回 NULL
+ */
+PyObject* fb_fields_to_dict(const char* const* fields, const double* values, Py_ssize_t n);
+
+/**
+ * @brief 取得长度为 n 的 float64 数组
+ * @param obj 缓冲区对象（零拷贝）或普通序列（复制到 fallback，仅限只读）
+ * @param name 参数名（用于错误信息）
+ * @param n 要求的元素个数
+ * @param writable 是否需要可写
+ * @param view 使用缓冲区时 view->obj 非 NULL，调用者需 PyBuffer_Release()
+ * @param fallback 序列输入的临时存储（长度 n，可写时可为 NULL）
+ * @param data 输出数组地址
+ * @return 0 成功，-1 失败（已设置异常）
+ */
+int fb_get_doubles(PyObject* obj, const char* name, Py_ssize_t n, int writable,
+                   Py_buffer* view, double* fallback, double** data);
+
+/**
+ * @brief 取得长度为 n 的 float64 或 float32 数组（参数同 fb_get_doubles()）
+ * @param f32 输出：1 表示缓冲区为 float32（格式 "f"，*data 为 float*），
+ *            0 表示 float64 缓冲区或复制到 fallback 的序列（*data 为 double*）
+ * @return 0 成功，-1 失败（已设置异常）
+ */
+int fb_get_reals(PyObject* obj, const char* name, Py_ssize_t n, int writable,
+                 Py_buffer* view, double* fallback, void** data, int* f32);
+
+/**
+ * @brief 以只读方式导出对象内部的 double 数组（bf_getbuffer 实现）
+ * @param view 待填充的缓冲区描述
+ * @param owner 导出对象
+ * @param data 数组地址
+ * @param shape 形状（指向对象内保存的元素个数）
+ * @param stride 步长（指向对象内保存的 sizeof(double)）
+ * @param flags 请求标志
+ * @return 0 成功，-1 失败（请求可写时）
+ */
+int fb_export_doubles(Py_buffer* view, PyObject* owner, double* data,
+                      Py_ssize_t* shape, Py_ssize_t* stride, int flags);
+
+#endif // PY_VIEW_H
@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_window.c
+ * @brief 滑动窗口滤波功能块（MovingAverage、MovingMedian、Slope）Python 绑定实现
+ */
+
+#include <Python.h>
+#include "../function_blocks/fb_window.h"
+#include "../function_blocks/fb_pool.h"
+#include "py_fastcall.h"
+#include "py_registry.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+// 三种窗口功能块共用的 Python 对象结构
+typedef struct {
+    PyObject_HEAD
+    FunctionBlock* fb;   // MovingAverageFB / MovingMedianFB / SlopeFB
+} WindowObject;
+
+static const char Window_uninit[] = "实例未初始化";
+
+// 解析窗口长度
+static int Window_parse_window(PyObject* obj, uint32_t min, uint32_t* window) {
+    long value = PyLong_AsLong(obj);
+    if (value == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (value < (long)min || value > (long)FB_WINDOW_MAX) {
+        PyErr_Format(PyExc_ValueError, "window must be in [%u, %u]", min, FB_WINDOW_MAX);
+        return -1;
+    }
+    *window = (uint32_t)value;
+    return 0;
+}
+
+static int Window_check_period(double period) {
+    if (!(period > 0.0 && period < 1e9)) {
+        PyErr_SetString(PyExc_ValueError, "period must be positive");
+        return -1;
+    }
+    return 0;
+}
+
+// 析构函数
+static void Window_dealloc(WindowObject* self) {
+    if (self->fb) {
+        switch (self->fb->type) {
+        case FB_TYPE_MOVING_AVERAGE:
+            moving_average_destroy((MovingAverageFB*)self->fb);
+            break;
+        case FB_TYPE_MOVING_MEDIAN:
+            moving_median_destroy((MovingMedianFB*)self->fb);
+            break;
+        default:
+            slope_destroy((SlopeFB*)self->fb);
+            break;
+        }
+    }
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// 创建 C 功能块；重复调用 __init__ 时换用新存储原地重新初始化，保持 ID 和名称
+static int Window_setup(WindowObject* self, FunctionBlockType type, uint32_t window,
+                        double period) {
+    if (!self->fb) {
+        switch (type) {
+        case FB_TYPE_MOVING_AVERAGE:
+            self->fb = (FunctionBlock*)moving_average_create(window);
+            break;
+        case FB_TYPE_MOVING_MEDIAN:
+            self->fb = (FunctionBlock*)moving_median_create(window);
+            break;
+        default:
+            self->fb = (FunctionBlock*)slope_create(window, period);
+            break;
+        }
+        if (!self->fb) {
+            PyErr_SetString(PyExc_MemoryError, "创建失败：实例池、附属存储区或注册表已满");
+            return -1;
+        }
+        fb_py_register_owner((PyObject*)self, self->fb);
+        return 0;
+    }
+
+    size_t size = type == FB_TYPE_MOVING_AVERAGE ? moving_average_storage_size(window)
+                  : type == FB_TYPE_MOVING_MEDIAN ? moving_median_storage_size(window)
+                                                  : slope_storage_size(window);
+    void* storage = fb_pool_storage_alloc(size);
+    if (!storage) {
+        PyErr_SetString(PyExc_MemoryError, "初始化失败：附属存储区不足");
+        return -1;
+    }
+
+    switch (type) {
+    case FB_TYPE_MOVING_AVERAGE: {
+        MovingAverageFB fresh;
+        moving_average_init(&fresh, window, storage);
+        fresh.storage = storage;
+        fb_pool_storage_free(((MovingAverageFB*)self->fb)->storage);
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+        break;
+    }
+    case FB_TYPE_MOVING_MEDIAN: {
+        MovingMedianFB fresh;
+        moving_median_init(&fresh, window, storage);
+        fresh.storage = storage;
+        fb_pool_storage_free(((MovingMedianFB*)self->fb)->storage);
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+        break;
+    }
+    default: {
+        SlopeFB fresh;
+        slope_init(&fresh, window, period, storage);
+        fresh.storage = storage;
+        fb_pool_storage_free(((SlopeFB*)self->fb)->storage);
+        fb_reinit(self->fb, &fresh, sizeof(fresh));
+        break;
+    }
+    }
+    return 0;
+}
+
+// 解析 (window[, period])；has_period 为 Slope
+static int Window_parse(const char* fname, PyObject* const* args, Py_ssize_t nargs,
+                        PyObject* kwnames, int has_period, uint32_t* window, double* period) {
+    static const char* const kwlist[] = {"window", "period", NULL};
+    static const char* const kwlist_window[] = {"window", NULL};
+    PyObject* slots[2] = {NULL, NULL};
+
+    if (fastcall_unpack(fname, args, nargs, kwnames, has_period ? kwlist : kwlist_window,
+                        has_period ? 2 : 1, slots) != 0 ||
+        Window_parse_window(slots[0], has_period ? 2 : 1, window) != 0) {
+        return -1;
+    }
+    if (has_period &&
+        (fastcall_as_double(slots[1], period) != 0 || Window_check_period(*period) != 0)) {
+        return -1;
+    }
+    return 0;
+}
+
+static FunctionBlockType Window_type_of(PyTypeObject* type);
+
+// vectorcall 构造
+static PyObject* Window_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf,
+                                   PyObject* kwnames) {
+    FunctionBlockType fb_type = Window_type_of((PyTypeObject*)type);
+    uint32_t window;
+    double period = 0.0;
+
+    if (Window_parse(((PyTypeObject*)type)->tp_name, args, PyVectorcall_NARGS(nargsf), kwnames,
+                     fb_type == FB_TYPE_SLOPE, &window, &period) != 0) {
+        return NULL;
+    }
+
+    WindowObject* self = (WindowObject*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    if (Window_setup(self, fb_type, window, period) != 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+// 构造函数：__init__(self, window) / Slope: __init__(self, window, period)
+static int Window_init(WindowObject* self, PyObject* args, PyObject* kwds) {
+    static const char* const kwlist[] = {"window", "period", NULL};
+    static const char* const kwlist_window[] = {"window", NULL};
+    FunctionBlockType fb_type = Window_type_of(Py_TYPE(self));
+    PyObject* window_obj;
+    uint32_t window;
+    double period = 0.0;
+
+    if (fb_type == FB_TYPE_SLOPE) {
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "Od", (char**)kwlist, &window_obj,
+                                         &period) ||
+            Window_check_period(period) != 0) {
+            return -1;
+        }
+    } else if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", (char**)kwlist_window,
+                                            &window_obj)) {
+        return -1;
+    }
+    if (Window_parse_window(window_obj, fb_type == FB_TYPE_SLOPE ? 2 : 1, &window) != 0) {
+        return -1;
+    }
+
+    return Window_setup(self, fb_type, window, period);
+}
+
+// compute(input) -> float
+static PyObject* Window_compute(WindowObject* self, PyObject* arg) {
+    double input;
+    double output;
+
+    if (fastcall_as_double(arg, &input) != 0) {
+        return NULL;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Window_uninit);
+        return NULL;
+    }
+
+    switch (self->fb->type) {
+    case FB_TYPE_MOVING_AVERAGE:
+        output = moving_average_compute((MovingAverageFB*)self->fb, input);
+        break;
+    case FB_TYPE_MOVING_MEDIAN:
+        output = moving_median_compute((MovingMedianFB*)self->fb, input);
+        break;
+    default:
+        output = slope_compute((SlopeFB*)self->fb, input);
+        break;
+    }
+    return PyFloat_FromDouble(output);
+}
+
+// reset()：清空窗口
+static PyObject* Window_reset(WindowObject* self, PyObject* Py_UNUSED(ignored)) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Window_uninit);
+        return NULL;
+    }
+
+    switch (self->fb->type) {
+    case FB_TYPE_MOVING_AVERAGE:
+        moving_average_reset((MovingAverageFB*)self->fb);
+        break;
+    case FB_TYPE_MOVING_MEDIAN:
+        moving_median_reset((MovingMedianFB*)self->fb);
+        break;
+    default:
+        slope_reset((SlopeFB*)self->fb);
+        break;
+    }
+    Py_RETURN_NONE;
+}
+
+// 只读属性：closure 为字段在各功能块结构中的偏移（三种结构中 window/count 偏移相同）
+_Static_assert(offsetof(MovingAverageFB, window) == offsetof(MovingMedianFB, window) &&
+               offsetof(MovingAverageFB, window) == offsetof(SlopeFB, window) &&
+               offsetof(MovingAverageFB, count) == offsetof(MovingMedianFB, count) &&
+               offsetof(MovingAverageFB, count) == offsetof(SlopeFB, count),
+               "窗口功能块的 window/count 必须位于相同偏移");
+
+static PyObject* Window_get_u32(WindowObject* self, void* closure) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Window_uninit);
+        return NULL;
+    }
+    return PyLong_FromUnsignedLong(*(uint32_t*)((char*)self->fb + (size_t)closure));
+}
+
+static PyObject* Window_get_double(WindowObject* self, void* closure) {
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Window_uninit);
+        return NULL;
+    }
+    return PyFloat_FromDouble(*(double*)((char*)self->fb + (size_t)closure));
+}
+
+// Slope.period（可写）
+static int Slope_set_period(WindowObject* self, PyObject* value, void* Py_UNUSED(closure)) {
+    double period;
+
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "不能删除 period");
+        return -1;
+    }
+    if (!self->fb) {
+        PyErr_SetString(PyExc_RuntimeError, Window_uninit);
+        return -1;
+    }
+    if (fastcall_as_double(value, &period) != 0) {
+        return -1;
+    }
+    if (slope_set_period((SlopeFB*)self->fb, period) != 0) {
+        PyErr_SetString(PyExc_ValueError, "period must be positive");
+        return -1;
+    }
+    return 0;
+}
+
+#define WINDOW_COMMON_GETSET(FBType)                                                      \
+    {"window", (getter)Window_get_u32, NULL, "窗口长度（样本数，只读）",                  \
+     (void*)offsetof(FBType, window)},                                                    \
+    {"count", (getter)Window_get_u32, NULL, "窗口内现有样本数（只读）",                   \
+     (void*)offsetof(FBType, count)},                                                     \
+    {"output", (getter)Window_get_double, NULL, "最近一次输出（只读）",                   \
+     (void*)offsetof(FBType, output)},                                                    \
+    FB_REGISTRY_GETSET(WindowObject, fb)
+
+static PyGetSetDef MovingAverage_getset[] = {
+    WINDOW_COMMON_GETSET(MovingAverageFB),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyGetSetDef MovingMedian_getset[] = {
+    WINDOW_COMMON_GETSET(MovingMedianFB),
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyGetSetDef Slope_getset[] = {
+    WINDOW_COMMON_GETSET(SlopeFB),
+    {"period", (getter)Window_get_double, (setter)Slope_set_period, "采样周期（秒）",
+     (void*)offsetof(SlopeFB, period)},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef MovingAverage_methods[] = {
+    {"compute", (PyCFunction)Window_compute, METH_O,
+     "写入一个样本并返回窗口平均值\n\n参数:\n  input: 输入信号\n\n返回:\n  float: 平均值"},
+    {"reset", (PyCFunction)Window_reset, METH_NOARGS, "清空窗口"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyMethodDef MovingMedian_methods[] = {
+    {"compute", (PyCFunction)Window_compute, METH_O,
+     "写入一个样本并返回窗口中值\n\n参数:\n  input: 输入信号\n\n返回:\n  float: 中值"},
+    {"reset", (PyCFunction)Window_reset, METH_NOARGS, "清空窗口"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyMethodDef Slope_methods[] = {
+    {"compute", (PyCFunction)Window_compute, METH_O,
+     "写入一个样本并返回窗口内的最小二乘斜率\n\n参数:\n  input: 输入信号\n\n"
+     "返回:\n  float: 变化率（单位/秒），样本少于 2 个时为 0"},
+    {"reset", (PyCFunction)Window_reset, METH_NOARGS, "清空窗口"},
+    {NULL, NULL, 0, NULL}
+};
+
+// 类型定义
+PyTypeObject MovingAverageType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.MovingAverage",
+    .tp_doc = "滑动平均功能块\n\nMovingAverage(window)：最近 window 个样本的平均值，"
+              "维护累加和，每周期 O(1)。",
+    .tp_basicsize = sizeof(WindowObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Window_init,
+    .tp_dealloc = (destructor)Window_dealloc,
+    .tp_methods = MovingAverage_methods,
+    .tp_getset = MovingAverage_getset,
+    .tp_vectorcall = Window_vectorcall,
+};
+
+PyTypeObject MovingMedianType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.MovingMedian",
+    .tp_doc = "滑动中值功能块\n\nMovingMedian(window)：最近 window 个样本的中值，"
+              "用于抑制尖峰干扰，双堆结构每周期 O(log window)。",
+    .tp_basicsize = sizeof(WindowObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Window_init,
+    .tp_dealloc = (destructor)Window_dealloc,
+    .tp_methods = MovingMedian_methods,
+    .tp_getset = MovingMedian_getset,
+    .tp_vectorcall = Window_vectorcall,
+};
+
+PyTypeObject SlopeType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "plcopen_c.Slope",
+    .tp_doc = "变化率功能块\n\nSlope(window, period)：最近 window 个样本对时间的最小二乘斜率"
+              "（单位/秒），每周期 O(1)。",
+    .tp_basicsize = sizeof(WindowObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Window_init,
+    .tp_dealloc = (destructor)Window_dealloc,
+    .tp_methods = Slope_methods,
+    .tp_getset = Slope_getset,
+    .tp_vectorcall = Window_vectorcall,
+};
+
+// 子类也按基类确定功能块类型
+static FunctionBlockType Window_type_of(PyTypeObject* type) {
+    if (PyType_IsSubtype(type, &MovingAverageType)) {
+        return FB_TYPE_MOVING_AVERAGE;
+    }
+    if (PyType_IsSubtype(type, &MovingMedianType)) {
+        return FB_TYPE_MOVING_MEDIAN;
+    }
+    return FB_TYPE_SLOPE;
+}
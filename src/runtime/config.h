@@ -30,6 +30,45 @@
 #define CONFIG_H
 
 #include "logger.h"
+#include <stddef.h>
+
+// 运行模式
+typedef enum {
+    RUNTIME_MODE_PYTHON,   // 嵌入 Python，周期调用用户脚本（默认）
+    RUNTIME_MODE_C         // 纯 C：不初始化解释器，只运行配置中声明的网络
+} RuntimeMode;
+
+// 输入录制模式
+typedef enum {
+    RECORD_MODE_OFF,       // 不录制（默认）
+    RECORD_MODE_RECORD,    // 录制每周期的输入、输出和周期时间
+    RECORD_MODE_REPLAY     // 按虚拟时间回放录制文件并核对输出
+} RecordMode;
+
+// 网络声明条目类型
+typedef enum {
+    NETWORK_DECL_INPUT,        // 网络输入：name = 初值
+    NETWORK_DECL_BLOCK,        // 功能块：name = {type: ..., 参数: 值, ...}
+    NETWORK_DECL_CONNECTION,   // 连线：value = "src -> dst"
+    NETWORK_DECL_OUTPUT        // 网络输出：name = 源地址
+} NetworkDeclKind;
+
+// network 节中的一条声明（原样保存，启动时编译为 FBNetwork）
+typedef struct {
+    NetworkDeclKind kind;
+    char name[32];
+    char value[384];
+    int line;                  // 配置文件行号（报错用）
+} NetworkDecl;
+
+// network 节配置
+typedef struct {
+    NetworkDecl* decls;        // 按出现顺序保存的声明
+    size_t count;
+    size_t capacity;
+    char phase[16];            // before_step / after_step（Python 模式下的执行时机）
+    int period_ms;             // 执行周期（毫秒），0 表示每个控制周期
+} NetworkConfig;
 
 // 运行时配置结构体
 typedef struct {
@@ -37,9 +76,11 @@ typedef struct {
     int cycle_period_ms;              // 控制周期（毫秒）
     char script_path[512];            // Python 脚本路径
     int timeout_threshold_percent;    // 超时阈值（周期的百分比）
+    RuntimeMode mode;                 // 运行模式
 
     // 日志配置
     LogConfig log_config;
+    int journal_flush_ms;             // 功能块事件汇总间隔（毫秒）
 
     // 调试配置
     int debug_enabled;                // 是否启用调试
@@ -50,6 +91,26 @@ typedef struct {
     // 性能配置
     int cpu_affinity;                 // CPU 亲和性（-1 表示不绑定）
     int max_function_blocks;          // 最大功能块数量
+    int fb_storage_kb;                // 功能块附属存储区大小（KB，0 表示按功能块数量估算）
+
+    // 剖析配置
+    int profiler_enabled;             // 启动时是否开启 step() 剖析
+    char profiler_output[256];        // 折叠栈输出文件路径
+    int profiler_max_nodes;           // 调用上下文树节点上限
+    char fb_timing_output[256];       // 功能块执行时间计数输出文件路径（FB_TIMING 构建）
+
+    // 网络配置
+    NetworkConfig network;            // 配置文件中声明的功能块网络
+
+    // 保持变量配置
+    char retain_file[256];            // 保持文件路径（空表示不启用）
+    int retain_period_ms;             // 最短写盘间隔（毫秒）
+    int retain_size_kb;               // 单个存储区大小（KiB）
+
+    // 输入录制配置
+    RecordMode record_mode;           // 录制模式
+    char record_file[256];            // 录制文件路径
+    int record_buffer_kb;             // 录制环形缓冲区大小（KiB）
 } RuntimeConfig;
 
 /**
@@ -58,4 +119,10 @@ typedef struct {
  */
 RuntimeConfig config_default(void);
 
+/**
+ * @brief 释放配置中动态分配的内容（网络声明）
+ * @param config 配置结构体
+ */
+void config_free(RuntimeConfig* config);
+
 #endif // CONFIG_H
@@ -27,6 +27,18 @@
  *
  * 简化版本：支持基本的 YAML 解析（手动实现，避免第三方依赖）。
  * 生产环境建议使用 libyaml 或 PyYAML 通过 Python 解析。
+ *
+ * network 节支持两级嵌套，各条目原样保存，启动时由 config_network 编译：
+ *   network:
+ *     phase: after_step
+ *     inputs:
+ *       sp: 50.0
+ *     blocks:
+ *       pid: {type: PID, Kp: 2.0, Ki: 0.5}
+ *     connections:
+ *       - sp -> pid.SP
+ *     outputs:
+ *       valve: pid.CV
  */
 
 #include "config_loader.h"
@@ -44,6 +56,10 @@ static int parse_key_value(const char* line, char* key, char* value);
 // 内部函数：解析日志级别
 static LogLevel parse_log_level(const char* str);
 
+// 内部函数：解析 network 节中的一行
+static int parse_network_line(RuntimeConfig* config, char* trimmed, int indent, int line_no,
+                              int* net_indent, char* subsection);
+
 RuntimeConfig config_default(void) {
     RuntimeConfig config;
 
@@ -51,12 +67,14 @@ RuntimeConfig config_default(void) {
     config.cycle_period_ms = 100;
     strcpy(config.script_path, "python/examples/pid_temperature.py");
     config.timeout_threshold_percent = 110;
+    config.mode = RUNTIME_MODE_PYTHON;
 
     // 日志默认配置
     config.log_config.level = LOG_INFO;
     config.log_config.file_path = "runtime.log";
     config.log_config.max_size_mb = 10;
     config.log_config.backup_count = 3;
+    config.journal_flush_ms = 5000;
 
     // 调试默认配置
     config.debug_enabled = 0;
@@ -67,10 +85,45 @@ RuntimeConfig config_default(void) {
     // 性能默认配置
     config.cpu_affinity = -1;
     config.max_function_blocks = 32;
+    config.fb_storage_kb = 0;
+
+    // 剖析默认配置
+    config.profiler_enabled = 0;
+    strcpy(config.profiler_output, "profile.folded");
+    config.profiler_max_nodes = 4096;
+    strcpy(config.fb_timing_output, "fb_timing.txt");
+
+    // 网络默认配置（无声明）
+    config.network.decls = NULL;
+    config.network.count = 0;
+    config.network.capacity = 0;
+    strcpy(config.network.phase, "after_step");
+    config.network.period_ms = 0;
+
+    // 保持变量默认配置（不启用）
+    config.retain_file[0] = '\0';
+    config.retain_period_ms = 100;
+    config.retain_size_kb = 64;
+
+    // 输入录制默认配置（不启用）
+    config.record_mode = RECORD_MODE_OFF;
+    config.record_file[0] = '\0';
+    config.record_buffer_kb = 256;
 
     return config;
 }
 
+void config_free(RuntimeConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    free(config->network.decls);
+    config->network.decls = NULL;
+    config->network.count = 0;
+    config->network.capacity = 0;
+}
+
 int config_load_from_file(const char* file_path, RuntimeConfig* config) {
     if (!file_path || !config) {
         return -1;
@@ -90,22 +143,38 @@ int config_load_from_file(const char* file_path, RuntimeConfig* config) {
     char line[512];
     char key[128], value[384];
     char section[64] = "";
+    char subsection[64] = "";
+    int net_indent = -1;
+    int line_no = 0;
 
     while (fgets(line, sizeof(line), file)) {
+        line_no++;
+
         // 跳过注释和空行
         char* trimmed = trim(line);
         if (trimmed[0] == '#' || trimmed[0] == '\0') {
             continue;
         }
 
-        // 检测节（section）
-        if (strstr(trimmed, ":") && !strstr(trimmed, "  ")) {
+        // 检测节（section）：无缩进的行为顶层键
+        if (strstr(trimmed, ":") && !isspace((unsigned char)line[0])) {
             // 顶层键（节名）
             sscanf(trimmed, "%63[^:]:", section);
             trim(section);
             continue;
         }
 
+        // network 节有嵌套结构，单独解析
+        if (strcmp(section, "network") == 0) {
+            if (parse_network_line(config, trimmed, (int)(trimmed - line), line_no,
+                                   &net_indent, subsection) != 0) {
+                fclose(file);
+                config_free(config);
+                return -1;
+            }
+            continue;
+        }
+
         // 解析键值对
         if (parse_key_value(trimmed, key, value) == 0) {
             // 根据节和键设置配置
@@ -118,6 +187,18 @@ int config_load_from_file(const char* file_path, RuntimeConfig* config) {
                     config->script_path[sizeof(config->script_path) - 1] = '\0';
                 } else if (strcmp(key, "timeout_threshold_percent") == 0) {
                     config->timeout_threshold_percent = atoi(value);
+                } else if (strcmp(key, "mode") == 0) {
+                    if (strcmp(value, "c") == 0) {
+                        config->mode = RUNTIME_MODE_C;
+                    } else if (strcmp(value, "python") == 0) {
+                        config->mode = RUNTIME_MODE_PYTHON;
+                    } else {
+                        fprintf(stderr, "错误：配置第 %d 行：未知运行模式 '%s'（python 或 c）\n",
+                                line_no, value);
+                        fclose(file);
+                        config_free(config);
+                        return -1;
+                    }
                 }
             } else if (strcmp(section, "script") == 0) {
                 // 支持独立的 script 节
@@ -134,6 +215,8 @@ int config_load_from_file(const char* file_path, RuntimeConfig* config) {
                     config->log_config.max_size_mb = (size_t)atoi(value);
                 } else if (strcmp(key, "backup_count") == 0) {
                     config->log_config.backup_count = atoi(value);
+                } else if (strcmp(key, "journal_flush_ms") == 0) {
+                    config->journal_flush_ms = atoi(value);
                 }
             } else if (strcmp(section, "debug") == 0) {
                 if (strcmp(key, "enabled") == 0) {
@@ -151,13 +234,64 @@ int config_load_from_file(const char* file_path, RuntimeConfig* config) {
                     config->cpu_affinity = atoi(value);
                 } else if (strcmp(key, "max_function_blocks") == 0) {
                     config->max_function_blocks = atoi(value);
+                } else if (strcmp(key, "fb_storage_kb") == 0) {
+                    config->fb_storage_kb = atoi(value);
+                }
+            } else if (strcmp(section, "profiler") == 0) {
+                if (strcmp(key, "enabled") == 0) {
+                    config->profiler_enabled = (strcmp(value, "true") == 0);
+                } else if (strcmp(key, "output") == 0) {
+                    strncpy(config->profiler_output, value, sizeof(config->profiler_output) - 1);
+                    config->profiler_output[sizeof(config->profiler_output) - 1] = '\0';
+                } else if (strcmp(key, "max_nodes") == 0) {
+                    config->profiler_max_nodes = atoi(value);
+                } else if (strcmp(key, "fb_timing_output") == 0) {
+                    strncpy(config->fb_timing_output, value,
+                            sizeof(config->fb_timing_output) - 1);
+                    config->fb_timing_output[sizeof(config->fb_timing_output) - 1] = '\0';
+                }
+            } else if (strcmp(section, "retain") == 0) {
+                if (strcmp(key, "file") == 0) {
+                    strncpy(config->retain_file, value, sizeof(config->retain_file) - 1);
+                    config->retain_file[sizeof(config->retain_file) - 1] = '\0';
+                } else if (strcmp(key, "period_ms") == 0) {
+                    config->retain_period_ms = atoi(value);
+                } else if (strcmp(key, "size_kb") == 0) {
+                    config->retain_size_kb = atoi(value);
+                }
+            } else if (strcmp(section, "record") == 0) {
+                if (strcmp(key, "mode") == 0) {
+                    if (strcmp(value, "off") == 0) {
+                        config->record_mode = RECORD_MODE_OFF;
+                    } else if (strcmp(value, "record") == 0) {
+                        config->record_mode = RECORD_MODE_RECORD;
+                    } else if (strcmp(value, "replay") == 0) {
+                        config->record_mode = RECORD_MODE_REPLAY;
+                    } else {
+                        fprintf(stderr,
+                                "错误：配置第 %d 行：未知录制模式 '%s'（off、record 或 replay）\n",
+                                line_no, value);
+                        fclose(file);
+                        config_free(config);
+                        return -1;
+                    }
+                } else if (strcmp(key, "file") == 0) {
+                    strncpy(config->record_file, value, sizeof(config->record_file) - 1);
+                    config->record_file[sizeof(config->record_file) - 1] = '\0';
+                } else if (strcmp(key, "buffer_kb") == 0) {
+                    config->record_buffer_kb = atoi(value);
                 }
             }
         }
     }
 
     fclose(file);
-    return config_validate(config);
+
+    if (config_validate(config) != 0) {
+        config_free(config);
+        return -1;
+    }
+    return 0;
 }
 
 int config_validate(const RuntimeConfig* config) {
@@ -171,18 +305,65 @@ int config_validate(const RuntimeConfig* config) {
         return -1;
     }
 
-    // 验证脚本路径
-    if (strlen(config->script_path) == 0) {
+    // 验证脚本路径（纯 C 模式不加载脚本）
+    if (config->mode == RUNTIME_MODE_PYTHON && strlen(config->script_path) == 0) {
         fprintf(stderr, "错误：脚本路径不能为空\n");
         return -1;
     }
 
+    // 验证网络配置
+    if (config->mode == RUNTIME_MODE_C && config->network.count == 0) {
+        fprintf(stderr, "错误：纯 C 模式需要在 network 节中声明功能块网络\n");
+        return -1;
+    }
+    if (strcmp(config->network.phase, "before_step") != 0 &&
+        strcmp(config->network.phase, "after_step") != 0) {
+        fprintf(stderr, "错误：network.phase 必须为 before_step 或 after_step\n");
+        return -1;
+    }
+    if (config->network.period_ms < 0) {
+        fprintf(stderr, "错误：network.period_ms 不能为负数\n");
+        return -1;
+    }
+
     // 验证调试端口
     if (config->debug_enabled && (config->debug_port < 1024 || config->debug_port > 65535)) {
         fprintf(stderr, "错误：调试端口必须在 1024-65535 范围内\n");
         return -1;
     }
 
+    // 验证日志配置
+    if (config->journal_flush_ms < 100) {
+        fprintf(stderr, "错误：logging.journal_flush_ms 不能小于 100\n");
+        return -1;
+    }
+
+    // 验证保持变量配置
+    if (config->retain_period_ms < 1) {
+        fprintf(stderr, "错误：retain.period_ms 必须大于 0\n");
+        return -1;
+    }
+    if (config->retain_size_kb < 1 || config->retain_size_kb > 65536) {
+        fprintf(stderr, "错误：retain.size_kb 必须在 1-65536 范围内\n");
+        return -1;
+    }
+
+    // 验证输入录制配置
+    if (config->record_mode != RECORD_MODE_OFF && !config->record_file[0]) {
+        fprintf(stderr, "错误：启用录制或回放时必须设置 record.file\n");
+        return -1;
+    }
+    if (config->record_buffer_kb < 4 || config->record_buffer_kb > 1048576) {
+        fprintf(stderr, "错误：record.buffer_kb 必须在 4-1048576 范围内\n");
+        return -1;
+    }
+
+    // 验证剖析节点上限
+    if (config->profiler_max_nodes < 16 || config->profiler_max_nodes > 1048576) {
+        fprintf(stderr, "错误：剖析节点上限必须在 16-1048576 范围内\n");
+        return -1;
+    }
+
     return 0;
 }
 
@@ -249,6 +430,104 @@ static int parse_key_value(const char* line, char* key, char* value) {
     return 0;
 }
 
+// 追加一条网络声明
+static int add_network_decl(NetworkConfig* network, NetworkDeclKind kind, const char* name,
+                            const char* value, int line_no) {
+    if (strlen(name) >= sizeof(network->decls[0].name) ||
+        strlen(value) >= sizeof(network->decls[0].value)) {
+        fprintf(stderr, "错误：配置第 %d 行：名称或取值过长\n", line_no);
+        return -1;
+    }
+
+    if (network->count == network->capacity) {
+        size_t capacity = network->capacity ? network->capacity * 2 : 16;
+        NetworkDecl* decls = (NetworkDecl*)realloc(network->decls, capacity * sizeof(NetworkDecl));
+        if (!decls) {
+            fprintf(stderr, "错误：网络配置内存分配失败\n");
+            return -1;
+        }
+        network->decls = decls;
+        network->capacity = capacity;
+    }
+
+    NetworkDecl* decl = &network->decls[network->count++];
+    decl->kind = kind;
+    strcpy(decl->name, name);
+    strcpy(decl->value, value);
+    decl->line = line_no;
+    return 0;
+}
+
+static int parse_network_line(RuntimeConfig* config, char* trimmed, int indent, int line_no,
+                              int* net_indent, char* subsection) {
+    char key[128], value[384];
+
+    // 节内第一行的缩进即 network 直属键的缩进
+    if (*net_indent < 0) {
+        *net_indent = indent;
+    }
+
+    // 列表项：connections 下的 "- src -> dst"
+    if (trimmed[0] == '-') {
+        if (strcmp(subsection, "connections") != 0) {
+            fprintf(stderr, "错误：配置第 %d 行：列表项只能出现在 network.connections 中\n",
+                    line_no);
+            return -1;
+        }
+
+        char* item = trimmed + 1;
+        char* comment = strchr(item, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        item = trim(item);
+
+        size_t len = strlen(item);
+        if (len > 1 && item[0] == '"' && item[len - 1] == '"') {
+            item[len - 1] = '\0';
+            item++;
+        }
+        return add_network_decl(&config->network, NETWORK_DECL_CONNECTION, "", item, line_no);
+    }
+
+    if (parse_key_value(trimmed, key, value) != 0) {
+        fprintf(stderr, "错误：配置第 %d 行：无法解析 '%s'\n", line_no, trimmed);
+        return -1;
+    }
+
+    // network 直属键：子节（值为空）或标量选项
+    if (indent <= *net_indent) {
+        subsection[0] = '\0';
+
+        if (value[0] == '\0') {
+            if (strcmp(key, "inputs") != 0 && strcmp(key, "blocks") != 0 &&
+                strcmp(key, "connections") != 0 && strcmp(key, "outputs") != 0) {
+                fprintf(stderr, "错误：配置第 %d 行：未知的 network 子节 '%s'\n", line_no, key);
+                return -1;
+            }
+            strcpy(subsection, key);
+        } else if (strcmp(key, "phase") == 0) {
+            strncpy(config->network.phase, value, sizeof(config->network.phase) - 1);
+            config->network.phase[sizeof(config->network.phase) - 1] = '\0';
+        } else if (strcmp(key, "period_ms") == 0) {
+            config->network.period_ms = atoi(value);
+        }
+        return 0;
+    }
+
+    // 子节条目
+    if (strcmp(subsection, "inputs") == 0) {
+        return add_network_decl(&config->network, NETWORK_DECL_INPUT, key, value, line_no);
+    } else if (strcmp(subsection, "blocks") == 0) {
+        return add_network_decl(&config->network, NETWORK_DECL_BLOCK, key, value, line_no);
+    } else if (strcmp(subsection, "outputs") == 0) {
+        return add_network_decl(&config->network, NETWORK_DECL_OUTPUT, key, value, line_no);
+    }
+
+    fprintf(stderr, "错误：配置第 %d 行：'%s' 不属于任何 network 子节\n", line_no, key);
+    return -1;
+}
+
 static LogLevel parse_log_level(const char* str) {
     if (strcmp(str, "DEBUG") == 0) return LOG_DEBUG;
     if (strcmp(str, "INFO") == 0) return LOG_INFO;
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file config_network.c
+ * @brief 把配置文件 network 节编译为可执行的 FBD 网络
+ *
+ * 先添加全部输入和功能块，再连线、添加输出，因此各子节在配置文件中的
+ * 先后顺序不影响结果。功能块条目为 YAML 流式映射：
+ *   pid: {type: PID, Kp: 2.0, Ki: 0.5}
+ * 也可只写类型名（pid: PID），此时全部参数取默认值。Lookup1D 的折线表以
+ * 流式序列给出：
+ *   valve: {type: Lookup1D, x: [0, 50, 100], y: [0, 20, 100]}
+ */
+
+#include "config_network.h"
+#include "logger.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 去除首尾空白（原地修改）
+static char* strip(char* str) {
+    while (isspace((unsigned char)*str)) str++;
+    char* end = str + strlen(str);
+    while (end > str && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+    return str;
+}
+
+// 解析浮点数，整串都必须是数字
+static int parse_double(const char* text, double* out) {
+    char* end;
+    double value = strtod(text, &end);
+    if (end == text || *strip(end) != '\0') {
+        return -1;
+    }
+    *out = value;
+    return 0;
+}
+
+// 取下一个字段：按不在方括号内的 ',' 分割（原地修改），没有更多字段时返回 NULL
+static char* next_field(char** cursor) {
+    char* field = *cursor;
+    if (!field) {
+        return NULL;
+    }
+
+    int depth = 0;
+    for (char* p = field; *p; p++) {
+        if (*p == '[') {
+            depth++;
+        } else if (*p == ']' && depth > 0) {
+            depth--;
+        } else if (*p == ',' && depth == 0) {
+            *p = '\0';
+            *cursor = p + 1;
+            return field;
+        }
+    }
+    *cursor = NULL;
+    return field;
+}
+
+// 解析 "[v0, v1, ...]"，返回元素个数，格式错误返回 -1
+static long parse_list(char* text, double* out, size_t capacity) {
+    size_t len = strlen(text);
+    if (len < 2 || text[0] != '[' || text[len - 1] != ']') {
+        return -1;
+    }
+    text[len - 1] = '\0';
+
+    size_t count = 0;
+    for (char* item = strtok(text + 1, ","); item; item = strtok(NULL, ",")) {
+        if (count == capacity || parse_double(strip(item), &out[count]) != 0) {
+            return -1;
+        }
+        count++;
+    }
+    return (long)count;
+}
+
+// 解析功能块条目并添加到网络
+static int add_block(FBNetwork* net, const NetworkDecl* decl) {
+    char text[sizeof(decl->value)];
+    strcpy(text, decl->value);
+
+    char* body = strip(text);
+    size_t len = strlen(body);
+    int is_map = len >= 2 && body[0] == '{' && body[len - 1] == '}';
+    if (is_map) {
+        body[len - 1] = '\0';
+        body++;
+    }
+
+    char* kind = NULL;
+    char* fields[FB_NETWORK_MAX_PARAMS + 1];
+    size_t field_count = 0;
+
+    if (!is_map) {
+        kind = body;
+    } else {
+        char* cursor = body;
+        for (char* field = next_field(&cursor); field; field = next_field(&cursor)) {
+            char* colon = strchr(field, ':');
+            if (!colon) {
+                LOG_ERROR_MSG("配置第 %d 行：功能块 %s 的字段 '%s' 缺少 ':'",
+                              decl->line, decl->name, strip(field));
+                return -1;
+            }
+            *colon = '\0';
+            if (strcmp(strip(field), "type") == 0) {
+                kind = strip(colon + 1);
+            } else if (field_count < FB_NETWORK_MAX_PARAMS + 1) {
+                *colon = ':';
+                fields[field_count++] = field;
+            } else {
+                LOG_ERROR_MSG("配置第 %d 行：功能块 %s 的参数过多", decl->line, decl->name);
+                return -1;
+            }
+        }
+    }
+
+    FunctionBlockType type;
+    if (!kind || fb_network_parse_type(kind, &type) != 0) {
+        LOG_ERROR_MSG("配置第 %d 行：功能块 %s 的类型无效（PID、FirstOrder、Ramp、Limit 或 Lookup1D）",
+                      decl->line, decl->name);
+        return -1;
+    }
+
+    const char* const* names;
+    const double* defaults;
+    size_t count = fb_network_param_info(type, &names, &defaults);
+    double params[FB_NETWORK_MAX_PARAMS];
+    memcpy(params, defaults, count * sizeof(double));
+
+    // 折线表的断点 x 和输出值 y（每个数至少占 "0," 两个字符）
+    double table[2][sizeof(decl->value) / 2];
+    long table_len[2] = {-1, -1};
+
+    for (size_t i = 0; i < field_count; i++) {
+        char* colon = strchr(fields[i], ':');
+        *colon = '\0';
+        const char* name = strip(fields[i]);
+        char* value = strip(colon + 1);
+
+        int axis = strcmp(name, "x") == 0 ? 0 : strcmp(name, "y") == 0 ? 1 : -1;
+        if (type == FB_TYPE_LOOKUP_1D && axis >= 0) {
+            table_len[axis] = parse_list(value, table[axis], sizeof(table[axis]) / sizeof(double));
+            if (table_len[axis] < 0) {
+                LOG_ERROR_MSG("配置第 %d 行：%s 应为数字序列，如 [0, 50, 100]", decl->line, name);
+                return -1;
+            }
+            continue;
+        }
+
+        size_t index = 0;
+        while (index < count && strcmp(names[index], name) != 0) {
+            index++;
+        }
+        if (index == count) {
+            LOG_ERROR_MSG("配置第 %d 行：%s 没有参数 '%s'", decl->line, kind, name);
+            return -1;
+        }
+        if (parse_double(value, &params[index]) != 0) {
+            LOG_ERROR_MSG("配置第 %d 行：参数 %s 的取值 '%s' 不是数字", decl->line, name, value);
+            return -1;
+        }
+    }
+
+    if (type == FB_TYPE_LOOKUP_1D && (table_len[0] < 0 || table_len[0] != table_len[1])) {
+        LOG_ERROR_MSG("配置第 %d 行：折线表 %s 需要个数相同的 x 和 y", decl->line, decl->name);
+        return -1;
+    }
+
+    if (fb_network_add_block(net, decl->name, type, params) != 0 ||
+        (type == FB_TYPE_LOOKUP_1D &&
+         fb_network_set_table(net, decl->name, table[0], table[1], (size_t)table_len[0]) != 0)) {
+        LOG_ERROR_MSG("配置第 %d 行：%s", decl->line, fb_network_last_error(net));
+        return -1;
+    }
+    return 0;
+}
+
+// 解析 "src -> dst" 并连线
+static int add_connection(FBNetwork* net, const NetworkDecl* decl) {
+    char text[sizeof(decl->value)];
+    strcpy(text, decl->value);
+
+    char* arrow = strstr(text, "->");
+    if (!arrow) {
+        LOG_ERROR_MSG("配置第 %d 行：连线格式应为 'src -> dst'", decl->line);
+        return -1;
+    }
+    *arrow = '\0';
+
+    if (fb_network_connect(net, strip(text), strip(arrow + 2)) != 0) {
+        LOG_ERROR_MSG("配置第 %d 行：%s", decl->line, fb_network_last_error(net));
+        return -1;
+    }
+    return 0;
+}
+
+// 按类型处理一轮声明
+static int apply_decls(FBNetwork* net, const NetworkConfig* network, NetworkDeclKind kind) {
+    for (size_t i = 0; i < network->count; i++) {
+        const NetworkDecl* decl = &network->decls[i];
+        if (decl->kind != kind) {
+            continue;
+        }
+
+        int rc = 0;
+        switch (kind) {
+        case NETWORK_DECL_INPUT: {
+            double value = 0.0;
+            char text[sizeof(decl->value)];
+            strcpy(text, decl->value);
+            if (text[0] != '\0' && parse_double(strip(text), &value) != 0) {
+                LOG_ERROR_MSG("配置第 %d 行：输入 %s 的初值 '%s' 不是数字",
+                              decl->line, decl->name, decl->value);
+                return -1;
+            }
+            rc = fb_network_add_input(net, decl->name, value);
+            break;
+        }
+        case NETWORK_DECL_BLOCK:
+            if (add_block(net, decl) != 0) {
+                return -1;
+            }
+            break;
+        case NETWORK_DECL_CONNECTION:
+            if (add_connection(net, decl) != 0) {
+                return -1;
+            }
+            break;
+        case NETWORK_DECL_OUTPUT:
+            rc = fb_network_add_output(net, decl->name, decl->value);
+            break;
+        }
+
+        if (rc != 0) {
+            LOG_ERROR_MSG("配置第 %d 行：%s", decl->line, fb_network_last_error(net));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+FBNetwork* config_network_build(const NetworkConfig* network, int max_blocks) {
+    if (!network || network->count == 0) {
+        return NULL;
+    }
+
+    FBNetwork* net = fb_network_create();
+    if (!net) {
+        return NULL;
+    }
+
+    static const NetworkDeclKind order[] = {NETWORK_DECL_INPUT, NETWORK_DECL_BLOCK,
+                                            NETWORK_DECL_CONNECTION, NETWORK_DECL_OUTPUT};
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        if (apply_decls(net, network, order[i]) != 0) {
+            fb_network_destroy(net);
+            return NULL;
+        }
+    }
+
+    if (max_blocks > 0 && net->block_count > (size_t)max_blocks) {
+        LOG_ERROR_MSG("网络功能块数量 %zu 超过上限 %d（performance.max_function_blocks）",
+                      net->block_count, max_blocks);
+        fb_network_destroy(net);
+        return NULL;
+    }
+
+    if (fb_network_build(net) != 0) {
+        fb_network_destroy(net);
+        return NULL;
+    }
+
+    return net;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file config_network.h
+ * @brief 把配置文件 network 节编译为可执行的 FBD 网络
+ */
+
+#ifndef CONFIG_NETWORK_H
+#define CONFIG_NETWORK_H
+
+#include "config.h"
+#include "../function_blocks/fb_network.h"
+
+/**
+ * @brief 按声明创建网络、连线并构建执行列表
+ * @param network network 节配置
+ * @param max_blocks 功能块数量上限（performance.max_function_blocks）
+ * @return 已构建的网络，失败返回 NULL（原因已写入日志）
+ */
+FBNetwork* config_network_build(const NetworkConfig* network, int max_blocks);
+
+#endif // CONFIG_NETWORK_H
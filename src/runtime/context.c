@@ -28,6 +28,10 @@
 
 #include "context.h"
 #include "config_loader.h"
+#include "config_network.h"
+#include "../function_blocks/fb_journal.h"
+#include "../function_blocks/fb_pool.h"
+#include "../function_blocks/fb_registry.h"
 #include "logger.h"
 #include <stdlib.h>
 #include <string.h>
@@ -36,10 +40,26 @@
 static RuntimeContext g_runtime_context = {0};
 static int g_context_initialized = 0;
 
+// 命令行 --record/--replay 指定的录制设置
+static RecordMode g_record_override = RECORD_MODE_OFF;
+static const char* g_record_override_file = NULL;
+
+// 释放配置声明的网络（初始化失败或清理时）
+static void discard_network(void) {
+    fb_network_destroy(g_runtime_context.network);
+    g_runtime_context.network = NULL;
+    config_free(&g_runtime_context.config);
+}
+
 RuntimeContext* runtime_context_get(void) {
     return &g_runtime_context;
 }
 
+void runtime_context_set_record_override(RecordMode mode, const char* file) {
+    g_record_override = mode;
+    g_record_override_file = file;
+}
+
 int runtime_context_init(const char* config_file) {
     if (g_context_initialized) {
         LOG_WARNING_MSG("运行时上下文已初始化");
@@ -55,6 +75,13 @@ int runtime_context_init(const char* config_file) {
         fflush(stderr);
         return -1;
     }
+    if (g_record_override != RECORD_MODE_OFF) {
+        g_runtime_context.config.record_mode = g_record_override;
+        strncpy(g_runtime_context.config.record_file, g_record_override_file,
+                sizeof(g_runtime_context.config.record_file) - 1);
+        g_runtime_context.config.record_file[sizeof(g_runtime_context.config.record_file) - 1] =
+            '\0';
+    }
 
     fprintf(stdout, "DEBUG: Config loaded, initializing logger\n");
     fflush(stdout);
@@ -67,12 +94,93 @@ int runtime_context_init(const char* config_file) {
     }
 
     LOG_INFO_MSG("运行时上下文初始化：配置文件=%s", config_file);
+
+    // 运行时自身的功能块注册表：配置声明的网络中的功能块在此登记
+    if (g_runtime_context.config.max_function_blocks > 0 &&
+        fb_registry_configure((size_t)g_runtime_context.config.max_function_blocks) != 0) {
+        LOG_WARNING_MSG("功能块注册表配置失败，使用默认容量");
+    }
+    // 网络中 Lookup1D 的表副本从附属存储区分配
+    if (g_runtime_context.config.max_function_blocks > 0 &&
+        fb_pool_configure((size_t)g_runtime_context.config.max_function_blocks,
+                          (size_t)g_runtime_context.config.fb_storage_kb * 1024) != 0) {
+        LOG_WARNING_MSG("功能块实例池配置失败，首次分配时使用默认容量");
+    }
+
+    // 编译配置中声明的网络（两种模式共用同一张网络表）
+    py_networks_init(&g_runtime_context.py_context.networks,
+                     g_runtime_context.config.cycle_period_ms);
+    if (g_runtime_context.config.network.count > 0) {
+        g_runtime_context.network =
+            config_network_build(&g_runtime_context.config.network,
+                                 g_runtime_context.config.max_function_blocks);
+        if (!g_runtime_context.network) {
+            LOG_ERROR_MSG("配置文件中的网络编译失败");
+            discard_network();
+            logger_cleanup();
+            return -1;
+        }
+    }
+
+    // 纯 C 模式：不初始化 Python 解释器
+    if (g_runtime_context.config.mode == RUNTIME_MODE_C) {
+        if (g_runtime_context.config.record_mode != RECORD_MODE_OFF) {
+            LOG_WARNING_MSG("纯 C 模式没有外部输入，录制/回放配置被忽略");
+        }
+        py_networks_add(&g_runtime_context.py_context.networks, g_runtime_context.network,
+                        PY_NETWORK_AFTER_STEP, g_runtime_context.config.network.period_ms);
+
+        // 网络编译完成后再恢复保持数据，覆盖配置中的初始状态
+        if (retain_store_open_network(&g_runtime_context.retain, &g_runtime_context.config,
+                                      g_runtime_context.network) != 0) {
+            LOG_ERROR_MSG("保持文件打开失败：%s", g_runtime_context.config.retain_file);
+            discard_network();
+            logger_cleanup();
+            return -1;
+        }
+
+        // 功能块事件只在内存中记录，由汇总线程周期写入日志
+        fb_journal_start(g_runtime_context.config.journal_flush_ms);
+
+        g_runtime_context.running = 0;
+        g_runtime_context.cycle_count = 0;
+        g_context_initialized = 1;
+
+        LOG_INFO_MSG("运行时上下文初始化完成（纯 C 模式）");
+        return 0;
+    }
+
     fprintf(stdout, "DEBUG: Logger initialized, initializing Python\n");
     fflush(stdout);
 
     // 初始化 Python 解释器
     if (py_embed_init() != 0) {
         LOG_ERROR_MSG("Python 解释器初始化失败");
+        discard_network();
+        logger_cleanup();
+        return -1;
+    }
+
+    // 脚本创建功能块前按 max_function_blocks 预分配实例池（失败时退回默认容量）
+    py_embed_configure_pools(g_runtime_context.config.max_function_blocks,
+                             g_runtime_context.config.fb_storage_kb);
+
+    // 扩展模块中的功能块事件由运行时的汇总线程一并写入日志
+    py_embed_attach_journal();
+
+    // 脚本加载前打开保持文件，模块级代码即可通过 plcopen.retain 声明保持项
+    if (record_session_prepare_retain(&g_runtime_context.config) != 0 ||
+        retain_store_open_python(&g_runtime_context.config) != 0) {
+        py_embed_cleanup();
+        discard_network();
+        logger_cleanup();
+        return -1;
+    }
+
+    // 录制/回放同样在加载脚本前打开，模块级代码中的输入也被录制
+    if (record_session_open(&g_runtime_context.config) != 0) {
+        py_embed_cleanup();
+        discard_network();
         logger_cleanup();
         return -1;
     }
@@ -85,6 +193,7 @@ int runtime_context_init(const char* config_file) {
                              &g_runtime_context.py_context) != 0) {
         LOG_ERROR_MSG("用户脚本加载失败：%s", g_runtime_context.config.script_path);
         py_embed_cleanup();
+        discard_network();
         logger_cleanup();
         return -1;
     }
@@ -92,6 +201,39 @@ int runtime_context_init(const char* config_file) {
     fprintf(stdout, "DEBUG: Script loaded successfully\n");
     fflush(stdout);
 
+    // 初始化周期协程循环
+    if (cycle_loop_init(&g_runtime_context.py_context.cycle_loop,
+                        g_runtime_context.py_context.step_func,
+                        g_runtime_context.config.cycle_period_ms) != 0) {
+        LOG_ERROR_MSG("周期协程循环初始化失败");
+        py_embed_cleanup();
+        discard_network();
+        logger_cleanup();
+        return -1;
+    }
+
+    // 构建多速率任务表
+    if (py_tasks_init(&g_runtime_context.py_context.tasks,
+                      g_runtime_context.config.cycle_period_ms) != 0) {
+        LOG_ERROR_MSG("多速率任务初始化失败");
+        cycle_loop_cleanup(&g_runtime_context.py_context.cycle_loop);
+        py_embed_cleanup();
+        discard_network();
+        logger_cleanup();
+        return -1;
+    }
+
+    // 配置声明的网络按 network.phase 在 step() 前后执行
+    if (g_runtime_context.network) {
+        PyNetworkPhase phase = strcmp(g_runtime_context.config.network.phase, "before_step") == 0
+                                   ? PY_NETWORK_BEFORE_STEP
+                                   : PY_NETWORK_AFTER_STEP;
+        py_networks_add(&g_runtime_context.py_context.networks, g_runtime_context.network,
+                        phase, g_runtime_context.config.network.period_ms);
+    }
+
+    fb_journal_start(g_runtime_context.config.journal_flush_ms);
+
     g_runtime_context.running = 0;
     g_runtime_context.cycle_count = 0;
     g_context_initialized = 1;
@@ -110,8 +252,25 @@ void runtime_context_cleanup(void) {
 
     g_runtime_context.running = 0;
 
-    // 清理 Python 解释器
-    py_embed_cleanup();
+    // 停止任务线程并释放网络、任务、协程（需在解释器关闭前进行）
+    py_networks_cleanup(&g_runtime_context.py_context.networks);
+    if (g_runtime_context.config.mode == RUNTIME_MODE_PYTHON) {
+        py_tasks_cleanup(&g_runtime_context.py_context.tasks);
+        cycle_loop_cleanup(&g_runtime_context.py_context.cycle_loop);
+
+        // 写入最终检查点和剩余录制记录（句柄属于 Python 对象，须在解释器关闭前）
+        retain_store_close(&g_runtime_context.retain);
+        record_session_close(&g_runtime_context.record);
+
+        // 清理 Python 解释器
+        py_embed_cleanup();
+    } else {
+        retain_store_close(&g_runtime_context.retain);
+    }
+    discard_network();
+
+    // 最后一次汇总功能块事件（扩展模块不随解释器关闭卸载，其日志仍可读）
+    fb_journal_stop();
 
     // 清理日志系统
     logger_cleanup();
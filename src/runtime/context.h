@@ -33,11 +33,17 @@
 
 #include "config.h"
 #include "py_embed.h"
+#include "../function_blocks/fb_network.h"
+#include "retain_store.h"
+#include "record_session.h"
 
 // 运行时上下文结构体
 typedef struct {
     RuntimeConfig config;        // 运行时配置
-    PyEmbedContext py_context;   // Python 上下文
+    PyEmbedContext py_context;   // Python 上下文（纯 C 模式下只使用其中的网络表）
+    FBNetwork* network;          // 配置文件 network 节声明的网络（未声明时为 NULL）
+    RetainStore retain;          // 保持变量检查点（未启用时 store 为 NULL）
+    RecordSession record;        // 输入录制/回放（未启用时 rec 为 NULL）
     int running;                 // 运行状态标志
     uint64_t cycle_count;        // 周期计数
 } RuntimeContext;
@@ -48,6 +54,13 @@ typedef struct {
  */
 RuntimeContext* runtime_context_get(void);
 
+/**
+ * @brief 设置命令行指定的录制/回放（覆盖配置文件的 record 节，需在初始化前调用）
+ * @param mode 录制模式
+ * @param file 录制文件路径
+ */
+void runtime_context_set_record_override(RecordMode mode, const char* file);
+
 /**
  * @brief 初始化运行时上下文
  * @param config_file 配置文件路径
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file cycle_loop.c
+ * @brief 周期驱动的协程事件循环实现
+ *
+ * 与 asyncio 不同，这里没有就绪队列、回调句柄和 Future：每个协程只记录
+ * 一个等待请求，按周期计数的等待在 C 侧递减，不进入解释器。
+ */
+
+#include "cycle_loop.h"
+#include "py_embed.h"
+#include "logger.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CYCLE_LOOP_INITIAL_CAPACITY 16
+
+static int is_coroutine_function(PyObject* func) {
+    if (!func || !PyFunction_Check(func)) {
+        return 0;
+    }
+
+    PyCodeObject* code = (PyCodeObject*)PyFunction_GetCode(func);
+    return (code->co_flags & CO_COROUTINE) != 0;
+}
+
+static void task_clear(CycleTask* task) {
+    Py_CLEAR(task->coro);
+    Py_CLEAR(task->condition);
+    task->wait_cycles = 0;
+}
+
+/*
+ * 向协程发送 None。
+ * 返回 1 表示协程让出（*yielded 为新引用），0 表示协程结束，-1 表示抛出异常。
+ */
+static int task_send(PyObject* coro, PyObject** yielded) {
+#if PY_VERSION_HEX >= 0x030A0000
+    PySendResult result = PyIter_Send(coro, Py_None, yielded);
+    if (result == PYGEN_NEXT) {
+        return 1;
+    }
+    if (result == PYGEN_RETURN) {
+        Py_CLEAR(*yielded);
+        return 0;
+    }
+    return -1;
+#else
+    *yielded = PyObject_CallMethod(coro, "send", "O", Py_None);
+    if (*yielded) {
+        return 1;
+    }
+    if (PyErr_ExceptionMatches(PyExc_StopIteration)) {
+        PyErr_Clear();
+        return 0;
+    }
+    return -1;
+#endif
+}
+
+// 解析协程让出的等待请求（接管 request 的引用）
+static int task_set_wait(CycleTask* task, PyObject* request) {
+    if (request == Py_None) {
+        task->wait_cycles = 1;
+        Py_DECREF(request);
+        return 0;
+    }
+
+    if (PyLong_Check(request)) {
+        long long n = PyLong_AsLongLong(request);
+        Py_DECREF(request);
+        if (n == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        task->wait_cycles = n < 1 ? 1 : (uint64_t)n;
+        return 0;
+    }
+
+    if (PyCallable_Check(request)) {
+        task->condition = request;
+        task->wait_cycles = 0;
+        return 0;
+    }
+
+    PyErr_Format(PyExc_TypeError, "协程让出了不支持的等待对象：%s",
+                 Py_TYPE(request)->tp_name);
+    Py_DECREF(request);
+    return -1;
+}
+
+/*
+ * 推进一个协程任务。
+ * 返回 1 表示仍在等待或运行，0 表示已结束，-1 表示因异常结束。
+ */
+static int task_advance(CycleLoop* loop, CycleTask* task) {
+    if (task->condition) {
+        PyObject* ready = PyObject_CallObject(task->condition, NULL);
+        int truth = ready ? PyObject_IsTrue(ready) : -1;
+        Py_XDECREF(ready);
+        if (truth < 0) {
+            goto failed;
+        }
+        if (!truth) {
+            return 1;
+        }
+        Py_CLEAR(task->condition);
+    } else if (task->wait_cycles > 1) {
+        task->wait_cycles--;
+        loop->stats.skipped++;
+        return 1;
+    }
+
+    PyObject* yielded = NULL;
+    int result = task_send(task->coro, &yielded);
+    loop->stats.resumed++;
+
+    if (result == 1) {
+        if (task_set_wait(task, yielded) == 0) {
+            return 1;
+        }
+        goto failed;
+    }
+
+    if (result == 0) {
+        loop->stats.completed++;
+        task_clear(task);
+        return 0;
+    }
+
+failed:
+    py_embed_handle_exception();
+    loop->stats.failed++;
+    task_clear(task);
+    return -1;
+}
+
+static int loop_append(CycleLoop* loop, PyObject* coro) {
+    if (loop->task_count == loop->task_capacity) {
+        size_t capacity = loop->task_capacity ? loop->task_capacity * 2 : CYCLE_LOOP_INITIAL_CAPACITY;
+        CycleTask* tasks = (CycleTask*)realloc(loop->tasks, capacity * sizeof(CycleTask));
+        if (!tasks) {
+            LOG_ERROR_MSG("协程注册失败：内存分配失败");
+            return -1;
+        }
+        loop->tasks = tasks;
+        loop->task_capacity = capacity;
+    }
+
+    CycleTask* task = &loop->tasks[loop->task_count++];
+    Py_INCREF(coro);
+    task->coro = coro;
+    task->condition = NULL;
+    task->wait_cycles = 0;
+    return 0;
+}
+
+// 接收 plcopen.spawn() 在上一周期注册的协程；追加失败时未接收的协程留在队列中，下一周期重试
+static void loop_drain_spawn_queue(CycleLoop* loop) {
+    Py_ssize_t n = PyList_GET_SIZE(loop->spawn_queue);
+    Py_ssize_t i = 0;
+
+    while (i < n && loop_append(loop, PyList_GET_ITEM(loop->spawn_queue, i)) == 0) {
+        i++;
+    }
+    if (i < n) {
+        LOG_WARNING_MSG("%zd 个协程暂未接收，下一周期重试", n - i);
+    }
+
+    PyList_SetSlice(loop->spawn_queue, 0, i, NULL);
+}
+
+int cycle_loop_init(CycleLoop* loop, PyObject* step_func, int cycle_period_ms) {
+    if (!loop) {
+        return -1;
+    }
+
+    memset(loop, 0, sizeof(CycleLoop));
+
+    if (is_coroutine_function(step_func)) {
+        Py_INCREF(step_func);
+        loop->step_func = step_func;
+        LOG_INFO_MSG("step() 为协程函数，由周期协程循环推进");
+    }
+
+    loop->tasks = (CycleTask*)calloc(CYCLE_LOOP_INITIAL_CAPACITY, sizeof(CycleTask));
+    if (!loop->tasks) {
+        LOG_ERROR_MSG("协程循环初始化失败：内存分配失败");
+        Py_CLEAR(loop->step_func);
+        return -1;
+    }
+    loop->task_capacity = CYCLE_LOOP_INITIAL_CAPACITY;
+
+    // plcopen.cycle 提供 awaitable 和 spawn()，不可用时仅支持 async step()
+    PyObject* module = PyImport_ImportModule("plcopen.cycle");
+    if (!module) {
+        PyErr_Clear();
+        LOG_DEBUG_MSG("plcopen.cycle 不可用，spawn() 已禁用");
+        return 0;
+    }
+
+    PyObject* period = PyLong_FromLong(cycle_period_ms);
+    if (!period || PyObject_SetAttrString(module, "_cycle_period_ms", period) != 0) {
+        PyErr_Clear();
+    }
+    Py_XDECREF(period);
+
+    loop->spawn_queue = PyObject_GetAttrString(module, "_spawn_queue");
+    if (!loop->spawn_queue || !PyList_Check(loop->spawn_queue)) {
+        PyErr_Clear();
+        Py_CLEAR(loop->spawn_queue);
+    }
+    Py_DECREF(module);
+
+    return 0;
+}
+
+void cycle_loop_cleanup(CycleLoop* loop) {
+    if (!loop) {
+        return;
+    }
+
+    if (loop->stats.resumed > 0) {
+        LOG_INFO_MSG("协程循环统计：恢复=%llu, C 侧跳过=%llu, 完成=%llu, 异常=%llu",
+                     (unsigned long long)loop->stats.resumed,
+                     (unsigned long long)loop->stats.skipped,
+                     (unsigned long long)loop->stats.completed,
+                     (unsigned long long)loop->stats.failed);
+    }
+
+    task_clear(&loop->step_task);
+    for (size_t i = 0; i < loop->task_count; i++) {
+        task_clear(&loop->tasks[i]);
+    }
+    free(loop->tasks);
+
+    Py_CLEAR(loop->step_func);
+    Py_CLEAR(loop->spawn_queue);
+    memset(loop, 0, sizeof(CycleLoop));
+}
+
+int cycle_loop_is_async_step(const CycleLoop* loop) {
+    return loop && loop->step_func != NULL;
+}
+
+int cycle_loop_run_once(CycleLoop* loop) {
+    if (!loop) {
+        return -1;
+    }
+
+    int status = 0;
+
+    if (loop->spawn_queue && PyList_GET_SIZE(loop->spawn_queue) > 0) {
+        loop_drain_spawn_queue(loop);
+    }
+
+    // async step()：上一个协程结束后在本周期重新创建
+    if (loop->step_func) {
+        if (!loop->step_task.coro) {
+            loop->step_task.coro = PyObject_CallObject(loop->step_func, NULL);
+            if (!loop->step_task.coro) {
+                py_embed_handle_exception();
+                loop->stats.failed++;
+                status = -1;
+            }
+        }
+        if (loop->step_task.coro && task_advance(loop, &loop->step_task) < 0) {
+            status = -1;
+        }
+    }
+
+    // 推进 spawn() 注册的协程，并压缩掉已结束的任务
+    size_t kept = 0;
+    for (size_t i = 0; i < loop->task_count; i++) {
+        CycleTask* task = &loop->tasks[i];
+        if (task_advance(loop, task) < 0) {
+            status = -1;
+        }
+        if (task->coro) {
+            loop->tasks[kept++] = *task;
+        }
+    }
+    loop->task_count = kept;
+
+    return status;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file cycle_loop.h
+ * @brief 周期驱动的协程事件循环
+ *
+ * 支持 `async def step()` 以及通过 plcopen.spawn() 注册的长期协程。
+ * 每个控制周期由 C 调度器把每个协程最多推进一次；协程通过 yield
+ * 一个等待请求把控制权交回：
+ *   - None / 整数 N：等待 N 个周期（N < 1 按 1 处理），计数在 C 侧完成，
+ *     等待期间不进入解释器；
+ *   - 可调用对象：每个周期调用一次，返回真值时恢复协程。
+ * 对应的 awaitable 由 python/plcopen/cycle.py 提供。
+ */
+
+#ifndef CYCLE_LOOP_H
+#define CYCLE_LOOP_H
+
+#include <Python.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 单个协程任务
+typedef struct {
+    PyObject* coro;          // 协程对象（NULL 表示空闲）
+    PyObject* condition;     // 等待条件，NULL 表示按周期计数等待
+    uint64_t wait_cycles;    // 剩余等待周期数
+} CycleTask;
+
+// 协程循环统计
+typedef struct {
+    uint64_t resumed;        // 协程恢复次数（进入解释器）
+    uint64_t skipped;        // 在 C 侧直接跳过的等待周期数
+    uint64_t completed;      // 正常结束的协程数
+    uint64_t failed;         // 因异常结束的协程数
+} CycleLoopStats;
+
+// 协程循环
+typedef struct {
+    CycleTask step_task;     // async step() 对应的协程
+    PyObject* step_func;     // async step() 函数，NULL 表示 step() 为普通函数
+    CycleTask* tasks;        // spawn() 注册的协程
+    size_t task_count;
+    size_t task_capacity;
+    PyObject* spawn_queue;   // plcopen.cycle._spawn_queue 列表，NULL 表示不支持 spawn()
+    CycleLoopStats stats;
+} CycleLoop;
+
+/**
+ * @brief 初始化协程循环
+ * @param loop 协程循环
+ * @param step_func 用户脚本的 step 函数
+ * @param cycle_period_ms 控制周期（毫秒），用于 plcopen.sleep() 换算
+ * @return 0 成功，-1 失败
+ *
+ * step_func 为协程函数时，由循环负责创建和推进 step() 协程。
+ */
+int cycle_loop_init(CycleLoop* loop, PyObject* step_func, int cycle_period_ms);
+
+/**
+ * @brief 释放协程循环持有的所有协程
+ * @param loop 协程循环
+ */
+void cycle_loop_cleanup(CycleLoop* loop);
+
+/**
+ * @brief 判断 step() 是否为协程函数
+ * @param loop 协程循环
+ * @return 1 是，0 否
+ */
+int cycle_loop_is_async_step(const CycleLoop* loop);
+
+/**
+ * @brief 执行一个周期：推进 async step() 与所有已注册协程
+ * @param loop 协程循环
+ * @return 0 成功，-1 有协程抛出异常（异常已记录，其余协程照常推进）
+ */
+int cycle_loop_run_once(CycleLoop* loop);
+
+#endif // CYCLE_LOOP_H
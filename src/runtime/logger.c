@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <errno.h>
 #include <sys/stat.h>
 #include <pthread.h>
 
@@ -32,6 +33,9 @@ static void rotate_log_if_needed(void);
 // 内部函数：获取文件大小（MB）
 static size_t get_file_size_mb(const char* path);
 
+// 内部函数：创建日志文件所在目录（仅一级）
+static void ensure_parent_dir(const char* path);
+
 int logger_init(const LogConfig* config) {
     if (!config || !config->file_path) {
         return -1;
@@ -52,6 +56,10 @@ int logger_init(const LogConfig* config) {
 
     // 打开日志文件（追加模式）
     g_logger.file = fopen(config->file_path, "a");
+    if (!g_logger.file && errno == ENOENT) {
+        ensure_parent_dir(config->file_path);
+        g_logger.file = fopen(config->file_path, "a");
+    }
     if (!g_logger.file) {
         pthread_mutex_unlock(&g_logger.mutex);
         return -1;
@@ -70,10 +78,12 @@ int logger_init(const LogConfig* config) {
 }
 
 void logger_cleanup(void) {
+    // 关闭消息须在加锁前写出（logger_log 自身会获取同一把锁）
+    LOG_INFO_MSG("日志系统关闭");
+
     pthread_mutex_lock(&g_logger.mutex);
 
     if (g_logger.file) {
-        LOG_INFO_MSG("日志系统关闭");
         fclose(g_logger.file);
         g_logger.file = NULL;
     }
@@ -143,6 +153,18 @@ static size_t get_file_size_mb(const char* path) {
     return 0;
 }
 
+static void ensure_parent_dir(const char* path) {
+    char dir[512];
+    const char* slash = strrchr(path, '/');
+    if (!slash || slash == path || (size_t)(slash - path) >= sizeof(dir)) {
+        return;
+    }
+
+    memcpy(dir, path, (size_t)(slash - path));
+    dir[slash - path] = '\0';
+    mkdir(dir, 0755);  // 已存在时忽略错误
+}
+
 static void rotate_log_if_needed(void) {
     if (!g_logger.config.file_path) {
         return;
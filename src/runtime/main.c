@@ -26,6 +26,7 @@
  * @brief PLCopen Python 运行时主程序
  *
  * 运行时主循环，负责周期性调用用户脚本。
+ * 纯 C 模式（runtime.mode: c）下不初始化 Python，只周期执行配置中声明的网络。
  */
 
 #include <stdio.h>
@@ -39,9 +40,13 @@
 #include "py_embed.h"
 #include "debug_server.h"
 #include "debug_session.h"
+#include "profiler.h"
+#include "../function_blocks/fb_timing.h"
 
 // 全局信号标志
 static volatile sig_atomic_t g_shutdown_requested = 0;
+static volatile sig_atomic_t g_profiler_toggle_requested = 0;
+static volatile sig_atomic_t g_profiler_dump_requested = 0;
 
 /**
  * @brief 信号处理函数
@@ -51,6 +56,139 @@ static void signal_handler(int signum) {
     g_shutdown_requested = 1;
 }
 
+/**
+ * @brief 剖析器信号处理函数（SIGUSR1 切换开关，SIGUSR2 导出结果）
+ */
+static void profiler_signal_handler(int signum) {
+    if (signum == SIGUSR1) {
+        g_profiler_toggle_requested = 1;
+    } else if (signum == SIGUSR2) {
+        g_profiler_dump_requested = 1;
+    }
+}
+
+/**
+ * @brief 启动 step() 剖析器
+ */
+static void start_profiler(const RuntimeConfig* config) {
+    if (config->debug_enabled) {
+        LOG_WARNING_MSG("调试模式下 trace 钩子由 debugpy 占用，剖析器未启动");
+        return;
+    }
+
+    if (profiler_init((size_t)config->profiler_max_nodes) == 0) {
+        profiler_start();
+    }
+}
+
+/**
+ * @brief 导出功能块执行时间计数（仅 FB_TIMING 构建）
+ *
+ * 运行时和扩展模块各有一份注册表：先写运行时中配置声明的网络，
+ * Python 模式下再写脚本创建的功能块（运行时注册表为空时不写前一段）。
+ */
+static void dump_fb_timing(const RuntimeConfig* config, int python_mode) {
+    if (!fb_timing_enabled()) {
+        return;
+    }
+
+    int append = 0;
+    if (!python_mode || fb_registry_count() > 0) {
+        fb_timing_dump(config->fb_timing_output, "w");
+        append = 1;
+    }
+    if (python_mode) {
+        py_embed_dump_fb_timing(config->fb_timing_output, append);
+    }
+}
+
+/**
+ * @brief 在周期边界处理剖析器请求
+ *
+ * 钩子的安装/卸载和结果导出都需要在控制线程中进行，信号处理函数只设置标志。
+ */
+static void handle_profiler_requests(const RuntimeConfig* config) {
+    if (g_profiler_toggle_requested) {
+        g_profiler_toggle_requested = 0;
+
+        if (profiler_is_running()) {
+            profiler_stop();
+        } else {
+            start_profiler(config);
+        }
+    }
+
+    if (g_profiler_dump_requested) {
+        g_profiler_dump_requested = 0;
+        profiler_dump_folded(config->profiler_output);
+        dump_fb_timing(config, 1);
+    }
+}
+
+/**
+ * @brief 启动调试服务器、调用 init() 并启动任务线程和挂接网络（Python 模式）
+ * @return 0 成功，-1 失败
+ */
+static int start_script(RuntimeContext* ctx, DebugSession* debug_session) {
+    // 启动调试服务器（如果启用）
+    if (ctx->config.debug_enabled) {
+        if (debug_session_init(debug_session,
+                              ctx->config.debug_host,
+                              ctx->config.debug_port,
+                              ctx->config.debug_timeout) == 0) {
+            // 启动 debugpy 服务器（失败不影响运行）
+            if (debug_server_start(debug_session, &ctx->py_context) != 0) {
+                LOG_WARNING_MSG("调试服务器启动失败，程序继续运行");
+            }
+        }
+    } else {
+        LOG_DEBUG_MSG("调试功能未启用");
+    }
+
+    // 调用用户脚本的 init() 函数
+    if (py_embed_call_init(&ctx->py_context) != 0) {
+        LOG_ERROR_MSG("init() 函数调用失败");
+        return -1;
+    }
+
+    // 启动独立线程中的任务组（仅 free-threaded 构建）
+    if (py_tasks_start(&ctx->py_context.tasks) != 0) {
+        LOG_ERROR_MSG("任务线程启动失败");
+        return -1;
+    }
+
+    // 读取 init() 期间挂接的 FBD 网络
+    if (py_networks_load_attached(&ctx->py_context.networks) != 0) {
+        LOG_ERROR_MSG("FBD 网络挂接失败");
+        return -1;
+    }
+
+    // 接管 plcopen.retain 打开的保持文件（配置启用或脚本自行打开）
+    retain_store_attach_python(&ctx->retain, ctx->network);
+
+    // 接管 plcopen.record 打开的录制器
+    record_session_attach(&ctx->record);
+    if (record_session_replaying(&ctx->record) && ctx->py_context.tasks.thread_count > 0) {
+        LOG_WARNING_MSG("独立线程中的任务不按周期同步，回放结果可能不一致");
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 输出配置声明网络的最终输出值
+ */
+static void log_network_outputs(const FBNetwork* net) {
+    if (!net) {
+        return;
+    }
+
+    for (size_t i = 0; i < net->output_count; i++) {
+        LOG_INFO_MSG("网络输出 %s = %.6f", net->outputs[i].name,
+                     net->slots[net->outputs[i].slot]);
+    }
+}
+
 /**
  * @brief 打印使用说明
  */
@@ -59,8 +197,14 @@ static void print_usage(const char* program_name) {
     printf("用法: %s [选项]\n\n", program_name);
     printf("选项:\n");
     printf("  --config FILE    配置文件路径（默认: config/runtime.yaml）\n");
+    printf("  --record FILE    录制每周期的输入和输出到 FILE\n");
+    printf("  --replay FILE    按虚拟时间回放 FILE 并报告第一个不一致\n");
     printf("  --help, -h       显示此帮助信息\n");
     printf("\n");
+    printf("信号:\n");
+    printf("  SIGUSR1          开启/关闭 step() 剖析\n");
+    printf("  SIGUSR2          导出剖析结果（折叠栈格式）和功能块计时\n");
+    printf("\n");
 }
 
 /**
@@ -79,6 +223,10 @@ int main(int argc, char* argv[]) {
             config_file = argv[++i];
             fprintf(stdout, "Using config: %s\n", config_file);
             fflush(stdout);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            runtime_context_set_record_override(RECORD_MODE_RECORD, argv[++i]);
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            runtime_context_set_record_override(RECORD_MODE_REPLAY, argv[++i]);
         } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
             print_usage(argv[0]);
             return 0;
@@ -92,6 +240,8 @@ int main(int argc, char* argv[]) {
     // 注册信号处理
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
+    signal(SIGUSR1, profiler_signal_handler);
+    signal(SIGUSR2, profiler_signal_handler);
 
     fprintf(stdout, "Initializing runtime context...\n");
     fflush(stdout);
@@ -105,27 +255,15 @@ int main(int argc, char* argv[]) {
 
     RuntimeContext* ctx = runtime_context_get();
 
-    // 启动调试服务器（如果启用）
+    int python_mode = ctx->config.mode == RUNTIME_MODE_PYTHON;
     DebugSession debug_session;
-    if (ctx->config.debug_enabled) {
-        if (debug_session_init(&debug_session,
-                              ctx->config.debug_host,
-                              ctx->config.debug_port,
-                              ctx->config.debug_timeout) == 0) {
-            // 启动 debugpy 服务器（失败不影响运行）
-            if (debug_server_start(&debug_session, &ctx->py_context) != 0) {
-                LOG_WARNING_MSG("调试服务器启动失败，程序继续运行");
-            }
+    if (python_mode) {
+        if (start_script(ctx, &debug_session) != 0) {
+            runtime_context_cleanup();
+            return 1;
         }
-    } else {
-        LOG_DEBUG_MSG("调试功能未启用");
-    }
-
-    // 调用用户脚本的 init() 函数
-    if (py_embed_call_init(&ctx->py_context) != 0) {
-        LOG_ERROR_MSG("init() 函数调用失败");
-        runtime_context_cleanup();
-        return 1;
+    } else if (ctx->config.debug_enabled || ctx->config.profiler_enabled) {
+        LOG_WARNING_MSG("纯 C 模式不运行 Python，调试和剖析配置被忽略");
     }
 
     // 初始化调度器
@@ -143,8 +281,14 @@ int main(int argc, char* argv[]) {
         scheduler_set_cpu_affinity(ctx->config.cpu_affinity);
     }
 
+    // 启动剖析器（如果配置了）
+    if (python_mode && ctx->config.profiler_enabled) {
+        start_profiler(&ctx->config);
+    }
+
     ctx->running = 1;
-    LOG_INFO_MSG("运行时启动：周期=%d ms", ctx->config.cycle_period_ms);
+    LOG_INFO_MSG("运行时启动：周期=%d ms，模式=%s", ctx->config.cycle_period_ms,
+                 python_mode ? "python" : "c");
 
     // 主循环
     while (ctx->running && !g_shutdown_requested) {
@@ -153,31 +297,65 @@ int main(int argc, char* argv[]) {
         // 记录周期开始时间
         scheduler_cycle_start(&scheduler, &cycle_start);
 
-        // 检查调试服务器状态（如果启用）
-        if (ctx->config.debug_enabled) {
-            debug_server_check_status(&debug_session);
+        // 锁存周期时间（回放时取录制值，录制结束即停止）
+        if (record_session_begin_cycle(&ctx->record, &cycle_start)) {
+            LOG_INFO_MSG("回放到达录制结尾");
+            break;
         }
 
-        // 调用用户脚本的 step() 函数
-        if (py_embed_call_step(&ctx->py_context) != 0) {
-            LOG_ERROR_MSG("step() 函数执行失败");
-            // 继续运行，不退出
+        if (python_mode) {
+            // 检查调试服务器状态（如果启用）
+            if (ctx->config.debug_enabled) {
+                debug_server_check_status(&debug_session);
+            }
+
+            // 处理剖析器开关/导出请求
+            handle_profiler_requests(&ctx->config);
+
+            // 调用用户脚本的 step() 函数
+            if (py_embed_call_step(&ctx->py_context) != 0) {
+                LOG_ERROR_MSG("step() 函数执行失败");
+                // 继续运行，不退出
+            }
+        } else {
+            // 纯 C 模式：只执行配置声明的网络，SIGUSR2 只导出功能块计时
+            if (g_profiler_dump_requested) {
+                g_profiler_dump_requested = 0;
+                dump_fb_timing(&ctx->config, 0);
+            }
+            py_networks_run(&ctx->py_context.networks, PY_NETWORK_AFTER_STEP);
         }
 
+        // 周期末捕获保持数据（只做内存拷贝，写盘由后台线程完成）
+        retain_store_capture(&ctx->retain);
+
         // 记录周期结束时间并更新统计
         double actual_time = scheduler_cycle_end(&scheduler, &cycle_start);
         (void)actual_time;  // 抑制未使用警告
 
         ctx->cycle_count++;
 
-        // 等待下一个周期
-        if (scheduler_wait_next_cycle(&scheduler) != 0) {
+        // 回放按虚拟时间运行，不等待周期定时
+        if (record_session_replaying(&ctx->record)) {
+            continue;
+        }
+
+        // 等待下一个周期（等待期间释放 GIL，任务线程可以运行）
+        int wait_ret;
+        if (python_mode) {
+            PyThreadState* tstate = PyEval_SaveThread();
+            wait_ret = scheduler_wait_next_cycle(&scheduler);
+            PyEval_RestoreThread(tstate);
+        } else {
+            wait_ret = scheduler_wait_next_cycle(&scheduler);
+        }
+        if (wait_ret != 0) {
             LOG_WARNING_MSG("调度器等待被中断");
         }
     }
 
     // 停止调试服务器（如果启用）
-    if (ctx->config.debug_enabled) {
+    if (python_mode && ctx->config.debug_enabled) {
         debug_server_stop(&debug_session);
     }
 
@@ -188,10 +366,24 @@ int main(int argc, char* argv[]) {
                  stats->avg_cycle_time_ms,
                  (unsigned long long)stats->timeout_count);
 
+    log_network_outputs(ctx->network);
+    if (python_mode) {
+        py_embed_log_pool_stats();
+    }
+    int diverged = record_session_report(&ctx->record);
+
+    // 导出剖析结果（如果剖析过）
+    if (profiler_is_running()) {
+        profiler_stop();
+        profiler_dump_folded(ctx->config.profiler_output);
+    }
+    profiler_cleanup();
+    dump_fb_timing(&ctx->config, python_mode);
+
     // 清理
     scheduler_stop(&scheduler);
     runtime_context_cleanup();
 
     printf("运行时已正常退出\n");
-    return 0;
+    return diverged ? 2 : 0;
 }
@@ -0,0 +1,483 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file profiler.c
+ * @brief step() 行级性能剖析器实现
+ *
+ * 调用上下文树（calling context tree）：每个节点由 (父节点, 代码对象或
+ * C 方法定义, 行号) 唯一确定，节点表和哈希表在初始化时一次性分配，
+ * 钩子回调中只做查表和时间累加，不分配内存。
+ */
+
+#include <Python.h>
+#include "profiler.h"
+#include "logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PROF_NAME_LEN   96      // 节点名称最大长度
+#define PROF_MAX_DEPTH  256     // 导出时的最大栈深度
+#define PROF_ROOT       0       // 根节点（step() 调用本身）
+#define PROF_OVERFLOW   1       // 节点表已满时的归并节点
+
+// 节点类型
+typedef enum {
+    PROF_NODE_ROOT,  // 根节点/溢出节点
+    PROF_NODE_PY,    // Python 代码行
+    PROF_NODE_C      // C 函数调用
+} ProfNodeKind;
+
+// 调用上下文树节点
+typedef struct {
+    const void* key;              // PyCodeObject* 或 PyMethodDef*
+    PyObject* owner;              // Python 节点持有的代码对象引用
+    int32_t parent;               // 父节点下标
+    int32_t line;                 // 行号（C 节点为 0）
+    ProfNodeKind kind;            // 节点类型
+    uint64_t self_ns;             // 自身耗时（纳秒）
+    char name[PROF_NAME_LEN];     // 显示名称（创建时格式化）
+} ProfNode;
+
+// 剖析器全局状态（仅在控制线程中访问）
+static struct {
+    ProfNode* nodes;         // 节点表
+    int32_t* table;          // 开放寻址哈希表（节点下标，-1 为空）
+    size_t table_mask;       // 哈希表大小 - 1
+    size_t max_nodes;        // 节点上限
+    size_t node_count;       // 已用节点数
+    int32_t current;         // 当前所在节点
+    uint32_t overflow_depth; // 溢出节点内的嵌套深度
+    int32_t overflow_return; // 离开溢出节点后返回的节点
+    uint64_t last_ns;        // 上一个事件的时间戳
+    int in_step;             // 是否处于 step() 调用中
+    int running;             // 钩子是否已安装
+    uint64_t event_count;
+    uint64_t dropped_count;
+    uint64_t sampled_steps;
+} g_prof = {0};
+
+static inline uint64_t prof_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 将距上一个事件的时间计入当前节点
+static inline void prof_account(void) {
+    uint64_t now = prof_now_ns();
+    g_prof.nodes[g_prof.current].self_ns += now - g_prof.last_ns;
+    g_prof.last_ns = now;
+    g_prof.event_count++;
+}
+
+static inline size_t prof_hash(int32_t parent, const void* key, int32_t line) {
+    uint64_t h = (uint64_t)(uintptr_t)key;
+    h ^= (uint64_t)(uint32_t)parent * 0x9E3779B97F4A7C15ULL;
+    h ^= (uint64_t)(uint32_t)line * 0xC2B2AE3D27D4EB4FULL;
+    h ^= h >> 29;
+    return (size_t)h;
+}
+
+static void prof_format_code(char* buf, PyCodeObject* code, int line) {
+#if PY_VERSION_HEX >= 0x030B0000
+    const char* func = PyUnicode_AsUTF8(code->co_qualname);
+#else
+    const char* func = PyUnicode_AsUTF8(code->co_name);
+#endif
+    if (!func) {
+        PyErr_Clear();
+        func = "?";
+    }
+    const char* file = PyUnicode_AsUTF8(code->co_filename);
+    if (!file) {
+        PyErr_Clear();
+        file = "?";
+    }
+    const char* base = strrchr(file, '/');
+    snprintf(buf, PROF_NAME_LEN, "%s (%s:%d)", func, base ? base + 1 : file, line);
+}
+
+static void prof_format_cfunc(char* buf, PyObject* func) {
+    PyCFunctionObject* cf = (PyCFunctionObject*)func;
+    const char* meth = cf->m_ml->ml_name;
+    PyObject* self = cf->m_self;
+
+    if (self && PyModule_Check(self)) {
+        const char* mod = PyModule_GetName(self);
+        if (!mod) {
+            PyErr_Clear();
+            mod = "?";
+        }
+        snprintf(buf, PROF_NAME_LEN, "%s.%s", mod, meth);
+    } else if (self) {
+        snprintf(buf, PROF_NAME_LEN, "%s.%s", Py_TYPE(self)->tp_name, meth);
+    } else {
+        snprintf(buf, PROF_NAME_LEN, "%s", meth);
+    }
+}
+
+/*
+ * 查找子节点，不存在时创建。
+ * source 用于首次创建时格式化名称（代码对象或 C 函数对象）。
+ * 节点表已满时返回 -1。
+ */
+static int32_t prof_child(int32_t parent, const void* key, int32_t line,
+                          ProfNodeKind kind, PyObject* source) {
+    size_t slot = prof_hash(parent, key, line) & g_prof.table_mask;
+
+    for (;;) {
+        int32_t idx = g_prof.table[slot];
+        if (idx < 0) {
+            break;
+        }
+        const ProfNode* n = &g_prof.nodes[idx];
+        if (n->key == key && n->parent == parent && n->line == line) {
+            return idx;
+        }
+        slot = (slot + 1) & g_prof.table_mask;
+    }
+
+    if (g_prof.node_count >= g_prof.max_nodes) {
+        return -1;
+    }
+
+    int32_t idx = (int32_t)g_prof.node_count++;
+    ProfNode* n = &g_prof.nodes[idx];
+    n->key = key;
+    n->parent = parent;
+    n->line = line;
+    n->kind = kind;
+    n->self_ns = 0;
+    n->owner = NULL;
+    if (kind == PROF_NODE_PY) {
+        Py_INCREF(source);
+        n->owner = source;
+        prof_format_code(n->name, (PyCodeObject*)source, line);
+    } else {
+        prof_format_cfunc(n->name, source);
+    }
+    g_prof.table[slot] = idx;
+    return idx;
+}
+
+static void prof_push(const void* key, int32_t line, ProfNodeKind kind, PyObject* source) {
+    if (g_prof.overflow_depth > 0) {
+        g_prof.overflow_depth++;
+        return;
+    }
+
+    int32_t idx = prof_child(g_prof.current, key, line, kind, source);
+    if (idx < 0) {
+        g_prof.dropped_count++;
+        g_prof.overflow_return = g_prof.current;
+        g_prof.overflow_depth = 1;
+        idx = PROF_OVERFLOW;
+    }
+    g_prof.current = idx;
+}
+
+static void prof_pop(void) {
+    if (g_prof.overflow_depth > 0) {
+        if (--g_prof.overflow_depth == 0) {
+            g_prof.current = g_prof.overflow_return;
+        }
+        return;
+    }
+
+    // 根节点之下不再回退（例如剖析在函数中途开始）
+    if (g_prof.current != PROF_ROOT) {
+        g_prof.current = g_prof.nodes[g_prof.current].parent;
+    }
+}
+
+// profile 钩子：函数进入/返回以及 C 函数调用
+static int prof_profile_func(PyObject* obj, PyFrameObject* frame, int what, PyObject* arg) {
+    (void)obj;
+
+    if (!g_prof.in_step) {
+        return 0;
+    }
+
+    prof_account();
+
+    switch (what) {
+        case PyTrace_CALL: {
+            PyCodeObject* code = PyFrame_GetCode(frame);
+            prof_push(code, PyFrame_GetLineNumber(frame), PROF_NODE_PY, (PyObject*)code);
+            Py_DECREF(code);
+            break;
+        }
+        case PyTrace_RETURN:
+            prof_pop();
+            break;
+        case PyTrace_C_CALL:
+            if (PyCFunction_Check(arg)) {
+                prof_push(((PyCFunctionObject*)arg)->m_ml, 0, PROF_NODE_C, arg);
+            }
+            break;
+        case PyTrace_C_RETURN:
+        case PyTrace_C_EXCEPTION:
+            if (PyCFunction_Check(arg)) {
+                prof_pop();
+            }
+            break;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+// trace 钩子：仅处理行事件，切换到同一函数的对应行节点
+static int prof_trace_func(PyObject* obj, PyFrameObject* frame, int what, PyObject* arg) {
+    (void)obj;
+    (void)arg;
+
+    if (what != PyTrace_LINE || !g_prof.in_step || g_prof.overflow_depth > 0) {
+        return 0;
+    }
+
+    prof_account();
+
+    const ProfNode* cur = &g_prof.nodes[g_prof.current];
+    if (cur->kind != PROF_NODE_PY) {
+        return 0;
+    }
+
+    PyCodeObject* code = PyFrame_GetCode(frame);
+    if ((const void*)code == cur->key) {
+        int line = PyFrame_GetLineNumber(frame);
+        if (line != cur->line) {
+            int32_t idx = prof_child(cur->parent, code, line, PROF_NODE_PY, (PyObject*)code);
+            if (idx >= 0) {
+                g_prof.current = idx;
+            } else {
+                g_prof.dropped_count++;
+            }
+        }
+    }
+    Py_DECREF(code);
+
+    return 0;
+}
+
+static void prof_init_fixed_nodes(void) {
+    ProfNode* root = &g_prof.nodes[PROF_ROOT];
+    memset(root, 0, sizeof(*root));
+    root->parent = -1;
+    root->kind = PROF_NODE_ROOT;
+    snprintf(root->name, PROF_NAME_LEN, "step()");
+
+    ProfNode* overflow = &g_prof.nodes[PROF_OVERFLOW];
+    memset(overflow, 0, sizeof(*overflow));
+    overflow->parent = PROF_ROOT;
+    overflow->kind = PROF_NODE_ROOT;
+    snprintf(overflow->name, PROF_NAME_LEN, "[overflow]");
+
+    g_prof.node_count = 2;
+    g_prof.current = PROF_ROOT;
+    g_prof.overflow_depth = 0;
+}
+
+int profiler_init(size_t max_nodes) {
+    if (g_prof.nodes) {
+        return 0;
+    }
+
+    if (max_nodes < 16) {
+        LOG_ERROR_MSG("剖析器节点上限过小：%zu", max_nodes);
+        return -1;
+    }
+
+    // 哈希表大小取不小于 2 倍节点数的 2 的幂，保证装载因子 <= 0.5
+    size_t table_size = 1;
+    while (table_size < max_nodes * 2) {
+        table_size <<= 1;
+    }
+
+    g_prof.nodes = (ProfNode*)calloc(max_nodes, sizeof(ProfNode));
+    g_prof.table = (int32_t*)malloc(table_size * sizeof(int32_t));
+    if (!g_prof.nodes || !g_prof.table) {
+        LOG_ERROR_MSG("剖析器初始化失败：内存分配失败");
+        free(g_prof.nodes);
+        free(g_prof.table);
+        g_prof.nodes = NULL;
+        g_prof.table = NULL;
+        return -1;
+    }
+
+    memset(g_prof.table, 0xFF, table_size * sizeof(int32_t));
+    g_prof.table_mask = table_size - 1;
+    g_prof.max_nodes = max_nodes;
+    prof_init_fixed_nodes();
+
+    LOG_INFO_MSG("剖析器初始化：节点上限=%zu", max_nodes);
+    return 0;
+}
+
+void profiler_cleanup(void) {
+    if (!g_prof.nodes) {
+        return;
+    }
+
+    profiler_stop();
+    profiler_reset();
+
+    free(g_prof.nodes);
+    free(g_prof.table);
+    memset(&g_prof, 0, sizeof(g_prof));
+}
+
+int profiler_start(void) {
+    if (!g_prof.nodes) {
+        LOG_ERROR_MSG("剖析器未初始化");
+        return -1;
+    }
+    if (g_prof.running) {
+        return 0;
+    }
+
+    PyEval_SetProfile(prof_profile_func, NULL);
+    PyEval_SetTrace(prof_trace_func, NULL);
+    g_prof.running = 1;
+    g_prof.in_step = 0;
+
+    LOG_INFO_MSG("剖析器已启动");
+    return 0;
+}
+
+void profiler_stop(void) {
+    if (!g_prof.running) {
+        return;
+    }
+
+    PyEval_SetProfile(NULL, NULL);
+    PyEval_SetTrace(NULL, NULL);
+    g_prof.running = 0;
+    g_prof.in_step = 0;
+    g_prof.current = PROF_ROOT;
+    g_prof.overflow_depth = 0;
+
+    LOG_INFO_MSG("剖析器已停止：已剖析 %llu 次 step()，节点 %zu/%zu",
+                 (unsigned long long)g_prof.sampled_steps,
+                 g_prof.node_count, g_prof.max_nodes);
+}
+
+int profiler_is_running(void) {
+    return g_prof.running;
+}
+
+void profiler_step_begin(void) {
+    if (!g_prof.running) {
+        return;
+    }
+
+    g_prof.current = PROF_ROOT;
+    g_prof.overflow_depth = 0;
+    g_prof.last_ns = prof_now_ns();
+    g_prof.in_step = 1;
+    g_prof.sampled_steps++;
+}
+
+void profiler_step_end(void) {
+    if (!g_prof.in_step) {
+        return;
+    }
+
+    prof_account();
+    g_prof.in_step = 0;
+    g_prof.current = PROF_ROOT;
+}
+
+void profiler_reset(void) {
+    if (!g_prof.nodes) {
+        return;
+    }
+
+    for (size_t i = 0; i < g_prof.node_count; i++) {
+        Py_XDECREF(g_prof.nodes[i].owner);
+    }
+    memset(g_prof.table, 0xFF, (g_prof.table_mask + 1) * sizeof(int32_t));
+    prof_init_fixed_nodes();
+
+    g_prof.event_count = 0;
+    g_prof.dropped_count = 0;
+    g_prof.sampled_steps = 0;
+}
+
+int profiler_dump_folded(const char* path) {
+    if (!path || !g_prof.nodes) {
+        return -1;
+    }
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        LOG_ERROR_MSG("无法写入剖析结果：%s", path);
+        return -1;
+    }
+
+    int32_t chain[PROF_MAX_DEPTH];
+    size_t lines = 0;
+
+    for (size_t i = 0; i < g_prof.node_count; i++) {
+        uint64_t us = (g_prof.nodes[i].self_ns + 500) / 1000;
+        if (us == 0) {
+            continue;
+        }
+
+        // 自底向上收集祖先，超出深度时截断最顶层部分
+        int depth = 0;
+        for (int32_t n = (int32_t)i; n >= 0 && depth < PROF_MAX_DEPTH; n = g_prof.nodes[n].parent) {
+            chain[depth++] = n;
+        }
+
+        for (int d = depth - 1; d >= 0; d--) {
+            fputs(g_prof.nodes[chain[d]].name, file);
+            fputc(d > 0 ? ';' : ' ', file);
+        }
+        fprintf(file, "%llu\n", (unsigned long long)us);
+        lines++;
+    }
+
+    fclose(file);
+
+    LOG_INFO_MSG("剖析结果已导出：%s（%zu 条栈，%llu 次 step()，丢弃 %llu 次）",
+                 path, lines, (unsigned long long)g_prof.sampled_steps,
+                 (unsigned long long)g_prof.dropped_count);
+    return 0;
+}
+
+void profiler_get_stats(ProfilerStats* stats) {
+    if (!stats) {
+        return;
+    }
+
+    stats->event_count = g_prof.event_count;
+    stats->dropped_count = g_prof.dropped_count;
+    stats->sampled_steps = g_prof.sampled_steps;
+    stats->node_count = g_prof.node_count;
+    stats->max_nodes = g_prof.max_nodes;
+    stats->running = g_prof.running;
+}
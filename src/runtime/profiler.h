@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file profiler.h
+ * @brief step() 行级性能剖析器
+ *
+ * 通过 C 级 profile/trace 钩子（Python 3.12+ 上由 sys.monitoring 承载）
+ * 将 step() 的耗时归属到脚本行和 C 函数调用（如 plcopen_c），在 C 侧
+ * 按调用上下文树聚合，可随时导出为 flamegraph 使用的折叠栈格式。
+ * 未启动时不安装任何钩子，对控制周期无额外开销。
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 剖析器统计信息
+typedef struct {
+    uint64_t event_count;    // 已处理的钩子事件数
+    uint64_t dropped_count;  // 因节点表已满而合并到溢出节点的次数
+    uint64_t sampled_steps;  // 已剖析的 step() 次数
+    size_t node_count;       // 已使用的调用上下文节点数
+    size_t max_nodes;        // 节点上限
+    int running;             // 钩子是否已安装
+} ProfilerStats;
+
+/**
+ * @brief 初始化剖析器（预分配节点表，不安装钩子）
+ * @param max_nodes 调用上下文树节点上限
+ * @return 0 成功，-1 失败
+ */
+int profiler_init(size_t max_nodes);
+
+/**
+ * @brief 释放剖析器资源（会先停止剖析）
+ */
+void profiler_cleanup(void);
+
+/**
+ * @brief 在当前线程安装剖析钩子
+ * @return 0 成功，-1 失败
+ *
+ * @note 必须在持有 GIL 的控制线程中、周期边界处调用
+ */
+int profiler_start(void);
+
+/**
+ * @brief 卸载剖析钩子（已聚合的数据保留）
+ */
+void profiler_stop(void);
+
+/**
+ * @brief 查询剖析钩子是否已安装
+ * @return 1 已安装，0 未安装
+ */
+int profiler_is_running(void);
+
+/**
+ * @brief 标记 step() 开始，此后的事件计入调用上下文树
+ */
+void profiler_step_begin(void);
+
+/**
+ * @brief 标记 step() 结束
+ */
+void profiler_step_end(void);
+
+/**
+ * @brief 清空已聚合的数据
+ */
+void profiler_reset(void);
+
+/**
+ * @brief 以折叠栈格式导出剖析结果
+ * @param path 输出文件路径
+ * @return 0 成功，-1 失败
+ *
+ * 每行格式为 "帧1;帧2;...;帧N 微秒数"，可直接输入 flamegraph.pl。
+ */
+int profiler_dump_folded(const char* path);
+
+/**
+ * @brief 获取剖析器统计信息
+ * @param stats 输出统计信息
+ */
+void profiler_get_stats(ProfilerStats* stats);
+
+#endif // PROFILER_H
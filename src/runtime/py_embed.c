@@ -28,6 +28,8 @@
 
 #include "py_embed.h"
 #include "logger.h"
+#include "profiler.h"
+#include "../function_blocks/fb_journal.h"
 #include <stdlib.h>
 #include <string.h>
 #include <libgen.h>
@@ -92,6 +94,8 @@ int py_embed_load_script(const char* script_path, PyEmbedContext* context) {
     context->module = NULL;
     context->init_func = NULL;
     context->step_func = NULL;
+    memset(&context->cycle_loop, 0, sizeof(CycleLoop));
+    memset(&context->tasks, 0, sizeof(PyTaskTable));
     context->initialized = 0;
 
     // 提取模块名（去除 .py 扩展名和路径）
@@ -143,9 +147,15 @@ int py_embed_load_script(const char* script_path, PyEmbedContext* context) {
         return -1;
     }
 
-    // 获取 step() 函数
+    // 获取 step() 函数（脚本注册了任务或在模块级挂接了网络时可省略）
     context->step_func = PyObject_GetAttrString(context->module, "step");
-    if (!context->step_func || !PyCallable_Check(context->step_func)) {
+    if (!context->step_func) {
+        PyErr_Clear();
+    }
+    if (!context->step_func &&
+        (py_tasks_registered_count() > 0 || py_networks_registered_count() > 0)) {
+        LOG_INFO_MSG("脚本未定义 step()，仅运行注册的任务和挂接的网络");
+    } else if (!context->step_func || !PyCallable_Check(context->step_func)) {
         LOG_ERROR_MSG("脚本缺少 step() 函数或函数不可调用");
         Py_DECREF(context->init_func);
         Py_XDECREF(context->step_func);
@@ -159,6 +169,91 @@ int py_embed_load_script(const char* script_path, PyEmbedContext* context) {
     return 0;
 }
 
+int py_embed_configure_pools(int capacity, int storage_kb) {
+    PyObject* module = PyImport_ImportModule("plcopen_c");
+    if (!module) {
+        PyErr_Clear();
+        LOG_WARNING_MSG("plcopen_c 扩展不可用，功能块实例池未预分配");
+        return -1;
+    }
+
+    PyObject* result = PyObject_CallMethod(module, "configure_pools", "in", capacity,
+                                           (Py_ssize_t)storage_kb * 1024);
+    Py_DECREF(module);
+    if (!result) {
+        LOG_WARNING_MSG("功能块实例池配置失败：容量 %d", capacity);
+        py_embed_handle_exception();
+        return -1;
+    }
+
+    Py_DECREF(result);
+    return 0;
+}
+
+void py_embed_log_pool_stats(void) {
+    PyObject* module = PyImport_ImportModule("plcopen_c");
+    PyObject* stats = module ? PyObject_CallMethod(module, "pool_stats", NULL) : NULL;
+    Py_XDECREF(module);
+    if (!stats || !PyDict_Check(stats)) {
+        PyErr_Clear();
+        Py_XDECREF(stats);
+        return;
+    }
+
+    PyObject* key;
+    PyObject* entry;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(stats, &pos, &key, &entry)) {
+        PyObject* capacity = PyDict_GetItemString(entry, "capacity");
+        PyObject* used = PyDict_GetItemString(entry, "used");
+        PyObject* peak = PyDict_GetItemString(entry, "peak");
+        PyObject* failures = PyDict_GetItemString(entry, "failures");
+        if (!capacity || !used || !peak || !failures) {
+            continue;
+        }
+        LOG_INFO_MSG("实例池 %s：容量=%zd，占用=%zd，峰值=%zd，分配失败=%llu",
+                     PyUnicode_AsUTF8(key), PyLong_AsSsize_t(capacity),
+                     PyLong_AsSsize_t(used), PyLong_AsSsize_t(peak),
+                     PyLong_AsUnsignedLongLong(failures));
+    }
+    Py_DECREF(stats);
+}
+
+int py_embed_dump_fb_timing(const char* path, int append) {
+    PyObject* module = PyImport_ImportModule("plcopen_c");
+    PyObject* count = module ? PyObject_CallMethod(module, "timing_dump", "si", path, append)
+                             : NULL;
+    Py_XDECREF(module);
+    if (!count) {
+        LOG_WARNING_MSG("扩展模块功能块计时导出失败");
+        py_embed_handle_exception();
+        return -1;
+    }
+
+    Py_DECREF(count);
+    return 0;
+}
+
+int py_embed_attach_journal(void) {
+    PyObject* module = PyImport_ImportModule("plcopen_c");
+    PyObject* capsule = module ? PyObject_GetAttrString(module, "_journal") : NULL;
+    Py_XDECREF(module);
+    FBJournal* journal =
+        capsule ? (FBJournal*)PyCapsule_GetPointer(capsule, FB_JOURNAL_CAPSULE_NAME) : NULL;
+    Py_XDECREF(capsule);
+    if (!journal) {
+        PyErr_Clear();
+        LOG_WARNING_MSG("扩展模块的功能块事件日志不可用，脚本中的功能块事件不汇总");
+        return -1;
+    }
+
+    if (fb_journal_add_source(journal, "脚本") != 0) {
+        LOG_WARNING_MSG("功能块事件汇总来源已满，脚本中的功能块事件不汇总");
+        return -1;
+    }
+    return 0;
+}
+
 int py_embed_call_init(PyEmbedContext* context) {
     if (!context || !context->initialized || !context->init_func) {
         LOG_ERROR_MSG("无效的 Python 上下文");
@@ -187,20 +282,49 @@ int py_embed_call_init(PyEmbedContext* context) {
 }
 
 int py_embed_call_step(PyEmbedContext* context) {
-    if (!context || !context->initialized || !context->step_func) {
+    if (!context || !context->initialized) {
         return -1;
     }
 
-    // 调用 step() 函数
-    PyObject* result = PyObject_CallObject(context->step_func, NULL);
+    int status = 0;
 
-    if (!result) {
-        LOG_ERROR_MSG("step() 函数执行失败");
-        py_embed_handle_exception();
-        return -1;
+    // 剖析器未启动时 begin/end 为空操作
+    profiler_step_begin();
+
+    // step() 之前执行的网络（无网络时立即返回）
+    py_networks_run(&context->networks, PY_NETWORK_BEFORE_STEP);
+
+    // 调用 step() 函数（async step() 由协程循环推进）
+    if (context->step_func && !cycle_loop_is_async_step(&context->cycle_loop)) {
+        PyObject* result = PyObject_CallObject(context->step_func, NULL);
+        if (result) {
+            Py_DECREF(result);
+        } else {
+            LOG_ERROR_MSG("step() 函数执行失败");
+            py_embed_handle_exception();
+            status = -1;
+        }
     }
 
-    Py_DECREF(result);
+    // 推进协程（无协程时立即返回）
+    if (cycle_loop_run_once(&context->cycle_loop) != 0) {
+        LOG_ERROR_MSG("周期协程执行失败");
+        status = -1;
+    }
+
+    // step() 之后执行的网络
+    py_networks_run(&context->networks, PY_NETWORK_AFTER_STEP);
+
+    // 执行本周期到期的多速率任务（无任务时立即返回）
+    if (py_tasks_run_due(&context->tasks) != 0) {
+        status = -1;
+    }
+
+    profiler_step_end();
+
+    if (status != 0) {
+        return -1;
+    }
 
     // 强制刷新 Python stdout，确保输出立即显示
     PyRun_SimpleString("import sys; sys.stdout.flush()");
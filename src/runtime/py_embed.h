@@ -32,12 +32,18 @@
 #define PY_EMBED_H
 
 #include <Python.h>
+#include "cycle_loop.h"
+#include "py_tasks.h"
+#include "py_networks.h"
 
 // Python 嵌入上下文
 typedef struct {
     PyObject* module;          // 用户脚本模块
     PyObject* init_func;       // init() 函数
-    PyObject* step_func;       // step() 函数
+    PyObject* step_func;       // step() 函数（注册了任务时可省略，为 NULL）
+    CycleLoop cycle_loop;      // 协程循环（async step() 与 spawn() 注册的协程）
+    PyTaskTable tasks;         // @plcopen.task 注册的多速率任务
+    PyNetworkTable networks;   // 挂接的 FBD 网络（attach() 与配置文件 network 节）
     int initialized;           // 是否已初始化
 } PyEmbedContext;
 
@@ -71,9 +77,44 @@ int py_embed_call_init(PyEmbedContext* context);
  * @brief 调用用户脚本的 step() 函数
  * @param context Python 上下文
  * @return 0 成功，-1 失败
+ *
+ * step() 为协程函数时不直接调用，而是由协程循环推进一次；
+ * 随后推进所有通过 plcopen.spawn() 注册的协程。
+ * 挂接的 FBD 网络按各自时机在 step() 之前/之后执行。
  */
 int py_embed_call_step(PyEmbedContext* context);
 
+/**
+ * @brief 按 performance.max_function_blocks 预分配扩展模块的功能块实例池
+ * @param capacity 每种功能块类型的槽位数
+ * @param storage_kb 附属存储区大小（performance.fb_storage_kb，0 表示按容量估算）
+ * @return 0 成功，-1 失败（扩展模块不可用或配置失败，已记录警告）
+ *
+ * 需在加载用户脚本之前调用，此后创建功能块不再调用系统分配器。
+ */
+int py_embed_configure_pools(int capacity, int storage_kb);
+
+/**
+ * @brief 记录扩展模块各实例池的占用情况
+ */
+void py_embed_log_pool_stats(void);
+
+/**
+ * @brief 把扩展模块中功能块的执行时间计数写入文件（仅 FB_TIMING 构建）
+ * @param path 输出文件路径
+ * @param append 1 追加，0 覆盖
+ * @return 0 成功，-1 失败
+ */
+int py_embed_dump_fb_timing(const char* path, int append);
+
+/**
+ * @brief 把扩展模块的功能块事件日志加入运行时的汇总线程
+ * @return 0 成功，-1 失败（扩展模块不可用或汇总来源已满）
+ *
+ * 扩展模块中的事件计数和变更记录由运行时按 logging.journal_flush_ms 汇总写入日志。
+ */
+int py_embed_attach_journal(void);
+
 /**
  * @brief 处理 Python 异常
  *
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_networks.c
+ * @brief 挂接到控制周期的 FBD 网络实现
+ *
+ * 运行时与 plcopen_c 扩展各自编译了一份 fb_network.c，两者源码相同、
+ * 结构体布局一致，因此可以用运行时的 fb_network_execute() 直接执行
+ * 扩展创建的网络；fb_st.c 同理。FB_TIMING 会改变 FunctionBlock 的布局，
+ * 挂接网络前检查两者的设置一致。
+ */
+
+#include "py_networks.h"
+#include "py_embed.h"
+#include "logger.h"
+#include "../function_blocks/fb_timing.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 获取 plcopen.network._attached（新引用），不可用时返回 NULL
+static PyObject* get_attached(void) {
+    PyObject* module = PyImport_ImportModule("plcopen.network");
+    if (!module) {
+        PyErr_Clear();
+        return NULL;
+    }
+
+    PyObject* attached = PyObject_GetAttrString(module, "_attached");
+    Py_DECREF(module);
+    if (!attached || !PyList_Check(attached)) {
+        PyErr_Clear();
+        Py_XDECREF(attached);
+        return NULL;
+    }
+
+    return attached;
+}
+
+// 扩展模块的 FB_TIMING 设置与运行时一致时返回 1（没有该属性的扩展视为未启用）
+static int timing_layout_matches(void) {
+    PyObject* module = PyImport_ImportModule("plcopen_c");
+    PyObject* flag = module ? PyObject_GetAttrString(module, "FB_TIMING") : NULL;
+    Py_XDECREF(module);
+    int extension = flag ? PyObject_IsTrue(flag) == 1 : 0;
+    Py_XDECREF(flag);
+    PyErr_Clear();
+
+    if (extension == fb_timing_enabled()) {
+        return 1;
+    }
+    LOG_ERROR_MSG("plcopen_c 扩展%s以 FB_TIMING 构建，运行时%s，功能块结构布局不一致",
+                  extension ? "" : "未", fb_timing_enabled() ? "已启用" : "未启用");
+    return 0;
+}
+
+size_t py_networks_registered_count(void) {
+    PyObject* attached = get_attached();
+    if (!attached) {
+        return 0;
+    }
+
+    size_t count = (size_t)PyList_GET_SIZE(attached);
+    Py_DECREF(attached);
+    return count;
+}
+
+int py_networks_init(PyNetworkTable* table, int base_period_ms) {
+    if (!table || base_period_ms <= 0) {
+        return -1;
+    }
+
+    memset(table, 0, sizeof(PyNetworkTable));
+    table->base_period_ms = base_period_ms;
+    return 0;
+}
+
+// 追加表项并计算分频系数
+static PyNetwork* append_item(PyNetworkTable* table, FBNetwork* net, STProgram* program,
+                              PyNetworkPhase phase, int period_ms) {
+    PyNetwork* items = (PyNetwork*)realloc(table->items, (table->count + 1) * sizeof(PyNetwork));
+    if (!items) {
+        LOG_ERROR_MSG("网络表扩容失败：内存分配失败");
+        return NULL;
+    }
+    table->items = items;
+
+    uint32_t divider = 1;
+    if (period_ms > 0) {
+        divider = (uint32_t)(period_ms / table->base_period_ms);
+        if (divider == 0 || period_ms % table->base_period_ms != 0) {
+            divider = divider ? divider : 1;
+            LOG_WARNING_MSG("网络周期 %d ms 不是控制周期 %d ms 的整数倍，按 %u 分频执行",
+                            period_ms, table->base_period_ms, divider);
+        }
+    }
+
+    PyNetwork* item = &table->items[table->count++];
+    item->owner = NULL;
+    item->net = net;
+    item->program = program;
+    item->phase = phase;
+    item->divider = divider;
+    item->dt = divider * table->base_period_ms / 1000.0;
+
+    const char* when = phase == PY_NETWORK_BEFORE_STEP ? "before_step" : "after_step";
+    if (program) {
+        LOG_INFO_MSG("挂接 ST 程序：%zu 条指令，%s 执行，周期 %u ms", program->code_count, when,
+                     divider * (unsigned)table->base_period_ms);
+    } else {
+        LOG_INFO_MSG("挂接 FBD 网络：%zu 个功能块，%s 执行，周期 %u ms", net->op_count, when,
+                     divider * (unsigned)table->base_period_ms);
+    }
+    return item;
+}
+
+int py_networks_add(PyNetworkTable* table, FBNetwork* net, PyNetworkPhase phase, int period_ms) {
+    if (!table || !net || !net->built || table->base_period_ms <= 0) {
+        return -1;
+    }
+
+    return append_item(table, net, NULL, phase, period_ms) ? 0 : -1;
+}
+
+int py_networks_load_attached(PyNetworkTable* table) {
+    if (!table || table->base_period_ms <= 0) {
+        return -1;
+    }
+
+    PyObject* attached = get_attached();
+    if (!attached) {
+        return 0;
+    }
+
+    Py_ssize_t n = PyList_GET_SIZE(attached);
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject* owner;
+        const char* phase;
+        int period_ms;
+
+        if (!PyArg_ParseTuple(PyList_GET_ITEM(attached, i), "Osi", &owner, &phase, &period_ms)) {
+            LOG_ERROR_MSG("网络挂接表第 %zd 项格式无效", i);
+            py_embed_handle_exception();
+            Py_DECREF(attached);
+            return -1;
+        }
+
+        // _capsule 的名称区分 FBD 网络和 ST 程序
+        PyObject* capsule = PyObject_GetAttrString(owner, "_capsule");
+        FBNetwork* net = NULL;
+        STProgram* program = NULL;
+        if (capsule && PyCapsule_IsValid(capsule, ST_PROGRAM_CAPSULE_NAME)) {
+            program = (STProgram*)PyCapsule_GetPointer(capsule, ST_PROGRAM_CAPSULE_NAME);
+        } else if (capsule) {
+            net = (FBNetwork*)PyCapsule_GetPointer(capsule, FB_NETWORK_CAPSULE_NAME);
+        }
+        Py_XDECREF(capsule);
+        if (!net && !program) {
+            LOG_ERROR_MSG("网络挂接表第 %zd 项不是 plcopen_c.Network 或 STProgram", i);
+            py_embed_handle_exception();
+            Py_DECREF(attached);
+            return -1;
+        }
+
+        if (net && !timing_layout_matches()) {
+            LOG_ERROR_MSG("网络挂接表第 %zd 项无法挂接：请用相同的 FB_TIMING 设置重新构建", i);
+            Py_DECREF(attached);
+            return -1;
+        }
+
+        // attach() 之后又修改过结构的网络需要重新构建
+        if (net && !net->built && fb_network_build(net) != 0) {
+            LOG_ERROR_MSG("网络挂接表第 %zd 项构建失败：%s", i, fb_network_last_error(net));
+            Py_DECREF(attached);
+            return -1;
+        }
+
+        PyNetworkPhase where = strcmp(phase, "before_step") == 0 ? PY_NETWORK_BEFORE_STEP
+                                                                 : PY_NETWORK_AFTER_STEP;
+        PyNetwork* item = append_item(table, net, program, where, period_ms);
+        if (!item) {
+            Py_DECREF(attached);
+            return -1;
+        }
+        Py_INCREF(owner);
+        item->owner = owner;
+    }
+
+    Py_DECREF(attached);
+    return 0;
+}
+
+void py_networks_run(PyNetworkTable* table, PyNetworkPhase phase) {
+    if (!table || table->count == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < table->count; i++) {
+        PyNetwork* item = &table->items[i];
+        if (item->phase != phase || table->tick % item->divider != 0) {
+            continue;
+        }
+        if (item->program) {
+            st_program_run(item->program);
+        } else {
+            fb_network_execute(item->net, item->dt);
+        }
+    }
+
+    if (phase == PY_NETWORK_AFTER_STEP) {
+        table->tick++;
+    }
+}
+
+void py_networks_cleanup(PyNetworkTable* table) {
+    if (!table) {
+        return;
+    }
+
+    for (size_t i = 0; i < table->count; i++) {
+        Py_XDECREF(table->items[i].owner);
+    }
+    free(table->items);
+    memset(table, 0, sizeof(PyNetworkTable));
+}
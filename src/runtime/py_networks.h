@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_networks.h
+ * @brief 挂接到控制周期的 FBD 网络
+ *
+ * 脚本通过 plcopen.network.attach() 挂接 plcopen_c.Network，运行时在 init()
+ * 返回后读取挂接表，经 PyCapsule 取得底层 FBNetwork 指针，之后每周期在
+ * step() 之前/之后直接调用 fb_network_execute()，不再经过 Python。
+ * 配置文件 network 节声明的网络也加入同一张表（纯 C 模式下只有这一个网络）。
+ * 挂接的 plcopen_c.STProgram（结构化文本程序）同样放在这张表中，按相同时机执行。
+ */
+
+#ifndef PY_NETWORKS_H
+#define PY_NETWORKS_H
+
+#include <Python.h>
+#include "../function_blocks/fb_network.h"
+#include "../function_blocks/fb_st.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// 网络执行时机
+typedef enum {
+    PY_NETWORK_BEFORE_STEP,    // step() 之前（Python 读取网络输出）
+    PY_NETWORK_AFTER_STEP      // step() 之后（Python 写入网络输入）
+} PyNetworkPhase;
+
+// 单个挂接的网络
+typedef struct {
+    PyObject* owner;           // plcopen_c.Network / STProgram 对象（持有引用，保证网络存活），
+                               // 配置声明的网络为 NULL（由运行时上下文持有）
+    FBNetwork* net;            // 底层网络（ST 程序为 NULL）
+    STProgram* program;        // 底层 ST 程序（FBD 网络为 NULL）
+    PyNetworkPhase phase;      // 执行时机
+    uint32_t divider;          // 相对控制周期的分频系数
+    double dt;                 // 每次执行的时间步长（秒）
+} PyNetwork;
+
+// 挂接表
+typedef struct {
+    PyNetwork* items;
+    size_t count;
+    int base_period_ms;        // 控制周期
+    uint64_t tick;             // 周期计数（AFTER_STEP 执行后递增）
+} PyNetworkTable;
+
+/**
+ * @brief 初始化空网络表（不调用 Python API，纯 C 模式也可使用）
+ * @param table 网络表
+ * @param base_period_ms 控制周期（毫秒）
+ * @return 0 成功，-1 失败
+ */
+int py_networks_init(PyNetworkTable* table, int base_period_ms);
+
+/**
+ * @brief 追加一个网络（不持有所有权）
+ * @param table 网络表
+ * @param net 已构建的网络
+ * @param phase 执行时机
+ * @param period_ms 执行周期（毫秒），0 表示每个控制周期
+ * @return 0 成功，-1 失败
+ */
+int py_networks_add(PyNetworkTable* table, FBNetwork* net, PyNetworkPhase phase, int period_ms);
+
+/**
+ * @brief 读取 plcopen.network 挂接表并追加到网络表
+ * @param table 网络表
+ * @return 0 成功（无网络也返回 0），-1 失败
+ *
+ * @note 在 init() 返回后调用，调用线程需持有 GIL
+ */
+int py_networks_load_attached(PyNetworkTable* table);
+
+/**
+ * @brief 查询脚本是否挂接了网络（用于允许省略 step()）
+ * @return 挂接的网络数量
+ */
+size_t py_networks_registered_count(void);
+
+/**
+ * @brief 执行指定时机上本周期到期的网络
+ * @param table 网络表
+ * @param phase 执行时机
+ */
+void py_networks_run(PyNetworkTable* table, PyNetworkPhase phase);
+
+/**
+ * @brief 释放网络表
+ * @param table 网络表
+ *
+ * @note 表中有脚本挂接的网络时调用线程需持有 GIL
+ */
+void py_networks_cleanup(PyNetworkTable* table);
+
+#endif // PY_NETWORKS_H
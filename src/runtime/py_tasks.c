@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_tasks.c
+ * @brief 装饰器注册的多速率 Python 任务实现
+ */
+
+#include "py_tasks.h"
+#include "py_embed.h"
+#include "logger.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// free-threaded 构建下任务组可以在独立线程中并行运行
+#if defined(Py_GIL_DISABLED) && !defined(PY_TASKS_THREADS)
+#define PY_TASKS_THREADS 1
+#endif
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int gcd_int(int a, int b) {
+    while (b != 0) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// 获取 plcopen.tasks._registry（新引用），不可用时返回 NULL
+static PyObject* get_registry(void) {
+    PyObject* module = PyImport_ImportModule("plcopen.tasks");
+    if (!module) {
+        PyErr_Clear();
+        return NULL;
+    }
+
+    PyObject* registry = PyObject_GetAttrString(module, "_registry");
+    Py_DECREF(module);
+    if (!registry || !PyList_Check(registry)) {
+        PyErr_Clear();
+        Py_XDECREF(registry);
+        return NULL;
+    }
+
+    return registry;
+}
+
+// 执行单个任务并更新统计
+static int run_task(PyTask* task) {
+    double start = now_ms();
+    PyObject* result = PyObject_CallObject(task->func, NULL);
+    double elapsed = now_ms() - start;
+
+    PyTaskStats* stats = &task->stats;
+    stats->run_count++;
+    stats->last_exec_ms = elapsed;
+    stats->total_exec_ms += elapsed;
+    if (elapsed > stats->max_exec_ms) {
+        stats->max_exec_ms = elapsed;
+    }
+    if (elapsed > task->period_ms) {
+        stats->overrun_count++;
+    }
+
+    if (!result) {
+        stats->error_count++;
+        LOG_ERROR_MSG("任务 %s 执行失败", task->name);
+        py_embed_handle_exception();
+        return -1;
+    }
+
+    Py_DECREF(result);
+    return 0;
+}
+
+#ifdef PY_TASKS_THREADS
+static int find_or_add_thread(PyTaskTable* table, const char* name) {
+    for (size_t i = 0; i < table->thread_count; i++) {
+        if (strcmp(table->threads[i].name, name) == 0) {
+            return (int)i;
+        }
+    }
+
+    PyTaskThread* th = &table->threads[table->thread_count];
+    strncpy(th->name, name, sizeof(th->name) - 1);
+    th->name[sizeof(th->name) - 1] = '\0';
+    th->table = table;
+    return (int)table->thread_count++;
+}
+
+static void timespec_add_ms(struct timespec* ts, int ms) {
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec += ts->tv_nsec / 1000000000L;
+        ts->tv_nsec %= 1000000000L;
+    }
+}
+
+static void* task_thread_main(void* arg) {
+    PyTaskThread* th = (PyTaskThread*)arg;
+    PyTaskTable* table = th->table;
+    int index = (int)(th - table->threads);
+
+    if (th->priority >= 1 && th->priority <= 99) {
+        struct sched_param param = { .sched_priority = th->priority };
+        int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (ret != 0) {
+            LOG_WARNING_MSG("任务线程 %s 设置实时优先级 %d 失败：%s",
+                            th->name, th->priority, strerror(ret));
+        }
+    }
+
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyThreadState* tstate = PyEval_SaveThread();
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    uint64_t tick = 0;
+
+    while (!__atomic_load_n(&table->stop, __ATOMIC_ACQUIRE)) {
+        timespec_add_ms(&next, th->tick_ms);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR) {
+        }
+        if (__atomic_load_n(&table->stop, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+
+        PyEval_RestoreThread(tstate);
+        for (size_t i = 0; i < table->task_count; i++) {
+            PyTask* task = &table->tasks[i];
+            if (task->thread_index == index && tick % task->divider == 0) {
+                run_task(task);
+            }
+        }
+        tstate = PyEval_SaveThread();
+        tick++;
+    }
+
+    PyEval_RestoreThread(tstate);
+    PyGILState_Release(gstate);
+    return NULL;
+}
+#endif
+
+size_t py_tasks_registered_count(void) {
+    PyObject* registry = get_registry();
+    if (!registry) {
+        return 0;
+    }
+
+    size_t count = (size_t)PyList_GET_SIZE(registry);
+    Py_DECREF(registry);
+    return count;
+}
+
+int py_tasks_init(PyTaskTable* table, int base_period_ms) {
+    if (!table || base_period_ms <= 0) {
+        return -1;
+    }
+
+    memset(table, 0, sizeof(PyTaskTable));
+    table->base_period_ms = base_period_ms;
+
+    PyObject* registry = get_registry();
+    if (!registry) {
+        return 0;
+    }
+
+    size_t n = (size_t)PyList_GET_SIZE(registry);
+    if (n == 0) {
+        Py_DECREF(registry);
+        return 0;
+    }
+
+    table->tasks = (PyTask*)calloc(n, sizeof(PyTask));
+    table->threads = (PyTaskThread*)calloc(n, sizeof(PyTaskThread));
+    if (!table->tasks || !table->threads) {
+        LOG_ERROR_MSG("任务表初始化失败：内存分配失败");
+        Py_DECREF(registry);
+        py_tasks_cleanup(table);
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        PyObject* func;
+        PyObject* thread_obj;
+        const char* name;
+        int period_ms, priority;
+
+        if (!PyArg_ParseTuple(PyList_GET_ITEM(registry, i), "OiisO",
+                              &func, &period_ms, &priority, &name, &thread_obj)) {
+            LOG_ERROR_MSG("任务注册表第 %zu 项格式无效", i);
+            py_embed_handle_exception();
+            Py_DECREF(registry);
+            py_tasks_cleanup(table);
+            return -1;
+        }
+
+        PyTask* task = &table->tasks[table->task_count++];
+        strncpy(task->name, name, sizeof(task->name) - 1);
+        Py_INCREF(func);
+        task->func = func;
+        task->period_ms = period_ms;
+        task->priority = priority;
+        task->thread_index = -1;
+
+        if (thread_obj != Py_None) {
+#ifdef PY_TASKS_THREADS
+            const char* thread_name = PyUnicode_AsUTF8(thread_obj);
+            if (!thread_name) {
+                py_embed_handle_exception();
+                Py_DECREF(registry);
+                py_tasks_cleanup(table);
+                return -1;
+            }
+            task->thread_index = find_or_add_thread(table, thread_name);
+#else
+            LOG_WARNING_MSG("任务 %s 指定了独立线程，但当前解释器带有 GIL，改在控制线程中执行",
+                            task->name);
+#endif
+        }
+    }
+    Py_DECREF(registry);
+
+    // 线程节拍取组内任务周期的最大公约数，线程优先级取组内最高优先级
+    for (size_t i = 0; i < table->task_count; i++) {
+        PyTask* task = &table->tasks[i];
+        if (task->thread_index >= 0) {
+            PyTaskThread* th = &table->threads[task->thread_index];
+            th->tick_ms = th->tick_ms ? gcd_int(th->tick_ms, task->period_ms) : task->period_ms;
+            if (task->priority > th->priority) {
+                th->priority = task->priority;
+            }
+        }
+    }
+
+    // 计算分频系数；控制线程中的任务周期取整到控制周期的整数倍
+    for (size_t i = 0; i < table->task_count; i++) {
+        PyTask* task = &table->tasks[i];
+        if (task->thread_index >= 0) {
+            task->divider = (uint32_t)(task->period_ms / table->threads[task->thread_index].tick_ms);
+            continue;
+        }
+
+        int divider = (task->period_ms + base_period_ms / 2) / base_period_ms;
+        if (divider < 1) {
+            divider = 1;
+        }
+        if (divider * base_period_ms != task->period_ms) {
+            LOG_WARNING_MSG("任务 %s 周期 %d ms 不是控制周期 %d ms 的整数倍，按 %d ms 执行",
+                            task->name, task->period_ms, base_period_ms, divider * base_period_ms);
+            task->period_ms = divider * base_period_ms;
+        }
+        task->divider = (uint32_t)divider;
+    }
+
+    // 按优先级降序稳定排序（任务数量很少，插入排序即可）
+    for (size_t i = 1; i < table->task_count; i++) {
+        PyTask key = table->tasks[i];
+        size_t j = i;
+        while (j > 0 && table->tasks[j - 1].priority < key.priority) {
+            table->tasks[j] = table->tasks[j - 1];
+            j--;
+        }
+        table->tasks[j] = key;
+    }
+
+    for (size_t i = 0; i < table->task_count; i++) {
+        const PyTask* task = &table->tasks[i];
+        LOG_INFO_MSG("注册任务：%s, 周期=%d ms, 优先级=%d, 线程=%s",
+                     task->name, task->period_ms, task->priority,
+                     task->thread_index >= 0 ? table->threads[task->thread_index].name : "控制线程");
+    }
+
+    return 0;
+}
+
+int py_tasks_start(PyTaskTable* table) {
+    if (!table) {
+        return -1;
+    }
+
+#ifdef PY_TASKS_THREADS
+    __atomic_store_n(&table->stop, 0, __ATOMIC_RELEASE);
+
+    for (size_t i = 0; i < table->thread_count; i++) {
+        PyTaskThread* th = &table->threads[i];
+        int ret = pthread_create(&th->thread, NULL, task_thread_main, th);
+        if (ret != 0) {
+            LOG_ERROR_MSG("任务线程 %s 启动失败：%s", th->name, strerror(ret));
+            return -1;
+        }
+        th->started = 1;
+        LOG_INFO_MSG("任务线程 %s 已启动：节拍=%d ms", th->name, th->tick_ms);
+    }
+#endif
+
+    return 0;
+}
+
+int py_tasks_run_due(PyTaskTable* table) {
+    if (!table || table->task_count == 0) {
+        return 0;
+    }
+
+    int status = 0;
+    uint64_t tick = table->tick++;
+
+    for (size_t i = 0; i < table->task_count; i++) {
+        PyTask* task = &table->tasks[i];
+        if (task->thread_index < 0 && tick % task->divider == 0) {
+            if (run_task(task) != 0) {
+                status = -1;
+            }
+        }
+    }
+
+    return status;
+}
+
+void py_tasks_cleanup(PyTaskTable* table) {
+    if (!table) {
+        return;
+    }
+
+    // 停止任务线程；等待期间释放解释器，以便线程完成当前任务
+    __atomic_store_n(&table->stop, 1, __ATOMIC_RELEASE);
+    if (table->threads) {
+        PyThreadState* tstate = PyEval_SaveThread();
+        for (size_t i = 0; i < table->thread_count; i++) {
+            if (table->threads[i].started) {
+                pthread_join(table->threads[i].thread, NULL);
+                table->threads[i].started = 0;
+            }
+        }
+        PyEval_RestoreThread(tstate);
+    }
+
+    for (size_t i = 0; i < table->task_count; i++) {
+        PyTask* task = &table->tasks[i];
+        const PyTaskStats* stats = &task->stats;
+        LOG_INFO_MSG("任务统计：%s, 执行=%llu, 平均=%.3f ms, 最大=%.3f ms, 超时=%llu, 异常=%llu",
+                     task->name, (unsigned long long)stats->run_count,
+                     stats->run_count ? stats->total_exec_ms / stats->run_count : 0.0,
+                     stats->max_exec_ms,
+                     (unsigned long long)stats->overrun_count,
+                     (unsigned long long)stats->error_count);
+        Py_CLEAR(task->func);
+    }
+
+    free(table->tasks);
+    free(table->threads);
+    memset(table, 0, sizeof(PyTaskTable));
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file py_tasks.h
+ * @brief 装饰器注册的多速率 Python 任务
+ *
+ * 脚本通过 @plcopen.task(period_ms=..., priority=...) 注册周期函数，
+ * 运行时按各自周期调度并在 C 侧统计每个任务的执行情况。
+ * 默认所有任务在控制线程中按基础周期分频执行（同一周期内按优先级从高到低）；
+ * 在 free-threaded（无 GIL）构建中，指定了 thread 的任务组在独立线程中运行。
+ */
+
+#ifndef PY_TASKS_H
+#define PY_TASKS_H
+
+#include <Python.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 单个任务的统计信息
+typedef struct {
+    uint64_t run_count;        // 执行次数
+    uint64_t error_count;      // 抛出异常的次数
+    uint64_t overrun_count;    // 执行时间超过自身周期的次数
+    double last_exec_ms;       // 最近一次执行时间（毫秒）
+    double max_exec_ms;        // 最大执行时间（毫秒）
+    double total_exec_ms;      // 累计执行时间（毫秒）
+} PyTaskStats;
+
+// 单个任务
+typedef struct {
+    char name[64];             // 任务名称
+    PyObject* func;            // 周期函数
+    int period_ms;             // 任务周期（毫秒）
+    int priority;              // 优先级（越大越先执行，线程任务组用作 SCHED_FIFO 优先级）
+    uint32_t divider;          // 相对所在调度节拍的分频系数
+    int thread_index;          // 所在任务线程下标，-1 表示控制线程
+    PyTaskStats stats;         // 统计信息
+} PyTask;
+
+// 任务线程（同一 thread 名称的任务组）
+typedef struct {
+    char name[64];             // 线程组名称
+    int tick_ms;               // 线程节拍（组内任务周期的最大公约数）
+    int priority;              // 组内最高优先级
+    pthread_t thread;          // 线程句柄
+    int started;               // 是否已启动
+    struct PyTaskTable* table; // 所属任务表
+} PyTaskThread;
+
+// 任务表
+typedef struct PyTaskTable {
+    PyTask* tasks;             // 按优先级降序排列
+    size_t task_count;
+    PyTaskThread* threads;
+    size_t thread_count;
+    int base_period_ms;        // 控制线程的基础周期
+    uint64_t tick;             // 控制线程节拍计数
+    volatile int stop;         // 任务线程停止标志
+} PyTaskTable;
+
+/**
+ * @brief 从 plcopen.tasks 注册表构建任务表
+ * @param table 任务表
+ * @param base_period_ms 控制周期（毫秒）
+ * @return 0 成功（无任务也返回 0），-1 失败
+ */
+int py_tasks_init(PyTaskTable* table, int base_period_ms);
+
+/**
+ * @brief 查询脚本是否注册了任务（用于允许省略 step()）
+ * @return 注册的任务数量
+ */
+size_t py_tasks_registered_count(void);
+
+/**
+ * @brief 启动任务线程（无线程任务组时为空操作）
+ * @param table 任务表
+ * @return 0 成功，-1 失败
+ *
+ * @note 调用线程需持有 GIL；任务线程只有在控制线程等待周期时才能运行 Python 代码
+ */
+int py_tasks_start(PyTaskTable* table);
+
+/**
+ * @brief 在控制线程执行本节拍到期的任务
+ * @param table 任务表
+ * @return 0 成功，-1 有任务抛出异常
+ */
+int py_tasks_run_due(PyTaskTable* table);
+
+/**
+ * @brief 停止任务线程、输出统计并释放任务表
+ * @param table 任务表
+ *
+ * @note 调用线程需持有 GIL
+ */
+void py_tasks_cleanup(PyTaskTable* table);
+
+#endif // PY_TASKS_H
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file record_session.c
+ * @brief 运行时的输入录制与回放实现
+ */
+
+#include <Python.h>
+#include "record_session.h"
+#include "logger.h"
+#include "py_embed.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// 复制文件；源文件不存在时删除目标并返回 1
+static int copy_file(const char* src, const char* dst) {
+    int in = open(src, O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        if (errno == ENOENT) {
+            unlink(dst);
+            return 1;
+        }
+        LOG_ERROR_MSG("无法读取 %s：%s", src, strerror(errno));
+        return -1;
+    }
+
+    int out = open(dst, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0) {
+        LOG_ERROR_MSG("无法写入 %s：%s", dst, strerror(errno));
+        close(in);
+        return -1;
+    }
+
+    char buffer[65536];
+    int rc = 0;
+    for (;;) {
+        ssize_t n = read(in, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            rc = n < 0 ? -1 : 0;
+            break;
+        }
+        for (ssize_t done = 0; done < n;) {
+            ssize_t w = write(out, buffer + done, (size_t)(n - done));
+            if (w < 0 && errno == EINTR) {
+                continue;
+            }
+            if (w < 0) {
+                rc = -1;
+                break;
+            }
+            done += w;
+        }
+        if (rc != 0) {
+            break;
+        }
+    }
+    if (rc != 0) {
+        LOG_ERROR_MSG("复制 %s 到 %s 失败：%s", src, dst, strerror(errno));
+    }
+
+    close(in);
+    close(out);
+    return rc;
+}
+
+int record_session_prepare_retain(RuntimeConfig* config) {
+    if (config->record_mode == RECORD_MODE_OFF || !config->retain_file[0]) {
+        return 0;
+    }
+
+    char snapshot[sizeof(config->record_file) + 16];
+    snprintf(snapshot, sizeof(snapshot), "%s.retain", config->record_file);
+
+    if (config->record_mode == RECORD_MODE_RECORD) {
+        return copy_file(config->retain_file, snapshot) < 0 ? -1 : 0;
+    }
+
+    char replay[sizeof(snapshot) + 8];
+    snprintf(replay, sizeof(replay), "%s.replay", snapshot);
+    if (copy_file(snapshot, replay) < 0) {
+        return -1;
+    }
+    if (strlen(replay) >= sizeof(config->retain_file)) {
+        LOG_ERROR_MSG("回放保持快照路径过长：%s", replay);
+        return -1;
+    }
+    LOG_INFO_MSG("回放使用保持快照 %s，不改写 %s", replay, config->retain_file);
+    memcpy(config->retain_file, replay, strlen(replay) + 1);
+    return 0;
+}
+
+int record_session_open(const RuntimeConfig* config) {
+    if (config->record_mode == RECORD_MODE_OFF) {
+        return 0;
+    }
+
+    const char* mode = config->record_mode == RECORD_MODE_RECORD ? "record" : "replay";
+    PyObject* module = PyImport_ImportModule("plcopen.record");
+    PyObject* rec = module ? PyObject_CallMethod(module, "open", "ssn", config->record_file, mode,
+                                                 (Py_ssize_t)config->record_buffer_kb * 1024)
+                           : NULL;
+    Py_XDECREF(module);
+    if (!rec) {
+        LOG_ERROR_MSG("录制文件打开失败：%s", config->record_file);
+        py_embed_handle_exception();
+        return -1;
+    }
+
+    Py_DECREF(rec);
+    return 0;
+}
+
+void record_session_attach(RecordSession* session) {
+    session->rec = NULL;
+    session->mode = RECORD_MODE_OFF;
+    session->owner = NULL;
+
+    PyObject* modules = PyImport_GetModuleDict();
+    PyObject* module = PyDict_GetItemString(modules, "plcopen.record");  // 借用引用
+    PyObject* rec = module ? PyObject_GetAttrString(module, "_recorder") : NULL;
+    if (!rec || rec == Py_None) {
+        PyErr_Clear();
+        Py_XDECREF(rec);
+        return;
+    }
+
+    PyObject* capsule = PyObject_GetAttrString(rec, "_capsule");
+    session->rec = capsule ? (FBRecorder*)PyCapsule_GetPointer(capsule, FB_RECORD_CAPSULE_NAME)
+                           : NULL;
+    Py_XDECREF(capsule);
+    if (!session->rec) {
+        PyErr_Clear();
+        Py_DECREF(rec);
+        LOG_WARNING_MSG("plcopen.record 当前句柄无效，不录制");
+        return;
+    }
+    session->owner = rec;
+
+    session->mode = fb_record_mode(session->rec) == FB_RECORD_MODE_RECORD ? RECORD_MODE_RECORD
+                                                                          : RECORD_MODE_REPLAY;
+}
+
+int record_session_check_open(RecordSession* session) {
+    PyObject* closed = PyObject_GetAttrString(session->owner, "closed");
+    int rc = closed ? PyObject_IsTrue(closed) : -1;
+    Py_XDECREF(closed);
+    if (rc == 0) {
+        return 1;
+    }
+
+    // 脚本调用了 plcopen.record.close()（读取失败同样按已关闭处理）
+    PyErr_Clear();
+    LOG_INFO_MSG("plcopen.record 句柄已关闭，停止%s", session->mode == RECORD_MODE_REPLAY
+                                                          ? "回放" : "录制");
+    session->rec = NULL;
+    session->mode = RECORD_MODE_OFF;
+    Py_CLEAR(session->owner);
+    return 0;
+}
+
+int record_session_report(RecordSession* session) {
+    if (!session->rec || !record_session_check_open(session)) {
+        return 0;
+    }
+
+    FBRecordStats stats;
+    fb_record_get_stats(session->rec, &stats);
+    if (session->mode == RECORD_MODE_RECORD) {
+        LOG_INFO_MSG("录制：%llu 个周期，%llu 条记录，%zu 个通道，丢弃 %llu 条",
+                     (unsigned long long)stats.cycles, (unsigned long long)stats.records,
+                     stats.channels, (unsigned long long)stats.dropped);
+        return 0;
+    }
+
+    FBRecordDivergence div;
+    fb_record_get_divergence(session->rec, &div);
+    if (!div.found) {
+        LOG_INFO_MSG("回放完成：%llu 个周期，%llu 条记录，输出全部一致%s",
+                     (unsigned long long)stats.cycles, (unsigned long long)stats.records,
+                     stats.finished ? "" : "（未回放到录制结尾）");
+        return 0;
+    }
+
+    LOG_ERROR_MSG("回放不一致：第 %llu 周期，通道 %s，录制值=%.17g，回放值=%.17g",
+                  (unsigned long long)div.cycle, div.channel, div.expected, div.actual);
+    return 1;
+}
+
+void record_session_close(RecordSession* session) {
+    if (!session->rec || !record_session_check_open(session)) {
+        return;
+    }
+
+    PyObject* module = PyImport_ImportModule("plcopen.record");
+    PyObject* result = module ? PyObject_CallMethod(module, "close", NULL) : NULL;
+    Py_XDECREF(module);
+    if (!result) {
+        py_embed_handle_exception();
+    }
+    Py_XDECREF(result);
+
+    session->rec = NULL;
+    session->mode = RECORD_MODE_OFF;
+    Py_CLEAR(session->owner);
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file record_session.h
+ * @brief 运行时的输入录制与回放
+ *
+ * 仅 Python 模式：加载脚本前调用 plcopen.record.open()，init() 返回后经
+ * PyCapsule 取得底层 FBRecorder 指针并持有 Recorder 对象的引用，每个周期
+ * 开始时在 C 中锁存周期时间（回放时取录制值）。脚本调用
+ * plcopen.record.close() 后不再锁存，回放随之结束、改回按周期定时运行。
+ * 回放不等待周期定时，录制结束或遇到缺口时停止，退出前报告第一个不一致。
+ */
+
+#ifndef RECORD_SESSION_H
+#define RECORD_SESSION_H
+
+#include <Python.h>
+#include "config.h"
+#include "../function_blocks/fb_record.h"
+#include <time.h>
+
+typedef struct {
+    FBRecorder* rec;       // 借用 plcopen.record 的句柄，未启用时为 NULL
+    RecordMode mode;
+    PyObject* owner;       // 句柄所属的 plcopen_c.Recorder 对象（持有引用，保证 close() 前不被释放）
+} RecordSession;
+
+/**
+ * @brief 让保持数据在录制和回放之间保持一致（在打开保持文件之前调用）
+ *
+ * 录制：把当前保持文件复制为 "<录制文件>.retain" 快照；
+ * 回放：把快照复制为 "<录制文件>.retain.replay" 并改用该文件，
+ * 回放从录制开始时的保持状态出发，也不会改写生产环境的保持文件。
+ *
+ * @param config 运行时配置（回放时修改 retain_file）
+ * @return 0 成功，-1 失败
+ */
+int record_session_prepare_retain(RuntimeConfig* config);
+
+/**
+ * @brief 在加载脚本前调用 plcopen.record.open()
+ * @param config 运行时配置（record.mode 为 off 时不启用）
+ * @return 0 成功或未启用，-1 失败
+ */
+int record_session_open(const RuntimeConfig* config);
+
+/**
+ * @brief init() 返回后取得 plcopen.record 当前打开的句柄
+ * @param session 输出（未打开时 rec 为 NULL）
+ */
+void record_session_attach(RecordSession* session);
+
+/**
+ * @brief 确认句柄仍然打开；脚本已关闭时释放引用并结束会话（持有 GIL 调用）
+ * @param session 会话
+ * @return 1 打开，0 已关闭
+ */
+int record_session_check_open(RecordSession* session);
+
+/**
+ * @brief 开始一个周期（控制线程在 step() 之前调用）
+ * @param session 会话
+ * @param cycle_start 周期开始时间（单调时钟）
+ * @return 0 继续，1 回放已结束
+ */
+static inline int record_session_begin_cycle(RecordSession* session,
+                                             const struct timespec* cycle_start) {
+    if (!session->rec || !record_session_check_open(session)) {
+        return 0;
+    }
+    double now = cycle_start->tv_sec + cycle_start->tv_nsec / 1e9;
+    return fb_record_begin_cycle(session->rec, now, NULL) != 0;
+}
+
+/**
+ * @brief 是否以回放方式运行（不等待周期定时）
+ * @param session 会话
+ * @return 1 回放，0 否
+ */
+static inline int record_session_replaying(const RecordSession* session) {
+    return session->rec && session->mode == RECORD_MODE_REPLAY;
+}
+
+/**
+ * @brief 输出录制统计；回放时报告第一个不一致
+ * @param session 会话
+ * @return 回放发现不一致时返回 1，否则 0
+ */
+int record_session_report(RecordSession* session);
+
+/**
+ * @brief 写出剩余记录并关闭（需持有 GIL、在解释器关闭前调用）
+ * @param session 会话
+ */
+void record_session_close(RecordSession* session);
+
+#endif // RECORD_SESSION_H
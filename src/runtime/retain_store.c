@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file retain_store.c
+ * @brief 运行时的保持变量检查点实现
+ */
+
+#include <Python.h>
+#include "retain_store.h"
+#include "logger.h"
+#include "py_embed.h"
+
+// 登记网络中全部有状态的功能块
+static int add_network_blocks(FBRetain* store, FBNetwork* net) {
+    size_t restored = 0;
+    size_t declared = 0;
+    for (size_t i = 0; i < net->block_count; i++) {
+        FBNetworkBlock* block = &net->blocks[i];
+        if (block->type == FB_TYPE_LIMIT || block->type == FB_TYPE_LOOKUP_1D) {
+            continue;  // 无状态
+        }
+        int rc = fb_retain_add_block(store, block->name, block->type, &block->fb);
+        if (rc < 0) {
+            return -1;
+        }
+        declared++;
+        restored += (size_t)rc;
+    }
+
+    LOG_INFO_MSG("网络保持功能块 %zu 个，从检查点恢复 %zu 个", declared, restored);
+    return 0;
+}
+
+int retain_store_open_network(RetainStore* retain, const RuntimeConfig* config, FBNetwork* net) {
+    retain->store = NULL;
+    retain->owned = 0;
+    retain->python = 0;
+    retain->owner = NULL;
+    retain->net = net;
+    if (!config->retain_file[0] || !net) {
+        return 0;
+    }
+
+    retain->store = fb_retain_open(config->retain_file, (size_t)config->retain_size_kb * 1024);
+    if (!retain->store) {
+        return -1;
+    }
+    retain->owned = 1;
+
+    if (add_network_blocks(retain->store, net) != 0 ||
+        fb_retain_start(retain->store, config->retain_period_ms) != 0) {
+        retain_store_close(retain);
+        return -1;
+    }
+    return 0;
+}
+
+int retain_store_open_python(const RuntimeConfig* config) {
+    if (!config->retain_file[0]) {
+        return 0;
+    }
+
+    PyObject* module = PyImport_ImportModule("plcopen.retain");
+    PyObject* store = module ? PyObject_CallMethod(module, "open", "sii", config->retain_file,
+                                                   config->retain_size_kb * 1024,
+                                                   config->retain_period_ms)
+                             : NULL;
+    Py_XDECREF(module);
+    if (!store) {
+        LOG_ERROR_MSG("保持文件打开失败：%s", config->retain_file);
+        py_embed_handle_exception();
+        return -1;
+    }
+
+    Py_DECREF(store);
+    return 0;
+}
+
+// Retain 对象是否已关闭（读取失败按已关闭处理）
+static int python_store_closed(PyObject* store) {
+    PyObject* closed = PyObject_GetAttrString(store, "closed");
+    int rc = closed ? PyObject_IsTrue(closed) : -1;
+    Py_XDECREF(closed);
+    if (rc < 0) {
+        PyErr_Clear();
+        return 1;
+    }
+    return rc;
+}
+
+// 取得 plcopen.retain._store（新引用），未导入、未打开或已关闭时返回 NULL
+static PyObject* current_python_store(void) {
+    PyObject* modules = PyImport_GetModuleDict();
+    PyObject* module = PyDict_GetItemString(modules, "plcopen.retain");  // 借用引用
+    if (!module) {
+        return NULL;
+    }
+
+    PyObject* store = PyObject_GetAttrString(module, "_store");
+    if (!store || store == Py_None || python_store_closed(store)) {
+        PyErr_Clear();
+        Py_XDECREF(store);
+        return NULL;
+    }
+    return store;
+}
+
+// 接管 Retain 对象（偷取 owner 的引用）的句柄并登记配置网络
+static void attach_owner(RetainStore* retain, PyObject* owner) {
+    PyObject* capsule = PyObject_GetAttrString(owner, "_capsule");
+    FBRetain* store = capsule ? (FBRetain*)PyCapsule_GetPointer(capsule, FB_RETAIN_CAPSULE_NAME)
+                              : NULL;
+    Py_XDECREF(capsule);
+    if (!store) {
+        PyErr_Clear();
+        Py_DECREF(owner);
+        LOG_WARNING_MSG("plcopen.retain 当前句柄无效，不捕获保持数据");
+        return;
+    }
+    retain->store = store;
+    retain->owner = owner;
+
+    // 键与脚本声明的保持项冲突时只告警，网络功能块不再保持
+    if (retain->net && add_network_blocks(retain->store, retain->net) != 0) {
+        LOG_WARNING_MSG("配置网络的功能块未能全部登记为保持项");
+    }
+
+    FBRetainStats stats;
+    fb_retain_get_stats(retain->store, &stats);
+    LOG_INFO_MSG("保持数据：%zu 项，占用 %zu/%zu 字节", stats.item_count, stats.used,
+                 stats.bank_size);
+}
+
+void retain_store_attach_python(RetainStore* retain, FBNetwork* net) {
+    retain->store = NULL;
+    retain->owned = 0;
+    retain->python = 1;
+    retain->owner = NULL;
+    retain->net = net;
+
+    // 脚本未在配置中启用、而是自行调用 plcopen.retain.open() 时同样接管
+    PyObject* owner = current_python_store();
+    if (owner) {
+        attach_owner(retain, owner);
+    }
+}
+
+int retain_store_python_open(RetainStore* retain) {
+    if (retain->owner) {
+        if (!python_store_closed(retain->owner)) {
+            return 1;
+        }
+        // 脚本调用了 plcopen.retain.close()，句柄已释放
+        LOG_INFO_MSG("plcopen.retain 句柄已关闭，停止捕获保持数据");
+        retain->store = NULL;
+        Py_CLEAR(retain->owner);
+    }
+
+    PyObject* owner = current_python_store();
+    if (!owner) {
+        return 0;
+    }
+    attach_owner(retain, owner);
+    return retain->store != NULL;
+}
+
+void retain_store_close(RetainStore* retain) {
+    if (!retain->store) {
+        Py_CLEAR(retain->owner);
+        retain->python = 0;
+        return;
+    }
+
+    if (retain->owned) {
+        fb_retain_close(retain->store);
+    } else {
+        // 句柄属于 Python 对象，经 plcopen.retain.close() 写入最终检查点
+        PyObject* module = PyImport_ImportModule("plcopen.retain");
+        PyObject* result = module ? PyObject_CallMethod(module, "close", NULL) : NULL;
+        Py_XDECREF(module);
+        if (!result) {
+            py_embed_handle_exception();
+        }
+        Py_XDECREF(result);
+    }
+
+    retain->store = NULL;
+    retain->owned = 0;
+    retain->python = 0;
+    Py_CLEAR(retain->owner);
+}
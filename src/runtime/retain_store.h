@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Hollysys Co., Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file retain_store.h
+ * @brief 运行时的保持变量检查点
+ *
+ * 纯 C 模式：运行时打开 retain.file，登记配置网络中全部有状态的功能块
+ * （以实例名为键）。Python 模式：运行时在加载脚本前调用
+ * plcopen.retain.open()，脚本自行声明保持项，init() 返回后经 PyCapsule
+ * 取得底层 FBRetain 指针，并持有 Retain 对象的引用；脚本调用
+ * plcopen.retain.close() 后停止捕获，之后再次 open() 时接管新的句柄。
+ * 两种模式下每个控制周期结束后都在 C 中捕获一次，写盘由后台线程完成，
+ * 控制线程不做 I/O。
+ */
+
+#ifndef RETAIN_STORE_H
+#define RETAIN_STORE_H
+
+#include <Python.h>
+#include "config.h"
+#include "../function_blocks/fb_network.h"
+#include "../function_blocks/fb_retain.h"
+
+typedef struct {
+    FBRetain* store;   // 保持文件句柄，未启用时为 NULL
+    int owned;         // 1：运行时打开（纯 C 模式）；0：借用 plcopen.retain 的句柄
+    int python;        // 1：Python 模式，每周期确认句柄仍然打开
+    PyObject* owner;   // 句柄所属的 plcopen_c.Retain 对象（持有引用，保证 close() 前不被释放）
+    FBNetwork* net;    // 接管新句柄时一并登记的配置网络
+} RetainStore;
+
+/**
+ * @brief 纯 C 模式：打开保持文件并登记网络中的功能块
+ * @param retain 输出
+ * @param config 运行时配置（retain.file 为空时不启用）
+ * @param net 配置声明的网络
+ * @return 0 成功或未启用，-1 失败
+ */
+int retain_store_open_network(RetainStore* retain, const RuntimeConfig* config, FBNetwork* net);
+
+/**
+ * @brief Python 模式：在加载脚本前调用 plcopen.retain.open()
+ * @param config 运行时配置（retain.file 为空时不启用）
+ * @return 0 成功或未启用，-1 失败
+ */
+int retain_store_open_python(const RuntimeConfig* config);
+
+/**
+ * @brief Python 模式：init() 返回后取得 plcopen.retain 当前打开的句柄
+ *
+ * 配置声明的网络中的功能块同时登记到该句柄（以实例名为键）。
+ *
+ * @param retain 输出（未打开时 store 为 NULL）
+ * @param net 配置声明的网络（可为 NULL）
+ */
+void retain_store_attach_python(RetainStore* retain, FBNetwork* net);
+
+/**
+ * @brief Python 模式：确认句柄仍然打开（持有 GIL 调用）
+ *
+ * 脚本已关闭当前句柄时释放对 Retain 对象的引用；plcopen.retain 又打开了
+ * 新的句柄时改为接管它。
+ *
+ * @param retain 句柄
+ * @return 1 可以捕获，0 没有打开的句柄
+ */
+int retain_store_python_open(RetainStore* retain);
+
+/**
+ * @brief 捕获一次检查点（控制线程每周期调用，无 I/O）
+ * @param retain 句柄
+ */
+static inline void retain_store_capture(RetainStore* retain) {
+    if (retain->owned || (retain->python && retain_store_python_open(retain))) {
+        fb_retain_capture(retain->store);
+    }
+}
+
+/**
+ * @brief 写入最终检查点并关闭（Python 模式需持有 GIL、在解释器关闭前调用）
+ * @param retain 句柄
+ */
+void retain_store_close(RetainStore* retain);
+
+#endif // RETAIN_STORE_H
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+"""
+继电器自整定（AutoTuner）校验与基准测试
+
+对若干一阶加纯滞后对象 K·e^(-Ls)/(Ts+1)：
+  1. 与纯 Python 参考实现逐周期比较继电器输出，结果 Ku/Tu/Kp/Ki/Kd 逐位一致；
+  2. Ku、Tu 与解析临界点比较（描述函数法对这类对象的典型误差在 25% 以内）；
+  3. 试验结束时 PID 无扰切回自动：切换周期的输出变化不超过继电器幅值，
+     按新参数闭环后 PV 回到设定值。
+计时比较 n 个回路每周期调用 PID.compute 与 AutoTuner.compute 的耗时。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/autotune.py --loops 200
+"""
+
+import argparse
+import math
+import os
+import sys
+import time
+from collections import deque
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+# (K, T, L)：增益、时间常数（秒）、纯滞后（秒）
+PLANTS = [(2.0, 5.0, 1.0), (0.8, 20.0, 4.0), (1.5, 2.0, 1.5), (3.0, 60.0, 5.0)]
+
+# 规则 -> (kp, ti, td)，与 C 实现相同
+RULES = {
+    "zn": (0.6, 0.5, 0.125),
+    "zn_pi": (0.45, 1.0 / 1.2, 0.0),
+    "tyreus_luyben": (1.0 / 2.2, 2.2, 1.0 / 6.3),
+    "some_overshoot": (0.33, 0.5, 1.0 / 3.0),
+    "no_overshoot": (0.2, 0.5, 1.0 / 3.0),
+}
+
+
+class Plant:
+    """一阶加纯滞后对象，前向欧拉离散"""
+
+    def __init__(self, K, T, L, dt, u0, pv0=20.0):
+        """从输入 u0 对应的稳态开始"""
+        self.K, self.T, self.dt, self.pv0 = K, T, dt, pv0
+        self.pv = pv0 + K * u0
+        self.queue = deque([u0] * max(1, round(L / dt)))
+
+    def step(self, u):
+        self.queue.append(u)
+        ud = self.queue.popleft()
+        self.pv += self.dt / self.T * (self.K * ud - (self.pv - self.pv0))
+        return self.pv
+
+
+class ReferenceTuner:
+    """纯 Python 参考实现，运算顺序与 C 实现相同"""
+
+    def __init__(self, relay, hysteresis, rule, cycles=3, tolerance=0.05, lo=0.0, hi=100.0):
+        self.relay, self.eps, self.rule = relay, hysteresis, rule
+        self.cycles, self.tol, self.lo, self.hi = cycles, tolerance, lo, hi
+
+    def start(self, sp, bias):
+        self.sp = sp
+        d = abs(self.relay)
+        self.u_high = min(max(bias + d, self.lo), self.hi)
+        self.u_low = min(max(bias - d, self.lo), self.hi)
+        self.high = False
+        self.elapsed = 0.0
+        self.last_rise = -1.0
+        self.pv_max, self.pv_min = -math.inf, math.inf
+        self.period = self.amplitude = 0.0
+        self.periods = self.consistent = 0
+        self.result = None
+        self.running = True
+
+    def compute(self, pv, dt):
+        self.elapsed += dt
+        self.pv_max = max(self.pv_max, pv)
+        self.pv_min = min(self.pv_min, pv)
+        error = self.sp - pv
+        if not self.high and error > self.eps:
+            self.high = True
+            if self.last_rise >= 0.0:
+                period = self.elapsed - self.last_rise
+                amplitude = (self.pv_max - self.pv_min) / 2.0
+                same = (self.periods > 0
+                        and abs(period - self.period) <= self.tol * abs(period)
+                        and abs(amplitude - self.amplitude) <= self.tol * abs(amplitude))
+                self.consistent = self.consistent + 1 if same else 1
+                self.period, self.amplitude = period, amplitude
+                self.periods += 1
+            self.last_rise = self.elapsed
+            self.pv_max = self.pv_min = pv
+        elif self.high and error < -self.eps:
+            self.high = False
+        out = self.u_high if self.high else self.u_low
+        if self.consistent >= self.cycles:
+            a, eps = self.amplitude, self.eps
+            d = (self.u_high - self.u_low) / 2.0
+            ku = 4.0 * abs(d) / (3.14159265358979323846 * math.sqrt(a * a - eps * eps))
+            kp_f, ti_f, td_f = RULES[self.rule]
+            kp = kp_f * ku
+            self.result = {"Kp": kp, "Ki": kp / (ti_f * self.period),
+                           "Kd": kp * td_f * self.period, "Ku": ku, "Tu": self.period}
+            self.running = False
+        return out
+
+
+def ultimate_point(K, T, L):
+    """解析临界点：atan(wT) + wL = pi"""
+    w = 1.0 / L
+    for _ in range(100):
+        f = math.atan(w * T) + w * L - math.pi
+        w -= f / (T / (1.0 + (w * T) ** 2) + L)
+    return math.sqrt(1.0 + (w * T) ** 2) / K, 2.0 * math.pi / w
+
+
+def run_case(PID, AutoTuner, K, T, L, rule):
+    """整定一个回路，返回不一致项列表"""
+    dt = min(0.05, L / 20.0)
+    bias = 50.0
+    plant = Plant(K, T, L, dt, bias)
+    sp = plant.pv
+    problems = []
+
+    # 整定前的保守参数；偏置取稳态输出，继电器在输出范围内对称
+    pid = PID(Kp=0.2 / K, Ki=0.05 / (K * T), Kd=0.0, output_min=0.0, output_max=100.0)
+    tuner = AutoTuner(pid, relay=10.0, hysteresis=0.1, rule=rule, timeout=200 * (T + L))
+    ref = ReferenceTuner(10.0, 0.1, rule)
+    tuner.start(sp, bias)
+    ref.start(sp, bias)
+
+    u = tuner.output
+    while tuner.running:
+        pv = plant.pv
+        u = tuner.compute(pv, dt)
+        if ref.compute(pv, dt) != u:
+            problems.append("继电器输出不一致")
+            break
+        plant.step(u)
+
+    if tuner.state != "done" or tuner.result != ref.result:
+        problems.append(f"结果不一致：{tuner.result} / {ref.result}")
+        return problems, None
+
+    ku, tu = ultimate_point(K, T, L)
+    err = max(abs(tuner.Ku - ku) / ku, abs(tuner.Tu - tu) / tu)
+    if err > 0.25:
+        problems.append(f"Ku/Tu 偏离解析值 {err:.0%}")
+
+    # 无扰切换：切回自动后的第一个输出不应跳变
+    first = pid.compute(sp, plant.pv, dt)
+    if abs(first - u) > 10.0:
+        problems.append(f"切换跳变 {first - u:+.2f}")
+    plant.step(first)
+    for _ in range(round(30 * (T + L) / dt)):
+        plant.step(pid.compute(sp, plant.pv, dt))
+    if abs(plant.pv - sp) > 0.5:
+        problems.append(f"闭环未稳定 PV={plant.pv:.2f}")
+    return problems, err
+
+
+def main():
+    parser = argparse.ArgumentParser(description="继电器自整定校验与基准测试")
+    parser.add_argument("--loops", type=int, default=200, help="计时回路数（默认 200）")
+    parser.add_argument("--cycles", type=int, default=2000, help="计时周期数（默认 2000）")
+    args = parser.parse_args()
+
+    from plcopen_c import PID, AutoTuner
+
+    failures = 0
+    print(f"{'对象 (K, T, L)':<22}{'规则':<16}{'Ku/Tu 偏差':>12}  结果")
+    for K, T, L in PLANTS:
+        for rule in RULES:
+            problems, err = run_case(PID, AutoTuner, K, T, L, rule)
+            failures += bool(problems)
+            err_text = "-" if err is None else f"{err:.1%}"
+            print(f"{str((K, T, L)):<22}{rule:<16}{err_text:>12}  {'; '.join(problems) or '通过'}")
+    print(f"一致性校验：{len(PLANTS) * len(RULES)} 个试验，失败 {failures}")
+
+    n = args.loops
+    pids = [PID(Kp=1.0, Ki=0.2, Kd=0.0, output_min=0.0, output_max=100.0) for _ in range(n)]
+    tuners = [AutoTuner(p, relay=10.0, hysteresis=0.1, cycles=100, tolerance=1e-9)
+              for p in pids]
+    for t in tuners:
+        t.start(50.0, 50.0)
+    pv = [50.0 + (i % 7) - 3.0 for i in range(n)]
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        for i, p in enumerate(pids):
+            p.compute(50.0, pv[i], 0.01)
+    pid_ns = (time.perf_counter() - start) / (args.cycles * n) * 1e9
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        for i, t in enumerate(tuners):
+            t.compute(pv[i], 0.01)
+    tune_ns = (time.perf_counter() - start) / (args.cycles * n) * 1e9
+
+    print(f"{n} 个回路，每回路每周期：")
+    print(f"PID.compute：        {pid_ns:8.1f} ns")
+    print(f"AutoTuner.compute：  {tune_ns:8.1f} ns（含手动跟踪的 PID 计算）")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
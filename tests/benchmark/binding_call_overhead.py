@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""
+功能块绑定调用开销基准测试
+
+测量 plcopen_c 功能块构造和 compute() 等方法每次调用的耗时（纳秒），
+用于比较绑定实现（如 METH_VARARGS 与 METH_FASTCALL/vectorcall）的差异。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/binding_call_overhead.py --save before.json
+    # 修改绑定并重新构建后
+    python3 tests/benchmark/binding_call_overhead.py --compare before.json
+"""
+
+import argparse
+import json
+import os
+import sys
+import timeit
+
+# 优先使用仓库根目录下就地构建的扩展
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+import plcopen_c  # noqa: E402
+
+SETUP = """
+from array import array
+from plcopen_c import PID, FirstOrder, Ramp, Limit
+pid = PID(Kp=2.0, Ki=0.5, Kd=0.1, output_min=0.0, output_max=100.0)
+fo = FirstOrder(T=1.0)
+ramp = Ramp(rising_rate=1.0, falling_rate=1.0)
+lim = Limit(min_value=0.0, max_value=100.0)
+sp = 25.0
+pv = 20.0
+try:
+    from plcopen_c import FirstOrderArray, LimitArray
+    lims = [Limit(0.0, 100.0) for _ in range(64)]
+    lim64 = LimitArray(64, 0.0, 100.0)
+    fo64 = FirstOrderArray(64, T=1.0)
+    ai = array("d", range(64))
+    ao = array("d", bytes(8 * 64))
+except ImportError:
+    pass
+try:
+    from plcopen_c import Network
+    net = Network()
+    net.add_input("sp", sp)
+    net.add_input("pv", pv)
+    net.add_block("pid", "PID", Kp=2.0, Ki=0.5, Kd=0.1,
+                  output_min=0.0, output_max=100.0)
+    net.add_block("lim", "Limit", min_value=0.0, max_value=80.0)
+    net.add_block("ramp", "Ramp", rising_rate=1.0, falling_rate=1.0)
+    net.connect("sp", "pid.SP")
+    net.connect("pv", "pid.PV")
+    net.connect("pid.CV", "lim.in")
+    net.connect("lim.out", "ramp.in")
+    net.build()
+except ImportError:
+    pass
+try:
+    import os
+    from plcopen_c import Recorder
+    rec = Recorder(os.devnull, "record", 1 << 22)
+    rec.cycle()
+except ImportError:
+    pass
+"""
+
+# 基准项：名称 -> 语句
+CASES = {
+    "PID.compute(sp, pv)": "pid.compute(sp, pv)",
+    "FirstOrder.compute(x)": "fo.compute(pv)",
+    "Ramp.compute(x, dt)": "ramp.compute(sp, 0.1)",
+    "Ramp.compute(input=, dt=)": "ramp.compute(input=sp, dt=0.1)",
+    "Limit.compute(x)": "lim.compute(sp)",
+    "Limit.compute(input=)": "lim.compute(input=sp)",
+    "PID.set_params(Kp=)": "pid.set_params(Kp=2.0)",
+    "PID(...)": "PID(2.0, 0.5, 0.1, 0.0, 100.0)",
+    "PID(Kp=, Ki=)": "PID(Kp=2.0, Ki=0.5)",
+    "FirstOrder(T=)": "FirstOrder(T=1.0)",
+    "Limit(...)": "Limit(0.0, 100.0)",
+    "PID.get_state()": "pid.get_state()",
+    "PID.integral": "pid.integral",
+    "PID.state.integral": "pid.state.integral",
+    "64 x Limit.compute(x)": "for i in range(64): ao[i] = lims[i].compute(ai[i])",
+    "LimitArray(64).compute": "lim64.compute(ai, ao)",
+    "FirstOrderArray(64).compute": "fo64.compute(ai, ao, 0.01)",
+    "PID->Limit->Ramp (Python)":
+        "ramp.compute(lim.compute(pid.compute(sp, pv, 0.1)), 0.1)",
+    "PID->Limit->Ramp (Network)": "net.execute(0.1)",
+    "Recorder.input(name, x)": "rec.input('pv', pv)",
+    "Recorder.output(name, x)": "rec.output('cv', sp)",
+}
+
+
+def measure(stmt: str, number: int, repeat: int) -> float:
+    """
+    测量单条语句每次执行的耗时
+
+    Args:
+        stmt: 被测语句
+        number: 每轮执行次数
+        repeat: 轮数（取最小值以降低噪声）
+
+    Returns:
+        每次调用耗时（纳秒）
+    """
+    timer = timeit.Timer(stmt, setup=SETUP)
+    best = min(timer.repeat(repeat=repeat, number=number))
+    return best / number * 1e9
+
+
+def main():
+    parser = argparse.ArgumentParser(description="功能块绑定调用开销基准测试")
+    parser.add_argument(
+        "--number",
+        type=int,
+        default=200000,
+        help="每轮调用次数（默认 200000）",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=7,
+        help="重复轮数，取最小值（默认 7）",
+    )
+    parser.add_argument("--save", help="把结果保存为 JSON 文件")
+    parser.add_argument("--compare", help="与之前保存的 JSON 结果比较")
+
+    args = parser.parse_args()
+
+    baseline = {}
+    if args.compare:
+        with open(args.compare, "r", encoding="utf-8") as f:
+            baseline = json.load(f)
+
+    print(f"Python {sys.version.split()[0]}, 模块 {plcopen_c.__file__}")
+    if baseline:
+        print(f"{'调用':<28}{'基线 ns':>10}{'当前 ns':>10}{'加速比':>8}")
+    else:
+        print(f"{'调用':<28}{'ns/调用':>10}")
+
+    results = {}
+    for name, stmt in CASES.items():
+        try:
+            ns = measure(stmt, args.number, args.repeat)
+        except (NameError, AttributeError):
+            # 当前构建不提供该接口（如与旧版本比较时）
+            print(f"{name:<28}{'-':>10}")
+            continue
+        results[name] = ns
+        if name in baseline:
+            print(f"{name:<28}{baseline[name]:>10.1f}{ns:>10.1f}"
+                  f"{baseline[name] / ns:>7.2f}x")
+        else:
+            print(f"{name:<28}{ns:>10.1f}")
+
+    if args.save:
+        with open(args.save, "w", encoding="utf-8") as f:
+            json.dump(results, f, indent=2, ensure_ascii=False)
+        print(f"结果已保存：{args.save}")
+
+    return 0
+
+
+if __name__ == "__main__":
+    exit(main())
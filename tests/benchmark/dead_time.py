@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""
+纯滞后基准测试
+
+比较脚本中常见的 list.pop(0) 延迟队列、n 个 DeadTime 实例和一个
+DeadTimeArray 模拟 n 条输送线延迟的每周期耗时，并逐周期校验三者输出一致。
+另校验 DeadTime 缓冲区从附属存储区分配：占用按块计入 pool_stats()["storage"]，
+存储区不足时抛出 MemoryError，释放后相邻空闲块合并复用。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/dead_time.py --lines 100 --delay 30
+"""
+
+import argparse
+import os
+import random
+import sys
+import time
+from array import array
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+
+class ListDelay:
+    """原脚本写法：每周期 append + pop(0)"""
+
+    def __init__(self, steps: int):
+        self.queue = [0.0] * steps
+
+    def compute(self, x: float) -> float:
+        self.queue.append(x)
+        return self.queue.pop(0)
+
+
+def verify_storage(pc):
+    problems = []
+    pc.configure_pools(64, 64 * 1024)
+    used = lambda: pc.pool_stats()["storage"]["used"]
+    chunk = 64 + 128 * 8          # 块头 + 101 个周期取整到 128 个样本
+
+    blocks = []
+    try:
+        while len(blocks) < 64:
+            blocks.append(pc.DeadTime(0.1, 0.001))
+    except MemoryError:
+        pass
+    if len(blocks) != 64 * 1024 // chunk or used() != len(blocks) * chunk:
+        problems.append(f"存储区填满时创建 {len(blocks)} 个、占用 {used()} 字节，"
+                        f"应为 {64 * 1024 // chunk} 个、{64 * 1024 // chunk * chunk} 字节")
+
+    del blocks[::2]
+    blocks[0].__init__(0.05, 0.001)   # 64 个样本，放入第一个空洞
+    if used() != len(blocks) * chunk - 512:
+        problems.append(f"__init__ 缩小缓冲区后占用 {used()} 字节，"
+                        f"应为 {len(blocks) * chunk - 512}")
+    try:
+        pc.DeadTime(3.0, 0.001)
+        problems.append("存储区碎片化时创建 32 KB 缓冲区应抛出 MemoryError")
+    except MemoryError:
+        pass
+    del blocks[:]
+    try:
+        big = pc.DeadTime(3.0, 0.001)
+        del big
+    except MemoryError:
+        problems.append("全部释放后空闲块未合并，无法创建 32 KB 缓冲区")
+    if used() != 0:
+        problems.append(f"全部释放后存储区占用 {used()} 字节，应为 0")
+
+    print(f"附属存储区：{'通过' if not problems else '失败'}")
+    return problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description="纯滞后基准测试")
+    parser.add_argument("--lines", type=int, default=100, help="输送线条数（默认 100）")
+    parser.add_argument("--delay", type=float, default=30.0, help="延迟时间（秒，默认 30）")
+    parser.add_argument("--period", type=float, default=0.01, help="采样周期（秒，默认 0.01）")
+    parser.add_argument("--cycles", type=int, default=2000, help="计时周期数（默认 2000）")
+    args = parser.parse_args()
+
+    import plcopen_c as pc
+    from plcopen_c import DeadTime, DeadTimeArray
+
+    failures = verify_storage(pc)
+    for p in failures:
+        print(f"  {p}")
+
+    n = args.lines
+    steps = round(args.delay / args.period)
+    # 每个实例的缓冲区按 2 的幂取整，最多为 2 * (steps + 2) 个样本
+    pc.configure_pools(max(n, 64), n * (64 + 16 * (steps + 2)) + (1 << 20))
+    lists = [ListDelay(steps) for _ in range(n)]
+    blocks = [DeadTime(args.delay, args.period) for _ in range(n)]
+    bank = DeadTimeArray(n, args.delay, args.period)
+
+    print(f"{n} 条输送线，延迟 {steps} 个周期，缓冲区 {bank.capacity} 个样本")
+
+    rng = random.Random(1)
+    mismatches = 0
+    for _ in range(steps + 200):
+        x = array("d", (rng.uniform(0.0, 100.0) for _ in range(n)))
+        out = bank.compute(x)
+        for i in range(n):
+            expected = lists[i].compute(x[i])
+            if blocks[i].compute(x[i]) != expected or out[i] != expected:
+                mismatches += 1
+    print(f"一致性校验：{steps + 200} 周期，不一致 {mismatches}")
+
+    x = array("d", (rng.uniform(0.0, 100.0) for _ in range(n)))
+    out = array("d", bytes(8 * n))
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        for i, q in enumerate(lists):
+            q.compute(x[i])
+    list_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        for i, b in enumerate(blocks):
+            b.compute(x[i])
+    block_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        bank.compute(x, out)
+    bank_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    print(f"list.pop(0)：         {list_us:10.2f} us/周期")
+    print(f"{n} 个 DeadTime：     {block_us:10.2f} us/周期（{list_us / block_us:.1f}x）")
+    print(f"DeadTimeArray：       {bank_us:10.2f} us/周期（{list_us / bank_us:.1f}x）")
+
+    return 1 if mismatches or failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+功能块执行时间计数（FB_TIMING）校验与基准测试
+
+校验：
+  以 FB_TIMING=1 构建时：
+    1. PID / Limit / TON / KalmanFilter 实例和网络中的功能块，调用次数与实际
+       调用次数一致，max_ns ≥ mean_ns > 0，total_ns = mean_ns × calls；
+    2. timing_reset() 清零所有计数，timing_dump() 按累计耗时降序写出表格。
+  未启用时：timing 属性为 None，timing() 为空列表，timing_dump() 抛出 RuntimeError。
+计时比较每次 compute 调用（含 Python 调用开销）和网络中每个功能块的耗时，
+分别以两种构建各运行一次即可得到计数本身的开销。
+
+用法:
+    python3 setup.py build_ext --inplace --force
+    python3 tests/benchmark/fb_timing.py
+    FB_TIMING=1 python3 setup.py build_ext --inplace --force
+    python3 tests/benchmark/fb_timing.py
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+import time
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+
+def make_network(pc):
+    net = pc.Network()
+    net.add_input("sp", 50.0)
+    net.add_input("pv", 20.0)
+    net.add_block("pid", "PID", Kp=2.0, Ki=0.5, output_min=0.0, output_max=100.0)
+    net.add_block("lim", "Limit", min_value=0.0, max_value=80.0)
+    net.add_block("ramp", "Ramp", rising_rate=5.0, falling_rate=5.0)
+    net.connect("sp", "pid.SP")
+    net.connect("pv", "pid.PV")
+    net.connect("pid.CV", "lim.in")
+    net.connect("lim.out", "ramp.in")
+    net.add_output("valve", "ramp.out")
+    net.build()
+    return net
+
+
+def check(name, timing, calls):
+    """返回问题描述，没有问题时返回空串"""
+    if timing is None:
+        return f"{name}：timing 为 None"
+    if timing["calls"] != calls:
+        return f"{name}：calls={timing['calls']}，应为 {calls}"
+    if calls and not timing["max_ns"] >= timing["mean_ns"] > 0.0:
+        return f"{name}：max_ns={timing['max_ns']:.1f} mean_ns={timing['mean_ns']:.1f}"
+    if abs(timing["total_ns"] - timing["mean_ns"] * calls) > 1e-6 * timing["total_ns"]:
+        return f"{name}：total_ns 与 mean_ns × calls 不符"
+    return ""
+
+
+def verify_enabled(pc, cycles):
+    problems = []
+    pid = pc.PID(Kp=1.0, Ki=0.2, Kd=0.05, output_min=0.0, output_max=100.0)
+    pid.name = "bench_pid"
+    lim = pc.Limit(0.0, 10.0)
+    ton = pc.TON(0.05)
+    kf = pc.KalmanFilter(F=[[1.0]], H=[[1.0]], Q=[[1e-3]], R=[0.1])
+    net = make_network(pc)
+
+    for k in range(cycles):
+        pid.compute(50.0, float(k % 100), 0.01)
+        lim.compute(float(k % 20))
+        ton.compute(k % 10 < 7, 0.01)
+        kf.compute([float(k % 3)])
+        net.execute(0.01)
+
+    for name, block in (("PID", pid), ("Limit", lim), ("TON", ton), ("KalmanFilter", kf)):
+        problems.append(check(name, block.timing, cycles))
+
+    by_name = {item["name"]: item for item in pc.timing()}
+    for name in ("pid", "lim", "ramp"):
+        problems.append(check(f"网络 {name}", by_name.get(name), cycles))
+    if by_name.get("bench_pid", {}).get("object") is not pid:
+        problems.append("timing() 中 bench_pid 的 object 不是该实例")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "fb_timing.txt")
+        count = pc.timing_dump(path)
+        rows = [line.split() for line in open(path, encoding="utf-8")
+                if not line.startswith("#")]
+        totals = [float(row[4]) for row in rows]
+        if count != len(pc.timing()) or len(rows) != count:
+            problems.append(f"timing_dump() 导出 {count} 行，文件中 {len(rows)} 行")
+        elif totals != sorted(totals, reverse=True):
+            problems.append("timing_dump() 未按累计耗时降序")
+
+    pc.timing_reset()
+    if any(item["calls"] for item in pc.timing()) or pid.timing["max_ns"] != 0.0:
+        problems.append("timing_reset() 后计数未清零")
+
+    problems = [p for p in problems if p]
+    print(f"计数校验：4 个实例 + 3 个网络功能块 × {cycles} 次，"
+          f"{'通过' if not problems else '失败'}")
+    for p in problems:
+        print(f"  {p}")
+    return len(problems)
+
+
+def verify_disabled(pc):
+    problems = []
+    pid = pc.PID(Kp=1.0, Ki=0.2, Kd=0.0, output_min=0.0, output_max=100.0)
+    pid.compute(1.0, 0.0, 0.01)
+    if pid.timing is not None:
+        problems.append("timing 属性应为 None")
+    if pc.timing() != []:
+        problems.append("timing() 应为空列表")
+    try:
+        pc.timing_dump(os.devnull)
+        problems.append("timing_dump() 应抛出 RuntimeError")
+    except RuntimeError:
+        pass
+    print(f"未启用 FB_TIMING：{'通过' if not problems else '失败'}")
+    for p in problems:
+        print(f"  {p}")
+    return len(problems)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="功能块执行时间计数校验与基准测试")
+    parser.add_argument("--cycles", type=int, default=200000, help="计时调用次数（默认 200000）")
+    args = parser.parse_args()
+
+    import plcopen_c as pc
+
+    enabled = pc.FB_TIMING
+    failures = verify_enabled(pc, 1000) if enabled else verify_disabled(pc)
+
+    n = args.cycles
+    pid = pc.PID(Kp=1.0, Ki=0.2, Kd=0.05, output_min=0.0, output_max=100.0)
+    lim = pc.Limit(0.0, 10.0)
+    net = make_network(pc)
+    pc.timing_reset()
+
+    start = time.perf_counter()
+    for _ in range(n):
+        pid.compute(50.0, 20.0, 0.01)
+    pid_ns = (time.perf_counter() - start) / n * 1e9
+
+    start = time.perf_counter()
+    for _ in range(n):
+        lim.compute(5.0)
+    lim_ns = (time.perf_counter() - start) / n * 1e9
+
+    start = time.perf_counter()
+    for _ in range(n):
+        net.execute(0.01)
+    net_ns = (time.perf_counter() - start) / n * 1e9
+
+    print(f"FB_TIMING {'已启用' if enabled else '未启用'}，每次调用耗时（{n} 次平均）")
+    print(f"PID.compute：            {pid_ns:8.1f} ns")
+    print(f"Limit.compute：          {lim_ns:8.1f} ns")
+    print(f"Network.execute（3 块）：{net_ns:8.1f} ns（每块 {net_ns / 3:.1f} ns）")
+    if enabled:
+        print("计数得到的 C 内计算耗时（mean / max）：")
+        for name, timing in (("PID", pid.timing), ("Limit", lim.timing)):
+            print(f"  {name:<8}{timing['mean_ns']:8.1f} / {timing['max_ns']:.1f} ns")
+        for item in pc.timing():
+            if item["name"] in ("pid", "lim", "ramp"):
+                print(f"  网络 {item['name']:<4}{item['mean_ns']:8.1f} / {item['max_ns']:.1f} ns")
+    else:
+        print("以 FB_TIMING=1 重新构建后再次运行，两次结果之差即计数开销")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""
+IEC 61131-3 定时器、计数器与边沿检测基准测试
+
+校验：随机输入下，把 TON / TOF / TP / CTU / CTD / R_TRIG / F_TRIG 与
+纯 Python 参考实现（整数纳秒计时，语义同 C 实现）逐周期比较 Q、ET、CV，
+并比较 TimerArray / CounterArray / TriggerArray 的每个通道与单实例。
+计时比较脚本中常见的 time.time() 时间戳写法、n 个 TON 实例和一个 TimerArray。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/iec_timers.py --channels 200
+"""
+
+import argparse
+import os
+import random
+import sys
+import time
+from array import array
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+
+class RefTimer:
+    """纯 Python 参考定时器，时间按整数纳秒累加"""
+
+    def __init__(self, kind: str, pt: float):
+        self.kind = kind
+        self.pt = round(pt * 1e9)
+        self.et = 0
+        self.prev = False
+        self.q = False
+
+    def _advance(self, dt: int):
+        self.et = min(self.et + dt, self.pt)
+
+    def compute(self, x: bool, dt: float) -> bool:
+        step = round(dt * 1e9)
+        if self.kind == "TON":
+            if not x:
+                self.et, self.q = 0, False
+            else:
+                if self.prev:
+                    self._advance(step)
+                else:
+                    self.et = 0
+                self.q = self.et >= self.pt
+        elif self.kind == "TOF":
+            if x:
+                self.et, self.q = 0, True
+            elif self.prev:
+                self.et, self.q = 0, self.pt > 0
+            elif self.q:
+                self._advance(step)
+                self.q = self.et < self.pt
+        else:
+            if self.q:
+                self._advance(step)
+                self.q = self.et < self.pt
+            elif x and not self.prev:
+                self.et, self.q = 0, self.pt > 0
+            elif not x:
+                self.et = 0
+        self.prev = x
+        return self.q
+
+
+class RefCounter:
+    def __init__(self, kind: str, pv: int):
+        self.kind, self.pv, self.cv, self.prev = kind, pv, 0, False
+
+    def compute(self, x: bool, load: bool) -> bool:
+        if load:
+            self.cv = 0 if self.kind == "CTU" else self.pv
+        elif x and not self.prev:
+            self.cv += 1 if self.kind == "CTU" else -1
+        self.prev = x
+        return self.cv >= self.pv if self.kind == "CTU" else self.cv <= 0
+
+
+class RefTrigger:
+    def __init__(self, kind: str):
+        self.kind, self.prev = kind, False
+
+    def compute(self, x: bool) -> bool:
+        q = (x and not self.prev) if self.kind == "R_TRIG" else (not x and self.prev)
+        self.prev = x
+        return q
+
+
+class TimestampTON:
+    """原脚本写法：记录 time.time() 时间戳再比较"""
+
+    def __init__(self, pt: float):
+        self.pt = pt
+        self.start = None
+
+    def compute(self, x: bool) -> bool:
+        if not x:
+            self.start = None
+            return False
+        now = time.time()
+        if self.start is None:
+            self.start = now
+        return now - self.start >= self.pt
+
+
+def verify(cycles: int, n: int) -> int:
+    import plcopen_c as pc
+
+    rng = random.Random(7)
+    mismatches = 0
+
+    # 周期 10 ms 左右抖动，PT 取周期整数倍和非整数倍
+    for kind in ("TON", "TOF", "TP"):
+        pts = [rng.choice([0.0, 0.01, 0.03, 0.05, 0.037, 0.2]) for _ in range(n)]
+        refs = [RefTimer(kind, pt) for pt in pts]
+        blocks = [getattr(pc, kind)(pt) for pt in pts]
+        bank = pc.TimerArray(n, kind, 0.0)
+        for i, pt in enumerate(pts):
+            bank.set_preset(i, pt)
+        state = [False] * n
+        for _ in range(cycles):
+            dt = rng.choice([0.01, 0.01, 0.01, 0.009, 0.011])
+            for i in range(n):
+                if rng.random() < 0.15:
+                    state[i] = not state[i]
+            x = array("d", state)
+            out = bank.compute(x, dt=dt)
+            values = bank.values
+            for i in range(n):
+                q = refs[i].compute(state[i], dt)
+                et = refs[i].et / 1e9
+                if (blocks[i].compute(state[i], dt) != q or blocks[i].ET != et
+                        or out[i] != float(q) or values[i] != et):
+                    mismatches += 1
+    print(f"定时器校验：TON/TOF/TP × {cycles} 周期 × {n} 通道，不一致 {mismatches}")
+    timer_mismatches = mismatches
+
+    for kind in ("CTU", "CTD"):
+        pvs = [rng.randint(0, 20) for _ in range(n)]
+        refs = [RefCounter(kind, pv) for pv in pvs]
+        blocks = [getattr(pc, kind)(pv) for pv in pvs]
+        bank = pc.CounterArray(n, kind, 1)
+        for i, pv in enumerate(pvs):
+            bank.set_preset(i, pv)
+        for _ in range(cycles):
+            x = [rng.random() < 0.5 for _ in range(n)]
+            load = [rng.random() < 0.02 for _ in range(n)]
+            out = bank.compute(array("d", x), array("d", load))
+            values = bank.values
+            for i in range(n):
+                q = refs[i].compute(x[i], load[i])
+                got = (blocks[i].compute(x[i], load[i]) if kind == "CTU"
+                       else blocks[i].compute(x[i], LD=load[i]))
+                if got != q or blocks[i].CV != refs[i].cv or out[i] != float(q) \
+                        or values[i] != refs[i].cv:
+                    mismatches += 1
+
+    for kind in ("R_TRIG", "F_TRIG"):
+        refs = [RefTrigger(kind) for _ in range(n)]
+        blocks = [getattr(pc, kind)() for _ in range(n)]
+        bank = pc.TriggerArray(n, kind)
+        for _ in range(cycles):
+            x = [rng.random() < 0.5 for _ in range(n)]
+            out = bank.compute(x)
+            for i in range(n):
+                q = refs[i].compute(x[i])
+                if blocks[i].compute(x[i]) != q or out[i] != float(q):
+                    mismatches += 1
+    print(f"计数器与边沿检测校验：CTU/CTD/R_TRIG/F_TRIG × {cycles} 周期 × {n} 通道，"
+          f"不一致 {mismatches - timer_mismatches}")
+    return mismatches
+
+
+def main():
+    parser = argparse.ArgumentParser(description="IEC 定时器、计数器与边沿检测基准测试")
+    parser.add_argument("--channels", type=int, default=200, help="通道数（默认 200）")
+    parser.add_argument("--cycles", type=int, default=2000, help="计时周期数（默认 2000）")
+    args = parser.parse_args()
+
+    from plcopen_c import TON, TimerArray
+
+    mismatches = verify(500, 37)
+
+    n = args.channels
+    rng = random.Random(3)
+    x = array("d", (float(rng.random() < 0.8) for _ in range(n)))
+    flags = [v != 0.0 for v in x]
+    out = array("d", bytes(8 * n))
+
+    scripts = [TimestampTON(5.0) for _ in range(n)]
+    blocks = [TON(5.0) for _ in range(n)]
+    bank = TimerArray(n, "TON", 5.0)
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        for i, s in enumerate(scripts):
+            s.compute(flags[i])
+    script_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        for i, b in enumerate(blocks):
+            b.compute(flags[i])
+    block_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        bank.compute(x, out)
+    bank_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    print(f"{n} 个接通延时定时器（dt 自动计算）")
+    print(f"time.time() 写法：   {script_us:10.2f} us/周期")
+    print(f"{n} 个 TON：         {block_us:10.2f} us/周期（{script_us / block_us:.1f}x）")
+    print(f"TimerArray：         {bank_us:10.2f} us/周期（{script_us / bank_us:.1f}x）")
+
+    return 1 if mismatches else 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+IIR（级联二阶节）精度与基准测试
+
+精度校验：
+  1. s 域原型的离散系数与独立实现的双线性变换（多项式展开）比较；
+  2. IIR 每周期输出与纯 Python 转置直接 II 型参考实现逐位比较；
+  3. IIRArray 每个通道与单实例 IIR 逐位比较（含向量内核剩余的尾部通道）；
+  4. 二阶欠阻尼环节阶跃响应与解析解比较，误差随周期减小而收敛。
+计时比较纯 Python 参考实现、n 个 IIR 实例和一个 IIRArray。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/iir.py --channels 256 --kernel avx2
+"""
+
+import argparse
+import math
+import os
+import random
+import sys
+import time
+from array import array
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+WN = 2.0 * math.pi * 1.5      # 二阶环节自然频率（rad/s）
+ZETA = 0.3                    # 阻尼比
+
+# s 域原型：二阶低通 wn^2/(s^2 + 2*zeta*wn*s + wn^2)，一阶超前滞后 (0.2s+1)/(0.5s+1)，纯积分 1/s
+ANALOG = [
+    [0.0, 0.0, WN * WN, 1.0, 2.0 * ZETA * WN, WN * WN],
+    [0.0, 0.2, 1.0, 0.0, 0.5, 1.0],
+]
+INTEGRATOR = [[0.0, 0.0, 1.0, 0.0, 1.0, 0.0]]
+
+
+def poly_mul(p, q):
+    out = [0.0] * (len(p) + len(q) - 1)
+    for i, a in enumerate(p):
+        for j, b in enumerate(q):
+            out[i + j] += a * b
+    return out
+
+
+def ref_tustin(row, period):
+    """独立的双线性变换：按分母阶次 m 展开 sum(c_k * K^k * (1-q)^k * (1+q)^(m-k))"""
+    b, a = row[:3], row[3:]
+    order = 2 if a[0] else 1 if a[1] else 0
+    K = 2.0 / period
+
+    def expand(p):
+        coeffs = [0.0, 0.0, 0.0]
+        for k in range(order + 1):               # s^k 的系数为 p[2 - k]
+            term = [p[2 - k] * K ** k]
+            for _ in range(k):
+                term = poly_mul(term, [1.0, -1.0])
+            for _ in range(order - k):
+                term = poly_mul(term, [1.0, 1.0])
+            for i, c in enumerate(term):
+                coeffs[i] += c
+        return coeffs
+
+    nb, na = expand(b), expand(a)
+    return [nb[0] / na[0], nb[1] / na[0], nb[2] / na[0], 1.0, na[1] / na[0], na[2] / na[0]]
+
+
+class ReferenceIIR:
+    """纯 Python 转置直接 II 型级联，运算顺序与 C 实现相同"""
+
+    def __init__(self, coefficients):
+        self.coef = [tuple(c) for c in coefficients]
+        self.state = [[0.0, 0.0] for _ in self.coef]
+
+    def compute(self, x: float) -> float:
+        for (b0, b1, b2, _, a1, a2), st in zip(self.coef, self.state):
+            y = b0 * x + st[0]
+            st[0] = b1 * x - a1 * y + st[1]
+            st[1] = b2 * x - a2 * y
+            x = y
+        return x
+
+
+def step_reference(t: float) -> float:
+    """二阶欠阻尼环节的单位阶跃响应解析解"""
+    wd = WN * math.sqrt(1.0 - ZETA * ZETA)
+    phi = math.acos(ZETA)
+    return 1.0 - math.exp(-ZETA * WN * t) / math.sqrt(1.0 - ZETA * ZETA) * math.sin(wd * t + phi)
+
+
+def check_coefficients(IIR) -> int:
+    failures = 0
+    for period in (0.1, 0.01, 0.001):
+        coef = IIR(ANALOG + INTEGRATOR, period, analog=True).coefficients
+        for row, got in zip(ANALOG + INTEGRATOR, coef):
+            expected = ref_tustin(row, period)
+            err = max(abs(g - e) / max(1.0, abs(e)) for g, e in zip(got, expected))
+            if err > 1e-12:
+                failures += 1
+    print(f"系数校验：3 个周期 × {len(ANALOG) + 1} 节，不一致 {failures}")
+    return failures
+
+
+def check_outputs(IIR, IIRArray, cycles: int) -> int:
+    rng = random.Random(3)
+    failures = 0
+
+    # z 域系数分母首项不为 1，检验归一化
+    z_sections = [[3.0 * v for v in ref_tustin(row, 0.01)] for row in ANALOG]
+    cases = {
+        "s 域": (ANALOG + INTEGRATOR, 0.01, True),
+        "z 域": (z_sections, 0.01, False),
+    }
+    for name, (sections, period, analog) in cases.items():
+        block = IIR(sections, period, analog=analog)
+        ref = ReferenceIIR(block.coefficients)
+        n = 37                                  # 不是向量宽度的整数倍
+        bank = IIRArray(n, sections, period, analog=analog)
+        blocks = [IIR(sections, period, analog=analog) for _ in range(n)]
+        mismatches = 0
+        for _ in range(cycles):
+            x = array("d", (rng.gauss(0.0, 10.0) for _ in range(n)))
+            if block.compute(x[0]) != ref.compute(x[0]):
+                mismatches += 1
+            out = bank.compute(x)
+            for i in range(n):
+                if blocks[i].compute(x[i]) != out[i]:
+                    mismatches += 1
+        print(f"{name}输出校验（内核 {bank.kernel}）：{cycles} 周期 × {n} 通道，不一致 {mismatches}")
+        failures += mismatches
+    return failures
+
+
+def check_step_response(IIR) -> int:
+    errors = []
+    for period in (0.01, 0.001):
+        block = IIR(ANALOG[:1], period, analog=True)
+        steps = round(5.0 / period)
+        err = max(abs(block.compute(1.0) - step_reference(k * period)) for k in range(steps))
+        errors.append(err)
+        print(f"阶跃响应 period={period}：与解析解最大偏差 {err:.2e}")
+    # Tustin 对阶跃输入的误差为 O(period)：周期缩小 10 倍，误差至少缩小 5 倍
+    return 0 if errors[1] < 1e-2 and errors[0] / errors[1] > 5.0 else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="IIR 精度与基准测试")
+    parser.add_argument("--channels", type=int, default=256, help="通道数（默认 256）")
+    parser.add_argument("--cycles", type=int, default=500, help="计时周期数（默认 500）")
+    parser.add_argument("--kernel", choices=["scalar", "sse2", "avx2"], help="强制使用指定内核")
+    args = parser.parse_args()
+
+    if args.kernel:
+        os.environ["PLCOPEN_IIR_KERNEL"] = args.kernel
+
+    from plcopen_c import IIR, IIRArray
+
+    failures = check_coefficients(IIR)
+    failures += check_outputs(IIR, IIRArray, 400)
+    failures += check_step_response(IIR)
+
+    n = args.channels
+    sections = ANALOG
+    rng = random.Random(4)
+    x = array("d", (rng.uniform(0.0, 100.0) for _ in range(n)))
+    out = array("d", bytes(8 * n))
+
+    coef = IIR(sections, 0.01, analog=True).coefficients
+    refs = [ReferenceIIR(coef) for _ in range(n)]
+    blocks = [IIR(sections, 0.01, analog=True) for _ in range(n)]
+    bank = IIRArray(n, sections, 0.01, analog=True)
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        for i, r in enumerate(refs):
+            r.compute(x[i])
+    ref_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        for i, b in enumerate(blocks):
+            b.compute(x[i])
+    block_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        bank.compute(x, out)
+    bank_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    print(f"{n} 通道，{len(sections)} 节，内核 {bank.kernel}")
+    print(f"纯 Python：        {ref_us:10.2f} us/周期")
+    print(f"{n} 个 IIR：       {block_us:10.2f} us/周期（{ref_us / block_us:.1f}x）")
+    print(f"IIRArray：         {bank_us:10.2f} us/周期（{ref_us / bank_us:.1f}x）")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""
+功能块事件计数与变更记录校验与基准测试
+
+校验：
+  1. 创建、改参、重置、销毁 PID / FirstOrder 后，journal_stats() 中各事件计数的增量
+     与实际调用次数一致，journal() 中最后一条改参记录携带最新参数值；
+  2. 参数越限被限幅时只计数（clamped 增加），不改变事件计数；
+  3. 变更记录超过容量后只保留最近 capacity 条，序号连续，计数不受影响。
+计时比较每次 set_params() / reset() 调用的耗时（含 Python 调用开销），
+以及每个周期改参的 PID 周期（set_params + compute）与只计算的周期之差。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/journal.py
+    python3 tests/benchmark/journal.py --cycles 500000
+"""
+
+import argparse
+import os
+import sys
+import time
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+
+def event_counts(pc):
+    """返回 {(类型, 事件): 次数}"""
+    return {(t, e): n for t, events in pc.journal_stats()["events"].items()
+            for e, n in events.items()}
+
+
+def delta(before, after):
+    return {k: n - before.get(k, 0) for k, n in after.items() if n != before.get(k, 0)}
+
+
+def verify_counts(pc, updates):
+    problems = []
+    before = event_counts(pc)
+    head = pc.journal_stats()["records"]
+
+    pid = pc.PID(Kp=1.0, Ki=0.1, Kd=0.0, output_min=0.0, output_max=100.0)
+    fo = pc.FirstOrder(T=1.0)
+    for k in range(updates):
+        pid.set_params(Kp=1.0 + k, Ki=0.2, Kd=0.01)
+        fo.set_time_constant(2.0 + k)
+        if k % 10 == 0:
+            pid.reset()
+    pid_id = pid.id
+    del pid, fo
+
+    expected = {
+        ("PID", "create"): 1, ("PID", "param"): updates,
+        ("PID", "reset"): (updates + 9) // 10, ("PID", "destroy"): 1,
+        ("FirstOrder", "create"): 1, ("FirstOrder", "param"): updates,
+        ("FirstOrder", "destroy"): 1,
+    }
+    got = delta(before, event_counts(pc))
+    if got != expected:
+        problems.append(f"事件计数增量 {got}，应为 {expected}")
+
+    records = pc.journal(head)
+    last = [r for r in records if r["type"] == "PID" and r["event"] == "param"]
+    want = {"Kp": float(updates), "Ki": 0.2, "Kd": 0.01}
+    if not last or last[-1]["id"] != pid_id or last[-1]["values"] != want:
+        problems.append(f"最后一条 PID 改参记录 {last[-1] if last else None}，应为 {want}")
+    if [r["seq"] for r in records] != list(range(head + 1, head + len(records) + 1)):
+        problems.append("变更记录序号不连续")
+
+    print(f"计数校验：{updates} 次改参，{'通过' if not problems else '失败'}")
+    return problems
+
+
+def verify_clamp(pc):
+    problems = []
+    stats = pc.journal_stats()
+    before = event_counts(pc)
+
+    pid = pc.PID(Kp=1.0, Ki=0.0, Kd=0.0, output_min=0.0, output_max=1.0)
+    pid.set_params(Kp=-5.0, Ki=2e7)
+    if (pid.Kp, pid.Ki) != (0.0, 1e6):
+        problems.append(f"限幅结果 Kp={pid.Kp} Ki={pid.Ki}，应为 0 和 1e6")
+    del pid
+
+    clamped = pc.journal_stats()["clamped"] - stats["clamped"]
+    if clamped != 2:
+        problems.append(f"限幅计数增加 {clamped}，应为 2")
+    got = delta(before, event_counts(pc))
+    if got != {("PID", "create"): 1, ("PID", "param"): 1, ("PID", "destroy"): 1}:
+        problems.append(f"限幅时事件计数增量 {got}")
+
+    print(f"限幅计数：{'通过' if not problems else '失败'}")
+    return problems
+
+
+def verify_overwrite(pc):
+    problems = []
+    stats = pc.journal_stats()
+    capacity = stats["capacity"]
+    head = stats["records"]
+    before = event_counts(pc)
+
+    pid = pc.PID(Kp=1.0, Ki=0.0, Kd=0.0, output_min=0.0, output_max=1.0)
+    updates = 2 * capacity
+    for k in range(updates):
+        pid.set_params(Kp=1.0 + k)
+    del pid
+
+    new_head = pc.journal_stats()["records"]
+    records = pc.journal(head)
+    seqs = [r["seq"] for r in records]
+    if new_head - head != updates + 2:
+        problems.append(f"序号增加 {new_head - head}，应为 {updates + 2}")
+    if seqs != list(range(new_head - capacity + 1, new_head + 1)):
+        problems.append(f"覆盖后读到 {len(seqs)} 条（{seqs[:1]}…{seqs[-1:]}），"
+                        f"应为最近 {capacity} 条")
+    if delta(before, event_counts(pc)).get(("PID", "param")) != updates:
+        problems.append("覆盖后改参计数不正确")
+
+    print(f"环形覆盖：{updates + 2} 条记录 / 容量 {capacity}，"
+          f"{'通过' if not problems else '失败'}")
+    return problems
+
+
+def per_call_ns(fn, n):
+    start = time.perf_counter()
+    for _ in range(n):
+        fn()
+    return (time.perf_counter() - start) / n * 1e9
+
+
+def main():
+    parser = argparse.ArgumentParser(description="功能块事件计数与变更记录校验与基准测试")
+    parser.add_argument("--cycles", type=int, default=200000, help="计时调用次数（默认 200000）")
+    args = parser.parse_args()
+
+    import plcopen_c as pc
+
+    failures = []
+    failures += verify_counts(pc, 300)
+    failures += verify_clamp(pc)
+    failures += verify_overwrite(pc)
+    for p in failures:
+        print(f"  {p}")
+
+    n = args.cycles
+    pid = pc.PID(Kp=1.0, Ki=0.2, Kd=0.05, output_min=0.0, output_max=100.0)
+    set_ns = per_call_ns(lambda: pid.set_params(Kp=1.5, Ki=0.2, Kd=0.05), n)
+    reset_ns = per_call_ns(pid.reset, n)
+    compute_ns = per_call_ns(lambda: pid.compute(50.0, 20.0, 0.01), n)
+
+    def tuned_cycle():
+        pid.set_params(Kp=1.5)
+        pid.compute(50.0, 20.0, 0.01)
+
+    tuned_ns = per_call_ns(tuned_cycle, n)
+
+    print(f"每次调用耗时（{n} 次平均）")
+    print(f"PID.set_params：          {set_ns:8.1f} ns")
+    print(f"PID.reset：               {reset_ns:8.1f} ns")
+    print(f"PID.compute：             {compute_ns:8.1f} ns")
+    print(f"改参 + compute 周期：     {tuned_ns:8.1f} ns（比只计算多 {tuned_ns - compute_ns:.1f} ns）")
+    print("事件只写入内存计数和变更记录，不再在调用中格式化和写日志文件")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+"""
+折线表基准测试
+
+把 Lookup1D / Lookup2D 与脚本中常见的 bisect 查表写法逐点比较（等间距与
+非等间距断点、断点上、范围外限幅与外推、单调与随机输入），并校验缓冲区
+参数不复制（就地修改输出值立即生效），以及 Network.set_table() 复制的表从
+附属存储区分配（换表时归还旧表，存储区不足时抛出 ValueError 且保留原表）。
+随后计时 bisect 写法与 C 实现。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/lookup.py --points 256
+"""
+
+import argparse
+import bisect
+import os
+import random
+import sys
+import time
+from array import array
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+
+def segment(x, v):
+    """满足 x[i] <= v 的最大 i，限制在 [0, n-2]"""
+    return min(max(bisect.bisect_right(x, v) - 1, 0), len(x) - 2)
+
+
+def lerp(a, b, t):
+    return (1.0 - t) * a + t * b
+
+
+class BisectLookup:
+    """原脚本写法：bisect 查区间 + 线性插值"""
+
+    def __init__(self, x, y, clamp=True):
+        self.x, self.y, self.clamp = list(x), list(y), clamp
+
+    def compute(self, v: float) -> float:
+        x, y = self.x, self.y
+        if self.clamp:
+            if v <= x[0]:
+                return y[0]
+            if v >= x[-1]:
+                return y[-1]
+        i = segment(x, v)
+        return lerp(y[i], y[i + 1], (v - x[i]) / (x[i + 1] - x[i]))
+
+
+class BisectLookup2D:
+    """原脚本写法：两次 bisect + 双线性插值"""
+
+    def __init__(self, u, v, z, clamp=True):
+        self.u, self.v, self.z, self.clamp = list(u), list(v), list(z), clamp
+
+    def compute(self, a: float, b: float) -> float:
+        u, v, z = self.u, self.v, self.z
+        if self.clamp:
+            a = min(max(a, u[0]), u[-1])
+            b = min(max(b, v[0]), v[-1])
+        i, j = segment(u, a), segment(v, b)
+        ta = (a - u[i]) / (u[i + 1] - u[i])
+        tb = (b - v[j]) / (v[j + 1] - v[j])
+        r0 = i * len(v) + j
+        r1 = r0 + len(v)
+        return lerp(lerp(z[r0], z[r0 + 1], tb), lerp(z[r1], z[r1 + 1], tb), ta)
+
+
+def make_axis(rng, n, uniform):
+    if uniform:
+        return array("d", (-10.0 + 0.25 * k for k in range(n)))
+    x, v = array("d"), -10.0
+    for _ in range(n):
+        x.append(v)
+        v += rng.choice((0.01, 0.5, 3.0)) * rng.uniform(0.5, 1.5)
+    return x
+
+
+def inputs(rng, x, count):
+    """随机点、断点本身、范围外的点和一段单调扫描"""
+    lo, hi = x[0], x[-1]
+    span = hi - lo
+    pts = [rng.uniform(lo - 0.2 * span, hi + 0.2 * span) for _ in range(count)]
+    pts += list(x) + [lo - 1.0, hi + 1.0]
+    pts += [lo + span * k / count for k in range(count)]
+    pts += [hi - span * k / count for k in range(count)]
+    return pts
+
+
+def verify(points: int) -> int:
+    from plcopen_c import Lookup1D, Lookup2D
+
+    rng = random.Random(points)
+    mismatches = 0
+    for uniform in (True, False):
+        x = make_axis(rng, points, uniform)
+        y = array("d", (rng.uniform(-50.0, 50.0) for _ in range(points)))
+        for clamp in (True, False):
+            block, ref = Lookup1D(x, y, clamp), BisectLookup(x, y, clamp)
+            if block.uniform != (uniform or points == 2) or not block.shared:
+                mismatches += 1
+            for v in inputs(rng, x, 500):
+                if block.compute(v) != ref.compute(v):
+                    mismatches += 1
+
+        u = make_axis(rng, 9, uniform)
+        v = make_axis(rng, 13, not uniform)
+        z = array("d", (rng.uniform(-5.0, 5.0) for _ in range(len(u) * len(v))))
+        rows = [list(z[k * len(v):(k + 1) * len(v)]) for k in range(len(u))]
+        for clamp in (True, False):
+            block, ref = Lookup2D(u, v, z, clamp), BisectLookup2D(u, v, z, clamp)
+            nested = Lookup2D(list(u), list(v), rows, clamp)
+            for a, b in zip(inputs(rng, u, 300), inputs(rng, v, 300)):
+                expected = ref.compute(a, b)
+                if block.compute(a, b) != expected or nested.compute(a, b) != expected:
+                    mismatches += 1
+
+    # 缓冲区直接引用：就地修改 y 立即生效；普通列表复制
+    x = array("d", [0.0, 1.0, 2.0])
+    y = array("d", [0.0, 10.0, 20.0])
+    shared, copied = Lookup1D(x, y), Lookup1D(list(x), list(y))
+    y[1] = 100.0
+    if shared.compute(1.0) != 100.0 or copied.compute(1.0) != 10.0 or copied.shared:
+        mismatches += 1
+    return mismatches
+
+
+def verify_table_storage(pc) -> list:
+    problems = []
+    pc.configure_pools(64, 64 * 1024)
+    used = lambda: pc.pool_stats()["storage"]["used"]
+    base = used()
+
+    net = pc.Network()
+    net.add_input("x", 10.5)
+    net.add_block("c", "Lookup1D")
+    net.connect("x", "c.in")
+    net.add_output("y", "c.out")
+    net.set_table("c", [float(i) for i in range(256)], [2.0 * i for i in range(256)])
+    net.build()
+    if used() - base != 64 + 2 * 256 * 8:
+        problems.append(f"256 个断点的表副本占用 {used() - base} 字节，应为 {64 + 2 * 256 * 8}")
+
+    try:
+        net.set_table("c", [float(i) for i in range(4096)], [0.0] * 4096)
+        problems.append("超出附属存储区的表应抛出 ValueError")
+    except ValueError:
+        pass
+    if used() - base != 64 + 2 * 256 * 8:
+        problems.append(f"换表失败后占用 {used() - base} 字节，原表副本应保留")
+    net.execute(0.1)
+
+    net.set_table("c", [0.0, 1.0, 2.0], [0.0, 1.0, 4.0])
+    if used() - base != 128:
+        problems.append(f"换成 3 个断点的表后占用 {used() - base} 字节，应为 128")
+    del net
+    if used() != base:
+        problems.append(f"销毁网络后占用 {used() - base} 字节，应为 0")
+    pc.configure_pools(1024)
+
+    print(f"表副本存储：{'通过' if not problems else '失败'}")
+    return problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description="折线表基准测试")
+    parser.add_argument("--points", type=int, default=256, help="断点数（默认 256）")
+    parser.add_argument("--calls", type=int, default=200000, help="计时调用次数（默认 200000）")
+    args = parser.parse_args()
+
+    import plcopen_c as pc
+    from plcopen_c import Lookup1D, Lookup2D
+
+    failures = verify_table_storage(pc)
+    for p in failures:
+        print(f"  {p}")
+
+    mismatches = sum(verify(n) for n in sorted({2, 3, 17, args.points}))
+    print(f"一致性校验：断点数 {sorted({2, 3, 17, args.points})}，不一致 {mismatches}")
+
+    rng = random.Random(5)
+    n = args.points
+    print(f"{n} 个断点，{args.calls} 次调用")
+    print(f"{'表':<22}{'bisect (ns/次)':>16}{'C (ns/次)':>14}")
+    for name, uniform, monotonic in (("等间距 随机输入", True, False),
+                                     ("非等间距 随机输入", False, False),
+                                     ("非等间距 单调输入", False, True)):
+        x = make_axis(rng, n, uniform)
+        y = array("d", (rng.uniform(0.0, 100.0) for _ in range(n)))
+        if monotonic:
+            pts = [x[0] + (x[-1] - x[0]) * k / args.calls for k in range(args.calls)]
+        else:
+            pts = [rng.uniform(x[0], x[-1]) for _ in range(args.calls)]
+        ref, block = BisectLookup(x, y), Lookup1D(x, y)
+
+        start = time.perf_counter()
+        for v in pts:
+            ref.compute(v)
+        ref_ns = (time.perf_counter() - start) / args.calls * 1e9
+
+        compute = block.compute
+        start = time.perf_counter()
+        for v in pts:
+            compute(v)
+        block_ns = (time.perf_counter() - start) / args.calls * 1e9
+        print(f"{name:<22}{ref_ns:>16.1f}{block_ns:>14.1f}")
+
+    u, v = make_axis(rng, 32, True), make_axis(rng, 32, False)
+    z = array("d", (rng.uniform(0.0, 1.0) for _ in range(len(u) * len(v))))
+    pts = [(rng.uniform(u[0], u[-1]), rng.uniform(v[0], v[-1])) for _ in range(args.calls)]
+    ref, block = BisectLookup2D(u, v, z), Lookup2D(u, v, z)
+
+    start = time.perf_counter()
+    for a, b in pts:
+        ref.compute(a, b)
+    ref_ns = (time.perf_counter() - start) / args.calls * 1e9
+
+    compute = block.compute
+    start = time.perf_counter()
+    for a, b in pts:
+        compute(a, b)
+    block_ns = (time.perf_counter() - start) / args.calls * 1e9
+    print(f"{'二维 32×32':<22}{ref_ns:>16.1f}{block_ns:>14.1f}")
+
+    return 1 if mismatches or failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+批量 PID 基准测试
+
+比较 n 个独立 PID 实例逐个调用 compute() 与一个 PIDBank 一次计算全部回路
+的耗时，并逐位校验两者输出和积分状态一致（含输出饱和、抗积分饱和和 Ki=0 的回路）。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/pid_bank.py --loops 400
+    # 指定内核（对比 SIMD 与标量实现）
+    python3 tests/benchmark/pid_bank.py --kernel scalar
+"""
+
+import argparse
+import os
+import random
+import sys
+import time
+from array import array
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+
+def make_loops(n: int, seed: int) -> list[tuple]:
+    """
+    生成回路参数：部分回路 Ki=0，部分回路输出范围很窄以触发饱和
+
+    Returns:
+        [(Kp, Ki, Kd, output_min, output_max), ...]
+    """
+    rng = random.Random(seed)
+    loops = []
+    for i in range(n):
+        kp = rng.uniform(0.1, 5.0)
+        ki = 0.0 if i % 7 == 0 else rng.uniform(0.0, 2.0)
+        kd = rng.uniform(0.0, 0.5)
+        span = 5.0 if i % 3 == 0 else 100.0
+        loops.append((kp, ki, kd, -span, span))
+    return loops
+
+
+def verify(pids, bank, sp, pv_seq, dt: float) -> int:
+    """
+    逐周期比较 PID 与 PIDBank 的输出
+
+    Returns:
+        不一致的回路数
+    """
+    mismatches = 0
+    for pv in pv_seq:
+        out = bank.compute(sp, pv, dt)
+        for i, pid in enumerate(pids):
+            expected = pid.compute(sp[i], pv[i], dt)
+            if expected != out[i] or pid.integral != bank.get_loop(i)["integral"]:
+                mismatches += 1
+    return mismatches
+
+
+def main():
+    parser = argparse.ArgumentParser(description="批量 PID 基准测试")
+    parser.add_argument("--loops", type=int, default=400, help="回路数（默认 400）")
+    parser.add_argument("--cycles", type=int, default=2000, help="计时周期数（默认 2000）")
+    parser.add_argument(
+        "--kernel",
+        choices=["scalar", "sse2", "avx2"],
+        help="指定计算内核（默认自动选择）",
+    )
+
+    args = parser.parse_args()
+
+    if args.kernel:
+        os.environ["PLCOPEN_PID_BANK_KERNEL"] = args.kernel
+
+    from plcopen_c import PID, PIDBank
+
+    n = args.loops
+    dt = 0.01
+    loops = make_loops(n, seed=1)
+    pids = [PID(*p) for p in loops]
+    bank = PIDBank(n)
+    for i, (kp, ki, kd, lo, hi) in enumerate(loops):
+        bank.set_params(i, Kp=kp, Ki=ki, Kd=kd)
+        bank.set_output_limits(i, lo, hi)
+
+    rng = random.Random(2)
+    sp = array("d", (rng.uniform(20.0, 80.0) for _ in range(n)))
+    pv_seq = [
+        array("d", (rng.uniform(0.0, 100.0) for _ in range(n))) for _ in range(50)
+    ]
+
+    print(f"回路数 {n}，内核 {bank.kernel}")
+
+    mismatches = verify(pids, bank, sp, pv_seq, dt)
+    print(f"一致性校验：{len(pv_seq)} 周期，不一致 {mismatches}")
+
+    pv = pv_seq[0]
+    out = array("d", bytes(8 * n))
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        for i, pid in enumerate(pids):
+            pid.compute(sp[i], pv[i], dt)
+    loop_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        bank.compute(sp, pv, dt, out)
+    bank_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+    print(f"{n} 个 PID.compute()：{loop_us:10.2f} us/周期")
+    print(f"PIDBank.compute()：  {bank_us:10.2f} us/周期（{loop_us / bank_us:.1f}x）")
+
+    return 1 if mismatches else 0
+
+
+if __name__ == "__main__":
+    exit(main())
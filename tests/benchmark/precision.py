@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+"""
+float32 / Q16.16 功能块精度与基准测试
+
+校验：
+  1. precision="f64" 的 PIDBank / FirstOrderArray / RampArray / LimitArray 与纯 Python
+     参考实现逐位一致（内核模板的 double 实例与原算法相同）；
+  2. 同样的输入下，"f32" 和 "q16" 与 "f64" 的最大绝对偏差不超过 BOUNDS
+     （信号范围约 0~100，PID 输出范围 ±100）；
+  3. Q16.16 超出表示范围时饱和，不回绕；
+  4. precision="f32" 的 PIDBank（SoA SIMD 内核）与逐次舍入到 float32 的参考实现逐位一致，
+     float32 缓冲区（array('f')）输入输出与 float64 输入的结果相同。
+计时比较三种精度每周期计算 n 个通道的耗时，以及 f32 PIDBank 直接使用 float32 缓冲区的耗时。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/precision.py --channels 1024
+"""
+
+import argparse
+import math
+import os
+import random
+import struct
+import sys
+import time
+from array import array
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+DT = 0.01
+
+# 与 f64 的最大绝对偏差上限：(f32, q16)
+BOUNDS = {
+    "PIDBank": (5e-4, 0.2),
+    "FirstOrderArray": (5e-4, 0.05),
+    "RampArray": (5e-3, 0.2),
+    "LimitArray": (1e-5, 1e-5),
+}
+
+
+class RefPID:
+    def __init__(self, Kp, Ki, Kd, lo, hi):
+        self.Kp, self.Ki, self.Kd, self.lo, self.hi = Kp, Ki, Kd, lo, hi
+        self.integral = self.prev_error = 0.0
+
+    def compute(self, sp, pv, dt):
+        error = sp - pv
+        output = self.Kp * error
+        self.integral = self.integral + error * dt
+        output = output + self.Ki * self.integral
+        if dt > 0.0:
+            output = output + self.Kd * ((error - self.prev_error) / dt)
+        self.prev_error = error
+        limited = min(max(output, self.lo), self.hi) if output == output else output
+        if limited != output and self.Ki > 0.0:
+            self.integral = self.integral - error * dt
+        return limited
+
+
+def f32(v):
+    """舍入到 float32"""
+    return struct.unpack("f", struct.pack("f", v))[0]
+
+
+class RefPID32(RefPID):
+    """float32 参考实现：每次运算的结果舍入到 float32（与 pid_kernel_f32() 相同）"""
+
+    def __init__(self, *params):
+        super().__init__(*(f32(v) for v in params))
+
+    def compute(self, sp, pv, dt):
+        error = f32(f32(sp) - f32(pv))
+        output = f32(self.Kp * error)
+        self.integral = f32(self.integral + f32(error * dt))
+        output = f32(output + f32(self.Ki * self.integral))
+        if dt > 0.0:
+            output = f32(output + f32(self.Kd * f32(f32(error - self.prev_error) / dt)))
+        self.prev_error = error
+        limited = min(max(output, self.lo), self.hi) if output == output else output
+        if limited != output and self.Ki > 0.0:
+            self.integral = f32(self.integral - f32(error * dt))
+        return limited
+
+
+class RefFirstOrder:
+    def __init__(self, T):
+        self.T, self.prev = T, 0.0
+
+    def compute(self, x, dt):
+        alpha = dt / (self.T + dt)
+        self.prev = alpha * x + (1.0 - alpha) * self.prev
+        return self.prev
+
+
+class RefRamp:
+    def __init__(self, rising, falling):
+        self.rising, self.falling = rising, falling
+        self.output = None
+
+    def compute(self, x, dt):
+        if self.output is None:
+            self.output = x
+            return x
+        error = x - self.output
+        max_change = self.rising * dt if error > 0.0 else self.falling * dt
+        if abs(error) <= max_change:
+            self.output = x
+        elif error > 0.0:
+            self.output += max_change
+        else:
+            self.output -= max_change
+        return self.output
+
+
+def signal(rng, k, n):
+    """慢变正弦叠加噪声，包含阶跃"""
+    step = 30.0 if (k // 300) % 2 else 0.0
+    return array("d", (40.0 + step + 25.0 * math.sin(0.01 * k + i) + rng.gauss(0.0, 3.0)
+                       for i in range(n)))
+
+
+def make_cases(pc, n):
+    """名称 -> (构造函数(precision), 调用函数(block, x, y, out), 参考实现(x, y) -> 输出列表)"""
+    pids = [RefPID(2.0, 0.5, 0.05, -100.0, 100.0) for _ in range(n)]
+    filters = [RefFirstOrder(1.0) for _ in range(n)]
+    ramps = [RefRamp(5.0, 10.0) for _ in range(n)]
+    return {
+        "PIDBank": (lambda p: pc.PIDBank(n, Kp=2.0, Ki=0.5, Kd=0.05, output_min=-100.0,
+                                         output_max=100.0, precision=p),
+                    lambda b, x, y, out: b.compute(x, y, DT, out),
+                    lambda x, y: [r.compute(x[i], y[i], DT) for i, r in enumerate(pids)]),
+        "FirstOrderArray": (lambda p: pc.FirstOrderArray(n, T=1.0, precision=p),
+                            lambda b, x, y, out: b.compute(x, out, DT),
+                            lambda x, y: [r.compute(x[i], DT) for i, r in enumerate(filters)]),
+        "RampArray": (lambda p: pc.RampArray(n, 5.0, 10.0, precision=p),
+                      lambda b, x, y, out: b.compute(x, DT, out),
+                      lambda x, y: [r.compute(x[i], DT) for i, r in enumerate(ramps)]),
+        "LimitArray": (lambda p: pc.LimitArray(n, 20.0, 80.0, precision=p),
+                       lambda b, x, y, out: b.compute(x, out),
+                       lambda x, y: [min(max(v, 20.0), 80.0) for v in x]),
+    }
+
+
+def verify(pc, cycles, n):
+    failures = 0
+    rng = random.Random(5)
+    print(f"{'功能块':<18}{'f64 参考':>10}{'f32 偏差':>12}{'上限':>10}{'q16 偏差':>12}{'上限':>10}")
+    for name, (make, call, reference) in make_cases(pc, n).items():
+        blocks = {p: make(p) for p in ("f64", "f32", "q16")}
+        ref_mismatches = 0
+        dev = {"f32": 0.0, "q16": 0.0}
+        for k in range(cycles):
+            x = signal(rng, k, n)
+            y = array("d", (v + rng.gauss(0.0, 2.0) for v in x))
+            out = {p: list(call(b, x, y, None)) for p, b in blocks.items()}
+            expected = reference(x, y)
+            ref_mismatches += sum(a != b for a, b in zip(out["f64"], expected))
+            for p in dev:
+                dev[p] = max(dev[p], max(abs(a - b) for a, b in zip(out[p], out["f64"])))
+        f32_bound, q16_bound = BOUNDS[name]
+        ok = ref_mismatches == 0 and dev["f32"] <= f32_bound and dev["q16"] <= q16_bound
+        failures += not ok
+        print(f"{name:<18}{ref_mismatches:>10}{dev['f32']:>12.2e}{f32_bound:>10.0e}"
+              f"{dev['q16']:>12.2e}{q16_bound:>10.0e}  {'通过' if ok else '失败'}")
+
+    # Q16.16 饱和：超出 ±32768 的输入和参数按端点处理
+    lim = pc.LimitArray(2, -1e6, 1e6, precision="q16")
+    out = list(lim.compute([40000.0, -1e5]))
+    saturated = out == [32768.0 - 2.0 ** -16, -32768.0]
+    failures += not saturated
+    print(f"Q16.16 饱和：{out} {'通过' if saturated else '失败'}")
+    return failures + verify_f32_bank(pc, 300, n)
+
+
+def verify_f32_bank(pc, cycles, n):
+    """f32 PIDBank 与 float32 参考实现逐位比较（n 不是向量宽度的整数倍，覆盖尾部标量路径）"""
+    rng = random.Random(7)
+    params = [(rng.uniform(0.5, 5.0), 0.0 if i % 5 == 0 else rng.uniform(0.0, 2.0),
+               rng.uniform(0.0, 0.2), -20.0 if i % 3 == 0 else -100.0, 100.0) for i in range(n)]
+    bank = pc.PIDBank(n, precision="f32")
+    bank_f = pc.PIDBank(n, precision="f32")
+    for i, (kp, ki, kd, lo, hi) in enumerate(params):
+        for b in (bank, bank_f):
+            b.set_params(i, Kp=kp, Ki=ki, Kd=kd)
+            b.set_output_limits(i, lo, hi)
+    refs = [RefPID32(*p) for p in params]
+    dt = f32(DT)
+    out_f = array("f", bytes(4 * n))
+
+    mismatches = 0
+    for k in range(cycles):
+        x = signal(rng, k, n)
+        y = array("d", (v + rng.gauss(0.0, 2.0) for v in x))
+        out = list(bank.compute(x, y, DT))
+        bank_f.compute(array("f", x), array("f", y), DT, out_f)
+        expected = [r.compute(x[i], y[i], dt) for i, r in enumerate(refs)]
+        mismatches += sum(a != b for a, b in zip(out, expected))
+        mismatches += sum(a != b for a, b in zip(out_f, expected))
+    mismatches += sum(bank.get_loop(i)["integral"] != r.integral for i, r in enumerate(refs))
+
+    ok = mismatches == 0
+    print(f"f32 PIDBank（{bank.kernel} 内核，{n} 回路）与 float32 参考实现："
+          f"{mismatches} 处不一致 {'通过' if ok else '失败'}")
+    return 0 if ok else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="float32 / Q16.16 功能块精度与基准测试")
+    parser.add_argument("--channels", type=int, default=1024, help="通道数（默认 1024）")
+    parser.add_argument("--cycles", type=int, default=2000, help="计时周期数（默认 2000）")
+    args = parser.parse_args()
+
+    import plcopen_c as pc
+
+    failures = verify(pc, 1500, 37)
+
+    n = args.channels
+    rng = random.Random(6)
+    x = signal(rng, 0, n)
+    y = array("d", (v + rng.gauss(0.0, 2.0) for v in x))
+    out = array("d", bytes(8 * n))
+
+    print(f"{n} 通道，每周期耗时（us）")
+    print(f"{'功能块':<18}{'f64':>10}{'f32':>10}{'q16':>10}")
+    for name, (make, call, _) in make_cases(pc, n).items():
+        row = []
+        for p in ("f64", "f32", "q16"):
+            block = make(p)
+            start = time.perf_counter()
+            for _ in range(args.cycles):
+                call(block, x, y, out)
+            row.append((time.perf_counter() - start) / args.cycles * 1e6)
+        print(f"{name:<18}{row[0]:>10.2f}{row[1]:>10.2f}{row[2]:>10.2f}")
+
+    # f32 PIDBank 直接读写 float32 缓冲区，省去边界转换
+    bank = pc.PIDBank(n, Kp=2.0, Ki=0.5, Kd=0.05, output_min=-100.0, output_max=100.0,
+                      precision="f32")
+    x_f, y_f, out_f = array("f", x), array("f", y), array("f", bytes(4 * n))
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        bank.compute(x_f, y_f, DT, out_f)
+    elapsed = (time.perf_counter() - start) / args.cycles * 1e6
+    print(f"{'PIDBank f32 缓冲区':<18}{'':>10}{elapsed:>10.2f}（{bank.kernel} 内核）")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""
+功能块注册表一致性校验与查找基准测试
+
+校验：
+  1. 重复调用 __init__ 后实例的 ID 和名称不变，销毁后注册表中不再有该条目；
+  2. 网络 reset() 后 ID 不变，销毁网络后其功能块全部注销，按名称改参抛出 KeyError；
+  3. PIDBank（f64 / f32）和各 *Array 整体登记为一个条目，可按 ID / 名称查找，
+     事件记录中的 ID 与注册表一致，销毁后注销；
+  4. 每轮校验结束后 plcopen_c.blocks() 回到初始数量。
+计时比较 find_block() 按 ID 和按名称查找、set_block_param() 在线改参的耗时。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/registry.py
+    python3 tests/benchmark/registry.py --blocks 1000
+"""
+
+import argparse
+import gc
+import os
+import sys
+import time
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+
+def verify_reinit(pc):
+    problems = []
+    base = len(pc.blocks())
+    cases = (
+        (pc.PID, (1.0, 0.1, 0.0, 0.0, 100.0)),
+        (pc.FirstOrder, (1.0,)),
+        (pc.Ramp, (1.0, 1.0)),
+        (pc.Limit, (0.0, 1.0)),
+        (pc.MovingAverage, (4,)),
+        (pc.TON, (0.1,)),
+    )
+    for make, args in cases:
+        name = f"reinit_{make.__name__}"
+        blk = make(*args)
+        blk.name = name
+        block_id = blk.id
+        blk.__init__(*args)
+        if blk.id != block_id or blk.name != name:
+            problems.append(f"{make.__name__}：重复 __init__ 后 id={blk.id} name={blk.name}，"
+                            f"应为 {block_id} / {name}")
+        del blk
+        gc.collect()
+        if pc.find_block(name) is not None or pc.find_block(block_id) is not None:
+            problems.append(f"{make.__name__}：销毁后注册表仍有条目")
+
+    if len(pc.blocks()) != base:
+        problems.append(f"注册表条目数 {len(pc.blocks())}，应为 {base}")
+    print(f"重复初始化：{len(cases)} 种类型，{'通过' if not problems else '失败'}")
+    return problems
+
+
+def verify_network(pc):
+    problems = []
+    base = len(pc.blocks())
+
+    net = pc.Network()
+    net.add_input("x", 1.0)
+    net.add_block("r1", "Ramp", rising_rate=1.0, falling_rate=1.0)
+    net.add_block("f1", "FirstOrder", T=1.0)
+    net.connect("x", "r1.in")
+    net.connect("r1.out", "f1.in")
+    net.add_output("y", "f1.out")
+    net.build()
+    ids = {name: pc.find_block(name)["id"] for name in ("r1", "f1")}
+
+    for _ in range(3):
+        net.execute(0.1)
+    net.reset()
+    if {name: pc.find_block(name)["id"] for name in ids} != ids:
+        problems.append("reset() 后网络功能块的 ID 改变")
+    if len(pc.blocks()) != base + 2:
+        problems.append(f"reset() 后注册表条目数 {len(pc.blocks())}，应为 {base + 2}")
+
+    del net
+    gc.collect()
+    if len(pc.blocks()) != base:
+        problems.append(f"销毁网络后注册表条目数 {len(pc.blocks())}，应为 {base}")
+    try:
+        pc.set_block_param("r1", "rising_rate", 2.0)
+        problems.append("销毁网络后 set_block_param('r1') 应抛出 KeyError")
+    except KeyError:
+        pass
+
+    print(f"网络 reset / 销毁：{'通过' if not problems else '失败'}")
+    return problems
+
+
+def verify_banks(pc):
+    problems = []
+    base = len(pc.blocks())
+    cases = (
+        ("PIDBank", lambda: pc.PIDBank(16)),
+        ("PIDBank", lambda: pc.PIDBank(16, precision="f32")),
+        ("FirstOrderArray", lambda: pc.FirstOrderArray(16, T=1.0)),
+        ("LimitArray", lambda: pc.LimitArray(16, precision="q16")),
+        ("DeadTimeArray", lambda: pc.DeadTimeArray(16, delay=0.1, period=0.01)),
+        ("MovingAverageArray", lambda: pc.MovingAverageArray(16, 4)),
+        ("IIRArray", lambda: pc.IIRArray(16, [(1.0, 0.0, 0.0, 1.0, 0.0, 0.0)])),
+        ("TimerArray", lambda: pc.TimerArray(16, "TON", 0.1)),
+    )
+    ids = set()
+    for type_name, make in cases:
+        head = pc.journal_stats()["records"]
+        obj = make()
+        name = f"bank_{len(ids)}"
+        obj.name = name
+        entry = pc.find_block(name)
+        if (entry is None or entry["id"] != obj.id or entry["type"] != type_name
+                or entry["object"] is not obj):
+            problems.append(f"{type_name}：注册表条目 {entry}，应为 id={obj.id} 的 {type_name}")
+        ids.add(obj.id)
+        try:
+            pc.set_block_param(name, "Kp", 1.0)
+            problems.append(f"{type_name}：set_block_param 应抛出 ValueError")
+        except ValueError:
+            pass
+        created = [r for r in pc.journal(head) if r["event"] == "create"]
+        if type_name == "PIDBank" and created and created[-1]["id"] != obj.id:
+            problems.append(f"PIDBank 创建记录 id={created[-1]['id']}，应为 {obj.id}")
+        block_id = obj.id
+        del obj, entry
+        gc.collect()
+        if pc.find_block(block_id) is not None:
+            problems.append(f"{type_name}：销毁后注册表仍有条目")
+
+    if len(ids) != len(cases):
+        problems.append(f"{len(cases)} 个实例只得到 {len(ids)} 个不同 ID")
+    if len(pc.blocks()) != base:
+        problems.append(f"注册表条目数 {len(pc.blocks())}，应为 {base}")
+    print(f"批量类型登记：{len(cases)} 种，{'通过' if not problems else '失败'}")
+    return problems
+
+
+def per_call_ns(fn, n):
+    start = time.perf_counter()
+    for _ in range(n):
+        fn()
+    return (time.perf_counter() - start) / n * 1e9
+
+
+def main():
+    parser = argparse.ArgumentParser(description="功能块注册表一致性校验与查找基准测试")
+    parser.add_argument("--blocks", type=int, default=200, help="登记的实例数（默认 200）")
+    parser.add_argument("--cycles", type=int, default=200000, help="计时调用次数（默认 200000）")
+    args = parser.parse_args()
+
+    import plcopen_c as pc
+
+    pc.configure_pools(max(args.blocks, 32))
+    failures = verify_reinit(pc) + verify_network(pc) + verify_banks(pc)
+    for p in failures:
+        print(f"  {p}")
+
+    blocks = [pc.Limit(0.0, 1.0) for _ in range(args.blocks)]
+    for i, blk in enumerate(blocks):
+        blk.name = f"lim{i}"
+    target = blocks[len(blocks) // 2]
+    n = args.cycles
+    by_id = per_call_ns(lambda: pc.find_block(target.id), n)
+    by_name = per_call_ns(lambda: pc.find_block(target.name), n)
+    set_param = per_call_ns(lambda: pc.set_block_param(target.name, "max_value", 2.0), n)
+
+    print(f"{len(blocks)} 个登记实例，每次调用耗时（{n} 次平均）")
+    print(f"find_block(id)：              {by_id:8.1f} ns")
+    print(f"find_block(name)：            {by_name:8.1f} ns")
+    print(f"set_block_param(name, ...)：  {set_param:8.1f} ns")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,431 @@
+#!/usr/bin/env python3
+"""
+结构化文本程序（STProgram）校验与基准测试
+
+校验：
+  1. 液位控制逻辑（手动/自动、泵启停滞环、报警）分别用 ST 和等价的 Python
+     step() 实现，随机输入下逐周期比较全部输出，逐位一致；
+  2. 随机表达式：按 ST 优先级生成不加多余括号的 BOOL / INT / REAL 表达式，
+     与按相同语义实现的 Python 求值逐位比较（检验优先级、类型规则和常量折叠）；
+  3. 语法和类型错误抛出 SyntaxError，信息带行号和列号。
+计时比较 Python step()、STProgram.run() 和 run(cycles=N) 每周期的耗时。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/st_program.py --cycles 100000
+"""
+
+import argparse
+import math
+import os
+import random
+import sys
+import time
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+TANK_ST = """
+PROGRAM tank_logic
+VAR_INPUT
+    level : REAL;           (* 液位，% *)
+    flow_in : REAL;         (* 进料流量 *)
+    pump_ok : BOOL;
+    manual : BOOL;
+    manual_out : REAL;
+END_VAR
+VAR_OUTPUT
+    valve : REAL;
+    pump_on : BOOL;
+    alarm : BOOL;
+    starts : INT;
+END_VAR
+VAR
+    error : REAL;
+END_VAR
+VAR CONSTANT
+    SP : REAL := 60.0;
+    HIGH : REAL := 90.0;
+    LOW : REAL := 20.0;
+    GAIN : REAL := 2.5;
+    BAND : REAL := 5.0;
+END_VAR
+
+error := SP - level;
+IF manual THEN
+    valve := LIMIT(0.0, manual_out, 100.0);
+ELSIF level > HIGH OR NOT pump_ok THEN
+    valve := 0.0;
+ELSE
+    valve := LIMIT(0.0, 50.0 + GAIN * error - 0.1 * flow_in, 100.0);
+END_IF;
+
+// 泵启停：低于 LOW + BAND 启动，高于 HIGH - BAND 或故障时停止
+IF NOT pump_on AND level < LOW + BAND AND pump_ok THEN
+    pump_on := TRUE;
+    starts := starts + 1;
+ELSIF pump_on AND (level > HIGH - BAND OR NOT pump_ok) THEN
+    pump_on := FALSE;
+END_IF;
+alarm := level > HIGH OR level < LOW OR pump_on AND NOT pump_ok;
+END_PROGRAM
+"""
+
+INPUTS = ("level", "flow_in", "pump_ok", "manual", "manual_out")
+OUTPUTS = ("valve", "pump_on", "alarm", "starts")
+
+
+class PythonTank:
+    """原脚本写法：等价的 Python step()"""
+
+    SP, HIGH, LOW, GAIN, BAND = 60.0, 90.0, 20.0, 2.5, 5.0
+
+    def __init__(self):
+        self.valve = 0.0
+        self.pump_on = False
+        self.alarm = False
+        self.starts = 0
+
+    def step(self, level, flow_in, pump_ok, manual, manual_out):
+        error = self.SP - level
+        if manual:
+            self.valve = min(max(manual_out, 0.0), 100.0)
+        elif level > self.HIGH or not pump_ok:
+            self.valve = 0.0
+        else:
+            self.valve = min(max(50.0 + self.GAIN * error - 0.1 * flow_in, 0.0), 100.0)
+
+        if not self.pump_on and level < self.LOW + self.BAND and pump_ok:
+            self.pump_on = True
+            self.starts += 1
+        elif self.pump_on and (level > self.HIGH - self.BAND or not pump_ok):
+            self.pump_on = False
+        self.alarm = level > self.HIGH or level < self.LOW or (self.pump_on and not pump_ok)
+
+
+def random_inputs(rng, level):
+    """液位随机游走，其余输入偶尔切换"""
+    level = min(max(level + rng.gauss(0.0, 4.0), 0.0), 100.0)
+    return (level, rng.uniform(0.0, 50.0), rng.random() > 0.05, rng.random() < 0.1,
+            rng.uniform(-20.0, 120.0))
+
+
+def verify_tank(STProgram, cycles):
+    rng = random.Random(21)
+    prog = STProgram(TANK_ST)
+    ref = PythonTank()
+    mismatches = 0
+    level = 50.0
+    for _ in range(cycles):
+        values = random_inputs(rng, level)
+        level = values[0]
+        for name, value in zip(INPUTS, values):
+            prog[name] = value
+        prog.run()
+        ref.step(*values)
+        got = tuple(prog[name] for name in OUTPUTS)
+        expected = (ref.valve, ref.pump_on, ref.alarm, ref.starts)
+        if got != expected or tuple(map(type, got)) != tuple(map(type, expected)):
+            mismatches += 1
+    print(f"液位逻辑校验：{cycles} 周期，{prog.instructions} 条指令，启泵 {ref.starts} 次，"
+          f"不一致 {mismatches}")
+    return mismatches
+
+
+# ---- 随机表达式 ----------------------------------------------------------------
+
+# 优先级：数值越大结合越紧
+P_OR, P_XOR, P_AND, P_EQ, P_CMP, P_ADD, P_MUL, P_UNARY, P_ATOM = range(1, 10)
+
+
+def _trunc(x):
+    """同 C trunc()：保留符号，trunc(-0.5) 为 -0.0"""
+    return math.copysign(float(math.trunc(x)), x) if math.isfinite(x) else x
+
+
+def _round(x):
+    """四舍五入（0.5 远离零），同 C round()"""
+    if not math.isfinite(x):
+        return x
+    t = float(math.trunc(x))
+    if abs(x - t) >= 0.5:
+        t += math.copysign(1.0, x)
+    return math.copysign(t, x)
+
+
+def _div(a, b):
+    if b == 0.0:
+        if a == 0.0 or a != a:
+            return math.nan
+        return math.copysign(math.inf, a) * math.copysign(1.0, b)
+    return a / b
+
+
+def _idiv(a, b):
+    return 0.0 if b == 0.0 else _trunc(_div(a, b))
+
+
+def _mod(a, b):
+    if b == 0.0:
+        return 0.0
+    if math.isinf(a) or a != a or b != b:
+        return math.nan
+    return math.fmod(a, b)
+
+
+def _min(a, b):
+    return b if b < a else a
+
+
+def _max(a, b):
+    return b if b > a else a
+
+
+def _limit(mn, x, mx):
+    t = mn if mn > x else x
+    return mx if mx < t else t
+
+
+HELPERS = {"_trunc": _trunc, "_round": _round, "_div": _div, "_idiv": _idiv, "_mod": _mod,
+           "_min": _min, "_max": _max, "_limit": _limit, "math": math}
+
+VARS = {"REAL": ("r0", "r1", "r2", "r3"), "INT": ("i0", "i1"), "BOOL": ("b0", "b1")}
+
+
+class ExprGen:
+    """生成 (ST 文本, Python 文本, 优先级, ST 类型) 四元组"""
+
+    def __init__(self, rng):
+        self.rng = rng
+
+    def wrap(self, node, prec, right=False):
+        """作为优先级 prec 的运算符的操作数，必要时（或随机）加括号"""
+        st, p = node[0], node[2]
+        if p < prec or (right and p == prec) or self.rng.random() < 0.1:
+            st = f"({st})"
+        return st
+
+    def binary(self, op, prec, a, b, py, kind):
+        return f"{self.wrap(a, prec)} {op} {self.wrap(b, prec, right=True)}", py, prec, kind
+
+    @staticmethod
+    def num_type(*nodes):
+        return "INT" if all(n[3] == "INT" for n in nodes) else "REAL"
+
+    def leaf(self, kind):
+        rng = self.rng
+        if rng.random() < 0.4:
+            if kind == "BOOL":
+                v = rng.random() < 0.5
+                return ("TRUE" if v else "FALSE"), ("1.0" if v else "0.0"), P_ATOM, kind
+            if kind == "INT":
+                v = rng.randint(0, 9)
+                return str(v), f"{v}.0", P_ATOM, kind
+            v = rng.choice([0.5, 1.25, 2.0, 3.75, 10.0, 0.001])
+            return repr(v), repr(v), P_ATOM, kind
+        name = rng.choice(VARS[kind] + (VARS["INT"] if kind == "REAL" else ()))
+        return name, name, P_ATOM, "INT" if name in VARS["INT"] else kind
+
+    def gen(self, kind, depth):
+        """kind 为 REAL 时结果可能是 INT 类型（ST 中 INT 可用于 REAL 的位置）"""
+        rng = self.rng
+        if depth <= 0 or rng.random() < 0.2:
+            return self.leaf(kind)
+        d = depth - 1
+        choice = rng.randrange(8)
+
+        if kind == "BOOL":
+            if choice < 2:
+                op = rng.choice(["<", "<=", ">", ">="])
+                a, b = self.gen("REAL", d), self.gen("REAL", d)
+                return self.binary(op, P_CMP, a, b, f"float(({a[1]}) {op} ({b[1]}))", kind)
+            if choice == 2:
+                a = self.gen("BOOL", d)
+                return f"NOT {self.wrap(a, P_UNARY)}", f"float(({a[1]}) == 0.0)", P_UNARY, kind
+            if choice == 3:
+                sub = rng.choice(["BOOL", "REAL"])
+                a, b = self.gen(sub, d), self.gen(sub, d)
+                op = rng.choice(["=", "<>"])
+                pyop = "==" if op == "=" else "!="
+                return self.binary(op, P_EQ, a, b, f"float(({a[1]}) {pyop} ({b[1]}))", kind)
+            if choice == 4:
+                a = self.gen("INT", d)
+                return f"INT_TO_BOOL({a[0]})", f"float(({a[1]}) != 0.0)", P_ATOM, kind
+            op, prec = rng.choice([("AND", P_AND), ("&", P_AND), ("OR", P_OR), ("XOR", P_XOR)])
+            a, b = self.gen("BOOL", d), self.gen("BOOL", d)
+            pa, pb = f"(({a[1]}) != 0.0)", f"(({b[1]}) != 0.0)"
+            py = {"AND": f"float({pa} and {pb})", "&": f"float({pa} and {pb})",
+                  "OR": f"float({pa} or {pb})", "XOR": f"float({pa} != {pb})"}[op]
+            return self.binary(op, prec, a, b, py, kind)
+
+        if choice < 3:
+            op = rng.choice(["+", "-", "*"])
+            a, b = self.gen(kind, d), self.gen(kind, d)
+            return self.binary(op, P_ADD if op in "+-" else P_MUL, a, b,
+                               f"(({a[1]}) {op} ({b[1]}))", self.num_type(a, b))
+        if choice == 3:
+            a, b = self.gen(kind, d), self.gen(kind, d)
+            if kind == "INT" and rng.random() < 0.5:
+                return self.binary("MOD", P_MUL, a, b, f"_mod({a[1]}, {b[1]})", kind)
+            # INT / INT 为截断除法
+            div = "_idiv" if self.num_type(a, b) == "INT" else "_div"
+            return self.binary("/", P_MUL, a, b, f"{div}({a[1]}, {b[1]})", self.num_type(a, b))
+        if choice == 4:
+            a = self.gen(kind, d)
+            st = self.wrap(a, P_UNARY)
+            return f"-{st}", f"(-({a[1]}))", P_UNARY, a[3]
+        if choice == 5:
+            fn = rng.choice(["MIN", "MAX"])
+            args = [self.gen(kind, d) for _ in range(rng.randint(2, 3))]
+            py = args[0][1]
+            for arg in args[1:]:
+                py = f"_{fn.lower()}({py}, {arg[1]})"
+            return f"{fn}({', '.join(a[0] for a in args)})", py, P_ATOM, self.num_type(*args)
+        if choice == 6:
+            if rng.random() < 0.5:
+                g, a, b = self.gen("BOOL", d), self.gen(kind, d), self.gen(kind, d)
+                return (f"SEL({g[0]}, {a[0]}, {b[0]})",
+                        f"(({b[1]}) if ({g[1]}) != 0.0 else ({a[1]}))", P_ATOM,
+                        self.num_type(a, b))
+            lo, x, hi = self.gen(kind, d), self.gen(kind, d), self.gen(kind, d)
+            return (f"LIMIT({lo[0]}, {x[0]}, {hi[0]})", f"_limit({lo[1]}, {x[1]}, {hi[1]})",
+                    P_ATOM, self.num_type(lo, x, hi))
+        if kind == "INT":
+            fn = rng.choice(["TRUNC", "REAL_TO_INT", "BOOL_TO_INT", "ABS"])
+            if fn == "BOOL_TO_INT":
+                a = self.gen("BOOL", d)
+                return f"BOOL_TO_INT({a[0]})", a[1], P_ATOM, kind
+            a = self.gen("INT" if fn == "ABS" else "REAL", d)
+            py = {"TRUNC": "_trunc", "REAL_TO_INT": "_round", "ABS": "abs"}[fn]
+            return f"{fn}({a[0]})", f"{py}({a[1]})", P_ATOM, kind
+        if rng.random() < 0.5:
+            a = self.gen("INT", d)
+            return f"INT_TO_REAL({a[0]})", a[1], P_ATOM, "REAL"
+        a = self.gen("REAL", d)
+        return f"ABS({a[0]})", f"abs({a[1]})", P_ATOM, a[3]
+
+
+def verify_expressions(STProgram, programs, per_program):
+    rng = random.Random(22)
+    gen = ExprGen(rng)
+    mismatches = 0
+    total = 0
+    for _ in range(programs):
+        exprs = []
+        for k in range(per_program):
+            kind = rng.choice(["REAL", "INT", "BOOL"])
+            st, py, _, _ = gen.gen(kind, rng.randint(1, 5))
+            exprs.append((f"y{k}", kind, st, compile(py, "<expr>", "eval")))
+        source = ("VAR_INPUT r0, r1, r2, r3 : REAL; i0, i1 : INT; b0, b1 : BOOL; END_VAR\n"
+                  "VAR_OUTPUT\n" + "".join(f"  {n} : {t};\n" for n, t, _, _ in exprs) +
+                  "END_VAR\n" + "".join(f"{n} := {st};\n" for n, _, st, _ in exprs))
+        prog = STProgram(source)
+        index = {name: prog.index(name) for name, _, _, _ in exprs}
+        for _ in range(4):
+            env = dict(HELPERS)
+            for name in VARS["REAL"]:
+                env[name] = rng.choice([rng.uniform(-10.0, 10.0), 0.0, 2.5])
+            for name in VARS["INT"]:
+                env[name] = float(rng.randint(-9, 9))
+            for name in VARS["BOOL"]:
+                env[name] = float(rng.random() < 0.5)
+            for name in VARS["REAL"] + VARS["INT"] + VARS["BOOL"]:
+                prog[name] = env[name]
+            prog.run()
+            values = memoryview(prog)
+            for name, _, st, code in exprs:
+                expected = eval(code, env)
+                got = values[index[name]]
+                total += 1
+                if got != expected and not (got != got and expected != expected):
+                    mismatches += 1
+                    if mismatches <= 3:
+                        print(f"  不一致：{st} -> {got!r}，Python {expected!r}")
+    print(f"随机表达式校验：{total} 次求值，不一致 {mismatches}")
+    return mismatches
+
+
+ERROR_CASES = [
+    ("VAR x : INT; END_VAR\nx := 1.5;", "第 2 行第 6 列"),
+    ("VAR x : BOOL; END_VAR\nx := 1 AND TRUE;", "第 2 行第 8 列"),
+    ("VAR_INPUT u : REAL; END_VAR\nu := 1.0;", "第 2 行第 1 列"),
+    ("VAR x : REAL; END_VAR\nIF x THEN x := 1.0; END_IF;", "第 2 行第 4 列"),
+    ("VAR x : REAL; END_VAR\nx := y;", "第 2 行第 6 列"),
+    ("VAR x : REAL; END_VAR\n(* 未结束的注释", "第 2 行第 1 列"),
+    ("VAR x : REAL END_VAR", "第 1 行第 14 列"),
+    # 嵌套超过 256 层时报错而不是耗尽 C 栈
+    ("VAR x : REAL; END_VAR\nx := " + "(" * 5000 + "1.0" + ")" * 5000 + ";", "第 2 行第 262 列"),
+    ("VAR x : REAL; END_VAR\nx := " + "-" * 100000 + "1.0;", "第 2 行第 263 列"),
+    ("VAR x : REAL; END_VAR\n" + "IF TRUE THEN " * 5000 + "x := 1.0;" + " END_IF;" * 5000,
+     "第 2 行第 3319 列"),
+]
+
+
+def verify_errors(STProgram):
+    failures = 0
+    for source, where in ERROR_CASES:
+        try:
+            STProgram(source)
+            message = "未报错"
+        except SyntaxError as e:
+            message = str(e)
+        if not message.startswith(where):
+            failures += 1
+            print(f"  错误信息不符：{message}（应为 {where}）")
+    checks = [("VAR x : REAL; END_VAR x := -2 ** 2 + 2 ** 3 ** 2;", 68.0),
+              ("VAR x : INT; END_VAR x := 7 / 2 + -7 MOD 3 + 16#1F + 1_000;", 1033.0),
+              ("VAR x : BOOL; END_VAR x := FALSE OR TRUE AND FALSE XOR TRUE;", 1.0)]
+    for source, expected in checks:
+        prog = STProgram(source)
+        prog.run()
+        if memoryview(prog)[0] != expected:
+            failures += 1
+            print(f"  结果不符：{source}")
+    print(f"错误信息与字面量校验：{len(ERROR_CASES) + len(checks)} 项，失败 {failures}")
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description="结构化文本程序校验与基准测试")
+    parser.add_argument("--cycles", type=int, default=100000, help="计时周期数（默认 100000）")
+    args = parser.parse_args()
+
+    from plcopen_c import STProgram
+
+    failures = verify_tank(STProgram, 20000)
+    failures += verify_expressions(STProgram, 40, 50)
+    failures += verify_errors(STProgram)
+
+    rng = random.Random(23)
+    values = random_inputs(rng, 50.0)
+    ref = PythonTank()
+    prog = STProgram(TANK_ST)
+    for name, value in zip(INPUTS, values):
+        prog[name] = value
+
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        ref.step(*values)
+    py_ns = (time.perf_counter() - start) / args.cycles * 1e9
+
+    run = prog.run
+    start = time.perf_counter()
+    for _ in range(args.cycles):
+        run()
+    run_ns = (time.perf_counter() - start) / args.cycles * 1e9
+
+    start = time.perf_counter()
+    prog.run(args.cycles)
+    vm_ns = (time.perf_counter() - start) / args.cycles * 1e9
+
+    print(f"液位逻辑（{prog.instructions} 条指令），每周期耗时")
+    print(f"Python step()：       {py_ns:8.1f} ns")
+    print(f"STProgram.run()：     {run_ns:8.1f} ns（{py_ns / run_ns:.1f}x）")
+    print(f"run(cycles=N) / N：   {vm_ns:8.1f} ns（{py_ns / vm_ns:.1f}x，运行时挂接时的开销）")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
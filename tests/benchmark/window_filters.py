@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""
+滑动窗口滤波基准测试
+
+把 MovingAverage / MovingMedian / Slope 与脚本中常见的 deque 写法
+（每周期 sum()、sorted() 求中位数、逐点最小二乘求斜率）逐周期比较，
+校验通过后分别计时 deque 写法、n 个 C 实例和一个 xxxArray。
+另校验单个实例的窗口存储从附属存储区分配：创建、重复 __init__ 和销毁后
+pool_stats()["storage"] 的占用一致，存储区不足时抛出 MemoryError。
+
+用法:
+    python3 setup.py build_ext --inplace
+    python3 tests/benchmark/window_filters.py --channels 50 --window 64
+"""
+
+import argparse
+import os
+import random
+import sys
+import time
+from array import array
+from collections import deque
+
+sys.path.insert(
+    0, os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+)
+
+
+class DequeAverage:
+    """原脚本写法：deque + sum()"""
+
+    def __init__(self, window: int):
+        self.samples = deque(maxlen=window)
+
+    def compute(self, x: float) -> float:
+        self.samples.append(x)
+        return sum(self.samples) / len(self.samples)
+
+
+class DequeMedian:
+    """原脚本写法：deque + sorted()，偶数个样本取中间两个的平均"""
+
+    def __init__(self, window: int):
+        self.samples = deque(maxlen=window)
+
+    def compute(self, x: float) -> float:
+        self.samples.append(x)
+        s = sorted(self.samples)
+        m = len(s)
+        return s[m // 2] if m % 2 else (s[m // 2 - 1] + s[m // 2]) / 2.0
+
+
+class DequeSlope:
+    """原脚本写法：deque + 逐点最小二乘"""
+
+    def __init__(self, window: int, period: float):
+        self.samples = deque(maxlen=window)
+        self.period = period
+
+    def compute(self, x: float) -> float:
+        self.samples.append(x)
+        m = len(self.samples)
+        if m < 2:
+            return 0.0
+        mean_j = (m - 1) / 2.0
+        mean_x = sum(self.samples) / m
+        num = sum((j - mean_j) * (v - mean_x) for j, v in enumerate(self.samples))
+        den = m * (m * m - 1) / 12.0
+        return num / den / self.period
+
+
+def signal(rng: random.Random, k: int) -> float:
+    """带噪声、尖峰和重复值的测试信号"""
+    if rng.random() < 0.05:
+        return 500.0                       # 尖峰
+    if rng.random() < 0.1:
+        return float(k % 7)                # 大量重复值
+    return 0.05 * k + rng.gauss(0.0, 2.0)
+
+
+def verify(window: int, cycles: int, period: float) -> int:
+    """逐周期比较 C 块、数组与 deque 参考实现，返回不一致次数"""
+    from plcopen_c import (MovingAverage, MovingAverageArray, MovingMedian,
+                           MovingMedianArray, Slope, SlopeArray)
+
+    cases = [
+        (MovingAverage(window), MovingAverageArray(1, window), DequeAverage(window)),
+        (MovingMedian(window), MovingMedianArray(1, window), DequeMedian(window)),
+    ]
+    if window >= 2:                        # 斜率至少需要两个样本
+        cases.append((Slope(window, period), SlopeArray(1, window, period),
+                      DequeSlope(window, period)))
+    rng = random.Random(window)
+    mismatches = 0
+    for k in range(cycles):
+        x = signal(rng, k)
+        for block, bank, ref in cases:
+            expected = ref.compute(x)
+            got = block.compute(x)
+            got_bank = bank.compute([x])[0]
+            tol = 1e-9 * max(1.0, abs(expected))
+            if abs(got - expected) > tol or got_bank != got:
+                mismatches += 1
+    return mismatches
+
+
+def verify_storage(pc) -> list:
+    problems = []
+    pc.configure_pools(64, 256 * 1024)
+    used = lambda: pc.pool_stats()["storage"]["used"]
+    base = used()
+    for make, args in ((pc.MovingAverage, ()), (pc.MovingMedian, ()), (pc.Slope, (0.01,))):
+        blk = make(64, *args)
+        held = used()
+        blk.__init__(1024, *args)
+        blk.__init__(64, *args)
+        if held <= base or used() != held:
+            problems.append(f"{make.__name__}：创建后占用 {held - base} 字节，"
+                            f"重复 __init__ 后 {used() - base} 字节")
+        try:
+            blk.__init__(1 << 20, *args)
+            problems.append(f"{make.__name__}：窗口超出存储区时 __init__ 应抛出 MemoryError")
+        except MemoryError:
+            pass
+        del blk
+        if used() != base:
+            problems.append(f"{make.__name__}：销毁后占用 {used() - base} 字节，应为 0")
+    pc.configure_pools(1024)
+    print(f"附属存储区：{'通过' if not problems else '失败'}")
+    return problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description="滑动窗口滤波基准测试")
+    parser.add_argument("--channels", type=int, default=50, help="通道数（默认 50）")
+    parser.add_argument("--window", type=int, default=64, help="窗口长度（默认 64）")
+    parser.add_argument("--period", type=float, default=0.01, help="采样周期（秒，默认 0.01）")
+    parser.add_argument("--cycles", type=int, default=500, help="计时周期数（默认 500）")
+    args = parser.parse_args()
+
+    import plcopen_c as pc
+    from plcopen_c import (MovingAverage, MovingAverageArray, MovingMedian,
+                           MovingMedianArray, Slope, SlopeArray)
+
+    failures = verify_storage(pc)
+    for p in failures:
+        print(f"  {p}")
+
+    windows = sorted({1, 2, 3, 4, 7, 16, 31, args.window})
+    mismatches = sum(verify(w, 5 * w + 200, args.period) for w in windows)
+    print(f"一致性校验：窗口 {windows}，不一致 {mismatches}")
+
+    n, w = args.channels, args.window
+    rng = random.Random(2)
+    x = array("d", (rng.uniform(0.0, 100.0) for _ in range(n)))
+    out = array("d", bytes(8 * n))
+
+    filters = {
+        "MovingAverage": (lambda: DequeAverage(w), lambda: MovingAverage(w),
+                          MovingAverageArray(n, w)),
+        "MovingMedian": (lambda: DequeMedian(w), lambda: MovingMedian(w),
+                         MovingMedianArray(n, w)),
+        "Slope": (lambda: DequeSlope(w, args.period), lambda: Slope(w, args.period),
+                  SlopeArray(n, w, args.period)),
+    }
+
+    print(f"{n} 通道，窗口 {w}")
+    print(f"{'滤波器':<16}{'deque (us/周期)':>18}{'C 实例 (us/周期)':>20}{'数组 (us/周期)':>18}")
+    for name, (make_ref, make_block, bank) in filters.items():
+        refs = [make_ref() for _ in range(n)]
+        blocks = [make_block() for _ in range(n)]
+
+        start = time.perf_counter()
+        for _ in range(args.cycles):
+            for i, r in enumerate(refs):
+                r.compute(x[i])
+        ref_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+        start = time.perf_counter()
+        for _ in range(args.cycles):
+            for i, b in enumerate(blocks):
+                b.compute(x[i])
+        block_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+        start = time.perf_counter()
+        for _ in range(args.cycles):
+            bank.compute(x, out)
+        bank_us = (time.perf_counter() - start) / args.cycles * 1e6
+
+        print(f"{name:<16}{ref_us:>18.2f}{block_us:>20.2f}{bank_us:>18.2f}")
+
+    return 1 if mismatches or failures else 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,162 @@
+#!/bin/bash
+# 脚本在 step() 中关闭保持文件/录制器的回归测试
+# 运行时持有 Retain / Recorder 对象的引用，每周期确认句柄仍然打开；
+# 关闭后停止捕获/录制（回放改回按周期定时），不再访问已释放的句柄。
+# 可用 RUNTIME_BIN 指定 AddressSanitizer 构建的运行时。
+
+RUNTIME_BIN="${RUNTIME_BIN:-./bin/plcopen_runtime}"
+TEST_DIR="tests/close_cases"
+LOG_DIR="logs/close_tests"
+
+echo "========================================"
+echo "脚本关闭保持文件/录制器回归测试"
+echo "========================================"
+
+mkdir -p $TEST_DIR
+mkdir -p $LOG_DIR
+rm -f $TEST_DIR/*.bin $TEST_DIR/*.rec* $LOG_DIR/*.log
+# 运行时按模块名导入脚本，测试脚本所在目录需在模块搜索路径中
+export PYTHONPATH="$PWD/$TEST_DIR:.:python${PYTHONPATH:+:$PYTHONPATH}"
+
+TOTAL_TESTS=0
+PASSED_TESTS=0
+FAILED_TESTS=0
+
+GREEN='\033[0;32m'
+RED='\033[0;31m'
+NC='\033[0m' # No Color
+
+# 运行单个测试：运行 2 秒后发送 SIGINT，要求正常退出、日志包含 expected 指定次数
+run_test() {
+    local test_name=$1
+    local config_file=$2
+    local expected=$3
+    local count=$4
+
+    TOTAL_TESTS=$((TOTAL_TESTS + 1))
+    echo ""
+    echo "测试 $TOTAL_TESTS: $test_name"
+    echo "----------------------------------------"
+
+    timeout -s INT 2s $RUNTIME_BIN --config $config_file > $LOG_DIR/${test_name}.out 2>&1
+    EXIT_CODE=$?
+
+    local found
+    found=$(grep -c "$expected" $LOG_DIR/${test_name}.log)
+    # 收到 SIGINT 后正常退出时 timeout 返回 124
+    if grep -q "运行时已正常退出" $LOG_DIR/${test_name}.out && [ "$found" -eq "$count" ] && \
+       ! grep -q "AddressSanitizer" $LOG_DIR/${test_name}.out; then
+        echo -e "${GREEN}✓ 通过${NC}：正常退出，日志中“$expected”出现 $found 次"
+        PASSED_TESTS=$((PASSED_TESTS + 1))
+        return 0
+    fi
+
+    echo -e "${RED}✗ 失败${NC}：退出代码 $EXIT_CODE，“$expected”出现 $found 次（应为 $count）"
+    tail -20 $LOG_DIR/${test_name}.out
+    FAILED_TESTS=$((FAILED_TESTS + 1))
+    return 1
+}
+
+# 写配置：$1 名称，$2 附加配置节
+write_config() {
+    cat > $TEST_DIR/$1.yaml << EOF
+runtime:
+  cycle_period_ms: 10
+  script_path: $PWD/$TEST_DIR/$1.py
+logging:
+  level: INFO
+  file: $PWD/$LOG_DIR/$1.log
+$2
+EOF
+}
+
+# 测试 1：step() 中关闭保持文件，随后重新打开、再次关闭
+cat > $TEST_DIR/retain_close.py << 'EOF'
+"""step() 中调用 plcopen.retain.close()，之后重新打开时由运行时接管新句柄"""
+import plcopen.retain as retain
+import plcopen_c
+
+pid = None
+cycles = 0
+
+
+def init():
+    global pid
+    pid = plcopen_c.PID(Kp=1.0, Ki=0.1, Kd=0.0, output_min=0.0, output_max=100.0)
+    retain.block(pid, "pid")
+
+
+def step():
+    global cycles
+    cycles += 1
+    pid.compute(50.0, 20.0, 0.01)
+    if cycles == 5:
+        retain.close()
+    elif cycles == 10:
+        retain.open("tests/close_cases/retain_reopen.bin")
+        retain.block(pid, "pid")
+    elif cycles == 15:
+        retain.close()
+EOF
+
+write_config retain_close "retain:
+  file: $PWD/$TEST_DIR/retain.bin
+  period_ms: 10"
+run_test "retain_close" "$TEST_DIR/retain_close.yaml" "plcopen.retain 句柄已关闭" 2
+
+# 测试 2：录制中途关闭录制器
+cat > $TEST_DIR/record_close.py << 'EOF'
+"""录制中途调用 plcopen.record.close()，运行时停止锁存周期时间"""
+import plcopen.record as record
+
+cycles = 0
+CLOSE_AT = 5
+
+
+def init():
+    pass
+
+
+def step():
+    global cycles
+    cycles += 1
+    x = record.input("x", float(cycles))
+    record.output("y", 2.0 * x)
+    if cycles == CLOSE_AT:
+        record.close()
+EOF
+
+write_config record_close "record:
+  mode: record
+  file: $PWD/$TEST_DIR/run.rec"
+run_test "record_close" "$TEST_DIR/record_close.yaml" "plcopen.record 句柄已关闭，停止录制" 1
+
+# 测试 3：回放中途关闭录制器（先完整录制 20 个周期，回放到第 5 个周期时关闭）
+sed -e 's/^CLOSE_AT = 5/CLOSE_AT = 20/' $TEST_DIR/record_close.py > $TEST_DIR/record_full.py
+write_config record_full "record:
+  mode: record
+  file: $PWD/$TEST_DIR/full.rec"
+run_test "record_full" "$TEST_DIR/record_full.yaml" "plcopen.record 句柄已关闭，停止录制" 1
+
+cp $TEST_DIR/record_close.py $TEST_DIR/replay_close.py
+write_config replay_close "record:
+  mode: replay
+  file: $PWD/$TEST_DIR/full.rec"
+run_test "replay_close" "$TEST_DIR/replay_close.yaml" "plcopen.record 句柄已关闭，停止回放" 1
+
+echo ""
+echo "========================================"
+echo "测试报告"
+echo "========================================"
+echo "总测试数: $TOTAL_TESTS"
+echo -e "通过: ${GREEN}$PASSED_TESTS${NC}"
+echo -e "失败: ${RED}$FAILED_TESTS${NC}"
+
+if [ $FAILED_TESTS -eq 0 ]; then
+    echo -e "${GREEN}✓ 所有测试通过${NC}"
+    exit 0
+else
+    echo -e "${RED}✗ 部分测试失败${NC}"
+    echo "请检查日志文件: $LOG_DIR/"
+    exit 1
+fi